@@ -68,7 +68,7 @@ sizeof_cmd(int argc, char **argv)
     struct struct_sizes ssizes[] = {
         {"mmap_sizes_t", sizeof(mmap_sizes_t)},
         {"mmap_stats_t", sizeof(mmap_stats_t)},
-        {"pktmbuf_t", sizeof(pktmbuf_t), 64},
+        {"pktmbuf_t", sizeof(pktmbuf_t), 128},
         {"lport_stats", sizeof(lport_stats_t)},
         {"pktdev_info", sizeof(struct pktdev_info)},
         {"txbuff", sizeof(struct txbuff)},
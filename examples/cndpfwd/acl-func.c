@@ -15,6 +15,10 @@
 #include <string.h>               // for memset
 #include <txbuff.h>               // for txbuff_add, txbuff_t
 #include <cne_log.h>              // for CNE_ERR_RET, CNE_LOG_ERR
+#include <cne_cycles.h>           // for cne_rdtsc, cne_get_timer_hz
+#include <cne_rcu_qsbr.h>         // for cne_rcu_qsbr_thread_online, cne_rcu_qsbr_synchronize
+#include <cne_thread.h>           // for thread_create
+#include <metrics.h>              // for metrics_append, metrics_client_t
 
 #include "main.h"        // for fwd_port, MAX_BURST, acl_fwd_stats, get_dst_...
 
@@ -22,6 +26,7 @@
 #define ACL_DENY_SIGNATURE 0xf0000000
 #define MAX_ACL_RULE_NUM   100000
 #define ACL_RULES_PER_PAGE 32
+#define ACL_DELTA_MAX_RULE 64 /**< Rules matched outside of the built context */
 
 /*
  * Order in which fields are appearing in field definitions.
@@ -84,9 +89,52 @@ static struct cne_acl_config acl_config = {
 };
 // clang-format on
 
+/*
+ * The runtime context is replaced as a whole by a build on the control thread. Classifier
+ * threads load it once per burst, between going online and offline on acl_rcu, so the old
+ * context is freed once all of them went offline or reported a quiescent state.
+ */
 static struct cne_acl_ctx *ctx;
+static struct cne_rcu_qsbr *acl_rcu;
 static pthread_mutex_t ctx_mutex = PTHREAD_MUTEX_INITIALIZER;
 
+/*
+ * Rules added after the rules of the runtime context were copied, matched one by one on the
+ * packets the runtime context has no match for. Added rules have a lower priority than the
+ * rules added before them, so a match of the runtime context always wins.
+ */
+struct acl_delta {
+    uint32_t num; /**< Number of rules */
+    struct acl_delta_rule {
+        uint32_t src_addr; /**< Source address, masked */
+        uint32_t src_mask; /**< Source address mask */
+        uint32_t dst_addr; /**< Destination address, masked */
+        uint32_t dst_mask; /**< Destination address mask */
+        uint32_t userdata; /**< Classify result on a match */
+    } rules[ACL_DELTA_MAX_RULE];
+};
+
+static struct acl_delta *delta;
+static size_t delta_base;  /**< Index of the first rule missing from the runtime context */
+static uint64_t clear_gen; /**< Changed by a clear of the rule table */
+
+/* ACL build statistics, exported through metrics */
+static struct acl_build_stats {
+    uint64_t builds;    /**< Number of builds done */
+    uint64_t failures;  /**< Number of builds failed */
+    uint64_t last_us;   /**< Time taken by the last build in microseconds */
+    uint64_t mem_sz;    /**< Memory used by the runtime context in bytes */
+    size_t built_rules; /**< Number of rules in the runtime context */
+    bool building;      /**< A build is running on the control thread */
+} acl_bld_stats;
+
+/* A snapshot of the rule table built on the control thread */
+struct acl_build_job {
+    uint8_t *rules;     /**< Copy of the rules */
+    size_t num;         /**< Number of rules */
+    uint64_t clear_gen; /**< clear_gen when the copy was taken */
+};
+
 /*
  * This is the rule table, however due to the way the ACL works the base struct
  * does not include any actual rule data, so do *not* index the struct directly.
@@ -193,6 +241,169 @@ acl_tbl_add_rule(struct acl_rule_table *tbl, const struct acl_rule_desc *rule)
     tbl->len++;
 }
 
+static inline uint32_t
+acl_depth_to_mask(uint8_t depth)
+{
+    return (depth == 0) ? 0 : UINT32_MAX << (32 - depth);
+}
+
+/* Publish the rules missing from the runtime context, called with ctx_mutex held */
+static int
+acl_delta_update(void)
+{
+    struct acl_delta *d = NULL, *old;
+    size_t i;
+
+    if (delta_base < acl_rules.len) {
+        d = calloc(1, sizeof(*d));
+        if (d == NULL)
+            return -ENOMEM;
+
+        for (i = delta_base; i < acl_rules.len && d->num < ACL_DELTA_MAX_RULE; i++) {
+            struct cne_acl_rule *rule = acl_tbl_get_rule(&acl_rules, i);
+            struct acl_delta_rule *dr = &d->rules[d->num++];
+
+            dr->src_mask = acl_depth_to_mask(rule->field[SRC_FIELD_IPV4].mask_range.u8);
+            dr->src_addr = rule->field[SRC_FIELD_IPV4].value.u32 & dr->src_mask;
+            dr->dst_mask = acl_depth_to_mask(rule->field[DST_FIELD_IPV4].mask_range.u8);
+            dr->dst_addr = rule->field[DST_FIELD_IPV4].value.u32 & dr->dst_mask;
+            dr->userdata = rule->data.userdata;
+        }
+    }
+
+    old = __atomic_exchange_n(&delta, d, __ATOMIC_ACQ_REL);
+    if (old != NULL) {
+        /* wait for the classifier threads to stop using the old table */
+        cne_rcu_qsbr_synchronize(acl_rcu, CNE_QSBR_THRID_INVALID);
+        free(old);
+    }
+
+    return 0;
+}
+
+/* Create a context and build it with num rules */
+static int
+acl_ctx_create(const void *rules, size_t num, struct cne_acl_ctx **out)
+{
+    struct cne_acl_ctx *new_ctx;
+    int ret;
+
+    new_ctx = cne_acl_create(&acl_param);
+    if (new_ctx == NULL)
+        return -ENOMEM;
+
+    ret = cne_acl_add_rules(new_ctx, rules, num);
+    if (ret == 0)
+        ret = cne_acl_build(new_ctx, &acl_config);
+    if (ret != 0) {
+        cne_acl_free(new_ctx);
+        return ret;
+    }
+    *out = new_ctx;
+
+    return 0;
+}
+
+/* Account a build started at the start cycle count, called with ctx_mutex held */
+static void
+acl_build_done(int ret, uint64_t start, const struct cne_acl_ctx *new_ctx, size_t num)
+{
+    acl_bld_stats.last_us = ((cne_rdtsc() - start) * 1000000) / cne_get_timer_hz();
+    if (ret != 0) {
+        acl_bld_stats.failures++;
+        return;
+    }
+    acl_bld_stats.builds++;
+    acl_bld_stats.mem_sz      = cne_acl_mem_size(new_ctx);
+    acl_bld_stats.built_rules = num;
+}
+
+static int acl_start_build(void);
+
+static void
+acl_build_thread(void *arg)
+{
+    struct acl_build_job *job   = arg;
+    struct cne_acl_ctx *new_ctx = NULL, *old_ctx;
+    uint64_t start              = cne_rdtsc();
+    int ret, mret;
+
+    /* the classifier threads keep using the runtime context while the new one is built */
+    ret = acl_ctx_create(job->rules, job->num, &new_ctx);
+
+    mret = pthread_mutex_lock(&ctx_mutex);
+    if (mret != 0) {
+        CNE_ERR("Mutex lock failed: %s\n", strerror(mret));
+        cne_acl_free(new_ctx);
+        __atomic_store_n(&acl_bld_stats.building, false, __ATOMIC_RELEASE);
+        goto leave;
+    }
+
+    acl_build_done(ret, start, new_ctx, job->num);
+    if (ret != 0)
+        CNE_ERR("Cannot build ACL context: %s\n", strerror(-ret));
+    else {
+        old_ctx = ctx;
+        __atomic_store_n(&ctx, new_ctx, __ATOMIC_RELEASE);
+
+        /* rules added during the build stay in the delta table, all of them after a clear */
+        if (job->clear_gen == clear_gen)
+            delta_base = job->num;
+        if (acl_delta_update() < 0)
+            CNE_ERR("Failed to update the ACL delta table\n");
+
+        cne_rcu_qsbr_synchronize(acl_rcu, CNE_QSBR_THRID_INVALID);
+        cne_acl_free(old_ctx);
+    }
+    acl_bld_stats.building = false;
+
+    /* more rules than the delta table holds were added during the build */
+    if (ret == 0 && acl_rules.len - delta_base > ACL_DELTA_MAX_RULE && acl_start_build() < 0)
+        CNE_ERR("Failed to start ACL build\n");
+
+    mret = pthread_mutex_unlock(&ctx_mutex);
+    if (mret != 0)
+        CNE_ERR("Mutex unlock failed: %s\n", strerror(mret));
+leave:
+    free(job->rules);
+    free(job);
+}
+
+/* Build the current rule table on a control thread, called with ctx_mutex held */
+static int
+acl_start_build(void)
+{
+    struct acl_build_job *job;
+
+    if (acl_bld_stats.building)
+        return -EBUSY;
+
+    job = calloc(1, sizeof(*job));
+    if (job == NULL)
+        return -ENOMEM;
+
+    job->num       = acl_rules.len;
+    job->clear_gen = clear_gen;
+    if (job->num > 0) {
+        job->rules = malloc(job->num * acl_rules.rule_sz);
+        if (job->rules == NULL) {
+            free(job);
+            return -ENOMEM;
+        }
+        memcpy(job->rules, acl_rules.rules, job->num * acl_rules.rule_sz);
+    }
+
+    acl_bld_stats.building = true;
+    if (thread_create("acl-build", acl_build_thread, job) < 0) {
+        acl_bld_stats.building = false;
+        free(job->rules);
+        free(job);
+        return -EAGAIN;
+    }
+
+    return 0;
+}
+
 static int
 acl_add_rule(const struct acl_rule_desc *rule)
 {
@@ -212,6 +423,12 @@ acl_add_rule(const struct acl_rule_desc *rule)
 
     acl_tbl_add_rule(tbl, rule);
 
+    /* apply the rule right away through the delta table, a full table needs a build */
+    if (tbl->len - delta_base <= ACL_DELTA_MAX_RULE)
+        ret = acl_delta_update();
+    else if (!acl_bld_stats.building)
+        ret = acl_start_build();
+
 unlock:
     mret = pthread_mutex_unlock(&ctx_mutex);
     if (mret != 0)
@@ -234,6 +451,12 @@ acl_clear(void)
 
     acl_tbl_clear(tbl);
 
+    /* the delta table goes away now, the rules of the runtime context with the next build */
+    delta_base = 0;
+    clear_gen++;
+    if (acl_delta_update() < 0)
+        CNE_ERR("Failed to update the ACL delta table\n");
+
     ret = pthread_mutex_unlock(&ctx_mutex);
     if (ret != 0)
         CNE_ERR("Mutex unlock failed: %s\n", strerror(ret));
@@ -307,15 +530,46 @@ populate_acl_classify(struct acl_classify_t *acl_classify_ctx, pktmbuf_t **pkts,
     return num;
 }
 
+/* Match the packets without a result against the delta table, first match wins */
+static inline void
+acl_delta_classify(const struct acl_delta *d, struct acl_classify_t *acl_classify_ctx,
+                   uint16_t num)
+{
+    uint32_t src_addr, dst_addr;
+    uint16_t i;
+    uint32_t j;
+
+    for (i = 0; i < num; i++) {
+        if (acl_classify_ctx->acl_results[i] != 0)
+            continue;
+
+        memcpy(&src_addr, acl_classify_ctx->data_ptrs[i] + SRC_ADDR_ACL_OFFSET, sizeof(src_addr));
+        memcpy(&dst_addr, acl_classify_ctx->data_ptrs[i] + DST_ADDR_ACL_OFFSET, sizeof(dst_addr));
+        src_addr = be32toh(src_addr);
+        dst_addr = be32toh(dst_addr);
+
+        for (j = 0; j < d->num; j++) {
+            const struct acl_delta_rule *dr = &d->rules[j];
+
+            if ((src_addr & dr->src_mask) == dr->src_addr &&
+                (dst_addr & dr->dst_mask) == dr->dst_addr) {
+                acl_classify_ctx->acl_results[i] = dr->userdata;
+                break;
+            }
+        }
+    }
+}
+
 int
-acl_fwd_test(jcfg_lport_t *lport, struct fwd_info *fwd)
+acl_fwd_test(jcfg_lport_t *lport, uint16_t qid, struct fwd_info *fwd)
 {
     /* do we forward non-matching packets? */
     const bool fwd_non_matching                  = fwd->test == ACL_PERMISSIVE_TEST;
-    struct fwd_port *pd                          = lport->priv_;
+    struct fwd_port *pd                          = fwd_port_get(lport, qid);
     struct create_txbuff_thd_priv_t *thd_private = pd->thd->priv_;
     struct acl_classify_t acl_classify_ctx;
     struct acl_fwd_stats *stats = &pd->acl_stats;
+    const struct acl_delta *d;
     uint16_t n_pkts, n_filtered, n_permit, n_deny;
     txbuff_t **txbuff;
     int i;
@@ -331,7 +585,7 @@ acl_fwd_test(jcfg_lport_t *lport, struct fwd_info *fwd)
         n_pkts = xskdev_rx_burst(pd->xsk, (void **)pd->rx_mbufs, BURST_SIZE);
         break;
     case PKTDEV_PKT_API:
-        n_pkts = pktdev_rx_burst(pd->lport, pd->rx_mbufs, BURST_SIZE);
+        n_pkts = pktdev_rx_burst_q(pd->lport, pd->qid, pd->rx_mbufs, BURST_SIZE);
         if (n_pkts == PKTDEV_ADMIN_STATE_DOWN)
             return 0;
         break;
@@ -349,8 +603,17 @@ acl_fwd_test(jcfg_lport_t *lport, struct fwd_info *fwd)
     if (n_filtered == 0)
         return 0;
 
-    cne_acl_classify(ctx, acl_classify_ctx.data_ptrs, acl_classify_ctx.acl_results, n_filtered,
-                     MAX_CATEGORIES);
+    cne_rcu_qsbr_thread_online(acl_rcu, cne_id());
+
+    cne_acl_classify(__atomic_load_n(&ctx, __ATOMIC_ACQUIRE), acl_classify_ctx.data_ptrs,
+                     acl_classify_ctx.acl_results, n_filtered, MAX_CATEGORIES);
+
+    /* rules added since the last build, only a few packets miss the runtime context */
+    d = __atomic_load_n(&delta, __ATOMIC_ACQUIRE);
+    if (d != NULL)
+        acl_delta_classify(d, &acl_classify_ctx, n_filtered);
+
+    cne_rcu_qsbr_thread_offline(acl_rcu, cne_id());
 
     n_deny   = 0;
     n_permit = 0;
@@ -401,8 +664,26 @@ acl_fwd_test(jcfg_lport_t *lport, struct fwd_info *fwd)
     return 0;
 }
 
+int
+acl_thread_register(void)
+{
+    if (cne_rcu_qsbr_thread_register(acl_rcu, cne_id()))
+        CNE_ERR_RET("Failed to register thread %d to ACL QSBR\n", cne_id());
+
+    return 0;
+}
+
+void
+acl_thread_unregister(void)
+{
+    if (acl_rcu == NULL)
+        return;
+    cne_rcu_qsbr_thread_offline(acl_rcu, cne_id());
+    cne_rcu_qsbr_thread_unregister(acl_rcu, cne_id());
+}
+
 static int
-add_init_rules(struct cne_acl_ctx *ctx)
+add_init_rules(void)
 {
 #define DST_DENY_RULE_NUM  100  /* Dst IP 100.x.x.0/24 */
 #define SRC_DENY1_RULE_NUM 15   /* Src IP x.0.0.0/8 */
@@ -474,33 +755,9 @@ add_init_rules(struct cne_acl_ctx *ctx)
         acl_tbl_add_rule(&acl_rules, &rule);
     }
 
-    cne_printf("Adding rules to ACL context...\n");
-
-    ret = cne_acl_add_rules(ctx, (const struct cne_acl_rule *)acl_rules.rules, total_num);
-    if (ret < 0)
-        CNE_ERR_RET("Failed to add rules: %s\n", strerror(-ret));
-
     return 0;
 }
 
-static int
-thread_paused(jcfg_info_t *j __cne_unused, void *obj, void *arg __cne_unused, int idx __cne_unused)
-{
-    jcfg_thd_t *thd = obj;
-
-    if (strcasecmp(thd->thread_type, "main") == 0)
-        return 0;
-
-    return thd->pause ? 0 : -1;
-}
-
-static bool
-all_threads_stopped(struct fwd_info *fwd)
-{
-    /* zero return means all threads stopped */
-    return jcfg_thread_foreach(fwd->jinfo, thread_paused, NULL) == 0;
-}
-
 int
 fwd_acl_clear(uds_client_t *c __cne_unused, const char *cmd __cne_unused,
               const char *params __cne_unused)
@@ -605,13 +862,6 @@ int
 fwd_acl_build(uds_client_t *c, const char *cmd __cne_unused, const char *params __cne_unused)
 {
     int ret, mret;
-    struct fwd_info *fwd = (struct fwd_info *)(c->info->priv);
-
-    /* we cannot do anything with ACL context unless all threads are stopped */
-    if (!all_threads_stopped(fwd)) {
-        uds_append(c, "\"error\":\"Not all forwarding threads are stopped\"");
-        return 0;
-    }
 
     mret = pthread_mutex_lock(&ctx_mutex);
     if (mret != 0) {
@@ -620,30 +870,38 @@ fwd_acl_build(uds_client_t *c, const char *cmd __cne_unused, const char *params
         return 0;
     }
 
-    /* if there's already an ACL context, free it */
-    if (ctx != NULL) {
-        cne_acl_free(ctx);
-        ctx = NULL;
-    }
-    ctx = cne_acl_create(&acl_param);
-    if (ctx == NULL) {
-        uds_append(c, "\"error\":\"ACL context not initialized\"");
-        goto unlock;
-    }
+    /* the rule table is built in the background, classification goes on with the old rules */
+    ret = acl_start_build();
+    if (ret == -EBUSY)
+        uds_append(c, "\"error\":\"ACL build already in progress\"");
+    else if (ret < 0)
+        uds_append(c, "\"error\":\"Cannot start ACL build: %s\"", strerror(-ret));
+    else
+        uds_append(c, "\"build\":\"started\",\"num rules\":%zu", acl_rules.len);
 
-    /* add all rules */
-    ret = cne_acl_add_rules(ctx, (const struct cne_acl_rule *)acl_rules.rules, acl_rules.len);
-    if (ret < 0) {
-        uds_append(c, "\"error\":\"Cannot add ACL rules to context: %s\"", strerror(-ret));
-        goto unlock;
-    }
+    mret = pthread_mutex_unlock(&ctx_mutex);
+    if (mret != 0)
+        CNE_ERR("Mutex unlock failed: %s\n", strerror(mret));
+    return 0;
+}
 
-    /* build context */
-    ret = cne_acl_build(ctx, &acl_config);
-    if (ret != 0)
-        uds_append(c, "\"error\":\"Cannot build ACL context: %s\"", strerror(-ret));
+int
+fwd_acl_stats(metrics_client_t *c, const char *cmd __cne_unused, const char *params __cne_unused)
+{
+    int mret;
+
+    mret = pthread_mutex_lock(&ctx_mutex);
+    if (mret != 0)
+        CNE_ERR_RET("Mutex lock failed: %s\n", strerror(mret));
+
+    metrics_append(c, "\"acl_builds\":%lu", acl_bld_stats.builds);
+    metrics_append(c, ",\"acl_build_failures\":%lu", acl_bld_stats.failures);
+    metrics_append(c, ",\"acl_last_build_us\":%lu", acl_bld_stats.last_us);
+    metrics_append(c, ",\"acl_mem_bytes\":%lu", acl_bld_stats.mem_sz);
+    metrics_append(c, ",\"acl_built_rules\":%zu", acl_bld_stats.built_rules);
+    metrics_append(c, ",\"acl_delta_rules\":%zu", acl_rules.len - delta_base);
+    metrics_append(c, ",\"acl_building\":%d", acl_bld_stats.building);
 
-unlock:
     mret = pthread_mutex_unlock(&ctx_mutex);
     if (mret != 0)
         CNE_ERR("Mutex unlock failed: %s\n", strerror(mret));
@@ -654,6 +912,8 @@ static void
 print_acl_info(uds_client_t *c)
 {
     uds_append(c, "\"num rules\":%zu,", acl_rules.len);
+    uds_append(c, "\"delta rules\":%zu,", acl_rules.len - delta_base);
+    uds_append(c, "\"building\":%s,", acl_bld_stats.building ? "true" : "false");
     uds_append(c, "\"max rules\":%d,", acl_param.max_rule_num);
     uds_append(c, "\"rule pages\":%zu,", ACL_NUM_PAGES(acl_rules.len));
     uds_append(c, "\"rules per page\":%d", ACL_RULES_PER_PAGE);
@@ -793,6 +1053,7 @@ unlock:
 int
 acl_init(struct fwd_info *fwd)
 {
+    uint64_t start;
     int ret = -1, mret;
 
     cne_printf("Creating ACL context...\n");
@@ -803,20 +1064,23 @@ acl_init(struct fwd_info *fwd)
         return -1;
     }
 
-    /* create ACL context */
-    ctx = cne_acl_create(&acl_param);
-    if (ctx == NULL)
-        CNE_ERR_GOTO(unlock, "Could not create ACL context\n");
+    acl_rcu = cne_rcu_qsbr_create();
+    if (acl_rcu == NULL)
+        CNE_ERR_GOTO(unlock, "Could not create ACL QSBR variable\n");
 
-    /* add rules to context */
-    if (add_init_rules(ctx) < 0)
+    /* add rules to rule table */
+    if (add_init_rules() < 0)
         CNE_ERR_GOTO(unlock, "Could not add ACL rules\n");
 
     cne_printf("Building ACL runtime...\n");
 
     /* compile ACL matcher bytecode */
-    if (cne_acl_build(ctx, &acl_config) < 0)
+    start = cne_rdtsc();
+    ret   = acl_ctx_create(acl_rules.rules, acl_rules.len, &ctx);
+    acl_build_done(ret, start, ctx, acl_rules.len);
+    if (ret < 0)
         CNE_ERR_GOTO(unlock, "Could not build ACL runtime\n");
+    delta_base = acl_rules.len;
 
     cne_printf("ACL rule table created successfully\n");
 
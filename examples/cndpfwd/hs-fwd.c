@@ -38,11 +38,11 @@ hsfwd_handler(unsigned int id, unsigned long long from, unsigned long long to, u
 #endif /* ENABLE_HYPERSCAN */
 
 int
-hsfwd_test(jcfg_lport_t *lport, struct fwd_info *fwd)
+hsfwd_test(jcfg_lport_t *lport, uint16_t qid, struct fwd_info *fwd)
 {
 #ifdef ENABLE_HYPERSCAN
     /* do we forward non-matching packets? */
-    struct fwd_port *pd                          = lport->priv_;
+    struct fwd_port *pd                          = fwd_port_get(lport, qid);
     struct create_txbuff_thd_priv_t *thd_private = pd->thd->priv_;
     uint16_t n_pkts;
     txbuff_t **txbuff;
@@ -62,7 +62,7 @@ hsfwd_test(jcfg_lport_t *lport, struct fwd_info *fwd)
         n_pkts = xskdev_rx_burst(pd->xsk, (void **)pd->rx_mbufs, BURST_SIZE);
         break;
     case PKTDEV_PKT_API:
-        n_pkts = pktdev_rx_burst(pd->lport, pd->rx_mbufs, BURST_SIZE);
+        n_pkts = pktdev_rx_burst_q(pd->lport, pd->qid, pd->rx_mbufs, BURST_SIZE);
         if (n_pkts == PKTDEV_ADMIN_STATE_DOWN) {
             hs_free_scratch(thd_private->scratch);
             thd_private->scratch = NULL;
@@ -118,6 +118,7 @@ hsfwd_test(jcfg_lport_t *lport, struct fwd_info *fwd)
     return 0;
 #else
     CNE_SET_USED(lport);
+    CNE_SET_USED(qid);
     CNE_SET_USED(fwd);
     return -1;
 #endif /* ENABLE HYPERSCAN */
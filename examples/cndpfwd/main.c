@@ -27,6 +27,10 @@ static struct fwd_info *fwd = &fwd_info;
 #define foreach_thd_lport(_t, _lp) \
     for (int _i = 0; _i < _t->lport_cnt && (_lp = _t->lports[_i]); _i++, _lp = _t->lports[_i])
 
+/* Same as foreach_thd_lport() and also set _q to the queue of the lport the thread polls */
+#define foreach_thd_lport_qid(_t, _lp, _q) \
+    for (int _i = 0; _i < _t->lport_cnt && (_lp = _t->lports[_i], _q = _t->lport_qids[_i], 1); _i++)
+
 #define TIMEOUT_VALUE 1000 /* Number of times to wait for each usleep() time */
 
 enum thread_quit_state {
@@ -42,7 +46,7 @@ __rx_burst(pkt_api_t api, struct fwd_port *pd, pktmbuf_t **mbufs, int n_pkts)
     case XSKDEV_PKT_API:
         return xskdev_rx_burst(pd->xsk, (void **)mbufs, n_pkts);
     case PKTDEV_PKT_API:
-        return pktdev_rx_burst(pd->lport, mbufs, n_pkts);
+        return pktdev_rx_burst_q(pd->lport, pd->qid, mbufs, n_pkts);
     default:
         break;
     }
@@ -56,7 +60,7 @@ __tx_burst(pkt_api_t api, struct fwd_port *pd, pktmbuf_t **mbufs, int n_pkts)
     case XSKDEV_PKT_API:
         return xskdev_tx_burst(pd->xsk, (void **)mbufs, n_pkts);
     case PKTDEV_PKT_API:
-        return pktdev_tx_burst(pd->lport, mbufs, n_pkts);
+        return pktdev_tx_burst_q(pd->lport, pd->qid, mbufs, n_pkts);
     default:
         break;
     }
@@ -79,9 +83,9 @@ __tx_flush(struct fwd_port *pd, pkt_api_t api, pktmbuf_t **mbufs, uint16_t n_pkt
 }
 
 static int
-_drop_test(jcfg_lport_t *lport, struct fwd_info *fwd)
+_drop_test(jcfg_lport_t *lport, uint16_t qid, struct fwd_info *fwd)
 {
-    struct fwd_port *pd = lport->priv_;
+    struct fwd_port *pd = fwd_port_get(lport, qid);
     int n_pkts;
 
     if (!pd)
@@ -98,9 +102,9 @@ _drop_test(jcfg_lport_t *lport, struct fwd_info *fwd)
 }
 
 static int
-_fwd_test(jcfg_lport_t *lport, struct fwd_info *fwd)
+_fwd_test(jcfg_lport_t *lport, uint16_t qid, struct fwd_info *fwd)
 {
-    struct fwd_port *pd                          = lport->priv_;
+    struct fwd_port *pd                          = fwd_port_get(lport, qid);
     struct create_txbuff_thd_priv_t *thd_private = pd->thd->priv_;
     txbuff_t **txbuff;
     int n_pkts;
@@ -173,9 +177,9 @@ ipv4_adjust_cksum(struct cne_ipv4_hdr *hdr)
 }
 
 static int
-_l3fwd_test(jcfg_lport_t *lport, struct fwd_info *fwd)
+_l3fwd_test(jcfg_lport_t *lport, uint16_t qid, struct fwd_info *fwd)
 {
-    struct fwd_port *pd                          = lport->priv_;
+    struct fwd_port *pd                          = fwd_port_get(lport, qid);
     struct create_txbuff_thd_priv_t *thd_private = pd->thd->priv_;
     txbuff_t **txbuff;
     int n_pkts;
@@ -233,9 +237,9 @@ _l3fwd_test(jcfg_lport_t *lport, struct fwd_info *fwd)
 }
 
 static int
-_loopback_test(jcfg_lport_t *lport, struct fwd_info *fwd)
+_loopback_test(jcfg_lport_t *lport, uint16_t qid, struct fwd_info *fwd)
 {
-    struct fwd_port *pd = lport->priv_;
+    struct fwd_port *pd = fwd_port_get(lport, qid);
     int n_pkts, n;
 
     if (!pd)
@@ -258,9 +262,9 @@ _loopback_test(jcfg_lport_t *lport, struct fwd_info *fwd)
 }
 
 static int
-_txonly_test(jcfg_lport_t *lport, struct fwd_info *fwd)
+_txonly_test(jcfg_lport_t *lport, uint16_t qid, struct fwd_info *fwd)
 {
-    struct fwd_port *pd = lport->priv_;
+    struct fwd_port *pd = fwd_port_get(lport, qid);
     pktmbuf_t *tx_mbufs[fwd->burst];
     int n_pkts, n;
 
@@ -314,9 +318,9 @@ _txonly_test(jcfg_lport_t *lport, struct fwd_info *fwd)
 }
 
 static int
-_txonly_rx_test(jcfg_lport_t *lport, struct fwd_info *fwd)
+_txonly_rx_test(jcfg_lport_t *lport, uint16_t qid, struct fwd_info *fwd)
 {
-    struct fwd_port *pd = lport->priv_;
+    struct fwd_port *pd = fwd_port_get(lport, qid);
     pktmbuf_t *tx_mbufs[fwd->burst];
     int n_pkts, n;
 
@@ -396,6 +400,16 @@ destroy_per_thread_txbuff(jcfg_thd_t *thd, struct fwd_info *fwd)
     }
 }
 
+/* Return the queue of the lport polled by the thread, queue 0 if the thread does not poll it */
+static uint16_t
+thd_lport_qid(jcfg_thd_t *thd, jcfg_lport_t *lport)
+{
+    for (int i = 0; i < thd->lport_cnt; i++)
+        if (thd->lports[i] == lport)
+            return thd->lport_qids[i];
+    return 0;
+}
+
 static int
 _create_txbuff(jcfg_info_t *jinfo __cne_unused, void *obj, void *arg, int idx)
 {
@@ -404,7 +418,8 @@ _create_txbuff(jcfg_info_t *jinfo __cne_unused, void *obj, void *arg, int idx)
     txbuff_t **txbuffs                           = thd_private->txbuffs;
     struct fwd_port *pd;
 
-    pd = lport->priv_;
+    /* Transmit on the queue this thread owns when it also polls the destination lport */
+    pd = fwd_port_get(lport, thd_lport_qid(thd_private->thd, lport));
     if (!pd)
         CNE_ERR_RET("fwd_port passed in lport private data is NULL\n");
 
@@ -415,8 +430,8 @@ _create_txbuff(jcfg_info_t *jinfo __cne_unused, void *obj, void *arg, int idx)
             txbuff_xskdev_create(fwd->burst, txbuff_count_callback, &pd->tx_overrun, pd->xsk);
         break;
     case PKTDEV_PKT_API:
-        txbuffs[idx] =
-            txbuff_pktdev_create(fwd->burst, txbuff_count_callback, &pd->tx_overrun, pd->lport);
+        txbuffs[idx] = txbuff_pktdev_queue_create(fwd->burst, txbuff_count_callback,
+                                                  &pd->tx_overrun, pd->lport, pd->qid);
         break;
     default:
         txbuffs[idx] = NULL;
@@ -432,6 +447,7 @@ static int
 create_per_thread_txbuff(jcfg_thd_t *thd, struct fwd_info *fwd)
 {
     jcfg_lport_t *lport;
+    uint16_t qid;
 
     if (thd->priv_) {
         CNE_ERR("Expected thread's private data to be unused but it is %p\n", thd->priv_);
@@ -451,6 +467,7 @@ create_per_thread_txbuff(jcfg_thd_t *thd, struct fwd_info *fwd)
     }
 
     thd_private->pkt_api = fwd->pkt_api;
+    thd_private->thd     = thd;
     thd->priv_           = thd_private;
 
     /* Allocate a Tx buffer for all lports, not just the receiving ones */
@@ -459,9 +476,9 @@ create_per_thread_txbuff(jcfg_thd_t *thd, struct fwd_info *fwd)
         return -1;
     }
 
-    /* Set reference for this thread's receiving lports, not all lports */
-    foreach_thd_lport (thd, lport)
-        ((struct fwd_port *)lport->priv_)->thd = thd;
+    /* Set reference for this thread's receiving lport queues, not all lports */
+    foreach_thd_lport_qid (thd, lport, qid)
+        fwd_port_get(lport, qid)->thd = thd;
 
     return 0;
 }
@@ -473,10 +490,11 @@ thread_func(void *arg)
     struct fwd_info *fwd               = func_arg->fwd;
     jcfg_thd_t *thd                    = func_arg->thd;
     jcfg_lport_t *lport;
+    uint16_t qid;
     idlemgr_t *imgr = NULL;
     // clang-format off
     struct {
-        int (*func)(jcfg_lport_t *lport, struct fwd_info *fwd);
+        int (*func)(jcfg_lport_t *lport, uint16_t qid, struct fwd_info *fwd);
     } tests[] = {
         {NULL},
         {_drop_test},
@@ -509,12 +527,16 @@ thread_func(void *arg)
             cne_exit("Failed to create txbuff(s) for \"%s\" thread\n", thd->name);
     }
 
+    /* classifier threads report to the ACL QSBR variable, before the old rules are freed */
+    if ((fwd->test == ACL_STRICT_TEST || fwd->test == ACL_PERMISSIVE_TEST) &&
+        acl_thread_register() < 0)
+        goto leave;
+
     cne_printf("   [green]Forwarding Thread ID [orange]%d [green]on lcore [orange]%d[]\n", thd->tid,
                cne_lcore_id());
 
     if (thd->idle_timeout) {
         struct fwd_port *pd;
-        struct pktdev_info info;
         int fd = -1;
 
         cne_printf("   [green]Create idlemgr for thread [orange]%s [green]idle/intr "
@@ -524,7 +546,7 @@ thread_func(void *arg)
         if (!imgr)
             CNE_ERR_GOTO(leave, "failed to create idle managed\n");
 
-        foreach_thd_lport (thd, lport) {
+        foreach_thd_lport_qid (thd, lport, qid) {
             switch (fwd->pkt_api) {
             case XSKDEV_PKT_API:
                 pd = lport->priv_;
@@ -532,10 +554,9 @@ thread_func(void *arg)
                     CNE_ERR_GOTO(leave, "failed to get file descriptors for %s\n", lport->name);
                 break;
             case PKTDEV_PKT_API:
-                memset(&info, 0, sizeof(info));
-                if (pktdev_info_get(lport->lpid, &info) < 0)
-                    CNE_ERR_GOTO(leave, "failed to get info for %s\n", lport->name);
-                fd = info.rx_fd;
+                /* Wait on the fd of the queue the thread receives from */
+                if (pktdev_queue_fd_get(lport->lpid, qid, &fd, NULL) < 0)
+                    CNE_ERR_GOTO(leave, "failed to get file descriptors for %s\n", lport->name);
                 break;
             default:
                 break;
@@ -548,7 +569,7 @@ thread_func(void *arg)
     }
 
     for (;;) {
-        foreach_thd_lport (thd, lport) {
+        foreach_thd_lport_qid (thd, lport, qid) {
             int n_pkts;
 
             if (thd->quit == THD_QUIT) /* Make sure we check quit often to break out ASAP */
@@ -558,7 +579,7 @@ thread_func(void *arg)
                 continue;
             }
 
-            if ((n_pkts = tests[fwd->test].func(lport, fwd)) < 0)
+            if ((n_pkts = tests[fwd->test].func(lport, qid, fwd)) < 0)
                 goto leave;
 
             if (thd->idle_timeout) {
@@ -572,6 +593,8 @@ leave:
     if (fwd->test == FWD_TEST || fwd->test == L3_FWD_TEST || fwd->test == ACL_STRICT_TEST ||
         fwd->test == ACL_PERMISSIVE_TEST || fwd->test == HYPERSCAN_TEST)
         destroy_per_thread_txbuff(thd, fwd);
+    if (fwd->test == ACL_STRICT_TEST || fwd->test == ACL_PERMISSIVE_TEST)
+        acl_thread_unregister();
 leave_no_lport:
     if (imgr)
         idlemgr_destroy(imgr);
@@ -601,6 +624,7 @@ _thread_port_close(jcfg_info_t *j __cne_unused, void *obj, void *arg, int idx __
 {
     jcfg_thd_t *thd = obj;
     jcfg_lport_t *lport;
+    uint16_t qid;
     int ret;
     struct fwd_info *fwd = arg;
 
@@ -611,9 +635,13 @@ _thread_port_close(jcfg_info_t *j __cne_unused, void *obj, void *arg, int idx __
         CNE_DEBUG("Close %d lport%s for thread '%s'\n", thd->lport_cnt,
                   (thd->lport_cnt == 1) ? "" : "s", thd->name);
 
-    foreach_thd_lport (thd, lport) {
+    foreach_thd_lport_qid (thd, lport, qid) {
         struct fwd_port *pd = lport->priv_;
 
+        /* A multi-queue lport is closed once, by the thread polling its first queue */
+        if (qid)
+            continue;
+
         cne_printf(">>>    [magenta]lport [red]%d[] - '[cyan]%s[]'\n", lport->lpid, lport->name);
         switch (fwd->pkt_api) {
         case XSKDEV_PKT_API:
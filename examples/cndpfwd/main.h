@@ -97,6 +97,7 @@ typedef enum { UNKNOWN_PKT_API, XSKDEV_PKT_API, PKTDEV_PKT_API } pkt_api_t;
 struct create_txbuff_thd_priv_t {
     txbuff_t **txbuffs; /**< txbuff_t double pointer */
     pkt_api_t pkt_api;  /**< The packet API mode */
+    jcfg_thd_t *thd;    /**< Thread owning the txbuffs */
 #ifdef ENABLE_HYPERSCAN
     hs_scratch_t *scratch; /**< Scratch per thread for Hyperscan */
 #endif
@@ -120,6 +121,8 @@ struct fwd_port {
         xskdev_info_t *xsk; /**< XSKDEV information pointer */
         int lport;          /**< PKTDEV lport id */
     };
+    uint16_t qid;                        /**< Queue index within the lport polled by thd */
+    uint16_t nb_queues;                  /**< Number of fwd_port entries, one per lport queue */
     pktmbuf_t *rx_mbufs[MAX_BURST_SIZE]; /**< RX mbufs array */
     uint64_t ipackets;                   /**< previous rx packets */
     uint64_t opackets;                   /**< previous tx packets */
@@ -130,6 +133,24 @@ struct fwd_port {
     struct acl_fwd_stats prev_acl_stats; /**< previous values for ACL stats */
 };
 
+/**
+ * Return the fwd_port of a queue of the lport, each lport queue has its own fwd_port.
+ *
+ * @param lport
+ *   The lport holding the array of fwd_port structures in priv_.
+ * @param qid
+ *   The queue index within the lport.
+ * @return
+ *   The fwd_port pointer or NULL if the lport has no fwd_port for the queue.
+ */
+static inline struct fwd_port *
+fwd_port_get(jcfg_lport_t *lport, uint16_t qid)
+{
+    struct fwd_port *pd = lport->priv_;
+
+    return (pd && qid < pd->nb_queues) ? &pd[qid] : NULL;
+}
+
 struct app_options {
     bool no_metrics; /**< Enable metrics*/
     bool no_restapi; /**< Enable REST API*/
@@ -172,18 +193,21 @@ void thread_func(void *arg);
 int enable_metrics(struct fwd_info *fwd);
 int enable_uds_info(struct fwd_info *fwd);
 void print_port_stats_all(struct fwd_info *fwd);
-int acl_fwd_test(jcfg_lport_t *lport, struct fwd_info *fwd);
+int acl_fwd_test(jcfg_lport_t *lport, uint16_t qid, struct fwd_info *fwd);
 int acl_init(struct fwd_info *fwd);
 int fwd_acl_clear(uds_client_t *c, const char *cmd, const char *params);
 int fwd_acl_add_rule(uds_client_t *c, const char *cmd, const char *params);
 int fwd_acl_build(uds_client_t *c, const char *cmd, const char *params);
 int fwd_acl_read(uds_client_t *c, const char *cmd, const char *params);
+int fwd_acl_stats(metrics_client_t *c, const char *cmd, const char *params);
+int acl_thread_register(void);
+void acl_thread_unregister(void);
 int l3fwd_fib_init(struct fwd_info *fwd);
 int l3fwd_fib_lookup(uint32_t *ip, struct ether_addr *eaddr, uint16_t *tx_port, int n);
 
 int hsfwd_init(struct fwd_info *fwd);
 void hsfwd_finish(struct fwd_info *fwd);
-int hsfwd_test(jcfg_lport_t *lport, struct fwd_info *fwd);
+int hsfwd_test(jcfg_lport_t *lport, uint16_t qid, struct fwd_info *fwd);
 
 #define MAX_STRLEN_SIZE 16
 
@@ -29,7 +29,7 @@
     for (int _i = 0; _i < _t->lport_cnt && (_lp = _t->lports[_i]); _i++, _lp = _t->lports[_i])
 
 static int
-process_callback(jcfg_info_t *j __cne_unused, void *_obj, void *arg, int idx)
+process_callback(jcfg_info_t *j, void *_obj, void *arg, int idx)
 {
     jcfg_obj_t obj;
     struct fwd_info *f = arg;
@@ -121,7 +121,8 @@ process_callback(jcfg_info_t *j __cne_unused, void *_obj, void *arg, int idx)
                         total_region_cnt / 1024, obj.umem->bufcnt / 1024);
 
         /* The UMEM object describes the total size of the UMEM space */
-        obj.umem->mm = mmap_alloc(obj.umem->bufcnt, obj.umem->bufsz, obj.umem->mtype);
+        obj.umem->mm = mmap_alloc_numa(obj.umem->bufcnt, obj.umem->bufsz, obj.umem->mtype,
+                                       jcfg_umem_numa_node(j, obj.umem));
         if (obj.umem->mm == NULL)
             CNE_ERR_RET("**** Failed to allocate mmap memory %ld\n",
                         (uint64_t)obj.umem->bufcnt * (uint64_t)obj.umem->bufsz);
@@ -157,19 +158,21 @@ process_callback(jcfg_info_t *j __cne_unused, void *_obj, void *arg, int idx)
         do {
             lport = obj.lport;
             struct fwd_port *pd;
-            mmap_t *mm;
-            jcfg_umem_t *umem;
             struct lport_cfg pcfg = {0};
+            uint16_t nb_queues    = (lport->nb_queues > 1) ? lport->nb_queues : 1;
 
-            umem = lport->umem;
-            mm   = umem->mm;
+            if (nb_queues > 1 && f->pkt_api != PKTDEV_PKT_API)
+                CNE_ERR_RET("lport %s with %u queues needs the %s API\n", lport->name, nb_queues,
+                            PKTDEV_API_NAME);
 
-            pd = calloc(1, sizeof(struct fwd_port));
+            /* One fwd_port per queue, as each queue can be polled by a different thread */
+            pd = calloc(nb_queues, sizeof(struct fwd_port));
             if (!pd)
                 CNE_ERR_RET("Failed to allocate fwd_port structure\n");
 
             // Init lport to -1, so in cleanup routine we can know if we need to close it.
-            pd->lport = -1;
+            pd->lport     = -1;
+            pd->nb_queues = nb_queues;
 
             lport->priv_ = pd;
 
@@ -177,18 +180,15 @@ process_callback(jcfg_info_t *j __cne_unused, void *_obj, void *arg, int idx)
                 cne_printf("[yellow]**** [green]SKB_MODE is [red]enabled[]\n");
             if (lport->flags & LPORT_BUSY_POLLING)
                 cne_printf("[yellow]**** [green]BUSY_POLLING is [red]enabled[]\n");
-
-            pcfg.qid          = lport->qid;
-            pcfg.bufsz        = umem->bufsz;
-            pcfg.rx_nb_desc   = umem->rxdesc;
-            pcfg.tx_nb_desc   = umem->txdesc;
-            pcfg.umem_addr    = mmap_addr(mm);
-            pcfg.umem_size    = mmap_size(mm, NULL, NULL);
-            pcfg.pmd_opts     = lport->pmd_opts;
-            pcfg.busy_timeout = lport->busy_timeout;
-            pcfg.busy_budget  = lport->busy_budget;
-            pcfg.flags        = lport->flags;
-            pcfg.flags |= (umem->shared_umem == 1) ? LPORT_SHARED_UMEM : 0;
+            if (lport->flags & LPORT_MULTI_BUFFER)
+                cne_printf("[yellow]**** [green]MULTI_BUFFER is [red]enabled[]\n");
+            if (lport->flags & LPORT_TX_OWNER)
+                cne_printf("[yellow]**** [green]TX_OWNER is [red]enabled[]\n");
+            if (lport->flags & LPORT_XDP_METADATA)
+                cne_printf("[yellow]**** [green]XDP_METADATA is [red]enabled[]\n");
+
+            if (jcfg_lport_cfg(lport, &pcfg) < 0)
+                return -1;
 
             if (lport->xsk_map_path) {
                 cne_printf("[yellow]**** [green]PINNED_BPF_MAP is [red]enabled[]\n");
@@ -204,18 +204,6 @@ process_callback(jcfg_info_t *j __cne_unused, void *_obj, void *arg, int idx)
                 }
             }
 
-            pcfg.addr = jcfg_lport_region(lport, &pcfg.bufcnt);
-            if (!pcfg.addr) {
-                CNE_ERR_RET("lport %s region index %d >= %d or not configured correctly\n",
-                            lport->name, lport->region_idx, umem->region_cnt);
-            }
-            pcfg.pi = umem->rinfo[lport->region_idx].pool;
-
-            /* Setup the mempool configuration */
-            strlcpy(pcfg.pmd_name, lport->pmd_name, sizeof(pcfg.pmd_name));
-            strlcpy(pcfg.ifname, lport->netdev, sizeof(pcfg.ifname));
-            strlcpy(pcfg.name, lport->name, sizeof(pcfg.name));
-
             switch (f->pkt_api) {
             case XSKDEV_PKT_API:
                 pd->xsk = xskdev_socket_create(&pcfg);
@@ -228,6 +216,11 @@ process_callback(jcfg_info_t *j __cne_unused, void *_obj, void *arg, int idx)
                 if (pd->lport < 0) {
                     CNE_ERR_RET("pktdev_port_setup(%s) failed\n", lport->name);
                 }
+                for (uint16_t q = 1; q < nb_queues; q++) {
+                    pd[q].lport     = pd->lport;
+                    pd[q].qid       = q;
+                    pd[q].nb_queues = nb_queues;
+                }
                 break;
             default:
                 CNE_ERR_RET("lport %s API not supported %d\n", lport->name, f->pkt_api);
@@ -7,6 +7,7 @@
 #include <cne_log.h>           // for CNE_ERR_RET, CNE_LOG_ERR
 #include <metrics.h>           // for metrics_append, metrics_register, metrics_cl...
 #include <stdint.h>            // for uint64_t
+#include <string.h>            // for memset
 #include <unistd.h>            // for gethostname
 
 #include <cne_lport.h>        // for lport_stats_t
@@ -43,10 +44,27 @@ prt_cnt(int skip, int width, uint64_t cnt, int type)
     // clang-format on
 }
 
+/* Sum the ACL stats and TX overruns of all queues of the lport, p is the first queue */
+static void
+fwd_port_sum(struct fwd_port *p, struct acl_fwd_stats *acl, uint64_t *tx_overrun)
+{
+    memset(acl, 0, sizeof(*acl));
+    *tx_overrun = 0;
+
+    for (uint16_t q = 0; q < p->nb_queues; q++) {
+        acl->acl_permit += p[q].acl_stats.acl_permit;
+        acl->acl_deny += p[q].acl_stats.acl_deny;
+        acl->acl_prefilter_drop += p[q].acl_stats.acl_prefilter_drop;
+        *tx_overrun += p[q].tx_overrun;
+    }
+}
+
 static void
 print_port_stats(int lport_id, struct fwd_port *p, struct fwd_info *fwd)
 {
     lport_stats_t stats = {0};
+    struct acl_fwd_stats acl;
+    uint64_t tx_overrun;
     uint64_t rx_pps, tx_pps;
     uint64_t acl_permit_pps, acl_deny_pps, acl_prefilter_pps;
     int skip, col;
@@ -71,11 +89,13 @@ print_port_stats(int lport_id, struct fwd_port *p, struct fwd_info *fwd)
         break;
     }
 
+    fwd_port_sum(p, &acl, &tx_overrun);
+
     rx_pps            = (stats.ipackets - p->ipackets);
     tx_pps            = (stats.opackets - p->opackets);
-    acl_permit_pps    = (p->acl_stats.acl_permit - p->prev_acl_stats.acl_permit);
-    acl_deny_pps      = (p->acl_stats.acl_deny - p->prev_acl_stats.acl_deny);
-    acl_prefilter_pps = (p->acl_stats.acl_prefilter_drop - p->prev_acl_stats.acl_prefilter_drop);
+    acl_permit_pps    = (acl.acl_permit - p->prev_acl_stats.acl_permit);
+    acl_deny_pps      = (acl.acl_deny - p->prev_acl_stats.acl_deny);
+    acl_prefilter_pps = (acl.acl_prefilter_drop - p->prev_acl_stats.acl_prefilter_drop);
 
     vt_cnright(skip);
     cne_printf("[yellow]%*s [yellow]+[]\n", col, COLUMN_SEPARATOR);
@@ -103,13 +123,13 @@ print_port_stats(int lport_id, struct fwd_port *p, struct fwd_info *fwd)
 
     if (fwd->flags & FWD_ACL_STATS) {
         prt_cnt(skip, col, acl_prefilter_pps, YELLOW_TYPE);
-        prt_cnt(skip, col, p->acl_stats.acl_prefilter_drop, MAGENTA_TYPE);
+        prt_cnt(skip, col, acl.acl_prefilter_drop, MAGENTA_TYPE);
 
         prt_cnt(skip, col, acl_permit_pps, YELLOW_TYPE);
-        prt_cnt(skip, col, p->acl_stats.acl_permit, MAGENTA_TYPE);
+        prt_cnt(skip, col, acl.acl_permit, MAGENTA_TYPE);
 
         prt_cnt(skip, col, acl_deny_pps, YELLOW_TYPE);
-        prt_cnt(skip, col, p->acl_stats.acl_deny, MAGENTA_TYPE);
+        prt_cnt(skip, col, acl.acl_deny, MAGENTA_TYPE);
     }
 
     if (fwd->flags & FWD_DEBUG_STATS) {
@@ -132,7 +152,7 @@ print_port_stats(int lport_id, struct fwd_port *p, struct fwd_info *fwd)
         prt_cnt(skip, col, stats.tx_kicks, CYAN_TYPE);
         prt_cnt(skip, col, stats.tx_kick_failed, RED_TYPE);
         prt_cnt(skip, col, stats.tx_kick_again, RED_TYPE);
-        prt_cnt(skip, col, p->tx_overrun, CYAN_TYPE);
+        prt_cnt(skip, col, tx_overrun, CYAN_TYPE);
         prt_cnt(skip, col, stats.tx_ring_full, CYAN_TYPE);
         prt_cnt(skip, col, stats.tx_copied, CYAN_TYPE);
 
@@ -142,9 +162,9 @@ print_port_stats(int lport_id, struct fwd_port *p, struct fwd_info *fwd)
 
     p->ipackets                          = stats.ipackets;
     p->opackets                          = stats.opackets;
-    p->prev_acl_stats.acl_prefilter_drop = p->acl_stats.acl_prefilter_drop;
-    p->prev_acl_stats.acl_permit         = p->acl_stats.acl_permit;
-    p->prev_acl_stats.acl_deny           = p->acl_stats.acl_deny;
+    p->prev_acl_stats.acl_prefilter_drop = acl.acl_prefilter_drop;
+    p->prev_acl_stats.acl_permit         = acl.acl_permit;
+    p->prev_acl_stats.acl_deny           = acl.acl_deny;
 }
 
 static int
@@ -358,11 +378,14 @@ handle_stats(jcfg_info_t *j __cne_unused, void *obj, void *arg __cne_unused, int
 
     /* only publish ACL-related stats in one of the ACL modes */
     if (fwd->flags & FWD_ACL_STATS) {
+        struct acl_fwd_stats acl;
+        uint64_t tx_overrun;
+
+        fwd_port_sum(pd, &acl, &tx_overrun);
         metrics_append(c, ",\"%s_n_acl_prefilter_drop_packets\":%ld", lport->name,
-                       pd->acl_stats.acl_prefilter_drop);
-        metrics_append(c, ",\"%s_n_acl_permit_packets\":%ld", lport->name,
-                       pd->acl_stats.acl_permit);
-        metrics_append(c, ",\"%s_n_acl_deny_packets\":%ld", lport->name, pd->acl_stats.acl_deny);
+                       acl.acl_prefilter_drop);
+        metrics_append(c, ",\"%s_n_acl_permit_packets\":%ld", lport->name, acl.acl_permit);
+        metrics_append(c, ",\"%s_n_acl_deny_packets\":%ld", lport->name, acl.acl_deny);
     }
 
     return 0;
@@ -386,6 +409,10 @@ enable_metrics(struct fwd_info *fwd)
     if (metrics_register("/port_stats", fwd_stats) < 0)
         CNE_ERR_RET("Failed to register the metric stats\n");
 
+    if ((fwd->test == ACL_STRICT_TEST || fwd->test == ACL_PERMISSIVE_TEST) &&
+        metrics_register("/acl_stats", fwd_acl_stats) < 0)
+        CNE_ERR_RET("Failed to register the ACL build stats\n");
+
     return 0;
 }
 
@@ -33,6 +33,7 @@
 #include <cnet_chnl.h>
 #include <chnl_priv.h>
 #include <cnet_chnl_opt.h>
+#include <cnet_tcp_cc.h>
 #include <cnet_ifshow.h>
 
 #include <cne_graph.h>               // for cne_graph_cluster_stats_param
@@ -317,15 +318,18 @@ thread_func(void *arg)
     if (cnet_stk_initialize(cinfo->cnet) < 0)
         CNE_RET("cnet_stk_initialize('%s') failed\n", thd->name);
 
+    if (cinfo->opts.tcp_cc && cnet_tcp_cc_default_set(cinfo->opts.tcp_cc) < 0)
+        CNE_ERR_GOTO(stop, "Unknown TCP congestion control '%s'\n", cinfo->opts.tcp_cc);
+
     if ((tid = cne_id()) < 0)
-        CNE_ERR_GOTO(err, "Failed to get cne id\n");
+        CNE_ERR_GOTO(stop, "Failed to get cne id\n");
 
     if (tid >= cne_countof(cinfo->graph_info))
-        CNE_ERR_GOTO(err, "Number of threads cannot be >= %d\n", cne_countof(cinfo->graph_info));
+        CNE_ERR_GOTO(stop, "Number of threads cannot be >= %d\n", cne_countof(cinfo->graph_info));
     gi = &cinfo->graph_info[tid];
 
     if (initialize_graph(thd, gi))
-        CNE_ERR_GOTO(err, "Initialize_graph() failed\n");
+        CNE_ERR_GOTO(stop, "Initialize_graph() failed\n");
 
     /* Construct the options key name <thread-name>-chnl */
     snprintf(chnl_name, sizeof(chnl_name), "%s-chnl", thd->name);
@@ -342,7 +346,7 @@ thread_func(void *arg)
         char *s = chnl_array->arr[i]->str;
 
         if (!s || (s[0] == '\0'))
-            CNE_ERR_GOTO(err, "string is NULL or empty\n");
+            CNE_ERR_GOTO(stop, "string is NULL or empty\n");
 
         if (cinfo->flags & FWD_DEBUG_STATS)
             cne_printf("'[orange]%s[]'", s);
@@ -356,10 +360,15 @@ thread_func(void *arg)
         cne_printf("\r");
 
 skip:
-    while (likely(!thd->quit))
+    while (likely(!thd->quit)) {
         cne_graph_walk(gi->graph);
+        cnet_quiescent(); /* Allow deleted routes to be reclaimed */
+    }
 
+    cnet_stk_offline();
     return;
+stop:
+    cnet_stk_offline();
 err:
     if (pthread_barrier_wait(&cinfo->barrier))
         CNE_ERR("Barrier wait failed: %s\n", strerror(errno));
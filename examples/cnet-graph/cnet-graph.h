@@ -70,6 +70,7 @@ typedef enum {
 #define NO_METRICS_TAG "no-metrics" /**< json tag for no-metrics */
 #define NO_RESTAPI_TAG "no-restapi" /**< json tag for no-restapi */
 #define ENABLE_CLI_TAG "cli"        /**< json tag to enable/disable CLI */
+#define TCP_CC_TAG     "tcp-cc"     /**< json tag for the TCP congestion control */
 
 struct fwd_port {
     int lport;                           /**< PKTDEV lport id */
@@ -81,9 +82,10 @@ struct fwd_port {
 };
 
 struct app_options {
-    bool no_metrics; /**< Enable metrics*/
-    bool no_restapi; /**< Enable REST API*/
-    bool cli;        /**< Enable Cli*/
+    bool no_metrics;    /**< Enable metrics*/
+    bool no_restapi;    /**< Enable REST API*/
+    bool cli;           /**< Enable Cli*/
+    const char *tcp_cc; /**< TCP congestion control name or NULL for the default */
     unsigned int node_cnt;
     unsigned int node_sz;
     const char **nodes;
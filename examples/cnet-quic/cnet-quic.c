@@ -150,22 +150,27 @@ thread_func(void *arg)
         CNE_RET("cnet_stk_initialize('%s') failed\n", thd->name);
 
     if ((tid = cne_id()) < 0)
-        CNE_ERR_GOTO(err, "Failed to get cne id\n");
+        CNE_ERR_GOTO(stop, "Failed to get cne id\n");
 
     if (tid >= cne_countof(cinfo->graph_info))
-        CNE_ERR_GOTO(err, "Number of threads cannot be >= %d\n", cne_countof(cinfo->graph_info));
+        CNE_ERR_GOTO(stop, "Number of threads cannot be >= %d\n", cne_countof(cinfo->graph_info));
     gi = &cinfo->graph_info[tid];
 
     if (initialize_graph(thd, gi))
-        CNE_ERR_GOTO(err, "Initialize_graph() failed\n");
+        CNE_ERR_GOTO(stop, "Initialize_graph() failed\n");
 
     if (open_quic_channel() < 0)
-        CNE_ERR_GOTO(err, "Failed to create QUIC channel\n");
+        CNE_ERR_GOTO(stop, "Failed to create QUIC channel\n");
 
-    while (likely(!thd->quit))
+    while (likely(!thd->quit)) {
         cne_graph_walk(gi->graph);
+        cnet_quiescent(); /* Allow deleted routes to be reclaimed */
+    }
 
+    cnet_stk_offline();
     return;
+stop:
+    cnet_stk_offline();
 err:
     (void)pthread_barrier_wait(&cinfo->barrier);
 }
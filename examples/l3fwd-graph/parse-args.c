@@ -27,7 +27,7 @@
 #include "pktmbuf.h"           // for pktmbuf_pool_create, pktmbuf_info_t
 
 static int
-process_callback(jcfg_info_t *j __cne_unused, void *_obj, void *arg, int idx)
+process_callback(jcfg_info_t *j, void *_obj, void *arg, int idx)
 {
     jcfg_obj_t obj;
     struct fwd_info *f = arg;
@@ -61,7 +61,8 @@ process_callback(jcfg_info_t *j __cne_unused, void *_obj, void *arg, int idx)
 
     case JCFG_UMEM_TYPE:
         /* The UMEM object describes the total size of the UMEM space */
-        obj.umem->mm = mmap_alloc(obj.umem->bufcnt, obj.umem->bufsz, obj.umem->mtype);
+        obj.umem->mm = mmap_alloc_numa(obj.umem->bufcnt, obj.umem->bufsz, obj.umem->mtype,
+                                       jcfg_umem_numa_node(j, obj.umem));
         if (obj.umem->mm == NULL)
             CNE_ERR_RET("**** Failed to allocate mmap memory %ld\n",
                         (uint64_t)obj.umem->bufcnt * (uint64_t)obj.umem->bufsz);
@@ -96,42 +97,17 @@ process_callback(jcfg_info_t *j __cne_unused, void *_obj, void *arg, int idx)
         do {
             jcfg_lport_t *lport = obj.lport;
             struct fwd_port *pd;
-            mmap_t *mm;
-            jcfg_umem_t *umem;
             struct lport_cfg pcfg = {0};
 
-            umem = lport->umem;
-            mm   = umem->mm;
-
             pd = calloc(1, sizeof(struct fwd_port));
             if (!pd)
                 CNE_ERR_RET("Failed to allocate fwd_port structure\n");
             lport->priv_ = pd;
 
-            pcfg.qid          = lport->qid;
-            pcfg.bufsz        = umem->bufsz;
-            pcfg.rx_nb_desc   = umem->rxdesc;
-            pcfg.tx_nb_desc   = umem->txdesc;
-            pcfg.umem_addr    = mmap_addr(mm);
-            pcfg.umem_size    = mmap_size(mm, NULL, NULL);
-            pcfg.pmd_opts     = lport->pmd_opts;
-            pcfg.busy_timeout = lport->busy_timeout;
-            pcfg.busy_budget  = lport->busy_budget;
-            pcfg.flags        = lport->flags;
-            pcfg.flags |= (umem->shared_umem == 1) ? LPORT_SHARED_UMEM : 0;
-
-            pcfg.addr = jcfg_lport_region(lport, &pcfg.bufcnt);
-            if (!pcfg.addr) {
+            if (jcfg_lport_cfg(lport, &pcfg) < 0) {
                 free(pd);
-                CNE_ERR_RET("lport %s region index %d >= %d or not configured correctly\n",
-                            lport->name, lport->region_idx, umem->region_cnt);
+                return -1;
             }
-            pcfg.pi = umem->rinfo[lport->region_idx].pool;
-
-            /* Setup the mempool configuration */
-            strlcpy(pcfg.pmd_name, lport->pmd_name, sizeof(pcfg.pmd_name));
-            strlcpy(pcfg.ifname, lport->netdev, sizeof(pcfg.ifname));
-            strlcpy(pcfg.name, lport->name, sizeof(pcfg.name));
 
             pd->lport = pktdev_port_setup(&pcfg);
             if (pd->lport < 0) {
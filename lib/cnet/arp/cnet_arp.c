@@ -124,7 +124,7 @@ cnet_arp_delete(struct in_addr *addr)
             if (fib_info_free(fi, (uint32_t)idx) != entry)
                 CNE_WARN("Freed entry does not match\n");
 
-            cnet_arp_free(entry);
+            cnet_rcu_defer_free(this_cnet->arp_obj, entry);
             return 0;
         }
     }
@@ -39,18 +39,16 @@ chnl_callback_node_set_source(struct cne_node *node, chnl_callback_source_node_t
 static inline void
 __callback(struct pcb_entry *pcb, chnl_callback_source_node_t source)
 {
-    if (pcb->ch->ch_callback) {
-        chnl_type_t ctype;
+    chnl_type_t ctype;
 
-        if (source == CHNL_CALLBACK_SOURCE_CHNL_RECV)
-            ctype = (pcb->ip_proto == IPPROTO_TCP) ? CHNL_TCP_RECV_TYPE : CHNL_UDP_RECV_TYPE;
-        else if (source == CHNL_CALLBACK_SOURCE_ETH_TX)
-            ctype = (pcb->ip_proto == IPPROTO_TCP) ? CHNL_TCP_SENT_TYPE : CHNL_UDP_SENT_TYPE;
-        else
-            return;
+    if (source == CHNL_CALLBACK_SOURCE_CHNL_RECV)
+        ctype = (pcb->ip_proto == IPPROTO_TCP) ? CHNL_TCP_RECV_TYPE : CHNL_UDP_RECV_TYPE;
+    else if (source == CHNL_CALLBACK_SOURCE_ETH_TX)
+        ctype = (pcb->ip_proto == IPPROTO_TCP) ? CHNL_TCP_SENT_TYPE : CHNL_UDP_SENT_TYPE;
+    else
+        return;
 
-        pcb->ch->ch_callback(ctype, pcb->ch->ch_cd);
-    }
+    chnl_notify(pcb->ch, ctype);
 }
 
 static uint16_t
@@ -99,6 +97,22 @@ chnl_callback_node_process(struct cne_graph *graph __cne_unused, struct cne_node
 
         if (source == CHNL_CALLBACK_SOURCE_CHNL_RECV) {
             cb = &pcb->ch->ch_rcv;
+
+            /* A stream packet merged by tcp_gro is queued as one mbuf per segment */
+            if (mbuf->nb_segs > 1 && pcb->ch->ch_proto->type == SOCK_STREAM) {
+                pktmbuf_t *next;
+
+                for (; mbuf; mbuf = next) {
+                    next          = mbuf->next;
+                    mbuf->next    = NULL;
+                    mbuf->nb_segs = 1;
+
+                    vec_add(cb->cb_vec, mbuf);
+                    cb->cb_cc += pktmbuf_data_len(mbuf);
+                }
+                continue;
+            }
+
             vec_add(cb->cb_vec, mbuf);
             cb->cb_cc += pktmbuf_data_len(mbuf);
         }
@@ -0,0 +1,223 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright (c) 2023 Intel Corporation
+ */
+
+#include <errno.h>              // for EINVAL, EBUSY, EXDEV, ENOMEM
+#include <stdlib.h>             // for calloc, free
+#include <cnet.h>               // for cnet, this_cnet
+#include <cne_ring.h>           // for cne_ring_create, cne_ring_free
+#include <cne_ring_api.h>       // for cne_ring_enqueue_elem, cne_ring_dequeue_burst_elem
+#include <cne_cycles.h>         // for cne_rdtsc, cne_get_timer_hz
+#include <cne_pause.h>          // for cne_pause
+#include <cne_common.h>         // for cne_align32pow2, CNE_MIN
+#include <cne_log.h>            // for CNE_ERR_RET, CNE_NULL_RET
+#include <cnet_const.h>         // for __errno_set
+
+#include "chnl_priv.h"
+#include <cnet_chnl.h>
+
+#define CHNL_EVQ_BURST 64 /**< Number of channel descriptors dequeued at a time */
+
+struct chnl_evq {
+    cne_ring_t *ring;  /**< MP/SC ring of channel descriptors with events pending */
+    int stk_id;        /**< Stack instance of the channels, -1 until a channel is added */
+    uint32_t nb_chnls; /**< Number of channels in the queue */
+    uint8_t queued[];  /**< Non-zero while the channel descriptor is in the ring */
+};
+
+/* Event reported to the queue for each callback type */
+static const uint32_t evq_events[CHNL_CALLBACK_TYPES] = {
+    [CHNL_UDP_SENT_TYPE]        = CHNL_EV_SENT,
+    [CHNL_UDP_RECV_TYPE]        = CHNL_EV_RECV,
+    [CHNL_UDP_CLOSE_TYPE]       = CHNL_EV_CLOSE,
+    [CHNL_TCP_SENT_TYPE]        = CHNL_EV_SENT,
+    [CHNL_TCP_ESTABLISHED_TYPE] = CHNL_EV_ESTABLISHED,
+    [CHNL_TCP_RECV_TYPE]        = CHNL_EV_RECV,
+    [CHNL_TCP_CLOSE_TYPE]       = CHNL_EV_CLOSE,
+};
+
+/*
+ * Merge the events into the pending events of the channel, the descriptor is only queued when
+ * no event was pending and it is not in the ring already. A descriptor left in the ring by a
+ * channel removed from the queue, or by a freed channel, stays marked as queued until the
+ * consumer dequeues it, so a descriptor is never in the ring more than once and the ring never
+ * fills up.
+ */
+static inline void
+evq_post(struct chnl *ch, uint32_t ev)
+{
+    struct chnl_evq *evq = ch->ch_evq;
+    uint32_t cd          = ch->ch_cd;
+
+    ev &= ch->ch_evmask;
+    if (!ev || __atomic_fetch_or(&ch->ch_evpend, ev, __ATOMIC_ACQ_REL))
+        return;
+
+    if (__atomic_exchange_n(&evq->queued[cd], 1, __ATOMIC_ACQ_REL))
+        return;
+
+    if (cne_ring_enqueue_elem(evq->ring, &cd, sizeof(cd)) < 0) {
+        __atomic_store_n(&evq->queued[cd], 0, __ATOMIC_RELEASE);
+        __atomic_store_n(&ch->ch_evpend, 0, __ATOMIC_RELEASE);
+        CNE_ERR("Event queue is full, events of channel %d lost\n", cd);
+    }
+}
+
+static inline void
+evq_detach(struct chnl_evq *evq, struct chnl *ch)
+{
+    ch->ch_evq    = NULL;
+    ch->ch_evmask = 0;
+    __atomic_store_n(&ch->ch_evpend, 0, __ATOMIC_RELEASE);
+
+    if (__atomic_sub_fetch(&evq->nb_chnls, 1, __ATOMIC_ACQ_REL) == 0)
+        evq->stk_id = -1;
+}
+
+void
+chnl_evq_post(struct chnl *ch, int ctype)
+{
+    if (ctype >= 0 && ctype < CHNL_CALLBACK_TYPES)
+        evq_post(ch, evq_events[ctype]);
+}
+
+struct chnl_evq *
+chnl_evq_create(const char *name)
+{
+    struct cnet *cnet = this_cnet;
+    struct chnl_evq *evq;
+
+    if (!cnet || !name)
+        CNE_NULL_RET("Invalid cnet pointer or event queue name\n");
+
+    evq = calloc(1, sizeof(struct chnl_evq) + cnet->num_chnls);
+    if (!evq)
+        CNE_NULL_RET("Failed to allocate event queue %s\n", name);
+
+    /*
+     * Room for every channel descriptor, as each descriptor is queued at most once. The stack
+     * thread posts events while chnl_evq_add() posts from the application thread, so the ring
+     * is MP.
+     */
+    evq->stk_id = -1;
+    evq->ring   = cne_ring_create(name, sizeof(uint32_t), cne_align32pow2(cnet->num_chnls + 1),
+                                  RING_F_SC_DEQ);
+    if (!evq->ring) {
+        free(evq);
+        CNE_NULL_RET("Failed to create event queue ring %s\n", name);
+    }
+
+    return evq;
+}
+
+void
+chnl_evq_destroy(struct chnl_evq *evq)
+{
+    struct cnet *cnet = this_cnet;
+
+    if (!evq)
+        return;
+
+    for (int cd = 0; cnet && evq->nb_chnls && cd < (int)cnet->num_chnls; cd++) {
+        struct chnl *ch = ch_get(cd);
+
+        if (ch && ch->ch_evq == evq)
+            evq_detach(evq, ch);
+    }
+
+    cne_ring_free(evq->ring);
+    free(evq);
+}
+
+int
+chnl_evq_add(struct chnl_evq *evq, int cd, uint32_t events)
+{
+    struct chnl *ch = ch_get(cd);
+
+    if (!evq || !ch || chnl_state_tst(ch, _CHNL_FREE) || !events || (events & ~CHNL_EV_ALL))
+        return __errno_set(EINVAL);
+
+    if (ch->ch_evq && ch->ch_evq != evq)
+        CNE_ERR_RET_VAL(__errno_set(EBUSY), "Channel %d is in another event queue\n", cd);
+
+    if (evq->stk_id >= 0 && evq->stk_id != ch->stk_id)
+        CNE_ERR_RET_VAL(__errno_set(EXDEV), "Channel %d is not on the stack of the queue\n", cd);
+
+    if (!ch->ch_evq) {
+        __atomic_store_n(&ch->ch_evpend, 0, __ATOMIC_RELEASE);
+        evq->stk_id = ch->stk_id;
+        __atomic_fetch_add(&evq->nb_chnls, 1, __ATOMIC_ACQ_REL);
+    }
+    ch->ch_evmask = events;
+    ch->ch_evq    = evq;
+
+    /* Data received before the channel was added would not be reported otherwise */
+    if (cb_avail(&ch->ch_rcv))
+        evq_post(ch, CHNL_EV_RECV);
+
+    return 0;
+}
+
+int
+chnl_evq_del(int cd)
+{
+    struct chnl *ch = ch_get(cd);
+
+    if (!ch || !ch->ch_evq)
+        return __errno_set(EINVAL);
+
+    evq_detach(ch->ch_evq, ch);
+
+    return 0;
+}
+
+int
+chnl_evq_wait(struct chnl_evq *evq, struct chnl_event *evs, int max, int timeout_ms)
+{
+    uint32_t cds[CHNL_EVQ_BURST];
+    uint64_t deadline = 0;
+    int n             = 0;
+
+    if (!evq || !evs || max <= 0)
+        return __errno_set(EINVAL);
+
+    if (timeout_ms > 0)
+        deadline = cne_rdtsc() + (cne_get_timer_hz() * (uint64_t)timeout_ms) / 1000;
+
+    for (;;) {
+        while (n < max) {
+            uint32_t nb = cne_ring_dequeue_burst_elem(
+                evq->ring, cds, sizeof(uint32_t), CNE_MIN(max - n, CHNL_EVQ_BURST), NULL);
+
+            if (nb == 0)
+                break;
+
+            for (uint32_t i = 0; i < nb; i++) {
+                struct chnl *ch;
+                uint32_t ev;
+
+                /* Unmark before taking the events, so an event posted after that queues again */
+                __atomic_store_n(&evq->queued[cds[i]], 0, __ATOMIC_RELEASE);
+
+                /* The channel was removed, or freed and its descriptor reused, since queued */
+                ch = ch_get(cds[i]);
+                if (!ch || ch->ch_evq != evq)
+                    continue;
+
+                ev = __atomic_exchange_n(&ch->ch_evpend, 0, __ATOMIC_ACQ_REL);
+                if (ev) {
+                    evs[n].cd     = cds[i];
+                    evs[n].events = ev;
+                    n++;
+                }
+            }
+        }
+
+        if (n || timeout_ms == 0 || (timeout_ms > 0 && cne_rdtsc() >= deadline))
+            break;
+
+        cne_pause();
+    }
+
+    return n;
+}
@@ -73,7 +73,9 @@ struct chnl {
     uint16_t ch_state;              /**< Current state of channel */
     uint16_t ch_error;              /**< Error value */
     int ch_cd;                      /**< Channel descriptor index value */
-    pthread_mutex_t ch_mutex;       /**< Mutex for buffer */
+    uint32_t ch_evmask;             /**< CHNL_EV_* events reported to ch_evq */
+    uint32_t ch_evpend;             /**< Events pending in ch_evq */
+    struct chnl_evq *ch_evq;        /**< Event queue of the channel or NULL */
     struct pcb_entry *ch_pcb;       /**< Pointer to the PCB */
     struct protosw_entry *ch_proto; /**< Current proto value */
     chnl_cb_t ch_callback;          /**< Channel callback routine */
@@ -97,6 +99,9 @@ enum {
 
 #define _STATE_MASK 0x000f /**< Channel state mask */
 
+/** Bit of a SO_CHANNEL flag option in chnl.ch_options, the option values are below 16 */
+#define CHNL_OPT_BIT(opt) (1 << (opt))
+
 /**
  * Return the current channel state value
  *
@@ -424,6 +429,33 @@ void chnl_cleanup(struct chnl *ch);
  */
 struct chnl *__chnl_create(int32_t dom, int32_t type, int32_t pro, struct pcb_entry *pcb);
 
+/**
+ * Post an event of a channel to its event queue.
+ *
+ * @param ch
+ *   The channel structure pointer, ch_evq must be set.
+ * @param ctype
+ *   The chnl_type_t callback type of the event.
+ */
+void chnl_evq_post(struct chnl *ch, int ctype);
+
+/**
+ * Report an event of a channel to its event queue or else to its callback.
+ *
+ * @param ch
+ *   The channel structure pointer
+ * @param ctype
+ *   The chnl_type_t callback type of the event.
+ */
+static inline void
+chnl_notify(struct chnl *ch, int ctype)
+{
+    if (ch->ch_evq)
+        chnl_evq_post(ch, ctype);
+    else if (ch->ch_callback)
+        ch->ch_callback(ctype, ch->ch_cd);
+}
+
 /**
  * Validate the chnl_buf structure and print a message if invalid
  *
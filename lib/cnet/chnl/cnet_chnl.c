@@ -17,7 +17,6 @@
 #include <errno.h>         // for EFAULT, EINVAL, EADDRINUSE, EADDRNOTAVAIL
 #include <string.h>        // for memcpy, memset, strerror
 #include <cnet_meta.h>
-#include <cne_mutex_helper.h>
 
 #include "cne_common.h"        // for __cne_unused, CNE_MIN, CNE_SET_USED
 #include "cne_log.h"           // for cne_panic
@@ -100,14 +99,15 @@ free_chnl(struct chnl *ch)
     if (!ch || !stk || !stk->chnl_objs)
         CNE_RET("Free for channel structure failed\n");
 
+    /* Leave the event queue, the waiter skips the descriptor if it is still queued */
+    if (ch->ch_evq)
+        chnl_evq_del(ch->ch_cd);
+
     free_cd(ch);
 
     vec_free(ch->ch_rcv.cb_vec);
     vec_free(ch->ch_snd.cb_vec);
 
-    if (cne_mutex_destroy(&ch->ch_mutex))
-        CNE_RET("Failed to destroy ch_mutex\n");
-
     mp_init(stk->chnl_objs, NULL, (void *)ch, 0);
 
     mempool_put(stk->chnl_objs, (void *)ch);
@@ -536,6 +536,7 @@ chnl_connect(int cd, struct sockaddr *sa, int namelen)
         }
 
         in_caddr_copy(&ch->ch_pcb->key.faddr, &faddr);
+        cnet_pcb_rehash(ch->ch_pcb);
 
         if (psw && psw->funcs)
             rs = psw->funcs->connect_func(ch, name, namelen);
@@ -848,6 +849,7 @@ chnl_bind_common(struct chnl *ch, struct in_caddr *addr, int32_t len, struct pcb
     /* addr == NULL we return 0 */
     if (!addr) {
         in_caddr_zero(&ch->ch_pcb->key.laddr);
+        cnet_pcb_rehash(ch->ch_pcb);
         CNE_ERR_RET_VAL(0, "Address is NULL\n");
     }
 
@@ -910,7 +912,7 @@ chnl_bind_common(struct chnl *ch, struct in_caddr *addr, int32_t len, struct pcb
         CIN_PORT(&laddr) = CIN_PORT(&key.laddr);
     }
     /* else check for acceptable reuse of local port numbers. */
-    else if (ch->ch_options & SO_REUSEPORT) {
+    else if (ch->ch_options & CHNL_OPT_BIT(SO_REUSEPORT)) {
         /*
          * SO_REUSEPORT allows a completely duplicate binding, but only if
          * all chnls using the addr/port (including the first) have
@@ -919,9 +921,9 @@ chnl_bind_common(struct chnl *ch, struct in_caddr *addr, int32_t len, struct pcb
         struct pcb_entry *pcb;
 
         if (((pcb = cnet_pcb_lookup(hd, &key, EXACT_MATCH)) != NULL) &&
-            ((pcb->ch->ch_options & SO_REUSEPORT) == 0))
+            ((pcb->ch->ch_options & CHNL_OPT_BIT(SO_REUSEPORT)) == 0))
             return __errno_set(EADDRINUSE);
-    } else if (ch->ch_options & SO_REUSEADDR) {
+    } else if (ch->ch_options & CHNL_OPT_BIT(SO_REUSEADDR)) {
         /*
          * SO_REUSEADDR allows two chnls to bind to the same port,
          * but only if they have different addresses.
@@ -931,8 +933,14 @@ chnl_bind_common(struct chnl *ch, struct in_caddr *addr, int32_t len, struct pcb
     } else if (cnet_pcb_lookup(hd, &key, BEST_MATCH) != NULL)
         return __errno_set(EADDRINUSE);
 
+    /* The SO_REUSEPORT groups are checked on all of the stack instances */
+    if (cnet_pcb_reuseport_join(ch->ch_pcb, &laddr,
+                                (ch->ch_options & CHNL_OPT_BIT(SO_REUSEPORT)) != 0))
+        return __errno_set(EADDRINUSE);
+
     /* Setup the local address */
     in_caddr_copy(&ch->ch_pcb->key.laddr, &laddr);
+    cnet_pcb_rehash(ch->ch_pcb);
 
     return 0;
 }
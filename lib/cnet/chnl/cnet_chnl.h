@@ -75,6 +75,23 @@ typedef enum {
     CHNL_CALLBACK_TYPES        /**< Maximum number of callback types */
 } chnl_type_t;
 
+/** Readiness events reported by a channel event queue */
+enum {
+    CHNL_EV_RECV        = 0x01, /**< Data is ready to be received */
+    CHNL_EV_SENT        = 0x02, /**< Send completed, more data can be sent */
+    CHNL_EV_ESTABLISHED = 0x04, /**< Connection established or ready to be accepted */
+    CHNL_EV_CLOSE       = 0x08, /**< Connection closed */
+    CHNL_EV_ALL         = 0x0F, /**< All of the events */
+};
+
+/** A channel and the events found ready on it by chnl_evq_wait() */
+struct chnl_event {
+    int cd;          /**< Channel descriptor */
+    uint32_t events; /**< CHNL_EV_* events ready on the channel */
+};
+
+struct chnl_evq;
+
 /**
  * @brief Dump out a channel structure
  *
@@ -360,6 +377,83 @@ CNDP_API int chnl_shutdown(int cd, int how);
  */
 CNDP_API int chnl_open(const char *str, int flags, chnl_cb_t fn);
 
+/**
+ * Create a channel event queue.
+ *
+ * An event queue gathers the readiness of many channels of one stack instance, a channel
+ * added to the queue reports its events to the queue in place of its channel callback.
+ * The stack thread posts a channel to the queue once when the first event is pending and
+ * the events found until the application collects them are merged, so a busy channel
+ * takes one entry in the queue no matter how many packets it gets.
+ *
+ * The queue is a multi producer and single consumer ring, events are posted by the stack
+ * thread and by chnl_evq_add() but only one application thread can wait on a queue.
+ *
+ * @param name
+ *   The name of the event queue.
+ * @return
+ *   NULL on error or the event queue pointer.
+ */
+CNDP_API struct chnl_evq *chnl_evq_create(const char *name);
+
+/**
+ * Destroy a channel event queue, the channels still in the queue are removed.
+ *
+ * @param evq
+ *   The event queue pointer, can be NULL.
+ */
+CNDP_API void chnl_evq_destroy(struct chnl_evq *evq);
+
+/**
+ * Add a channel to an event queue or change the events it reports.
+ *
+ * All of the channels of a queue must belong to the same stack instance. A channel with
+ * received data already queued is posted to the queue when it is added, and a channel is
+ * removed from its queue when it is freed.
+ *
+ * @param evq
+ *   The event queue pointer.
+ * @param cd
+ *   The channel descriptor to add.
+ * @param events
+ *   The CHNL_EV_* events to report for the channel.
+ * @return
+ *   -1 on error or 0 on success
+ */
+CNDP_API int chnl_evq_add(struct chnl_evq *evq, int cd, uint32_t events);
+
+/**
+ * Remove a channel from its event queue, the channel callback is used again.
+ *
+ * @param cd
+ *   The channel descriptor to remove.
+ * @return
+ *   -1 on error or 0 on success
+ */
+CNDP_API int chnl_evq_del(int cd);
+
+/**
+ * Collect the channels with events ready from an event queue.
+ *
+ * The events of a channel are cleared when returned, the channel is posted again on the
+ * next event. When the application runs on the same thread as the stack the timeout must
+ * be zero, as the stack can not run while the thread waits.
+ *
+ * @param evq
+ *   The event queue pointer.
+ * @param evs
+ *   The array to fill with the ready channels and their events.
+ * @param max
+ *   Number of entries in the evs array.
+ * @param timeout_ms
+ *   Zero to return at once, a negative value to wait until an event is ready or the
+ *   number of milliseconds to wait for an event.
+ * @return
+ *   -1 on error or the number of entries filled in evs.
+ */
+CNDP_API int chnl_evq_wait(struct chnl_evq *evq, struct chnl_event *evs, int max,
+                           int timeout_ms);
+
 #ifdef __cplusplus
 }
 #endif
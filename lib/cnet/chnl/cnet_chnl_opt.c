@@ -330,12 +330,12 @@ chnl_set_opt(int cd, int level, int optname, const void *optval, int optlen)
             /* flag options */
             case SO_KEEPALIVE:
             case SO_BROADCAST:
-                setsockoptBit(ch->ch_options, optname, val);
+                setsockoptBit(ch->ch_options, CHNL_OPT_BIT(optname), val);
                 break;
 
             case SO_REUSEADDR:
             case SO_REUSEPORT:
-                setsockoptBit(ch->ch_options, optname, val);
+                setsockoptBit(ch->ch_options, CHNL_OPT_BIT(optname), val);
                 break;
 
             case SO_SNDBUF:
@@ -543,7 +543,7 @@ chnl_get_opt(int cd, int level, int optname, void *optval, socklen_t *optlen)
             case SO_KEEPALIVE:
             case SO_BROADCAST:
             case SO_REUSEPORT:
-                resI = (int)((ch->ch_options & optname) != 0);
+                resI = (int)((ch->ch_options & CHNL_OPT_BIT(optname)) != 0);
                 break;
 
             /* value options */
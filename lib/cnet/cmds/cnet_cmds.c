@@ -182,10 +182,11 @@ dump_mbuf(void)
     _off(e, packet_type);
 
     _off(e, refcnt);
-    _off(e, rsvd16);
+    _off(e, nb_segs);
     _off(e, tx_offload);
     _off(e, ol_flags);
     _off(e, udata64);
+    _off(e, next);
 
     return 0;
 }
@@ -739,6 +740,14 @@ cmd_tcp(int argc, char **argv)
         _(tcp_rexmit);
         _(resets_sent);
         _(tcp_connect);
+        _(sack_rexmit);
+        _(rack_lost);
+        _(tlp_probes);
+        _(dsack_rcvd);
+        _(gso_sends);
+        _(gso_frames);
+        _(gro_merged);
+        _(paced);
         break;
     default:
         return cli_cmd_error("Command invalid", "tcp", argc, argv);
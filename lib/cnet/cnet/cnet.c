@@ -22,6 +22,9 @@
 #include <cne_log.h>         // for CNE_LOG, CNE_LOG_ERR
 #include <cne_ring.h>        // for cne_ring_create
 #include <cne_hash.h>
+#include <cne_rcu_qsbr.h>        // for cne_rcu_qsbr_create, cne_rcu_qsbr_dq_create
+#include <mempool.h>             // for mempool_put
+#include <cnet_fib_info.h>       // for fib_info
 #include <pktdev_api.h>         // for pktdev_port_count
 #include <pktdev_core.h>        // for cne_pktdev, pktdev_data
 #include <pmd_ring.h>
@@ -37,6 +40,14 @@
 static struct cnet cnet_data, *__cnet;
 static pthread_spinlock_t __cnet_lock;
 
+#define CNET_RCU_DQ_RECLAIM_MAX 32 /**< Max objects to reclaim from the defer queue in one call */
+
+/* Entry placed on the RCU defer queue by cnet_rcu_defer_free() */
+struct cnet_rcu_obj {
+    struct cne_mempool *mp;
+    void *obj;
+};
+
 struct cnet *
 cnet_get(void)
 {
@@ -59,6 +70,79 @@ cnet_unlock(void)
         CNE_ERR("Failed to unlock CNET: %s\n", strerror(errno));
 }
 
+static void
+cnet_rcu_free_obj(void *p __cne_unused, void *e, unsigned int n __cne_unused)
+{
+    struct cnet_rcu_obj *ent = e;
+
+    mempool_put(ent->mp, ent->obj);
+}
+
+int
+cnet_rcu_defer_free(struct cne_mempool *mp, void *obj)
+{
+    struct cnet *cnet       = this_cnet;
+    struct cnet_rcu_obj ent = {.mp = mp, .obj = obj};
+
+    if (!mp || !obj)
+        return -1;
+
+    if (!cnet || !cnet->rcu_dq) {
+        mempool_put(mp, obj);
+        return 0;
+    }
+
+    if (cne_rcu_qsbr_dq_enqueue(cnet->rcu_dq, &ent)) {
+        /* Defer queue is full, wait for the stack threads and free it now */
+        cne_rcu_qsbr_synchronize(cnet->rcu, CNE_QSBR_THRID_INVALID);
+        mempool_put(mp, obj);
+    }
+
+    return 0;
+}
+
+static int
+cnet_rcu_create(struct cnet *cnet)
+{
+    struct cne_rcu_qsbr_dq_parameters params = {0};
+    struct cne_fib_rcu_config cfg            = {0};
+
+    cnet->rcu = cne_rcu_qsbr_create();
+    if (!cnet->rcu)
+        CNE_ERR_RET("Failed to create RCU QSBR variable\n");
+
+    params.name             = "cnet_rcu";
+    params.size             = (cnet->num_routes * 2) + cnet->num_arps + cnet->num_neighs;
+    params.max_reclaim_size = CNET_RCU_DQ_RECLAIM_MAX;
+    params.esize            = sizeof(struct cnet_rcu_obj);
+    params.free_fn          = cnet_rcu_free_obj;
+    params.v                = cnet->rcu;
+
+    cnet->rcu_dq = cne_rcu_qsbr_dq_create(&params);
+    if (!cnet->rcu_dq)
+        CNE_ERR_RET("Failed to create RCU defer queue\n");
+
+    /* tbl8 groups released by route updates wait for the stack threads */
+    cfg.v    = cnet->rcu;
+    cfg.mode = CNE_FIB_QSBR_MODE_DQ;
+    if (cne_fib_rcu_qsbr_add(cnet->rt4_finfo->fib, &cfg) ||
+        cne_fib_rcu_qsbr_add(cnet->arp_finfo->fib, &cfg) ||
+        cne_fib6_rcu_qsbr_add(cnet->rt6_finfo->fib6, &cfg) ||
+        cne_fib6_rcu_qsbr_add(cnet->nd6_finfo->fib6, &cfg))
+        CNE_ERR_RET("Failed to attach RCU QSBR to FIB tables\n");
+
+    return 0;
+}
+
+static void
+cnet_rcu_destroy(struct cnet *cnet)
+{
+    /* The stack threads are stopped, so everything on the queue can be reclaimed */
+    if (cnet->rcu_dq && cne_rcu_qsbr_dq_delete(cnet->rcu_dq))
+        CNE_WARN("RCU defer queue still has pending objects\n");
+    cnet->rcu_dq = NULL;
+}
+
 struct cnet *
 cnet_config_create(uint32_t num_chnls, uint32_t num_routes)
 {
@@ -87,6 +171,9 @@ cnet_config_create(uint32_t num_chnls, uint32_t num_routes)
         if (cnet_nd6_create(cnet, 0, 0) < 0)
             CNE_ERR_GOTO(leave, "Failed to create nd6\n");
 
+        if (cnet_rcu_create(cnet) < 0)
+            CNE_ERR_GOTO(leave, "Failed to create RCU\n");
+
         if (cnet_netlink_create(cnet) < 0)
             CNE_ERR_GOTO(leave, "Failed to create netlink\n");
 
@@ -118,11 +205,13 @@ cnet_stop(void)
 
     if (cnet && cnet_lock()) {
         cnet_drv_destroy(cnet);
+        cnet_netlink_destroy(cnet); /* Stop the table writer before reclaiming */
+        cnet_rcu_destroy(cnet);
         cnet_route4_destroy(cnet);
         cnet_route6_destroy(cnet);
         cnet_arp_destroy(cnet);
         cnet_nd6_destroy(cnet);
-        cnet_netlink_destroy(cnet);
+        cne_rcu_qsbr_free(cnet->rcu);
 
         vec_free(cnet->stks);
         vec_free(cnet->drvs);
@@ -132,6 +221,10 @@ cnet_stop(void)
             CNE_ERR("Failed to unregister UID\n");
         vec_free(cnet->chnl_descriptors);
 
+        for (uint32_t i = 0; i < vec_len(cnet->reuseport); i++)
+            free(cnet->reuseport[i]);
+        vec_free(cnet->reuseport);
+
         __cnet = NULL;
         memset(&cnet_data, 0, sizeof(cnet_data));
         cnet_unlock();
@@ -19,6 +19,8 @@
 #include <stdint.h>            // for uint16_t, int32_t
 
 #include <cne_common.h>        // for CNE_MAX_ETHPORTS, __cne_cache_aligned
+#include <cne.h>               // for cne_id
+#include <cne_rcu_qsbr.h>      // for cne_rcu_qsbr_quiescent, cne_rcu_qsbr
 #include <uid.h>
 
 #ifdef __cplusplus
@@ -29,6 +31,7 @@ struct stk_s;
 struct drv_entry;
 struct cne_mempool;
 struct fib_info;
+struct pcb_reuseport;
 
 struct cnet {
     CNE_ATOMIC(uint_fast16_t) stk_order; /**< Order of the stack initializations */
@@ -55,6 +58,9 @@ struct cnet {
     struct fib_info *nd6_finfo;          /**< NDP (for IPv6) FIB table pointer */
     struct fib_info *pcb_finfo;          /**< PCB FIB table pointer */
     struct fib_info *tcb_finfo;          /**< TCB FIB table pointer */
+    struct cne_rcu_qsbr *rcu;            /**< QSBR variable for the lock free table readers */
+    struct cne_rcu_qsbr_dq *rcu_dq;      /**< Defer queue for route and neighbor objects */
+    struct pcb_reuseport **reuseport;    /**< SO_REUSEPORT groups of all of the stacks */
 } __cne_cache_aligned;
 
 enum {
@@ -71,6 +77,38 @@ enum {
 struct cnet *cnet_get(void);
 #define this_cnet cnet_get()
 
+/**
+ * @brief Report a quiescent state for the calling stack thread.
+ *
+ * The forwarding nodes read the route, ARP and ND6 tables without a lock, so
+ * entries removed by the netlink thread are only reclaimed once every stack
+ * thread has called this routine. Call it between graph walks, when the thread
+ * holds no references to table entries.
+ *
+ * @return
+ *   N/A
+ */
+static inline void
+cnet_quiescent(void)
+{
+    struct cnet *cnet = cnet_get();
+
+    if (likely(cnet && cnet->rcu))
+        cne_rcu_qsbr_quiescent(cnet->rcu, cne_id());
+}
+
+/**
+ * @brief Free a table object back to its mempool once the readers are done with it.
+ *
+ * @param mp
+ *   The mempool the object was allocated from.
+ * @param obj
+ *   The object already removed from the FIB and fib_info tables.
+ * @return
+ *   -1 on error or 0 on success
+ */
+CNDP_API int cnet_rcu_defer_free(struct cne_mempool *mp, void *obj);
+
 /**
  * @brief Lock the cnet structure.
  *
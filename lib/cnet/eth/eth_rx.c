@@ -32,14 +32,12 @@
 
 static struct eth_rx_node_main eth_rx_main;
 
+/* The packet type and header lengths are set by cne_get_ptype_bulk() */
 static __cne_always_inline void
 mbuf_update(pktmbuf_t *m, uint16_t lpid)
 {
-    struct cne_net_hdr_lens hdr_lens;
     struct cne_ether_hdr *eth_hdr;
 
-    m->packet_type = cne_get_ptype(m, &hdr_lens, CNE_PTYPE_ALL_MASK);
-
     m->ol_flags = 0;
 
     eth_hdr = pktmbuf_mtod(m, struct cne_ether_hdr *);
@@ -52,11 +50,7 @@ mbuf_update(pktmbuf_t *m, uint16_t lpid)
     else if (ether_addr_is_multicast(&eth_hdr->d_addr))
         m->ol_flags |= CNE_MBUF_TYPE_MCAST;
 
-    m->tx_offload = 0;
-    m->l2_len     = hdr_lens.l2_len;
-    m->l3_len     = hdr_lens.l3_len;
-    m->l4_len     = hdr_lens.l4_len;
-    m->lport      = lpid;
+    m->lport = lpid;
 
     /* Skip past the L2 header */
     pktmbuf_adj_offset(m, m->l2_len);
@@ -72,24 +66,10 @@ eth_pkt_parse(eth_rx_node_ctx_t *ctx, pktmbuf_t **mbufs, uint16_t nb_pkts)
     n_left = nb_pkts;
     lpid   = ctx->port_id;
 
-    /* Prefetch next-next pktmbufs */
-    if (n_left >= 4) {
-        cne_prefetch0(pktmbuf_mtod(pkts[0], void *));
-        cne_prefetch0(pktmbuf_mtod(pkts[1], void *));
-        cne_prefetch0(pktmbuf_mtod(pkts[2], void *));
-        cne_prefetch0(pktmbuf_mtod(pkts[3], void *));
-    }
+    /* Packet type, header lengths and flow hash of the whole burst */
+    cne_get_ptype_bulk(mbufs, nb_pkts);
 
     while (n_left >= 4) {
-        /* Prefetch next-next pktmbufs */
-        if (likely(n_left >= 8)) {
-            cne_prefetch0(pktmbuf_mtod(pkts[4], void *));
-            cne_prefetch0(pktmbuf_mtod(pkts[5], void *));
-            cne_prefetch0(pktmbuf_mtod(pkts[6], void *));
-            cne_prefetch0(pktmbuf_mtod(pkts[7], void *));
-        }
-
-        /* Extract ptype of mbuf0, mbuf1, mbuf2, mbuf3 */
         mbuf_update(pkts[0], lpid);
         mbuf_update(pkts[1], lpid);
         mbuf_update(pkts[2], lpid);
@@ -0,0 +1,547 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright (c) 2023 Intel Corporation
+ */
+
+#include <stdlib.h>                  // for calloc, free
+#include <string.h>                  // for memcmp, memcpy, memset
+#include <netinet/in.h>              // for IPPROTO_FRAGMENT
+#include <cne_common.h>              // for CNE_MIN, cne_align32pow2, __cne_unused
+#include <cne_cycles.h>              // for cne_rdtsc
+#include <cne_system.h>              // for cne_get_timer_hz
+#include <cne_jhash.h>               // for cne_jhash
+#include <cne_log.h>                 // for CNE_NULL_RET, CNE_ERR_RET, CNE_ERR_GOTO
+#include <cne_stdio.h>               // for cne_printf
+#include <cne.h>                     // for cne_id
+#include <net/cne_ip.h>              // for __cne_raw_cksum, cne_ipv4_hdr, cne_ipv6_hdr
+#include <pktmbuf.h>                 // for pktmbuf_t, pktmbuf_free, pktmbuf_attach
+
+#include "cnet_frag.h"
+
+static inline bool
+frag_flow_expired(struct frag_tbl *tbl, struct frag_flow *f, uint64_t now)
+{
+    return (now - f->start) > tbl->ttl;
+}
+
+static void
+frag_flow_free(struct frag_tbl *tbl, struct frag_flow *f, bool free_mbufs)
+{
+    if (free_mbufs) {
+        for (uint16_t i = 0; i < f->nb_frags; i++)
+            pktmbuf_free(f->frags[i].m);
+    }
+
+    tbl->nb_mbufs -= f->nb_segs;
+    tbl->nb_flows--;
+
+    memset(&f->key, 0, sizeof(f->key));
+    f->total_len = 0;
+    f->rcvd_len  = 0;
+    f->nb_segs   = 0;
+    f->nb_frags  = 0;
+    f->hdr_len   = 0;
+}
+
+static struct frag_flow *
+frag_flow_find(struct frag_tbl *tbl, const struct frag_key *key, uint64_t now)
+{
+    struct frag_flow *bkt, *empty = NULL, *stale = NULL;
+    uint32_t idx;
+
+    idx = cne_jhash(key, sizeof(*key), 0) & tbl->bucket_mask;
+    bkt = &tbl->flows[idx * CNET_FRAG_BUCKET_SIZE];
+
+    for (int i = 0; i < CNET_FRAG_BUCKET_SIZE; i++) {
+        struct frag_flow *f = &bkt[i];
+
+        if (f->key.af == 0) {
+            if (!empty)
+                empty = f;
+            continue;
+        }
+
+        if (memcmp(&f->key, key, sizeof(*key)) == 0) {
+            if (!frag_flow_expired(tbl, f, now))
+                return f;
+
+            /* Start over, the old fragments can not be part of this datagram */
+            tbl->stats.timeouts++;
+            frag_flow_free(tbl, f, true);
+            empty = f;
+            break;
+        }
+
+        if (frag_flow_expired(tbl, f, now))
+            stale = f;
+    }
+
+    /* Reuse an expired flow of the bucket before the timer gets to it */
+    if (!empty && stale) {
+        tbl->stats.timeouts++;
+        frag_flow_free(tbl, stale, true);
+        empty = stale;
+    }
+
+    if (empty) {
+        memcpy(&empty->key, key, sizeof(*key));
+        empty->start = now;
+        tbl->nb_flows++;
+    }
+
+    return empty;
+}
+
+/*
+ * Move the first len bytes of the packet into the first segment. A fragment built by
+ * cnet_frag_build() has the headers in its first segment and the payload in the next
+ * ones, so the L4 header of the datagram is not in the first segment after reassembly.
+ */
+static void
+frag_pullup(pktmbuf_t *m, uint32_t len)
+{
+    pktmbuf_t *seg;
+
+    len = CNE_MIN(len, pktmbuf_pkt_len(m));
+    if (pktmbuf_data_len(m) >= len || !pktmbuf_is_writable(m) ||
+        pktmbuf_tailroom(m) < len - pktmbuf_data_len(m))
+        return;
+
+    while (pktmbuf_data_len(m) < len && (seg = m->next) != NULL) {
+        uint16_t cnt = CNE_MIN(len - pktmbuf_data_len(m), (uint32_t)pktmbuf_data_len(seg));
+
+        memcpy(pktmbuf_mtod_last(m), pktmbuf_mtod(seg, void *), cnt);
+        pktmbuf_data_len(m) += cnt;
+        pktmbuf_data_off(seg) += cnt;
+        pktmbuf_data_len(seg) -= cnt;
+
+        if (pktmbuf_data_len(seg) == 0) {
+            m->next   = seg->next;
+            seg->next = NULL;
+            m->nb_segs--;
+            pktmbuf_free_seg(seg);
+        }
+    }
+}
+
+static pktmbuf_t *
+frag_flow_complete(struct frag_tbl *tbl, struct frag_flow *f)
+{
+    pktmbuf_t *head;
+    char *hdr;
+
+    /* Sort the fragments by offset, the number of fragments is small */
+    for (uint16_t i = 1; i < f->nb_frags; i++) {
+        struct frag_ent e = f->frags[i];
+        int j;
+
+        for (j = i - 1; j >= 0 && f->frags[j].ofs > e.ofs; j--)
+            f->frags[j + 1] = f->frags[j];
+        f->frags[j + 1] = e;
+    }
+
+    /* The first fragment keeps the metadata of the datagram */
+    head = f->frags[0].m;
+    for (uint16_t i = 1; i < f->nb_frags; i++) {
+        if (pktmbuf_chain(head, f->frags[i].m) < 0) {
+            /* Release the fragments not chained yet, the head frees the others */
+            for (; i < f->nb_frags; i++)
+                pktmbuf_free(f->frags[i].m);
+            goto err;
+        }
+    }
+
+    /* The headroom of the first fragment held the header being restored */
+    hdr = pktmbuf_prepend(head, f->hdr_len);
+    if (!hdr)
+        goto err;
+    memcpy(hdr, f->hdr, f->hdr_len);
+    frag_pullup(head, f->hdr_len + CNET_FRAG_L4_MAX);
+
+    tbl->stats.reassembled++;
+    frag_flow_free(tbl, f, false);
+
+    return head;
+err:
+    tbl->stats.invalid++;
+    pktmbuf_free(head);
+    frag_flow_free(tbl, f, false);
+    return NULL;
+}
+
+int
+cnet_frag_insert(struct frag_tbl *tbl, const struct frag_key *key, pktmbuf_t *m,
+                 uint16_t hdr_len, uint16_t skip, uint16_t ofs, bool more, uint64_t now,
+                 pktmbuf_t **out)
+{
+    struct frag_flow *f;
+    uint16_t nb_segs;
+    uint32_t len, end;
+
+    *out = NULL;
+    tbl->stats.frags_rcvd++;
+
+    /* The headers must be in the first segment */
+    if (hdr_len > CNET_FRAG_HDR_MAX || pktmbuf_data_len(m) < (hdr_len + skip)) {
+        tbl->stats.invalid++;
+        goto drop;
+    }
+
+    nb_segs = m->nb_segs;
+    len     = pktmbuf_pkt_len(m) - hdr_len - skip;
+    end     = ofs + len;
+
+    /* Only the last fragment can have a length which is not a multiple of 8 bytes */
+    if ((more && (len == 0 || (len & 7))) || end > CNET_FRAG_MAX_DATAGRAM) {
+        tbl->stats.invalid++;
+        goto drop;
+    }
+
+    if (tbl->nb_mbufs + nb_segs > tbl->max_mbufs) {
+        tbl->stats.no_mbufs++;
+        goto drop;
+    }
+
+    f = frag_flow_find(tbl, key, now);
+    if (!f) {
+        tbl->stats.no_flow++;
+        goto drop;
+    }
+
+    for (uint16_t i = 0; i < f->nb_frags; i++) {
+        struct frag_ent *e = &f->frags[i];
+
+        if (e->ofs == ofs && e->len == len) {
+            tbl->stats.frags_dup++;
+            pktmbuf_free(m);
+            return 0;
+        }
+
+        /* Overlapping fragments are not accepted, see RFC 5722 */
+        if (ofs < (e->ofs + e->len) && e->ofs < end)
+            goto invalid;
+
+        if (!more && (e->ofs + e->len) > end)
+            goto invalid;
+    }
+
+    if (!more) {
+        if (f->total_len)
+            goto invalid;
+        f->total_len = end;
+    } else if (f->total_len && end > f->total_len)
+        goto invalid;
+
+    if (f->nb_frags >= CNET_FRAG_MAX_FRAGS)
+        goto invalid;
+
+    if (ofs == 0) {
+        memcpy(f->hdr, pktmbuf_mtod(m, void *), hdr_len);
+        f->hdr_len = hdr_len;
+    }
+    pktmbuf_adj_offset(m, hdr_len + skip);
+
+    f->frags[f->nb_frags].m   = m;
+    f->frags[f->nb_frags].ofs = ofs;
+    f->frags[f->nb_frags].len = len;
+    f->nb_frags++;
+    f->rcvd_len += len;
+    f->nb_segs += nb_segs;
+    tbl->nb_mbufs += nb_segs;
+
+    /* Without overlaps all of the data has been received when the lengths match */
+    if (f->total_len == 0 || f->rcvd_len != f->total_len)
+        return 0;
+
+    *out = frag_flow_complete(tbl, f);
+
+    return (*out) ? 0 : -1;
+
+invalid:
+    tbl->stats.invalid++;
+    frag_flow_free(tbl, f, true);
+drop:
+    pktmbuf_free(m);
+    return -1;
+}
+
+void
+cnet_frag_tbl_expire(struct frag_tbl *tbl, uint64_t now)
+{
+    uint32_t nb_flows = tbl->nb_buckets * CNET_FRAG_BUCKET_SIZE;
+
+    for (uint32_t i = 0; i < nb_flows && tbl->nb_flows; i++) {
+        struct frag_flow *f = &tbl->flows[i];
+
+        if (f->key.af && frag_flow_expired(tbl, f, now)) {
+            tbl->stats.timeouts++;
+            frag_flow_free(tbl, f, true);
+        }
+    }
+}
+
+static void
+frag_timer_cb(struct cne_timer *tim __cne_unused, void *arg)
+{
+    cnet_frag_tbl_expire(arg, cne_rdtsc());
+}
+
+struct frag_tbl *
+cnet_frag_tbl_create(uint32_t max_flows, uint32_t max_mbufs, uint16_t ttl_secs)
+{
+    struct frag_tbl *tbl;
+
+    if (max_flows == 0)
+        max_flows = CNET_FRAG_MAX_FLOWS;
+    if (max_mbufs == 0)
+        max_mbufs = CNET_FRAG_MAX_MBUFS;
+    if (ttl_secs == 0)
+        ttl_secs = CNET_FRAG_TTL_DEFAULT;
+
+    max_flows = cne_align32pow2(CNE_MAX(max_flows, (uint32_t)CNET_FRAG_BUCKET_SIZE));
+
+    tbl = calloc(1, sizeof(struct frag_tbl));
+    if (!tbl)
+        CNE_NULL_RET("Failed to allocate fragment table\n");
+
+    tbl->flows = calloc(max_flows, sizeof(struct frag_flow));
+    if (!tbl->flows)
+        CNE_ERR_GOTO(err, "Failed to allocate %u fragment flows\n", max_flows);
+
+    tbl->nb_buckets  = max_flows / CNET_FRAG_BUCKET_SIZE;
+    tbl->bucket_mask = tbl->nb_buckets - 1;
+    tbl->max_mbufs   = max_mbufs;
+    tbl->ttl         = cne_get_timer_hz() * ttl_secs;
+
+    cne_timer_init(&tbl->timer);
+
+    if (cne_timer_reset(&tbl->timer, (cne_get_timer_hz() / 1000) * CNET_FRAG_TIMER_MS, PERIODICAL,
+                        cne_id(), frag_timer_cb, tbl) < 0)
+        CNE_ERR_GOTO(err, "Failed to start fragment expire timer\n");
+
+    return tbl;
+err:
+    free(tbl->flows);
+    free(tbl);
+    return NULL;
+}
+
+void
+cnet_frag_tbl_destroy(struct frag_tbl *tbl)
+{
+    if (!tbl)
+        return;
+
+    if (cne_timer_stop(&tbl->timer) < 0)
+        CNE_ERR("Failed to stop fragment expire timer\n");
+
+    for (uint32_t i = 0; i < tbl->nb_buckets * CNET_FRAG_BUCKET_SIZE; i++) {
+        if (tbl->flows[i].key.af)
+            frag_flow_free(tbl, &tbl->flows[i], true);
+    }
+
+    free(tbl->flows);
+    free(tbl);
+}
+
+uint32_t
+cnet_frag_cksum_mbuf(const pktmbuf_t *m, uint32_t off, uint32_t len, uint32_t sum)
+{
+    uint32_t done = 0;
+
+    while (m && off >= pktmbuf_data_len(m)) {
+        off -= pktmbuf_data_len(m);
+        m = m->next;
+    }
+
+    for (; m && len; m = m->next, off = 0) {
+        uint32_t seglen = CNE_MIN((uint32_t)pktmbuf_data_len(m) - off, len);
+        uint16_t tmp;
+
+        tmp = __cne_raw_cksum_reduce(
+            __cne_raw_cksum(pktmbuf_mtod_offset(m, const void *, off), seglen, 0));
+
+        /* A segment starting at an odd offset has its bytes swapped in the 16 bit sum */
+        if (done & 1)
+            tmp = __builtin_bswap16(tmp);
+
+        sum += tmp;
+        done += seglen;
+        len -= seglen;
+    }
+
+    return sum;
+}
+
+int
+cnet_frag_build(pktmbuf_t *m, uint16_t hdr_len, uint16_t ext_len, uint16_t frag_size,
+                pktmbuf_t **frags, uint16_t max_frags)
+{
+    pktmbuf_info_t *pi;
+    pktmbuf_t *seg;
+    uint32_t plen, flen, seg_off;
+    int nb = 0;
+
+    if (!m || !frags || frag_size == 0 || (frag_size & 7) || pktmbuf_data_len(m) < hdr_len)
+        CNE_ERR_RET("Invalid fragment arguments\n");
+
+    pi   = m->pooldata;
+    plen = pktmbuf_pkt_len(m) - hdr_len;
+    if (((plen + frag_size - 1) / frag_size) > max_frags)
+        CNE_ERR_RET("Packet of %u bytes needs more than %u fragments\n", plen, max_frags);
+
+    seg     = m;
+    seg_off = hdr_len;
+
+    for (uint32_t off = 0; off < plen; off += flen) {
+        pktmbuf_t *h;
+        char *hdr;
+
+        flen = CNE_MIN(plen - off, (uint32_t)frag_size);
+
+        h = pktmbuf_alloc(pi);
+        if (!h)
+            goto err;
+        frags[nb++] = h;
+
+        hdr = pktmbuf_append(h, hdr_len + ext_len);
+        if (!hdr)
+            goto err;
+        memcpy(hdr, pktmbuf_mtod(m, void *), hdr_len);
+        memset(hdr + hdr_len, 0, ext_len);
+        h->lport      = m->lport;
+        h->tx_offload = m->tx_offload;
+
+        /* Attach the payload range of the fragment, it can span several segments */
+        for (uint32_t left = flen; left;) {
+            pktmbuf_t *p;
+            uint32_t len;
+
+            while (seg_off >= pktmbuf_data_len(seg)) {
+                seg_off -= pktmbuf_data_len(seg);
+                seg = seg->next;
+            }
+            len = CNE_MIN(left, pktmbuf_data_len(seg) - seg_off);
+
+            p = pktmbuf_alloc(pi);
+            if (!p)
+                goto err;
+            if (pktmbuf_attach(p, seg) < 0) {
+                pktmbuf_free(p);
+                goto err;
+            }
+            pktmbuf_data_off(p) = (uint16_t)(pktmbuf_data_off(p) + seg_off);
+            pktmbuf_data_len(p) = (uint16_t)len;
+
+            if (pktmbuf_chain(h, p) < 0) {
+                pktmbuf_free(p);
+                goto err;
+            }
+
+            seg_off += len;
+            left -= len;
+        }
+    }
+
+    return nb;
+err:
+    while (nb > 0)
+        pktmbuf_free(frags[--nb]);
+    CNE_ERR_RET("Failed to build fragments\n");
+}
+
+int
+cnet_frag_ip4(pktmbuf_t *m, uint16_t mtu, pktmbuf_t **frags, uint16_t max_frags)
+{
+    struct cne_ipv4_hdr *ip;
+    uint16_t hlen, frag_size;
+    uint32_t plen;
+    int nb;
+
+    if (!m || pktmbuf_data_len(m) < m->l2_len + sizeof(struct cne_ipv4_hdr))
+        return -1;
+
+    ip   = pktmbuf_mtod_offset(m, struct cne_ipv4_hdr *, m->l2_len);
+    hlen = cne_ipv4_hdr_len(ip);
+    if (mtu <= hlen + 8 || (be16toh(ip->fragment_offset) & CNE_IPV4_HDR_DF_FLAG))
+        return -1;
+
+    frag_size = (mtu - hlen) & ~7;
+    plen      = pktmbuf_pkt_len(m) - m->l2_len - hlen;
+
+    nb = cnet_frag_build(m, m->l2_len + hlen, 0, frag_size, frags, max_frags);
+    if (nb < 0)
+        return -1;
+
+    for (int i = 0; i < nb; i++) {
+        struct cne_ipv4_hdr *fip = pktmbuf_mtod_offset(frags[i], struct cne_ipv4_hdr *, m->l2_len);
+        uint32_t ofs             = i * frag_size;
+        uint16_t flags           = (i < nb - 1) ? CNE_IPV4_HDR_MF_FLAG : 0;
+
+        fip->total_length    = htobe16(hlen + CNE_MIN(plen - ofs, (uint32_t)frag_size));
+        fip->fragment_offset = htobe16(flags | (ofs / CNE_IPV4_HDR_OFFSET_UNITS));
+        fip->hdr_checksum    = 0;
+        fip->hdr_checksum    = cne_ipv4_cksum(fip);
+    }
+
+    return nb;
+}
+
+int
+cnet_frag_ip6(pktmbuf_t *m, uint16_t mtu, uint32_t id, pktmbuf_t **frags, uint16_t max_frags)
+{
+    uint16_t hlen = sizeof(struct cne_ipv6_hdr);
+    uint16_t flen = sizeof(struct cne_ipv6_fragment_ext);
+    struct cne_ipv6_hdr *ip6;
+    uint16_t frag_size;
+    uint32_t plen;
+    uint8_t proto;
+    int nb;
+
+    if (!m || pktmbuf_data_len(m) < m->l2_len + hlen || mtu <= hlen + flen + 8)
+        return -1;
+
+    ip6       = pktmbuf_mtod_offset(m, struct cne_ipv6_hdr *, m->l2_len);
+    frag_size = (mtu - hlen - flen) & ~7;
+    plen      = pktmbuf_pkt_len(m) - m->l2_len - hlen;
+    proto     = ip6->proto;
+
+    nb = cnet_frag_build(m, m->l2_len + hlen, flen, frag_size, frags, max_frags);
+    if (nb < 0)
+        return -1;
+
+    for (int i = 0; i < nb; i++) {
+        struct cne_ipv6_hdr *fip = pktmbuf_mtod_offset(frags[i], struct cne_ipv6_hdr *, m->l2_len);
+        struct cne_ipv6_fragment_ext *fh = (struct cne_ipv6_fragment_ext *)(fip + 1);
+        uint32_t ofs                     = i * frag_size;
+
+        fip->payload_len = htobe16(flen + CNE_MIN(plen - ofs, (uint32_t)frag_size));
+        fip->proto       = IPPROTO_FRAGMENT;
+
+        fh->next_header = proto;
+        fh->frag_data   = htobe16(CNE_IPV6_SET_FRAG_DATA(ofs, (i < nb - 1)));
+        fh->id          = htobe32(id);
+    }
+
+    return nb;
+}
+
+void
+cnet_frag_stats_dump(struct frag_tbl *tbl)
+{
+    if (!tbl)
+        return;
+
+    cne_printf("    [magenta]%-24s[]= [orange]%u[]\n", "frag_flows", tbl->nb_flows);
+    cne_printf("    [magenta]%-24s[]= [orange]%u[]\n", "frag_mbufs", tbl->nb_mbufs);
+#define _(stat) cne_printf("    [magenta]%-24s[]= [orange]%'ld[]\n", #stat, tbl->stats.stat)
+    _(frags_rcvd);
+    _(frags_dup);
+    _(reassembled);
+    _(timeouts);
+    _(no_flow);
+    _(no_mbufs);
+    _(invalid);
+    _(frags_created);
+    _(frag_failed);
+#undef _
+}
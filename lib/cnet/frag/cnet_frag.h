@@ -0,0 +1,259 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright (c) 2023 Intel Corporation
+ */
+
+#ifndef __CNET_FRAG_H
+#define __CNET_FRAG_H
+
+/**
+ * @file
+ * CNET IP fragment reassembly table and fragmentation helpers.
+ *
+ * The reassembly table is owned by a single stack instance and only accessed from the
+ * stack thread, the graph nodes insert fragments and a periodic stack timer expires the
+ * flows which did not complete within the reassembly TTL. Memory is bounded by the number
+ * of flows, the number of fragments per flow and the total number of mbufs held.
+ */
+
+#include <stdint.h>         // for uint16_t, uint32_t, uint64_t, uint8_t
+#include <stdbool.h>        // for bool
+#include <cne_timer.h>      // for cne_timer
+#include <pktmbuf.h>        // for pktmbuf_t
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define CNET_FRAG_MAX_FLOWS    256  /**< Default number of reassembly flows */
+#define CNET_FRAG_MAX_FRAGS    64   /**< Max fragments per flow, covers 64K at a 1500 MTU */
+#define CNET_FRAG_MAX_MBUFS    2048 /**< Default max number of mbufs held by a table */
+#define CNET_FRAG_BUCKET_SIZE  4    /**< Number of flows in a hash bucket */
+#define CNET_FRAG_HDR_MAX      60   /**< Max L3 header saved from the first fragment */
+#define CNET_FRAG_L4_MAX       60   /**< Max L4 header moved to the first segment */
+#define CNET_FRAG_TTL_DEFAULT  15   /**< Default reassembly TTL in seconds, RFC 791 */
+#define CNET_FRAG_TIMER_MS     100  /**< Period of the expire timer in milliseconds */
+#define CNET_FRAG_MAX_DATAGRAM 65535
+
+/**
+ * Key of a reassembly flow, the IPv4 addresses use the first 4 bytes of the address fields.
+ */
+struct frag_key {
+    uint8_t src[16]; /**< Source address */
+    uint8_t dst[16]; /**< Destination address */
+    uint32_t id;     /**< Fragment identification value */
+    uint8_t proto;   /**< Protocol of the datagram, zero for IPv6 */
+    uint8_t af;      /**< Address family of the flow */
+    uint16_t pad;
+};
+
+struct frag_ent {
+    pktmbuf_t *m; /**< Fragment payload mbuf */
+    uint16_t ofs; /**< Offset of the fragment payload in the datagram */
+    uint16_t len; /**< Length of the fragment payload */
+};
+
+struct frag_flow {
+    struct frag_key key;                        /**< Key of the flow */
+    uint64_t start;                             /**< Timer cycles when the flow was created */
+    uint32_t total_len;                         /**< Datagram length, zero until last frag */
+    uint32_t rcvd_len;                          /**< Number of payload bytes received */
+    uint32_t nb_segs;                           /**< Number of mbufs held by the flow */
+    uint16_t nb_frags;                          /**< Number of fragments in frags[] */
+    uint16_t hdr_len;                           /**< Length of the saved L3 header */
+    uint8_t hdr[CNET_FRAG_HDR_MAX];             /**< L3 header of the first fragment */
+    struct frag_ent frags[CNET_FRAG_MAX_FRAGS]; /**< Fragments of the flow */
+};
+
+struct frag_stats {
+    uint64_t frags_rcvd;    /**< Number of fragments received */
+    uint64_t frags_dup;     /**< Number of duplicate fragments dropped */
+    uint64_t reassembled;   /**< Number of datagrams reassembled */
+    uint64_t timeouts;      /**< Number of flows expired by the timer */
+    uint64_t no_flow;       /**< Fragments dropped as no flow was available */
+    uint64_t no_mbufs;      /**< Fragments dropped as the mbuf limit was reached */
+    uint64_t invalid;       /**< Flows dropped for overlapping or invalid fragments */
+    uint64_t frags_created; /**< Number of fragments created on output */
+    uint64_t frag_failed;   /**< Number of datagrams which failed to be fragmented */
+};
+
+struct frag_tbl {
+    uint32_t nb_buckets;     /**< Number of buckets, power of 2 */
+    uint32_t bucket_mask;    /**< Mask to get the bucket index from a hash */
+    uint32_t nb_flows;       /**< Number of active flows */
+    uint32_t nb_mbufs;       /**< Number of mbufs held by the table */
+    uint32_t max_mbufs;      /**< Max number of mbufs the table can hold */
+    uint64_t ttl;            /**< Reassembly TTL in timer cycles */
+    struct frag_stats stats; /**< Statistics of the table */
+    struct cne_timer timer;  /**< Expire timer of the table */
+    struct frag_flow *flows; /**< nb_buckets * CNET_FRAG_BUCKET_SIZE flows */
+};
+
+/**
+ * Create a reassembly table and start its expire timer on the calling lcore.
+ *
+ * @param max_flows
+ *   Number of flows in the table, rounded up to a power of 2, zero uses CNET_FRAG_MAX_FLOWS.
+ * @param max_mbufs
+ *   Max number of mbufs held by the table, zero uses CNET_FRAG_MAX_MBUFS.
+ * @param ttl_secs
+ *   Number of seconds to wait for all the fragments of a datagram.
+ * @return
+ *   Pointer to the table or NULL on error.
+ */
+CNDP_API struct frag_tbl *cnet_frag_tbl_create(uint32_t max_flows, uint32_t max_mbufs,
+                                               uint16_t ttl_secs);
+
+/**
+ * Stop the expire timer, free all held fragments and the table.
+ *
+ * @param tbl
+ *   Pointer to the table, can be NULL.
+ */
+CNDP_API void cnet_frag_tbl_destroy(struct frag_tbl *tbl);
+
+/**
+ * Free the flows which are older than the reassembly TTL.
+ *
+ * @param tbl
+ *   Pointer to the table.
+ * @param now
+ *   Current timer cycles.
+ */
+CNDP_API void cnet_frag_tbl_expire(struct frag_tbl *tbl, uint64_t now);
+
+/**
+ * Add a fragment to the reassembly table.
+ *
+ * The mbuf data must start at the L3 header of the fragment and the packet length must be
+ * the length of the fragment. The L3 header is removed from the mbuf and saved when the
+ * fragment is the first one of the datagram. The table owns the mbuf after the call.
+ *
+ * @param tbl
+ *   Pointer to the table.
+ * @param key
+ *   The key of the datagram.
+ * @param m
+ *   The fragment mbuf.
+ * @param hdr_len
+ *   Length of the L3 header to save, the unfragmentable part of the datagram.
+ * @param skip
+ *   Number of bytes after the saved header to remove, the IPv6 fragment header.
+ * @param ofs
+ *   Offset of the fragment payload in bytes.
+ * @param more
+ *   True when more fragments follow.
+ * @param now
+ *   Current timer cycles.
+ * @param out
+ *   Set to the reassembled datagram with the saved L3 header prepended and the data pointing
+ *   at the L3 header, or NULL when the datagram is not complete yet. The first segment holds
+ *   up to CNET_FRAG_L4_MAX bytes after the L3 header when its buffer has room for them.
+ * @return
+ *   0 on success or -1 when the fragment or the datagram was dropped.
+ */
+CNDP_API int cnet_frag_insert(struct frag_tbl *tbl, const struct frag_key *key, pktmbuf_t *m,
+                              uint16_t hdr_len, uint16_t skip, uint16_t ofs, bool more,
+                              uint64_t now, pktmbuf_t **out);
+
+/**
+ * Compute the non-complemented 16 bit one's complement sum of a range of a packet.
+ *
+ * Unlike the cne_ip.h helpers the data does not need to be contiguous, the range can span
+ * any number of segments.
+ *
+ * @param m
+ *   The first segment of the packet.
+ * @param off
+ *   Offset of the range in the packet.
+ * @param len
+ *   Length of the range.
+ * @param sum
+ *   Initial value of the sum.
+ * @return
+ *   The updated sum, use __cne_raw_cksum_reduce() to fold it.
+ */
+CNDP_API uint32_t cnet_frag_cksum_mbuf(const pktmbuf_t *m, uint32_t off, uint32_t len,
+                                       uint32_t sum);
+
+/**
+ * Build the fragments of a packet without copying the payload.
+ *
+ * Each fragment is a new mbuf holding a copy of the L2 and L3 headers chained to indirect
+ * mbufs attached to the payload of the original packet. The caller fixes up the L3 header
+ * of each fragment and frees the original packet once all fragments are built.
+ *
+ * @param m
+ *   The packet to fragment, data must start at the L2 header.
+ * @param hdr_len
+ *   Length of the L2 and L3 headers copied into each fragment.
+ * @param ext_len
+ *   Number of zeroed bytes added after the copied headers, room for an IPv6 fragment header.
+ * @param frag_size
+ *   Max payload size of a fragment, a multiple of 8 bytes.
+ * @param frags
+ *   Array to store the fragment mbufs.
+ * @param max_frags
+ *   Number of entries in frags[].
+ * @return
+ *   Number of fragments built or -1 on error, no fragments are left allocated on error.
+ */
+CNDP_API int cnet_frag_build(pktmbuf_t *m, uint16_t hdr_len, uint16_t ext_len,
+                             uint16_t frag_size, pktmbuf_t **frags, uint16_t max_frags);
+
+/**
+ * Fragment an IPv4 datagram to fit the MTU.
+ *
+ * The fragments are built with cnet_frag_build() and their IPv4 header is updated with
+ * the length, offset, MF flag and checksum of the fragment. The L4 checksum must already
+ * be computed over the whole datagram. The caller frees the original packet.
+ *
+ * @param m
+ *   The datagram, data must start at the L2 header and l2_len must be set.
+ * @param mtu
+ *   The MTU of the output interface.
+ * @param frags
+ *   Array to store the fragment mbufs.
+ * @param max_frags
+ *   Number of entries in frags[].
+ * @return
+ *   Number of fragments or -1 on error or when the DF flag is set.
+ */
+CNDP_API int cnet_frag_ip4(pktmbuf_t *m, uint16_t mtu, pktmbuf_t **frags, uint16_t max_frags);
+
+/**
+ * Fragment an IPv6 datagram to fit the MTU.
+ *
+ * A fragment header is inserted after the IPv6 header of each fragment built with
+ * cnet_frag_build(), extension headers in the datagram are not supported. The L4
+ * checksum must already be computed over the whole datagram. The caller frees the
+ * original packet.
+ *
+ * @param m
+ *   The datagram, data must start at the L2 header and l2_len must be set.
+ * @param mtu
+ *   The MTU of the output interface.
+ * @param id
+ *   The identification of the datagram in host byte order.
+ * @param frags
+ *   Array to store the fragment mbufs.
+ * @param max_frags
+ *   Number of entries in frags[].
+ * @return
+ *   Number of fragments or -1 on error.
+ */
+CNDP_API int cnet_frag_ip6(pktmbuf_t *m, uint16_t mtu, uint32_t id, pktmbuf_t **frags,
+                           uint16_t max_frags);
+
+/**
+ * Print the statistics of a fragment table.
+ *
+ * @param tbl
+ *   Pointer to the table, can be NULL.
+ */
+CNDP_API void cnet_frag_stats_dump(struct frag_tbl *tbl);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __CNET_FRAG_H */
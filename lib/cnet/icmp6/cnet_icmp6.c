@@ -35,6 +35,9 @@ icmp6_create(void *_stk)
     stk->icmp6->snd_size            = MAX_ICMP6_SND_SIZE;
     stk->icmp6->icmp6_hd.local_port = _IPPORT_RESERVED;
 
+    if (cnet_pcb_hd_init(&stk->icmp6->icmp6_hd, "icmp6_pcb", CNET_NUM_CHANNELS) < 0)
+        CNE_ERR_RET("Failed to create ICMP6 PCB hash table\n");
+
     return 0;
 }
 
@@ -48,8 +51,7 @@ icmp6_destroy(void *_stk)
 
         vec_foreach_ptr (p, stk->icmp6->icmp6_hd.vec)
             free(p);
-        vec_free(stk->icmp6->icmp6_hd.vec);
-        stk->icmp6->icmp6_hd.vec = NULL;
+        cnet_pcb_hd_free(&stk->icmp6->icmp6_hd);
         free(stk->icmp6);
         stk->icmp6 = NULL;
     }
@@ -45,7 +45,7 @@ icmp6_input_lookup(struct cne_graph *graph, struct cne_node *node, pktmbuf_t *m,
     inet6_addr_copy_from_octs(&key.laddr.cin6_addr, iip->ip6.dst_addr);
 
     /* Create a 4x PCB lookup routine */
-    pcb = cnet_pcb_lookup(hd, &key, BEST_MATCH);
+    pcb = cnet_pcb_lookup(hd, &key, BEST_MATCH | IPV6_TYPE);
     if (likely(pcb)) {
 
         csum = cne_ipv6_icmpv6_cksum_verify(&iip->ip6, &iip->icmp6);
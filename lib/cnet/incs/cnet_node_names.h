@@ -29,19 +29,26 @@ extern "C" {
 #define ETH_TX_NODE_NAME        "eth_tx"
 #define GTPU_INPUT_NODE_NAME    "gtpu_input"
 #define IP4_FORWARD_NODE_NAME   "ip4_forward"
+#define IP4_FRAG_NODE_NAME      "ip4_frag"
+#define IP4_GSO_NODE_NAME       "ip4_gso"
 #define IP4_INPUT_NODE_NAME     "ip4_input"
 #define IP4_OUTPUT_NODE_NAME    "ip4_output"
 #define IP4_PROTO_NODE_NAME     "ip4_proto"
+#define IP4_REASM_NODE_NAME     "ip4_reasm"
 #define IP6_FORWARD_NODE_NAME   "ip6_forward"
+#define IP6_FRAG_NODE_NAME      "ip6_frag"
+#define IP6_GSO_NODE_NAME       "ip6_gso"
 #define IP6_INPUT_NODE_NAME     "ip6_input"
 #define IP6_OUTPUT_NODE_NAME    "ip6_output"
 #define IP6_PROTO_NODE_NAME     "ip6_proto"
+#define IP6_REASM_NODE_NAME     "ip6_reasm"
 #define KERNEL_RECV_NODE_NAME   "kernel_recv"
 #define NULL_NODE_NAME          "null"
 #define PKT_DROP_NODE_NAME      "pkt_drop"
 #define PTYPE_NODE_NAME         "ptype"
 #define PUNT_KERNEL_NODE_NAME   "punt_kernel"
 #define PUNT_ETHER_NODE_NAME    "punt_l2_kernel"
+#define TCP_GRO_NODE_NAME       "tcp_gro"
 #define TCP_INPUT_NODE_NAME     "tcp_input"
 #define TCP_OUTPUT_NODE_NAME    "tcp_output"
 #define UDP_INPUT_NODE_NAME     "udp_input"
@@ -32,6 +32,7 @@
 #include "cnet_reg.h"
 #include "cnet_ipv4.h"           // for ipv4_entry, ipv4_stats, DEFAULT_I...
 #include "cnet_protosw.h"        // for protosw_entry
+#include "cnet_frag.h"           // for cnet_frag_tbl_create, cnet_frag_tbl_destroy
 #include "pktmbuf.h"             // for pktmbuf_t, pktmbuf_free
 
 static void
@@ -56,6 +57,7 @@ __ipv4_stats_dump(stk_t *stk)
     _(ip_mlookup_failed);
     _(ip_forwarding_disabled);
 #undef _
+    cnet_frag_stats_dump(stk->ipv4->frag_tbl);
 }
 
 int
@@ -101,7 +103,14 @@ ipv4_create(void *_stk)
         return -1;
 
     stk->ipv4->ip_forwarding = DEFAULT_FORWARDING_STATE;
-    stk->ipv4->reassem_ttl   = 0;
+    stk->ipv4->reassem_ttl   = CNET_FRAG_TTL_DEFAULT;
+
+    stk->ipv4->frag_tbl = cnet_frag_tbl_create(0, 0, stk->ipv4->reassem_ttl);
+    if (stk->ipv4->frag_tbl == NULL) {
+        free(stk->ipv4);
+        stk->ipv4 = NULL;
+        return -1;
+    }
 
     return 0;
 }
@@ -111,6 +120,8 @@ ipv4_destroy(void *_stk)
 {
     stk_t *stk = _stk;
 
+    if (stk->ipv4)
+        cnet_frag_tbl_destroy(stk->ipv4->frag_tbl);
     free(stk->ipv4);
     stk->ipv4 = NULL;
 
@@ -39,6 +39,7 @@ struct rt4_entry;
 struct arp_entry;
 struct cne_lpm;
 struct ipfwd_info;
+struct frag_tbl;
 
 struct ipv4_stats {
     uint64_t ip_ver_error;
@@ -61,8 +62,9 @@ struct ipv4_stats {
 struct ipv4_entry {
     uint8_t ip_forwarding;       /**< IP forwarding is enabled */
     uint8_t do_multicast;        /**< Allow multicast support */
-    uint16_t reassem_ttl;        /**< reassemble TTL value */
+    uint16_t reassem_ttl;        /**< reassemble TTL value in seconds */
     struct ipfwd_info *fwd_info; /**< Forwarding information */
+    struct frag_tbl *frag_tbl;   /**< Fragment reassembly table */
     struct ipv4_stats stats;     /**< simple stats for protocol */
     iofunc_t fastpath;           /**< Fastpath function pointer */
     iofunc_t dhcp;               /**< DHCP function pointer */
@@ -141,32 +143,17 @@ struct ipoptions {
 /*
  * Adjust the checksum to reflect that the TTL had been decremented.
  *
- * Flip the bits on the checksum, decrement the high byte of the checksum,
- * fold in any carry, and then flip the bits back.  Rather than convert
- * the checksum to host byte order and then back to network byte order,
- * just convert the increment to network byte order.  Note: in 1's
- * complement arithmetic, subtracting by x is the same as adding the 1's
- * complement of x.  So, in 16 bit arithmetic, rather than subtracting by
- * (1<<8), we can add by (1<<8)^0xffff.  Since it's all constants, that
- * should be evaluated by the compiler at compile time.
- *
- * Doing the ^0xffff to initially flip the bits keeps the upper bits from
- * also being flipped. Using the ~ operation at the end doesn't matter,
- * because the upper bits get tossed when we assign it to the 16 bit sum
- * field, so let the compiler do whatever is fastest.
+ * The TTL shares a 16 bit word of the header with the protocol, the checksum is updated
+ * for the change of that word with RFC 1624 eqn. 3.
  */
 static inline void
 ipv4_adjust_cksum(struct cne_ipv4_hdr *hdr)
 {
-    int32_t cksum;
+    uint16_t old = htobe16((uint16_t)(hdr->time_to_live << 8) | hdr->next_proto_id);
 
     hdr->time_to_live--;
 
-    /* increment checksum high byte */
-    cksum = (int32_t)(hdr->hdr_checksum ^ 0xFFFF) + (int32_t)htobe16(((1 << 8) ^ 0xFFFF));
-
-    /* Fold the carry bit into the checksum */
-    hdr->hdr_checksum = ~(cksum + (cksum >> 16));
+    hdr->hdr_checksum = cne_cksum_update16(hdr->hdr_checksum, old, old - htobe16(1 << 8));
 }
 
 /**
@@ -0,0 +1,91 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright (c) 2023 Intel Corporation
+ */
+
+#include <cne_graph.h>               // for cne_node_register, CNE_NODE_REGISTER
+#include <cne_graph_worker.h>        // for cne_node, cne_node_enqueue_x1
+#include <net/cne_ip.h>              // for cne_ipv4_hdr
+#include <pktmbuf.h>                 // for pktmbuf_t, pktmbuf_mtod_offset
+#include <stdint.h>                  // for uint16_t, uint32_t
+#include <cnet.h>                    // for this_cnet
+#include <cnet_stk.h>                // for this_stk
+#include <cnet_route4.h>             // for rt4_entry
+#include <cnet_netif.h>              // for netif, cnet_netif_from_index
+#include <cnet_ipv4.h>               // for ipv4_entry
+#include <cnet_frag.h>               // for cnet_frag_ip4, CNET_FRAG_MAX_FRAGS
+
+#include <cnet_node_names.h>
+#include "ip4_node_api.h"                 // for ip4_frag_node_get
+#include "ip4_frag_priv.h"                // for IP4_FRAG_NEXT_PKT_DROP
+#include "cne_branch_prediction.h"        // for likely, unlikely
+#include "cnet_fib_info.h"                // for fib_info_lookup
+
+/*
+ * Split a datagram from ip4_output into MTU sized fragments, the L4 checksum has already
+ * been computed over the whole datagram and the Ethernet header is complete.
+ */
+static inline void
+ip4_frag_one(struct cne_graph *graph, struct cne_node *node, pktmbuf_t *m)
+{
+    struct ipv4_entry *ipv4 = this_stk->ipv4;
+    pktmbuf_t *frags[CNET_FRAG_MAX_FRAGS];
+    struct cne_ipv4_hdr *ip;
+    struct rt4_entry *rt4;
+    struct netif *nif;
+    uint32_t ipaddr;
+    int nb;
+
+    ip     = pktmbuf_mtod_offset(m, struct cne_ipv4_hdr *, m->l2_len);
+    ipaddr = be32toh(ip->src_addr);
+
+    if (unlikely(fib_info_lookup(this_cnet->rt4_finfo, &ipaddr, (void **)&rt4, 1) <= 0))
+        goto drop;
+
+    nif = cnet_netif_from_index(rt4->netif_idx);
+    if (unlikely(!nif))
+        goto drop;
+
+    nb = cnet_frag_ip4(m, nif->mtu, frags, CNET_FRAG_MAX_FRAGS);
+    if (nb < 0)
+        goto drop;
+
+    for (int i = 0; i < nb; i++)
+        cne_node_enqueue_x1(graph, node, rt4->netif_idx + IP4_FRAG_NEXT_MAX, frags[i]);
+    ipv4->frag_tbl->stats.frags_created += nb;
+
+    pktmbuf_free(m);
+    return;
+
+drop:
+    ipv4->frag_tbl->stats.frag_failed++;
+    cne_node_enqueue_x1(graph, node, IP4_FRAG_NEXT_PKT_DROP, m);
+}
+
+static uint16_t
+ip4_frag_node_process(struct cne_graph *graph, struct cne_node *node, void **objs,
+                      uint16_t nb_objs)
+{
+    for (uint16_t i = 0; i < nb_objs; i++)
+        ip4_frag_one(graph, node, objs[i]);
+
+    return nb_objs;
+}
+
+static struct cne_node_register ip4_frag_node = {
+    .process = ip4_frag_node_process,
+    .name    = IP4_FRAG_NODE_NAME,
+
+    .nb_edges = IP4_FRAG_NEXT_MAX,
+    .next_nodes =
+        {
+            [IP4_FRAG_NEXT_PKT_DROP] = PKT_DROP_NODE_NAME, /* TX output nodes go here */
+        },
+};
+
+struct cne_node_register *
+ip4_frag_node_get(void)
+{
+    return &ip4_frag_node;
+}
+
+CNE_NODE_REGISTER(ip4_frag_node);
@@ -0,0 +1,30 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright (c) 2023 Intel Corporation
+ */
+
+#ifndef __INCLUDE_IP4_FRAG_PRIV_H__
+#define __INCLUDE_IP4_FRAG_PRIV_H__
+
+/**
+ * @file ip4_frag_priv.h
+ *
+ * Next nodes of the ip4_frag node, the eth_tx nodes of each port are added after
+ * IP4_FRAG_NEXT_MAX in the same way as the ip4_output node.
+ */
+
+#include <cne_common.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+enum cne_node_ip4_frag_next {
+    IP4_FRAG_NEXT_PKT_DROP, /**< Packet drop node. */
+    IP4_FRAG_NEXT_MAX,      /**< Number of next nodes of fragment node. */
+};
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __INCLUDE_IP4_FRAG_PRIV_H__ */
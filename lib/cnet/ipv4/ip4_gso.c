@@ -0,0 +1,84 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright (c) 2023 Intel Corporation
+ */
+
+#include <cne_graph.h>               // for cne_node_register, CNE_NODE_REGISTER
+#include <cne_graph_worker.h>        // for cne_node, cne_node_enqueue
+#include <net/cne_ip.h>              // for cne_ipv4_hdr
+#include <pktmbuf.h>                 // for pktmbuf_t, pktmbuf_mtod_offset
+#include <stdint.h>                  // for uint16_t, uint32_t
+#include <cnet.h>                    // for this_cnet
+#include <cnet_route4.h>             // for rt4_entry
+#include <cnet_netif.h>              // for netif, cnet_netif_from_index
+#include <cnet_tcp_gso.h>            // for cnet_tcp_gso_segment, TCP_GSO_MAX_SEGS
+
+#include <cnet_node_names.h>
+#include "ip4_node_api.h"                 // for ip4_gso_node_get
+#include "ip4_gso_priv.h"                 // for IP4_GSO_NEXT_PKT_DROP
+#include "cne_branch_prediction.h"        // for likely, unlikely
+#include "cnet_fib_info.h"                // for fib_info_lookup
+
+/*
+ * Split a TCP super-segment from ip4_output into MSS sized frames, the Ethernet and IPv4
+ * headers are complete and the TCP checksum is left to the GSO code.
+ */
+static inline void
+ip4_gso_one(struct cne_graph *graph, struct cne_node *node, pktmbuf_t *m)
+{
+    pktmbuf_t *segs[TCP_GSO_MAX_SEGS];
+    struct cne_ipv4_hdr *ip;
+    struct rt4_entry *rt4;
+    struct netif *nif;
+    uint32_t ipaddr;
+    int nb;
+
+    ip     = pktmbuf_mtod_offset(m, struct cne_ipv4_hdr *, m->l2_len);
+    ipaddr = be32toh(ip->src_addr);
+
+    if (unlikely(fib_info_lookup(this_cnet->rt4_finfo, &ipaddr, (void **)&rt4, 1) <= 0))
+        goto drop;
+
+    nif = cnet_netif_from_index(rt4->netif_idx);
+    if (unlikely(!nif))
+        goto drop;
+
+    nb = cnet_tcp_gso_segment(m, nif->tx_cksum_offload, segs, TCP_GSO_MAX_SEGS);
+    if (nb < 0)
+        goto drop;
+
+    /* The frames go to the TX node as one burst */
+    cne_node_enqueue(graph, node, rt4->netif_idx + IP4_GSO_NEXT_MAX, (void **)segs, nb);
+    return;
+
+drop:
+    cne_node_enqueue_x1(graph, node, IP4_GSO_NEXT_PKT_DROP, m);
+}
+
+static uint16_t
+ip4_gso_node_process(struct cne_graph *graph, struct cne_node *node, void **objs,
+                     uint16_t nb_objs)
+{
+    for (uint16_t i = 0; i < nb_objs; i++)
+        ip4_gso_one(graph, node, objs[i]);
+
+    return nb_objs;
+}
+
+static struct cne_node_register ip4_gso_node = {
+    .process = ip4_gso_node_process,
+    .name    = IP4_GSO_NODE_NAME,
+
+    .nb_edges = IP4_GSO_NEXT_MAX,
+    .next_nodes =
+        {
+            [IP4_GSO_NEXT_PKT_DROP] = PKT_DROP_NODE_NAME, /* TX output nodes go here */
+        },
+};
+
+struct cne_node_register *
+ip4_gso_node_get(void)
+{
+    return &ip4_gso_node;
+}
+
+CNE_NODE_REGISTER(ip4_gso_node);
@@ -72,6 +72,22 @@ CNDP_API struct cne_node_register *ip4_output_node_get(void);
  */
 CNDP_API int ip4_output_set_next(uint16_t port_id, uint16_t next_index);
 
+/**
+ * Get the ipv4 fragment node.
+ *
+ * @return
+ *   Pointer to the ipv4 fragment node.
+ */
+CNDP_API struct cne_node_register *ip4_frag_node_get(void);
+
+/**
+ * Get the ipv4 TCP GSO node.
+ *
+ * @return
+ *   Pointer to the ipv4 GSO node.
+ */
+CNDP_API struct cne_node_register *ip4_gso_node_get(void);
+
 #ifdef __cplusplus
 }
 #endif
@@ -37,6 +37,7 @@
 #include "cne_common.h"                   // for CNE_BUILD_BUG_ON, CNE_PRIORITY_LAST
 #include "cne_log.h"                      // for CNE_LOG_DEBUG, CNE_LOG_ERR
 #include "cnet_fib_info.h"
+#include "cnet_frag.h"
 
 static struct ip4_output_node_main *ip4_output_nm;
 
@@ -45,6 +46,23 @@ struct ip4_output_node_ctx {
 };
 #define IP4_OUTPUT_NODE_LAST_NEXT(ctx) (((struct ip4_output_node_ctx *)ctx)->next_index)
 
+/* UDP/TCP checksum of a packet which can be chained, the L4 checksum must be zero */
+static inline uint16_t
+ip4_output_cksum(pktmbuf_t *m, struct cne_ipv4_hdr *ip, uint16_t phdr)
+{
+    uint32_t off = m->l2_len + m->l3_len;
+    uint16_t cksum;
+
+    cksum = ~__cne_raw_cksum_reduce(
+        cnet_frag_cksum_mbuf(m, off, pktmbuf_pkt_len(m) - off, phdr));
+
+    /* Per RFC 768 a zero UDP checksum is transmitted as all ones */
+    if (cksum == 0 && ip->next_proto_id == IPPROTO_UDP)
+        cksum = 0xffff;
+
+    return cksum;
+}
+
 static inline uint16_t
 ip4_output_header(struct cne_node *node __cne_unused, pktmbuf_t *m, uint16_t nxt)
 {
@@ -57,6 +75,7 @@ ip4_output_header(struct cne_node *node __cne_unused, pktmbuf_t *m, uint16_t nxt
     struct cnet_metadata *md;
     struct netif *nif;
     uint32_t ipaddr;
+    bool frag, gso;
     void *l4;
 
     pcb = m->userptr;
@@ -74,7 +93,7 @@ ip4_output_header(struct cne_node *node __cne_unused, pktmbuf_t *m, uint16_t nxt
 
     ip->version_ihl     = (IPv4_VERSION << 4) | (sizeof(struct cne_ipv4_hdr) / 4);
     ip->type_of_service = pcb->tos;
-    ip->total_length    = htobe16(pktmbuf_data_len(m));
+    ip->total_length    = htobe16(pktmbuf_pkt_len(m));
     ip->fragment_offset = 0;
     ip->time_to_live    = pcb->ttl;
     ip->next_proto_id   = pcb->ip_proto;
@@ -95,21 +114,51 @@ ip4_output_header(struct cne_node *node __cne_unused, pktmbuf_t *m, uint16_t nxt
         ether_addr_copy(&nif->mac, &eth->s_addr);
         eth->ether_type = htobe16(CNE_ETHER_TYPE_IPV4);
         ip->packet_id   = htobe16(nif->ip_ident);
-        nif->ip_ident += ip->total_length;
+
+        /* A TCP GSO super-segment uses one identification for each of its frames */
+        gso = (m->ol_flags & CNE_MBUF_F_TX_TCP_SEG) != 0;
+        nif->ip_ident += (gso) ? m->nb_segs : ip->total_length;
 
         ip->hdr_checksum = cne_ipv4_cksum(ip);
 
-        /* Do the UDP/TCP checksum if enabled */
+        /* Datagrams larger than the MTU go to the fragment node, GSO frames fit the MTU */
+        frag = !gso && nif->mtu && (pktmbuf_pkt_len(m) - m->l2_len) > nif->mtu;
+
+        /*
+         * Do the UDP/TCP checksum if enabled, with TX checksum offload only the pseudo
+         * header checksum is done here and the NIC completes it. The checksum of a
+         * datagram being fragmented or chained is done here over all of the segments.
+         */
         if (pcb->ip_proto == IPPROTO_UDP) {
             if (pcb->opt_flag & UDP_CHKSUM_FLAG) {
                 struct cne_udp_hdr *udp = l4;
 
-                udp->dgram_cksum = cne_ipv4_udptcp_cksum(ip, l4);
+                if (unlikely(frag || m->nb_segs > 1))
+                    udp->dgram_cksum = ip4_output_cksum(m, ip, cne_ipv4_phdr_cksum(ip, 0));
+                else if (nif->tx_cksum_offload) {
+                    m->ol_flags |= CNE_MBUF_F_TX_IPV4 | CNE_MBUF_F_TX_UDP_CKSUM;
+                    udp->dgram_cksum = cne_ipv4_phdr_cksum(ip, m->ol_flags);
+                } else
+                    udp->dgram_cksum = cne_ipv4_udptcp_cksum(ip, l4);
             }
         } else if (pcb->ip_proto == IPPROTO_TCP) {
             struct cne_tcp_hdr *tcp = l4;
-
-            tcp->cksum = cne_ipv4_udptcp_cksum(ip, l4);
+            uint16_t l4_len         = pktmbuf_pkt_len(m) - m->l2_len - m->l3_len;
+            uint16_t phdr;
+
+            /* TCP sends from the PCB key, a hashed PCB has the pseudo header sum cached */
+            phdr = (likely(pcb->hashed)) ? cnet_pcb_phdr_cksum(pcb, l4_len)
+                                         : cne_ipv4_phdr_cksum(ip, 0);
+
+            if (unlikely(gso))
+                tcp->cksum = 0; /* The GSO node does the checksum of each frame */
+            else if (unlikely(frag || m->nb_segs > 1))
+                tcp->cksum = ip4_output_cksum(m, ip, phdr);
+            else if (nif->tx_cksum_offload) {
+                m->ol_flags |= CNE_MBUF_F_TX_IPV4 | CNE_MBUF_F_TX_TCP_CKSUM;
+                tcp->cksum = phdr;
+            } else
+                tcp->cksum = ~__cne_raw_cksum_reduce(cne_cksum_sum(l4, l4_len, phdr));
         } else
             return nxt;
 
@@ -118,7 +167,11 @@ ip4_output_header(struct cne_node *node __cne_unused, pktmbuf_t *m, uint16_t nxt
         if (likely(fib_info_lookup(cnet->arp_finfo, &ipaddr, (void **)&arp, 1) > 0)) {
             ether_addr_copy(&arp->ha, &eth->d_addr);
 
-            nxt = rt4->netif_idx + IP4_OUTPUT_NEXT_MAX;
+            if (unlikely(gso))
+                nxt = IP4_OUTPUT_NEXT_GSO;
+            else
+                nxt = (unlikely(frag)) ? IP4_OUTPUT_NEXT_FRAG
+                                       : rt4->netif_idx + IP4_OUTPUT_NEXT_MAX;
         }
     }
 
@@ -293,7 +346,9 @@ static struct cne_node_register ip4_output_node = {
     .next_nodes =
         {
             [IP4_OUTPUT_NEXT_PKT_DROP]    = PKT_DROP_NODE_NAME,    /* Drop packet node */
-            [IP4_OUTPUT_NEXT_ARP_REQUEST] = ARP_REQUEST_NODE_NAME, /* TX output nodes go here */
+            [IP4_OUTPUT_NEXT_ARP_REQUEST] = ARP_REQUEST_NODE_NAME, /* ARP request node */
+            [IP4_OUTPUT_NEXT_FRAG]        = IP4_FRAG_NODE_NAME,    /* Fragment node */
+            [IP4_OUTPUT_NEXT_GSO]         = IP4_GSO_NODE_NAME,     /* TX output nodes go here */
         },
 };
 
@@ -26,6 +26,8 @@ extern "C" {
 enum cne_node_ip4_output_next {
     IP4_OUTPUT_NEXT_PKT_DROP,    /**< Packet drop node. */
     IP4_OUTPUT_NEXT_ARP_REQUEST, /**< Packet ARP request node. */
+    IP4_OUTPUT_NEXT_FRAG,        /**< Packet fragment node. */
+    IP4_OUTPUT_NEXT_GSO,         /**< TCP GSO node. */
     IP4_OUTPUT_NEXT_MAX,         /**< Number of next nodes of lookup node. */
 };
 
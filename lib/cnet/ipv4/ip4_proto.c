@@ -18,6 +18,7 @@
 #include <string.h>                  // for memcpy, NULL
 #include <cnet_route.h>              // for
 #include <cnet_route4.h>             // for
+#include <cnet_ipv4.h>               // for _ISFRAG
 
 #include <cnet_node_names.h>
 #include "ip4_proto_priv.h"               // for
@@ -27,6 +28,16 @@
 
 static uint8_t proto_nxt[256] __cne_cache_aligned;
 
+static __cne_always_inline cne_edge_t
+ip4_proto_next(struct cne_ipv4_hdr *ip)
+{
+    /* Fragments are reassembled before the protocol sees them */
+    if (unlikely(_ISFRAG(be16toh(ip->fragment_offset))))
+        return CNE_NODE_IP4_INPUT_PROTO_REASM;
+
+    return proto_nxt[ip->next_proto_id];
+}
+
 static uint16_t
 ip4_proto_node_process(struct cne_graph *graph, struct cne_node *node, void **objs,
                        uint16_t nb_objs)
@@ -85,10 +96,10 @@ ip4_proto_node_process(struct cne_graph *graph, struct cne_node *node, void **ob
         ip4[2] = pktmbuf_mtod(mbuf2, struct cne_ipv4_hdr *);
         ip4[3] = pktmbuf_mtod(mbuf3, struct cne_ipv4_hdr *);
 
-        next0 = proto_nxt[ip4[0]->next_proto_id];
-        next1 = proto_nxt[ip4[1]->next_proto_id];
-        next2 = proto_nxt[ip4[2]->next_proto_id];
-        next3 = proto_nxt[ip4[3]->next_proto_id];
+        next0 = ip4_proto_next(ip4[0]);
+        next1 = ip4_proto_next(ip4[1]);
+        next2 = ip4_proto_next(ip4[2]);
+        next3 = ip4_proto_next(ip4[3]);
 
         /* Enqueue four to next node */
         cne_edge_t fix_spec = (next_index ^ next0) | (next_index ^ next1) | (next_index ^ next2) |
@@ -147,7 +158,7 @@ ip4_proto_node_process(struct cne_graph *graph, struct cne_node *node, void **ob
         n_left_from -= 1;
 
         ip4[0] = pktmbuf_mtod(mbuf0, struct cne_ipv4_hdr *);
-        next0  = proto_nxt[ip4[0]->next_proto_id];
+        next0  = ip4_proto_next(ip4[0]);
 
         if (unlikely(next_index ^ next0)) {
             /* Copy things successfully speculated till now */
@@ -206,8 +217,9 @@ static struct cne_node_register ip4_proto_node = {
             [CNE_NODE_IP4_INPUT_PROTO_DROP] = PKT_DROP_NODE_NAME,
             [CNE_NODE_IP4_INPUT_PROTO_UDP]  = UDP_INPUT_NODE_NAME,
 #if CNET_ENABLE_TCP
-            [CNE_NODE_IP4_INPUT_PROTO_TCP] = TCP_INPUT_NODE_NAME,
+            [CNE_NODE_IP4_INPUT_PROTO_TCP] = TCP_GRO_NODE_NAME,
 #endif
+            [CNE_NODE_IP4_INPUT_PROTO_REASM] = IP4_REASM_NODE_NAME,
         },
 };
 
@@ -0,0 +1,147 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright (c) 2023 Intel Corporation
+ */
+
+#include <sys/socket.h>              // for AF_INET
+#include <netinet/in.h>              // for IPPROTO_UDP, IPPROTO_TCP
+#include <cne_graph.h>               // for cne_node_register, CNE_NODE_REGISTER
+#include <cne_graph_worker.h>        // for cne_node, cne_node_enqueue_x1
+#include <cne_cycles.h>              // for cne_rdtsc
+#include <net/cne_ip.h>              // for cne_ipv4_hdr, cne_ipv4_cksum
+#include <net/cne_udp.h>             // for cne_udp_hdr
+#include <net/cne_tcp.h>             // for cne_tcp_hdr
+#include <pktmbuf.h>                 // for pktmbuf_t, pktmbuf_mtod
+#include <string.h>                  // for memcpy, memset
+#include <cnet_stk.h>                // for this_stk
+#include <cnet_ipv4.h>               // for ipv4_entry, _OFF_MASK, _OFF_MF
+#include <cnet_frag.h>               // for cnet_frag_insert, cnet_frag_cksum_mbuf
+
+#include <cnet_node_names.h>
+#include "ip4_reasm_priv.h"               // for IP4_REASM_NEXT_PKT_DROP
+#include "cne_branch_prediction.h"        // for likely, unlikely
+#include "cne_common.h"                   // for __cne_unused
+
+/*
+ * Fix up the header of a reassembled datagram and verify the L4 checksum over the
+ * chained fragments, the UDP and TCP input nodes only handle a contiguous packet.
+ */
+static inline uint16_t
+ip4_reasm_done(pktmbuf_t *m)
+{
+    struct cne_ipv4_hdr *ip = pktmbuf_mtod(m, struct cne_ipv4_hdr *);
+    uint16_t hlen           = cne_ipv4_hdr_len(ip);
+    uint32_t len            = pktmbuf_pkt_len(m);
+    uint16_t nxt, l4_len;
+    uint32_t sum;
+
+    if (len > CNET_FRAG_MAX_DATAGRAM)
+        return IP4_REASM_NEXT_PKT_DROP;
+
+    ip->total_length    = htobe16((uint16_t)len);
+    ip->fragment_offset = 0;
+    ip->hdr_checksum    = 0;
+    ip->hdr_checksum    = cne_ipv4_cksum(ip);
+
+    switch (ip->next_proto_id) {
+    case IPPROTO_UDP:
+        nxt    = IP4_REASM_NEXT_UDP;
+        l4_len = sizeof(struct cne_udp_hdr);
+        break;
+#if CNET_ENABLE_TCP
+    case IPPROTO_TCP:
+        nxt    = IP4_REASM_NEXT_TCP;
+        l4_len = sizeof(struct cne_tcp_hdr);
+        break;
+#endif
+    default:
+        return IP4_REASM_NEXT_PKT_DROP;
+    }
+
+    /* The L4 header must be in the first fragment */
+    if (pktmbuf_data_len(m) < hlen + l4_len)
+        return IP4_REASM_NEXT_PKT_DROP;
+
+    if (nxt == IP4_REASM_NEXT_UDP) {
+        struct cne_udp_hdr *udp = pktmbuf_mtod_offset(m, struct cne_udp_hdr *, hlen);
+
+        if (udp->dgram_cksum == 0)
+            goto done;
+    } else {
+        struct cne_tcp_hdr *tcp = pktmbuf_mtod_offset(m, struct cne_tcp_hdr *, hlen);
+
+        l4_len = (tcp->data_off & 0xf0) >> 2;
+        if (pktmbuf_data_len(m) < hlen + l4_len)
+            return IP4_REASM_NEXT_PKT_DROP;
+    }
+
+    sum = cnet_frag_cksum_mbuf(m, hlen, len - hlen, cne_ipv4_phdr_cksum(ip, 0));
+    if (__cne_raw_cksum_reduce(sum) != 0xffff)
+        return IP4_REASM_NEXT_PKT_DROP;
+
+done:
+    m->ol_flags = (m->ol_flags & ~CNE_MBUF_F_RX_L4_CKSUM_MASK) | CNE_MBUF_F_RX_L4_CKSUM_GOOD;
+    m->l3_len   = hlen;
+    m->l4_len   = l4_len;
+
+    return nxt;
+}
+
+static uint16_t
+ip4_reasm_node_process(struct cne_graph *graph, struct cne_node *node, void **objs,
+                       uint16_t nb_objs)
+{
+    struct ipv4_entry *ipv4 = this_stk->ipv4;
+    uint64_t now            = cne_rdtsc();
+    struct frag_key key;
+
+    memset(&key, 0, sizeof(key));
+    key.af = AF_INET;
+
+    for (uint16_t i = 0; i < nb_objs; i++) {
+        pktmbuf_t *m = objs[i];
+        struct cne_ipv4_hdr *ip;
+        uint16_t off, nxt;
+
+        ip  = pktmbuf_mtod(m, struct cne_ipv4_hdr *);
+        off = be16toh(ip->fragment_offset);
+
+        memcpy(key.src, &ip->src_addr, sizeof(ip->src_addr));
+        memcpy(key.dst, &ip->dst_addr, sizeof(ip->dst_addr));
+        key.id    = ip->packet_id;
+        key.proto = ip->next_proto_id;
+
+        /* The table holds the fragment, frees it or returns the complete datagram */
+        if (cnet_frag_insert(ipv4->frag_tbl, &key, m, cne_ipv4_hdr_len(ip), 0,
+                             (off & _OFF_MASK) << 3, (off & _OFF_MF) != 0, now, &m) < 0) {
+            ipv4->stats.ip_reassemble_failed++;
+            continue;
+        }
+        if (!m)
+            continue;
+
+        nxt = ip4_reasm_done(m);
+        if (nxt == IP4_REASM_NEXT_PKT_DROP)
+            ipv4->stats.ip_reassemble_failed++;
+
+        cne_node_enqueue_x1(graph, node, nxt, m);
+    }
+
+    return nb_objs;
+}
+
+static struct cne_node_register ip4_reasm_node = {
+    .process = ip4_reasm_node_process,
+    .name    = IP4_REASM_NODE_NAME,
+
+    .nb_edges = IP4_REASM_NEXT_MAX,
+    .next_nodes =
+        {
+            [IP4_REASM_NEXT_PKT_DROP] = PKT_DROP_NODE_NAME,
+            [IP4_REASM_NEXT_UDP]      = UDP_INPUT_NODE_NAME,
+#if CNET_ENABLE_TCP
+            [IP4_REASM_NEXT_TCP] = TCP_INPUT_NODE_NAME,
+#endif
+        },
+};
+
+CNE_NODE_REGISTER(ip4_reasm_node);
@@ -31,6 +31,7 @@
 #include "cnet_reg.h"
 #include "cnet_ipv6.h"            // for ipv6_entry, ipv6_stats, DEFAULT_I...
 #include "cnet_protosw.h"         // for protosw_entry
+#include "cnet_frag.h"            // for cnet_frag_tbl_create, cnet_frag_tbl_destroy
 #include "pktmbuf.h"              // for pktmbuf_t, pktmbuf_free
 #include <cne_fib6.h>             // for IPV6_ADDR_LEN
 #include <ip6_flowlabel.h>        // for srhash_init0()
@@ -56,6 +57,7 @@ __ipv6_stats_dump(stk_t *stk)
     _(ip6_mlookup_failed);
     _(ip6_forwarding_disabled);
 #undef _
+    cnet_frag_stats_dump(stk->ipv6->frag_tbl);
 }
 
 int
@@ -110,7 +112,15 @@ ipv6_create(void *_stk)
         return -1;
 
     stk->ipv6->ip6_forwarding = DEFAULT_FORWARDING_STATE;
-    stk->ipv6->reassem_ttl    = 0;
+    stk->ipv6->reassem_ttl    = CNET_FRAG_TTL_DEFAULT;
+    stk->ipv6->frag_ident     = (uint32_t)rand();
+
+    stk->ipv6->frag_tbl = cnet_frag_tbl_create(0, 0, stk->ipv6->reassem_ttl);
+    if (stk->ipv6->frag_tbl == NULL) {
+        free(stk->ipv6);
+        stk->ipv6 = NULL;
+        return -1;
+    }
 
     return 0;
 }
@@ -120,6 +130,8 @@ ipv6_destroy(void *_stk)
 {
     stk_t *stk = _stk;
 
+    if (stk->ipv6)
+        cnet_frag_tbl_destroy(stk->ipv6->frag_tbl);
     free(stk->ipv6);
     stk->ipv6 = NULL;
 
@@ -31,6 +31,7 @@ struct rt6_entry;
 struct ndp_entry;
 struct cne_lpm;
 struct ipfwd_info;
+struct frag_tbl;
 
 /* IPv6 Flow Entry */
 struct ip6_flowentry {
@@ -59,8 +60,10 @@ struct ipv6_stats {
 struct ipv6_entry {
     uint8_t ip6_forwarding;      /**< IP forwarding is enabled */
     uint8_t do_multicast;        /**< Allow multicast support */
-    uint16_t reassem_ttl;        /**< reassemble TTL value */
+    uint16_t reassem_ttl;        /**< reassemble TTL value in seconds */
+    uint32_t frag_ident;         /**< Identification of the next fragmented datagram */
     struct ipfwd_info *fwd_info; /**< Forwarding information */
+    struct frag_tbl *frag_tbl;   /**< Fragment reassembly table */
     struct ipv6_stats stats;     /**< simple stats for protocol */
     iofunc_t fastpath;           /**< Fastpath function pointer */
     iofunc_t dhcp6;              /**< DHCP6 function pointer */
@@ -0,0 +1,92 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright (c) 2023 Intel Corporation
+ */
+
+#include <cne_graph.h>               // for cne_node_register, CNE_NODE_REGISTER
+#include <cne_graph_worker.h>        // for cne_node, cne_node_enqueue_x1
+#include <net/cne_ip.h>              // for cne_ipv6_hdr
+#include <pktmbuf.h>                 // for pktmbuf_t, pktmbuf_mtod_offset
+#include <stdint.h>                  // for uint16_t, uint32_t
+#include <string.h>                  // for memcpy
+#include <cnet.h>                    // for this_cnet
+#include <cnet_stk.h>                // for this_stk
+#include <cnet_route6.h>             // for rt6_entry
+#include <cnet_netif.h>              // for netif, cnet_netif_from_index
+#include <cnet_ipv6.h>               // for ipv6_entry
+#include <cnet_frag.h>               // for cnet_frag_ip6, CNET_FRAG_MAX_FRAGS
+
+#include <cnet_node_names.h>
+#include "ip6_node_api.h"                 // for ip6_frag_node_get
+#include "ip6_frag_priv.h"                // for IP6_FRAG_NEXT_PKT_DROP
+#include "cne_branch_prediction.h"        // for likely, unlikely
+#include "cnet_fib_info.h"                // for fib6_info_lookup
+
+/*
+ * Split a datagram from ip6_output into MTU sized fragments with a fragment header after
+ * the IPv6 header, the L4 checksum has already been computed over the whole datagram.
+ */
+static inline void
+ip6_frag_one(struct cne_graph *graph, struct cne_node *node, pktmbuf_t *m)
+{
+    struct ipv6_entry *ipv6 = this_stk->ipv6;
+    pktmbuf_t *frags[CNET_FRAG_MAX_FRAGS];
+    uint8_t ipaddr[1][IPV6_ADDR_LEN];
+    struct cne_ipv6_hdr *ip6;
+    struct rt6_entry *rt6;
+    struct netif *nif;
+    int nb;
+
+    ip6 = pktmbuf_mtod_offset(m, struct cne_ipv6_hdr *, m->l2_len);
+    memcpy(ipaddr[0], ip6->src_addr, IPV6_ADDR_LEN);
+
+    if (unlikely(fib6_info_lookup(this_cnet->rt6_finfo, ipaddr, (void **)&rt6, 1) <= 0))
+        goto drop;
+
+    nif = cnet_netif_from_index(rt6->netif_idx);
+    if (unlikely(!nif))
+        goto drop;
+
+    nb = cnet_frag_ip6(m, nif->mtu, ipv6->frag_ident++, frags, CNET_FRAG_MAX_FRAGS);
+    if (nb < 0)
+        goto drop;
+
+    for (int i = 0; i < nb; i++)
+        cne_node_enqueue_x1(graph, node, rt6->netif_idx + IP6_FRAG_NEXT_MAX, frags[i]);
+    ipv6->frag_tbl->stats.frags_created += nb;
+
+    pktmbuf_free(m);
+    return;
+
+drop:
+    ipv6->frag_tbl->stats.frag_failed++;
+    cne_node_enqueue_x1(graph, node, IP6_FRAG_NEXT_PKT_DROP, m);
+}
+
+static uint16_t
+ip6_frag_node_process(struct cne_graph *graph, struct cne_node *node, void **objs,
+                      uint16_t nb_objs)
+{
+    for (uint16_t i = 0; i < nb_objs; i++)
+        ip6_frag_one(graph, node, objs[i]);
+
+    return nb_objs;
+}
+
+static struct cne_node_register ip6_frag_node = {
+    .process = ip6_frag_node_process,
+    .name    = IP6_FRAG_NODE_NAME,
+
+    .nb_edges = IP6_FRAG_NEXT_MAX,
+    .next_nodes =
+        {
+            [IP6_FRAG_NEXT_PKT_DROP] = PKT_DROP_NODE_NAME, /* TX output nodes go here */
+        },
+};
+
+struct cne_node_register *
+ip6_frag_node_get(void)
+{
+    return &ip6_frag_node;
+}
+
+CNE_NODE_REGISTER(ip6_frag_node);
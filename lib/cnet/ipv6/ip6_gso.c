@@ -0,0 +1,86 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright (c) 2023 Intel Corporation
+ */
+
+#include <cne_graph.h>               // for cne_node_register, CNE_NODE_REGISTER
+#include <cne_graph_worker.h>        // for cne_node, cne_node_enqueue
+#include <net/cne_ip.h>              // for cne_ipv6_hdr
+#include <pktmbuf.h>                 // for pktmbuf_t, pktmbuf_mtod_offset
+#include <stdint.h>                  // for uint16_t, uint8_t
+#include <string.h>                  // for memcpy
+#include <cnet.h>                    // for this_cnet
+#include <cnet_route6.h>             // for rt6_entry
+#include <cnet_netif.h>              // for netif, cnet_netif_from_index
+#include <cnet_ipv6.h>               // for IPV6_ADDR_LEN
+#include <cnet_tcp_gso.h>            // for cnet_tcp_gso_segment, TCP_GSO_MAX_SEGS
+
+#include <cnet_node_names.h>
+#include "ip6_node_api.h"                 // for ip6_gso_node_get
+#include "ip6_gso_priv.h"                 // for IP6_GSO_NEXT_PKT_DROP
+#include "cne_branch_prediction.h"        // for likely, unlikely
+#include "cnet_fib_info.h"                // for fib6_info_lookup
+
+/*
+ * Split a TCP super-segment from ip6_output into MSS sized frames, the Ethernet and IPv6
+ * headers are complete and the TCP checksum is left to the GSO code.
+ */
+static inline void
+ip6_gso_one(struct cne_graph *graph, struct cne_node *node, pktmbuf_t *m)
+{
+    pktmbuf_t *segs[TCP_GSO_MAX_SEGS];
+    uint8_t ipaddr[1][IPV6_ADDR_LEN];
+    struct cne_ipv6_hdr *ip6;
+    struct rt6_entry *rt6;
+    struct netif *nif;
+    int nb;
+
+    ip6 = pktmbuf_mtod_offset(m, struct cne_ipv6_hdr *, m->l2_len);
+    memcpy(ipaddr[0], ip6->src_addr, IPV6_ADDR_LEN);
+
+    if (unlikely(fib6_info_lookup(this_cnet->rt6_finfo, ipaddr, (void **)&rt6, 1) <= 0))
+        goto drop;
+
+    nif = cnet_netif_from_index(rt6->netif_idx);
+    if (unlikely(!nif))
+        goto drop;
+
+    nb = cnet_tcp_gso_segment(m, nif->tx_cksum_offload, segs, TCP_GSO_MAX_SEGS);
+    if (nb < 0)
+        goto drop;
+
+    /* The frames go to the TX node as one burst */
+    cne_node_enqueue(graph, node, rt6->netif_idx + IP6_GSO_NEXT_MAX, (void **)segs, nb);
+    return;
+
+drop:
+    cne_node_enqueue_x1(graph, node, IP6_GSO_NEXT_PKT_DROP, m);
+}
+
+static uint16_t
+ip6_gso_node_process(struct cne_graph *graph, struct cne_node *node, void **objs,
+                     uint16_t nb_objs)
+{
+    for (uint16_t i = 0; i < nb_objs; i++)
+        ip6_gso_one(graph, node, objs[i]);
+
+    return nb_objs;
+}
+
+static struct cne_node_register ip6_gso_node = {
+    .process = ip6_gso_node_process,
+    .name    = IP6_GSO_NODE_NAME,
+
+    .nb_edges = IP6_GSO_NEXT_MAX,
+    .next_nodes =
+        {
+            [IP6_GSO_NEXT_PKT_DROP] = PKT_DROP_NODE_NAME, /* TX output nodes go here */
+        },
+};
+
+struct cne_node_register *
+ip6_gso_node_get(void)
+{
+    return &ip6_gso_node;
+}
+
+CNE_NODE_REGISTER(ip6_gso_node);
@@ -0,0 +1,30 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright (c) 2023 Intel Corporation
+ */
+
+#ifndef __INCLUDE_IP6_GSO_PRIV_H__
+#define __INCLUDE_IP6_GSO_PRIV_H__
+
+/**
+ * @file ip6_gso_priv.h
+ *
+ * Next nodes of the ip6_gso node, the eth_tx nodes of each port are added after
+ * IP6_GSO_NEXT_MAX in the same way as the ip4_output node.
+ */
+
+#include <cne_common.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+enum cne_node_ip6_gso_next {
+    IP6_GSO_NEXT_PKT_DROP, /**< Packet drop node. */
+    IP6_GSO_NEXT_MAX,      /**< Number of next nodes of GSO node. */
+};
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __INCLUDE_IP6_GSO_PRIV_H__ */
@@ -119,10 +119,10 @@ ip6_input_node_process(struct cne_graph *graph, struct cne_node *node, void **ob
         ip6[3] = pktmbuf_mtod(mbuf3, struct cne_ipv6_hdr *);
 
         /* Adjust the data length for an IPv6 packet to the size given in the header. */
-        pktmbuf_data_len(mbuf0) = be16toh(ip6[0]->payload_len);
-        pktmbuf_data_len(mbuf1) = be16toh(ip6[1]->payload_len);
-        pktmbuf_data_len(mbuf2) = be16toh(ip6[2]->payload_len);
-        pktmbuf_data_len(mbuf3) = be16toh(ip6[3]->payload_len);
+        pktmbuf_data_len(mbuf0) = sizeof(struct cne_ipv6_hdr) + be16toh(ip6[0]->payload_len);
+        pktmbuf_data_len(mbuf1) = sizeof(struct cne_ipv6_hdr) + be16toh(ip6[1]->payload_len);
+        pktmbuf_data_len(mbuf2) = sizeof(struct cne_ipv6_hdr) + be16toh(ip6[2]->payload_len);
+        pktmbuf_data_len(mbuf3) = sizeof(struct cne_ipv6_hdr) + be16toh(ip6[3]->payload_len);
 
         /*
          * When the total length exceeds mbuf size, the size check/checksum below will
@@ -216,7 +216,7 @@ ip6_input_node_process(struct cne_graph *graph, struct cne_node *node, void **ob
         ip6[0] = pktmbuf_mtod(mbuf0, struct cne_ipv6_hdr *);
 
         /* Adjust the data length for an IPv6 packet to the size given in the header */
-        pktmbuf_data_len(mbuf0) = be16toh(ip6[0]->payload_len);
+        pktmbuf_data_len(mbuf0) = sizeof(struct cne_ipv6_hdr) + be16toh(ip6[0]->payload_len);
 
         /*
          * When the total length exceeds mbuf size, the size check/checksum below will
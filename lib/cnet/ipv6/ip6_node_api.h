@@ -72,6 +72,22 @@ CNDP_API struct cne_node_register *ip6_output_node_get(void);
  */
 CNDP_API int ip6_output_set_next(uint16_t port_id, uint16_t next_index);
 
+/**
+ * Get the ipv6 fragment node.
+ *
+ * @return
+ *   Pointer to the ipv6 fragment node.
+ */
+CNDP_API struct cne_node_register *ip6_frag_node_get(void);
+
+/**
+ * Get the ipv6 TCP GSO node.
+ *
+ * @return
+ *   Pointer to the ipv6 GSO node.
+ */
+CNDP_API struct cne_node_register *ip6_gso_node_get(void);
+
 #ifdef __cplusplus
 }
 #endif
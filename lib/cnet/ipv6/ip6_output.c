@@ -33,6 +33,7 @@
 #include "cnet_fib_info.h"
 #include "ip6_flowlabel.h"
 #include "nd6.h"
+#include "cnet_frag.h"
 
 static struct ip6_output_node_main *ip6_output_nm;
 
@@ -41,6 +42,23 @@ struct ip6_output_node_ctx {
 };
 #define IP6_OUTPUT_NODE_LAST_NEXT(ctx) (((struct ip6_output_node_ctx *)ctx)->next_index)
 
+/* UDP/TCP checksum of a packet which can be chained, the L4 checksum must be zero */
+static inline uint16_t
+ip6_output_cksum(pktmbuf_t *m, struct cne_ipv6_hdr *ip, uint16_t phdr)
+{
+    uint32_t off = m->l2_len + m->l3_len;
+    uint16_t cksum;
+
+    cksum = ~__cne_raw_cksum_reduce(
+        cnet_frag_cksum_mbuf(m, off, pktmbuf_pkt_len(m) - off, phdr));
+
+    /* Per RFC 768 a zero UDP checksum is transmitted as all ones */
+    if (cksum == 0 && ip->proto == IPPROTO_UDP)
+        cksum = 0xffff;
+
+    return cksum;
+}
+
 static inline uint16_t
 ip6_output_header(struct cne_node *node __cne_unused, pktmbuf_t *m, uint16_t nxt)
 {
@@ -55,6 +73,7 @@ ip6_output_header(struct cne_node *node __cne_unused, pktmbuf_t *m, uint16_t nxt
     uint8_t ipaddr[IPV6_ADDR_LEN] = {0};
     void *l4;
     uint32_t nfllabel, exfllabel, tclass = 0;
+    bool frag, gso;
 
     pcb = m->userptr;
 
@@ -80,7 +99,7 @@ ip6_output_header(struct cne_node *node __cne_unused, pktmbuf_t *m, uint16_t nxt
         pcb->ip6_fl_entry->flowlabel = nfllabel;
     }
     ip6_flow_hdr(ip, tclass, nfllabel);
-    ip->payload_len = htobe16(pktmbuf_data_len(m));
+    ip->payload_len = htobe16(pktmbuf_pkt_len(m) - m->l3_len);
     ip->hop_limits  = pcb->ttl;
     ip->proto       = pcb->ip_proto; /* Protocol, next header. */
     memcpy(ip->dst_addr, md->faddr.cin6_addr.s6_addr, IPV6_ADDR_LEN);
@@ -97,20 +116,48 @@ ip6_output_header(struct cne_node *node __cne_unused, pktmbuf_t *m, uint16_t nxt
         nif = cnet_netif_from_index(rt6->netif_idx);
 
         ether_addr_copy(&nif->mac, &eth->s_addr);
-        eth->ether_type = htobe16(CNE_ETHER_TYPE_IPV4);
+        eth->ether_type = htobe16(CNE_ETHER_TYPE_IPV6);
         nif->ip_ident += ip->payload_len;
 
-        /* Do the UDP/TCP checksum if enabled */
+        /* Datagrams larger than the MTU go to the fragment node, GSO frames fit the MTU */
+        gso  = (m->ol_flags & CNE_MBUF_F_TX_TCP_SEG) != 0;
+        frag = !gso && nif->mtu && (pktmbuf_pkt_len(m) - m->l2_len) > nif->mtu;
+
+        /*
+         * Do the UDP/TCP checksum if enabled, with TX checksum offload only the pseudo
+         * header checksum is done here and the NIC completes it. The checksum of a
+         * datagram being fragmented or chained is done here over all of the segments.
+         */
         if (pcb->ip_proto == IPPROTO_UDP) {
             if (pcb->opt_flag & UDP_CHKSUM_FLAG) {
                 struct cne_udp_hdr *udp = l4;
 
-                udp->dgram_cksum = cne_ipv6_udptcp_cksum(ip, l4);
+                if (unlikely(frag || m->nb_segs > 1))
+                    udp->dgram_cksum = ip6_output_cksum(m, ip, cne_ipv6_phdr_cksum(ip, 0));
+                else if (nif->tx_cksum_offload) {
+                    m->ol_flags |= CNE_MBUF_F_TX_IPV6 | CNE_MBUF_F_TX_UDP_CKSUM;
+                    udp->dgram_cksum = cne_ipv6_phdr_cksum(ip, m->ol_flags);
+                } else
+                    udp->dgram_cksum = cne_ipv6_udptcp_cksum(ip, l4);
             }
         } else if (pcb->ip_proto == IPPROTO_TCP) {
             struct cne_tcp_hdr *tcp = l4;
-
-            tcp->cksum = cne_ipv6_udptcp_cksum(ip, l4);
+            uint16_t l4_len         = pktmbuf_pkt_len(m) - m->l2_len - m->l3_len;
+            uint16_t phdr;
+
+            /* TCP sends from the PCB key, a hashed PCB has the pseudo header sum cached */
+            phdr = (likely(pcb->hashed)) ? cnet_pcb_phdr_cksum(pcb, l4_len)
+                                         : cne_ipv6_phdr_cksum(ip, 0);
+
+            if (unlikely(gso))
+                tcp->cksum = 0; /* The GSO node does the checksum of each frame */
+            else if (unlikely(frag || m->nb_segs > 1))
+                tcp->cksum = ip6_output_cksum(m, ip, phdr);
+            else if (nif->tx_cksum_offload) {
+                m->ol_flags |= CNE_MBUF_F_TX_IPV6 | CNE_MBUF_F_TX_TCP_CKSUM;
+                tcp->cksum = phdr;
+            } else
+                tcp->cksum = ~__cne_raw_cksum_reduce(cne_cksum_sum(l4, l4_len, phdr));
         } else
             return nxt;
 
@@ -119,7 +166,11 @@ ip6_output_header(struct cne_node *node __cne_unused, pktmbuf_t *m, uint16_t nxt
         if (likely(fib6_info_lookup(cnet->arp_finfo, &ipaddr, (void **)&nd6, 1) > 0)) {
             ether_addr_copy(&nd6->ll_addr, &eth->d_addr);
 
-            nxt = rt6->netif_idx + IP6_OUTPUT_NEXT_MAX;
+            if (unlikely(gso))
+                nxt = IP6_OUTPUT_NEXT_GSO;
+            else
+                nxt = (unlikely(frag)) ? IP6_OUTPUT_NEXT_FRAG
+                                       : rt6->netif_idx + IP6_OUTPUT_NEXT_MAX;
         }
     }
 
@@ -294,7 +345,9 @@ static struct cne_node_register ip6_output_node = {
     .next_nodes =
         {
             [IP6_OUTPUT_NEXT_PKT_DROP]    = PKT_DROP_NODE_NAME,    /* Drop packet node */
-            [IP6_OUTPUT_NEXT_ND6_REQUEST] = ND6_REQUEST_NODE_NAME, /* TX output nodes go here */
+            [IP6_OUTPUT_NEXT_ND6_REQUEST] = ND6_REQUEST_NODE_NAME, /* NDP request node */
+            [IP6_OUTPUT_NEXT_FRAG]        = IP6_FRAG_NODE_NAME,    /* Fragment node */
+            [IP6_OUTPUT_NEXT_GSO]         = IP6_GSO_NODE_NAME,     /* TX output nodes go here */
         },
 };
 
@@ -25,6 +25,8 @@ extern "C" {
 enum cne_node_ip6_output_next {
     IP6_OUTPUT_NEXT_PKT_DROP,    /**< Packet drop node. */
     IP6_OUTPUT_NEXT_ND6_REQUEST, /**< Packet NDP 6 request node. */
+    IP6_OUTPUT_NEXT_FRAG,        /**< Packet fragment node. */
+    IP6_OUTPUT_NEXT_GSO,         /**< TCP GSO node. */
     IP6_OUTPUT_NEXT_MAX,         /**< Number of next nodes of lookup node. */
 };
 
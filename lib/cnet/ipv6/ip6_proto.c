@@ -190,7 +190,8 @@ ip6_proto_node_init(const struct cne_graph *graph, struct cne_node *node)
 #if CNET_ENABLE_TCP
     proto_nxt[IPPROTO_TCP] = CNE_NODE_IP6_INPUT_PROTO_TCP;
 #endif
-    proto_nxt[IPPROTO_ICMPV6] = CNE_NODE_IP6_INPUT_PROTO_ICMP6;
+    proto_nxt[IPPROTO_ICMPV6]   = CNE_NODE_IP6_INPUT_PROTO_ICMP6;
+    proto_nxt[IPPROTO_FRAGMENT] = CNE_NODE_IP6_INPUT_PROTO_REASM;
 
     return 0;
 }
@@ -207,9 +208,10 @@ static struct cne_node_register ip6_proto_node = {
             [CNE_NODE_IP6_INPUT_PROTO_DROP] = PKT_DROP_NODE_NAME,
             [CNE_NODE_IP6_INPUT_PROTO_UDP]  = UDP_INPUT_NODE_NAME,
 #if CNET_ENABLE_TCP
-            [CNE_NODE_IP6_INPUT_PROTO_TCP] = TCP_INPUT_NODE_NAME,
+            [CNE_NODE_IP6_INPUT_PROTO_TCP] = TCP_GRO_NODE_NAME,
 #endif
             [CNE_NODE_IP6_INPUT_PROTO_ICMP6] = ICMP6_INPUT_NODE_NAME,
+            [CNE_NODE_IP6_INPUT_PROTO_REASM] = IP6_REASM_NODE_NAME,
         },
 };
 
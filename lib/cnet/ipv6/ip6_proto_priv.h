@@ -26,6 +26,7 @@ enum cne_node_ip6_proto_next {
     CNE_NODE_IP6_INPUT_PROTO_TCP, /**< TCP protocol. */
 #endif
     CNE_NODE_IP6_INPUT_PROTO_ICMP6, /**< ICMPv6 protocol. */
+    CNE_NODE_IP6_INPUT_PROTO_REASM, /**< Fragment reassembly node. */
     CNE_NODE_IP6_INPUT_PROTO_MAX,   /**< Number of next nodes of protocol node.*/
 };
 
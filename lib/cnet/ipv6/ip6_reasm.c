@@ -0,0 +1,152 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright (c) 2023 Intel Corporation
+ */
+
+#include <sys/socket.h>              // for AF_INET6
+#include <netinet/in.h>              // for IPPROTO_UDP, IPPROTO_TCP
+#include <cne_graph.h>               // for cne_node_register, CNE_NODE_REGISTER
+#include <cne_graph_worker.h>        // for cne_node, cne_node_enqueue_x1
+#include <cne_cycles.h>              // for cne_rdtsc
+#include <net/cne_ip.h>              // for cne_ipv6_hdr, cne_ipv6_fragment_ext
+#include <net/cne_udp.h>             // for cne_udp_hdr
+#include <net/cne_tcp.h>             // for cne_tcp_hdr
+#include <pktmbuf.h>                 // for pktmbuf_t, pktmbuf_mtod
+#include <string.h>                  // for memcpy, memset
+#include <cnet_stk.h>                // for this_stk
+#include <cnet_ipv6.h>               // for ipv6_entry
+#include <cnet_frag.h>               // for cnet_frag_insert, cnet_frag_cksum_mbuf
+
+#include <cnet_node_names.h>
+#include "ip6_reasm_priv.h"               // for IP6_REASM_NEXT_PKT_DROP
+#include "cne_branch_prediction.h"        // for likely, unlikely
+#include "cne_common.h"                   // for __cne_unused
+
+/*
+ * Fix up the header of a reassembled datagram and verify the L4 checksum over the
+ * chained fragments, the UDP and TCP input nodes only handle a contiguous packet.
+ */
+static inline uint16_t
+ip6_reasm_done(pktmbuf_t *m)
+{
+    struct cne_ipv6_hdr *ip6 = pktmbuf_mtod(m, struct cne_ipv6_hdr *);
+    uint16_t hlen            = sizeof(struct cne_ipv6_hdr);
+    uint32_t len             = pktmbuf_pkt_len(m);
+    uint16_t nxt, l4_len;
+    uint32_t sum;
+
+    if (len - hlen > CNET_FRAG_MAX_DATAGRAM)
+        return IP6_REASM_NEXT_PKT_DROP;
+
+    ip6->payload_len = htobe16((uint16_t)(len - hlen));
+
+    switch (ip6->proto) {
+    case IPPROTO_UDP:
+        nxt    = IP6_REASM_NEXT_UDP;
+        l4_len = sizeof(struct cne_udp_hdr);
+        break;
+#if CNET_ENABLE_TCP
+    case IPPROTO_TCP:
+        nxt    = IP6_REASM_NEXT_TCP;
+        l4_len = sizeof(struct cne_tcp_hdr);
+        break;
+#endif
+    default:
+        return IP6_REASM_NEXT_PKT_DROP;
+    }
+
+    /* The L4 header must be in the first fragment */
+    if (pktmbuf_data_len(m) < hlen + l4_len)
+        return IP6_REASM_NEXT_PKT_DROP;
+
+#if CNET_ENABLE_TCP
+    if (nxt == IP6_REASM_NEXT_TCP) {
+        struct cne_tcp_hdr *tcp = pktmbuf_mtod_offset(m, struct cne_tcp_hdr *, hlen);
+
+        l4_len = (tcp->data_off & 0xf0) >> 2;
+        if (pktmbuf_data_len(m) < hlen + l4_len)
+            return IP6_REASM_NEXT_PKT_DROP;
+    }
+#endif
+
+    /* The UDP checksum is mandatory for IPv6 */
+    sum = cnet_frag_cksum_mbuf(m, hlen, len - hlen, cne_ipv6_phdr_cksum(ip6, 0));
+    if (__cne_raw_cksum_reduce(sum) != 0xffff)
+        return IP6_REASM_NEXT_PKT_DROP;
+
+    m->ol_flags = (m->ol_flags & ~CNE_MBUF_F_RX_L4_CKSUM_MASK) | CNE_MBUF_F_RX_L4_CKSUM_GOOD;
+    m->l3_len   = hlen;
+    m->l4_len   = l4_len;
+
+    return nxt;
+}
+
+static uint16_t
+ip6_reasm_node_process(struct cne_graph *graph, struct cne_node *node, void **objs,
+                       uint16_t nb_objs)
+{
+    struct ipv6_entry *ipv6 = this_stk->ipv6;
+    uint64_t now            = cne_rdtsc();
+    struct frag_key key;
+
+    memset(&key, 0, sizeof(key));
+    key.af = AF_INET6;
+
+    for (uint16_t i = 0; i < nb_objs; i++) {
+        pktmbuf_t *m = objs[i];
+        struct cne_ipv6_fragment_ext *fh;
+        struct cne_ipv6_hdr *ip6;
+        uint16_t frag_data, nxt;
+
+        ip6 = pktmbuf_mtod(m, struct cne_ipv6_hdr *);
+
+        /* Only a fragment header directly after the IPv6 header is supported */
+        if (unlikely(pktmbuf_data_len(m) < sizeof(*ip6) + sizeof(*fh))) {
+            ipv6->stats.ip6_reassemble_failed++;
+            cne_node_enqueue_x1(graph, node, IP6_REASM_NEXT_PKT_DROP, m);
+            continue;
+        }
+        fh        = pktmbuf_mtod_offset(m, struct cne_ipv6_fragment_ext *, sizeof(*ip6));
+        frag_data = be16toh(fh->frag_data);
+
+        memcpy(key.src, ip6->src_addr, sizeof(key.src));
+        memcpy(key.dst, ip6->dst_addr, sizeof(key.dst));
+        key.id = fh->id;
+
+        /* The saved header of the first fragment carries the upper layer protocol */
+        ip6->proto = fh->next_header;
+
+        if (cnet_frag_insert(ipv6->frag_tbl, &key, m, sizeof(*ip6), sizeof(*fh),
+                             frag_data & CNE_IPV6_EHDR_FO_MASK, CNE_IPV6_GET_MF(frag_data), now,
+                             &m) < 0) {
+            ipv6->stats.ip6_reassemble_failed++;
+            continue;
+        }
+        if (!m)
+            continue;
+
+        nxt = ip6_reasm_done(m);
+        if (nxt == IP6_REASM_NEXT_PKT_DROP)
+            ipv6->stats.ip6_reassemble_failed++;
+
+        cne_node_enqueue_x1(graph, node, nxt, m);
+    }
+
+    return nb_objs;
+}
+
+static struct cne_node_register ip6_reasm_node = {
+    .process = ip6_reasm_node_process,
+    .name    = IP6_REASM_NODE_NAME,
+
+    .nb_edges = IP6_REASM_NEXT_MAX,
+    .next_nodes =
+        {
+            [IP6_REASM_NEXT_PKT_DROP] = PKT_DROP_NODE_NAME,
+            [IP6_REASM_NEXT_UDP]      = UDP_INPUT_NODE_NAME,
+#if CNET_ENABLE_TCP
+            [IP6_REASM_NEXT_TCP] = TCP_INPUT_NODE_NAME,
+#endif
+        },
+};
+
+CNE_NODE_REGISTER(ip6_reasm_node);
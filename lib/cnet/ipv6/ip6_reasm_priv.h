@@ -0,0 +1,33 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright (c) 2023 Intel Corporation
+ */
+
+#ifndef __INCLUDE_IP6_REASM_PRIV_H__
+#define __INCLUDE_IP6_REASM_PRIV_H__
+
+/**
+ * @file ip6_reasm_priv.h
+ *
+ * Next nodes of the ip6_reasm node, the reassembled datagram is passed to the protocol.
+ */
+
+#include <cne_common.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+enum cne_node_ip6_reasm_next {
+    IP6_REASM_NEXT_PKT_DROP, /**< Packet drop node. */
+    IP6_REASM_NEXT_UDP,      /**< UDP protocol. */
+#if CNET_ENABLE_TCP
+    IP6_REASM_NEXT_TCP, /**< TCP protocol. */
+#endif
+    IP6_REASM_NEXT_MAX, /**< Number of next nodes of reassembly node. */
+};
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __INCLUDE_IP6_REASM_PRIV_H__ */
@@ -168,7 +168,7 @@ cnet_nd6_delete(struct in6_addr *addr)
             if (fib_info_free(fi, (uint32_t)idx) != entry)
                 CNE_WARN("Freed entry does not match\n");
 
-            cnet_nd6_free(entry);
+            cnet_rcu_defer_free(this_cnet->nd6_obj, entry);
             return 0;
         }
     }
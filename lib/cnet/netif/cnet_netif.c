@@ -226,6 +226,8 @@ cnet_netif_attach_ports(struct cnet *cnet)
     struct netif *netif = NULL;
 
     for (uint16_t lpid = 0; lpid < CNE_MAX_ETHPORTS; lpid++) {
+        struct offloads off = {0};
+
         if ((netif = vec_at_index(this_cnet->netifs, lpid)) == NULL)
             continue;
 
@@ -237,6 +239,14 @@ cnet_netif_attach_ports(struct cnet *cnet)
         netif->drv = drv;
         drv->netif = netif;
 
+        /* Fragment on output to the standard Ethernet MTU until one is configured */
+        if (netif->mtu == 0)
+            netif->mtu = ETHERMTU;
+
+        /* Use the NIC for the TCP/UDP checksum when the lport can pass it down */
+        if (pktdev_offloads_get(lpid, &off) == 0)
+            netif->tx_cksum_offload = (off.tx_checksum_offload) ? 1 : 0;
+
         pktdev_stats_reset(lpid);
     }
 
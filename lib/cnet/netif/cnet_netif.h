@@ -89,6 +89,7 @@ struct netif {
     uint16_t ip_ident;                         /**< IP identification value */
     uint16_t family;                           /**< Interface family */
     uint16_t mtu;                              /**< Max Transmission Unit */
+    uint16_t tx_cksum_offload;                 /**< The lport can offload the TX L4 checksum */
     char ifname[IF_NAMESIZE + 1];              /**< ifname of interface */
     char netdev_name[IF_NAMESIZE + 1];         /**< netdev name of interface */
     struct drv_entry *drv;                     /**< Driver interface structure */
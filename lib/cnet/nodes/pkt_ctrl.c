@@ -25,6 +25,8 @@ eth_node4_config(struct pkt_eth_node_config *conf, uint16_t nb_confs)
 {
     struct cne_node_register *ip4_forward_node;
     struct cne_node_register *ip4_output_node;
+    struct cne_node_register *ip4_frag_node;
+    struct cne_node_register *ip4_gso_node;
     struct eth_tx_node_main *tx_node_data;
     uint16_t port_id;
     struct cne_node_register *tx_node;
@@ -35,6 +37,8 @@ eth_node4_config(struct pkt_eth_node_config *conf, uint16_t nb_confs)
 
     ip4_forward_node = ip4_forward_node_get();
     ip4_output_node  = ip4_output_node_get();
+    ip4_frag_node    = ip4_frag_node_get();
+    ip4_gso_node     = ip4_gso_node_get();
 
     tx_node_data = eth_tx_node_data_get();
     tx_node      = eth_tx_node_get();
@@ -85,6 +89,12 @@ eth_node4_config(struct pkt_eth_node_config *conf, uint16_t nb_confs)
         /* Add this tx port node as next output to ip4_output_node */
         cne_node_edge_update(ip4_output_node->id, CNE_EDGE_ID_INVALID, &next_nodes, 1);
 
+        /* Add this tx port node as next output to ip4_frag_node */
+        cne_node_edge_update(ip4_frag_node->id, CNE_EDGE_ID_INVALID, &next_nodes, 1);
+
+        /* Add this tx port node as next output to ip4_gso_node */
+        cne_node_edge_update(ip4_gso_node->id, CNE_EDGE_ID_INVALID, &next_nodes, 1);
+
         /* Assuming edge id is the last one alloc'ed */
         if (ip4_forward_set_next(port_id, cne_node_edge_count(ip4_forward_node->id) - 1) < 0)
             goto err;
@@ -113,12 +123,16 @@ eth_node6_config(struct pkt_eth_node_config *conf, uint16_t nb_confs)
 {
     struct cne_node_register *ip6_forward_node;
     struct cne_node_register *ip6_output_node;
+    struct cne_node_register *ip6_frag_node;
+    struct cne_node_register *ip6_gso_node;
     uint16_t port_id;
     char name[CNE_NODE_NAMESIZE] = {0};
     const char *next_nodes       = name;
 
     ip6_forward_node = ip6_forward_node_get();
     ip6_output_node  = ip6_output_node_get();
+    ip6_frag_node    = ip6_frag_node_get();
+    ip6_gso_node     = ip6_gso_node_get();
 
     for (int i = 0; i < nb_confs; i++) {
         port_id = conf[i].port_id;
@@ -135,6 +149,12 @@ eth_node6_config(struct pkt_eth_node_config *conf, uint16_t nb_confs)
         /* Add this tx port node as next output to ip6_output_node */
         cne_node_edge_update(ip6_output_node->id, CNE_EDGE_ID_INVALID, &next_nodes, 1);
 
+        /* Add this tx port node as next output to ip6_frag_node */
+        cne_node_edge_update(ip6_frag_node->id, CNE_EDGE_ID_INVALID, &next_nodes, 1);
+
+        /* Add this tx port node as next output to ip6_gso_node */
+        cne_node_edge_update(ip6_gso_node->id, CNE_EDGE_ID_INVALID, &next_nodes, 1);
+
         /* Assuming edge id is the last one alloc'ed */
         if (ip6_forward_set_next(port_id, cne_node_edge_count(ip6_forward_node->id) - 1) < 0)
             goto err;
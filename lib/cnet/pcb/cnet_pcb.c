@@ -8,10 +8,24 @@
 #include "../chnl/chnl_priv.h"
 #include <cnet_chnl.h>         // for chnl_protocol_str, chnl, AF_INET
 #include <netinet/in.h>        // for INADDR_ANY, ntohs
+#include <cne_hash.h>          // for cne_hash_create, cne_hash_lookup_bulk_data
+#include <stdlib.h>            // for calloc, free
+#include <net/cne_cksum.h>     // for cne_cksum_sum
+#include <cne_jhash.h>         // for cne_jhash_2words
+#ifdef CNE_MACHINE_CPUFLAG_SSE4_2
+#include <cne_hash_crc.h>        // for cne_hash_crc
+
+#define DEFAULT_HASH_FUNC cne_hash_crc
+#else
+#define DEFAULT_HASH_FUNC cne_jhash
+#endif
 
 #include "cnet_pcb.h"
 #include "cne_inet.h"        // for CIN_PORT, CIN_CADDR, CIN_F...
 
+#define PCB_HASH_MIN_ENTRIES 64 /**< Smallest PCB hash table to create */
+#define CNET_REUSEPORT_MAX   64 /**< Max listeners of a reuseport group on one stack */
+
 /*
  * Lookup a PCB in the given list to locate the matching PCB or near matching
  * PCB. The flag value denotes if the match is EXACT or a best match. With the
@@ -145,13 +159,359 @@ pcb_v6_lookup(struct pcb_entry **vec, struct pcb_key *key, int32_t flag)
     return match;
 }
 
+/*
+ * A key is fully specified when both the local and foreign addresses are set,
+ * only these keys can be matched without wildcards and stored in the hash.
+ */
+static inline int
+pcb_key_is_full(struct pcb_key *key, int ipv6)
+{
+    if (ipv6)
+        return !inet6_addr_is_any(&CIN6_ADDR(&key->laddr)) &&
+               !inet6_addr_is_any(&CIN6_ADDR(&key->faddr));
+
+    return (CIN_CADDR(&key->laddr) != INADDR_ANY) && (CIN_CADDR(&key->faddr) != INADDR_ANY);
+}
+
+static inline int
+pcb_is_ipv6(struct pcb_entry *pcb)
+{
+    return is_pcb_dom_inet6(pcb) || CIN_FAMILY(&pcb->key.laddr) == AF_INET6 ||
+           CIN_FAMILY(&pcb->key.faddr) == AF_INET6;
+}
+
+static void
+pcb_wild_remove(struct pcb_hd *hd, struct pcb_entry *pcb)
+{
+    int idx = vec_find_index(hd->wild, pcb);
+
+    if (idx >= 0) {
+        uint32_t n = vec_len(hd->wild) - idx - 1;
+
+        /* Keep the list order, first entry added wins on equal wildcard counts */
+        if (n)
+            memmove(&hd->wild[idx], &hd->wild[idx + 1], n * sizeof(struct pcb_entry *));
+        vec_dec_len(hd->wild);
+    }
+}
+
+/*
+ * Sum of the pseudo header less the L4 length, the IPv4 and IPv6 pseudo headers both sum
+ * to the addresses plus the protocol and the length as 16 bit words in network order.
+ */
+static inline uint32_t
+pcb_phdr_sum(struct pcb_entry *pcb, int ipv6)
+{
+    size_t alen = (ipv6) ? sizeof(struct in6_addr) : sizeof(struct in_addr);
+    uint32_t sum;
+
+    sum = cne_cksum_sum(pcb->hkey.faddr, alen, htobe16(pcb->ip_proto));
+    return cne_cksum_sum(pcb->hkey.laddr, alen, sum);
+}
+
+static void
+pcb_hash_add(struct pcb_hd *hd, struct pcb_entry *pcb)
+{
+    int ipv6 = pcb_is_ipv6(pcb);
+
+    /*
+     * Only listeners and partially bound PCBs are kept on the wildcard list, a
+     * duplicate 4-tuple or a full hash table also falls back to the list.
+     */
+    if (hd->hash && CIN_PORT(&pcb->key.laddr) && pcb_key_is_full(&pcb->key, ipv6)) {
+        cnet_pcb_hkey_init(&pcb->hkey, &pcb->key, ipv6);
+
+        if (cne_hash_lookup(hd->hash, &pcb->hkey) < 0 &&
+            cne_hash_add_key_data(hd->hash, &pcb->hkey, pcb) == 0) {
+            pcb->hashed   = 1;
+            pcb->phdr_sum = pcb_phdr_sum(pcb, ipv6);
+            return;
+        }
+    }
+
+    vec_add(hd->wild, pcb);
+}
+
+static void
+pcb_hash_del(struct pcb_hd *hd, struct pcb_entry *pcb)
+{
+    if (pcb->hashed) {
+        if (cne_hash_del_key(hd->hash, &pcb->hkey) < 0)
+            CNE_WARN("PCB %p not found in hash table\n", pcb);
+        pcb->hashed = 0;
+    } else
+        pcb_wild_remove(hd, pcb);
+}
+
+int
+cnet_pcb_hd_init(struct pcb_hd *hd, const char *name, uint32_t entries)
+{
+    struct cne_hash_parameters params = {0};
+
+    if (!hd || !name)
+        CNE_ERR_RET("Invalid parameters\n");
+
+    params.name      = name;
+    params.entries   = CNE_MAX(entries, (uint32_t)PCB_HASH_MIN_ENTRIES);
+    params.key_len   = sizeof(struct pcb_hkey);
+    params.hash_func = DEFAULT_HASH_FUNC;
+    params.socket_id = -1;
+
+    hd->hash = cne_hash_create(&params);
+    if (!hd->hash)
+        CNE_ERR_RET("Unable to create PCB hash table %s\n", name);
+
+    return 0;
+}
+
+void
+cnet_pcb_hd_free(struct pcb_hd *hd)
+{
+    if (!hd)
+        return;
+
+    cne_hash_free(hd->hash);
+    hd->hash = NULL;
+    vec_free(hd->wild);
+    hd->wild = NULL;
+    vec_free(hd->vec);
+    hd->vec = NULL;
+}
+
+void
+cnet_pcb_link(struct pcb_hd *hd, struct pcb_entry *pcb)
+{
+    pcb->hd     = hd;
+    pcb->hashed = 0;
+
+    vec_add(hd->vec, pcb);
+    pcb_hash_add(hd, pcb);
+}
+
+void
+cnet_pcb_unlink(struct pcb_entry *pcb)
+{
+    if (pcb && pcb->hd) {
+        pcb_hash_del(pcb->hd, pcb);
+        pcb->hd = NULL;
+    }
+}
+
+void
+cnet_pcb_rehash(struct pcb_entry *pcb)
+{
+    if (pcb && pcb->hd) {
+        pcb_hash_del(pcb->hd, pcb);
+        pcb_hash_add(pcb->hd, pcb);
+    }
+}
+
+/*
+ * With a fully specified key only a PCB with the same 4-tuple can match with
+ * zero wildcards and those PCBs are in the hash table. On a miss the best match
+ * can only be found in the wildcard list, which keeps the wildcard precedence of
+ * the linear scan. Partial keys used by bind() still scan all of the PCBs.
+ */
 struct pcb_entry *
 cnet_pcb_lookup(struct pcb_hd *hd, struct pcb_key *key, int32_t flag)
 {
-    if (flag & IPV6_TYPE)
-        return pcb_v6_lookup(hd->vec, key, flag);
+    struct pcb_entry **vec = hd->vec;
+    int ipv6 = (flag & IPV6_TYPE) || CIN_FAMILY(&key->laddr) == AF_INET6;
+
+    if (hd->hash && pcb_key_is_full(key, ipv6)) {
+        struct pcb_hkey hk;
+        void *pcb;
+
+        cnet_pcb_hkey_init(&hk, key, ipv6);
+        if (cne_hash_lookup_data(hd->hash, &hk, &pcb) >= 0)
+            return pcb;
+
+        vec = hd->wild;
+    }
+
+    if (ipv6)
+        return pcb_v6_lookup(vec, key, flag);
     else
-        return pcb_v4_lookup(hd->vec, key, flag);
+        return pcb_v4_lookup(vec, key, flag);
+}
+
+int
+cnet_pcb_lookup_bulk(struct pcb_hd *hd, struct pcb_key **keys, uint32_t nb_keys,
+                     struct pcb_entry **pcbs)
+{
+    struct pcb_hkey hkeys[CNE_HASH_LOOKUP_BULK_MAX];
+    const void *kptrs[CNE_HASH_LOOKUP_BULK_MAX];
+    void *data[CNE_HASH_LOOKUP_BULK_MAX];
+    uint32_t idx[CNE_HASH_LOOKUP_BULK_MAX];
+    int hits = 0;
+
+    for (uint32_t i = 0; i < nb_keys; i++)
+        pcbs[i] = NULL;
+
+    if (!hd->hash)
+        return 0;
+
+    for (uint32_t base = 0; base < nb_keys; base += CNE_HASH_LOOKUP_BULK_MAX) {
+        uint32_t cnt = CNE_MIN(nb_keys - base, (uint32_t)CNE_HASH_LOOKUP_BULK_MAX);
+        uint64_t hit_mask = 0;
+        uint32_t n = 0;
+
+        for (uint32_t i = base; i < base + cnt; i++) {
+            int ipv6 = CIN_FAMILY(&keys[i]->laddr) == AF_INET6;
+
+            if (!pcb_key_is_full(keys[i], ipv6))
+                continue;
+
+            cnet_pcb_hkey_init(&hkeys[n], keys[i], ipv6);
+            kptrs[n] = &hkeys[n];
+            idx[n++] = i;
+        }
+
+        if (n == 0 || cne_hash_lookup_bulk_data(hd->hash, kptrs, n, &hit_mask, data) <= 0)
+            continue;
+
+        for (uint32_t j = 0; j < n; j++) {
+            if (hit_mask & (1ULL << j)) {
+                pcbs[idx[j]] = data[j];
+                hits++;
+            }
+        }
+    }
+
+    return hits;
+}
+
+static inline bool
+reuseport_match(struct pcb_reuseport *grp, uint16_t proto, struct in_caddr *laddr)
+{
+    if (grp->ip_proto != proto || CIN_FAMILY(&grp->laddr) != CIN_FAMILY(laddr) ||
+        CIN_PORT(&grp->laddr) != CIN_PORT(laddr))
+        return false;
+
+    if (CIN_FAMILY(laddr) == AF_INET6)
+        return inet6_addr_cmp(&CIN6_ADDR(&grp->laddr), &CIN6_ADDR(laddr));
+
+    return CIN_CADDR(&grp->laddr) == CIN_CADDR(laddr);
+}
+
+/* Called with the cnet lock held */
+static void
+reuseport_put(struct cnet *cnet, struct pcb_reuseport *grp)
+{
+    int idx;
+
+    if (--grp->nb_pcbs)
+        return;
+
+    idx = vec_find_index(cnet->reuseport, grp);
+    if (idx >= 0) {
+        cnet->reuseport[idx] = cnet->reuseport[vec_len(cnet->reuseport) - 1];
+        vec_dec_len(cnet->reuseport);
+    }
+    free(grp);
+}
+
+int
+cnet_pcb_reuseport_join(struct pcb_entry *pcb, struct in_caddr *laddr, bool reuse)
+{
+    struct cnet *cnet = this_cnet;
+    struct pcb_reuseport *grp, *found = NULL;
+
+    if (!cnet || !pcb || !laddr)
+        CNE_ERR_RET("Invalid parameters\n");
+
+    if (!cnet_lock())
+        return -1;
+
+    vec_foreach_ptr (grp, cnet->reuseport) {
+        if (reuseport_match(grp, pcb->ip_proto, laddr)) {
+            found = grp;
+            break;
+        }
+    }
+
+    /* Every PCB bound to the address and port of a group must have SO_REUSEPORT */
+    if (found && !reuse) {
+        cnet_unlock();
+        return -1;
+    }
+
+    if (pcb->reuseport) {
+        reuseport_put(cnet, pcb->reuseport);
+        pcb->reuseport = NULL;
+    }
+
+    if (!found && reuse) {
+        found = calloc(1, sizeof(struct pcb_reuseport));
+        if (!found) {
+            cnet_unlock();
+            CNE_ERR_RET("Unable to allocate reuseport group\n");
+        }
+        in_caddr_copy(&found->laddr, laddr);
+        found->ip_proto = pcb->ip_proto;
+        vec_add(cnet->reuseport, found);
+    }
+
+    if (found) {
+        found->nb_pcbs++;
+        pcb->reuseport = found;
+    }
+
+    cnet_unlock();
+
+    return 0;
+}
+
+void
+cnet_pcb_reuseport_leave(struct pcb_entry *pcb)
+{
+    struct cnet *cnet = this_cnet;
+
+    if (!pcb || !pcb->reuseport || !cnet || !cnet_lock())
+        return;
+
+    reuseport_put(cnet, pcb->reuseport);
+    pcb->reuseport = NULL;
+
+    cnet_unlock();
+}
+
+struct pcb_entry *
+cnet_pcb_reuseport_select(struct pcb_entry *pcb, pktmbuf_t *m, struct pcb_key *key)
+{
+    struct pcb_entry *p, *best = pcb;
+    uint32_t n = 0, hash, weight, best_weight = 0;
+
+    if (m->ol_flags & CNE_MBUF_F_RX_RSS_HASH)
+        hash = pktmbuf_hash(m);
+    else {
+        struct pcb_hkey hk;
+
+        cnet_pcb_hkey_init(&hk, key, CIN_FAMILY(&key->laddr) == AF_INET6);
+        hash = DEFAULT_HASH_FUNC(&hk, sizeof(hk), 0);
+    }
+
+    /*
+     * Rendezvous hashing, the member with the highest weight for the flow wins. The weight
+     * only depends on the flow and the member, so a member leaving the group only moves the
+     * flows it had. The CRC is linear and would favour some members, jhash mixes the bits.
+     * Only the wildcard list of the stack is walked, it holds the listeners.
+     */
+    vec_foreach_ptr (p, pcb->hd->wild) {
+        if (p->reuseport != pcb->reuseport || p->closed)
+            continue;
+
+        weight = cne_jhash_2words((uint32_t)(uintptr_t)p, (uint32_t)((uint64_t)(uintptr_t)p >> 32),
+                                  hash);
+        if (n == 0 || weight > best_weight) {
+            best        = p;
+            best_weight = weight;
+        }
+        if (++n == CNET_REUSEPORT_MAX)
+            break;
+    }
+
+    return best;
 }
 
 static void
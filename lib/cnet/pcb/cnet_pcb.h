@@ -13,6 +13,9 @@
 #include <cne_inet.h>        // for in_caddr
 #include <stdint.h>          // for uint16_t, uint8_t, int32_t
 #include <string.h>          // for NULL, memset
+#include <stdbool.h>         // for bool
+#include <pktmbuf.h>         // for pktmbuf_t
+#include <net/cne_ip.h>      // for __cne_raw_cksum_reduce
 
 #include "cne_common.h"        // for __cne_aligned, __cne_cache_aligned
 #include "cne_log.h"           // for CNE_LOG, CNE_LOG_DEBUG
@@ -33,10 +36,37 @@ struct pcb_key {
     struct in_caddr laddr; /**< local IP address */
 } __cne_aligned(sizeof(void *));
 
+/**
+ * Compact exact match key used to index fully specified PCB entries in the
+ * cne_hash table of a pcb_hd. IPv4 addresses use the first 4 bytes of the
+ * address arrays and the remaining bytes are zero.
+ */
+struct pcb_hkey {
+    uint8_t faddr[16]; /**< Foreign IPv4 or IPv6 address */
+    uint8_t laddr[16]; /**< Local IPv4 or IPv6 address */
+    uint16_t fport;    /**< Foreign port in network order */
+    uint16_t lport;    /**< Local port in network order */
+    uint8_t ipv6;      /**< Non-zero if the addresses are IPv6 */
+    uint8_t pad[3];    /**< Pad to a multiple of 4 bytes, always zero */
+};
+
 struct netif;
 struct chnl;
 struct tcb_entry;
 struct ip6_flowentry;
+struct pcb_hd;
+struct cne_hash;
+
+/**
+ * A SO_REUSEPORT group, the PCBs bound to the same local address and port on any of the
+ * stack instances. The members of a stack are found on the wildcard list of its PCB head,
+ * so each stack only selects between its own listeners and keeps its own accept queues.
+ */
+struct pcb_reuseport {
+    struct in_caddr laddr; /**< Local address and port of the group */
+    uint16_t ip_proto;     /**< IP protocol of the group */
+    uint16_t nb_pcbs;      /**< Number of PCBs in the group on all of the stacks */
+};
 
 struct pcb_entry {
     TAILQ_ENTRY(pcb_entry) next;        /**< Pointer to the next pcb_entry in a list */
@@ -50,20 +80,223 @@ struct pcb_entry {
     uint8_t tos;                        /**< TOS value */
     uint8_t closed;                     /**< Closed flag */
     uint8_t ip_proto;                   /**< IP protocol number */
+    uint8_t hashed;                     /**< PCB is in the exact match hash table */
+    struct pcb_hd *hd;                  /**< PCB list head holding this entry */
+    struct pcb_hkey hkey;               /**< Hash key of the PCB, valid when hashed is set */
+    struct pcb_reuseport *reuseport;    /**< SO_REUSEPORT group of the PCB or NULL */
+    uint32_t phdr_sum;                  /**< Pseudo header sum less the length, when hashed */
 } __cne_cache_aligned;
 
 #ifndef __CNET_PCB_HD_STRUCT_
 #define __CNET_PCB_HD_STRUCT_
 struct pcb_hd {
-    struct pcb_entry **vec; /**< PCB entries */
-    uint16_t local_port;    /**< Local port number i.e. IP local port ID */
+    struct pcb_entry **vec;  /**< PCB entries */
+    struct pcb_entry **wild; /**< PCB entries not in the hash table i.e. listeners */
+    struct cne_hash *hash;   /**< Exact match 4-tuple hash table of PCB entries */
+    uint16_t local_port;     /**< Local port number i.e. IP local port ID */
 };
 #endif
 
+/**
+ * Create the exact match hash table for a PCB list head.
+ *
+ * PCB entries with a fully specified 4-tuple are stored in the hash table,
+ * all other entries are kept on the smaller wildcard list.
+ *
+ * @param hd
+ *   A pointer to the PCB list head.
+ * @param name
+ *   The name of the hash table.
+ * @param entries
+ *   The number of entries in the hash table.
+ * @return
+ *   0 on success or -1 on error.
+ */
+CNDP_API int cnet_pcb_hd_init(struct pcb_hd *hd, const char *name, uint32_t entries);
+
+/**
+ * Release the hash table and PCB lists of a PCB list head.
+ *
+ * @param hd
+ *   A pointer to the PCB list head.
+ */
+CNDP_API void cnet_pcb_hd_free(struct pcb_hd *hd);
+
+/**
+ * Add a PCB entry to the PCB list head and place it in the hash table or on
+ * the wildcard list.
+ *
+ * @param hd
+ *   A pointer to the PCB list head.
+ * @param pcb
+ *   The PCB entry to add.
+ */
+CNDP_API void cnet_pcb_link(struct pcb_hd *hd, struct pcb_entry *pcb);
+
+/**
+ * Remove a PCB entry from the hash table or wildcard list of its PCB list head.
+ *
+ * @param pcb
+ *   The PCB entry to remove.
+ */
+CNDP_API void cnet_pcb_unlink(struct pcb_entry *pcb);
+
+/**
+ * Update the hash table or wildcard list after the key of a PCB entry changed.
+ *
+ * Must be called each time the local or foreign address of a PCB is modified.
+ *
+ * @param pcb
+ *   The PCB entry with the new key values.
+ */
+CNDP_API void cnet_pcb_rehash(struct pcb_entry *pcb);
+
+/**
+ * Fill in a hash key from a PCB key.
+ *
+ * @param hk
+ *   The hash key to fill in.
+ * @param key
+ *   The PCB key containing the local and foreign address.
+ * @param ipv6
+ *   Non-zero if the addresses are IPv6 addresses.
+ */
+static inline void
+cnet_pcb_hkey_init(struct pcb_hkey *hk, struct pcb_key *key, int ipv6)
+{
+    memset(hk, 0, sizeof(struct pcb_hkey));
+
+    if (ipv6) {
+        memcpy(hk->faddr, &key->faddr.cin6_addr, sizeof(struct in6_addr));
+        memcpy(hk->laddr, &key->laddr.cin6_addr, sizeof(struct in6_addr));
+    } else {
+        memcpy(hk->faddr, &key->faddr.cin_addr, sizeof(struct in_addr));
+        memcpy(hk->laddr, &key->laddr.cin_addr, sizeof(struct in_addr));
+    }
+    hk->fport = CIN_PORT(&key->faddr);
+    hk->lport = CIN_PORT(&key->laddr);
+    hk->ipv6  = (ipv6) ? 1 : 0;
+}
+
+/**
+ * Test if a PCB found with cnet_pcb_lookup_bulk() still matches the given key.
+ *
+ * Processing one packet of a burst can close or reuse the PCB found for a later
+ * packet, the caller must revalidate the PCB before using it.
+ *
+ * @param pcb
+ *   The PCB entry to test, can be NULL.
+ * @param key
+ *   The PCB key used for the lookup.
+ * @return
+ *   true if the PCB is hashed with the same 4-tuple or false otherwise.
+ */
+static inline bool
+cnet_pcb_match(struct pcb_entry *pcb, struct pcb_key *key)
+{
+    struct pcb_hkey hk;
+
+    if (!pcb || !pcb->hashed)
+        return false;
+
+    cnet_pcb_hkey_init(&hk, key, CIN_FAMILY(&key->laddr) == AF_INET6);
+
+    return memcmp(&hk, &pcb->hkey, sizeof(struct pcb_hkey)) == 0;
+}
+
+/**
+ * Add a PCB to the SO_REUSEPORT group of a local address and port.
+ *
+ * The groups are shared by all of the stack instances. A PCB without SO_REUSEPORT can not
+ * bind to the address and port of a group, in that case the PCB is not added and -1 is
+ * returned. A PCB already in a group leaves it first.
+ *
+ * @param pcb
+ *   The PCB being bound.
+ * @param laddr
+ *   The local address and port the PCB is bound to, the port must be set.
+ * @param reuse
+ *   true if the channel of the PCB has the SO_REUSEPORT option set.
+ * @return
+ *   0 on success or -1 if the address and port are in use.
+ */
+CNDP_API int cnet_pcb_reuseport_join(struct pcb_entry *pcb, struct in_caddr *laddr, bool reuse);
+
+/**
+ * Remove a PCB from its SO_REUSEPORT group, the group is freed with its last PCB.
+ *
+ * @param pcb
+ *   The PCB to remove, nothing is done if the PCB is not in a group.
+ */
+CNDP_API void cnet_pcb_reuseport_leave(struct pcb_entry *pcb);
+
+/**
+ * Select the PCB of the SO_REUSEPORT group for a new flow.
+ *
+ * The selection uses the RSS hash of the packet when the driver provides one, else a hash
+ * of the 4-tuple, so all of the packets of a flow select the same PCB. Only the members
+ * on the stack of the given PCB are considered, and a member leaving the group only moves
+ * the flows which selected it.
+ *
+ * @param pcb
+ *   The PCB found by the lookup, it must be in a group.
+ * @param m
+ *   The received packet.
+ * @param key
+ *   The 4-tuple of the packet.
+ * @return
+ *   The selected PCB of the group.
+ */
+CNDP_API struct pcb_entry *cnet_pcb_reuseport_select(struct pcb_entry *pcb, pktmbuf_t *m,
+                                                     struct pcb_key *key);
+
+/**
+ * Spread the new flows of a SO_REUSEPORT group over the listeners of the stack.
+ *
+ * @param pcb
+ *   The PCB found by the lookup or NULL.
+ * @param m
+ *   The received packet.
+ * @param key
+ *   The 4-tuple of the packet.
+ * @return
+ *   The PCB to deliver the packet to.
+ */
+static inline struct pcb_entry *
+cnet_pcb_reuseport(struct pcb_entry *pcb, pktmbuf_t *m, struct pcb_key *key)
+{
+    /* Connected PCBs are in the hash table and own their flow */
+    if (pcb && pcb->reuseport && !pcb->hashed)
+        return cnet_pcb_reuseport_select(pcb, m, key);
+
+    return pcb;
+}
+
+/**
+ * Pseudo header checksum of a packet sent on a PCB in the hash table.
+ *
+ * The sum of the addresses and the protocol is cached when the PCB is added to the hash
+ * table, only the L4 length is added for each packet.
+ *
+ * @param pcb
+ *   The PCB entry, must be in the hash table.
+ * @param l4_len
+ *   Length of the L4 header and data.
+ * @return
+ *   The non-complemented pseudo header checksum.
+ */
+static inline uint16_t
+cnet_pcb_phdr_cksum(const struct pcb_entry *pcb, uint16_t l4_len)
+{
+    return __cne_raw_cksum_reduce(pcb->phdr_sum + htobe16(l4_len));
+}
+
 static inline void
 cnet_pcb_free(struct pcb_entry *pcb)
 {
     if (pcb) {
+        cnet_pcb_reuseport_leave(pcb);
+        cnet_pcb_unlink(pcb);
         memset(pcb, 0, sizeof(struct pcb_entry));
         pcb->closed   = 1;
         pcb->ip_proto = -1;
@@ -92,7 +325,7 @@ cnet_pcb_alloc(struct pcb_hd *hd, uint16_t proto)
         pcb->ip6_fl_entry->flowlabel         = 0;
     }
 
-    vec_add(hd->vec, pcb);
+    cnet_pcb_link(hd, pcb);
 
     return pcb;
 }
@@ -147,6 +380,27 @@ cnet_pcb_delete(struct pcb_hd *hd, struct pcb_entry *pcb)
  */
 CNDP_API struct pcb_entry *cnet_pcb_lookup(struct pcb_hd *hd, struct pcb_key *key, int32_t flags);
 
+/**
+ * Lookup a burst of fully specified keys in the exact match hash table.
+ *
+ * Only the exact 4-tuple hash table is searched, keys which are not found or
+ * are not fully specified return NULL and the caller must fall back to
+ * cnet_pcb_lookup() to locate a wildcard match.
+ *
+ * @param hd
+ *   A pointer to the PCB list head.
+ * @param keys
+ *   Array of pointers to the keys to lookup.
+ * @param nb_keys
+ *   Number of keys in the array.
+ * @param pcbs
+ *   Array of nb_keys entries to return the matching PCB or NULL.
+ * @return
+ *   The number of keys found in the hash table.
+ */
+CNDP_API int cnet_pcb_lookup_bulk(struct pcb_hd *hd, struct pcb_key **keys, uint32_t nb_keys,
+                                  struct pcb_entry **pcbs);
+
 /**
  * @brief Dump out the PCB information.
  *
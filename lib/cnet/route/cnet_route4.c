@@ -85,7 +85,7 @@ cnet_route4_delete(struct in_addr *ipaddr)
 
         if (fib_info_free(fi, (uint32_t)nexthop) != rt)
             CNE_WARN("Freed entry does not match\n");
-        cnet_route4_free(rt);
+        cnet_rcu_defer_free(this_cnet->rt4_obj, rt);
     }
 
     return 0;
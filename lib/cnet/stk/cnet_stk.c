@@ -82,12 +82,44 @@ cnet_stk_initialize(struct cnet *cnet)
     if (cnet_do_instance_calls(stk, CNET_INIT))
         CNE_ERR_RET("cnet_do_stk_calls() failed for %s\n", stk->name);
 
+    /* The stack thread reads the route and neighbor tables without a lock */
+    if (cnet->rcu) {
+        if (cne_rcu_qsbr_thread_register(cnet->rcu, cne_id())) {
+            /* Let the other stk instances run, they do not depend on this one */
+            atomic_fetch_add(&this_cnet->stk_order, 1);
+            CNE_ERR_RET("Failed to register %s with RCU QSBR\n", stk->name);
+        }
+        cne_rcu_qsbr_thread_online(cnet->rcu, cne_id());
+    }
+
     /* Bump the order value to allow other stk instances to run */
     atomic_fetch_add(&this_cnet->stk_order, 1);
 
     return 0;
 }
 
+int
+cnet_stk_offline(void)
+{
+    if (!this_stk)
+        CNE_ERR_RET("Stk pointer is NULL\n");
+
+    /* A writer waiting on the grace period would otherwise wait for this thread forever,
+     * the lock keeps cnet_stop() from freeing the QSBR variable under us.
+     */
+    if (cnet_lock()) {
+        struct cnet *cnet = this_cnet;
+
+        if (cnet && cnet->rcu) {
+            cne_rcu_qsbr_thread_offline(cnet->rcu, cne_id());
+            cne_rcu_qsbr_thread_unregister(cnet->rcu, cne_id());
+        }
+        cnet_unlock();
+    }
+
+    return 0;
+}
+
 int
 cnet_stk_stop(void)
 {
@@ -64,6 +64,7 @@ typedef struct stk_s {
     struct udp_entry *udp;              /**< UDP information */
     struct chnl_optsw **chnlopt;        /**< Channel Option pointers */
     struct cne_timer tcp_timer;         /**< TCP Timer structure */
+    struct cne_timer tcp_pace_timer;    /**< TCP pacer timer, armed at the next paced send */
     struct tcp_stats *tcp_stats;        /**< TCP statistics */
 } stk_t __cne_cache_aligned;
 
@@ -75,6 +76,9 @@ enum {
     TCP_TIMEOUT_ENABLED    = 0x00000001, /**< Enable TCP Timeouts */
     RFC1323_TSTAMP_ENABLED = 0x00004000, /**< Enable RFC1323 Timestamp */
     RFC1323_SCALE_ENABLED  = 0x00008000, /**< Enable RFC1323 window scaling */
+    RFC2018_SACK_ENABLED   = 0x00010000, /**< Enable RFC2018 selective acknowledgments */
+    TCP_GSO_ENABLED        = 0x00020000, /**< Enable TCP generic segmentation offload */
+    TCP_GRO_ENABLED        = 0x00040000, /**< Enable TCP generic receive offload */
 };
 
 static inline uint64_t
@@ -155,6 +159,17 @@ stk_unlock(void)
  */
 CNDP_API int cnet_stk_initialize(struct cnet *cnet);
 
+/**
+ * @brief Take the stack thread out of the RCU QSBR reader set.
+ *
+ * Must be called by the stack thread before it exits, on error paths too, as
+ * cnet_stk_initialize() registers the thread as a reader of the route and neighbor tables.
+ *
+ * @return
+ *   -1 on error or 0 on success
+ */
+CNDP_API int cnet_stk_offline(void);
+
 /**
  * @brief Stop the stack instance and free resources.
  *
@@ -46,6 +46,9 @@
 #include <cnet_ip_common.h>        // for ip_info
 #include <cnet_meta.h>             // for cnet_metadata
 #include <cnet_tcp_chnl.h>         // for cnet_drop_acked_data, cnet_tcp_chnl_scal...
+#include <cnet_tcp_sack.h>         // for cnet_tcp_sack_update, cnet_tcp_sack_sent
+#include <cnet_tcp_cc.h>           // for cnet_tcp_cc_ack, cnet_tcp_cc_loss, cnet_tcp_cc_rto
+#include <cnet_tcp_gso.h>          // for TCP_GSO_MAX_SEGS, TCP_GSO_MAX_SIZE
 #include <endian.h>                // for be16toh, htobe32, htobe16, be32toh
 #include <errno.h>                 // for errno, ECONNREFUSED, ECONNRESET, ETIMEDOUT
 #include <netinet/in.h>            // for ntohs, IPPROTO_TCP, IN_CLASSD, ntohl
@@ -83,7 +86,8 @@ static int tcp_destroy(void *_stk);
 static int tcb_cleanup(struct tcb_entry *tcb);
 static void tcp_update_acked_data(struct seg_entry *seg, struct tcb_entry *tcb);
 static int32_t tcp_send_options(struct tcb_entry *tcb, uint8_t *sp, uint8_t flags_n);
-static int tcp_init(int32_t n_tcb_entries, bool wscale, bool t_stamp);
+static int tcp_init(int32_t n_tcb_entries, bool wscale, bool t_stamp, bool sack, bool gso,
+                    bool gro);
 
 const char *tcb_in_states[] = TCP_INPUT_STATES;
 
@@ -299,6 +303,26 @@ tcp_set_MSS(struct tcb_entry *tcb, uint16_t mss_offer)
     tcb->max_mss = CNE_MIN(mss_offer, TCP_MAX_MSS);
 }
 
+/*
+ * SACK is used when both sides sent the SACK permitted option in the SYN, RFC2018.
+ */
+static inline bool
+tcp_sack_enabled(struct tcb_entry *tcb)
+{
+    return tcb->sack && is_set(tcb->tflags, TCBF_REQ_SACK) && is_set(tcb->tflags, TCBF_SACK_PERMIT);
+}
+
+/*
+ * Arm the tail loss probe timer when not in loss recovery, the probe timeout is capped
+ * by the retransmit timeout converted from slow timer ticks to cycles.
+ */
+static inline void
+tcp_tlp_arm(struct tcb_entry *tcb, uint64_t now)
+{
+    if (is_clr(tcb->tflags, TCBF_IN_RECOVERY))
+        cnet_tcp_sack_tlp_arm(tcb->sack, (cne_get_timer_hz() * tcb->rxtcur) / TCP_SLOWHZ, now);
+}
+
 /*
  * Allocate a new struct tcb_entry structure if the pcb->tcb does not already contain
  * a struct tcb_entry pointer. If the pcb->tcb contains a valid pointer then return the
@@ -325,12 +349,19 @@ cnet_tcb_new(struct pcb_entry *pcb)
     if (!tcb->reassemble)
         CNE_ERR_GOTO(err, "tcb->backlog allocate failed\n");
 
+    if (stk->gflags & RFC2018_SACK_ENABLED) {
+        tcb->sack = cnet_tcp_sack_create();
+        if (!tcb->sack)
+            CNE_ERR_GOTO(err, "tcb->sack allocate failed\n");
+    }
+
     TAILQ_INIT(&tcb->backlog_q.head);
     TAILQ_INIT(&tcb->half_open_q.head);
 
     /* Enable RFC1323 (TCP Extensions for High Performance), if requested. */
     tcb->tflags = (stk->gflags & RFC1323_SCALE_ENABLED) != 0 ? TCBF_REQ_SCALE : 0;
     tcb->tflags |= (stk->gflags & RFC1323_TSTAMP_ENABLED) != 0 ? TCBF_REQ_TSTAMP : 0;
+    tcb->tflags |= (stk->gflags & RFC2018_SACK_ENABLED) != 0 ? TCBF_REQ_SACK : 0;
 
     tcb->srtt   = TCP_SRTTBASE_TV;
     tcb->rttvar = stk->tcp->default_RTT * (TCP_SLOWHZ << TCP_RTTVAR_SHIFT);
@@ -346,6 +377,9 @@ cnet_tcb_new(struct pcb_entry *pcb)
     /* Normally set to TCP_MAXWIN as per RFC2001 */
     tcb->snd_ssthresh = tcb->snd_cwnd << 1;
 
+    /* Use the stack default congestion control, TCP_CONGESTION can change it */
+    cnet_tcp_cc_set(tcb, NULL);
+
     /* Link the PCB and TCB together */
     tcb->pcb   = pcb;
     pcb->tcb   = tcb;
@@ -360,6 +394,10 @@ cnet_tcb_new(struct pcb_entry *pcb)
     tcb->state = TCPS_CLOSED;
     return tcb;
 err:
+    if (tcb) {
+        vec_free(tcb->reassemble);
+        cnet_tcp_sack_destroy(tcb->sack);
+    }
     tcb_free(tcb);
     return NULL;
 }
@@ -432,6 +470,7 @@ tcp_send_segment(struct tcb_entry *tcb, struct seg_entry *seg)
 
             /* Use the interface attached to the route for the source address */
             inet6_addr_copy(&pcb->key.laddr.cin6_addr, &nif->ip6_addrs[k].ip);
+            cnet_pcb_rehash(pcb);
         }
 
     } else /* if AF_INET */
@@ -466,11 +505,14 @@ tcp_send_segment(struct tcb_entry *tcb, struct seg_entry *seg)
 
             /* Use the interface attached to the route for the source address */
             pcb->key.laddr.cin_addr.s_addr = htobe32(nif->ip4_addrs[k].ip.s_addr);
+            cnet_pcb_rehash(pcb);
         }
 
     /* Clear the send Ack Now bit, if an ACK is present. */
-    if (is_set(seg->flags, TCP_ACK))
+    if (is_set(seg->flags, TCP_ACK)) {
         tcb->tflags &= ~(TCBF_ACK_NOW | TCBF_DELAYED_ACK);
+        tcp_timer_stop(tcb, TCPT_DELACK);
+    }
 
     /* Always clear the force tx and need output flags. */
     tcb->tflags &= ~TCBF_FORCE_TX;
@@ -525,14 +567,15 @@ tcp_set_persist(struct tcb_entry *tcb)
     int32_t t = (tcb->srtt + (tcb->rttvar << 2));
 
     /* Divide by 500 ms to get the correct persist timer value. */
-    tcb->timers[TCPT_PERSIST] = tcp_range_set(((t * tcp_backoff[tcb->rxtshift]) / 500) >> 3,
-                                              TCP_PERSMIN_TV, TCP_PERSMAX_TV);
+    tcp_timer_set(tcb, TCPT_PERSIST,
+                  tcp_range_set(((t * tcp_backoff[tcb->rxtshift]) / 500) >> 3, TCP_PERSMIN_TV,
+                                TCP_PERSMAX_TV));
 
     if (tcb->rxtshift < TCP_MAXRXTSHIFT)
         tcb->rxtshift++;
 }
 
-/* skip to the offset in the list and copy the data to the buffer. */
+/* skip to the offset in the list and copy the data to the buffer, called on the stack thread. */
 static int
 tcp_mbuf_copydata(struct chnl_buf *cb, uint32_t off, uint32_t len, char *buf)
 {
@@ -540,9 +583,6 @@ tcp_mbuf_copydata(struct chnl_buf *cb, uint32_t off, uint32_t len, char *buf)
     uint32_t total = 0, cnt;
     int i          = 0;
 
-    if (!stk_lock())
-        CNE_ERR_RET("Failed to acquire mutex\n");
-
     m = vec_at_index(cb->cb_vec, i++);
 
     /* skip to the offset location */
@@ -568,10 +608,104 @@ tcp_mbuf_copydata(struct chnl_buf *cb, uint32_t off, uint32_t len, char *buf)
         m   = vec_at_index(cb->cb_vec, i++);
     }
 
-    stk_unlock();
     return total;
 }
 
+/*
+ * Allocate the mbuf of a segment, a GSO super-segment of nb_segs frames is a chain with
+ * one mbuf per frame, the frames after the first keep their headroom for the headers.
+ */
+static int
+tcp_segment_alloc(struct seg_entry *seg, uint32_t segsz, uint32_t nb_segs)
+{
+    pktmbuf_t *mbufs[TCP_GSO_MAX_SEGS];
+    int n;
+
+    n = pktdev_buf_alloc(seg->lport, mbufs, nb_segs);
+    if (n < (int)nb_segs) {
+        if (n > 0)
+            pktmbuf_free_bulk(mbufs, n);
+        CNE_WARN("pktmbuf allocation from lport %d failed id %d\n", seg->lport, cne_id());
+        return -1;
+    }
+    seg->mbuf = mbufs[0];
+
+    for (uint32_t i = 1; i < nb_segs; i++) {
+        if (pktmbuf_chain(seg->mbuf, mbufs[i]) < 0) {
+            /* Release the mbufs not chained yet, the head frees the others */
+            pktmbuf_free_bulk(&mbufs[i], nb_segs - i);
+            pktmbuf_free(seg->mbuf);
+            seg->mbuf = NULL;
+            CNE_WARN("pktmbuf chain of %u segments failed\n", nb_segs);
+            return -1;
+        }
+    }
+
+    if (nb_segs > 1) {
+        seg->mbuf->ol_flags |= CNE_MBUF_F_TX_TCP_SEG;
+        seg->mbuf->tso_segsz = segsz;
+        INC_TCP_STAT(gso_sends);
+    }
+
+    return 0;
+}
+
+/* The pacing rate of the congestion control module capped by SO_MAX_PACING_RATE */
+static inline uint64_t
+tcp_pace_rate(struct tcb_entry *tcb)
+{
+    uint64_t rate = tcb->pacing_rate;
+
+    if (tcb->pace_max && (rate == 0 || rate > tcb->pace_max))
+        rate = tcb->pace_max;
+
+    return rate;
+}
+
+/*
+ * Refill the token bucket of the connection and return the bytes it can send now. The
+ * bucket holds TCP_PACE_BURST_US of data at the pacing rate and at least two segments,
+ * which bounds the burst a connection sends into the switch buffers.
+ */
+uint32_t
+tcp_pace_budget(struct tcb_entry *tcb, uint64_t now)
+{
+    uint64_t rate  = tcp_pace_rate(tcb);
+    uint64_t hz    = cne_get_timer_hz();
+    uint64_t burst = CNE_MAX((rate * TCP_PACE_BURST_US) / 1000000, (uint64_t)(2 * tcb->max_mss));
+    uint64_t tokens;
+
+    if (tcb->pace_ts == 0 || (now - tcb->pace_ts) >= hz)
+        tokens = burst;
+    else
+        tokens = tcb->pace_tokens + (uint64_t)((double)(now - tcb->pace_ts) * rate / hz);
+
+    tcb->pace_tokens = (uint32_t)CNE_MIN(tokens, burst);
+    tcb->pace_ts     = now;
+
+    return tcb->pace_tokens;
+}
+
+/*
+ * Not enough tokens to send len bytes, record when the send can resume. The stack has
+ * one pacer timer armed at the earliest deadline of all of the connections.
+ */
+void
+tcp_pace_defer(struct tcb_entry *tcb, uint32_t len, uint64_t now)
+{
+    stk_t *stk    = this_stk;
+    uint64_t rate = tcp_pace_rate(tcb);
+    uint64_t wait;
+
+    wait = (uint64_t)((double)(len - tcb->pace_tokens) * cne_get_timer_hz() / rate) + 1;
+
+    tcb->pace_next = now + wait;
+    INC_TCP_STAT(paced);
+
+    if (!cne_timer_pending(&stk->tcp_pace_timer) || stk->tcp_pace_timer.expire > tcb->pace_next)
+        cne_timer_reset(&stk->tcp_pace_timer, wait, SINGLE, cne_id(), tcp_pace_timo, stk);
+}
+
 /*
  * Determine if a segment of data or just a TCP header needs to be sent via
  * the tcb_send_segment routine.
@@ -609,23 +743,18 @@ tcp_output(struct tcb_entry *tcb)
          * cwnd is reduced to the value of the restart window (RW) before
          * transmission begins.
          *
-         * For the purposes of this standard, we define RW = IW.
-         *
-         * We note that the non-standard experimental extension to TCP defined
-         * in [AFP98] defines RW = min(IW, cwnd), with the definition of IW
-         * adjusted per equation (1) above.
+         * The congestion control module decides the restart window.
          */
-        if (tcb->idle >= tcb->rxtcur)
-            tcb->snd_cwnd =
-                CNE_MIN((4 * tcb->max_mss), CNE_MAX((2 * tcb->max_mss), TCP_INITIAL_CWND));
+        if (tcp_idle(tcb) >= (uint32_t)tcb->rxtcur)
+            cnet_tcp_cc_restart(tcb);
 #endif /* CNET_TCP_FAST_REXMIT */
     }
 
     do {
         struct seg_entry tx_seg;
         struct seg_entry *seg = &tx_seg;
-        uint32_t off;
-        int32_t len;
+        uint32_t off, segsz, budget, nb_segs;
+        int32_t len, avail;
         uint32_t win;
         seq_t prev_rcv_adv;
         int iphdr_len;
@@ -662,8 +791,8 @@ tcp_output(struct tcb_entry *tcb)
                     win = 1; /* Send at least one byte */
                 } else {
                     /* Turn off the persistent timer */
-                    tcb->timers[TCPT_PERSIST] = 0;
-                    tcb->rxtshift             = 0;
+                    tcp_timer_stop(tcb, TCPT_PERSIST);
+                    tcb->rxtshift = 0;
                 }
             }
 
@@ -702,11 +831,14 @@ tcp_output(struct tcb_entry *tcb)
 
                 if (win == 0) {
                     /* When win is zero, we are done doing retransmits. */
-                    tcb->timers[TCPT_REXMT] = 0;
-                    tcb->snd_nxt            = tcb->snd_una;
+                    tcp_timer_stop(tcb, TCPT_REXMT);
+                    tcb->snd_nxt = tcb->snd_una;
                 }
             }
 
+            /* The data ready to send, more than one segment can go in a GSO send */
+            avail = len;
+
             if (len > tcb->max_mss) {
                 CNE_DEBUG("len [cyan]%d[] > [cyan]%d[] max_mss, vec_len([orange]%d[])\n", len,
                           tcb->max_mss, vec_len(ch->ch_snd.cb_vec));
@@ -811,10 +943,10 @@ tcp_output(struct tcb_entry *tcb)
              *  persisting          to move a small or zero window
              *  (re)transmitting    and thereby not persisting
              *
-             * tcb->timers[TCPT_PERSIST] is greater then zero.
+             * tcb->timers[TCPT_PERSIST] is running.
              * TCBF_FORCE_TX is set when we are called to send a persist packet.
-             * tcb->timers[TCPT_REXMT] is greater then zero.
-             * The output side is idle when both timers are zero.
+             * tcb->timers[TCPT_REXMT] is running.
+             * The output side is idle when both timers are stopped.
              *
              * If send window is too small, there is data to transmit, and no
              * retransmit or persist is pending, then go to persist state.
@@ -822,8 +954,8 @@ tcp_output(struct tcb_entry *tcb)
              * if window is nonzero, transmit what we can,
              * otherwise force out a byte.
              */
-            if (ch->ch_snd.cb_cc && (tcb->timers[TCPT_REXMT] == 0) &&
-                (tcb->timers[TCPT_PERSIST] == 0)) {
+            if (ch->ch_snd.cb_cc && !tcp_timer_active(tcb, TCPT_REXMT) &&
+                !tcp_timer_active(tcb, TCPT_PERSIST)) {
                 tcb->rxtshift = 0;
                 CNE_DEBUG("Set [orange]Persist[]\n");
                 tcp_set_persist(tcb);
@@ -842,12 +974,44 @@ tcp_output(struct tcb_entry *tcb)
             /* Turn off the FIN if it is set */
             seg->flags &= ~TCP_FIN;
         }
+        segsz   = tcb->max_mss - seg->optlen;
+        budget  = UINT32_MAX;
+        nb_segs = 1;
+
+        /* New data is paced, retransmissions and segments without data are sent at once */
+        if (len && tcb->snd_nxt == tcb->snd_max && tcp_pace_rate(tcb)) {
+            uint64_t now = cne_rdtsc();
+
+            budget = tcp_pace_budget(tcb, now);
+            if (budget < (uint32_t)len) {
+                tcp_pace_defer(tcb, len, now);
+
+                /* Still send an ACK that is owed, without the data */
+                if (is_clr(tcb->tflags, TCBF_ACK_NOW))
+                    goto leave;
+                len      = 0;
+                sendalot = false;
+            }
+        }
 
-        if (pktdev_buf_alloc(seg->lport, &seg->mbuf, 1) <= 0) {
-            CNE_WARN("pktmbuf allocation from lport %d failed id %d\n", seg->lport, cne_id());
-            return -1;
+        /*
+         * Send full sized segments as one GSO super-segment, the ip4_gso or ip6_gso node
+         * splits it into frames after the headers are built once.
+         */
+        if (is_set(this_stk->gflags, TCP_GSO_ENABLED) && len == (int32_t)segsz &&
+            avail > len && is_clr(tcb->tflags, TCBF_FORCE_TX) &&
+            !tcp_timer_active(tcb, TCPT_PERSIST)) {
+            uint32_t max = CNE_MIN((uint32_t)TCP_GSO_MAX_SEGS, TCP_GSO_MAX_SIZE / segsz);
+
+            nb_segs = CNE_MIN(CNE_MIN((uint32_t)avail, budget) / segsz, max);
+            if (nb_segs < 1)
+                nb_segs = 1;
+            len = nb_segs * segsz;
         }
 
+        if (tcp_segment_alloc(seg, segsz, nb_segs) < 0)
+            return -1;
+
         seg->mbuf->userptr = tcb->pcb;
 
         if (is_pcb_dom_inet6(tcb->pcb))
@@ -863,11 +1027,23 @@ tcp_output(struct tcb_entry *tcb)
                sizeof(struct cne_tcp_hdr) + seg->optlen + iphdr_len + sizeof(struct ether_addr));
 
         if (len) {
-            len = tcp_mbuf_copydata(&ch->ch_snd, off, len, pktmbuf_mtod(seg->mbuf, char *));
-
-            pktmbuf_append(seg->mbuf, len); /* Update length */
+            pktmbuf_t *m  = seg->mbuf;
+            uint32_t want = len;
+
+            /* Each mbuf of a GSO super-segment holds the data of one frame */
+            len = 0;
+            for (uint32_t i = 0; i < nb_segs; i++, m = m->next) {
+                int n = tcp_mbuf_copydata(&ch->ch_snd, off + len,
+                                          CNE_MIN(want - (uint32_t)len, segsz),
+                                          pktmbuf_mtod(m, char *));
+
+                pktmbuf_data_len(m) = (uint16_t)n; /* Update length */
+                len += n;
+            }
             CNE_DEBUG("Add [orange]%4d[] bytes to the packet buffer\n", len);
         }
+        if (budget != UINT32_MAX)
+            tcb->pace_tokens -= CNE_MIN((uint32_t)len, tcb->pace_tokens);
 
         /* Make sure if sending a FIN does not advertise a new sequence number */
         if (is_set(seg->flags, TCP_FIN) && is_set(tcb->tflags, TCBF_SENT_FIN) &&
@@ -880,13 +1056,28 @@ tcp_output(struct tcb_entry *tcb)
          * Calculate the correct sequence number based on the presents of the
          * SIN or FIN flag bits. The ACK is the next receive sequence value.
          */
-        if (len || is_set(seg->flags, SYN_FIN) || tcb->timers[TCPT_PERSIST])
+        if (len || is_set(seg->flags, SYN_FIN) || tcp_timer_active(tcb, TCPT_PERSIST))
             seg->seq = tcb->snd_nxt;
         else
             seg->seq = tcb->snd_max;
 
         seg->ack = tcb->rcv_nxt;
 
+        /* Track the new or retransmitted data in the SACK scoreboard */
+        if (len && tcp_sack_enabled(tcb)) {
+            uint64_t now = cne_rdtsc();
+
+            for (uint32_t i = 0; i < nb_segs; i++)
+                cnet_tcp_sack_sent(tcb->sack, seg->seq + i * segsz,
+                                   CNE_MIN((uint32_t)len - i * segsz, segsz), now);
+            if (tcb->sack->tlp_deadline == 0)
+                tcp_tlp_arm(tcb, now);
+        }
+
+        /* New data can start a round trip sample, retransmissions are ambiguous */
+        if (len && seg->seq == tcb->snd_max)
+            cnet_tcp_cc_sent(tcb, seg->seq + len, (off + len) >= ch->ch_snd.cb_cc, cne_rdtsc());
+
         if (tcb->rcv_scale == 0)
             tcb->rcv_scale = tcb->req_recv_scale;
 
@@ -911,7 +1102,7 @@ tcp_output(struct tcb_entry *tcb)
         seg->wnd = win >> tcb->rcv_scale;
         CNE_DEBUG("Window size [cyan]%u, scaled win %u, %u[]\n", win, seg->wnd, tcb->rcv_scale);
 
-        if (is_clr(tcb->tflags, TCBF_FORCE_TX) || (tcb->timers[TCPT_PERSIST] == 0)) {
+        if (is_clr(tcb->tflags, TCBF_FORCE_TX) || !tcp_timer_active(tcb, TCPT_PERSIST)) {
             uint32_t startseq = tcb->snd_nxt;
 
             /* Count the SYN and/or FIN bits */
@@ -934,11 +1125,11 @@ tcp_output(struct tcb_entry *tcb)
                 }
             }
 
-            if ((tcb->timers[TCPT_REXMT] == 0) && (tcb->snd_nxt != tcb->snd_una)) {
-                tcb->timers[TCPT_REXMT] = tcb->rxtcur;
-                if (tcb->timers[TCPT_PERSIST] != 0) {
-                    tcb->timers[TCPT_PERSIST] = 0;
-                    tcb->rxtshift             = 0;
+            if (!tcp_timer_active(tcb, TCPT_REXMT) && (tcb->snd_nxt != tcb->snd_una)) {
+                tcp_timer_set(tcb, TCPT_REXMT, tcb->rxtcur);
+                if (tcp_timer_active(tcb, TCPT_PERSIST)) {
+                    tcp_timer_stop(tcb, TCPT_PERSIST);
+                    tcb->rxtshift = 0;
                 }
             }
         } else if (seqGT(tcb->snd_nxt + len, tcb->snd_max))
@@ -999,6 +1190,165 @@ cnet_tcp_output(struct tcb_entry *tcb)
     }
 }
 
+/*
+ * Retransmit a range of the send buffer. The tcp_output() routine sends from snd_nxt
+ * and the congestion window limits it to the range, return true when data was sent.
+ */
+static bool
+tcp_sack_rexmit(struct tcb_entry *tcb, seq_t seq, uint32_t len)
+{
+    seq_t onxt    = tcb->snd_nxt;
+    uint32_t cwnd = tcb->snd_cwnd;
+    bool sent;
+
+    tcb->snd_nxt  = seq;
+    tcb->snd_cwnd = (seq - tcb->snd_una) + len;
+    cnet_tcp_output(tcb);
+
+    sent          = seqGT(tcb->snd_nxt, seq);
+    tcb->snd_cwnd = cwnd;
+    if (seqGT(onxt, tcb->snd_nxt))
+        tcb->snd_nxt = onxt;
+
+    if (sent)
+        INC_TCP_STAT(sack_rexmit);
+
+    return sent;
+}
+
+/*
+ * SACK based loss recovery, RFC6675 using the RACK loss marking of RFC8985.
+ *
+ * Entering recovery sets ssthresh to max(FlightSize / 2, 2 * SMSS) and cwnd to ssthresh,
+ * the segments marked lost are retransmitted first and new data is sent while the
+ * estimated pipe is below cwnd. Recovery ends when snd_una reaches the recovery point.
+ */
+static void
+tcp_sack_recover(struct tcb_entry *tcb, int ev)
+{
+    struct tcp_sack *sk = tcb->sack;
+    uint32_t pipe, len;
+    seq_t seq;
+
+    if (!tcb->pcb || !tcb->pcb->ch)
+        return;
+
+    if (ev & TCP_SACK_EV_LOSS)
+        INC_TCP_STAT(rack_lost);
+
+    if (ev & TCP_SACK_EV_RECOVERED) {
+        tcb->tflags &= ~TCBF_IN_RECOVERY;
+        tcb->snd_cwnd = tcb->snd_ssthresh;
+    }
+
+    /* A loss repaired by a tail loss probe gets the same response without recovery */
+    if ((ev & (TCP_SACK_EV_LOSS | TCP_SACK_EV_TLP_LOSS)) &&
+        is_clr(tcb->tflags, TCBF_IN_RECOVERY)) {
+        cnet_tcp_cc_loss(tcb);
+        tcb->snd_cwnd = tcb->snd_ssthresh;
+        tcb->rtt      = 0;
+
+        if (ev & TCP_SACK_EV_LOSS) {
+            sk->recovery_point = tcb->snd_max;
+            sk->tlp_deadline   = 0;
+            tcb->tflags |= TCBF_IN_RECOVERY;
+        }
+    }
+
+    if (is_clr(tcb->tflags, TCBF_IN_RECOVERY))
+        return;
+
+    while (cnet_tcp_sack_pipe(sk) < tcb->snd_cwnd && cnet_tcp_sack_next_lost(sk, &seq, &len))
+        if (!tcp_sack_rexmit(tcb, seq, len))
+            break;
+
+    /* Send new data when the pipe allows, tcp_output() limits the window from snd_una */
+    pipe = cnet_tcp_sack_pipe(sk);
+    if (pipe < tcb->snd_cwnd && tcb->pcb->ch->ch_snd.cb_cc > (tcb->snd_nxt - tcb->snd_una)) {
+        uint32_t cwnd = tcb->snd_cwnd;
+
+        tcb->snd_cwnd = (tcb->snd_nxt - tcb->snd_una) + (cwnd - pipe);
+        cnet_tcp_output(tcb);
+        tcb->snd_cwnd = cwnd;
+    }
+}
+
+/*
+ * The probe timeout expired, send a new segment when the windows allow it or else
+ * retransmit the last segment to get the tail of the flight acknowledged, RFC8985 7.3.
+ */
+static void
+tcp_tlp_send(struct tcb_entry *tcb)
+{
+    struct chnl *ch;
+    uint32_t off, len;
+    seq_t seq;
+
+    if (!tcb->pcb || (ch = tcb->pcb->ch) == NULL)
+        return;
+
+    INC_TCP_STAT(tlp_probes);
+
+    off = tcb->snd_nxt - tcb->snd_una;
+    if (ch->ch_snd.cb_cc > off && tcb->snd_wnd > off) {
+        uint32_t cwnd = tcb->snd_cwnd;
+        seq_t omax    = tcb->snd_max;
+
+        /* Send one segment even if it is small */
+        tcb->tflags |= TCBF_NAGLE_CREDIT;
+        tcb->snd_cwnd = off + tcb->max_mss;
+        cnet_tcp_output(tcb);
+        tcb->snd_cwnd = cwnd;
+
+        if (seqGT(tcb->snd_max, omax)) {
+            cnet_tcp_sack_tlp_sent(tcb->sack, tcb->snd_max, false);
+            return;
+        }
+    }
+
+    if (cnet_tcp_sack_last(tcb->sack, &seq, &len) && tcp_sack_rexmit(tcb, seq, len))
+        cnet_tcp_sack_tlp_sent(tcb->sack, tcb->snd_max, true);
+}
+
+/*
+ * Check the RACK reordering timer and the tail loss probe timer of a connection.
+ */
+static void
+tcp_sack_timo(struct tcb_entry *tcb, uint64_t now)
+{
+    int ev = cnet_tcp_sack_timo(tcb->sack, is_set(tcb->tflags, TCBF_IN_RECOVERY), now);
+
+    if (ev & TCP_SACK_EV_LOSS)
+        tcp_sack_recover(tcb, ev);
+    if (ev & TCP_SACK_EV_TLP)
+        tcp_tlp_send(tcb);
+}
+
+/*
+ * Update the SACK scoreboard from the ACK and the SACK blocks of a segment before the
+ * segment is processed, return the TCP_SACK_EV_XXX events.
+ */
+static int
+tcp_sack_input(struct seg_entry *seg, struct tcb_entry *tcb)
+{
+    uint64_t now = cne_rdtsc();
+    int ev;
+
+    if (seqLT(seg->ack, tcb->snd_una) || seqGT(seg->ack, tcb->snd_max))
+        return 0;
+
+    ev = cnet_tcp_sack_update(tcb->sack, seg->ack, seg->sacks, seg->nb_sacks,
+                              is_set(tcb->tflags, TCBF_IN_RECOVERY), now);
+    if (ev & TCP_SACK_EV_DSACK)
+        INC_TCP_STAT(dsack_rcvd);
+
+    /* Restart the probe timer when new data is acknowledged */
+    if (seqGT(seg->ack, tcb->snd_una) || tcb->sack->tlp_deadline == 0)
+        tcp_tlp_arm(tcb, now);
+
+    return ev;
+}
+
 /*
  * The routine sends a TCP response segment for a given input segment. The
  * values passed are <seg>, <seq>, <ack> and <flags>. Construct a TCP response
@@ -1230,6 +1580,23 @@ tcp_do_options(struct seg_entry *seg, uint8_t *opts)
                 seg->sflags |= SEG_SACK_PERMIT;
             break;
 
+        case TCP_OPT_SACK:
+            if ((opts[1] + opts) > opt_end)
+                return -1;
+
+            /* The option is 2 + 8 * n bytes long, ignore it when malformed */
+            if (opts[1] > 2 && ((opts[1] - 2) % TCP_SACK_BLOCK_LEN) == 0) {
+                int nb = CNE_MIN((opts[1] - 2) / TCP_SACK_BLOCK_LEN, TCP_SACK_MAX_BLOCKS);
+
+                for (int i = 0; i < nb; i++) {
+                    memcpy(&seg->sacks[i], &opts[2 + i * TCP_SACK_BLOCK_LEN], TCP_SACK_BLOCK_LEN);
+                    seg->sacks[i].start = ntohl(seg->sacks[i].start);
+                    seg->sacks[i].end   = ntohl(seg->sacks[i].end);
+                }
+                seg->nb_sacks = nb;
+            }
+            break;
+
         case TCP_OPT_TSTAMP:
             if ((opts[1] + opts) > opt_end)
                 CNE_ERR_RET("Option Length Invalid opts %u\n", *opts);
@@ -1363,7 +1730,7 @@ tcp_do_state_change(struct pcb_entry *pcb, int32_t new_state)
                   tcb_in_states[TCPS_SYN_RCVD]);
 
         /* Start up the TIMER for SYN_RCVD state */
-        tcb->timers[TCPT_KEEP] = TCP_KEEP_INIT_TV;
+        tcp_timer_set(tcb, TCPT_KEEP, TCP_KEEP_INIT_TV);
         break;
 
     case TCPS_ESTABLISHED:
@@ -1389,14 +1756,14 @@ tcp_do_state_change(struct pcb_entry *pcb, int32_t new_state)
                     cnet_tcp_abort(pcb);
                     CNE_ERR("Failed to enqueue PCB to backlog queue\n");
                 }
-                pcb->ch->ch_callback(CHNL_TCP_ESTABLISHED_TYPE, tcb->ppcb->ch->ch_cd);
+                chnl_notify(tcb->ppcb->ch, CHNL_TCP_ESTABLISHED_TYPE);
             }
         } else {
-            pcb->ch->ch_callback(CHNL_TCP_ESTABLISHED_TYPE, pcb->ch->ch_cd);
+            chnl_notify(pcb->ch, CHNL_TCP_ESTABLISHED_TYPE);
         }
 
-        tcb->idle              = 0;
-        tcb->timers[TCPT_KEEP] = tcb->tcp->keep_idle;
+        tcb->idle_ts = stk_get_timer_ticks();
+        tcp_timer_set(tcb, TCPT_KEEP, tcb->tcp->keep_idle);
 
         if ((tcb->tflags & (TCBF_RCVD_SCALE | TCBF_REQ_SCALE)) ==
             (TCBF_RCVD_SCALE | TCBF_REQ_SCALE)) {
@@ -1417,7 +1784,7 @@ tcp_do_state_change(struct pcb_entry *pcb, int32_t new_state)
          * the TIME_WAIT timeout.
          */
         tcb_kill_timers(tcb);
-        tcb->timers[TCPT_2MSL] = 2 * TCP_MSL_TV;
+        tcp_timer_set(tcb, TCPT_2MSL, 2 * TCP_MSL_TV);
         break;
 
     case TCPS_TIME_WAIT:
@@ -1431,7 +1798,7 @@ tcp_do_state_change(struct pcb_entry *pcb, int32_t new_state)
          * the TIME_WAIT timeout.
          */
         tcb_kill_timers(tcb);
-        tcb->timers[TCPT_2MSL] = 2 * TCP_MSL_TV;
+        tcp_timer_set(tcb, TCPT_2MSL, 2 * TCP_MSL_TV);
         break;
 
     default:
@@ -1579,7 +1946,8 @@ static inline void
 tcp_do_process_options(struct tcb_entry *tcb, struct seg_entry *seg, struct chnl *ch)
 {
     /* skip a few tests if none of the bits are set */
-    if (is_set(seg->sflags, (SEG_TS_PRESENT | SEG_WS_PRESENT | SEG_MSS_PRESENT))) {
+    if (is_set(seg->sflags,
+               (SEG_TS_PRESENT | SEG_WS_PRESENT | SEG_MSS_PRESENT | SEG_SACK_PERMIT))) {
         /* When the Timestamp is present and the SYN bit grab the TS value */
         if (is_set(seg->sflags, SEG_TS_PRESENT)) {
             tcb->tflags |= TCBF_RCVD_TSTAMP;
@@ -1595,7 +1963,9 @@ tcp_do_process_options(struct tcb_entry *tcb, struct seg_entry *seg, struct chnl
         if (is_set(seg->sflags, SEG_MSS_PRESENT))
             tcp_set_MSS(tcb, seg->mss);
 
-        /* Need to look into supporting SACK_PERMIT support */
+        /* SACK is only negotiated in the SYN segments, RFC2018 */
+        if (is_set(seg->sflags, SEG_SACK_PERMIT) && is_set(seg->flags, TCP_SYN))
+            tcb->tflags |= TCBF_SACK_PERMIT;
     }
 
     /* Compute proper scaling value from buffer space */
@@ -1682,6 +2052,7 @@ do_passive_open(struct seg_entry *seg)
     /* Add the pkt information to the new pcb */
     in_caddr_copy(&nch->ch_pcb->key.faddr, &md->faddr);
     in_caddr_copy(&nch->ch_pcb->key.laddr, &md->laddr);
+    cnet_pcb_rehash(nch->ch_pcb);
 
     /* Retain part of the options */
     nch->ch_options  = ppcb->ch->ch_options & ((1 << SO_DONTROUTE) | (1 << SO_KEEPALIVE));
@@ -1702,6 +2073,10 @@ do_passive_open(struct seg_entry *seg)
 
     tcp_do_process_options(tcb, seg, nch);
 
+    /* The new connection uses the congestion control of the listener */
+    if (ppcb->tcb->cc != tcb->cc)
+        cnet_tcp_cc_set(tcb, ppcb->tcb->cc);
+
     /* Setup this TCB as having a parent PCB */
     tcb->ppcb = ppcb;
 
@@ -1716,7 +2091,7 @@ do_passive_open(struct seg_entry *seg)
     tcb->snd_wnd = seg->wnd << tcb->snd_scale;
 
     tcp_do_state_change(nch->ch_pcb, TCPS_SYN_RCVD); /* Move to SYN_RCVD */
-    tcb->timers[TCPT_KEEP] = TCP_KEEP_INIT_TV;
+    tcp_timer_set(tcb, TCPT_KEEP, TCP_KEEP_INIT_TV);
 
     /* Tell the new TCB to send a SYN_ACK */
     tcb->tflags |= TCBF_ACK_NOW;
@@ -1802,6 +2177,8 @@ tcb_cleanup(struct tcb_entry *tcb)
 
     /* TCB should be disconnected and ready to be freed */
     vec_free(tcb->reassemble);
+    cnet_tcp_sack_destroy(tcb->sack);
+    cnet_tcp_cc_release(tcb);
 
     tcb_free(tcb);
 
@@ -2087,12 +2464,19 @@ _process_data(struct seg_entry *seg, struct tcb_entry *tcb __cne_unused)
      * frequently than every second full-sized segment.
      */
     if (seg->mbuf) {
-        int len = pktmbuf_data_len(seg->mbuf);
+        int len = pktmbuf_pkt_len(seg->mbuf);
 
         if (len) {
             /* Update the rcv_nxt with the number of bytes consumed */
             tcb->rcv_nxt += len;
 
+            /*
+             * A packet merged by tcp_gro holds two or more segments, mark the ACK as
+             * already delayed so the caller sends it now.
+             */
+            if (seg->mbuf->nb_segs > 1)
+                tcb->tflags |= TCBF_DELAYED_ACK;
+
             /* chnl_recv will enqueue the mbufs to the receive queue */
 
             seg->mbuf = NULL; /* Consumed the packet */
@@ -2120,9 +2504,10 @@ do_process_data(struct seg_entry *seg)
 
         rc = _process_data(seg, tcb);
 
-        if (is_clr(tcb->tflags, TCBF_DELAYED_ACK))
+        if (is_clr(tcb->tflags, TCBF_DELAYED_ACK)) {
             tcb->tflags |= TCBF_DELAYED_ACK;
-        else {
+            tcp_timer_start(tcb, TCPT_DELACK, TCP_DELACK_TICKS);
+        } else {
             tcb->tflags |= TCBF_ACK_NOW;
             cnet_tcp_output(tcb);
         }
@@ -2223,7 +2608,7 @@ do_segment_syn_sent(struct seg_entry *seg)
     if (is_set(seg->flags, TCP_SYN) && (acceptable || is_clr(seg->flags, TCP_ACK))) {
         tcp_do_process_options(tcb, seg, seg->pcb->ch);
 
-        tcb->timers[TCPT_REXMT] = 0;
+        tcp_timer_stop(tcb, TCPT_REXMT);
 
         /* RCV.NXT = SEG.SEQ + 1 */
         tcb->rcv_adv = tcb->rcv_nxt = seg->seq + 1;
@@ -2356,40 +2741,6 @@ tcp_calculate_RTT(struct tcb_entry *tcb, int16_t rtt)
     return 0;
 }
 
-/*
- * Update the congestion window value in the TCB structure. When cwnd < then
- * ssthresh then we are in slow start. If greater then or equal to ssthresh
- * then we are in congestion avoidance.
- *
- * RFC2581: pg 4
- * During slow start, a TCP increments cwnd by at most SMSS bytes for
- * each ACK received that acknowledges new data. Slow start ends when
- * cwnd exceeds ssthresh (or, optionally, when it reaches it, as noted
- * above) or when congestion is observed.
- *
- * During congestion avoidance, cwnd is incremented by 1 full-sized
- * segment per round-trip time (RTT). Congestion avoidance continues
- * until congestion is detected. One formula commonly used to update
- * cwnd during congestion avoidance is given in equation 2:
- *       cwnd += SMSS*SMSS/cwnd (2)
- */
-static void
-tcp_update_cwnd(struct tcb_entry *tcb)
-{
-    uint32_t cwnd = tcb->snd_cwnd;
-    uint32_t incr = tcb->max_mss;
-
-    /*
-     * When cwnd is <= to ssthresh, we are in slow-start else
-     * congestion avoidance.
-     */
-    if (cwnd > tcb->snd_ssthresh)
-        incr = incr * incr / cwnd; /* cwnd += SMSS*SMSS/cwnd (2) */
-
-    /* Increase the cwnd by SMSS value unless in congestion avoidance */
-    tcb->snd_cwnd = CNE_MIN((int)(cwnd + incr), TCP_MAXWIN << tcb->snd_scale);
-}
-
 /*
  * Update the segment information values in the TCB structure.
  */
@@ -2425,6 +2776,7 @@ do_segment_others(struct seg_entry *seg)
 {
     struct tcb_entry *tcb = seg->pcb->tcb;
     struct chnl *ch       = seg->pcb->ch;
+    seq_t snd_una         = tcb->snd_una;
     int32_t trim, rc = TCP_INPUT_NEXT_PKT_DROP;
     bool acceptable;
 
@@ -2451,8 +2803,13 @@ do_segment_others(struct seg_entry *seg)
      * After sending the acknowledgment, drop the unacceptable segment and
      * return.
      */
-    if (acceptable == false)
+    if (acceptable == false) {
+        /* Report a duplicate of data already received with a D-SACK block, RFC2883 */
+        if (tcp_sack_enabled(tcb) && seg->len && seqLEQ(seg->seq + seg->len, tcb->rcv_nxt))
+            cnet_tcp_sack_dsack_set(tcb->sack, seg->seq, seg->seq + seg->len);
+
         return tcp_drop_after_ack(seg);
+    }
 
     /*
      * In the following it is assumed that the segment is the idealized
@@ -2741,7 +3098,9 @@ do_segment_others(struct seg_entry *seg)
          */
         if (seqLEQ(seg->ack, tcb->snd_una)) {
             if ((seg->len == 0) && (seg->wnd == tcb->snd_wnd)) {
-                if ((tcb->timers[TCPT_REXMT] == 0) || (seg->ack != tcb->snd_una))
+                /* With SACK the scoreboard and RACK detect the losses, not dupacks */
+                if (!tcp_timer_active(tcb, TCPT_REXMT) || (seg->ack != tcb->snd_una) ||
+                    tcp_sack_enabled(tcb))
                     tcb->dupacks = 0;
 
                 /* RFC2581: pg 6
@@ -2752,16 +3111,13 @@ do_segment_others(struct seg_entry *seg)
                  */
                 else if (++tcb->dupacks == TCP_RETRANSMIT_THRESHOLD) {
                     uint32_t onxt = tcb->snd_max;
-                    uint32_t win  = CNE_MIN(tcb->snd_wnd, tcb->snd_cwnd) / 2 / tcb->max_mss;
 
-                    if (win < 2)
-                        win = 2;
-                    /* Equation (3): ssthresh = max (FlightSize / 2, 2*SMSS) */
-                    tcb->snd_ssthresh       = win * tcb->max_mss;
-                    tcb->timers[TCPT_REXMT] = 0;
-                    tcb->rtt                = 0;
-                    tcb->snd_nxt            = seg->ack;
-                    tcb->snd_cwnd           = tcb->max_mss;
+                    /* Equation (3) for Reno, the congestion control sets ssthresh */
+                    cnet_tcp_cc_loss(tcb);
+                    tcp_timer_stop(tcb, TCPT_REXMT);
+                    tcb->rtt      = 0;
+                    tcb->snd_nxt  = seg->ack;
+                    tcb->snd_cwnd = tcb->max_mss;
 
                     cnet_tcp_output(tcb);
                     /*
@@ -2850,7 +3206,7 @@ do_segment_others(struct seg_entry *seg)
     case TCPS_LAST_ACK:
         if (is_set(tcb->tflags, TCBF_OUR_FIN_ACKED)) {
             if (tcb->pcb && tcb->pcb->ch)
-                tcb->pcb->ch->ch_callback(CHNL_TCP_CLOSE_TYPE, tcb->pcb->ch->ch_cd);
+                chnl_notify(tcb->pcb->ch, CHNL_TCP_CLOSE_TYPE);
 
             tcp_do_state_change(seg->pcb, TCPS_CLOSED);
             return TCP_INPUT_NEXT_PKT_DROP;
@@ -2908,12 +3264,12 @@ do_segment_others(struct seg_entry *seg)
      * reset the retransmit timer to the current RTO value.
      */
     if (seg->ack == tcb->snd_max)
-        tcb->timers[TCPT_REXMT] = 0;
-    else if (tcb->timers[TCPT_PERSIST] == 0)
-        tcb->timers[TCPT_REXMT] = tcb->rxtcur;
+        tcp_timer_stop(tcb, TCPT_REXMT);
+    else if (!tcp_timer_active(tcb, TCPT_PERSIST))
+        tcp_timer_set(tcb, TCPT_REXMT, tcb->rxtcur);
 
     /* Update the congestion window for this connection. */
-    tcp_update_cwnd(tcb);
+    cnet_tcp_cc_ack(tcb, tcb->snd_una - snd_una, cne_rdtsc());
 
     /* Sixth, check the URG bit */
     CNE_DEBUG("Check RFC 793 [orange]URG[] bit\n");
@@ -3048,7 +3404,7 @@ do_segment_others(struct seg_entry *seg)
         case TCPS_FIN_WAIT_2:
             CNE_DEBUG("FIN bit set in [orange]FIN Wait 2[]\n");
             tcp_do_state_change(tcb->pcb, TCPS_TIME_WAIT);
-            tcb->timers[TCPT_2MSL] = 2 * TCP_MSL_TV;
+            tcp_timer_set(tcb, TCPT_2MSL, 2 * TCP_MSL_TV);
             break;
 
         /*
@@ -3057,7 +3413,7 @@ do_segment_others(struct seg_entry *seg)
          */
         case TCPS_TIME_WAIT:
             CNE_DEBUG("FIN bit set in [orange]Time Wait[]\n");
-            tcb->timers[TCPT_2MSL] = 2 * TCP_MSL_TV;
+            tcp_timer_set(tcb, TCPT_2MSL, 2 * TCP_MSL_TV);
             break;
 
         /*
@@ -3226,6 +3582,7 @@ tcp_header_prediction(struct seg_entry *seg, struct tcb_entry *tcb)
          */
         if (seqGT(seg->ack, tcb->snd_una) && seqLEQ(seg->ack, tcb->snd_max) &&
             (tcb->snd_cwnd >= tcb->snd_wnd)) {
+            uint32_t acked = seg->ack - tcb->snd_una;
 
             INC_TCP_STAT(ack_predicted);
 
@@ -3235,14 +3592,15 @@ tcp_header_prediction(struct seg_entry *seg, struct tcb_entry *tcb)
             else if (tcb->rtt && seqGT(seg->ack, tcb->rttseq))
                 tcp_calculate_RTT(tcb, tcb->rtt);
 
-            cnet_drop_acked_data(&ch->ch_snd, (seg->ack - tcb->snd_una));
+            cnet_drop_acked_data(&ch->ch_snd, acked);
 
             tcb->snd_una = seg->ack;
+            cnet_tcp_cc_ack(tcb, acked, cne_rdtsc());
 
             if (tcb->snd_una == tcb->snd_max)
-                tcb->timers[TCPT_REXMT] = 0;
-            else if (tcb->timers[TCPT_PERSIST] == 0)
-                tcb->timers[TCPT_REXMT] = tcb->rxtcur;
+                tcp_timer_stop(tcb, TCPT_REXMT);
+            else if (!tcp_timer_active(tcb, TCPT_PERSIST))
+                tcp_timer_set(tcb, TCPT_REXMT, tcb->rxtcur);
 
             /* Allow the users to put more data in send buffer */
             if (cb_space(&ch->ch_snd) >= ch->ch_snd.cb_lowat) {
@@ -3269,9 +3627,10 @@ tcp_header_prediction(struct seg_entry *seg, struct tcb_entry *tcb)
 
         rc = _process_data(seg, tcb);
 
-        if (is_clr(tcb->tflags, TCBF_DELAYED_ACK))
+        if (is_clr(tcb->tflags, TCBF_DELAYED_ACK)) {
             tcb->tflags |= TCBF_DELAYED_ACK;
-        else {
+            tcp_timer_start(tcb, TCPT_DELACK, TCP_DELACK_TICKS);
+        } else {
             tcb->tflags |= TCBF_ACK_NOW;
             cnet_tcp_output(tcb);
         }
@@ -3336,6 +3695,7 @@ cnet_tcp_input(struct pcb_entry *pcb, pktmbuf_t *mbuf)
     uint16_t tlen;
     struct tcb_entry *tcb      = NULL;
     uint8_t tcp_syn_fin_cnt[4] = {0, 1, 1, 2};
+    int sack_ev                = 0;
 
     if (!(this_cnet->flags & CNET_TCP_ENABLED))
         CNE_ERR_GOTO(free_seg, "TCP is not enabled\n");
@@ -3452,8 +3812,8 @@ cnet_tcp_input(struct pcb_entry *pcb, pktmbuf_t *mbuf)
         CNE_ERR_GOTO(free_seg, "[orange]TCB is Closed[]\n");
 
     /* Process the packet for the given TCP state */
-    tcb->idle              = 0;
-    tcb->timers[TCPT_KEEP] = tcb->tcp->keep_idle;
+    tcb->idle_ts = stk_get_timer_ticks();
+    tcp_timer_set(tcb, TCPT_KEEP, tcb->tcp->keep_idle);
 
     /* Scale the window value if not a SYN segment */
     if (is_clr(seg->flags, TCP_SYN))
@@ -3466,6 +3826,10 @@ cnet_tcp_input(struct pcb_entry *pcb, pktmbuf_t *mbuf)
         CNE_DEBUG("Flags: [orange]%s[]\n", tcb_print_flags(seg->pcb->tcb->tflags));
     }
 
+    /* Update the SACK scoreboard and the RACK state before the ACK is processed */
+    if (tcb->state >= TCPS_ESTABLISHED && is_set(seg->flags, TCP_ACK) && tcp_sack_enabled(tcb))
+        sack_ev = tcp_sack_input(seg, tcb);
+
 #ifdef ENABLE_HEADER_PREDICTION
     /*
      * TCP Header prediction.
@@ -3479,7 +3843,8 @@ cnet_tcp_input(struct pcb_entry *pcb, pktmbuf_t *mbuf)
     if ((tcb->state == TCPS_ESTABLISHED) && ((seg->flags & HDR_PREDIC) == TCP_ACK) &&
         (is_clr(seg->sflags, SEG_TS_PRESENT) || tstampGEQ(seg->ts_val, tcb->ts_recent)) &&
         (seg->seq == tcb->rcv_nxt) && (seg->wnd && (seg->wnd == tcb->snd_wnd)) &&
-        (tcb->snd_nxt == tcb->snd_max)) {
+        (tcb->snd_nxt == tcb->snd_max) && (sack_ev == 0) && (seg->nb_sacks == 0) &&
+        is_clr(tcb->tflags, TCBF_IN_RECOVERY)) {
         if (tcp_header_prediction(seg, tcb)) {
             CNE_DEBUG("Header prediction [orange]Good[]\n");
             rc = TCP_INPUT_NEXT_CHNL_RECV;
@@ -3510,6 +3875,11 @@ cnet_tcp_input(struct pcb_entry *pcb, pktmbuf_t *mbuf)
         rc = TCP_INPUT_NEXT_PKT_DROP;
     }
 
+    /* Retransmit the lost segments once the ACK has been processed */
+    if (seg->pcb && seg->pcb->tcb == tcb && tcp_sack_enabled(tcb) &&
+        (sack_ev || is_set(tcb->tflags, TCBF_IN_RECOVERY)))
+        tcp_sack_recover(tcb, sack_ev);
+
     if (seg->pcb && seg->pcb->tcb && seg->pcb->tcb->state != TCPS_SYN_RCVD)
         cnet_tcp_output(seg->pcb->tcb);
 
@@ -3527,10 +3897,13 @@ tcp_fast_retransmit_timo(stk_t *stk)
 {
     struct pcb_hd *hd = &stk->tcp->tcp_hd;
     struct pcb_entry *p;
+    uint64_t now;
 
     if (!hd)
         return;
 
+    now = cne_rdtsc();
+
     /* TCP fast timer to process retransmits. */
     vec_foreach_ptr (p, hd->vec) {
         struct tcb_entry *t = p->tcb;
@@ -3539,27 +3912,28 @@ tcp_fast_retransmit_timo(stk_t *stk)
             t->tflags &= ~TCBF_NEED_FAST_REXMT;
             cnet_tcp_output(t);
         }
+
+        /* RACK reordering and tail loss probe timers */
+        if (t && t->state >= TCPS_ESTABLISHED && tcp_sack_enabled(t))
+            tcp_sack_timo(t, now);
     }
 }
 
 /*
- * Process the fast timeout for TCP, which is used for delayed ACKs.
+ * Process an expired TCP timer, the delayed ACK timer and the slow timers of
+ * the state machine.
  */
-static inline void
-tcp_fast_timo(void *arg)
+static bool
+tcp_process_timer(struct pcb_entry *p, int32_t tmr)
 {
-    stk_t *stk        = (stk_t *)arg;
-    struct pcb_hd *hd = &stk->tcp->tcp_hd;
-    struct pcb_entry *p;
-
-    if (!hd)
-        CNE_RET("tcp_hd is NULL\n");
-
-    /* TCP fast timer to process Delayed ACKs. */
-    vec_foreach_ptr (p, hd->vec) {
-        struct tcb_entry *t = p->tcb;
+    struct tcb_entry *t = p->tcb; /* tcb pointer will be valid from the caller */
+    stk_t *stk          = this_stk;
+    int32_t rexmt;
+    bool state = false;
 
-        if (t && is_set(t->tflags, TCBF_DELAYED_ACK)) {
+    switch (tmr) {
+    case TCPT_DELACK:
+        if (is_set(t->tflags, TCBF_DELAYED_ACK)) {
             t->tflags &= ~TCBF_DELAYED_ACK;
             t->tflags |= TCBF_ACK_NOW;
 
@@ -3568,26 +3942,11 @@ tcp_fast_timo(void *arg)
             /* ACK flag is cleared in tcp output */
             cnet_tcp_output(t);
         }
-    }
-}
-
-/*
- * Process the TCP timers for the slow timeouts or the state machine for
- * the timers and TCP.
- */
-static bool
-tcp_process_timer(struct pcb_entry *p, int32_t tmr)
-{
-    struct tcb_entry *t = p->tcb; /* tcb pointer will be valid from the caller */
-    stk_t *stk          = this_stk;
-    int32_t rexmt;
-    uint32_t win;
-    bool state = false;
+        break;
 
-    switch (tmr) {
     case TCPT_2MSL:
-        if ((t->state != TCPS_TIME_WAIT) && (t->idle <= stk->tcp->max_idle))
-            t->timers[tmr] = stk->tcp->keep_intvl;
+        if ((t->state != TCPS_TIME_WAIT) && (tcp_idle(t) <= (uint32_t)stk->tcp->max_idle))
+            tcp_timer_set(t, tmr, stk->tcp->keep_intvl);
         else {
             tcp_do_state_change(p, TCPS_CLOSED);
             state = true;
@@ -3616,17 +3975,19 @@ tcp_process_timer(struct pcb_entry *p, int32_t tmr)
         }
 
         if (is_set(p->opt_flag, SO_KEEPALIVE) && (t->state <= TCPS_CLOSE_WAIT)) {
-            if (t->idle >= (stk->tcp->keep_idle + stk->tcp->max_idle)) {
-                CNE_DEBUG("Idle %d < %d\n", t->idle, stk->tcp->keep_idle + stk->tcp->max_idle);
+            uint32_t idle = tcp_idle(t);
+
+            if (idle >= (uint32_t)(stk->tcp->keep_idle + stk->tcp->max_idle)) {
+                CNE_DEBUG("Idle %u < %d\n", idle, stk->tcp->keep_idle + stk->tcp->max_idle);
                 goto dropit;
             }
 
             CNE_DEBUG("[orange]Keepalive!![]\n");
             tcp_do_response(t->netif, p, NULL, t->snd_nxt - 1, t->rcv_nxt - 1, TCP_ACK);
 
-            t->timers[tmr] = stk->tcp->keep_intvl;
+            tcp_timer_set(t, tmr, stk->tcp->keep_intvl);
         } else
-            t->timers[tmr] = stk->tcp->keep_idle;
+            tcp_timer_set(t, tmr, stk->tcp->keep_idle);
 
         break;
     dropit:
@@ -3651,20 +4012,21 @@ tcp_process_timer(struct pcb_entry *p, int32_t tmr)
         t->rxtcur = tcp_range_set(rexmt, t->rttmin, TCP_REXMTMAX_TV);
 
         /* Restart the retransmit timer */
-        t->timers[TCPT_REXMT] = t->rxtcur;
+        tcp_timer_set(t, TCPT_REXMT, t->rxtcur);
 
         /* Reset snd_nxt to force a retransmit of data */
         t->snd_nxt = t->snd_una;
         t->rtt     = 0;
 
-        win = CNE_MIN(t->snd_wnd, t->snd_cwnd) / 2 / t->max_mss;
-
-        if (win < 2)
-            win = 2;
+        /* The congestion control sets cwnd to the loss window and ssthresh */
+        cnet_tcp_cc_rto(t);
+        t->dupacks = 0;
 
-        t->snd_cwnd     = t->max_mss;
-        t->snd_ssthresh = win * t->max_mss;
-        t->dupacks      = 0;
+        /* The receiver may discard SACKed data, forget the scoreboard state RFC2018 */
+        if (t->sack) {
+            cnet_tcp_sack_rto(t->sack);
+            t->tflags &= ~TCBF_IN_RECOVERY;
+        }
 
         /* Set the ACK now bit to force a retransmit. */
         t->tflags |= TCBF_ACK_NOW;
@@ -3679,60 +4041,87 @@ tcp_process_timer(struct pcb_entry *p, int32_t tmr)
 }
 
 /*
- * Process the slow timeouts for the TCP state machine.
+ * Timer wheel callback, the timer is stopped and tcp_process_timer() can restart it.
+ */
+static void
+tcp_timer_expire(struct tcp_timer_entry *tim, void *arg __cne_unused)
+{
+    struct tcb_entry *t = tim->arg;
+
+    if (!t->pcb)
+        return;
+
+    /* The state machine timers do not run while closed or listening */
+    if (tim->idx != TCPT_DELACK && (t->state == TCPS_CLOSED || t->state == TCPS_LISTEN))
+        return;
+
+    tcp_process_timer(t->pcb, tim->idx);
+}
+
+/*
+ * Process the slow timeouts for the TCP state machine, the TCB timers are on
+ * the timer wheel and only the ones expiring are touched.
  */
 static inline void
 tcp_slow_timo(stk_t *stk)
 {
+    stk->tcp->max_idle = stk->tcp->keep_cnt * stk->tcp->keep_intvl;
+
+    stk->tcp->snd_ISS += (TCP_ISSINCR / TCP_SLOWHZ); /* Increment iss */
+    stk->tcp_now++;
+}
+
+/*
+ * Pacer timer, send for the connections whose paced send is due and re-arm the timer at
+ * the earliest deadline left.
+ */
+void
+tcp_pace_timo(struct cne_timer *tim, void *arg)
+{
+    stk_t *stk        = arg;
     struct pcb_hd *hd = &stk->tcp->tcp_hd;
     struct pcb_entry *p;
-    int32_t j;
+    uint64_t now, next = 0;
 
-    stk->tcp->max_idle = stk->tcp->keep_cnt * stk->tcp->keep_intvl;
+    now = cne_rdtsc();
 
-    /* TCP slow timer */
     vec_foreach_ptr (p, hd->vec) {
         struct tcb_entry *t = p->tcb;
 
-        if (!t)
-            continue;
-
-        if (t->state == TCPS_CLOSED || t->state == TCPS_LISTEN)
+        if (!t || t->pace_next == 0)
             continue;
 
-        for (j = 0; j < TCP_NTIMERS; j++) {
-            if ((t->timers[j] > 0) && (--t->timers[j] == 0))
-                if (tcp_process_timer(p, j)) {
-                    t = NULL;
-                    break;
-                }
+        if (now >= t->pace_next) {
+            t->pace_next = 0;
+            cnet_tcp_output(t);
         }
 
-        /* measure the current idle time */
-        if (t)
-            t->idle++;
+        if (t->pace_next && (next == 0 || t->pace_next < next))
+            next = t->pace_next;
     }
 
-    stk->tcp->snd_ISS += (TCP_ISSINCR / TCP_SLOWHZ); /* Increment iss */
-    stk->tcp_now++;
+    if (next)
+        cne_timer_reset(tim, (next > now) ? next - now : 1, SINGLE, cne_id(), tcp_pace_timo, stk);
 }
 
 /*
- * Timeout every XXms to be able to have a fast and slow timer of 200ms/500ms.
+ * Timeout every MS_PER_TICK ms to run the 100ms and 500ms timeouts and to advance
+ * the timer wheel of the TCB timers by one tick.
  */
 static void
 _process_timers(struct cne_timer *tim __cne_unused, void *arg)
 {
     stk_t *stk = arg;
 
+    stk->ticks++;
+
     if (!(stk->ticks % (TCP_REXMT_TIMEOUT_MS / MS_PER_TICK)))
         tcp_fast_retransmit_timo(stk);
 
-    if (!(stk->ticks % (TCP_FAST_TIMEOUT_MS / MS_PER_TICK)))
-        tcp_fast_timo(stk);
-
-    if (!(stk->ticks % (TCP_SLOW_TIMEOUT_MS / MS_PER_TICK)))
+    if (!(stk->ticks % TCP_SLOW_TICKS))
         tcp_slow_timo(stk);
+
+    cnet_tcp_timer_advance(&stk->tcp->tw, stk->ticks);
 }
 
 /*
@@ -3776,6 +4165,16 @@ tcp_send_options(struct tcb_entry *tcb, uint8_t *opts, uint8_t flags_n)
             *p++ = TCP_OPT_NOP;
             optlen += 4;
         }
+
+        /* Add the SACK permitted option to the SYN or the SYN/ACK when the peer sent it */
+        if (is_set(tcb->tflags, TCBF_REQ_SACK) &&
+            (is_clr(flags_n, TCP_ACK) || is_set(tcb->tflags, TCBF_SACK_PERMIT))) {
+            *p++ = TCP_OPT_NOP;
+            *p++ = TCP_OPT_NOP;
+            *p++ = TCP_OPT_SACK_OK;
+            *p++ = TCP_OPT_SACK_LEN;
+            optlen += 4;
+        }
     }
 
     CNE_DEBUG("tcb state [orange]%s[]\n", tcb_print_flags(tcb->tflags));
@@ -3794,6 +4193,19 @@ tcp_send_options(struct tcb_entry *tcb, uint8_t *opts, uint8_t flags_n)
     } else
         CNE_DEBUG("TCP options not added\n");
 
+    /* Send a pending D-SACK block once, RFC2883 */
+    if (tcp_sack_enabled(tcb) && tcb->sack->dsack_pending && is_clr(flags_n, SYN_RST)) {
+        uint32_t *lp = (uint32_t *)&opts[optlen];
+
+        *lp++ = htobe32((TCP_OPT_NOP << 24) | (TCP_OPT_NOP << 16) | (TCP_OPT_SACK << 8) |
+                        (2 + TCP_SACK_BLOCK_LEN));
+        *lp++ = htobe32(tcb->sack->dsack.start);
+        *lp++ = htobe32(tcb->sack->dsack.end);
+        optlen += 12;
+
+        tcb->sack->dsack_pending = false;
+    }
+
     return optlen; /* Length of options */
 }
 
@@ -3868,8 +4280,8 @@ cnet_tcp_connect(struct pcb_entry *pcb)
 
     chnl_state_set(pcb->ch, _ISCONNECTING);
 
-    tcb->state             = TCPS_SYN_SENT;
-    tcb->timers[TCPT_KEEP] = TCP_KEEP_INIT_TV;
+    tcb->state = TCPS_SYN_SENT;
+    tcp_timer_set(tcb, TCPT_KEEP, TCP_KEEP_INIT_TV);
 
     /* Set the new send ISS value. */
     tcp_send_seq_set(tcb, 7);
@@ -3957,6 +4369,8 @@ cnet_tcb_list(stk_t *stk, struct tcb_entry *tcb)
             t->snd_max, t->snd_wnd, t->snd_ssthresh, t->snd_cwnd, t->max_sndwnd);
         cne_printf("   Rcv: wnd %u nxt %u urp %u irs %u adv %u bsize %u sst %u\n", t->rcv_wnd,
                    t->rcv_nxt, t->rcv_urp, t->rcv_irs, t->rcv_adv, t->rcv_bsize, t->rcv_ssthresh);
+        cne_printf("   CC: [orange]%s[] pacing %lu bytes/sec max %lu tokens %u\n",
+                   t->cc ? t->cc->name : "none", t->pacing_rate, t->pace_max, t->pace_tokens);
         cne_printf("   Flags: [orange]%s[]\n", tcb_print_flags(t->tflags));
     }
 }
@@ -3975,7 +4389,7 @@ cnet_tcb_dump(void)
  * Main entry point to initialize the TCP protocol.
  */
 static int
-tcp_init(int32_t n_tcb_entries, bool wscale, bool t_stamp)
+tcp_init(int32_t n_tcb_entries, bool wscale, bool t_stamp, bool sack, bool gso, bool gro)
 {
     stk_t *stk                = this_stk;
     struct mempool_cfg cfg    = {0};
@@ -4002,6 +4416,9 @@ tcp_init(int32_t n_tcb_entries, bool wscale, bool t_stamp)
 
     stk->gflags |= (TCP_TIMEOUT_ENABLED | (wscale ? RFC1323_SCALE_ENABLED : 0));
     stk->gflags |= (t_stamp ? RFC1323_TSTAMP_ENABLED : 0);
+    stk->gflags |= (sack ? RFC2018_SACK_ENABLED : 0);
+    stk->gflags |= (gso ? TCP_GSO_ENABLED : 0);
+    stk->gflags |= (gro ? TCP_GRO_ENABLED : 0);
 
     stk->tcp->rcv_size    = MAX_TCP_RCV_SIZE;
     stk->tcp->snd_size    = MAX_TCP_SND_SIZE;
@@ -4012,11 +4429,14 @@ tcp_init(int32_t n_tcb_entries, bool wscale, bool t_stamp)
     stk->tcp->default_MSS = TCP_NORMAL_MSS;
     stk->tcp->default_RTT = TCP_SRTTDFLT_TV; /* RFC6298 states - 1 sec */
     stk->tcp->snd_ISS     = (uint32_t)rand();
+    stk->tcp->cc          = cnet_tcp_cc_find(TCP_CC_DEFAULT);
     stk->tcp_now          = (uint32_t)cne_rdtsc();
 
     stk->tcp->tcp_hd.vec = vec_alloc(stk->tcp->tcp_hd.vec, TCP_VEC_PCB_COUNT);
     CNE_ASSERT(stk->tcp->tcp_hd.vec != NULL);
     stk->tcp->tcp_hd.local_port = _IPPORT_RESERVED;
+    if (cnet_pcb_hd_init(&stk->tcp->tcp_hd, "tcp_pcb", CNET_NUM_CHANNELS) < 0)
+        goto err_exit;
 
     cfg.objcnt    = CNET_NUM_TCBS;
     cfg.objsz     = sizeof(struct seg_entry);
@@ -4031,7 +4451,9 @@ tcp_init(int32_t n_tcb_entries, bool wscale, bool t_stamp)
     if (CNET_ENABLE_IP6 && !cnet_protosw_add("TCPv6", AF_INET6, SOCK_STREAM, IPPROTO_TCP))
         goto err_exit;
 
+    cnet_tcp_timer_init(&stk->tcp->tw, stk->ticks, tcp_timer_expire, stk);
     cne_timer_init(&stk->tcp_timer);
+    cne_timer_init(&stk->tcp_pace_timer);
 
     if (cne_timer_reset(&stk->tcp_timer, (cne_get_timer_hz() / 1000) * 10, PERIODICAL, cne_id(),
                         _process_timers, (void *)stk) < 0)
@@ -4062,7 +4484,7 @@ cleanup:
 static int
 tcp_create(void *stk __cne_unused)
 {
-    return tcp_init(CNET_NUM_TCBS, 1, 1);
+    return tcp_init(CNET_NUM_TCBS, 1, 1, 1, 1, 1);
 }
 
 static int
@@ -4071,6 +4493,8 @@ tcp_destroy(void *_stk __cne_unused)
     stk_t *stk = _stk;
 
     free(stk->tcp_stats);
+    if (stk->tcp)
+        cnet_pcb_hd_free(&stk->tcp->tcp_hd);
     free(stk->tcp);
     free(stk->tcbs);
 
@@ -4079,6 +4503,7 @@ tcp_destroy(void *_stk __cne_unused)
 
     if (cne_timer_stop(&stk->tcp_timer) < 0)
         CNE_ERR("Failed to stop TCP timer for instance %s\n", stk->name);
+    cne_timer_stop(&stk->tcp_pace_timer);
 
     return 0;
 }
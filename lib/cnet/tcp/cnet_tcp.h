@@ -57,6 +57,9 @@
 #include "cnet_stk.h"          // for per_thread_stk, stk_entry, this_stk
 #include "mempool.h"           // for mempool_get, mempool_put
 #include "pktmbuf.h"           // for pktmbuf_t
+#include "cnet_tcp_sack.h"     // for tcp_sack, tcp_sack_blk, TCP_SACK_MAX_BLOCKS
+#include "cnet_tcp_cc.h"       // for tcp_cc_ops, tcp_cc_rs, TCP_CC_PRIV_U64
+#include "cnet_tcp_timer.h"    // for tcp_timer_entry, tcp_timer_wheel
 #include <cne_inet6.h>
 #ifdef __cplusplus
 extern "C" {
@@ -259,6 +262,12 @@ enum {
 #define TCP_FAST_TIMEOUT_MS  200UL
 #define TCP_SLOW_TIMEOUT_MS  500UL
 
+/* Timer wheel ticks of a slow timeout tick and of the delayed ACK timeout */
+#define TCP_SLOW_TICKS   (TCP_SLOW_TIMEOUT_MS / MS_PER_TICK)
+#define TCP_DELACK_TICKS (TCP_FAST_TIMEOUT_MS / MS_PER_TICK)
+
+#define TCP_PACE_BURST_US 1000 /**< Pacer token bucket depth in micro-seconds of data */
+
 /*
  * The initial retransmission should happen at rtt + 4 * rttvar.
  * Because of the way we do the smoothing, srtt and rttvar
@@ -297,6 +306,7 @@ enum {
     TCPT_PERSIST,   /**< Persist timer index */
     TCPT_KEEP,      /**< Keepalive or Connection Established timer */
     TCPT_2MSL,      /**< 2 x Max Segment Life or FIN Wait 2 timer */
+    TCPT_DELACK,    /**< Delayed ACK timer */
     TCP_NTIMERS     /**< Number of timers in tcb_t.timers */
 };
 
@@ -322,6 +332,9 @@ struct seg_entry {
     uint8_t req_scale;             /**< Requested send scale */
     uint8_t optlen;                /**< TCP Options length */
     uint8_t opts[TCP_MAX_OPTIONS]; /**< TCP Option bytes */
+
+    uint8_t nb_sacks;                               /**< Number of SACK blocks in sacks[] */
+    struct tcp_sack_blk sacks[TCP_SACK_MAX_BLOCKS]; /**< SACK blocks in host order */
 };
 
 /* seg_entry.sflags bit definitions */
@@ -329,7 +342,7 @@ enum {
     SEG_TS_PRESENT  = 0x8000, /**< Timestamp is present */
     SEG_MSS_PRESENT = 0x4000, /**< MSS option is present */
     SEG_WS_PRESENT  = 0x2000, /**< Window Scale present */
-    SEG_SACK_PERMIT = 0x1000  /**< SACK permission flag, which is not supported at this time. */
+    SEG_SACK_PERMIT = 0x1000  /**< SACK permitted option is present */
 };
 
 enum {
@@ -351,6 +364,7 @@ struct tcb_entry {
     TAILQ_ENTRY(tcb_entry) entry; /**< Pointer to the next free tcb_entry structure */
 
     pktmbuf_t **reassemble;
+    struct tcp_sack *sack;    /**< SACK scoreboard, NULL when SACK is disabled */
     struct tcp_q backlog_q;   /**< Backlog queue of connections */
     struct tcp_q half_open_q; /**< Half open queue of connections */
 
@@ -364,8 +378,8 @@ struct tcb_entry {
     tcb_state_t state; /**< TCP Input State */
     uint16_t max_mss;  /**< Maximum Segment Size */
 
-    int16_t timers[TCP_NTIMERS] __cne_aligned(8); /**< TCP timers */
-    int32_t qLimit;                               /**< backlog limit for (3 * qLimit)/2 */
+    struct tcp_timer_entry timers[TCP_NTIMERS]; /**< TCP timers on the stack timer wheel */
+    int32_t qLimit;                             /**< backlog limit for (3 * qLimit)/2 */
 
     /* RFC1323 variables */
     uint8_t snd_scale;      /**< Send Window scale */
@@ -409,7 +423,19 @@ struct tcb_entry {
     int16_t rxtcur;      /**< Retransmission timeout */
     uint16_t rttmin;     /**< Minimum value for retransmission timeout */
     int16_t rxtshift;    /**< index into tcp_backoff[] array */
-    uint16_t idle;       /**< TCP Idle counter */
+    uint32_t idle_ts;    /**< tcp_now of the last segment received, see tcp_idle() */
+
+    /* Congestion control */
+    const struct tcp_cc_ops *cc;       /**< Congestion control module */
+    uint64_t pacing_rate;              /**< Pacing rate in bytes/sec, zero for no pacing */
+    struct tcp_cc_rs cc_rs;            /**< Round trip and delivery rate sampler */
+    uint64_t cc_priv[TCP_CC_PRIV_U64]; /**< Private state of the congestion control module */
+
+    /* Token bucket pacer */
+    uint64_t pace_max;    /**< Max pacing rate in bytes/sec, SO_MAX_PACING_RATE, zero none */
+    uint64_t pace_ts;     /**< Cycles of the last token refill */
+    uint64_t pace_next;   /**< Cycles when the paced send resumes, zero when not waiting */
+    uint32_t pace_tokens; /**< Bytes the connection can send now */
 };
 
 /* tcb_entry.tflags values */
@@ -422,8 +448,8 @@ enum {
 
     TCBF_RFC1122_URG     = 0x01000000, /**< RFC1122 Urgent */
     TCBF_BOUND           = 0x02000000, /**< TCB is Bound */
-    TCBF_FREE_BIT_2      = 0x04000000,
-    TCBF_FREE_BIT_3      = 0x08000000,
+    TCBF_REQ_SACK        = 0x04000000, /**< Requested SACK permitted option */
+    TCBF_IN_RECOVERY     = 0x08000000, /**< SACK loss recovery in progress */
 
     TCBF_REQ_TSTAMP      = 0x00100000, /**< Requested Timestamp option */
     TCBF_RCVD_SCALE      = 0x00200000, /**< Window Scaling received */
@@ -432,7 +458,7 @@ enum {
 
     TCBF_ACK_NOW         = 0x00010000, /**< ACK Now */
     TCBF_SENT_FIN        = 0x00020000, /**< FIN has been sent */
-    TCBF_SACK_PERMIT     = 0x00040000, /**< SACK Permit is not supported, look at SEG_SACK_PERMIT */
+    TCBF_SACK_PERMIT     = 0x00040000, /**< Peer sent the SACK permitted option */
     TCBF_RCVD_TSTAMP     = 0x00080000, /**< Received Timestamp in SYN */
 
     TCBF_NODELAY         = 0x00001000, /**< don't delay packets */
@@ -453,8 +479,8 @@ enum {
         "FORCE_TX",         \
         "PASSIVE_OPEN",     \
                             \
-        "Free_3",           \
-        "Free_2",           \
+        "IN_RECOVERY",      \
+        "REQ_SACK",         \
         "BOUND",            \
         "RFC1122_URG",      \
                             \
@@ -488,9 +514,12 @@ struct chnl;
 #ifndef __CNET_PCB_HD_STRUCT_
 #define __CNET_PCB_HD_STRUCT_
 struct pcb_entry;
+struct cne_hash;
 struct pcb_hd {
-    struct pcb_entry **vec; /**< PCB entries */
-    uint16_t local_port;    /**< Local port number i.e. IP local port ID */
+    struct pcb_entry **vec;  /**< PCB entries */
+    struct pcb_entry **wild; /**< PCB entries not in the hash table i.e. listeners */
+    struct cne_hash *hash;   /**< Exact match 4-tuple hash table of PCB entries */
+    uint16_t local_port;     /**< Local port number i.e. IP local port ID */
 };
 #endif
 
@@ -504,9 +533,11 @@ struct tcp_entry {
     int32_t keep_cnt;   /**< TCP Keep Count */
     int32_t max_idle;   /**< TCP Max Idle */
     uint16_t pad0;
-    uint16_t default_MSS; /**< Default MSS value */
-    int32_t default_RTT;  /**< Default Round Trip Time */
-    struct pcb_hd tcp_hd; /**< PCB header information */
+    uint16_t default_MSS;        /**< Default MSS value */
+    int32_t default_RTT;         /**< Default Round Trip Time */
+    struct pcb_hd tcp_hd;        /**< PCB header information */
+    const struct tcp_cc_ops *cc; /**< Default congestion control of new connections */
+    struct tcp_timer_wheel tw;   /**< Timer wheel of all TCB timers */
 };
 
 /**
@@ -538,6 +569,14 @@ typedef struct tcp_stats {
     uint64_t S_tcp_rexmit;     /**< TCP retransmission count */
     uint64_t S_resets_sent;    /**< TCP resets count */
     uint64_t S_tcp_connect;    /**< TCP connections count */
+    uint64_t S_sack_rexmit;    /**< TCP SACK recovery retransmission count */
+    uint64_t S_rack_lost;      /**< TCP RACK loss detection count */
+    uint64_t S_tlp_probes;     /**< TCP tail loss probe count */
+    uint64_t S_dsack_rcvd;     /**< TCP D-SACK received count */
+    uint64_t S_gso_sends;      /**< TCP GSO super-segments sent count */
+    uint64_t S_gso_frames;     /**< TCP frames created by GSO count */
+    uint64_t S_gro_merged;     /**< TCP segments merged by GRO count */
+    uint64_t S_paced;          /**< TCP sends deferred by the pacer count */
 } tcp_stats_t;
 
 #define INC_TCP_STAT(x)               \
@@ -561,12 +600,69 @@ tcp_range_set(int val, int tvmin, int tvmax)
     return (uint16_t)((val < tvmin) ? tvmin : (val > tvmax) ? tvmax : val);
 }
 
+/**
+ * Test if a TCB timer is running.
+ */
+static inline bool
+tcp_timer_active(struct tcb_entry *tcb, int tmr)
+{
+    return cnet_tcp_timer_pending(&tcb->timers[tmr]);
+}
+
 static inline void
-tcb_kill_timers(struct tcb_entry *tcb)
+tcp_timer_stop(struct tcb_entry *tcb, int tmr)
+{
+    cnet_tcp_timer_cancel(&tcb->timers[tmr]);
+}
+
+/**
+ * Start a TCB timer on the timer wheel of the stack, a running timer is restarted.
+ *
+ * @param tcb
+ *   The TCB owning the timer.
+ * @param tmr
+ *   The timer index, TCPT_REXMT, TCPT_PERSIST, ...
+ * @param ticks
+ *   Number of timer wheel ticks of MS_PER_TICK, the timer is stopped if <= 0.
+ */
+static inline void
+tcp_timer_start(struct tcb_entry *tcb, int tmr, int64_t ticks)
+{
+    struct tcp_timer_entry *tim = &tcb->timers[tmr];
+
+    if (ticks <= 0) {
+        cnet_tcp_timer_cancel(tim);
+        return;
+    }
+
+    tim->arg = tcb;
+    tim->idx = tmr;
+    cnet_tcp_timer_arm(&this_stk->tcp->tw, tim, ticks);
+}
+
+/**
+ * Start a TCB timer with a value in 500ms slow timeout ticks, a value of zero stops it.
+ */
+static inline void
+tcp_timer_set(struct tcb_entry *tcb, int tmr, int32_t val)
+{
+    tcp_timer_start(tcb, tmr, (int64_t)val * TCP_SLOW_TICKS);
+}
+
+/**
+ * Number of slow timeout ticks since the TCB last received a segment.
+ */
+static inline uint32_t
+tcp_idle(struct tcb_entry *tcb)
 {
-    uint64_t *p = (uint64_t *)(uintptr_t)tcb->timers;
+    return stk_get_timer_ticks() - tcb->idle_ts;
+}
 
-    p[0] = 0;
+static inline void
+tcb_kill_timers(struct tcb_entry *tcb)
+{
+    for (int i = 0; i < TCP_NTIMERS; i++)
+        cnet_tcp_timer_cancel(&tcb->timers[i]);
 }
 
 /**
@@ -602,6 +698,8 @@ tcb_free(struct tcb_entry *tcb)
     stk_t *stk = this_stk;
 
     if (tcb) {
+        tcb_kill_timers(tcb); /* Never leave a timer of a free TCB on the wheel */
+
         if (stk_lock()) {
             int idx = mempool_obj_index(stk->tcb_objs, tcb);
 
@@ -713,6 +811,43 @@ CNDP_API int cnet_tcp_close(struct pcb_entry *pcb);
  */
 void *tcp_q_pop(struct tcp_q *tq);
 
+/**
+ * Refill the pacer token bucket of the connection
+ * @internal
+ *
+ * @param tcb
+ *   The TCB of the paced connection.
+ * @param now
+ *   Current cycles.
+ * @return
+ *   The number of bytes the connection can send now.
+ */
+uint32_t tcp_pace_budget(struct tcb_entry *tcb, uint64_t now);
+
+/**
+ * Defer a paced send until the token bucket holds enough bytes
+ * @internal
+ *
+ * @param tcb
+ *   The TCB of the paced connection, tcp_pace_budget() was called at now.
+ * @param len
+ *   Number of bytes to send, larger than the tokens of the connection.
+ * @param now
+ *   Current cycles.
+ */
+void tcp_pace_defer(struct tcb_entry *tcb, uint32_t len, uint64_t now);
+
+/**
+ * The pacer timer callback, sends for the connections whose deferred send is due
+ * @internal
+ *
+ * @param tim
+ *   The tcp_pace_timer of the stack instance.
+ * @param arg
+ *   The stack instance.
+ */
+void tcp_pace_timo(struct cne_timer *tim, void *arg);
+
 /**
  * Dump out the TCP header and information
  *
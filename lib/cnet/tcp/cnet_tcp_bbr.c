@@ -0,0 +1,308 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright (c) 2023 Intel Corporation
+ */
+
+/*
+ * BBR congestion control, version 1.
+ *
+ * BBR builds a model of the path from the maximum delivery rate (BtlBw) seen over the last
+ * ten rounds and the minimum RTT seen over the last ten seconds. The pacing rate is the
+ * bottleneck bandwidth times a gain and the congestion window is a multiple of the
+ * bandwidth delay product, losses do not reduce the model.
+ *
+ * STARTUP doubles the sending rate each round until the bandwidth stops growing, DRAIN
+ * empties the queue created by STARTUP, PROBE_BW cycles the pacing gain to probe for more
+ * bandwidth and PROBE_RTT reduces the window every ten seconds to refresh the minimum RTT.
+ */
+
+#include <stdint.h>              // for uint32_t, uint64_t
+#include <cne_cycles.h>          // for cne_get_timer_hz
+#include <cnet_tcp.h>            // for tcb_entry
+
+#include "cnet_tcp_cc.h"
+#include "cne_common.h"        // for CNE_MIN, CNE_MAX, CNE_BUILD_BUG_ON
+
+#define BBR_SCALE          8
+#define BBR_UNIT           (1 << BBR_SCALE)
+#define BBR_HIGH_GAIN      ((BBR_UNIT * 2885) / 1000 + 1) /**< 2/ln(2) */
+#define BBR_DRAIN_GAIN     ((BBR_UNIT * 1000) / 2885)     /**< 1/high_gain */
+#define BBR_CWND_GAIN      (BBR_UNIT * 2)                 /**< cwnd gain in PROBE_BW */
+#define BBR_BW_ROUNDS      10                             /**< Rounds of the BtlBw max filter */
+#define BBR_CYCLE_LEN      8                              /**< Phases of the PROBE_BW cycle */
+#define BBR_MIN_RTT_SEC    10                             /**< Window of the min RTT filter */
+#define BBR_PROBE_RTT_MS   200                            /**< Time to stay in PROBE_RTT */
+#define BBR_MIN_CWND_SEGS  4                              /**< cwnd in segments in PROBE_RTT */
+#define BBR_FULL_BW_THRESH ((BBR_UNIT * 5) / 4)           /**< BW growth to stay in STARTUP */
+#define BBR_FULL_BW_CNT    3                              /**< Rounds without growth to leave */
+
+enum { BBR_STARTUP, BBR_DRAIN, BBR_PROBE_BW, BBR_PROBE_RTT };
+
+static const uint32_t bbr_pacing_gain[BBR_CYCLE_LEN] = {
+    BBR_UNIT * 5 / 4, BBR_UNIT * 3 / 4, BBR_UNIT, BBR_UNIT,
+    BBR_UNIT,         BBR_UNIT,         BBR_UNIT, BBR_UNIT,
+};
+
+struct bbr {
+    uint64_t bw[BBR_BW_ROUNDS];  /**< Max delivery rate of the last rounds in bytes/sec */
+    uint64_t min_rtt;            /**< Minimum RTT in cycles */
+    uint64_t min_rtt_ts;         /**< Cycles when min_rtt was set */
+    uint64_t cycle_ts;           /**< Cycles when the PROBE_BW phase started */
+    uint64_t probe_rtt_done_ts;  /**< Cycles when PROBE_RTT can end, zero not started */
+    uint64_t full_bw;            /**< BtlBw when the last growth was seen */
+    uint32_t round_cnt;          /**< Number of rounds */
+    uint32_t probe_rtt_round;    /**< Round when PROBE_RTT can end */
+    uint32_t prior_cwnd;         /**< cwnd before PROBE_RTT, recovery or a timeout */
+    uint32_t pacing_gain;        /**< Current pacing gain in BBR_UNIT */
+    uint32_t cwnd_gain;          /**< Current cwnd gain in BBR_UNIT */
+    uint8_t mode;                /**< BBR_XXX state */
+    uint8_t cycle_idx;           /**< Phase of the PROBE_BW cycle */
+    uint8_t full_bw_cnt;         /**< Rounds without BtlBw growth */
+    bool full_bw_reached;        /**< STARTUP filled the pipe */
+    bool in_recovery;            /**< Packet conservation is active */
+    bool min_rtt_expired;        /**< min_rtt was not seen for BBR_MIN_RTT_SEC */
+};
+
+static inline struct bbr *
+bbr_priv(struct tcb_entry *tcb)
+{
+    return (struct bbr *)tcb->cc_priv;
+}
+
+static inline uint64_t
+bbr_btl_bw(struct bbr *b)
+{
+    uint64_t bw = 0;
+
+    for (int i = 0; i < BBR_BW_ROUNDS; i++)
+        bw = CNE_MAX(bw, b->bw[i]);
+    return bw;
+}
+
+/* Bandwidth delay product times gain in bytes */
+static uint32_t
+bbr_target_cwnd(struct tcb_entry *tcb, struct bbr *b, uint32_t gain)
+{
+    uint64_t bw = bbr_btl_bw(b);
+    uint64_t bdp;
+
+    /* No samples yet, use the initial window */
+    if (bw == 0 || b->min_rtt == 0)
+        return tcb->snd_cwnd;
+
+    bdp = (uint64_t)((double)bw * b->min_rtt / cne_get_timer_hz());
+    bdp = ((bdp * gain) >> BBR_SCALE) + 3 * tcb->max_mss; /* Allow for delayed ACKs */
+
+    return (uint32_t)CNE_MIN(bdp, (uint64_t)cnet_tcp_cc_max_cwnd(tcb));
+}
+
+static void
+bbr_enter_startup(struct bbr *b)
+{
+    b->mode        = BBR_STARTUP;
+    b->pacing_gain = BBR_HIGH_GAIN;
+    b->cwnd_gain   = BBR_HIGH_GAIN;
+}
+
+static void
+bbr_enter_probe_bw(struct bbr *b, uint64_t now)
+{
+    b->mode        = BBR_PROBE_BW;
+    b->cwnd_gain   = BBR_CWND_GAIN;
+    b->cycle_idx   = (uint8_t)(now % (BBR_CYCLE_LEN - 1));
+    b->cycle_idx   = (b->cycle_idx >= 1) ? b->cycle_idx + 1 : 0; /* Never start draining */
+    b->pacing_gain = bbr_pacing_gain[b->cycle_idx];
+    b->cycle_ts    = now;
+}
+
+static void
+bbr_init(struct tcb_entry *tcb)
+{
+    struct bbr *b = bbr_priv(tcb);
+
+    CNE_BUILD_BUG_ON(sizeof(struct bbr) > sizeof(tcb->cc_priv));
+
+    bbr_enter_startup(b);
+}
+
+static void
+bbr_update_model(struct bbr *b, const struct tcp_cc_sample *rs)
+{
+    uint64_t hz = cne_get_timer_hz();
+    uint64_t bw;
+
+    if (!rs->round_start)
+        return;
+
+    b->round_cnt++;
+
+    /* An application limited sample only counts when it raises the estimate */
+    bw = bbr_btl_bw(b);
+    b->bw[b->round_cnt % BBR_BW_ROUNDS] = 0;
+    if (rs->bw && (!rs->app_limited || rs->bw >= bw))
+        b->bw[b->round_cnt % BBR_BW_ROUNDS] = rs->bw;
+
+    b->min_rtt_expired = b->min_rtt && (rs->now - b->min_rtt_ts) > BBR_MIN_RTT_SEC * hz;
+    if (rs->rtt && (b->min_rtt == 0 || rs->rtt <= b->min_rtt || b->min_rtt_expired)) {
+        b->min_rtt    = rs->rtt;
+        b->min_rtt_ts = rs->now;
+    }
+
+    /* STARTUP ends after three rounds without 25% bandwidth growth */
+    if (!b->full_bw_reached && !rs->app_limited) {
+        bw = bbr_btl_bw(b);
+        if (bw >= ((b->full_bw * BBR_FULL_BW_THRESH) >> BBR_SCALE)) {
+            b->full_bw     = bw;
+            b->full_bw_cnt = 0;
+        } else if (++b->full_bw_cnt >= BBR_FULL_BW_CNT)
+            b->full_bw_reached = true;
+    }
+}
+
+static void
+bbr_update_mode(struct tcb_entry *tcb, struct bbr *b, const struct tcp_cc_sample *rs)
+{
+    uint64_t hz = cne_get_timer_hz();
+
+    if (b->mode == BBR_STARTUP && b->full_bw_reached) {
+        b->mode        = BBR_DRAIN;
+        b->pacing_gain = BBR_DRAIN_GAIN;
+        b->cwnd_gain   = BBR_HIGH_GAIN;
+    }
+
+    if (b->mode == BBR_DRAIN && rs->inflight <= bbr_target_cwnd(tcb, b, BBR_UNIT))
+        bbr_enter_probe_bw(b, rs->now);
+
+    /* Each phase of the gain cycle lasts about one min_rtt */
+    if (b->mode == BBR_PROBE_BW && b->min_rtt && (rs->now - b->cycle_ts) > b->min_rtt) {
+        b->cycle_idx   = (b->cycle_idx + 1) % BBR_CYCLE_LEN;
+        b->pacing_gain = bbr_pacing_gain[b->cycle_idx];
+        b->cycle_ts    = rs->now;
+    }
+
+    /* Refresh min_rtt when it was not seen for BBR_MIN_RTT_SEC */
+    if (b->mode != BBR_PROBE_RTT && b->min_rtt_expired) {
+        b->min_rtt_expired   = false;
+        b->mode              = BBR_PROBE_RTT;
+        b->pacing_gain       = BBR_UNIT;
+        b->cwnd_gain         = BBR_UNIT;
+        b->prior_cwnd        = CNE_MAX(b->prior_cwnd, tcb->snd_cwnd);
+        b->probe_rtt_done_ts = 0;
+    }
+
+    if (b->mode == BBR_PROBE_RTT) {
+        uint32_t min_cwnd = BBR_MIN_CWND_SEGS * tcb->max_mss;
+
+        if (b->probe_rtt_done_ts == 0 && rs->inflight <= min_cwnd) {
+            b->probe_rtt_done_ts = rs->now + (BBR_PROBE_RTT_MS * hz) / 1000;
+            b->probe_rtt_round   = b->round_cnt + 1;
+        } else if (b->probe_rtt_done_ts && rs->now > b->probe_rtt_done_ts &&
+                   b->round_cnt >= b->probe_rtt_round) {
+            b->min_rtt_ts = rs->now;
+            tcb->snd_cwnd = CNE_MAX(tcb->snd_cwnd, b->prior_cwnd);
+            b->prior_cwnd = 0;
+            if (b->full_bw_reached)
+                bbr_enter_probe_bw(b, rs->now);
+            else
+                bbr_enter_startup(b);
+        }
+    }
+}
+
+static void
+bbr_ack(struct tcb_entry *tcb, const struct tcp_cc_sample *rs)
+{
+    struct bbr *b     = bbr_priv(tcb);
+    uint32_t min_cwnd = BBR_MIN_CWND_SEGS * tcb->max_mss;
+    uint32_t cwnd, target;
+
+    bbr_update_model(b, rs);
+    bbr_update_mode(tcb, b, rs);
+
+    /* Leaving PROBE_RTT restores snd_cwnd in bbr_update_mode() */
+    cwnd = tcb->snd_cwnd;
+
+    /* Packet conservation during loss recovery, restore the window when done */
+    if (rs->in_recovery) {
+        if (!b->in_recovery) {
+            b->in_recovery = true;
+            b->prior_cwnd  = CNE_MAX(b->prior_cwnd, cwnd);
+            cwnd           = rs->inflight + rs->acked;
+        } else
+            cwnd = CNE_MAX(cwnd, rs->inflight + rs->acked);
+    } else if (b->in_recovery) {
+        b->in_recovery = false;
+        cwnd           = CNE_MAX(cwnd, b->prior_cwnd);
+        b->prior_cwnd  = 0;
+    }
+
+    target = bbr_target_cwnd(tcb, b, b->cwnd_gain);
+    if (b->full_bw_reached)
+        cwnd = CNE_MIN(cwnd + rs->acked, target);
+    else if (cwnd < target || rs->inflight + rs->acked >= cwnd)
+        cwnd += rs->acked;
+
+    cwnd = CNE_MAX(cwnd, min_cwnd);
+    if (b->mode == BBR_PROBE_RTT)
+        cwnd = CNE_MIN(cwnd, min_cwnd);
+
+    tcb->snd_cwnd = CNE_MIN(cwnd, cnet_tcp_cc_max_cwnd(tcb));
+}
+
+/* BBR does not use ssthresh, the window is set by packet conservation in the ack hook */
+static uint32_t
+bbr_loss(struct tcb_entry *tcb)
+{
+    return tcb->snd_cwnd;
+}
+
+static void
+bbr_rto(struct tcb_entry *tcb)
+{
+    struct bbr *b = bbr_priv(tcb);
+
+    b->prior_cwnd     = CNE_MAX(b->prior_cwnd, tcb->snd_cwnd);
+    b->in_recovery    = true;
+    tcb->snd_ssthresh = tcb->snd_cwnd;
+    tcb->snd_cwnd     = tcb->max_mss;
+}
+
+/* After an idle period pace at the estimated rate, the window is kept */
+static void
+bbr_restart(struct tcb_entry *tcb)
+{
+    struct bbr *b = bbr_priv(tcb);
+
+    if (b->mode == BBR_PROBE_BW)
+        b->pacing_gain = BBR_UNIT;
+}
+
+static uint64_t
+bbr_pacing_rate(struct tcb_entry *tcb)
+{
+    struct bbr *b = bbr_priv(tcb);
+    uint64_t bw   = bbr_btl_bw(b);
+
+    /* Before the first sample pace the initial window over the RTT */
+    if (bw == 0) {
+        if (b->min_rtt == 0)
+            return 0;
+        bw = (uint64_t)((double)tcb->snd_cwnd * cne_get_timer_hz() / b->min_rtt);
+    }
+
+    return (bw * b->pacing_gain) >> BBR_SCALE;
+}
+
+static const struct tcp_cc_ops bbr_ops = {
+    .name        = "bbr",
+    .init        = bbr_init,
+    .ack         = bbr_ack,
+    .loss        = bbr_loss,
+    .rto         = bbr_rto,
+    .restart     = bbr_restart,
+    .pacing_rate = bbr_pacing_rate,
+};
+
+CNE_INIT_PRIO(cnet_tcp_cc_bbr_constructor, STACK)
+{
+    cnet_tcp_cc_register(&bbr_ops);
+}
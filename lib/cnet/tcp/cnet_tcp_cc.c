@@ -0,0 +1,269 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright (c) 2023 Intel Corporation
+ */
+
+#include <stdint.h>              // for uint32_t, uint64_t
+#include <string.h>              // for strncmp, memset
+#include <cne_cycles.h>          // for cne_get_timer_hz
+#include <cne_log.h>             // for CNE_ERR_RET
+#include <cnet_const.h>          // for is_set
+#include <cnet_stk.h>            // for this_stk
+#include <cnet_tcp.h>            // for tcb_entry, tcp_entry, seqGEQ, TCP_MAXWIN
+
+#include "cnet_tcp_cc.h"
+#include "cne_common.h"        // for CNE_MIN, CNE_MAX, CNE_INIT_PRIO
+
+static const struct tcp_cc_ops *cc_ops[TCP_CC_MAX_OPS];
+static int cc_nb_ops;
+
+int
+cnet_tcp_cc_register(const struct tcp_cc_ops *ops)
+{
+    if (!ops || !ops->ack || !ops->loss || !ops->rto || ops->name[0] == '\0')
+        CNE_ERR_RET("Congestion control ops are invalid\n");
+
+    if (cnet_tcp_cc_find(ops->name))
+        CNE_ERR_RET("Congestion control %s is already registered\n", ops->name);
+
+    if (cc_nb_ops >= TCP_CC_MAX_OPS)
+        CNE_ERR_RET("Too many congestion control modules\n");
+
+    cc_ops[cc_nb_ops++] = ops;
+
+    return 0;
+}
+
+const struct tcp_cc_ops *
+cnet_tcp_cc_find(const char *name)
+{
+    if (!name)
+        return NULL;
+
+    for (int i = 0; i < cc_nb_ops; i++)
+        if (!strncmp(cc_ops[i]->name, name, TCP_CC_NAME_MAX))
+            return cc_ops[i];
+
+    return NULL;
+}
+
+int
+cnet_tcp_cc_default_set(const char *name)
+{
+    stk_t *stk = this_stk;
+    const struct tcp_cc_ops *ops;
+
+    if (!stk || !stk->tcp)
+        CNE_ERR_RET("TCP is not initialized\n");
+
+    if ((ops = cnet_tcp_cc_find(name)) == NULL)
+        CNE_ERR_RET("Congestion control %s not found\n", name ? name : "(null)");
+
+    stk->tcp->cc = ops;
+
+    return 0;
+}
+
+void
+cnet_tcp_cc_release(struct tcb_entry *tcb)
+{
+    if (tcb->cc && tcb->cc->release)
+        tcb->cc->release(tcb);
+    tcb->cc = NULL;
+}
+
+void
+cnet_tcp_cc_set(struct tcb_entry *tcb, const struct tcp_cc_ops *ops)
+{
+    stk_t *stk = this_stk;
+
+    if (!ops)
+        ops = (stk && stk->tcp && stk->tcp->cc) ? stk->tcp->cc : cnet_tcp_cc_find(TCP_CC_DEFAULT);
+
+    cnet_tcp_cc_release(tcb);
+
+    memset(&tcb->cc_rs, 0, sizeof(tcb->cc_rs));
+    memset(tcb->cc_priv, 0, sizeof(tcb->cc_priv));
+    tcb->pacing_rate = 0;
+
+    tcb->cc = ops;
+    if (ops && ops->init)
+        ops->init(tcb);
+}
+
+void
+cnet_tcp_cc_sent(struct tcb_entry *tcb, uint32_t end_seq, bool app_limited, uint64_t now)
+{
+    struct tcp_cc_rs *rs = &tcb->cc_rs;
+
+    if (rs->round_ts == 0) {
+        rs->round_ts    = now;
+        rs->round_seq   = end_seq;
+        rs->delivered   = 0;
+        rs->app_limited = false;
+    }
+    rs->app_limited |= app_limited;
+}
+
+/*
+ * A round ends when the segment which started it is acknowledged, the time it took is a
+ * round trip sample and the data acknowledged meanwhile over that time is the delivery rate.
+ */
+void
+cnet_tcp_cc_ack(struct tcb_entry *tcb, uint32_t acked, uint64_t now)
+{
+    struct tcp_cc_rs *rs   = &tcb->cc_rs;
+    struct tcp_cc_sample s = {0};
+
+    if (!tcb->cc)
+        return;
+
+    s.now         = now;
+    s.acked       = acked;
+    s.inflight    = tcb->snd_max - tcb->snd_una;
+    s.in_recovery = is_set(tcb->tflags, TCBF_IN_RECOVERY);
+
+    rs->delivered += acked;
+    if (rs->round_ts && seqGEQ(tcb->snd_una, rs->round_seq)) {
+        uint64_t dt = now - rs->round_ts;
+
+        s.round_start = true;
+        s.app_limited = rs->app_limited;
+        s.rtt         = dt;
+        if (dt)
+            s.bw = (uint64_t)((double)rs->delivered * cne_get_timer_hz() / dt);
+
+        rs->round_ts = 0;
+    }
+
+    tcb->cc->ack(tcb, &s);
+
+    if (tcb->cc->pacing_rate)
+        tcb->pacing_rate = tcb->cc->pacing_rate(tcb);
+}
+
+void
+cnet_tcp_cc_loss(struct tcb_entry *tcb)
+{
+    if (tcb->cc)
+        tcb->snd_ssthresh = tcb->cc->loss(tcb);
+}
+
+void
+cnet_tcp_cc_rto(struct tcb_entry *tcb)
+{
+    /* The round in progress includes the timeout, it is not a valid sample */
+    tcb->cc_rs.round_ts = 0;
+
+    if (tcb->cc)
+        tcb->cc->rto(tcb);
+}
+
+void
+cnet_tcp_cc_restart(struct tcb_entry *tcb)
+{
+    tcb->cc_rs.round_ts = 0;
+
+    if (tcb->cc && tcb->cc->restart)
+        tcb->cc->restart(tcb);
+}
+
+uint32_t
+cnet_tcp_cc_reno_ssthresh(struct tcb_entry *tcb)
+{
+    uint32_t flight = tcb->snd_max - tcb->snd_una;
+
+    return CNE_MAX(flight / 2, (uint32_t)(2 * tcb->max_mss));
+}
+
+uint32_t
+cnet_tcp_cc_restart_wnd(struct tcb_entry *tcb)
+{
+    uint32_t iw = CNE_MIN((4 * tcb->max_mss), CNE_MAX((2 * tcb->max_mss), TCP_INITIAL_CWND));
+
+    return CNE_MIN(iw, tcb->snd_cwnd);
+}
+
+uint32_t
+cnet_tcp_cc_max_cwnd(struct tcb_entry *tcb)
+{
+    return TCP_MAXWIN << tcb->snd_scale;
+}
+
+/*
+ * RFC5681: pg 5
+ * During slow start, a TCP increments cwnd by at most SMSS bytes for
+ * each ACK received that acknowledges new data. Slow start ends when
+ * cwnd exceeds ssthresh (or, optionally, when it reaches it, as noted
+ * above) or when congestion is observed.
+ *
+ * During congestion avoidance, cwnd is incremented by 1 full-sized
+ * segment per round-trip time (RTT). Congestion avoidance continues
+ * until congestion is detected. One formula commonly used to update
+ * cwnd during congestion avoidance is given in equation 3:
+ *       cwnd += SMSS*SMSS/cwnd (3)
+ */
+static void
+reno_ack(struct tcb_entry *tcb, const struct tcp_cc_sample *rs)
+{
+    uint32_t cwnd = tcb->snd_cwnd;
+    uint32_t incr = tcb->max_mss;
+
+    /* The window is held at ssthresh until SACK loss recovery is done */
+    if (rs->in_recovery)
+        return;
+
+    /* When cwnd is <= to ssthresh, we are in slow-start else congestion avoidance. */
+    if (cwnd > tcb->snd_ssthresh)
+        incr = incr * incr / cwnd;
+
+    tcb->snd_cwnd = CNE_MIN(cwnd + incr, cnet_tcp_cc_max_cwnd(tcb));
+}
+
+static uint32_t
+reno_loss(struct tcb_entry *tcb)
+{
+    return cnet_tcp_cc_reno_ssthresh(tcb);
+}
+
+/*
+ * RFC5681: pg 8
+ * When a TCP sender detects segment loss using the retransmission timer,
+ * ssthresh is set to half the window but at least 2*SMSS and cwnd to one
+ * segment, the loss window.
+ */
+static void
+reno_rto(struct tcb_entry *tcb)
+{
+    uint32_t win = CNE_MIN(tcb->snd_wnd, tcb->snd_cwnd) / 2 / tcb->max_mss;
+
+    if (win < 2)
+        win = 2;
+
+    tcb->snd_cwnd     = tcb->max_mss;
+    tcb->snd_ssthresh = win * tcb->max_mss;
+}
+
+/*
+ * RFC5681: pg 11
+ * When TCP has not received a segment for more than one retransmission
+ * timeout, cwnd is reduced to the value of the restart window (RW) before
+ * transmission begins.
+ */
+static void
+reno_restart(struct tcb_entry *tcb)
+{
+    tcb->snd_cwnd = cnet_tcp_cc_restart_wnd(tcb);
+}
+
+static const struct tcp_cc_ops reno_ops = {
+    .name    = "reno",
+    .ack     = reno_ack,
+    .loss    = reno_loss,
+    .rto     = reno_rto,
+    .restart = reno_restart,
+};
+
+CNE_INIT_PRIO(cnet_tcp_cc_reno_constructor, STACK)
+{
+    cnet_tcp_cc_register(&reno_ops);
+}
@@ -0,0 +1,215 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright (c) 2023 Intel Corporation
+ */
+
+#ifndef __CNET_TCP_CC_H
+#define __CNET_TCP_CC_H
+
+/**
+ * @file
+ * CNET TCP pluggable congestion control.
+ *
+ * A congestion control module is a table of hooks called by the TCP code when new data is
+ * acknowledged, when a loss is detected, on a retransmission timeout and when the
+ * connection restarts after an idle period. The module owns snd_cwnd and snd_ssthresh and
+ * can return a pacing rate for the connection.
+ *
+ * The modules "reno", "cubic" (RFC 8312) and "bbr" (BBRv1) are registered at startup. The
+ * stack default is set with cnet_tcp_cc_default_set() and a channel selects its module
+ * with the TCP_CONGESTION channel option.
+ */
+
+#include <stdint.h>         // for uint32_t, uint64_t
+#include <stdbool.h>        // for bool
+#include <cne_common.h>     // for CNDP_API
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define TCP_CC_NAME_MAX 16     /**< Max length of a module name including the null */
+#define TCP_CC_MAX_OPS  8      /**< Max number of registered modules */
+#define TCP_CC_PRIV_U64 32     /**< Number of uint64_t words of private state per connection */
+#define TCP_CC_DEFAULT  "reno" /**< Name of the default module */
+
+struct tcb_entry;
+
+/* Round trip and delivery rate sampler shared by all modules */
+struct tcp_cc_rs {
+    uint64_t round_ts;  /**< Cycles when the first segment of the round was sent, zero if idle */
+    uint32_t round_seq; /**< The round ends when this sequence number is acknowledged */
+    uint32_t delivered; /**< Bytes acknowledged in the current round */
+    bool app_limited;   /**< The sender ran out of data in the current round */
+};
+
+/* Information on the ACK passed to the ack hook */
+struct tcp_cc_sample {
+    uint64_t now;      /**< Current cycles */
+    uint64_t rtt;      /**< Round trip time sample in cycles, zero when not available */
+    uint64_t bw;       /**< Delivery rate sample in bytes per second, zero when not available */
+    uint32_t acked;    /**< Bytes newly acknowledged by the ACK */
+    uint32_t inflight; /**< Bytes in flight after the ACK */
+    bool round_start;  /**< The ACK ended a round trip, rtt and bw are valid */
+    bool app_limited;  /**< The round was limited by the application not the network */
+    bool in_recovery;  /**< Loss recovery is in progress */
+};
+
+struct tcp_cc_ops {
+    char name[TCP_CC_NAME_MAX]; /**< Name of the module */
+
+    /** Initialize the private state of a connection, can be NULL */
+    void (*init)(struct tcb_entry *tcb);
+
+    /** Release the private state of a connection, can be NULL */
+    void (*release)(struct tcb_entry *tcb);
+
+    /** New data was acknowledged, update the congestion window */
+    void (*ack)(struct tcb_entry *tcb, const struct tcp_cc_sample *rs);
+
+    /** A loss was detected by dupacks, SACK or RACK, return the new snd_ssthresh */
+    uint32_t (*loss)(struct tcb_entry *tcb);
+
+    /** The retransmission timer expired, set snd_cwnd and snd_ssthresh */
+    void (*rto)(struct tcb_entry *tcb);
+
+    /** The connection is sending again after an idle period, can be NULL */
+    void (*restart)(struct tcb_entry *tcb);
+
+    /** Return the pacing rate in bytes per second or zero for no pacing, can be NULL */
+    uint64_t (*pacing_rate)(struct tcb_entry *tcb);
+};
+
+/**
+ * Register a congestion control module, normally called from a constructor.
+ *
+ * @param ops
+ *   Pointer to the module operations, must stay valid for the life of the process.
+ * @return
+ *   0 on success or -1 on error.
+ */
+CNDP_API int cnet_tcp_cc_register(const struct tcp_cc_ops *ops);
+
+/**
+ * Find a congestion control module by name.
+ *
+ * @param name
+ *   The name of the module.
+ * @return
+ *   Pointer to the module operations or NULL if not found.
+ */
+CNDP_API const struct tcp_cc_ops *cnet_tcp_cc_find(const char *name);
+
+/**
+ * Set the congestion control module used by new connections of this stack instance.
+ *
+ * @param name
+ *   The name of the module.
+ * @return
+ *   0 on success or -1 on error.
+ */
+CNDP_API int cnet_tcp_cc_default_set(const char *name);
+
+/**
+ * Attach a congestion control module to a connection, releasing the current one.
+ *
+ * @param tcb
+ *   Pointer to the TCB.
+ * @param ops
+ *   The module operations, NULL selects the stack default.
+ */
+void cnet_tcp_cc_set(struct tcb_entry *tcb, const struct tcp_cc_ops *ops);
+
+/**
+ * Detach the congestion control module from a connection.
+ *
+ * @param tcb
+ *   Pointer to the TCB.
+ */
+void cnet_tcp_cc_release(struct tcb_entry *tcb);
+
+/**
+ * Record new data sent, the first segment sent while idle starts a round trip sample.
+ *
+ * @param tcb
+ *   Pointer to the TCB.
+ * @param end_seq
+ *   Sequence number following the data sent.
+ * @param app_limited
+ *   True when the send buffer has no more data to send.
+ * @param now
+ *   Current cycles.
+ */
+void cnet_tcp_cc_sent(struct tcb_entry *tcb, uint32_t end_seq, bool app_limited, uint64_t now);
+
+/**
+ * Process newly acknowledged data, updates the round trip and delivery rate samples and
+ * calls the ack hook of the module.
+ *
+ * @param tcb
+ *   Pointer to the TCB, snd_una already includes the ACK.
+ * @param acked
+ *   Number of bytes newly acknowledged.
+ * @param now
+ *   Current cycles.
+ */
+void cnet_tcp_cc_ack(struct tcb_entry *tcb, uint32_t acked, uint64_t now);
+
+/**
+ * A loss was detected, set snd_ssthresh from the loss hook of the module.
+ *
+ * @param tcb
+ *   Pointer to the TCB.
+ */
+void cnet_tcp_cc_loss(struct tcb_entry *tcb);
+
+/**
+ * The retransmission timer expired, call the rto hook of the module.
+ *
+ * @param tcb
+ *   Pointer to the TCB.
+ */
+void cnet_tcp_cc_rto(struct tcb_entry *tcb);
+
+/**
+ * The connection was idle for more than one retransmission timeout, call the restart hook.
+ *
+ * @param tcb
+ *   Pointer to the TCB.
+ */
+void cnet_tcp_cc_restart(struct tcb_entry *tcb);
+
+/**
+ * Return the NewReno slow start threshold after a loss, RFC 5681 max(FlightSize / 2, 2 * SMSS).
+ *
+ * @param tcb
+ *   Pointer to the TCB.
+ * @return
+ *   The slow start threshold in bytes.
+ */
+uint32_t cnet_tcp_cc_reno_ssthresh(struct tcb_entry *tcb);
+
+/**
+ * Return the restart window used after an idle period, RFC 5681 RW = min(IW, cwnd).
+ *
+ * @param tcb
+ *   Pointer to the TCB.
+ * @return
+ *   The restart window in bytes.
+ */
+uint32_t cnet_tcp_cc_restart_wnd(struct tcb_entry *tcb);
+
+/**
+ * Return the largest congestion window the connection can use.
+ *
+ * @param tcb
+ *   Pointer to the TCB.
+ * @return
+ *   The max congestion window in bytes.
+ */
+uint32_t cnet_tcp_cc_max_cwnd(struct tcb_entry *tcb);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __CNET_TCP_CC_H */
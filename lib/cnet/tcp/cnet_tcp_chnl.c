@@ -17,6 +17,7 @@
 #include <cnet_chnl.h>        // for chnl, chnl_buf, _ISCONNECTED
 #include <cnet_pcb.h>         // for pcb_entry, pcb_key, cnet_pcb_alloc, pcb_hd
 #include <cnet_tcp.h>         // for tcb_entry, tcp_entry, cnet_tcb_new, tcp_a...
+#include <cnet_tcp_cc.h>      // for cnet_tcp_cc_find, cnet_tcp_cc_set, TCP_CC_NAME_MAX
 #include <cnet_tcp_chnl.h>
 #include <cnet_chnl_opt.h>        // for cnet_chnl_opt_add, chnl_optval_get, chnl_...
 #include <errno.h>                // for ENOPROTOOPT, EINVAL, EFAULT, ENOBUFS, EIS...
@@ -37,16 +38,14 @@
 
 /*
  * Drop the acked data from the chnl queue and free any complete
- * packet structures.
+ * packet structures. The chnl buffers are only used on the thread of
+ * the stack instance, so no lock is taken.
  */
 void
 cnet_drop_acked_data(struct chnl_buf *cb, int32_t acked)
 {
     int idx, len, free_cnt = 0;
 
-    if (!stk_lock())
-        CNE_RET("Failed to acquire mutex\n");
-
     len = vec_len(cb->cb_vec);
 
     CNE_DEBUG("\n");
@@ -94,8 +93,6 @@ cnet_drop_acked_data(struct chnl_buf *cb, int32_t acked)
         vec_remove(cb->cb_vec, free_cnt);
     }
     CNE_DEBUG("<<< Data left to ack [orange]%d[] bytes\n", acked);
-
-    stk_unlock();
 }
 
 void
@@ -372,6 +369,60 @@ tcp_chnl_close(struct chnl *ch)
     return 0;
 }
 
+/*
+ * Select the congestion control of the channel by name, TCP_CONGESTION option.
+ */
+static int
+tcp_chnl_cc_set(struct chnl *ch, const void *optval, uint32_t optlen)
+{
+    char name[TCP_CC_NAME_MAX] = {0};
+    const struct tcp_cc_ops *cc;
+    struct tcb_entry *tcb;
+
+    if (!optval || optlen == 0)
+        return __errno_set(EINVAL);
+
+    memcpy(name, optval, CNE_MIN(optlen, sizeof(name) - 1));
+    if ((cc = cnet_tcp_cc_find(name)) == NULL)
+        return __errno_set(ENOENT);
+
+    /* The TCB is normally allocated by bind or connect, create it to hold the choice */
+    if ((tcb = cnet_tcb_new(ch->ch_pcb)) == NULL)
+        return __errno_set(ENOBUFS);
+
+    if (tcb->cc != cc)
+        cnet_tcp_cc_set(tcb, cc);
+
+    return 0;
+}
+
+/*
+ * Limit the pacing rate of the channel in bytes per second, SO_MAX_PACING_RATE option.
+ * The value is a 32 or 64 bit integer, zero removes the limit.
+ */
+static int
+tcp_chnl_pace_set(struct chnl *ch, const void *optval, uint32_t optlen)
+{
+    struct tcb_entry *tcb;
+    uint64_t rate;
+
+    if (!optval || optlen < sizeof(uint32_t))
+        return __errno_set(EINVAL);
+
+    if (optlen >= sizeof(uint64_t))
+        memcpy(&rate, optval, sizeof(rate));
+    else
+        rate = chnl_optval_get(optval, optlen);
+
+    /* The TCB is normally allocated by bind or connect, create it to hold the limit */
+    if ((tcb = cnet_tcb_new(ch->ch_pcb)) == NULL)
+        return __errno_set(ENOBUFS);
+
+    tcb->pace_max = rate;
+
+    return 0;
+}
+
 static int
 tcp_chnl_opt_set(struct chnl *ch, int level, int optname, const void *optval, uint32_t optlen)
 {
@@ -391,7 +442,13 @@ tcp_chnl_opt_set(struct chnl *ch, int level, int optname, const void *optval, ui
 
     switch (level) {
     case SO_CHANNEL:
-        return __errno_set(ENOPROTOOPT);
+        switch (optname) {
+        case SO_MAX_PACING_RATE:
+            return tcp_chnl_pace_set(ch, optval, optlen);
+        default:
+            return __errno_set(ENOPROTOOPT);
+        }
+        break;
 
     case SOL_TCP:
         switch (optname) {
@@ -404,6 +461,8 @@ tcp_chnl_opt_set(struct chnl *ch, int level, int optname, const void *optval, ui
         case TCBF_NOPUSH:
             setsockoptBit(ch->ch_pcb->opt_flag, TCP_NOPUSH_FLAG, val);
             break;
+        case TCP_CONGESTION:
+            return tcp_chnl_cc_set(ch, optval, optlen);
         default:
             return __errno_set(ENOPROTOOPT);
         }
@@ -423,6 +482,7 @@ tcp_chnl_opt_get(struct chnl *ch, int level, int optname, void *optval, uint32_t
     void *resP           = (void *)opt;
     int *resI            = (int *)opt;
     struct tcp_info tcpi = {0};
+    const struct tcp_cc_ops *cc;
     struct tcb_entry *tcb;
     uint32_t len;
 
@@ -438,6 +498,10 @@ tcp_chnl_opt_get(struct chnl *ch, int level, int optname, void *optval, uint32_t
             *resI = (int)((ch->ch_pcb->tcb != (struct tcb_entry *)NULL) &&
                           (ch->ch_pcb->tcb->state == TCPS_LISTEN));
             break;
+        case SO_MAX_PACING_RATE:
+            opt[0] = ch->ch_pcb->tcb ? ch->ch_pcb->tcb->pace_max : 0;
+            len    = CNE_MIN(*optlen, (uint32_t)sizeof(uint64_t));
+            break;
 
         default:
             return __errno_set(ENOPROTOOPT);
@@ -465,8 +529,12 @@ tcp_chnl_opt_get(struct chnl *ch, int level, int optname, void *optval, uint32_t
             *resI = ch->ch_pcb->opt_flag & TCP_NOPUSH_FLAG;
             break;
         case TCP_CONGESTION:
-            resP = (void *)(uintptr_t) "reno";
-            len  = 5;
+            tcb = ch->ch_pcb->tcb;
+            cc  = (tcb && tcb->cc) ? tcb->cc : this_stk->tcp->cc;
+            if (!cc)
+                return __errno_set(EINVAL);
+            resP = (void *)(uintptr_t)cc->name;
+            len  = CNE_MIN(*optlen, (uint32_t)strnlen(cc->name, TCP_CC_NAME_MAX) + 1);
             break;
         case TCP_INFO:
             resP = (void *)&tcpi;
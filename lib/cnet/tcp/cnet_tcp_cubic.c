@@ -0,0 +1,184 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright (c) 2023 Intel Corporation
+ */
+
+/*
+ * CUBIC congestion control, RFC 8312.
+ *
+ * The window grows as a cubic function of the time since the last reduction, centered on
+ * the window where the loss happened, so it recovers quickly on a long fat pipe and probes
+ * slowly around the last saturation point. The Reno friendly window estimate keeps it from
+ * being less aggressive than Reno on short RTT paths.
+ */
+
+#include <stdint.h>              // for uint32_t, uint64_t, int64_t
+#include <cne_cycles.h>          // for cne_get_timer_hz
+#include <cnet_tcp.h>            // for tcb_entry
+
+#include "cnet_tcp_cc.h"
+#include "cne_common.h"        // for CNE_MIN, CNE_MAX, CNE_BUILD_BUG_ON
+
+/* beta_cubic = 0.7, C = 0.4 and alpha_cubic = 3 * (1 - beta) / (1 + beta) = 9 / 17 */
+#define CUBIC_BETA_NUM  7
+#define CUBIC_BETA_DEN  10
+#define CUBIC_ALPHA_NUM 9
+#define CUBIC_ALPHA_DEN 17
+#define CUBIC_MAX_T_MS  (1 << 20) /**< Clamp of t - K in ms, keeps the cube in 64 bits */
+
+struct cubic {
+    uint64_t epoch_start; /**< Cycles when the congestion avoidance epoch started, zero none */
+    uint64_t min_rtt;     /**< Minimum RTT in cycles */
+    uint32_t w_max;       /**< Window in bytes before the last reduction */
+    uint32_t origin;      /**< Plateau of the cubic function in bytes */
+    uint32_t w_est;       /**< Reno friendly window estimate in bytes */
+    uint32_t k_ms;        /**< Time to reach the plateau in milli-seconds */
+};
+
+static inline struct cubic *
+cubic_priv(struct tcb_entry *tcb)
+{
+    return (struct cubic *)tcb->cc_priv;
+}
+
+/* Integer cube root, Hacker's Delight */
+static uint64_t
+cubic_root(uint64_t x)
+{
+    uint64_t y = 0;
+
+    for (int s = 63; s >= 0; s -= 3) {
+        uint64_t b;
+
+        y <<= 1;
+        b = 3 * y * (y + 1) + 1;
+        if ((x >> s) >= b) {
+            x -= b << s;
+            y++;
+        }
+    }
+    return y;
+}
+
+static void
+cubic_init(struct tcb_entry *tcb)
+{
+    CNE_BUILD_BUG_ON(sizeof(struct cubic) > sizeof(tcb->cc_priv));
+}
+
+/* Start a congestion avoidance epoch, RFC 8312 section 4.1 */
+static void
+cubic_epoch_start(struct tcb_entry *tcb, struct cubic *ca, uint64_t now)
+{
+    uint32_t cwnd = tcb->snd_cwnd;
+
+    ca->epoch_start = now;
+    ca->w_est       = cwnd;
+
+    if (cwnd < ca->w_max) {
+        /* K = cubic_root(W_max - cwnd) / C) in milli-seconds, C = 0.4 */
+        uint64_t segs = ((uint64_t)(ca->w_max - cwnd) * 1000) / tcb->max_mss;
+
+        ca->k_ms   = (uint32_t)cubic_root(segs * 2500000);
+        ca->origin = ca->w_max;
+    } else {
+        ca->k_ms   = 0;
+        ca->origin = cwnd;
+    }
+}
+
+static void
+cubic_ack(struct tcb_entry *tcb, const struct tcp_cc_sample *rs)
+{
+    struct cubic *ca = cubic_priv(tcb);
+    uint64_t cwnd    = tcb->snd_cwnd;
+    uint64_t mss     = tcb->max_mss;
+    uint64_t hz      = cne_get_timer_hz();
+    int64_t t, target;
+
+    if (rs->rtt && (ca->min_rtt == 0 || rs->rtt < ca->min_rtt))
+        ca->min_rtt = rs->rtt;
+
+    if (rs->in_recovery || rs->acked == 0)
+        return;
+
+    /* Slow start is the same as Reno */
+    if (cwnd <= tcb->snd_ssthresh) {
+        cwnd += CNE_MIN(rs->acked, (uint32_t)mss);
+        goto done;
+    }
+
+    if (ca->epoch_start == 0)
+        cubic_epoch_start(tcb, ca, rs->now);
+
+    /* W_cubic(t + RTT) = C * (t - K)^3 + W_max, equation 1 */
+    t = (int64_t)(((rs->now - ca->epoch_start) * 1000 + ca->min_rtt * 1000) / hz) - ca->k_ms;
+    t = CNE_MAX(CNE_MIN(t, (int64_t)CUBIC_MAX_T_MS), -(int64_t)CUBIC_MAX_T_MS);
+
+    target = (int64_t)ca->origin + ((4 * t * t * t) / 10000000) * (int64_t)mss / 1000;
+    if (target < 0)
+        target = 0;
+
+    /* W_est += alpha_cubic * acked / cwnd segments, equation 4 */
+    ca->w_est += (uint32_t)((CUBIC_ALPHA_NUM * rs->acked * mss) / (CUBIC_ALPHA_DEN * cwnd));
+    if (target < ca->w_est)
+        target = ca->w_est; /* Reno friendly region */
+
+    /* Never more than 1.5 * cwnd in one RTT, section 4.3 */
+    target = CNE_MIN(target, (int64_t)(cwnd + cwnd / 2));
+
+    if ((uint64_t)target > cwnd)
+        cwnd += ((target - cwnd) * rs->acked) / cwnd;
+    else
+        cwnd += (rs->acked * mss) / (100 * cwnd);
+
+done:
+    tcb->snd_cwnd = CNE_MIN(cwnd, (uint64_t)cnet_tcp_cc_max_cwnd(tcb));
+}
+
+/* Multiplicative decrease with fast convergence, RFC 8312 sections 4.5 and 4.6 */
+static uint32_t
+cubic_loss(struct tcb_entry *tcb)
+{
+    struct cubic *ca = cubic_priv(tcb);
+    uint32_t cwnd    = tcb->snd_cwnd;
+
+    ca->epoch_start = 0;
+    if (cwnd < ca->w_max)
+        ca->w_max = (uint32_t)(((uint64_t)cwnd * (CUBIC_BETA_DEN + CUBIC_BETA_NUM)) /
+                               (2 * CUBIC_BETA_DEN));
+    else
+        ca->w_max = cwnd;
+
+    return CNE_MAX((uint32_t)(((uint64_t)cwnd * CUBIC_BETA_NUM) / CUBIC_BETA_DEN),
+                   (uint32_t)(2 * tcb->max_mss));
+}
+
+/* Timeout, section 4.7 */
+static void
+cubic_rto(struct tcb_entry *tcb)
+{
+    tcb->snd_ssthresh = cubic_loss(tcb);
+    tcb->snd_cwnd     = tcb->max_mss;
+}
+
+static void
+cubic_restart(struct tcb_entry *tcb)
+{
+    /* The idle time is not part of the epoch */
+    cubic_priv(tcb)->epoch_start = 0;
+    tcb->snd_cwnd                = cnet_tcp_cc_restart_wnd(tcb);
+}
+
+static const struct tcp_cc_ops cubic_ops = {
+    .name    = "cubic",
+    .init    = cubic_init,
+    .ack     = cubic_ack,
+    .loss    = cubic_loss,
+    .rto     = cubic_rto,
+    .restart = cubic_restart,
+};
+
+CNE_INIT_PRIO(cnet_tcp_cc_cubic_constructor, STACK)
+{
+    cnet_tcp_cc_register(&cubic_ops);
+}
@@ -0,0 +1,267 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright (c) 2023 Intel Corporation
+ */
+
+#include <stdint.h>              // for uint16_t, uint32_t
+#include <stdbool.h>             // for bool
+#include <string.h>              // for memcmp
+#include <netinet/in.h>          // for IPPROTO_TCP
+#include <net/cne_ip.h>          // for cne_ipv4_hdr, cne_ipv6_hdr, cne_ipv4_cksum
+#include <net/cne_tcp.h>         // for cne_tcp_hdr
+#include <pktmbuf.h>             // for pktmbuf_t, pktmbuf_adj_offset, pktmbuf_data_len
+#include <cnet_stk.h>            // for this_stk
+#include <cnet_tcp.h>            // for TCP_ACK, TCP_PSH, tcp_stats
+
+#include "cnet_tcp_gro.h"
+#include "cne_branch_prediction.h"        // for likely, unlikely
+
+/* A TCP segment of the burst */
+struct gro_seg {
+    void *l3;                /**< IPv4 or IPv6 header */
+    struct cne_tcp_hdr *tcp; /**< TCP header */
+    uint16_t hlen;           /**< Length of the IP and TCP headers */
+    uint16_t plen;           /**< Length of the TCP payload */
+    bool ip6;                /**< true for IPv6 */
+};
+
+/* A flow being merged, the headers of the head segment describe the merged packet */
+struct gro_flow {
+    pktmbuf_t *head;    /**< First segment of the flow, NULL when the entry is free */
+    pktmbuf_t *tail;    /**< Last segment chained to the head */
+    struct gro_seg seg; /**< Headers of the head segment */
+    uint32_t next_seq;  /**< Sequence number of the next in-order segment */
+    uint32_t len;       /**< IP length of the merged packet */
+    uint16_t mss;       /**< Payload length of the head, no merged segment is longer */
+    uint16_t nb;        /**< Number of segments merged */
+};
+
+/*
+ * Parse the headers of a packet, returns false if the packet is not a TCP segment this
+ * node understands. IP options, IPv6 extension headers and chained mbufs are skipped.
+ */
+static inline bool
+gro_parse(pktmbuf_t *m, struct gro_seg *s)
+{
+    uint8_t *l3 = pktmbuf_mtod(m, uint8_t *);
+    uint32_t iplen;
+    uint16_t thlen;
+
+    if (unlikely(m->nb_segs != 1))
+        return false;
+
+    s->l3 = l3;
+    if ((l3[0] >> 4) == 4) {
+        struct cne_ipv4_hdr *ip4 = (struct cne_ipv4_hdr *)l3;
+
+        if (m->l3_len != sizeof(struct cne_ipv4_hdr) || ip4->version_ihl != 0x45 ||
+            ip4->next_proto_id != IPPROTO_TCP)
+            return false;
+        s->ip6 = false;
+        iplen  = be16toh(ip4->total_length);
+    } else {
+        struct cne_ipv6_hdr *ip6 = (struct cne_ipv6_hdr *)l3;
+
+        if (!CNET_ENABLE_IP6 || m->l3_len != sizeof(struct cne_ipv6_hdr) ||
+            ip6->proto != IPPROTO_TCP)
+            return false;
+        s->ip6 = true;
+        iplen  = be16toh(ip6->payload_len) + sizeof(struct cne_ipv6_hdr);
+    }
+
+    s->tcp  = (struct cne_tcp_hdr *)(l3 + m->l3_len);
+    thlen   = (s->tcp->data_off & 0xF0) >> 2;
+    s->hlen = m->l3_len + thlen;
+
+    /* Ethernet padding is only found on segments too short to be worth merging */
+    if (thlen < sizeof(struct cne_tcp_hdr) || iplen < s->hlen || iplen != pktmbuf_data_len(m))
+        return false;
+    s->plen = iplen - s->hlen;
+
+    return true;
+}
+
+/* A data segment with only ACK and maybe PSH set, with a valid checksum */
+static inline bool
+gro_candidate(pktmbuf_t *m, struct gro_seg *s)
+{
+    if (s->plen == 0 || (s->tcp->tcp_flags & ~TCP_PSH) != TCP_ACK)
+        return false;
+
+    if ((m->ol_flags & CNE_MBUF_F_RX_L4_CKSUM_MASK) != CNE_MBUF_F_RX_L4_CKSUM_GOOD) {
+        int verify = s->ip6 ? cne_ipv6_udptcp_cksum_verify(s->l3, s->tcp)
+                            : cne_ipv4_udptcp_cksum_verify(s->l3, s->tcp);
+
+        /* Leave the segment to tcp_input, which drops it */
+        if (verify < 0)
+            return false;
+
+        /* Do not verify it again in tcp_input */
+        m->ol_flags &= ~CNE_MBUF_F_RX_L4_CKSUM_MASK;
+        m->ol_flags |= CNE_MBUF_F_RX_L4_CKSUM_GOOD;
+    }
+
+    return true;
+}
+
+/* Same addresses and ports */
+static inline bool
+gro_same_flow(const struct gro_seg *a, const struct gro_seg *b)
+{
+    const uint8_t *ka, *kb;
+    size_t klen;
+
+    if (a->ip6 != b->ip6)
+        return false;
+
+    if (a->tcp->src_port != b->tcp->src_port || a->tcp->dst_port != b->tcp->dst_port)
+        return false;
+
+    if (a->ip6) {
+        ka   = ((struct cne_ipv6_hdr *)a->l3)->src_addr;
+        kb   = ((struct cne_ipv6_hdr *)b->l3)->src_addr;
+        klen = 2 * sizeof(((struct cne_ipv6_hdr *)a->l3)->src_addr);
+    } else {
+        ka   = (const uint8_t *)&((struct cne_ipv4_hdr *)a->l3)->src_addr;
+        kb   = (const uint8_t *)&((struct cne_ipv4_hdr *)b->l3)->src_addr;
+        klen = 2 * sizeof(((struct cne_ipv4_hdr *)a->l3)->src_addr);
+    }
+
+    return memcmp(ka, kb, klen) == 0;
+}
+
+/* The segment continues the flow and differs from the head only by its sequence number */
+static inline bool
+gro_mergeable(const struct gro_flow *f, const struct gro_seg *s)
+{
+    const struct cne_tcp_hdr *h = f->seg.tcp, *t = s->tcp;
+
+    if (be32toh(t->sent_seq) != f->next_seq || t->recv_ack != h->recv_ack ||
+        t->data_off != h->data_off || t->rx_win != h->rx_win ||
+        (t->tcp_flags & ~TCP_PSH) != h->tcp_flags)
+        return false;
+
+    if (s->plen > f->mss || f->nb >= TCP_GRO_MAX_SEGS || f->len + s->plen > UINT16_MAX)
+        return false;
+
+    /* The options, mostly timestamps, must be the same */
+    return memcmp(&h[1], &t[1], ((t->data_off & 0xF0) >> 2) - sizeof(struct cne_tcp_hdr)) == 0;
+}
+
+/* Write the IP length of the merged packet, the flow entry is free afterwards */
+static void
+gro_flush(struct gro_flow *f)
+{
+    if (f->nb > 1) {
+        if (f->seg.ip6) {
+            struct cne_ipv6_hdr *ip6 = f->seg.l3;
+
+            ip6->payload_len = htobe16(f->len - sizeof(struct cne_ipv6_hdr));
+        } else {
+            struct cne_ipv4_hdr *ip4 = f->seg.l3;
+
+            ip4->total_length = htobe16(f->len);
+            ip4->hdr_checksum = 0;
+            ip4->hdr_checksum = cne_ipv4_cksum(ip4);
+        }
+        this_stk->tcp_stats->S_gro_merged += f->nb - 1;
+    }
+    f->head = NULL;
+}
+
+static inline struct gro_flow *
+gro_flow_alloc(struct gro_flow *flows, int *nb_flows)
+{
+    for (int j = 0; j < *nb_flows; j++)
+        if (!flows[j].head)
+            return &flows[j];
+
+    return (*nb_flows < TCP_GRO_MAX_FLOWS) ? &flows[(*nb_flows)++] : NULL;
+}
+
+static inline void
+gro_open(struct gro_flow *f, pktmbuf_t *m, const struct gro_seg *s)
+{
+    f->head     = m;
+    f->tail     = m;
+    f->seg      = *s;
+    f->next_seq = be32toh(s->tcp->sent_seq) + s->plen;
+    f->len      = s->hlen + s->plen;
+    f->mss      = s->plen;
+    f->nb       = 1;
+}
+
+static inline void
+gro_merge(struct gro_flow *f, pktmbuf_t *m, const struct gro_seg *s)
+{
+    /* Only the payload of the segment is kept */
+    pktmbuf_adj_offset(m, s->hlen);
+
+    f->tail->next = m;
+    f->tail       = m;
+    f->head->nb_segs++;
+    f->next_seq += s->plen;
+    f->len += s->plen;
+    f->nb++;
+
+    /* A PSH is kept in the merged packet and ends the flow, a short segment ends it too */
+    if (s->tcp->tcp_flags & TCP_PSH) {
+        f->seg.tcp->tcp_flags |= TCP_PSH;
+        gro_flush(f);
+    } else if (s->plen < f->mss)
+        gro_flush(f);
+}
+
+uint16_t
+cnet_tcp_gro(pktmbuf_t **pkts, uint16_t nb_pkts)
+{
+    struct gro_flow flows[TCP_GRO_MAX_FLOWS];
+    uint16_t nb_out = 0;
+    int nb_flows    = 0;
+
+    for (uint16_t i = 0; i < nb_pkts; i++) {
+        pktmbuf_t *m       = pkts[i];
+        struct gro_flow *f = NULL;
+        struct gro_seg s;
+        bool cand;
+
+        if (!gro_parse(m, &s)) {
+            /* The flow of the packet is unknown, end all merges to keep the order */
+            for (int j = 0; j < nb_flows; j++)
+                if (flows[j].head)
+                    gro_flush(&flows[j]);
+            nb_flows       = 0;
+            pkts[nb_out++] = m;
+            continue;
+        }
+
+        for (int j = 0; j < nb_flows; j++) {
+            if (flows[j].head && gro_same_flow(&flows[j].seg, &s)) {
+                f = &flows[j];
+                break;
+            }
+        }
+
+        cand = gro_candidate(m, &s);
+        if (f && cand && gro_mergeable(f, &s)) {
+            gro_merge(f, m, &s);
+            continue;
+        }
+
+        /* Anything else in the flow ends the merge, the segment may start a new one */
+        if (f)
+            gro_flush(f);
+        else if (cand)
+            f = gro_flow_alloc(flows, &nb_flows);
+
+        if (cand && f)
+            gro_open(f, m, &s);
+
+        pkts[nb_out++] = m;
+    }
+
+    for (int j = 0; j < nb_flows; j++)
+        if (flows[j].head)
+            gro_flush(&flows[j]);
+
+    return nb_out;
+}
@@ -0,0 +1,52 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright (c) 2023 Intel Corporation
+ */
+
+#ifndef __CNET_TCP_GRO_H
+#define __CNET_TCP_GRO_H
+
+/**
+ * @file
+ * CNET TCP generic receive offload in software.
+ *
+ * The tcp_gro node runs ahead of tcp_input and merges the in-order data segments of a flow
+ * found in the same burst into one packet. The first segment keeps its headers, the IP
+ * length is updated to cover all of the data and the payload of each following segment is
+ * chained to it, so TCP processes and acknowledges the data once per burst.
+ *
+ * Only segments with ACK and optionally PSH set, the same ACK number, window and options
+ * are merged. A segment shorter than the first one, a PSH, any other flag or data out of
+ * order ends the merge for the flow, and all flows end at the end of the burst. The TCP
+ * checksum of each segment is verified before it is merged and the merged packet is marked
+ * with CNE_MBUF_F_RX_L4_CKSUM_GOOD.
+ */
+
+#include <stdint.h>         // for uint16_t
+#include <pktmbuf.h>        // for pktmbuf_t
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define TCP_GRO_MAX_SEGS  32 /**< Max segments merged into one packet */
+#define TCP_GRO_MAX_FLOWS 8  /**< Max flows merged at the same time in a burst */
+
+/**
+ * Merge the TCP segments of a burst.
+ *
+ * @param pkts
+ *   The burst of IPv4 or IPv6 packets, the data offset is at the L3 header and l3_len is
+ *   set. The packets left after the merge are packed at the start of the array in the same
+ *   order, the merged segments are chained to the first segment of their flow.
+ * @param nb_pkts
+ *   Number of packets in pkts[].
+ * @return
+ *   The number of packets left in pkts[].
+ */
+uint16_t cnet_tcp_gro(pktmbuf_t **pkts, uint16_t nb_pkts);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __CNET_TCP_GRO_H */
@@ -0,0 +1,154 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright (c) 2023 Intel Corporation
+ */
+
+#include <stdint.h>              // for uint16_t, uint32_t
+#include <string.h>              // for memcpy
+#include <net/cne_ip.h>          // for cne_ipv4_hdr, cne_ipv6_hdr, __cne_raw_cksum
+#include <net/cne_tcp.h>         // for cne_tcp_hdr
+#include <pktmbuf.h>             // for pktmbuf_t, pktmbuf_prepend, pktmbuf_headroom
+#include <cne_log.h>             // for CNE_ERR_RET
+#include <cnet_stk.h>            // for this_stk
+#include <cnet_tcp.h>            // for TCP_FIN, TCP_PSH, tcp_stats
+
+#include "cnet_tcp_gso.h"
+#include "cne_branch_prediction.h"        // for unlikely
+
+/* Complement of the folded sum, the checksum to store in a header */
+static inline uint16_t
+gso_cksum(uint32_t sum)
+{
+    return (uint16_t)~__cne_raw_cksum_reduce(sum);
+}
+
+int
+cnet_tcp_gso_segment(pktmbuf_t *m, bool cksum_offload, pktmbuf_t **segs, uint16_t max_segs)
+{
+    uint16_t l3_off = m->l2_len, l4_off = m->l2_len + m->l3_len;
+    uint16_t hlen, segsz = m->tso_segsz;
+    struct cne_tcp_hdr *tcp;
+    struct cne_ipv4_hdr *ip4 = NULL;
+    struct cne_ipv6_hdr *ip6 = NULL;
+    uint32_t seq, phdr, tmpl, ip_tmpl = 0;
+    uint8_t flags, last_flags;
+    uint16_t ip_id = 0;
+    pktmbuf_t *s;
+    char *hdr;
+    int nb;
+
+    hlen = l4_off + m->l4_len;
+    if (unlikely(segsz == 0 || m->l4_len < sizeof(struct cne_tcp_hdr) ||
+                 pktmbuf_data_len(m) < hlen || pktmbuf_data_len(m) - hlen > segsz))
+        CNE_ERR_RET("Invalid GSO super-segment\n");
+
+    /* Check the layout first, the packet is left untouched on error */
+    nb = 1;
+    for (s = m->next; s; s = s->next) {
+        if (unlikely(++nb > max_segs))
+            CNE_ERR_RET("GSO super-segment has more than %u frames\n", max_segs);
+        if (unlikely(pktmbuf_data_len(s) > segsz || pktmbuf_headroom(s) < hlen))
+            CNE_ERR_RET("GSO payload segment is invalid\n");
+    }
+
+    hdr = pktmbuf_mtod(m, char *);
+    tcp = (struct cne_tcp_hdr *)(hdr + l4_off);
+    seq = be32toh(tcp->sent_seq);
+
+    /* The header template, FIN and PSH only go in the last frame */
+    last_flags     = tcp->tcp_flags;
+    flags          = last_flags & ~(TCP_FIN | TCP_PSH);
+    tcp->tcp_flags = flags;
+    tcp->sent_seq  = 0;
+    tcp->cksum     = 0;
+
+    if (((uint8_t)hdr[l3_off] >> 4) == 4) {
+        ip4 = (struct cne_ipv4_hdr *)(hdr + l3_off);
+
+        ip_id             = be16toh(ip4->packet_id);
+        ip4->total_length = 0;
+        ip4->packet_id    = 0;
+        ip4->hdr_checksum = 0;
+
+        ip_tmpl = __cne_raw_cksum(ip4, m->l3_len, 0);
+        phdr    = cne_ipv4_phdr_cksum(ip4, CNE_MBUF_F_TX_TCP_SEG); /* zero length */
+    } else {
+        ip6 = (struct cne_ipv6_hdr *)(hdr + l3_off);
+
+        ip6->payload_len = 0;
+        phdr             = cne_ipv6_phdr_cksum(ip6, 0);
+    }
+    tmpl = __cne_raw_cksum(tcp, m->l4_len, phdr);
+
+    /* Unchain the payload segments and give each one a copy of the headers */
+    nb         = 0;
+    segs[nb++] = m;
+    while ((s = m->next) != NULL) {
+        m->next = s->next;
+        s->next = NULL;
+
+        memcpy(pktmbuf_prepend(s, hlen), hdr, hlen);
+        s->tx_offload = m->tx_offload;
+        s->lport      = m->lport;
+        s->userptr    = m->userptr;
+        s->nb_segs    = 1;
+        s->ol_flags   = 0;
+
+        segs[nb++] = s;
+    }
+    m->nb_segs = 1;
+    m->ol_flags &= ~CNE_MBUF_F_TX_TCP_SEG;
+
+    for (int i = 0; i < nb; i++) {
+        pktmbuf_t *f          = segs[i];
+        char *h               = pktmbuf_mtod(f, char *);
+        uint16_t plen         = pktmbuf_data_len(f) - hlen;
+        uint16_t tlen         = htobe16(m->l4_len + plen);
+        struct cne_tcp_hdr *t = (struct cne_tcp_hdr *)(h + l4_off);
+        uint32_t sum          = tmpl;
+
+        f->tso_segsz = 0;
+
+        if (i == nb - 1 && last_flags != flags) {
+            t->tcp_flags = last_flags;
+            sum          = __cne_raw_cksum(t, m->l4_len, phdr);
+        }
+        t->sent_seq = htobe32(seq);
+        seq += plen;
+
+        if (ip4) {
+            struct cne_ipv4_hdr *ip = (struct cne_ipv4_hdr *)(h + l3_off);
+
+            /* RFC 1624, only the length and the identification differ from the template */
+            ip->total_length = htobe16(m->l3_len + m->l4_len + plen);
+            ip->packet_id    = htobe16((uint16_t)(ip_id + i));
+            ip->hdr_checksum = gso_cksum(ip_tmpl + ip->total_length + ip->packet_id);
+
+            if (cksum_offload) {
+                f->ol_flags |= CNE_MBUF_F_TX_IPV4 | CNE_MBUF_F_TX_TCP_CKSUM;
+                t->cksum = cne_ipv4_phdr_cksum(ip, f->ol_flags);
+                continue;
+            }
+        } else {
+            struct cne_ipv6_hdr *ip = (struct cne_ipv6_hdr *)(h + l3_off);
+
+            ip->payload_len = tlen;
+
+            if (cksum_offload) {
+                f->ol_flags |= CNE_MBUF_F_TX_IPV6 | CNE_MBUF_F_TX_TCP_CKSUM;
+                t->cksum = cne_ipv6_phdr_cksum(ip, f->ol_flags);
+                continue;
+            }
+        }
+
+        /* The template sum plus the TCP length, the sequence number and the payload */
+        sum += tlen;
+        sum = __cne_raw_cksum(&t->sent_seq, sizeof(t->sent_seq), sum);
+        sum = __cne_raw_cksum(h + hlen, plen, sum);
+
+        t->cksum = gso_cksum(sum);
+    }
+
+    this_stk->tcp_stats->S_gso_frames += nb;
+
+    return nb;
+}
@@ -0,0 +1,57 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright (c) 2023 Intel Corporation
+ */
+
+#ifndef __CNET_TCP_GSO_H
+#define __CNET_TCP_GSO_H
+
+/**
+ * @file
+ * CNET TCP generic segmentation offload in software.
+ *
+ * TCP sends a run of full sized segments as one super-segment, a packet marked with
+ * CNE_MBUF_F_TX_TCP_SEG and tso_segsz set to the payload size of each frame. The first
+ * mbuf holds the L2, L3 and L4 headers followed by the payload of the first frame and each
+ * chained mbuf holds the payload of one more frame, with enough headroom for the headers.
+ *
+ * The ip4_gso and ip6_gso nodes call cnet_tcp_gso_segment() after the headers are
+ * complete to turn the super-segment into a burst of frames. The headers are copied into
+ * the headroom of each payload mbuf, so no payload is copied, and the IP and TCP checksums
+ * are derived from a sum of the header template computed once per super-segment.
+ */
+
+#include <stdint.h>         // for uint16_t
+#include <stdbool.h>        // for bool
+#include <pktmbuf.h>        // for pktmbuf_t
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define TCP_GSO_MAX_SEGS 32    /**< Max frames in a super-segment */
+#define TCP_GSO_MAX_SIZE 65535 /**< Max payload bytes in a super-segment */
+
+/**
+ * Split a TCP super-segment into frames.
+ *
+ * The IPv4 packet_id of the super-segment is used by the first frame and incremented for
+ * each of the following frames. FIN and PSH are only set in the last frame.
+ *
+ * @param m
+ *   The super-segment, l2_len, l3_len, l4_len and tso_segsz must be set.
+ * @param cksum_offload
+ *   True to only set the pseudo header checksum and let the NIC complete the TCP checksum.
+ * @param segs
+ *   Array filled with the frames, the first frame is the super-segment mbuf itself.
+ * @param max_segs
+ *   Number of entries in segs[].
+ * @return
+ *   The number of frames or -1 on error, the super-segment is not modified on error.
+ */
+int cnet_tcp_gso_segment(pktmbuf_t *m, bool cksum_offload, pktmbuf_t **segs, uint16_t max_segs);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __CNET_TCP_GSO_H */
@@ -0,0 +1,407 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright (c) 2023 Intel Corporation
+ */
+
+#include <stdint.h>              // for uint32_t, uint64_t, int64_t
+#include <stdlib.h>              // for calloc, free
+#include <cne_cycles.h>          // for cne_get_timer_hz
+#include <cnet_tcp.h>            // for seqLT, seqGT, TCP_FAST_TIMEOUT_MS
+
+#include "cnet_tcp_sack.h"
+#include "cne_common.h"        // for CNE_MIN
+
+#define SB_MASK (TCP_SACK_SB_ENTRIES - 1)
+
+static inline struct tcp_sb_entry *
+sb_ent(struct tcp_sack *sk, uint16_t i)
+{
+    return &sk->ents[(sk->head + i) & SB_MASK];
+}
+
+/* True when the segment (t1, s1) was sent after the segment (t2, s2), RFC 8985 */
+static inline bool
+rack_sent_after(uint64_t t1, uint32_t s1, uint64_t t2, uint32_t s2)
+{
+    return (t1 > t2) || (t1 == t2 && seqGT(s1, s2));
+}
+
+/*
+ * Update the RACK state with a segment which was delivered, RFC 8985 section 6.2 steps 1-3.
+ */
+static void
+rack_deliver(struct tcp_sack *sk, struct tcp_sb_entry *e, uint64_t now)
+{
+    uint64_t rtt = now - e->xmit_ts;
+
+    /* The sample is ambiguous if the ACK may be for the original transmission */
+    if ((e->flags & TCP_SB_RETRANS) && sk->min_rtt && rtt < sk->min_rtt)
+        return;
+
+    if (!sk->min_rtt || rtt < sk->min_rtt)
+        sk->min_rtt = rtt;
+    sk->srtt = sk->srtt ? sk->srtt - (sk->srtt >> 3) + (rtt >> 3) : rtt;
+
+    /* A segment delivered below the highest delivered sequence was reordered */
+    if (sk->rack_xmit_ts == 0)
+        sk->rack_fack = e->end;
+    else if (seqLT(e->end, sk->rack_fack)) {
+        if (!(e->flags & TCP_SB_RETRANS))
+            sk->reordering_seen = true;
+    } else
+        sk->rack_fack = e->end;
+
+    if (rack_sent_after(e->xmit_ts, e->end, sk->rack_xmit_ts, sk->rack_end_seq)) {
+        sk->rack_rtt     = rtt;
+        sk->rack_xmit_ts = e->xmit_ts;
+        sk->rack_end_seq = e->end;
+    }
+}
+
+/*
+ * The reordering window is zero until reordering is seen and the connection is in recovery
+ * or three segments were selectively acknowledged, RFC 8985 section 6.2 step 4.
+ */
+static uint64_t
+rack_reo_wnd(struct tcp_sack *sk, bool in_recovery)
+{
+    if (!sk->reordering_seen) {
+        uint16_t sacked = 0;
+
+        if (in_recovery)
+            return 0;
+
+        for (uint16_t i = 0; i < sk->cnt; i++)
+            if (sb_ent(sk, i)->flags & TCP_SB_SACKED)
+                sacked++;
+        if (sacked >= TCP_RETRANSMIT_THRESHOLD)
+            return 0;
+    }
+
+    return CNE_MIN(sk->reo_wnd_mult * sk->min_rtt / 4, sk->srtt);
+}
+
+/*
+ * Mark the segments sent before the most recently delivered segment, by more than the
+ * reordering window, as lost and set the reordering timer for the others.
+ */
+static int
+rack_detect_loss(struct tcp_sack *sk, bool in_recovery, uint64_t now)
+{
+    uint64_t reo_wnd;
+    int64_t timeout = 0;
+    int ev          = 0;
+
+    if (sk->rack_xmit_ts == 0)
+        return 0;
+
+    reo_wnd = rack_reo_wnd(sk, in_recovery);
+
+    for (uint16_t i = 0; i < sk->cnt; i++) {
+        struct tcp_sb_entry *e = sb_ent(sk, i);
+        int64_t remaining;
+
+        if (e->flags & TCP_SB_SACKED)
+            continue;
+
+        /* Already lost and waiting to be retransmitted */
+        if ((e->flags & (TCP_SB_LOST | TCP_SB_RETRANS)) == TCP_SB_LOST)
+            continue;
+
+        if (!rack_sent_after(sk->rack_xmit_ts, sk->rack_end_seq, e->xmit_ts, e->end))
+            continue;
+
+        remaining = (int64_t)(e->xmit_ts + sk->rack_rtt + reo_wnd - now);
+        if (remaining <= 0) {
+            e->flags = (e->flags | TCP_SB_LOST) & ~TCP_SB_RETRANS;
+            ev |= TCP_SACK_EV_LOSS;
+        } else if (remaining > timeout)
+            timeout = remaining;
+    }
+
+    sk->rack_deadline = timeout ? now + timeout : 0;
+
+    return ev;
+}
+
+struct tcp_sack *
+cnet_tcp_sack_create(void)
+{
+    struct tcp_sack *sk;
+
+    sk = calloc(1, sizeof(struct tcp_sack));
+    if (!sk)
+        return NULL;
+
+    sk->reo_wnd_mult    = 1;
+    sk->reo_wnd_persist = TCP_RACK_REO_PERSIST;
+
+    return sk;
+}
+
+void
+cnet_tcp_sack_destroy(struct tcp_sack *sk)
+{
+    free(sk);
+}
+
+void
+cnet_tcp_sack_sent(struct tcp_sack *sk, uint32_t seq, uint32_t len, uint64_t now)
+{
+    uint32_t end = seq + len;
+    struct tcp_sb_entry *e;
+
+    if (!sk || !len)
+        return;
+
+    /* Retransmitted segments get a new transmit time and are no longer lost */
+    for (uint16_t i = 0; i < sk->cnt; i++) {
+        e = sb_ent(sk, i);
+
+        if (seqGEQ(e->start, end))
+            break;
+        if (seqLEQ(e->end, seq))
+            continue;
+
+        e->flags   = (e->flags | TCP_SB_RETRANS) & ~TCP_SB_LOST;
+        e->xmit_ts = now;
+    }
+
+    if (sk->cnt) {
+        e = sb_ent(sk, sk->cnt - 1);
+
+        if (seqGEQ(e->end, end))
+            return;
+        if (seqGT(e->end, seq))
+            seq = e->end;
+
+        /* When the scoreboard is full extend the last entry to keep tracking the data */
+        if (sk->cnt == TCP_SACK_SB_ENTRIES) {
+            e->end     = end;
+            e->xmit_ts = now;
+            return;
+        }
+    }
+
+    e          = sb_ent(sk, sk->cnt++);
+    e->start   = seq;
+    e->end     = end;
+    e->xmit_ts = now;
+    e->flags   = 0;
+}
+
+int
+cnet_tcp_sack_update(struct tcp_sack *sk, uint32_t ack, const struct tcp_sack_blk *blks,
+                     int nb_blks, bool in_recovery, uint64_t now)
+{
+    int first = 0, ev = 0;
+
+    if (!sk)
+        return 0;
+
+    /* RFC 2883, the first block is a D-SACK when below the ACK or inside the second block */
+    if (nb_blks > 0 && (seqLEQ(blks[0].end, ack) ||
+                        (nb_blks > 1 && seqGEQ(blks[0].start, blks[1].start) &&
+                         seqLEQ(blks[0].end, blks[1].end)))) {
+        ev |= TCP_SACK_EV_DSACK;
+        first = 1;
+
+        /* Grow the reordering window, RFC 8985 section 6.2 step 4 */
+        if (sk->reo_wnd_mult < TCP_RACK_REO_MULT)
+            sk->reo_wnd_mult++;
+        sk->reo_wnd_persist = TCP_RACK_REO_PERSIST;
+
+        /* The original segment was delivered, the probe did not repair a loss */
+        if (sk->tlp_inflight && seqLEQ(blks[0].end, sk->tlp_end_seq))
+            sk->tlp_is_retrans = false;
+    }
+
+    /* Remove the cumulatively acknowledged segments */
+    while (sk->cnt) {
+        struct tcp_sb_entry *e = sb_ent(sk, 0);
+
+        if (seqGT(e->end, ack)) {
+            if (seqLT(e->start, ack))
+                e->start = ack;
+            break;
+        }
+
+        if (!(e->flags & TCP_SB_SACKED))
+            rack_deliver(sk, e, now);
+
+        sk->head = (sk->head + 1) & SB_MASK;
+        sk->cnt--;
+    }
+
+    /* Mark the segments fully covered by a SACK block */
+    for (int b = first; b < nb_blks; b++) {
+        const struct tcp_sack_blk *blk = &blks[b];
+
+        if (seqGEQ(blk->start, blk->end) || seqLEQ(blk->end, ack))
+            continue;
+
+        for (uint16_t i = 0; i < sk->cnt; i++) {
+            struct tcp_sb_entry *e = sb_ent(sk, i);
+
+            if (seqGEQ(e->start, blk->end))
+                break;
+            if ((e->flags & TCP_SB_SACKED) || seqLT(e->start, blk->start) ||
+                seqGT(e->end, blk->end))
+                continue;
+
+            e->flags = (e->flags | TCP_SB_SACKED) & ~TCP_SB_LOST;
+            rack_deliver(sk, e, now);
+        }
+    }
+
+    /* The probe is acknowledged, without a D-SACK the probe repaired a loss */
+    if (sk->tlp_inflight && seqGEQ(ack, sk->tlp_end_seq)) {
+        if (sk->tlp_is_retrans)
+            ev |= TCP_SACK_EV_TLP_LOSS;
+        sk->tlp_inflight   = false;
+        sk->tlp_is_retrans = false;
+    }
+
+    if (in_recovery && seqGEQ(ack, sk->recovery_point)) {
+        ev |= TCP_SACK_EV_RECOVERED;
+        in_recovery = false;
+
+        /* Reset the reordering window after a number of recoveries without D-SACK */
+        if (--sk->reo_wnd_persist == 0) {
+            sk->reo_wnd_mult    = 1;
+            sk->reo_wnd_persist = TCP_RACK_REO_PERSIST;
+        }
+    }
+
+    return ev | rack_detect_loss(sk, in_recovery, now);
+}
+
+bool
+cnet_tcp_sack_next_lost(struct tcp_sack *sk, uint32_t *seq, uint32_t *len)
+{
+    for (uint16_t i = 0; sk && i < sk->cnt; i++) {
+        struct tcp_sb_entry *e = sb_ent(sk, i);
+
+        if ((e->flags & (TCP_SB_SACKED | TCP_SB_LOST | TCP_SB_RETRANS)) == TCP_SB_LOST) {
+            *seq = e->start;
+            *len = e->end - e->start;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+bool
+cnet_tcp_sack_last(struct tcp_sack *sk, uint32_t *seq, uint32_t *len)
+{
+    struct tcp_sb_entry *e;
+
+    if (!sk || !sk->cnt)
+        return false;
+
+    e    = sb_ent(sk, sk->cnt - 1);
+    *seq = e->start;
+    *len = e->end - e->start;
+
+    return true;
+}
+
+uint32_t
+cnet_tcp_sack_pipe(struct tcp_sack *sk)
+{
+    uint32_t pipe = 0;
+
+    for (uint16_t i = 0; sk && i < sk->cnt; i++) {
+        struct tcp_sb_entry *e = sb_ent(sk, i);
+
+        if (e->flags & TCP_SB_SACKED)
+            continue;
+
+        /* A lost segment has left the network until it is retransmitted */
+        if (!(e->flags & TCP_SB_LOST) || (e->flags & TCP_SB_RETRANS))
+            pipe += e->end - e->start;
+    }
+
+    return pipe;
+}
+
+void
+cnet_tcp_sack_tlp_arm(struct tcp_sack *sk, uint64_t rto, uint64_t now)
+{
+    uint64_t pto;
+
+    if (!sk)
+        return;
+
+    if (sk->tlp_inflight || sk->cnt == 0) {
+        sk->tlp_deadline = 0;
+        return;
+    }
+
+    /* PTO = 2 * SRTT, plus the delayed ACK time when a single segment is in flight */
+    pto = sk->srtt ? 2 * sk->srtt : rto;
+    if (sk->cnt == 1)
+        pto += (cne_get_timer_hz() * TCP_FAST_TIMEOUT_MS) / 1000;
+
+    sk->tlp_deadline = now + CNE_MIN(pto, rto);
+}
+
+void
+cnet_tcp_sack_tlp_sent(struct tcp_sack *sk, uint32_t snd_max, bool retrans)
+{
+    if (!sk)
+        return;
+
+    sk->tlp_inflight   = true;
+    sk->tlp_is_retrans = retrans;
+    sk->tlp_end_seq    = snd_max;
+    sk->tlp_deadline   = 0;
+}
+
+int
+cnet_tcp_sack_timo(struct tcp_sack *sk, bool in_recovery, uint64_t now)
+{
+    int ev = 0;
+
+    if (!sk)
+        return 0;
+
+    if (sk->rack_deadline && now >= sk->rack_deadline) {
+        sk->rack_deadline = 0;
+        ev |= rack_detect_loss(sk, in_recovery, now);
+    }
+
+    if (!in_recovery && sk->tlp_deadline && now >= sk->tlp_deadline) {
+        sk->tlp_deadline = 0;
+        ev |= TCP_SACK_EV_TLP;
+    }
+
+    return ev;
+}
+
+void
+cnet_tcp_sack_rto(struct tcp_sack *sk)
+{
+    if (!sk)
+        return;
+
+    /* The receiver may have discarded the SACKed data, everything is sent again */
+    for (uint16_t i = 0; i < sk->cnt; i++)
+        sb_ent(sk, i)->flags = 0;
+
+    sk->rack_deadline  = 0;
+    sk->tlp_deadline   = 0;
+    sk->tlp_inflight   = false;
+    sk->tlp_is_retrans = false;
+}
+
+void
+cnet_tcp_sack_dsack_set(struct tcp_sack *sk, uint32_t start, uint32_t end)
+{
+    if (!sk)
+        return;
+
+    sk->dsack.start   = start;
+    sk->dsack.end     = end;
+    sk->dsack_pending = true;
+}
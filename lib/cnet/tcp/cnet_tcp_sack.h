@@ -0,0 +1,236 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright (c) 2023 Intel Corporation
+ */
+
+#ifndef __CNET_TCP_SACK_H
+#define __CNET_TCP_SACK_H
+
+/**
+ * @file
+ * CNET TCP SACK scoreboard and RACK-TLP loss detection.
+ *
+ * The scoreboard tracks every segment sent but not yet cumulatively acknowledged, in
+ * sequence order, with the time it was last transmitted. SACK blocks (RFC 2018) mark
+ * segments as delivered, RACK (RFC 8985) uses the transmit times of the delivered segments
+ * to mark older segments as lost and the Tail Loss Probe recovers a loss at the end of a
+ * flight without waiting for the retransmission timeout.
+ *
+ * The scoreboard only does the bookkeeping, the TCP code decides when to send.
+ */
+
+#include <stdint.h>         // for uint32_t, uint64_t, uint16_t
+#include <stdbool.h>        // for bool
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define TCP_SACK_MAX_BLOCKS  4   /**< Max SACK blocks in a received segment */
+#define TCP_SACK_BLOCK_LEN   8   /**< Length of a SACK block in the option */
+#define TCP_SACK_SB_ENTRIES  512 /**< Number of segments tracked in the scoreboard */
+#define TCP_RACK_REO_MULT    16  /**< Max multiplier of the RACK reordering window */
+#define TCP_RACK_REO_PERSIST 16  /**< Recoveries before the reordering window is reset */
+
+/* tcp_sb_entry.flags values */
+enum {
+    TCP_SB_SACKED  = 0x01, /**< Segment was selectively acknowledged */
+    TCP_SB_LOST    = 0x02, /**< Segment was marked lost by RACK */
+    TCP_SB_RETRANS = 0x04, /**< Segment was retransmitted */
+};
+
+/* Events returned by cnet_tcp_sack_update() and cnet_tcp_sack_timo() */
+enum {
+    TCP_SACK_EV_LOSS      = 0x01, /**< Segments were marked lost */
+    TCP_SACK_EV_DSACK     = 0x02, /**< A D-SACK block was received */
+    TCP_SACK_EV_TLP       = 0x04, /**< The tail loss probe timer expired */
+    TCP_SACK_EV_TLP_LOSS  = 0x08, /**< A probe repaired a loss, congestion control must react */
+    TCP_SACK_EV_RECOVERED = 0x10, /**< The ACK reached the recovery point */
+};
+
+struct tcp_sack_blk {
+    uint32_t start; /**< First sequence number of the block */
+    uint32_t end;   /**< Sequence number following the last byte of the block */
+};
+
+struct tcp_sb_entry {
+    uint32_t start;   /**< First sequence number of the segment */
+    uint32_t end;     /**< Sequence number following the segment */
+    uint64_t xmit_ts; /**< Cycles of the last transmission of the segment */
+    uint32_t flags;   /**< TCP_SB_XXX flags */
+};
+
+struct tcp_sack {
+    uint16_t head;                                 /**< Index of the oldest entry */
+    uint16_t cnt;                                  /**< Number of entries in ents[] */
+    uint32_t recovery_point;                       /**< snd_max when recovery started */
+    uint64_t srtt;                                 /**< Smoothed RTT in cycles */
+    uint64_t min_rtt;                              /**< Minimum RTT in cycles */
+    uint64_t rack_xmit_ts;                         /**< Latest xmit time delivered */
+    uint32_t rack_end_seq;                         /**< End sequence of that segment */
+    uint32_t rack_fack;                            /**< Highest end sequence delivered */
+    uint64_t rack_rtt;                             /**< RTT of that segment in cycles */
+    uint64_t rack_deadline;                        /**< Reordering timer cycles or zero */
+    uint32_t reo_wnd_mult;                         /**< Reordering window multiplier */
+    uint32_t reo_wnd_persist;                      /**< Recoveries until mult is reset */
+    bool reordering_seen;                          /**< Reordering was detected */
+    bool tlp_is_retrans;                           /**< The probe was a retransmission */
+    bool tlp_inflight;                             /**< A probe is not acknowledged yet */
+    bool dsack_pending;                            /**< Send dsack in the next segment */
+    uint64_t tlp_deadline;                         /**< Probe timer cycles or zero */
+    uint32_t tlp_end_seq;                          /**< snd_max when the probe was sent */
+    struct tcp_sack_blk dsack;                     /**< D-SACK block to report */
+    struct tcp_sb_entry ents[TCP_SACK_SB_ENTRIES]; /**< Ring of sent segments */
+};
+
+/**
+ * Allocate a SACK scoreboard.
+ *
+ * @return
+ *   Pointer to the scoreboard or NULL on error.
+ */
+struct tcp_sack *cnet_tcp_sack_create(void);
+
+/**
+ * Free a SACK scoreboard.
+ *
+ * @param sk
+ *   Pointer to the scoreboard, can be NULL.
+ */
+void cnet_tcp_sack_destroy(struct tcp_sack *sk);
+
+/**
+ * Record a segment sent or retransmitted in the scoreboard.
+ *
+ * @param sk
+ *   Pointer to the scoreboard.
+ * @param seq
+ *   Sequence number of the first data byte.
+ * @param len
+ *   Number of data bytes in the segment.
+ * @param now
+ *   Current cycles.
+ */
+void cnet_tcp_sack_sent(struct tcp_sack *sk, uint32_t seq, uint32_t len, uint64_t now);
+
+/**
+ * Process the cumulative ACK and the SACK blocks of a received segment.
+ *
+ * @param sk
+ *   Pointer to the scoreboard.
+ * @param ack
+ *   The acknowledgment number of the segment.
+ * @param blks
+ *   The SACK blocks of the segment.
+ * @param nb_blks
+ *   Number of entries in blks[].
+ * @param in_recovery
+ *   True when the connection is in loss recovery.
+ * @param now
+ *   Current cycles.
+ * @return
+ *   A mask of TCP_SACK_EV_XXX events.
+ */
+int cnet_tcp_sack_update(struct tcp_sack *sk, uint32_t ack, const struct tcp_sack_blk *blks,
+                         int nb_blks, bool in_recovery, uint64_t now);
+
+/**
+ * Find the first segment marked lost and not yet retransmitted.
+ *
+ * @param sk
+ *   Pointer to the scoreboard.
+ * @param seq
+ *   Set to the first sequence number of the segment.
+ * @param len
+ *   Set to the length of the segment.
+ * @return
+ *   True when a segment was found.
+ */
+bool cnet_tcp_sack_next_lost(struct tcp_sack *sk, uint32_t *seq, uint32_t *len);
+
+/**
+ * Find the last segment in the scoreboard, the segment a tail loss probe retransmits.
+ *
+ * @param sk
+ *   Pointer to the scoreboard.
+ * @param seq
+ *   Set to the first sequence number of the segment.
+ * @param len
+ *   Set to the length of the segment.
+ * @return
+ *   True when the scoreboard is not empty.
+ */
+bool cnet_tcp_sack_last(struct tcp_sack *sk, uint32_t *seq, uint32_t *len);
+
+/**
+ * Return the number of bytes estimated to be in the network, RFC 6675 pipe.
+ *
+ * @param sk
+ *   Pointer to the scoreboard.
+ * @return
+ *   The number of bytes in flight.
+ */
+uint32_t cnet_tcp_sack_pipe(struct tcp_sack *sk);
+
+/**
+ * Arm the tail loss probe timer after data was sent or acknowledged.
+ *
+ * @param sk
+ *   Pointer to the scoreboard.
+ * @param rto
+ *   Current retransmission timeout in cycles, the probe timeout is capped to it.
+ * @param now
+ *   Current cycles.
+ */
+void cnet_tcp_sack_tlp_arm(struct tcp_sack *sk, uint64_t rto, uint64_t now);
+
+/**
+ * Record a tail loss probe was sent.
+ *
+ * @param sk
+ *   Pointer to the scoreboard.
+ * @param snd_max
+ *   Highest sequence number sent including the probe.
+ * @param retrans
+ *   True when the probe retransmitted the last segment.
+ */
+void cnet_tcp_sack_tlp_sent(struct tcp_sack *sk, uint32_t snd_max, bool retrans);
+
+/**
+ * Check the RACK reordering and tail loss probe timers.
+ *
+ * @param sk
+ *   Pointer to the scoreboard.
+ * @param in_recovery
+ *   True when the connection is in loss recovery.
+ * @param now
+ *   Current cycles.
+ * @return
+ *   A mask of TCP_SACK_EV_LOSS and TCP_SACK_EV_TLP events.
+ */
+int cnet_tcp_sack_timo(struct tcp_sack *sk, bool in_recovery, uint64_t now);
+
+/**
+ * Forget the SACK and loss information after a retransmission timeout, RFC 2018 section 8.
+ *
+ * @param sk
+ *   Pointer to the scoreboard.
+ */
+void cnet_tcp_sack_rto(struct tcp_sack *sk);
+
+/**
+ * Report a duplicate segment in the next segment sent, RFC 2883.
+ *
+ * @param sk
+ *   Pointer to the scoreboard.
+ * @param start
+ *   First sequence number of the duplicate segment.
+ * @param end
+ *   Sequence number following the duplicate segment.
+ */
+void cnet_tcp_sack_dsack_set(struct tcp_sack *sk, uint32_t start, uint32_t end);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __CNET_TCP_SACK_H */
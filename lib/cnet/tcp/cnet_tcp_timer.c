@@ -0,0 +1,105 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright (c) 2023 Intel Corporation
+ */
+
+#include <sys/queue.h>        // for TAILQ_INSERT_TAIL, TAILQ_REMOVE, TAILQ_FIRST
+#include <stdint.h>           // for uint64_t
+#include <string.h>           // for memset
+
+#include "cnet_tcp_timer.h"
+
+/* Level for a timer expiring delta ticks from now, the lowest level with a span over delta */
+static inline int
+tw_level(uint64_t delta)
+{
+    int lvl = 0;
+
+    while (lvl < (TCP_TIMER_LEVELS - 1) && delta >= (1ULL << (TCP_TIMER_BITS * (lvl + 1))))
+        lvl++;
+
+    return lvl;
+}
+
+static inline void
+tw_insert(struct tcp_timer_wheel *tw, struct tcp_timer_entry *tim)
+{
+    int lvl = tw_level(tim->expire - tw->now);
+
+    tim->head = &tw->slots[lvl][(tim->expire >> (TCP_TIMER_BITS * lvl)) & TCP_TIMER_MASK];
+    TAILQ_INSERT_TAIL(tim->head, tim, next);
+}
+
+/* Move the timers of a slot to the lower levels, none of them are due in this slot anymore */
+static void
+tw_cascade(struct tcp_timer_wheel *tw, int lvl, uint64_t idx)
+{
+    struct tcp_timer_list *head = &tw->slots[lvl][idx];
+    struct tcp_timer_list list;
+    struct tcp_timer_entry *tim;
+
+    TAILQ_INIT(&list);
+    TAILQ_CONCAT(&list, head, next);
+
+    while ((tim = TAILQ_FIRST(&list)) != NULL) {
+        TAILQ_REMOVE(&list, tim, next);
+        tw_insert(tw, tim);
+    }
+}
+
+void
+cnet_tcp_timer_init(struct tcp_timer_wheel *tw, uint64_t now, tcp_timer_cb_t cb, void *arg)
+{
+    memset(tw, 0, sizeof(struct tcp_timer_wheel));
+
+    tw->now = now;
+    tw->cb  = cb;
+    tw->arg = arg;
+
+    for (int lvl = 0; lvl < TCP_TIMER_LEVELS; lvl++)
+        for (int i = 0; i < TCP_TIMER_SLOTS; i++)
+            TAILQ_INIT(&tw->slots[lvl][i]);
+}
+
+void
+cnet_tcp_timer_arm(struct tcp_timer_wheel *tw, struct tcp_timer_entry *tim, uint64_t ticks)
+{
+    cnet_tcp_timer_cancel(tim);
+
+    if (ticks == 0)
+        ticks = 1;
+    else if (ticks >= TCP_TIMER_SPAN)
+        ticks = TCP_TIMER_SPAN - 1;
+
+    tim->expire = tw->now + ticks;
+    tw_insert(tw, tim);
+}
+
+void
+cnet_tcp_timer_advance(struct tcp_timer_wheel *tw, uint64_t now)
+{
+    while (tw->now < now) {
+        struct tcp_timer_list *head;
+        struct tcp_timer_entry *tim;
+        uint64_t t = ++tw->now;
+        int top    = 0;
+
+        /* Each level which wrapped around pulls down the timers of its next higher level */
+        while (top < (TCP_TIMER_LEVELS - 1) &&
+               (t & ((1ULL << (TCP_TIMER_BITS * (top + 1))) - 1)) == 0)
+            top++;
+        for (int lvl = top; lvl > 0; lvl--)
+            tw_cascade(tw, lvl, (t >> (TCP_TIMER_BITS * lvl)) & TCP_TIMER_MASK);
+
+        /*
+         * Every timer left in the level 0 slot expires now. The callback can stop any other
+         * timer or re-arm this one, a re-armed timer never lands in the slot being emptied.
+         */
+        head = &tw->slots[0][t & TCP_TIMER_MASK];
+        while ((tim = TAILQ_FIRST(head)) != NULL) {
+            TAILQ_REMOVE(head, tim, next);
+            tim->head = NULL;
+
+            tw->cb(tim, tw->arg);
+        }
+    }
+}
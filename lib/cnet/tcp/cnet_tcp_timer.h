@@ -0,0 +1,131 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright (c) 2023 Intel Corporation
+ */
+
+#ifndef __CNET_TCP_TIMER_H
+#define __CNET_TCP_TIMER_H
+
+/**
+ * @file
+ * CNET TCP hierarchical timer wheel.
+ *
+ * Each stack keeps one wheel for the timers of all of its TCBs. A timer is armed or stopped
+ * in constant time and advancing the wheel by one tick only touches the timers expiring in
+ * that tick, plus the timers moved down from a higher level once every TCP_TIMER_SLOTS ticks
+ * of the level below.
+ *
+ * Level 0 has one slot per tick, each higher level covers TCP_TIMER_SLOTS times the span of
+ * the level below. A timer further away than the span of the wheel is clamped to it.
+ */
+
+#include <sys/queue.h>        // for TAILQ_ENTRY, TAILQ_HEAD
+#include <stdint.h>           // for uint64_t, uint32_t
+#include <stdbool.h>          // for bool
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define TCP_TIMER_BITS   6                       /**< log2 of the slots per level */
+#define TCP_TIMER_SLOTS  (1 << TCP_TIMER_BITS)   /**< Number of slots per level */
+#define TCP_TIMER_MASK   (TCP_TIMER_SLOTS - 1)   /**< Mask of a slot index */
+#define TCP_TIMER_LEVELS 4                       /**< Number of levels in the wheel */
+#define TCP_TIMER_SPAN   (1ULL << (TCP_TIMER_BITS * TCP_TIMER_LEVELS)) /**< Ticks in the wheel */
+
+struct tcp_timer_entry;
+TAILQ_HEAD(tcp_timer_list, tcp_timer_entry);
+
+/**
+ * A timer on the wheel, embedded in the structure owning it.
+ */
+struct tcp_timer_entry {
+    TAILQ_ENTRY(tcp_timer_entry) next;
+    struct tcp_timer_list *head; /**< Slot holding the timer, NULL when the timer is stopped */
+    uint64_t expire;             /**< Wheel tick the timer expires at */
+    void *arg;                   /**< Argument for the expire callback */
+    uint32_t idx;                /**< Timer index for the expire callback */
+};
+
+/**
+ * Callback of an expired timer, the timer is stopped and can be armed again.
+ */
+typedef void (*tcp_timer_cb_t)(struct tcp_timer_entry *tim, void *arg);
+
+struct tcp_timer_wheel {
+    uint64_t now;      /**< Current tick of the wheel */
+    tcp_timer_cb_t cb; /**< Expire callback */
+    void *arg;         /**< Argument passed to the expire callback */
+
+    struct tcp_timer_list slots[TCP_TIMER_LEVELS][TCP_TIMER_SLOTS]; /**< Timer lists per level */
+};
+
+/**
+ * Initialize a timer wheel.
+ *
+ * @param tw
+ *   The timer wheel to initialize.
+ * @param now
+ *   The current tick.
+ * @param cb
+ *   The function called for each expired timer.
+ * @param arg
+ *   The argument passed to the callback.
+ */
+void cnet_tcp_timer_init(struct tcp_timer_wheel *tw, uint64_t now, tcp_timer_cb_t cb, void *arg);
+
+/**
+ * Start or restart a timer.
+ *
+ * @param tw
+ *   The timer wheel.
+ * @param tim
+ *   The timer to start, it is stopped first when already running.
+ * @param ticks
+ *   Number of ticks from now, a value of zero expires on the next tick.
+ */
+void cnet_tcp_timer_arm(struct tcp_timer_wheel *tw, struct tcp_timer_entry *tim, uint64_t ticks);
+
+/**
+ * Advance the wheel and call the callback for each timer expired on the way.
+ *
+ * @param tw
+ *   The timer wheel.
+ * @param now
+ *   The current tick, the wheel is advanced one tick at a time up to this value.
+ */
+void cnet_tcp_timer_advance(struct tcp_timer_wheel *tw, uint64_t now);
+
+/**
+ * Test if a timer is running.
+ *
+ * @param tim
+ *   The timer to test.
+ * @return
+ *   true if the timer is armed or false if it is stopped.
+ */
+static inline bool
+cnet_tcp_timer_pending(const struct tcp_timer_entry *tim)
+{
+    return tim->head != NULL;
+}
+
+/**
+ * Stop a timer, nothing is done if the timer is not running.
+ *
+ * @param tim
+ *   The timer to stop.
+ */
+static inline void
+cnet_tcp_timer_cancel(struct tcp_timer_entry *tim)
+{
+    if (tim->head) {
+        TAILQ_REMOVE(tim->head, tim, next);
+        tim->head = NULL;
+    }
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __CNET_TCP_TIMER_H */
@@ -0,0 +1,47 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright (c) 2023 Intel Corporation
+ */
+
+#include <cne_graph.h>               // for cne_node_register, CNE_NODE_REGISTER
+#include <cne_graph_worker.h>        // for cne_node, cne_node_enqueue
+#include <pktmbuf.h>                 // for pktmbuf_t
+#include <stdint.h>                  // for uint16_t
+#include <cnet_stk.h>                // for this_stk, TCP_GRO_ENABLED
+#include <cnet_tcp_gro.h>            // for cnet_tcp_gro
+
+#include <cnet_node_names.h>
+#include "tcp_gro_priv.h"
+
+/*
+ * Merge the in-order segments of each flow in the burst before tcp_input, the burst is
+ * moved to tcp_input as is when nothing was merged.
+ */
+static uint16_t
+tcp_gro_node_process(struct cne_graph *graph, struct cne_node *node, void **objs,
+                     uint16_t nb_objs)
+{
+    uint16_t nb = nb_objs;
+
+    if (this_stk->gflags & TCP_GRO_ENABLED)
+        nb = cnet_tcp_gro((pktmbuf_t **)objs, nb_objs);
+
+    if (likely(nb == nb_objs))
+        cne_node_next_stream_move(graph, node, TCP_GRO_NEXT_TCP_INPUT);
+    else
+        cne_node_enqueue(graph, node, TCP_GRO_NEXT_TCP_INPUT, objs, nb);
+
+    return nb_objs;
+}
+
+static struct cne_node_register tcp_gro_node_base = {
+    .process = tcp_gro_node_process,
+    .name    = TCP_GRO_NODE_NAME,
+
+    .nb_edges = TCP_GRO_NEXT_MAX,
+    .next_nodes =
+        {
+            [TCP_GRO_NEXT_TCP_INPUT] = TCP_INPUT_NODE_NAME,
+        },
+};
+
+CNE_NODE_REGISTER(tcp_gro_node_base);
@@ -0,0 +1,22 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright (c) 2023 Intel Corporation
+ */
+#ifndef __INCLUDE_TCP_GRO_PRIV_H__
+#define __INCLUDE_TCP_GRO_PRIV_H__
+
+#include <cne_common.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+enum tcp_gro_next_nodes {
+    TCP_GRO_NEXT_TCP_INPUT,
+    TCP_GRO_NEXT_MAX,
+};
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __INCLUDE_TCP_GRO_PRIV_H__ */
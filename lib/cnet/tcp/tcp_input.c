@@ -38,25 +38,22 @@ typedef struct l3_s2 {
     };
 } __cne_packed l3_t2;
 
-static inline uint16_t
-tcp_input_lookup(struct cne_node *node, pktmbuf_t *m, struct pcb_hd *hd)
+/* Build the PCB key from the packet headers, returns -1 if the packet must be dropped */
+static inline int
+tcp_input_key(pktmbuf_t *m, struct pcb_key *key)
 {
-    struct cnet *cnet = this_cnet;
     struct cne_tcp_hdr *tcp; /* TCP header */
-    void *l3;
     l3_t2 tip;
-    struct pcb_key key = {0};
-    struct pcb_entry *pcb;
     struct cnet_metadata *md;
-    int16_t verify;
     int a_family, a_len;
     struct pcb_entry *pcb2;
 
+    memset(key, 0, sizeof(struct pcb_key));
+
     md = pktmbuf_metadata(m);
     if (!md)
-        return TCP_INPUT_NEXT_PKT_DROP;
+        return -1;
 
-    l3  = pktmbuf_mtod(m, void *);
     tcp = pktmbuf_mtod_offset(m, struct cne_tcp_hdr *, m->l3_len);
 
     pcb2 = m->userptr;
@@ -70,41 +67,65 @@ tcp_input_lookup(struct cne_node *node, pktmbuf_t *m, struct pcb_hd *hd)
 
     if (a_family == AF_INET6) {
         a_len   = sizeof(struct in6_addr);
-        tip.ip6 = l3;
+        tip.ip6 = pktmbuf_mtod(m, void *);
     } else {
         a_len   = sizeof(struct in_addr);
-        tip.ip4 = l3;
+        tip.ip4 = pktmbuf_mtod(m, void *);
     }
 
     /* Convert this into AVX instructions */
-    in_caddr_update(&key.faddr, a_family, a_len, tcp->src_port);
+    in_caddr_update(&key->faddr, a_family, a_len, tcp->src_port);
     if (a_family == AF_INET6)
-        inet6_addr_copy_from_octs(&key.faddr.cin6_addr, tip.ip6->src_addr);
+        inet6_addr_copy_from_octs(&key->faddr.cin6_addr, tip.ip6->src_addr);
     else
-        key.faddr.cin_addr.s_addr = tip.ip4->src_addr;
-    in_caddr_update(&key.laddr, a_family, a_len, tcp->dst_port);
+        key->faddr.cin_addr.s_addr = tip.ip4->src_addr;
+    in_caddr_update(&key->laddr, a_family, a_len, tcp->dst_port);
     if (a_family == AF_INET6)
-        inet6_addr_copy_from_octs(&key.laddr.cin6_addr, tip.ip6->dst_addr);
+        inet6_addr_copy_from_octs(&key->laddr.cin6_addr, tip.ip6->dst_addr);
     else
-        key.laddr.cin_addr.s_addr = tip.ip4->dst_addr;
+        key->laddr.cin_addr.s_addr = tip.ip4->dst_addr;
 
-    md->faddr.cin_port = key.faddr.cin_port = tcp->src_port;
-    md->laddr.cin_port = key.laddr.cin_port = tcp->dst_port;
+    md->faddr.cin_port = key->faddr.cin_port = tcp->src_port;
+    md->laddr.cin_port = key->laddr.cin_port = tcp->dst_port;
 
-    /* Create a 4x PCB lookup routine */
-    pcb = cnet_pcb_lookup(hd, &key, BEST_MATCH);
+    return 0;
+}
+
+/*
+ * Process the packet with the PCB found by the bulk lookup, a NULL or stale
+ * PCB falls back to the best match lookup for listeners and wildcard entries.
+ */
+static inline uint16_t
+tcp_input_lookup(struct cne_node *node, pktmbuf_t *m, struct pcb_hd *hd, struct pcb_key *key,
+                 struct pcb_entry *pcb)
+{
+    struct cnet *cnet = this_cnet;
+    struct cne_tcp_hdr *tcp; /* TCP header */
+    void *l3;
+    struct cnet_metadata *md;
+    int16_t verify;
+
+    md  = pktmbuf_metadata(m);
+    l3  = pktmbuf_mtod(m, void *);
+    tcp = pktmbuf_mtod_offset(m, struct cne_tcp_hdr *, m->l3_len);
+
+    if (!cnet_pcb_match(pcb, key))
+        pcb = cnet_pcb_reuseport(cnet_pcb_lookup(hd, key, BEST_MATCH), m, key);
     if (likely(pcb)) {
         int rc = TCP_INPUT_NEXT_PKT_DROP;
-        if (is_pcb_dom_inet6(pcb))
-            verify = cne_ipv6_udptcp_cksum_verify(l3, tcp);
-        else
-            verify = cne_ipv4_udptcp_cksum_verify(l3, tcp);
-        if (verify < 0)
-            return rc;
+        /* Skip the checksum when the PMD has already verified it */
+        if ((m->ol_flags & CNE_MBUF_F_RX_L4_CKSUM_MASK) != CNE_MBUF_F_RX_L4_CKSUM_GOOD) {
+            if (is_pcb_dom_inet6(pcb))
+                verify = cne_ipv6_udptcp_cksum_verify(l3, tcp);
+            else
+                verify = cne_ipv4_udptcp_cksum_verify(l3, tcp);
+            if (verify < 0)
+                return rc;
+        }
 
         m->userptr = pcb;
-        in_caddr_copy(&md->faddr, &key.faddr); /* Save the foreign address */
-        in_caddr_copy(&md->laddr, &key.laddr); /* Save the local address */
+        in_caddr_copy(&md->faddr, &key->faddr); /* Save the foreign address */
+        in_caddr_copy(&md->laddr, &key->laddr); /* Save the local address */
 
         /* returns one of the TCP_INPUT_NEXT_* values */
         rc = cnet_tcp_input(pcb, m);
@@ -129,6 +150,10 @@ tcp_input_node_process(struct cne_graph *graph, struct cne_node *node, void **ob
     uint16_t last_spec = 0;
     uint16_t n_left_from;
     uint16_t held = 0;
+    struct pcb_key keys[4];
+    struct pcb_key *kptrs[4] = {&keys[0], &keys[1], &keys[2], &keys[3]};
+    struct pcb_entry *pcbs[4];
+    int bad;
 
     next_index = TCP_INPUT_NEXT_CHNL_RECV;
 
@@ -168,10 +193,22 @@ tcp_input_node_process(struct cne_graph *graph, struct cne_node *node, void **ob
         pkts += 4;
         n_left_from -= 4;
 
-        next0 = tcp_input_lookup(node, mbuf0, hd);
-        next1 = tcp_input_lookup(node, mbuf1, hd);
-        next2 = tcp_input_lookup(node, mbuf2, hd);
-        next3 = tcp_input_lookup(node, mbuf3, hd);
+        /* Build the four keys and look them up in the PCB hash table at once */
+        bad = (tcp_input_key(mbuf0, &keys[0]) < 0) << 0;
+        bad |= (tcp_input_key(mbuf1, &keys[1]) < 0) << 1;
+        bad |= (tcp_input_key(mbuf2, &keys[2]) < 0) << 2;
+        bad |= (tcp_input_key(mbuf3, &keys[3]) < 0) << 3;
+
+        cnet_pcb_lookup_bulk(hd, kptrs, 4, pcbs);
+
+        next0 = (bad & 1) ? TCP_INPUT_NEXT_PKT_DROP
+                          : tcp_input_lookup(node, mbuf0, hd, &keys[0], pcbs[0]);
+        next1 = (bad & 2) ? TCP_INPUT_NEXT_PKT_DROP
+                          : tcp_input_lookup(node, mbuf1, hd, &keys[1], pcbs[1]);
+        next2 = (bad & 4) ? TCP_INPUT_NEXT_PKT_DROP
+                          : tcp_input_lookup(node, mbuf2, hd, &keys[2], pcbs[2]);
+        next3 = (bad & 8) ? TCP_INPUT_NEXT_PKT_DROP
+                          : tcp_input_lookup(node, mbuf3, hd, &keys[3], pcbs[3]);
 
         /* Enqueue four to next node */
         cne_edge_t fix_spec = (next_index ^ next0) | (next_index ^ next1) | (next_index ^ next2) |
@@ -229,7 +266,10 @@ tcp_input_node_process(struct cne_graph *graph, struct cne_node *node, void **ob
         pkts += 1;
         n_left_from -= 1;
 
-        next0 = tcp_input_lookup(node, mbuf0, hd);
+        if (tcp_input_key(mbuf0, &keys[0]) < 0)
+            next0 = TCP_INPUT_NEXT_PKT_DROP;
+        else
+            next0 = tcp_input_lookup(node, mbuf0, hd, &keys[0], NULL);
 
         if (unlikely(next_index ^ next0)) {
             /* Copy things successfully speculated till now */
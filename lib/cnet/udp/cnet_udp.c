@@ -50,6 +50,9 @@ udp_create(void *_stk)
     stk->udp->snd_size          = MAX_UDP_SND_SIZE;
     stk->udp->udp_hd.local_port = _IPPORT_RESERVED;
 
+    if (cnet_pcb_hd_init(&stk->udp->udp_hd, "udp_pcb", CNET_NUM_CHANNELS) < 0)
+        CNE_ERR_RET("Failed to create UDP PCB hash table\n");
+
     return 0;
 }
 
@@ -59,8 +62,7 @@ udp_destroy(void *_stk)
     stk_t *stk = _stk;
 
     if (stk->udp) {
-        vec_free(stk->udp->udp_hd.vec);
-        stk->udp->udp_hd.vec = NULL;
+        cnet_pcb_hd_free(&stk->udp->udp_hd);
         free(stk->udp);
         stk->udp = NULL;
     }
@@ -96,9 +96,10 @@ udp_input_lookup(pktmbuf_t *m, struct pcb_hd *hd)
     md->laddr.cin_port = key.laddr.cin_port = udp->dst_port;
 
     /* Create a 4x PCB lookup routine */
-    pcb = cnet_pcb_lookup(hd, &key, BEST_MATCH);
+    pcb = cnet_pcb_reuseport(cnet_pcb_lookup(hd, &key, BEST_MATCH), m, &key);
     if (likely(pcb)) {
-        if ((pcb->opt_flag & UDP_CHKSUM_FLAG) && udp->dgram_cksum) {
+        if ((pcb->opt_flag & UDP_CHKSUM_FLAG) && udp->dgram_cksum &&
+            (m->ol_flags & CNE_MBUF_F_RX_L4_CKSUM_MASK) != CNE_MBUF_F_RX_L4_CKSUM_GOOD) {
             if (is_pcb_dom_inet6(pcb))
                 verify = cne_ipv6_udptcp_cksum_verify(l3, udp);
             else {
@@ -13,6 +13,7 @@
 #include <cne_branch_prediction.h>        // for likely, unlikely
 #include <cne_ring.h>                     // for cne_ring_t
 #include <cne_rwlock.h>                   // for cne_rwlock_write_unlock, cne_rwlo...
+#include <cne_rcu_qsbr.h>                 // for cne_rcu_qsbr_dq_enqueue, cne_rcu_...
 #include <bsd/string.h>                   // for strlcpy
 #include <emmintrin.h>                    // for _mm_cmpeq_epi16, _mm_load_si128
 #include <stdlib.h>                       // for free, calloc
@@ -29,11 +30,20 @@
      CNE_HASH_EXTRA_FLAGS_RW_CONCURRENCY | CNE_HASH_EXTRA_FLAGS_EXT_TABLE |           \
      CNE_HASH_EXTRA_FLAGS_NO_FREE_ON_DEL | CNE_HASH_EXTRA_FLAGS_RW_CONCURRENCY_LF)
 
+/* Default number of entries reclaimed from the defer queue in one call */
+#define CNE_HASH_RCU_DQ_RECLAIM_MAX 16
+
 #define FOR_EACH_BUCKET(CURRENT_BKT, START_BUCKET) \
     for (CURRENT_BKT = START_BUCKET; CURRENT_BKT != NULL; CURRENT_BKT = CURRENT_BKT->next)
 
 static cne_rwlock_t __hash_lock;
 
+/* Entry placed on the RCU defer queue when a key is deleted */
+struct __cne_hash_rcu_dq_entry {
+    uint32_t key_idx;
+    uint32_t ext_bkt_idx;
+};
+
 static inline struct cne_hash_bucket *
 cne_hash_get_last_bkt(struct cne_hash_bucket *lst_bkt)
 {
@@ -292,6 +302,11 @@ cne_hash_create(const struct cne_hash_parameters *params)
         h->sig_cmp_fn = CNE_HASH_COMPARE_SSE;
     else
         h->sig_cmp_fn = CNE_HASH_COMPARE_SCALAR;
+#if defined(__AVX512BW__) && defined(__AVX512VL__) && defined(__BMI2__)
+    if (__builtin_cpu_supports("avx512bw") && __builtin_cpu_supports("avx512vl") &&
+        __builtin_cpu_supports("bmi2"))
+        h->sig_cmp_fn = CNE_HASH_COMPARE_AVX512;
+#endif
 
     /* Writer threads need to take the lock when:
      * 1) CNE_HASH_EXTRA_FLAGS_RW_CONCURRENCY is enabled OR
@@ -333,6 +348,10 @@ cne_hash_free(struct cne_hash *h)
     if (h == NULL)
         return;
 
+    if (h->dq)
+        cne_rcu_qsbr_dq_delete(h->dq);
+    free(h->hash_rcu_cfg);
+
     if (h->writer_takes_lock)
         free(h->readwrite_lock);
     cne_ring_free(h->free_slots);
@@ -420,6 +439,15 @@ cne_hash_reset(struct cne_hash *h)
 
     __hash_rw_writer_lock(h);
 
+    if (h->dq) {
+        unsigned int pending = 0;
+
+        /* Reclaim all the resources, the free ring is rebuilt below */
+        cne_rcu_qsbr_dq_reclaim(h->dq, ~0, NULL, &pending, NULL);
+        if (pending != 0)
+            CNE_ERR("RCU reclaim all resources failed\n");
+    }
+
     memset(h->buckets, 0, h->num_buckets * sizeof(struct cne_hash_bucket));
     memset(h->key_store, 0, h->key_entry_size * (h->entries + 1));
     *h->tbl_chng_cnt = 0;
@@ -606,6 +634,7 @@ cne_hash_cuckoo_move_insert_mw(const struct cne_hash *h, struct cne_hash_bucket
         if (unlikely(&h->buckets[prev_alt_bkt_idx] != curr_bkt)) {
             /* revert it to empty, otherwise duplicated keys */
             __atomic_store_n(&curr_bkt->key_idx[curr_slot], EMPTY_SLOT, __ATOMIC_RELEASE);
+            __hash_rw_writer_unlock(h);
             return -1;
         }
 
@@ -655,6 +684,8 @@ cne_hash_cuckoo_move_insert_mw(const struct cne_hash *h, struct cne_hash_bucket
     /* Release the new bucket entry */
     __atomic_store_n(&curr_bkt->key_idx[curr_slot], new_idx, __ATOMIC_RELEASE);
 
+    __hash_rw_writer_unlock(h);
+
     return 0;
 }
 
@@ -763,8 +794,19 @@ __cne_hash_add_key_with_hash(const struct cne_hash *h, const void *key, hash_sig
 
     /* Did not find a match, so get a new slot for storing the new key */
     slot_id = alloc_slot(h);
-    if (slot_id == EMPTY_SLOT)
-        return -ENOSPC;
+    if (slot_id == EMPTY_SLOT) {
+        if (h->dq) {
+            /* Try to get some key slots back from the defer queue */
+            __hash_rw_writer_lock(h);
+            ret = cne_rcu_qsbr_dq_reclaim(h->dq, h->hash_rcu_cfg->max_reclaim_size, NULL, NULL,
+                                          NULL);
+            __hash_rw_writer_unlock(h);
+            if (ret == 0)
+                slot_id = alloc_slot(h);
+        }
+        if (slot_id == EMPTY_SLOT)
+            return -ENOSPC;
+    }
 
     new_k = CNE_PTR_ADD(keys, slot_id * h->key_entry_size);
     /* The store to application data (by the application) at *data should
@@ -1124,6 +1166,81 @@ free_slot(const struct cne_hash *h, uint32_t slot_id)
     return 0;
 }
 
+static void
+__hash_rcu_qsbr_free_resource(void *p, void *e, unsigned int n __cne_unused)
+{
+    struct cne_hash *h = p;
+    struct __cne_hash_rcu_dq_entry *ent = e;
+    struct cne_hash_key *k;
+
+    k = CNE_PTR_ADD(h->key_store, ent->key_idx * h->key_entry_size);
+
+    if (h->hash_rcu_cfg->free_key_data_func)
+        h->hash_rcu_cfg->free_key_data_func(h->hash_rcu_cfg->key_data_ptr, k->pdata);
+
+    /* Recycle empty ext bkt to free list. */
+    if (h->ext_table_support && ent->ext_bkt_idx != EMPTY_SLOT)
+        cne_ring_enqueue_elem(h->free_ext_bkts, &ent->ext_bkt_idx, sizeof(uint32_t));
+
+    /* Return key indexes to free slot ring */
+    if (free_slot(h, ent->key_idx) < 0)
+        CNE_ERR("%s: could not enqueue free slots in global ring\n", __func__);
+}
+
+int
+cne_hash_rcu_qsbr_add(struct cne_hash *h, struct cne_hash_rcu_config *cfg)
+{
+    struct cne_rcu_qsbr_dq_parameters params = {0};
+    char rcu_dq_name[CNE_RCU_QSBR_DQ_NAMESIZE];
+    struct cne_hash_rcu_config *hash_rcu_cfg;
+
+    if (h == NULL || cfg == NULL || cfg->v == NULL) {
+        errno = EINVAL;
+        return -1;
+    }
+
+    if (h->hash_rcu_cfg) {
+        errno = EEXIST;
+        return -1;
+    }
+
+    hash_rcu_cfg = calloc(1, sizeof(struct cne_hash_rcu_config));
+    if (hash_rcu_cfg == NULL) {
+        errno = ENOMEM;
+        return -1;
+    }
+
+    if (cfg->mode == CNE_HASH_QSBR_MODE_DQ) {
+        snprintf(rcu_dq_name, sizeof(rcu_dq_name), "HASH_RCU_%s", h->name);
+        params.name                  = rcu_dq_name;
+        params.size                  = (cfg->dq_size) ? cfg->dq_size : h->entries + 1;
+        params.trigger_reclaim_limit = cfg->trigger_reclaim_limit;
+        params.max_reclaim_size =
+            (cfg->max_reclaim_size) ? cfg->max_reclaim_size : CNE_HASH_RCU_DQ_RECLAIM_MAX;
+        params.esize   = sizeof(struct __cne_hash_rcu_dq_entry);
+        params.free_fn = __hash_rcu_qsbr_free_resource;
+        params.p       = h;
+        params.v       = cfg->v;
+
+        h->dq = cne_rcu_qsbr_dq_create(&params);
+        if (h->dq == NULL) {
+            free(hash_rcu_cfg);
+            CNE_ERR_RET("HASH defer queue creation failed\n");
+        }
+    } else if (cfg->mode != CNE_HASH_QSBR_MODE_SYNC) {
+        free(hash_rcu_cfg);
+        errno = EINVAL;
+        return -1;
+    }
+
+    *hash_rcu_cfg = *cfg;
+    if (hash_rcu_cfg->max_reclaim_size == 0)
+        hash_rcu_cfg->max_reclaim_size = CNE_HASH_RCU_DQ_RECLAIM_MAX;
+    h->hash_rcu_cfg = hash_rcu_cfg;
+
+    return 0;
+}
+
 static inline void
 remove_entry(const struct cne_hash *h, struct cne_hash_bucket *bkt, unsigned int i)
 {
@@ -1188,10 +1305,10 @@ search_and_remove(const struct cne_hash *h, const void *key, struct cne_hash_buc
             k = (struct cne_hash_key *)((char *)keys + key_idx * h->key_entry_size);
             if (cne_hash_cmp_eq(key, k->key, h) == 0) {
                 bkt->sig_current[i] = NULL_SIGNATURE;
-                /* Free the key store index if
-                 * no_free_on_del is disabled.
+                /* Free the key store index if no_free_on_del is
+                 * disabled and the RCU QSBR is not deferring it.
                  */
-                if (!h->no_free_on_del)
+                if (!h->no_free_on_del && !h->hash_rcu_cfg)
                     remove_entry(h, bkt, i);
 
                 __atomic_store_n(&bkt->key_idx[i], EMPTY_SLOT, __ATOMIC_RELEASE);
@@ -1218,6 +1335,7 @@ __cne_hash_del_key_with_hash(const struct cne_hash *h, const void *key, hash_sig
     int32_t ret, i;
     uint16_t short_sig;
     uint32_t index = EMPTY_SLOT;
+    struct __cne_hash_rcu_dq_entry rcu_dq_entry;
 
     short_sig       = get_short_sig(sig);
     prim_bucket_idx = get_prim_bucket_index(h, sig);
@@ -1268,10 +1386,12 @@ return_bkt:
     if (i == CNE_HASH_BUCKET_ENTRIES) {
         prev_bkt->next = NULL;
         index          = last_bkt - h->buckets_ext + 1;
-        /* Recycle the empty bkt if
-         * no_free_on_del is disabled.
+        /* Recycle the empty bkt if no_free_on_del is disabled,
+         * with RCU QSBR it is recycled along with the key index.
          */
-        if (h->no_free_on_del) {
+        if (h->hash_rcu_cfg) {
+            /* Handled by the defer queue entry below */
+        } else if (h->no_free_on_del) {
             /* Store index of an empty ext bkt to be recycled
              * on calling cne_hash_del_xxx APIs.
              * When lock free read-write concurrency is enabled,
@@ -1285,6 +1405,17 @@ return_bkt:
     }
 
 return_key:
+    if (h->hash_rcu_cfg) {
+        /* Key index where key is stored, adding the first dummy index */
+        rcu_dq_entry.key_idx     = ret + 1;
+        rcu_dq_entry.ext_bkt_idx = index;
+        if (h->dq == NULL) {
+            /* Wait for the readers to go quiescent in CNE_HASH_QSBR_MODE_SYNC */
+            cne_rcu_qsbr_synchronize(h->hash_rcu_cfg->v, CNE_QSBR_THRID_INVALID);
+            __hash_rcu_qsbr_free_resource((void *)(uintptr_t)h, &rcu_dq_entry, 1);
+        } else if (cne_rcu_qsbr_dq_enqueue(h->dq, &rcu_dq_entry) != 0)
+            CNE_ERR("Failed to push QSBR FIFO\n");
+    }
     __hash_rw_writer_unlock(h);
     return ret;
 }
@@ -1326,6 +1457,9 @@ cne_hash_free_key_with_position(const struct cne_hash *h, const int32_t position
 
     RETURN_IF_TRUE(((h == NULL) || (key_idx == EMPTY_SLOT)), -EINVAL);
 
+    /* Key indexes are reclaimed by the RCU QSBR defer queue */
+    RETURN_IF_TRUE((h->hash_rcu_cfg != NULL), -EINVAL);
+
     const uint32_t total_entries = h->entries + 1;
 
     /* Out of bounds */
@@ -1353,6 +1487,20 @@ compare_signatures(uint32_t *prim_hash_matches, uint32_t *sec_hash_matches,
 
     /* For match mask the first bit of every two bits indicates the match */
     switch (sig_cmp_fn) {
+#if defined(__AVX512BW__) && defined(__AVX512VL__) && defined(__BMI2__)
+    case CNE_HASH_COMPARE_AVX512: {
+        /* Compare the 16 signatures of both buckets at once, primary in the low half */
+        __m256i sigs = _mm256_inserti128_si256(
+            _mm256_castsi128_si256(_mm_load_si128((__m128i const *)prim_bkt->sig_current)),
+            _mm_load_si128((__m128i const *)sec_bkt->sig_current), 1);
+        uint32_t hits =
+            _pdep_u32(_mm256_cmpeq_epi16_mask(sigs, _mm256_set1_epi16(sig)), 0x55555555);
+
+        *prim_hash_matches = hits & 0xffff;
+        *sec_hash_matches  = hits >> 16;
+        break;
+    }
+#endif
     case CNE_HASH_COMPARE_SSE:
         if (__builtin_cpu_supports("sse2")) {
             /* Compare all signatures in the bucket */
@@ -1753,6 +1901,177 @@ cne_hash_lookup_bulk_data(const struct cne_hash *h, const void **keys, uint32_t
     return __builtin_popcountl(*hit_mask);
 }
 
+/* Search the signature hits of a bucket for the key and update its data.
+ * Writer holds the lock before calling this.
+ */
+static inline int32_t
+search_hits_and_update(const struct cne_hash *h, void *data, const void *key,
+                       struct cne_hash_bucket *bkt, uint32_t hitmask)
+{
+    struct cne_hash_key *k;
+
+    while (hitmask) {
+        uint32_t hit_index = __builtin_ctzl(hitmask) >> 1;
+        uint32_t key_idx   = bkt->key_idx[hit_index];
+
+        k = (struct cne_hash_key *)((char *)h->key_store + key_idx * h->key_entry_size);
+        if (key_idx != EMPTY_SLOT && cne_hash_cmp_eq(key, k->key, h) == 0) {
+            __atomic_store_n(&k->pdata, data, __ATOMIC_RELEASE);
+            return key_idx - 1;
+        }
+        hitmask &= ~(3U << (hit_index << 1));
+    }
+    return -1;
+}
+
+/* Find an empty entry in the primary or the secondary bucket, returns -1 if both are full */
+static inline int
+find_empty_entry(struct cne_hash_bucket *prim_bkt, struct cne_hash_bucket *sec_bkt,
+                 struct cne_hash_bucket **bkt)
+{
+    int i;
+
+    for (i = 0; i < CNE_HASH_BUCKET_ENTRIES; i++) {
+        if (prim_bkt->key_idx[i] == EMPTY_SLOT) {
+            *bkt = prim_bkt;
+            return i;
+        }
+    }
+    for (i = 0; i < CNE_HASH_BUCKET_ENTRIES; i++) {
+        if (sec_bkt->key_idx[i] == EMPTY_SLOT) {
+            *bkt = sec_bkt;
+            return i;
+        }
+    }
+    return -1;
+}
+
+/*
+ * Add up to CNE_HASH_LOOKUP_BULK_MAX keys. The buckets of the batch are prefetched before any
+ * of them is touched, the key slots come from the free ring in one burst and the keys having a
+ * free entry in one of their buckets are placed under a single writer lock. The keys needing
+ * a cuckoo displacement are added after that with the single key path, so the displacement
+ * search only runs for them and sees the buckets as filled by the rest of the batch.
+ */
+static inline int
+__cne_hash_add_bulk(const struct cne_hash *h, const void **keys, void *data[], int32_t num_keys,
+                    int32_t *positions)
+{
+    hash_sig_t prim_hash[CNE_HASH_LOOKUP_BULK_MAX];
+    uint16_t sig[CNE_HASH_LOOKUP_BULK_MAX];
+    struct cne_hash_bucket *prim_bkt[CNE_HASH_LOOKUP_BULK_MAX];
+    struct cne_hash_bucket *sec_bkt[CNE_HASH_LOOKUP_BULK_MAX];
+    uint32_t slots[CNE_HASH_LOOKUP_BULK_MAX];
+    struct cne_hash_bucket *cur_bkt;
+    uint32_t prim_idx, n_slots, used = 0;
+    uint64_t deferred = 0;
+    int32_t i, ret;
+    int added = 0;
+
+    for (i = 0; i < PREFETCH_OFFSET && i < num_keys; i++)
+        cne_prefetch0(keys[i]);
+
+    for (i = 0; i < num_keys; i++) {
+        if (i + PREFETCH_OFFSET < num_keys)
+            cne_prefetch0(keys[i + PREFETCH_OFFSET]);
+
+        prim_hash[i] = cne_hash_hash(h, keys[i]);
+        sig[i]       = get_short_sig(prim_hash[i]);
+        prim_idx     = get_prim_bucket_index(h, prim_hash[i]);
+        prim_bkt[i]  = &h->buckets[prim_idx];
+        sec_bkt[i]   = &h->buckets[get_alt_bucket_index(h, prim_idx, sig[i])];
+
+        cne_prefetch0(prim_bkt[i]);
+        cne_prefetch0(sec_bkt[i]);
+    }
+
+    /* Keys left without a slot go to the single key path, which reclaims from the defer queue */
+    n_slots = cne_ring_dequeue_burst_elem(h->free_slots, slots, sizeof(uint32_t), num_keys, NULL);
+
+    __hash_rw_writer_lock(h);
+    for (i = 0; i < num_keys; i++) {
+        void *d               = (data != NULL) ? data[i] : NULL;
+        uint32_t prim_hitmask = 0;
+        uint32_t sec_hitmask  = 0;
+        struct cne_hash_bucket *bkt;
+        struct cne_hash_key *new_k;
+        uint32_t slot_id;
+        int entry;
+
+        /* Keys added earlier in the batch are found here too */
+        compare_signatures(&prim_hitmask, &sec_hitmask, prim_bkt[i], sec_bkt[i], sig[i],
+                           h->sig_cmp_fn);
+        ret = search_hits_and_update(h, d, keys[i], prim_bkt[i], prim_hitmask);
+        if (ret == -1)
+            ret = search_hits_and_update(h, d, keys[i], sec_bkt[i], sec_hitmask);
+        if (ret == -1) {
+            FOR_EACH_BUCKET (cur_bkt, sec_bkt[i]->next) {
+                ret = search_and_update(h, d, keys[i], cur_bkt, sig[i]);
+                if (ret != -1)
+                    break;
+            }
+        }
+        if (ret != -1) {
+            positions[i] = ret;
+            added++;
+            continue;
+        }
+
+        entry = find_empty_entry(prim_bkt[i], sec_bkt[i], &bkt);
+        if (entry < 0 || used == n_slots) {
+            deferred |= 1ULL << i;
+            continue;
+        }
+
+        slot_id = slots[used++];
+        new_k   = CNE_PTR_ADD(h->key_store, slot_id * h->key_entry_size);
+        __atomic_store_n(&new_k->pdata, d, __ATOMIC_RELEASE);
+        memcpy(new_k->key, keys[i], h->key_len);
+
+        bkt->sig_current[entry] = sig[i];
+        /* key_idx is the guard variable for the signature and the key */
+        __atomic_store_n(&bkt->key_idx[entry], slot_id, __ATOMIC_RELEASE);
+        positions[i] = slot_id - 1;
+        added++;
+    }
+    __hash_rw_writer_unlock(h);
+
+    if (used < n_slots)
+        cne_ring_enqueue_burst_elem(h->free_slots, &slots[used], sizeof(uint32_t),
+                                    n_slots - used, NULL);
+
+    while (deferred) {
+        i = __builtin_ctzll(deferred);
+        deferred &= deferred - 1;
+
+        positions[i] = __cne_hash_add_key_with_hash(h, keys[i], prim_hash[i],
+                                                    (data != NULL) ? data[i] : NULL);
+        if (positions[i] >= 0)
+            added++;
+    }
+
+    return added;
+}
+
+int
+cne_hash_add_bulk(const struct cne_hash *h, const void **keys, void *data[], uint32_t num_keys,
+                  int32_t *positions)
+{
+    uint32_t i, n;
+    int added = 0;
+
+    RETURN_IF_TRUE(((h == NULL) || (keys == NULL) || (num_keys == 0) || (positions == NULL)),
+                   -EINVAL);
+
+    for (i = 0; i < num_keys; i += n) {
+        n = CNE_MIN(num_keys - i, (uint32_t)CNE_HASH_LOOKUP_BULK_MAX);
+        added += __cne_hash_add_bulk(h, &keys[i], (data != NULL) ? &data[i] : NULL, n,
+                                     &positions[i]);
+    }
+
+    return added;
+}
+
 static inline void
 __cne_hash_lookup_with_hash_bulk_l(const struct cne_hash *h, const void **keys,
                                    hash_sig_t *prim_hash, int32_t num_keys, int32_t *positions,
@@ -123,6 +123,7 @@ enum cne_hash_sig_compare_function {
     CNE_HASH_COMPARE_SCALAR = 0,
     CNE_HASH_COMPARE_SSE,
     CNE_HASH_COMPARE_NEON,
+    CNE_HASH_COMPARE_AVX512,
     CNE_HASH_COMPARE_NUM
 };
 
@@ -193,6 +194,8 @@ struct cne_hash {
     uint32_t *ext_bkt_to_free;
     uint32_t *tbl_chng_cnt;
     /**< Indicates if the hash table changed from last read. */
+    struct cne_hash_rcu_config *hash_rcu_cfg; /**< HASH RCU QSBR configuration structure */
+    struct cne_rcu_qsbr_dq *dq;               /**< RCU QSBR defer queue. */
 } __cne_cache_aligned;
 
 struct queue_node {
@@ -80,6 +80,30 @@ struct cne_hash_parameters {
 /** @internal A hash table structure. */
 struct cne_hash;
 
+struct cne_rcu_qsbr;
+
+/** HASH RCU QSBR reclamation modes */
+enum cne_hash_qsbr_mode {
+    /** Create defer queue for reclaim. */
+    CNE_HASH_QSBR_MODE_DQ = 0,
+    /** Use blocking mode reclaim. No defer queue created. */
+    CNE_HASH_QSBR_MODE_SYNC
+};
+
+/** Type of function used to free the application data of a reclaimed key. */
+typedef void (*cne_hash_free_key_data)(void *p, void *key_data);
+
+/** HASH RCU QSBR configuration structure. */
+struct cne_hash_rcu_config {
+    struct cne_rcu_qsbr *v;                    /**< RCU QSBR variable. */
+    enum cne_hash_qsbr_mode mode;              /**< Mode of RCU QSBR, CNE_HASH_QSBR_MODE_xxx */
+    uint32_t dq_size;                          /**< Defer queue size, zero uses total entries */
+    uint32_t trigger_reclaim_limit;            /**< Threshold to trigger auto reclaim. */
+    uint32_t max_reclaim_size;                 /**< Max entries to reclaim, zero uses default */
+    void *key_data_ptr;                        /**< Pointer passed to the free function. */
+    cne_hash_free_key_data free_key_data_func; /**< Function to free the key data or NULL */
+};
+
 /**
  * Create a new hash table.
  *
@@ -262,6 +286,35 @@ int32_t cne_hash_add_key(const struct cne_hash *h, const void *key);
  */
 int32_t cne_hash_add_key_with_hash(const struct cne_hash *h, const void *key, hash_sig_t sig);
 
+/**
+ * Add multiple keys to an existing hash table.
+ * This operation is not multi-thread safe
+ * and should only be called from one thread by default.
+ * Thread safety can be enabled by setting flag during
+ * table creation.
+ *
+ * The keys are added CNE_HASH_LOOKUP_BULK_MAX at a time. The buckets of each batch are
+ * prefetched together and the keys finding a free entry in one of their two buckets are
+ * placed under one writer lock; the keys needing entries to be moved are then added one
+ * by one. A key already in the table, or repeated in the list, has its data updated.
+ *
+ * @param h
+ *   Hash table to add the keys to.
+ * @param keys
+ *   A pointer to a list of keys to add.
+ * @param data
+ *   A list of data to store with the keys, NULL to store no data.
+ * @param num_keys
+ *   How many keys are in the keys list.
+ * @param positions
+ *   Output containing the value cne_hash_add_key() returns for each key in the list,
+ *   i.e. the position of the key or -ENOSPC if there was no space for it.
+ * @return
+ *   -EINVAL if the parameters are invalid, otherwise the number of keys added or updated.
+ */
+int cne_hash_add_bulk(const struct cne_hash *h, const void **keys, void *data[], uint32_t num_keys,
+                      int32_t *positions);
+
 /**
  * Remove a key from an existing hash table.
  * This operation is not multi-thread safe
@@ -275,7 +328,8 @@ int32_t cne_hash_add_key_with_hash(const struct cne_hash *h, const void *key, ha
  * additionally to free the index associated with the key.
  * cne_hash_free_key_with_position API should be called after all
  * the readers have stopped referencing the entry corresponding to
- * this key. RCU mechanisms could be used to determine such a state.
+ * this key. cne_hash_rcu_qsbr_add() can be used to have the table
+ * reclaim the index itself once such a state is reached.
  *
  * @param h
  *   Hash table to remove the key from.
@@ -303,7 +357,8 @@ int32_t cne_hash_del_key(const struct cne_hash *h, const void *key);
  * additionally to free the index associated with the key.
  * cne_hash_free_key_with_position API should be called after all
  * the readers have stopped referencing the entry corresponding to
- * this key. RCU mechanisms could be used to determine such a state.
+ * this key. cne_hash_rcu_qsbr_add() can be used to have the table
+ * reclaim the index itself once such a state is reached.
  *
  * @param h
  *   Hash table to remove the key from.
@@ -349,7 +404,8 @@ int cne_hash_get_key_with_position(const struct cne_hash *h, const int32_t posit
  * the key index returned by cne_hash_del_key_xxx APIs must be freed
  * using this API. This API should be called after all the readers
  * have stopped referencing the entry corresponding to this key.
- * RCU mechanisms could be used to determine such a state.
+ * This API must not be used when a QSBR variable has been attached
+ * with cne_hash_rcu_qsbr_add(), as the index is reclaimed internally.
  * This API does not validate if the key is already freed.
  *
  * @param h
@@ -579,6 +635,34 @@ int cne_hash_lookup_bulk(const struct cne_hash *h, const void **keys, uint32_t n
  */
 int32_t cne_hash_iterate(const struct cne_hash *h, const void **key, void **data, uint32_t *next);
 
+/**
+ * Associate a RCU QSBR variable with a hash table.
+ *
+ * Once attached, key indexes (and empty extendable buckets) released by the
+ * cne_hash_del_key_xxx APIs are not returned to the free list until all the
+ * reader threads registered with the QSBR variable have reported a quiescent
+ * state. This allows lock free readers to keep walking buckets while a writer
+ * deletes entries, without the application having to call
+ * cne_hash_free_key_with_position. This API should be called right after
+ * creating the hash table and before any keys are added.
+ *
+ * In CNE_HASH_QSBR_MODE_DQ mode the deleted entries are placed on a defer queue
+ * and reclaimed when the queue passes the trigger limit or when an add finds
+ * no free slot. In CNE_HASH_QSBR_MODE_SYNC mode the delete call blocks until
+ * the readers have gone quiescent.
+ *
+ * @param h
+ *   The hash table to attach the RCU QSBR variable to.
+ * @param cfg
+ *   RCU QSBR configuration, see struct cne_hash_rcu_config.
+ * @return
+ *   0 on success or -1 on error, with errno set to
+ *    - EINVAL - invalid pointer or mode
+ *    - EEXIST - already added QSBR
+ *    - ENOMEM - memory allocation failure
+ */
+int cne_hash_rcu_qsbr_add(struct cne_hash *h, struct cne_hash_rcu_config *cfg);
+
 #ifdef __cplusplus
 }
 #endif
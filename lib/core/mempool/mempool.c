@@ -119,10 +119,11 @@ mempool_destroy(mempool_t *_mp)
 }
 
 static void
-mempool_cache_init(struct mempool_cache *cache, uint32_t size)
+mempool_cache_init(struct mempool_cache *cache, uint32_t size, uint32_t low_wm, uint32_t high_wm)
 {
     cache->size        = size;
-    cache->flushthresh = CALC_CACHE_FLUSHTHRESH(size);
+    cache->flushthresh = high_wm;
+    cache->low_wm      = low_wm;
     cache->len         = 0;
 }
 
@@ -170,7 +171,8 @@ mempool_create_empty(struct mempool_cfg *ci)
     /* Init all default caches. */
     if (ci->cache_sz != 0) {
         for (int i = 0; i < thds; i++)
-            mempool_cache_init(&mp->cache[i], ci->cache_sz);
+            mempool_cache_init(&mp->cache[i], ci->cache_sz, 0,
+                               CALC_CACHE_FLUSHTHRESH(ci->cache_sz));
     }
 
     return mp;
@@ -223,6 +225,82 @@ mempool_default_cache(mempool_t *_mp)
     return &mp->cache[id];
 }
 
+struct mempool_cache *
+mempool_cache_create(mempool_t *_mp, uint32_t size, uint32_t low_wm, uint32_t high_wm)
+{
+    struct cne_mempool *mp = _mp;
+    struct mempool_cache *cache;
+
+    errno = EINVAL;
+    if (!mp)
+        CNE_NULL_RET("Mempool pointer is NULL\n");
+
+    if (size == 0 || size > MEMPOOL_CACHE_MAX_SIZE || size > mp->obj_cnt)
+        CNE_NULL_RET("Cache size %u is invalid for mempool\n", size);
+
+    CNE_DEFAULT_SET(high_wm, 0, CALC_CACHE_FLUSHTHRESH(size));
+
+    /* A put of up to MEMPOOL_CACHE_MAX_SIZE objects below high_wm must fit in objs[] */
+    if (low_wm >= size || high_wm <= size || high_wm > (MEMPOOL_CACHE_MAX_SIZE * 2))
+        CNE_NULL_RET("Cache watermarks low %u, high %u are invalid for size %u\n", low_wm,
+                     high_wm, size);
+
+    cache = calloc(1, sizeof(struct mempool_cache));
+    if (!cache) {
+        errno = ENOMEM;
+        CNE_NULL_RET("Failed to allocate mempool cache\n");
+    }
+    errno = 0;
+
+    mempool_cache_init(cache, size, low_wm, high_wm);
+
+    return cache;
+}
+
+void
+mempool_cache_flush(mempool_t *_mp, struct mempool_cache *cache)
+{
+    struct cne_mempool *mp = _mp;
+
+    if (!mp || !cache || cache->len == 0)
+        return;
+
+    mempool_ring_enqueue(mp, cache->objs, cache->len);
+    cache->len = 0;
+}
+
+void
+mempool_cache_destroy(mempool_t *mp, struct mempool_cache *cache)
+{
+    if (!cache)
+        return;
+
+    mempool_cache_flush(mp, cache);
+    free(cache);
+}
+
+int
+mempool_cache_stats_get(mempool_t *_mp, mempool_cache_stats_t *stats)
+{
+    struct cne_mempool *mp = _mp;
+
+    if (!mp || !stats)
+        return -1;
+
+    memset(stats, 0, sizeof(mempool_cache_stats_t));
+
+    for (int i = 0; i < cne_max_threads(); i++) {
+        struct mempool_stats *st = &mp->stats[i];
+
+        stats->hits += st->cache_hits;
+        stats->misses += st->cache_misses;
+        stats->refills += st->cache_refills;
+        stats->flushes += st->cache_flushes;
+    }
+
+    return 0;
+}
+
 /**
  * @internal Put several objects back in the mempool; used internally.
  * @param mp
@@ -266,6 +344,7 @@ __mempool_generic_put(mempool_t *_mp, void *const *obj_table, unsigned int n,
     if (cache->len >= cache->flushthresh) {
         mempool_ring_enqueue(mp, &cache->objs[cache->size], cache->len - cache->size);
         cache->len = cache->size;
+        __MEMPOOL_CACHE_STAT_INC(mp, flushes);
     }
 
     return;
@@ -325,31 +404,42 @@ __mempool_generic_get(struct cne_mempool *mp, void **obj_table, unsigned int n,
     uint32_t index, len;
     void **cache_objs;
 
-    /* No cache provided or cannot be satisfied from cache */
-    if (unlikely(cache == NULL || n >= cache->size))
+    /* No cache provided */
+    if (unlikely(cache == NULL))
+        goto ring_dequeue;
+
+    /* Cannot be satisfied from cache */
+    if (unlikely(n >= cache->size)) {
+        __MEMPOOL_CACHE_STAT_INC(mp, misses);
         goto ring_dequeue;
+    }
 
     cache_objs = cache->objs;
 
-    /* Can this be satisfied from the cache? */
-    if (cache->len < n) {
+    /* Can this be satisfied from the cache without dropping below the low watermark? */
+    if (cache->len < n + cache->low_wm) {
         /* No. Backfill the cache first, and then fill from it */
         uint32_t req = n + (cache->size - cache->len);
 
+        __MEMPOOL_CACHE_STAT_INC(mp, misses);
+
         /* How many do we require i.e. number to fill the cache + the request */
         ret = mempool_ring_dequeue(mp, &cache->objs[cache->len], req);
         if (unlikely(ret < 0)) {
             /*
              * In the off chance that we are buffer constrained,
-             * where we are not able to allocate cache + n, go to
-             * the ring directly. If that fails, we are truly out of
-             * buffers.
+             * where we are not able to allocate cache + n, use what
+             * is left in the cache or go to the ring directly. If
+             * that fails, we are truly out of buffers.
              */
-            goto ring_dequeue;
+            if (cache->len < n)
+                goto ring_dequeue;
+        } else {
+            cache->len += req;
+            __MEMPOOL_CACHE_STAT_INC(mp, refills);
         }
-
-        cache->len += req;
-    }
+    } else
+        __MEMPOOL_CACHE_STAT_INC(mp, hits);
 
     /* Now fill in the response ... */
     for (index = 0, len = cache->len - 1; index < n; ++index, len--, obj_table++)
@@ -439,6 +529,7 @@ void
 mempool_dump(mempool_t *_mp)
 {
     struct cne_mempool *mp = _mp;
+    mempool_cache_stats_t cs;
     unsigned common_count;
 
     if (mp == NULL)
@@ -464,6 +555,14 @@ mempool_dump(mempool_t *_mp)
                    mp->stats->get_fail_bulk);
         cne_printf("   [magenta]Get failed  Objs[]: [cyan]%12" PRIu64 "[]\n",
                    mp->stats->get_fail_objs);
+
+        mempool_cache_stats_get(mp, &cs);
+        if (cs.hits + cs.misses) {
+            cne_printf("   [magenta]Cache Hit   Rate[]: [cyan]%11.1f%%[]\n",
+                       (double)(cs.hits * 100) / (double)(cs.hits + cs.misses));
+            cne_printf("   [magenta]Cache    Refills[]: [cyan]%12" PRIu64 "[]\n", cs.refills);
+            cne_printf("   [magenta]Cache    Flushes[]: [cyan]%12" PRIu64 "[]\n", cs.flushes);
+        }
     }
 
     if (!mp->cache_sz)
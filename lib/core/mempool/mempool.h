@@ -101,6 +101,16 @@ typedef struct mempool_cfg {
     void *obj_init_arg;         /**< Argument to pass to obj_init function */
 } mempool_cfg_t;
 
+/**
+ * Mempool cache statistics, summed over all threads and all caches of a mempool.
+ */
+typedef struct mempool_cache_stats {
+    uint64_t hits;    /**< Number of gets served from a cache without touching the ring */
+    uint64_t misses;  /**< Number of gets with a cache that had to touch the ring */
+    uint64_t refills; /**< Number of bulk refills of a cache from the ring */
+    uint64_t flushes; /**< Number of bulk flushes of a cache to the ring */
+} mempool_cache_stats_t;
+
 /**
  * Create a new mempool in memory.
  *
@@ -196,6 +206,62 @@ CNDP_API void mempool_dump(mempool_t *mp);
  */
 CNDP_API struct mempool_cache *mempool_default_cache(mempool_t *mp);
 
+/**
+ * Create a mempool cache, which is owned by the caller and not tied to a thread.
+ *
+ * The cache is used by passing it to mempool_generic_get() and mempool_generic_put()
+ * and must only be used by one thread at a time. A get that would leave fewer than
+ * low_wm objects in the cache refills it from the ring in one bulk to size objects
+ * after the get. A put that fills the cache to high_wm or more objects flushes it
+ * to the ring in one bulk down to size objects.
+ *
+ * @param mp
+ *   A pointer to the mempool structure the cache gets objects from.
+ * @param size
+ *   The number of objects held after a refill or a flush, 1 to MEMPOOL_CACHE_MAX_SIZE.
+ * @param low_wm
+ *   The low watermark, must be less than size. Zero only refills an empty cache.
+ * @param high_wm
+ *   The high watermark, must be greater than size and at most 2 * MEMPOOL_CACHE_MAX_SIZE.
+ *   Zero selects the default of 1.5 * size.
+ * @return
+ *   A pointer to the mempool cache or NULL on error with errno set.
+ */
+CNDP_API struct mempool_cache *mempool_cache_create(mempool_t *mp, uint32_t size, uint32_t low_wm,
+                                                    uint32_t high_wm);
+
+/**
+ * Return all objects held in a mempool cache to the mempool.
+ *
+ * @param mp
+ *   A pointer to the mempool structure the cache belongs to.
+ * @param cache
+ *   A pointer to the mempool cache created by mempool_cache_create().
+ */
+CNDP_API void mempool_cache_flush(mempool_t *mp, struct mempool_cache *cache);
+
+/**
+ * Flush and free a mempool cache created by mempool_cache_create().
+ *
+ * @param mp
+ *   A pointer to the mempool structure the cache belongs to.
+ * @param cache
+ *   A pointer to the mempool cache to free, can be NULL.
+ */
+CNDP_API void mempool_cache_destroy(mempool_t *mp, struct mempool_cache *cache);
+
+/**
+ * Get the cache statistics of a mempool, the hit rate is hits / (hits + misses).
+ *
+ * @param mp
+ *   A pointer to the mempool structure.
+ * @param stats
+ *   The mempool_cache_stats_t structure to fill in.
+ * @return
+ *   0 on success or -1 on error.
+ */
+CNDP_API int mempool_cache_stats_get(mempool_t *mp, mempool_cache_stats_t *stats);
+
 /**
  * Put several objects back in the mempool.
  *
@@ -43,6 +43,10 @@ struct mempool_stats {
     uint64_t get_success_objs; /**< Objects successfully allocated. */
     uint64_t get_fail_bulk;    /**< Failed allocation number. */
     uint64_t get_fail_objs;    /**< Objects that failed to be allocated. */
+    uint64_t cache_hits;       /**< Gets served from a cache without touching the ring. */
+    uint64_t cache_misses;     /**< Gets with a cache that had to touch the ring. */
+    uint64_t cache_refills;    /**< Bulk refills of a cache from the ring. */
+    uint64_t cache_flushes;    /**< Bulk flushes of a cache to the ring. */
 } __cne_cache_aligned;
 
 /**
@@ -52,7 +56,8 @@ struct mempool_stats {
 
 struct mempool_cache {
     uint32_t size;        /**< Size of the cache */
-    uint32_t flushthresh; /**< Threshold before we flush excess elements */
+    uint32_t flushthresh; /**< Threshold before we flush excess elements, the high watermark */
+    uint32_t low_wm;      /**< Refill when a get would leave fewer elements, the low watermark */
     uint32_t len;         /**< Current cache count */
     /*
      * Cache is allocated to this size to allow it to overflow in certain
@@ -80,6 +85,10 @@ struct cne_mempool {
         mp->stats[__uid].name##_objs += n;      \
         mp->stats[__uid].name##_bulk += 1;      \
     } while(0)
+
+#define __MEMPOOL_CACHE_STAT_INC(mp, name) do { \
+        mp->stats[cne_id()].cache_##name++;     \
+    } while(0)
 // clang-format on
 
 #ifdef __cplusplus
@@ -16,7 +16,11 @@
 #include <unistd.h>            // for getpagesize
 #include <stdint.h>            // for uint64_t, uint32_t
 #include <stdlib.h>            // for free, calloc
+#include <limits.h>            // for CHAR_BIT
 #include <cne_mmap.h>
+#ifdef CNE_HAS_LIBNUMA
+#include <numaif.h>        // for mbind, move_pages, MPOL_PREFERRED
+#endif
 
 #include "mmap_private.h"        // for mmap_data
 #include "cne_mmap.h"            // for mmap_sizes_t, MMAP_HUGEPAGE_4KB, MMAP_HUGE...
@@ -138,11 +142,76 @@ mmap_set_default_by_name(const char *name)
     mmap_set_default(mmap_type_by_name(name));
 }
 
+#ifdef CNE_HAS_LIBNUMA
+#define MMAP_NODEMASK_LONGS 16  /**< Number of longs in the node mask given to mbind() */
+#define MMAP_QUERY_PAGES    256 /**< Number of pages queried at a time with move_pages() */
+
+/*
+ * Set the policy of the region before the pages are faulted in. The policy is preferred and
+ * not bind, so a node out of hugepages falls back to another node instead of a SIGBUS.
+ */
+static void
+mmap_bind(void *va, size_t sz, int node)
+{
+    unsigned long mask[MMAP_NODEMASK_LONGS] = {0};
+    const int bits                          = sizeof(unsigned long) * CHAR_BIT;
+
+    if (node >= MMAP_NODEMASK_LONGS * bits) {
+        CNE_WARN("NUMA node %d is out of range, using the default policy\n", node);
+        return;
+    }
+    mask[node / bits] = 1UL << (node % bits);
+
+    if (mbind(va, sz, MPOL_PREFERRED, mask, sizeof(mask) * CHAR_BIT, 0))
+        CNE_WARN("Failed to bind memory to NUMA node %d: %s\n", node, strerror(errno));
+}
+
+/* Count the pages of the region which are not on the requested node */
+static uint64_t
+mmap_remote_pages(struct mmap_data *mm)
+{
+    void *pages[MMAP_QUERY_PAGES];
+    int status[MMAP_QUERY_PAGES];
+    uint64_t nb_pages = mm->sz / mm->align, remote = 0;
+
+    for (uint64_t i = 0; i < nb_pages; i += MMAP_QUERY_PAGES) {
+        unsigned long n = CNE_MIN(nb_pages - i, (uint64_t)MMAP_QUERY_PAGES);
+
+        for (unsigned long j = 0; j < n; j++)
+            pages[j] = CNE_PTR_ADD(mm->addr, (i + j) * mm->align);
+
+        if (move_pages(0, n, pages, NULL, status, 0)) {
+            CNE_WARN("Failed to get the NUMA node of pages: %s\n", strerror(errno));
+            return 0;
+        }
+
+        for (unsigned long j = 0; j < n; j++)
+            if (status[j] >= 0 && status[j] != mm->numa_node)
+                remote++;
+    }
+
+    return remote;
+}
+#else
+static void
+mmap_bind(void *va __cne_unused, size_t sz __cne_unused, int node)
+{
+    CNE_WARN("NUMA node %d ignored, CNDP was built without libnuma\n", node);
+}
+
+static uint64_t
+mmap_remote_pages(struct mmap_data *mm __cne_unused)
+{
+    return 0;
+}
+#endif
+
 static void *
 __alloc_mem(struct mmap_data *mm, mmap_type_t typ)
 {
-    int flags = MAP_SHARED | MAP_ANONYMOUS | MAP_POPULATE;
+    int flags = MAP_SHARED | MAP_ANONYMOUS;
     uint64_t len;
+    void *va;
 
     mm->typ   = typ;
     mm->align = mmap_stats.sizes[typ].page_sz;
@@ -152,14 +221,28 @@ __alloc_mem(struct mmap_data *mm, mmap_type_t typ)
 
     flags |= pagesz_flags(mmap_stats.sizes[typ].page_sz);
 
+    /* Pages bound to a node are populated by mmap_alloc_numa() once the policy is set */
+    if (mm->numa_node == MMAP_NUMA_NODE_ANY)
+        flags |= MAP_POPULATE;
+
     /* map the segment, and populate page tables, the kernel fills
      * this segment with zeros if it's a new page.
      */
-    return mmap(NULL, mm->sz, PROT_READ | PROT_WRITE, flags, -1, 0);
+    va = mmap(NULL, mm->sz, PROT_READ | PROT_WRITE, flags, -1, 0);
+    if (va != MAP_FAILED && mm->numa_node != MMAP_NUMA_NODE_ANY)
+        mmap_bind(va, mm->sz, mm->numa_node);
+
+    return va;
 }
 
 mmap_t *
 mmap_alloc(uint32_t bufcnt, uint32_t bufsz, mmap_type_t typ)
+{
+    return mmap_alloc_numa(bufcnt, bufsz, typ, MMAP_NUMA_NODE_ANY);
+}
+
+mmap_t *
+mmap_alloc_numa(uint32_t bufcnt, uint32_t bufsz, mmap_type_t typ, int numa_node)
 {
     struct mmap_data *mm;
     void *va;
@@ -182,8 +265,9 @@ mmap_alloc(uint32_t bufcnt, uint32_t bufsz, mmap_type_t typ)
     if (!bufcnt || !bufsz)
         CNE_ERR_GOTO(leave, "bufcnt %u * bufsz %u is zero\n", bufcnt, bufsz);
 
-    mm->bufcnt = bufcnt;
-    mm->bufsz  = bufsz;
+    mm->bufcnt    = bufcnt;
+    mm->bufsz     = bufsz;
+    mm->numa_node = (numa_node < 0) ? MMAP_NUMA_NODE_ANY : numa_node;
 
 retry:
     /* Try the requested size and if not available, degrade to the next available size */
@@ -259,9 +343,23 @@ retry:
      * kernel populates the page with zeroes initially.
      */
     start_sigbus_handler();
-    *(volatile int *)va = *(volatile int *)va;
+    if (mm->numa_node == MMAP_NUMA_NODE_ANY)
+        *(volatile int *)va = *(volatile int *)va;
+    else {
+        /* Fault in every page now that the NUMA policy of the region is set */
+        for (size_t off = 0; off < mm->sz; off += mm->align)
+            *(volatile int *)CNE_PTR_ADD(va, off) = *(volatile int *)CNE_PTR_ADD(va, off);
+    }
     stop_sigbus_handler();
 
+    if (mm->numa_node != MMAP_NUMA_NODE_ANY) {
+        mm->remote_pages = mmap_remote_pages(mm);
+        if (mm->remote_pages)
+            CNE_WARN("%'ld of %'ld %s pages are not on NUMA node %d\n", mm->remote_pages,
+                     mm->sz / mm->align, mmap_types[mm->typ].name, mm->numa_node);
+        mmap_stats.sizes[mm->typ].remote_pages += mm->remote_pages;
+    }
+
     mmap_stats.sizes[typ].allocated += mm->sz;
     mmap_stats.sizes[typ].num_allocated++;
 
@@ -317,6 +415,31 @@ mmap_addr(mmap_t *_mm)
     return mmap_addr_at_offset(_mm, 0);
 }
 
+int
+mmap_numa_node(mmap_t *_mm, uint64_t *remote_pages)
+{
+    struct mmap_data *mm = _mm;
+
+    if (!mm)
+        return MMAP_NUMA_NODE_ANY;
+
+    if (remote_pages)
+        *remote_pages = mm->remote_pages;
+
+    return mm->numa_node;
+}
+
+int
+mmap_stats_get(mmap_stats_t *stats)
+{
+    if (!stats)
+        return -1;
+
+    *stats = mmap_stats;
+
+    return 0;
+}
+
 size_t
 mmap_size(mmap_t *_mm, uint32_t *bufcnt, uint32_t *bufsz)
 {
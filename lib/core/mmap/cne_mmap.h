@@ -33,6 +33,8 @@ typedef enum {
 
 #define MMAP_HUGEPAGE_DEFAULT MMAP_HUGEPAGE_4KB
 
+#define MMAP_NUMA_NODE_ANY -1 /**< Allocate memory on any NUMA node */
+
 /**
  * A set of stats for mmap allocation/free and other stats
  */
@@ -42,6 +44,7 @@ typedef struct {
     uint64_t num_freed;     /**< Number of freed memory */
     uint64_t allocated;     /**< Number of times memory has been allocated */
     uint64_t freed;         /**< Number of times memory has been freed */
+    uint64_t remote_pages;  /**< Number of pages allocated off the requested NUMA node */
 } mmap_sizes_t;
 
 /**
@@ -55,7 +58,7 @@ typedef struct {
 typedef void mmap_t; /**< Opaque pointer to internal mmap data */
 
 /**
- * Allocate memory on the correct socket and use hugepages if set.
+ * Allocate memory using the default NUMA policy and use hugepages if set.
  *
  * @param bufcnt
  *   Number of buffers in the memory pool
@@ -68,6 +71,49 @@ typedef void mmap_t; /**< Opaque pointer to internal mmap data */
  */
 CNDP_API mmap_t *mmap_alloc(uint32_t bufcnt, uint32_t bufsz, mmap_type_t hugepage);
 
+/**
+ * Allocate memory on a NUMA node and use hugepages if set.
+ *
+ * The pages are bound to the node with a preferred policy before they are faulted in, so
+ * the allocation falls back to other nodes when the node runs out of pages. The pages that
+ * landed on another node are counted in the remote_pages stats and a warning is logged.
+ *
+ * @param bufcnt
+ *   Number of buffers in the memory pool
+ * @param bufsz
+ *   The size of the buffers in the memory pool
+ * @param hugepage
+ *   Type of hugepage memory to allocate or non-hugepage memory.
+ * @param numa_node
+ *   The NUMA node of the memory, MMAP_NUMA_NODE_ANY to use the default policy.
+ * @return
+ *   The mmap_t structure pointer of the memory allocated or NULL on error
+ */
+CNDP_API mmap_t *mmap_alloc_numa(uint32_t bufcnt, uint32_t bufsz, mmap_type_t hugepage,
+                                 int numa_node);
+
+/**
+ * Return the NUMA node requested for the memory and the number of pages off that node.
+ *
+ * @param mm
+ *   The mmap_t pointer
+ * @param remote_pages
+ *   A uint64_t location to place the number of pages not on the node, can be NULL.
+ * @return
+ *   The NUMA node of the memory or MMAP_NUMA_NODE_ANY if none was requested
+ */
+CNDP_API int mmap_numa_node(mmap_t *mm, uint64_t *remote_pages);
+
+/**
+ * Copy the allocation stats of all page sizes
+ *
+ * @param stats
+ *   The location to copy the stats to
+ * @return
+ *   0 on success or -1 on error
+ */
+CNDP_API int mmap_stats_get(mmap_stats_t *stats);
+
 /**
  * Free the memory allocated
  *
@@ -22,12 +22,14 @@ extern "C" {
 #endif
 
 struct mmap_data {
-    uint32_t bufcnt; /**< Number of buffers in the pool */
-    uint32_t bufsz;  /**< Size of each buffer in the pool */
-    size_t sz;       /**< Real size of the memory region  (bufcnt * bufsz) */
-    void *addr;      /**< Address of the memory region */
-    mmap_type_t typ; /**< Type of memory allocated */
-    unsigned align;  /**< Alignment value */
+    uint32_t bufcnt;       /**< Number of buffers in the pool */
+    uint32_t bufsz;        /**< Size of each buffer in the pool */
+    size_t sz;             /**< Real size of the memory region  (bufcnt * bufsz) */
+    void *addr;            /**< Address of the memory region */
+    mmap_type_t typ;       /**< Type of memory allocated */
+    unsigned align;        /**< Alignment value */
+    int numa_node;         /**< NUMA node of the memory or MMAP_NUMA_NODE_ANY */
+    uint64_t remote_pages; /**< Number of pages not on numa_node */
 };
 
 #ifdef __cplusplus
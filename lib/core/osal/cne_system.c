@@ -224,6 +224,28 @@ err:
     return 0;
 }
 
+int
+cne_device_numa_node(const char *netdev)
+{
+    char path[PATH_MAX];
+    unsigned long numa;
+    int len;
+
+    if (!netdev)
+        return -1;
+
+    /* Virtual netdevs have no device directory */
+    len = snprintf(path, sizeof(path), NIC_NUMA_NODE_PATH, netdev);
+    if (len <= 0 || (unsigned)len >= sizeof(path) || access(path, F_OK))
+        return -1;
+
+    /* The kernel reports -1 when the node is unknown */
+    if (parse_sysfs_value(path, &numa) != 0 || (long)numa < 0)
+        return -1;
+
+    return (int)numa;
+}
+
 unsigned int
 cne_max_lcores(void)
 {
@@ -94,6 +94,17 @@ CNDP_API unsigned int cne_socket_id_self(void);
  */
 CNDP_API uint16_t cne_device_socket_id(char *netdev);
 
+/**
+ * Return the NUMA node of the device behind a netdev
+ *
+ * @param netdev
+ *   The netdev name string.
+ * @return
+ *   The NUMA node of the netdev or -1 if the netdev has no device, e.g. a veth, or the
+ *   kernel does not know its node.
+ */
+CNDP_API int cne_device_numa_node(const char *netdev);
+
 /**
  * Return number of physical sockets detected on the system.
  *
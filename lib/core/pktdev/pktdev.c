@@ -93,6 +93,9 @@ pktdev_allocate(const char *name, const char *ifname)
     dev       = &pktdev_devices[lport_id];
     dev->data = &pktdev_data[lport_id];
 
+    /* Clear any queue state left behind by a previous user of this lport */
+    memset(dev->data, 0, sizeof(struct pktdev_data));
+
     strlcpy(dev->data->name, name, sizeof(dev->data->name));
     if (strncmp(dev->data->name, name, name_len) != 0) {
         dev->state = PKTDEV_UNUSED;
@@ -275,6 +278,73 @@ pktdev_stats_get(uint16_t lport_id, lport_stats_t *stats)
     return CALL_PMD(dev->dev_ops->stats_get, dev, stats);
 }
 
+int
+pktdev_queue_stats_get(uint16_t lport_id, uint16_t qid, lport_stats_t *stats)
+{
+    struct cne_pktdev *dev;
+
+    if (!stats || lport_id >= CNE_MAX_ETHPORTS)
+        return -EINVAL;
+
+    dev = &pktdev_devices[lport_id];
+    if (!dev->data || !dev->dev_ops)
+        return -EINVAL;
+
+    if (qid >= CNE_MAX(dev->data->nb_rx_queues, dev->data->nb_tx_queues))
+        return -EINVAL;
+
+    memset(stats, 0, sizeof(*stats));
+
+    /* A single queue lport has the same stats for the port and its only queue */
+    if (!dev->dev_ops->queue_stats_get && dev->data->nb_rx_queues <= 1 &&
+        dev->data->nb_tx_queues <= 1)
+        return CALL_PMD(dev->dev_ops->stats_get, dev, stats);
+
+    return CALL_PMD(dev->dev_ops->queue_stats_get, dev, qid, stats);
+}
+
+int
+pktdev_queue_fd_get(uint16_t lport_id, uint16_t qid, int *rx_fd, int *tx_fd)
+{
+    struct cne_pktdev *dev;
+    struct pktdev_info info;
+    int ret;
+
+    if (lport_id >= CNE_MAX_ETHPORTS)
+        return -EINVAL;
+
+    dev = &pktdev_devices[lport_id];
+    if (!dev->data || !dev->dev_ops)
+        return -EINVAL;
+
+    if (qid >= CNE_MAX(dev->data->nb_rx_queues, dev->data->nb_tx_queues))
+        return -EINVAL;
+
+    if (rx_fd)
+        *rx_fd = -1;
+    if (tx_fd)
+        *tx_fd = -1;
+
+    if (dev->dev_ops->queue_fd_get)
+        return dev->dev_ops->queue_fd_get(dev, qid, rx_fd, tx_fd);
+
+    /* A single queue lport has the same file descriptors for the port and its only queue */
+    if (qid != 0)
+        return -ENOTSUP;
+
+    memset(&info, 0, sizeof(info));
+    ret = CALL_PMD(dev->dev_ops->dev_infos_get, dev, &info);
+    if (ret < 0)
+        return ret;
+
+    if (rx_fd)
+        *rx_fd = info.rx_fd;
+    if (tx_fd)
+        *tx_fd = info.tx_fd;
+
+    return 0;
+}
+
 int
 pktdev_stats_reset(uint16_t lport_id)
 {
@@ -316,7 +386,9 @@ pktdev_info_get(uint16_t lport_id, struct pktdev_info *dev_info)
         return diag;
     }
 
-    dev_info->admin_state = dev->data->admin_state;
+    dev_info->admin_state  = dev->data->admin_state;
+    dev_info->nb_rx_queues = dev->data->nb_rx_queues;
+    dev_info->nb_tx_queues = dev->data->nb_tx_queues;
 
     return 0;
 }
@@ -95,8 +95,10 @@ struct pktdev_info {
     struct pktdev_portconf default_txportconf;
     /** Generic device capabilities (PKTDEV_DEV_CAPA_). */
     uint64_t dev_capa;
-    int rx_fd; /**< The Rx file descriptor value or -1 if not available */
-    int tx_fd; /**< The Tx file descriptor value or -1 if not available */
+    int rx_fd;             /**< The Rx file descriptor value or -1 if not available */
+    int tx_fd;             /**< The Tx file descriptor value or -1 if not available */
+    uint16_t nb_rx_queues; /**< Number of RX queues owned by the lport */
+    uint16_t nb_tx_queues; /**< Number of TX queues owned by the lport */
 } __cne_cache_aligned;
 
 #include <pktdev_api.h>         // for pktdev_admin_state
@@ -282,6 +284,99 @@ pktdev_tx_burst(uint16_t lport_id, pktmbuf_t **tx_pkts, uint16_t nb_pkts)
     return (*dev->tx_pkt_burst)(dev->data->tx_queue, tx_pkts, nb_pkts);
 }
 
+/**
+ * Retrieve a burst of input packets from a given receive queue of a multi-queue lport.
+ *
+ * Same as pktdev_rx_burst(), but receives from queue *qid* of the lport, where
+ * *qid* is the queue index within the lport (0 to nb_rx_queues - 1) and not the
+ * netdev queue ID. Queue 0 is the queue used by pktdev_rx_burst(). Each queue must
+ * only be polled by a single thread at a time.
+ *
+ * @param lport_id
+ *   The lport identifier of the Ethernet device.
+ * @param qid
+ *   The queue index within the lport, see pktdev_info.nb_rx_queues.
+ * @param rx_pkts
+ *   The address of an array of pointers to *pktmbuf* structures that
+ *   must be large enough to store *nb_pkts* pointers in it.
+ * @param nb_pkts
+ *   The maximum number of packets to retrieve.
+ * @return
+ *   The number of packets actually retrieved, 0 if *qid* is not a valid queue or
+ *   0xFFFF on admin_state_down.
+ */
+static inline uint16_t
+pktdev_rx_burst_q(uint16_t lport_id, uint16_t qid, pktmbuf_t **rx_pkts, const uint16_t nb_pkts)
+{
+    struct cne_pktdev *dev = &pktdev_devices[lport_id];
+
+#ifdef PKTDEV_DEBUG
+    if (dev->rx_pkt_burst == NULL)
+        return 0;
+#endif
+
+    if (unlikely(qid >= dev->data->nb_rx_queues))
+        return 0;
+
+    /* Check packet stream status */
+    if (!pktdev_admin_state(lport_id)) {
+        CNE_DEBUG("Packet stream is disabled for '%d'\n", lport_id);
+        return PKTDEV_ADMIN_STATE_DOWN;
+    }
+
+    return (*dev->rx_pkt_burst)(dev->data->rx_queues[qid], rx_pkts, nb_pkts);
+}
+
+/**
+ * Send a burst of output packets on a given transmit queue of a multi-queue lport.
+ *
+ * Same as pktdev_tx_burst(), but transmits on queue *qid* of the lport, where
+ * *qid* is the queue index within the lport (0 to nb_tx_queues - 1). Queue 0 is
+ * the queue used by pktdev_tx_burst(). Each queue must only be used by a single
+ * thread at a time.
+ *
+ * @param lport_id
+ *   The lport identifier of the Ethernet device.
+ * @param qid
+ *   The queue index within the lport, see pktdev_info.nb_tx_queues.
+ * @param tx_pkts
+ *   The address of an array of *nb_pkts* pointers to *pktmbuf* structures
+ *   which contain the output packets.
+ * @param nb_pkts
+ *   The maximum number of packets to transmit.
+ * @return
+ *   The number of output packets actually stored in transmit descriptors of
+ *   the transmit ring, 0 if *qid* is not a valid queue or 0xFFFF on admin_state_down.
+ */
+static inline uint16_t
+pktdev_tx_burst_q(uint16_t lport_id, uint16_t qid, pktmbuf_t **tx_pkts, uint16_t nb_pkts)
+{
+    struct cne_pktdev *dev;
+
+#ifdef PKTDEV_DEBUG
+    if (lport_id >= CNE_MAX_ETHPORTS)
+        return 0;
+#endif
+
+    dev = &pktdev_devices[lport_id];
+
+#ifdef PKTDEV_DEBUG
+    if (dev->tx_pkt_burst == NULL)
+        return 0;
+#endif
+
+    if (unlikely(qid >= dev->data->nb_tx_queues))
+        return 0;
+
+    /* Check packet stream status */
+    if (!pktdev_admin_state(lport_id)) {
+        CNE_DEBUG("Packet stream is disabled for '%d'\n", lport_id);
+        return PKTDEV_ADMIN_STATE_DOWN;
+    }
+
+    return (*dev->tx_pkt_burst)(dev->data->tx_queues[qid], tx_pkts, nb_pkts);
+}
+
 /**
  * Process a burst of output packets on a transmit queue of an Ethernet device.
  *
@@ -34,6 +34,7 @@ int
 pktdev_port_setup(lport_cfg_t *c)
 {
     struct pktdev_driver *drv = NULL;
+    struct pktdev_data *data;
     int lport;
 
     if (!c)
@@ -53,6 +54,17 @@ pktdev_port_setup(lport_cfg_t *c)
         CNE_ERR_RET("Invalid port number %d >= CNE_MAX_ETHPORTS\n", lport);
     pktdev_devices[lport].state = PKTDEV_ACTIVE;
 
+    /* Single queue PMDs only set rx_queue/tx_queue, expose them as queue 0 */
+    data = pktdev_devices[lport].data;
+    if (data->nb_rx_queues == 0) {
+        data->rx_queues[0] = data->rx_queue;
+        data->nb_rx_queues = 1;
+    }
+    if (data->nb_tx_queues == 0) {
+        data->tx_queues[0] = data->tx_queue;
+        data->nb_tx_queues = 1;
+    }
+
     if (pktdev_start(lport) < 0)
         CNE_ERR_RET("pktdev_start(%d) failed\n", lport);
 
@@ -100,6 +112,13 @@ pktdev_offloads_get(uint16_t lport_id, struct offloads *off)
 
     dev = &pktdev_devices[lport_id];
 
+    /* A PMD without offload support leaves the offloads pointer NULL */
+    if (!dev->data || !dev->data->offloads) {
+        off->tx_checksum_offload = 0;
+        off->rx_checksum_offload = 0;
+        return 0;
+    }
+
     off->tx_checksum_offload = dev->data->offloads->tx_checksum_offload;
     off->rx_checksum_offload = dev->data->offloads->rx_checksum_offload;
 
@@ -118,6 +137,7 @@ lport_cfg_dump(FILE *f, lport_cfg_t *c)
         cne_fprintf(f, "  netdev          : %s\n", c->ifname);
         cne_fprintf(f, "  pmd_name        : %s\n", c->pmd_name);
         cne_fprintf(f, "  qid             : %u\n", c->qid);
+        cne_fprintf(f, "  nb_queues       : %u\n", c->nb_queues);
         cne_fprintf(f, "  bufcnt          : %u\n", c->bufcnt);
         cne_fprintf(f, "  bufsz           : %u\n", c->bufsz);
     }
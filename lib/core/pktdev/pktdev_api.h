@@ -201,6 +201,45 @@ CNDP_API int pktdev_close_all(void);
  */
 CNDP_API int pktdev_stats_get(uint16_t lport_id, lport_stats_t *stats);
 
+/**
+ * Retrieve the I/O statistics of a single queue of a multi-queue lport.
+ *
+ * The statistics returned by pktdev_stats_get() are the sum of all queues of the lport.
+ *
+ * @param lport_id
+ *   The lport identifier of the Ethernet device.
+ * @param qid
+ *   The queue index within the lport, 0 to pktdev_info.nb_rx_queues - 1.
+ * @param stats
+ *   A pointer to a structure of type *lport_stats* to be filled with the queue counters.
+ * @return
+ *   - (0) if successful.
+ *   - (-EINVAL) if *lport_id*, *qid* or *stats* is invalid.
+ *   - (-ENOTSUP) if per queue statistics are not supported by the PMD.
+ */
+CNDP_API int pktdev_queue_stats_get(uint16_t lport_id, uint16_t qid, lport_stats_t *stats);
+
+/**
+ * Retrieve the file descriptors of a single queue of a multi-queue lport.
+ *
+ * The RX file descriptor can be added to an idlemgr instance to wait for packets
+ * on the queue, see pktdev_info.rx_fd for the single queue case.
+ *
+ * @param lport_id
+ *   The lport identifier of the Ethernet device.
+ * @param qid
+ *   The queue index within the lport, 0 to pktdev_info.nb_rx_queues - 1.
+ * @param rx_fd
+ *   Location to store the RX file descriptor or -1 if not available, can be NULL.
+ * @param tx_fd
+ *   Location to store the TX file descriptor or -1 if not available, can be NULL.
+ * @return
+ *   - (0) if successful.
+ *   - (-EINVAL) if *lport_id* or *qid* is invalid.
+ *   - (-ENOTSUP) if per queue file descriptors are not supported by the PMD.
+ */
+CNDP_API int pktdev_queue_fd_get(uint16_t lport_id, uint16_t qid, int *rx_fd, int *tx_fd);
+
 /**
  * Reset the general I/O statistics of an Ethernet device.
  *
@@ -48,6 +48,12 @@ typedef int (*eth_link_update_t)(struct cne_pktdev *dev, int wait_to_complete);
 typedef int (*eth_stats_get_t)(struct cne_pktdev *dev, lport_stats_t *igb_stats);
 /**< @internal Get global I/O statistics of an Ethernet device. */
 
+typedef int (*eth_queue_stats_get_t)(struct cne_pktdev *dev, uint16_t qid, lport_stats_t *stats);
+/**< @internal Get I/O statistics of a single queue of an Ethernet device. */
+
+typedef int (*eth_queue_fd_get_t)(struct cne_pktdev *dev, uint16_t qid, int *rx_fd, int *tx_fd);
+/**< @internal Get the file descriptors of a single queue of an Ethernet device. */
+
 /**
  * @internal
  * Reset global I/O statistics of an Ethernet device to 0.
@@ -168,6 +174,8 @@ struct pktdev_ops {
     eth_mac_addr_set_t mac_addr_set;          /**< Set a MAC address. */
     eth_link_update_t link_update;            /**< Get device link state. */
     eth_stats_get_t stats_get;                /**< Get generic device statistics. */
+    eth_queue_stats_get_t queue_stats_get;    /**< Get per queue device statistics. */
+    eth_queue_fd_get_t queue_fd_get;          /**< Get per queue file descriptors. */
     eth_stats_reset_t stats_reset;            /**< Reset generic device statistics. */
     eth_tx_done_cleanup_t tx_done_cleanup;    /**< Free tx ring mbufs */
     eth_pkt_alloc pkt_alloc;                  /**< Allocate pktmbuf_t function pointers */
@@ -205,17 +213,21 @@ extern struct cne_pktdev pktdev_devices[CNE_MAX_ETHPORTS];
  * processes in a multi-process configuration.
  */
 struct pktdev_data {
-    char name[PKTDEV_NAME_MAX_LEN];   /**< Unique identifier name */
-    char ifname[PKTDEV_NAME_MAX_LEN]; /**< Netdev or interface name */
-    void *rx_queue;                   /**< RX queue pointer */
-    void *tx_queue;                   /**< TX queues pointer */
-    bool admin_state;                 /**< Packet stream admin state */
-    void *dev_private;                /**< PMD-specific private data. */
-    uint32_t min_rx_buf_size;         /**< Common RX buffer size handled by all queues. */
-    struct ether_addr *mac_addr;      /**< Ethernet MAC address if needed */
-    uint16_t lport_id;                /**< Device [external] lport identifier. */
-    uint16_t numa_node;               /**< NUMA node connection. */
-    struct offloads *offloads;        /**< Checksum offload. */
+    char name[PKTDEV_NAME_MAX_LEN];    /**< Unique identifier name */
+    char ifname[PKTDEV_NAME_MAX_LEN];  /**< Netdev or interface name */
+    void *rx_queue;                    /**< RX queue pointer, same as rx_queues[0] */
+    void *tx_queue;                    /**< TX queues pointer, same as tx_queues[0] */
+    void *rx_queues[LPORT_MAX_QUEUES]; /**< RX queue pointers for each queue */
+    void *tx_queues[LPORT_MAX_QUEUES]; /**< TX queue pointers for each queue */
+    uint16_t nb_rx_queues;             /**< Number of RX queues */
+    uint16_t nb_tx_queues;             /**< Number of TX queues */
+    bool admin_state;                  /**< Packet stream admin state */
+    void *dev_private;                 /**< PMD-specific private data. */
+    uint32_t min_rx_buf_size;          /**< Common RX buffer size handled by all queues. */
+    struct ether_addr *mac_addr;       /**< Ethernet MAC address if needed */
+    uint16_t lport_id;                 /**< Device [external] lport identifier. */
+    uint16_t numa_node;                /**< NUMA node connection. */
+    struct offloads *offloads;         /**< Checksum offload. */
 } __cne_cache_aligned;
 
 /**
@@ -78,6 +78,7 @@ __mbuf_init(pktmbuf_info_t *pi, pktmbuf_t *m, uint32_t sz, uint32_t idx, void *u
     m->pooldata   = pi;
     m->lport      = CNE_MBUF_INVALID_PORT;
     m->meta_index = idx;
+    m->nb_segs    = 1;
     pktmbuf_refcnt_set(m, 1);
 
     return 0;
@@ -257,6 +258,11 @@ pktmbuf_check(const pktmbuf_t *m, int is_header, const char **reason)
     if (is_header == 0)
         return 0;
 
+    if (m->nb_segs == 0) {
+        *reason = "bad nb_segs";
+        return -1;
+    }
+
     if (m->data_off > m->buf_len) {
         *reason = "data offset too big in mbuf segment";
         return -1;
@@ -273,44 +279,33 @@ pktmbuf_check(const pktmbuf_t *m, int is_header, const char **reason)
 pktmbuf_t *
 pktmbuf_copy(const pktmbuf_t *m, pktmbuf_info_t *pi, uint32_t off, uint32_t len)
 {
-    const pktmbuf_t *seg = m;
-    pktmbuf_t *mc;
+    pktmbuf_cursor_t c;
+    pktmbuf_t *mc, *seg;
+    uint32_t pkt_len;
 
     /* garbage in check */
     __pktmbuf_sanity_check(m, 1);
 
-    /* check for request to copy at offset past end of mbuf */
-    if (unlikely(off >= m->buf_len))
-        return NULL;
+    pkt_len = pktmbuf_pkt_len(m);
 
-    mc = pktmbuf_alloc(pi);
-    if (unlikely(mc == NULL))
+    /* check for request to copy at offset past end of mbuf */
+    if (unlikely(off > pkt_len))
         return NULL;
 
     /* truncate requested length to available data */
-    if (len > m->buf_len - off)
-        len = m->buf_len - off;
-
-    __pktmbuf_copy_hdr(mc, m);
+    if (len > pkt_len - off)
+        len = pkt_len - off;
 
-    uint32_t copy_len;
-
-    /* current buffer is full, chain a new one */
-    if (pktmbuf_tailroom(m) == 0)
+    mc = pktmbuf_alloc_chain(pi, len);
+    if (unlikely(mc == NULL))
         return NULL;
 
-    /*
-     * copy the min of data in input segment (seg)
-     * vs space available in output (m_last)
-     */
-    copy_len = CNE_MIN(seg->data_len - off, len);
-    if (copy_len > pktmbuf_tailroom(m))
-        copy_len = pktmbuf_tailroom(m);
-
-    memcpy(pktmbuf_mtod(mc, char *), pktmbuf_mtod(m, char *), copy_len);
+    __pktmbuf_copy_hdr(mc, m);
 
-    /* update offsets and lengths */
-    mc->data_len = copy_len;
+    /* copy the data into each of the output segments */
+    pktmbuf_cursor_init(&c, m, off);
+    for (seg = mc; seg; seg = seg->next)
+        pktmbuf_cursor_read(&c, pktmbuf_mtod(seg, void *), pktmbuf_data_len(seg));
 
     /* garbage out check */
     __pktmbuf_sanity_check(mc, 1);
@@ -364,7 +359,7 @@ pktmbuf_dump(const char *msg, const pktmbuf_t *m, unsigned dump_len)
 
     if (msg)
         cne_printf("[yellow]>>> [orange]%s [yellow]<<<[]\n", msg);
-    cne_printf("  dump mbuf at %p, buf_addr %p, data_start %p, pool %p\n", (void *)(uintptr_t)m,
+    cne_printf("  dump mbuf at %p, buf_addr %p, data_start %p, pool %p\n", (const void *)m,
                (void *)m->buf_addr, CNE_PTR_ADD(m->buf_addr, m->data_off), m->pooldata);
     cne_printf("  buf_len=%u, data_off=%u, l2_len %d, l3_len %d, l4_len %d,", (unsigned)m->buf_len,
                (unsigned)m->data_off, m->l2_len, m->l3_len, m->l4_len);
@@ -372,15 +367,22 @@ pktmbuf_dump(const char *msg, const pktmbuf_t *m, unsigned dump_len)
                m->refcnt);
     cne_printf("  tx_offload= 0x%04lx, hash=0x%08x, ptype=%08x, userptr=%p\n", m->tx_offload,
                m->hash, m->packet_type, m->userptr);
-
-    __pktmbuf_sanity_check(m, 0);
-
-    len = dump_len;
-    if (len > m->data_len)
-        len = m->data_len;
-    if (len != 0)
-        _hexdump(NULL, pktmbuf_mtod(m, void *), len);
-    dump_len -= len;
+    cne_printf("  nb_segs=%u, pkt_len=%" PRIu32 "\n", (unsigned)m->nb_segs, pktmbuf_pkt_len(m));
+
+    while (m && dump_len > 0) {
+        __pktmbuf_sanity_check(m, 0);
+
+        len = dump_len;
+        if (len > m->data_len)
+            len = m->data_len;
+        if (len != 0)
+            _hexdump(NULL, pktmbuf_mtod(m, void *), len);
+        dump_len -= len;
+        m = m->next;
+        if (m)
+            cne_printf("  segment at %p, data_off=%u, data_len=%u\n", (const void *)m,
+                       (unsigned)m->data_off, (unsigned)m->data_len);
+    }
 }
 
 /**
@@ -400,19 +402,16 @@ pktmbuf_dump(const char *msg, const pktmbuf_t *m, unsigned dump_len)
 const void *
 __pktmbuf_read(const pktmbuf_t *m, uint32_t off, uint32_t len, void *buf)
 {
-    uint32_t copy_len;
+    pktmbuf_cursor_t c;
 
     if (!m || !buf || len == 0)
         return NULL;
 
-    if (off >= pktmbuf_data_len(m))
+    if (pktmbuf_cursor_init(&c, m, off) < 0)
         return NULL;
 
-    copy_len = pktmbuf_data_len(m) - off;
-    if (copy_len > len)
-        copy_len = len;
-
-    memcpy((char *)buf, pktmbuf_mtod_offset(m, char *, off), copy_len);
+    if (pktmbuf_cursor_read(&c, buf, len) == 0)
+        return NULL;
 
     return buf;
 }
@@ -462,6 +461,10 @@ __pktmbuf_write(const void *buf, uint32_t len, pktmbuf_t *m, uint32_t off)
 
     /* determine if we need to increase or append more space to the mbuf data */
     if (lptr > eptr) {
+        /* Only the last segment of a packet can grow */
+        if (m->nb_segs > 1)
+            return NULL;
+
         /* Increase the packet length to hold the new data */
         if (pktmbuf_append(m, lptr - eptr) == NULL)
             return NULL;
@@ -472,29 +475,319 @@ __pktmbuf_write(const void *buf, uint32_t len, pktmbuf_t *m, uint32_t off)
     return sptr;
 }
 
-/* Creates a shallow copy of mbuf */
+/* Creates a shallow copy of mbuf, the new mbufs are attached to the data of md */
 pktmbuf_t *
 pktmbuf_clone(pktmbuf_t *md, pktmbuf_info_t *pi)
 {
-    pktmbuf_t *mc;
+    pktmbuf_t *mc, *mi, **prev;
+    uint16_t nb_segs = 0;
 
     if (!md) /* pi is checked in the pktmbuf_alloc() path */
         return NULL;
 
-    mc = pktmbuf_alloc(pi);
+    mc = mi = pktmbuf_alloc(pi);
     if (unlikely(mc == NULL))
         return NULL;
 
-    mc->lport      = md->lport;
-    mc->tx_offload = md->tx_offload;
-    mc->buf_len    = md->buf_len;
-    mc->data_off   = md->data_off;
-    mc->data_len   = md->data_len;
-    mc->buf_addr   = md->buf_addr;
+    prev = &mc;
+    do {
+        *prev = mi;
+        prev  = &mi->next;
+        nb_segs++;
+
+        (void)pktmbuf_attach(mi, md);
+    } while ((md = md->next) != NULL && (mi = pktmbuf_alloc(pi)) != NULL);
+
+    *prev       = NULL;
+    mc->nb_segs = nb_segs;
+
+    /* Allocation of a segment failed, release the partial clone */
+    if (md != NULL) {
+        pktmbuf_free(mc);
+        return NULL;
+    }
 
     return mc;
 }
 
+int
+pktmbuf_attach(pktmbuf_t *mi, pktmbuf_t *m)
+{
+    if (!mi || !m)
+        CNE_ERR_RET("Invalid mbuf pointer\n");
+
+    if (!pktmbuf_is_direct(mi) || pktmbuf_refcnt_read(mi) != 1 || mi->next)
+        CNE_ERR_RET("Attached mbuf must be a single direct mbuf with one reference\n");
+
+    if (m->shinfo) {
+        atomic_fetch_add_explicit(&m->shinfo->refcnt, 1, CNE_MEMORY_ORDER(relaxed));
+        mi->shinfo = m->shinfo;
+    } else {
+        /* Take the reference on the mbuf owning the buffer, not on an indirect mbuf */
+        pktmbuf_t *md = pktmbuf_is_direct(m) ? m : pktmbuf_from_indirect(m);
+
+        pktmbuf_refcnt_update(md, 1);
+    }
+
+    mi->buf_addr    = m->buf_addr;
+    mi->buf_len     = m->buf_len;
+    mi->data_off    = m->data_off;
+    mi->data_len    = m->data_len;
+    mi->lport       = m->lport;
+    mi->hash        = m->hash;
+    mi->packet_type = m->packet_type;
+    mi->ol_flags    = m->ol_flags;
+    mi->tx_offload  = m->tx_offload;
+    mi->userptr     = m->userptr;
+    mi->nb_segs     = 1;
+
+    return 0;
+}
+
+int
+pktmbuf_attach_extbuf(pktmbuf_t *m, void *buf_addr, uint16_t buf_len, pktmbuf_ext_shinfo_t *shinfo)
+{
+    if (!m || !buf_addr || !shinfo || !shinfo->free_cb)
+        CNE_ERR_RET("Invalid external buffer arguments\n");
+
+    if (!pktmbuf_is_direct(m) || pktmbuf_refcnt_read(m) != 1 || m->next)
+        CNE_ERR_RET("Attached mbuf must be a single direct mbuf with one reference\n");
+
+    atomic_fetch_add_explicit(&shinfo->refcnt, 1, CNE_MEMORY_ORDER(relaxed));
+
+    m->buf_addr = buf_addr;
+    m->buf_len  = buf_len;
+    m->data_off = 0;
+    m->data_len = buf_len;
+    m->shinfo   = shinfo;
+
+    return 0;
+}
+
+void
+pktmbuf_detach(pktmbuf_t *m)
+{
+    pktmbuf_info_t *pi;
+
+    if (!m || pktmbuf_is_direct(m))
+        return;
+
+    if (m->shinfo) {
+        pktmbuf_ext_shinfo_t *shinfo = m->shinfo;
+
+        if (atomic_fetch_sub_explicit(&shinfo->refcnt, 1, CNE_MEMORY_ORDER(acq_rel)) == 1)
+            shinfo->free_cb(m->buf_addr, shinfo->fcb_opaque);
+        m->shinfo = NULL;
+    } else {
+        pktmbuf_t *md = pktmbuf_refcnt_free(pktmbuf_from_indirect(m));
+
+        if (md) {
+            /* The owner can still be linked into the chain it was freed with */
+            md->next    = NULL;
+            md->nb_segs = 1;
+
+            pi = md->pooldata;
+            (void)pi->ops.mbuf_free(pi, &md, 1);
+        }
+    }
+
+    /* Restore the buffer owned by this mbuf */
+    pi          = m->pooldata;
+    m->buf_addr = (char *)m + sizeof(pktmbuf_t);
+    m->buf_len  = (uint16_t)(pi->bufsz - sizeof(pktmbuf_t));
+    m->data_len = 0;
+    pktmbuf_reset_headroom(m);
+}
+
+pktmbuf_t *
+pktmbuf_alloc_chain(pktmbuf_info_t *pi, uint32_t len)
+{
+    pktmbuf_t *head = NULL, *tail = NULL, *m;
+    uint16_t room;
+
+    do {
+        m = pktmbuf_alloc(pi);
+        if (unlikely(m == NULL))
+            goto err;
+
+        if (head == NULL)
+            head = m;
+        else {
+            /* Only the first segment needs headroom for the headers */
+            pktmbuf_data_off(m) = 0;
+            tail->next          = m;
+            head->nb_segs++;
+        }
+        tail = m;
+
+        room = pktmbuf_tailroom(m);
+        if (unlikely(room == 0 || head->nb_segs == UINT16_MAX))
+            goto err;
+
+        pktmbuf_data_len(m) = (uint16_t)CNE_MIN(len, (uint32_t)room);
+        len -= pktmbuf_data_len(m);
+    } while (len);
+
+    return head;
+err:
+    pktmbuf_free(head);
+    return NULL;
+}
+
+char *
+pktmbuf_append_chain(pktmbuf_t *m, uint16_t len)
+{
+    pktmbuf_t *last, *n;
+
+    if (!m)
+        return NULL;
+
+    last = pktmbuf_lastseg(m);
+    if (likely(pktmbuf_is_writable(last) && len <= pktmbuf_tailroom(last))) {
+        char *tail = pktmbuf_mtod_last(last);
+
+        pktmbuf_data_len(last) = (uint16_t)(pktmbuf_data_len(last) + len);
+        return tail;
+    }
+
+    if (unlikely(m->nb_segs == UINT16_MAX))
+        return NULL;
+
+    n = pktmbuf_alloc(m->pooldata);
+    if (unlikely(n == NULL))
+        return NULL;
+
+    pktmbuf_data_off(n) = 0;
+    if (unlikely(len > pktmbuf_tailroom(n))) {
+        pktmbuf_free(n);
+        return NULL;
+    }
+    pktmbuf_data_len(n) = len;
+
+    last->next = n;
+    m->nb_segs++;
+
+    return pktmbuf_mtod(n, char *);
+}
+
+char *
+pktmbuf_prepend_chain(pktmbuf_t **mp, uint16_t len)
+{
+    pktmbuf_t *m, *h;
+
+    if (!mp || (m = *mp) == NULL)
+        return NULL;
+
+    if (likely(pktmbuf_is_writable(m) && len <= pktmbuf_headroom(m)))
+        return pktmbuf_prepend(m, len);
+
+    if (unlikely(m->nb_segs == UINT16_MAX))
+        return NULL;
+
+    h = pktmbuf_alloc(m->pooldata);
+    if (unlikely(h == NULL))
+        return NULL;
+
+    if (unlikely(len > pktmbuf_buf_len(h))) {
+        pktmbuf_free(h);
+        return NULL;
+    }
+
+    /* Place the data at the end of the buffer to leave room for more headers */
+    pktmbuf_data_off(h) = (uint16_t)(pktmbuf_buf_len(h) - len);
+    pktmbuf_data_len(h) = len;
+
+    /* Move the packet level fields to the new first segment */
+    h->lport       = m->lport;
+    h->hash        = m->hash;
+    h->packet_type = m->packet_type;
+    h->ol_flags    = m->ol_flags;
+    h->tx_offload  = m->tx_offload;
+    h->userptr     = m->userptr;
+    h->nb_segs     = (uint16_t)(m->nb_segs + 1);
+    h->next        = m;
+    m->nb_segs     = 1;
+
+    *mp = h;
+
+    return pktmbuf_mtod(h, char *);
+}
+
+int
+pktmbuf_linearize(pktmbuf_t *m)
+{
+    pktmbuf_t *seg, *next;
+    uint32_t pkt_len;
+    char *dst;
+
+    if (!m)
+        return -1;
+
+    if (m->nb_segs == 1)
+        return 0;
+
+    pkt_len = pktmbuf_pkt_len(m);
+    if (!pktmbuf_is_writable(m) || (pktmbuf_data_off(m) + pkt_len) > pktmbuf_buf_len(m))
+        return -1;
+
+    dst = pktmbuf_mtod_last(m);
+    for (seg = m->next; seg; seg = next) {
+        next = seg->next;
+
+        memcpy(dst, pktmbuf_mtod(seg, char *), pktmbuf_data_len(seg));
+        dst += pktmbuf_data_len(seg);
+
+        seg->next = NULL;
+        pktmbuf_free_seg(seg);
+    }
+
+    pktmbuf_data_len(m) = (uint16_t)pkt_len;
+    m->next             = NULL;
+    m->nb_segs          = 1;
+
+    return 0;
+}
+
+uint32_t
+pktmbuf_cursor_read(pktmbuf_cursor_t *c, void *buf, uint32_t len)
+{
+    char *dst      = buf;
+    uint32_t total = 0;
+
+    while (c->seg && len) {
+        uint32_t cnt = CNE_MIN(pktmbuf_data_len(c->seg) - c->off, len);
+
+        memcpy(dst, pktmbuf_mtod_offset(c->seg, char *, c->off), cnt);
+
+        dst += cnt;
+        len -= cnt;
+        total += cnt;
+        c->off += cnt;
+        __pktmbuf_cursor_normalize(c);
+    }
+    c->pos += total;
+
+    return total;
+}
+
+uint32_t
+pktmbuf_cursor_skip(pktmbuf_cursor_t *c, uint32_t len)
+{
+    uint32_t total = 0;
+
+    while (c->seg && len) {
+        uint32_t cnt = CNE_MIN(pktmbuf_data_len(c->seg) - c->off, len);
+
+        len -= cnt;
+        total += cnt;
+        c->off += cnt;
+        __pktmbuf_cursor_normalize(c);
+    }
+    c->pos += total;
+
+    return total;
+}
+
 /*
  * Get the name of a RX offload flag. Must be kept synchronized with flag
  * definitions in cne_mbuf.h.
@@ -527,6 +820,7 @@ cne_get_rx_ol_flag_name(uint64_t mask)
     case CNE_MBUF_F_RX_OUTER_L4_CKSUM_BAD:      return "RX_OUTER_L4_CKSUM_BAD";
     case CNE_MBUF_F_RX_OUTER_L4_CKSUM_GOOD:     return "RX_OUTER_L4_CKSUM_GOOD";
     case CNE_MBUF_F_RX_OUTER_L4_CKSUM_INVALID:  return "RX_OUTER_L4_CKSUM_INVALID";
+    case CNE_MBUF_F_RX_TIMESTAMP:               return "RX_TIMESTAMP";
 
     default: return NULL;
     }
@@ -571,6 +865,7 @@ cne_get_rx_ol_flag_list(uint64_t mask, char *buf, size_t buflen)
         { CNE_MBUF_F_RX_OUTER_L4_CKSUM_GOOD, CNE_MBUF_F_RX_OUTER_L4_CKSUM_MASK, NULL },
         { CNE_MBUF_F_RX_OUTER_L4_CKSUM_INVALID, CNE_MBUF_F_RX_OUTER_L4_CKSUM_MASK, NULL },
         { CNE_MBUF_F_RX_OUTER_L4_CKSUM_UNKNOWN, CNE_MBUF_F_RX_OUTER_L4_CKSUM_MASK, "RX_OUTER_L4_CKSUM_UNKNOWN" },
+        { CNE_MBUF_F_RX_TIMESTAMP, CNE_MBUF_F_RX_TIMESTAMP, NULL },
     };
     // clang-format off
     const char *name;
@@ -634,6 +929,7 @@ cne_get_tx_ol_flag_name(uint64_t mask)
     case CNE_MBUF_F_TX_SEC_OFFLOAD:         return "TX_SEC_OFFLOAD";
     case CNE_MBUF_F_TX_UDP_SEG:             return "TX_UDP_SEG";
     case CNE_MBUF_F_TX_OUTER_UDP_CKSUM:     return "TX_OUTER_UDP_CKSUM";
+    case CNE_MBUF_F_TX_LAUNCH_TIME:         return "TX_LAUNCH_TIME";
     case CNE_MBUF_TYPE_MCAST:               return "MBUF_TYPE_MCAST";
     case CNE_MBUF_TYPE_BCAST:               return "MBUF_TYPE_BCAST";
     case CNE_MBUF_TYPE_IPv6:                return "MBUF_TYPE_IPv6";
@@ -675,6 +971,7 @@ cne_get_tx_ol_flag_list(uint64_t mask, char *buf, size_t buflen)
         { CNE_MBUF_F_TX_SEC_OFFLOAD, CNE_MBUF_F_TX_SEC_OFFLOAD, NULL },
         { CNE_MBUF_F_TX_UDP_SEG, CNE_MBUF_F_TX_UDP_SEG, NULL },
         { CNE_MBUF_F_TX_OUTER_UDP_CKSUM, CNE_MBUF_F_TX_OUTER_UDP_CKSUM, NULL },
+        { CNE_MBUF_F_TX_LAUNCH_TIME, CNE_MBUF_F_TX_LAUNCH_TIME, NULL },
         { CNE_MBUF_TYPE_MCAST, CNE_MBUF_TYPE_MCAST, NULL },
         { CNE_MBUF_TYPE_BCAST, CNE_MBUF_TYPE_BCAST, NULL },
         { CNE_MBUF_TYPE_IPv6, CNE_MBUF_TYPE_IPv6, NULL },
@@ -738,3 +1035,87 @@ CNE_INIT_PRIO(pinfo_constructor, START)
     if (cne_mutex_create(&pinfo_list_mutex, PTHREAD_MUTEX_RECURSIVE) < 0)
         CNE_RET("mutex init(pinfo_list_mutex) failed\n");
 }
+
+struct mempool_cache *
+pktmbuf_cache_create(pktmbuf_info_t *pi, uint32_t size, uint32_t low_wm, uint32_t high_wm)
+{
+    mbuf_ops_t ops;
+
+    if (!pi) {
+        errno = EINVAL;
+        CNE_NULL_RET("pktmbuf_info_t pointer is NULL\n");
+    }
+
+    /* The cache works directly on the mempool behind the default pktmbuf operations */
+    pktmbuf_set_default_ops(&ops);
+    if (pi->ops.mbuf_alloc != ops.mbuf_alloc || pi->ops.mbuf_free != ops.mbuf_free) {
+        errno = ENOTSUP;
+        CNE_NULL_RET("pktmbuf cache requires the default pktmbuf operations\n");
+    }
+
+    return mempool_cache_create(pi->pd, size, low_wm, high_wm);
+}
+
+void
+pktmbuf_cache_destroy(pktmbuf_info_t *pi, struct mempool_cache *cache)
+{
+    if (pi && cache)
+        mempool_cache_destroy(pi->pd, cache);
+}
+
+int
+pktmbuf_alloc_bulk_cache(pktmbuf_info_t *pi, pktmbuf_t **mbufs, unsigned int count,
+                         struct mempool_cache *cache)
+{
+    if (!pi)
+        return -EINVAL;
+
+    if (!cache)
+        return pi->ops.mbuf_alloc(pi, mbufs, count);
+
+    if (mempool_generic_get(pi->pd, (void **)mbufs, count, cache) != 0)
+        return 0;
+
+    for (unsigned int i = 0; i < count; i++)
+        pktmbuf_reset(mbufs[i]);
+
+    return count;
+}
+
+void
+pktmbuf_free_bulk_cache(pktmbuf_info_t *pi, pktmbuf_t **mbufs, unsigned int count,
+                        struct mempool_cache *cache)
+{
+    void *pending[PKTMBUF_PENDING_SZ];
+    unsigned int nb_pending = 0;
+
+    if (!pi || !cache) {
+        pktmbuf_free_bulk(mbufs, count);
+        return;
+    }
+
+    for (unsigned int i = 0; i < count; i++) {
+        pktmbuf_t *m = mbufs[i];
+
+        if (unlikely(!m))
+            continue;
+
+        if (unlikely(m->pooldata != pi || m->nb_segs > 1)) {
+            pktmbuf_free(m);
+            continue;
+        }
+
+        m = __pktmbuf_prefree(m);
+        if (!m)
+            continue;
+
+        pending[nb_pending++] = m;
+        if (nb_pending == PKTMBUF_PENDING_SZ) {
+            mempool_generic_put(pi->pd, pending, nb_pending, cache);
+            nb_pending = 0;
+        }
+    }
+
+    if (nb_pending)
+        mempool_generic_put(pi->pd, pending, nb_pending, cache);
+}
@@ -96,6 +96,26 @@ typedef struct pktmbuf_info_s {
 #define CNE_MBUF_DEFAULT_DATAROOM (2 * 1024)
 #define CNE_MBUF_DEFAULT_BUF_SIZE CNE_MBUF_DEFAULT_DATAROOM
 
+/**
+ * Callback to free an external buffer attached to one or more pktmbuf_t.
+ *
+ * @param addr
+ *   The address of the external buffer.
+ * @param opaque
+ *   The user supplied argument stored in pktmbuf_ext_shinfo_t.fcb_opaque.
+ */
+typedef void (*pktmbuf_extbuf_free_cb_t)(void *addr, void *opaque);
+
+/**
+ * Shared information of an external buffer, a single instance is shared by all of the
+ * pktmbuf_t structures attached to the same external buffer.
+ */
+typedef struct pktmbuf_ext_shinfo {
+    pktmbuf_extbuf_free_cb_t free_cb;  /**< Called when the last reference is dropped */
+    void *fcb_opaque;                  /**< User supplied argument to free_cb */
+    CNE_ATOMIC(uint_least16_t) refcnt; /**< Number of pktmbuf_t attached to the buffer */
+} pktmbuf_ext_shinfo_t;
+
 /**
  * The generic pktmbuf_s, containing a packet mbuf.
  */
@@ -157,7 +177,7 @@ struct pktmbuf_s {
         uint16_t refcnt;                          /**< Non-atomically accessed refcnt */
     };
 
-    uint16_t rsvd16;
+    uint16_t nb_segs; /**< Number of segments, only valid in the first segment of a packet */
 
     /* fields to support TX offloads */
     CNE_STD_C11
@@ -199,6 +219,18 @@ struct pktmbuf_s {
         void *userptr;    /**< 64bit user supplied pointer (optional) */
         uint64_t udata64; /**< 64bit data value (optional) */
     };
+
+    /*
+     * Second cache line, only touched when a packet is made up of more than one segment,
+     * the mbuf is attached to a buffer it does not own or an offload flag marks one of the
+     * fields below as valid. A pktmbuf_t sitting in the pool always has next == NULL,
+     * shinfo == NULL and nb_segs == 1.
+     */
+    CNE_MARKER cacheline1 __cne_cache_aligned;
+    struct pktmbuf_s *next;       /**< Next segment of a chained packet or NULL for the last one */
+    pktmbuf_ext_shinfo_t *shinfo; /**< Shared info of an attached external buffer or NULL */
+    uint64_t timestamp;           /**< RX timestamp or TX launch time in nanoseconds */
+    uint16_t vlan_tci;            /**< VLAN TCI of a stripped VLAN tag, see CNE_MBUF_F_RX_VLAN */
 } __cne_cache_aligned;
 
 typedef struct pktmbuf_s pktmbuf_t;
@@ -369,6 +401,48 @@ CNDP_API int pktmbuf_iterate(pktmbuf_info_t *pi, pktmbuf_cb_t cb, void *ud);
  */
 #define pktmbuf_data_len(m) ((m)->data_len)
 
+/**
+ * A macro that returns the number of segments in the packet.
+ *
+ * @param m
+ *   The packet mbuf, must be the first segment of the packet.
+ */
+#define pktmbuf_nb_segs(m) ((m)->nb_segs)
+
+/**
+ * A macro that returns the next segment of a chained packet or NULL.
+ *
+ * @param m
+ *   The packet mbuf.
+ */
+#define pktmbuf_next(m) ((m)->next)
+
+/**
+ * A macro to test if the mbuf owns its buffer, i.e. it is not attached to the buffer
+ * of another mbuf or to an external buffer.
+ *
+ * @param m
+ *   The packet mbuf.
+ */
+#define pktmbuf_is_direct(m) \
+    ((const char *)(m)->buf_addr == (const char *)(m) + sizeof(pktmbuf_t))
+
+/**
+ * A macro to test if the mbuf is attached to an external buffer.
+ *
+ * @param m
+ *   The packet mbuf.
+ */
+#define pktmbuf_has_extbuf(m) ((m)->shinfo != NULL)
+
+/**
+ * A macro that returns the mbuf owning the buffer of an indirect mbuf.
+ *
+ * @param m
+ *   The indirect packet mbuf, must not be attached to an external buffer.
+ */
+#define pktmbuf_from_indirect(m) ((pktmbuf_t *)CNE_PTR_SUB((m)->buf_addr, sizeof(pktmbuf_t)))
+
 /**
  * A macro that returns the data offset of the packet.
  *
@@ -647,6 +721,7 @@ pktmbuf_reset(pktmbuf_t *m)
 
     pktmbuf_data_len(m) = 0;
     pktmbuf_port(m)     = CNE_MBUF_INVALID_PORT;
+    m->nb_segs          = 1;
     m->packet_type      = 0;
     m->tx_offload       = 0;
     m->ol_flags         = 0;
@@ -731,16 +806,96 @@ pktmbuf_refcnt_free(pktmbuf_t *m)
     return NULL;
 }
 
+/**
+ * Detach an mbuf from the buffer it is attached to and restore its own buffer.
+ *
+ * The reference taken on the mbuf owning the buffer, or on the external buffer, is
+ * released and the owner is freed when it was the last reference. Calling this on a
+ * direct mbuf does nothing.
+ *
+ * @param m
+ *   The indirect packet mbuf or mbuf with an external buffer attached.
+ */
+CNDP_API void pktmbuf_detach(pktmbuf_t *m);
+
+/**
+ * @internal Drop one reference of a single mbuf and detach it when it was the last one.
+ */
+static __cne_always_inline pktmbuf_t *
+__pktmbuf_prefree(pktmbuf_t *m)
+{
+    m = pktmbuf_refcnt_free(m);
+    if (m && unlikely(!pktmbuf_is_direct(m)))
+        pktmbuf_detach(m);
+    return m;
+}
+
+/**
+ * Decrease the reference counter of one segment and restore the pool invariants.
+ *
+ * Same as pktmbuf_refcnt_free(), but when the last reference is dropped the segment is
+ * detached from any buffer it does not own and unlinked from the chain (next = NULL,
+ * nb_segs = 1) so it can be put back into the pool.
+ *
+ * @param m
+ *   The mbuf segment to be unlinked
+ * @return
+ *   - (m) if it is the last reference. It can be recycled or freed.
+ *   - (NULL) if the mbuf still has remaining references on it.
+ */
+static __cne_always_inline pktmbuf_t *
+pktmbuf_prefree_seg(pktmbuf_t *m)
+{
+    m = __pktmbuf_prefree(m);
+    if (m && m->next) {
+        m->next    = NULL;
+        m->nb_segs = 1;
+    }
+    return m;
+}
+
+/**
+ * Free a single segment of a packet back into its original pool.
+ *
+ * The segment is not removed from the packet chain it belongs to, the caller must make
+ * sure no other segment points to it once it is freed.
+ *
+ * @param m
+ *   The packet mbuf segment to be freed. If NULL, the function does nothing.
+ */
+static __cne_always_inline void
+pktmbuf_free_seg(pktmbuf_t *m)
+{
+    m = pktmbuf_prefree_seg(m);
+    if (likely(m != NULL)) {
+        pktmbuf_info_t *pi = (pktmbuf_info_t *)m->pooldata;
+
+        (void)pi->ops.mbuf_free(pi, &m, 1);
+    }
+}
+
 /**
  * Free a packet mbuf back into its original pool.
  *
+ * All segments of a chained packet are freed as well.
+ *
  * @param m
  *   The packet mbuf to be freed. If NULL, the function does nothing.
  */
 static __cne_always_inline void
 pktmbuf_free(pktmbuf_t *m)
 {
-    m = pktmbuf_refcnt_free(m);
+    if (unlikely(m && m->nb_segs > 1)) {
+        while (m) {
+            pktmbuf_t *next = m->next;
+
+            pktmbuf_free_seg(m);
+            m = next;
+        }
+        return;
+    }
+
+    m = __pktmbuf_prefree(m);
     if (likely(m != NULL)) {
         pktmbuf_info_t *pi = (pktmbuf_info_t *)m->pooldata;
 
@@ -774,10 +929,8 @@ __pktmbuf_flush_pending(pktmbuf_pending_t *p)
  *  constant value, such as PKTMBUF_PENDING_SZ.
  */
 static __cne_always_inline void
-__pktmbuf_free_bulk(pktmbuf_pending_t *p, pktmbuf_t *m)
+__pktmbuf_free_bulk_seg(pktmbuf_pending_t *p, pktmbuf_t *m)
 {
-    m = pktmbuf_refcnt_free(m);
-
     if (likely(m != NULL)) {
         if (p->nb_pending == p->pending_sz || (p->nb_pending > 0 && m->pooldata != p->pooldata)) {
             __pktmbuf_flush_pending(p);
@@ -788,6 +941,22 @@ __pktmbuf_free_bulk(pktmbuf_pending_t *p, pktmbuf_t *m)
     }
 }
 
+static __cne_always_inline void
+__pktmbuf_free_bulk(pktmbuf_pending_t *p, pktmbuf_t *m)
+{
+    if (unlikely(m && m->nb_segs > 1)) {
+        while (m) {
+            pktmbuf_t *next = m->next;
+
+            __pktmbuf_free_bulk_seg(p, pktmbuf_prefree_seg(m));
+            m = next;
+        }
+        return;
+    }
+
+    __pktmbuf_free_bulk_seg(p, __pktmbuf_prefree(m));
+}
+
 /**
  * Free a bulk of packet mbufs back into their original pools.
  *
@@ -817,6 +986,74 @@ pktmbuf_free_bulk(pktmbuf_t **mbufs, unsigned int count)
         __pktmbuf_flush_pending(&pend);
 }
 
+/**
+ * Create an explicit mbuf cache for a pktmbuf pool, see mempool_cache_create().
+ *
+ * The cache is owned by the caller, normally one per thread or per lport queue,
+ * and must only be used by one thread at a time. Only pools using the default
+ * pktmbuf operations are supported.
+ *
+ * @param pi
+ *   The pktmbuf_info_t pointer of the pool.
+ * @param size
+ *   The number of mbufs held in the cache after a bulk refill or flush.
+ * @param low_wm
+ *   Refill the cache when an allocation would leave fewer than low_wm mbufs.
+ * @param high_wm
+ *   Flush the cache when a free leaves high_wm or more mbufs, 0 for the default.
+ * @return
+ *   The mempool cache pointer or NULL on error with errno set.
+ */
+CNDP_API struct mempool_cache *pktmbuf_cache_create(pktmbuf_info_t *pi, uint32_t size,
+                                                    uint32_t low_wm, uint32_t high_wm);
+
+/**
+ * Return the mbufs held in a cache to the pool and free the cache.
+ *
+ * @param pi
+ *   The pktmbuf_info_t pointer the cache was created with.
+ * @param cache
+ *   The cache returned by pktmbuf_cache_create(), can be NULL.
+ */
+CNDP_API void pktmbuf_cache_destroy(pktmbuf_info_t *pi, struct mempool_cache *cache);
+
+/**
+ * Allocate a bulk of mbufs using an explicit mbuf cache.
+ *
+ * @param pi
+ *    The pktmbuf_info_t pointer the cache was created with.
+ * @param mbufs
+ *    Array of pointers to mbufs
+ * @param count
+ *    Array size
+ * @param cache
+ *    The cache returned by pktmbuf_cache_create(), if NULL this is the same as
+ *    pktmbuf_alloc_bulk().
+ * @return
+ *   number of mbufs allocated or 0 if not able to allocate request number of mbufs
+ */
+CNDP_API int pktmbuf_alloc_bulk_cache(pktmbuf_info_t *pi, pktmbuf_t **mbufs, unsigned int count,
+                                      struct mempool_cache *cache);
+
+/**
+ * Free a bulk of mbufs using an explicit mbuf cache.
+ *
+ * Single segment mbufs from the cache's pool go to the cache, any other mbufs are
+ * freed with pktmbuf_free().
+ *
+ * @param pi
+ *    The pktmbuf_info_t pointer the cache was created with.
+ * @param mbufs
+ *    Array of pointers to packet mbufs, the array may contain NULL pointers.
+ * @param count
+ *    Array size.
+ * @param cache
+ *    The cache returned by pktmbuf_cache_create(), if NULL this is the same as
+ *    pktmbuf_free_bulk().
+ */
+CNDP_API void pktmbuf_free_bulk_cache(pktmbuf_info_t *pi, pktmbuf_t **mbufs, unsigned int count,
+                                      struct mempool_cache *cache);
+
 /**
  * Create a full copy of a given packet mbuf.
  *
@@ -841,6 +1078,72 @@ pktmbuf_free_bulk(pktmbuf_t **mbufs, unsigned int count)
 CNDP_API pktmbuf_t *pktmbuf_copy(const pktmbuf_t *m, pktmbuf_info_t *pi, uint32_t offset,
                                  uint32_t length);
 
+/**
+ * Get the total length of the packet data, the sum of data_len of all segments.
+ *
+ * @param m
+ *   The packet mbuf, must be the first segment of the packet.
+ * @return
+ *   The length of the packet in bytes.
+ */
+static inline uint32_t
+pktmbuf_pkt_len(const pktmbuf_t *m)
+{
+    uint32_t len;
+
+    if (likely(m->nb_segs == 1))
+        return pktmbuf_data_len(m);
+
+    for (len = 0; m; m = m->next)
+        len += pktmbuf_data_len(m);
+
+    return len;
+}
+
+/**
+ * Return the last segment of a packet.
+ *
+ * @param m
+ *   The packet mbuf, any segment of the packet can be given.
+ * @return
+ *   The last segment of the packet.
+ */
+static inline pktmbuf_t *
+pktmbuf_lastseg(pktmbuf_t *m)
+{
+    while (m->next != NULL)
+        m = m->next;
+    return m;
+}
+
+/**
+ * Test if the buffer of the mbuf can be written without affecting other mbufs.
+ *
+ * @param m
+ *   The packet mbuf.
+ * @return
+ *   1 if the mbuf owns its buffer and holds the only reference, 0 otherwise.
+ */
+static inline int
+pktmbuf_is_writable(const pktmbuf_t *m)
+{
+    return pktmbuf_is_direct(m) && pktmbuf_refcnt_read(m) == 1;
+}
+
+/**
+ * Test if the packet data is contained in a single segment.
+ *
+ * @param m
+ *   The packet mbuf, must be the first segment of the packet.
+ * @return
+ *   1 if the packet is contiguous or 0 if it is made up of a chain of segments.
+ */
+static inline int
+pktmbuf_is_contiguous(const pktmbuf_t *m)
+{
+    return !!(m->nb_segs == 1);
+}
+
 /**
  * Get the headroom in a packet mbuf.
  *
@@ -987,8 +1290,8 @@ pktmbuf_adj_offset(pktmbuf_t *m, int16_t len)
 /**
  * Append len bytes to an mbuf.
  *
- * Append len bytes to an mbuf and return a pointer to the start address
- * of the added data.
+ * Append len bytes to the last segment of an mbuf and return a pointer to the
+ * start address of the added data.
  *
  * @param m
  *   The packet mbuf.
@@ -1005,6 +1308,9 @@ pktmbuf_append(pktmbuf_t *m, uint16_t len)
 
     __pktmbuf_sanity_check(m, 1);
 
+    if (unlikely(m->nb_segs > 1))
+        m = pktmbuf_lastseg(m);
+
     if (unlikely(len > pktmbuf_tailroom(m)))
         return NULL;
 
@@ -1131,6 +1437,256 @@ pktmbuf_data_room_size(mempool_t *mp)
  */
 CNDP_API pktmbuf_t *pktmbuf_clone(pktmbuf_t *md, pktmbuf_info_t *pi);
 
+/**
+ * Attach an mbuf to the buffer of another mbuf, zero-copy.
+ *
+ * After attaching, the indirect mbuf mi references the same data as m and holds a
+ * reference on the mbuf owning the buffer (or on the external buffer), which is released
+ * when mi is freed or detached. The data of an attached buffer must be treated as read-only.
+ *
+ * @param mi
+ *   The mbuf to attach, must be a direct mbuf with a single reference and no segments.
+ * @param m
+ *   The mbuf holding the buffer to attach to, can itself be indirect.
+ * @return
+ *   0 on success or -1 on error
+ */
+CNDP_API int pktmbuf_attach(pktmbuf_t *mi, pktmbuf_t *m);
+
+/**
+ * Initialize the shared information of an external buffer.
+ *
+ * @param shinfo
+ *   The shared information structure, must stay valid until free_cb is called.
+ * @param free_cb
+ *   The function called when the last pktmbuf_t attached to the buffer is freed.
+ * @param opaque
+ *   The user argument passed to free_cb.
+ */
+static inline void
+pktmbuf_ext_shinfo_init(pktmbuf_ext_shinfo_t *shinfo, pktmbuf_extbuf_free_cb_t free_cb,
+                        void *opaque)
+{
+    shinfo->free_cb    = free_cb;
+    shinfo->fcb_opaque = opaque;
+    atomic_store_explicit(&shinfo->refcnt, 0, CNE_MEMORY_ORDER(relaxed));
+}
+
+/**
+ * Attach an external buffer, i.e. application data, to an mbuf without copying it.
+ *
+ * The mbuf data is set to cover the whole external buffer. Each attached mbuf holds a
+ * reference on the external buffer and shinfo->free_cb() is called once all of them
+ * are freed.
+ *
+ * @param m
+ *   The mbuf to attach, must be a direct mbuf with a single reference and no segments.
+ * @param buf_addr
+ *   The address of the external buffer.
+ * @param buf_len
+ *   The length of the external buffer.
+ * @param shinfo
+ *   The shared information of the external buffer, see pktmbuf_ext_shinfo_init().
+ * @return
+ *   0 on success or -1 on error
+ */
+CNDP_API int pktmbuf_attach_extbuf(pktmbuf_t *m, void *buf_addr, uint16_t buf_len,
+                                   pktmbuf_ext_shinfo_t *shinfo);
+
+/**
+ * Allocate a chain of mbufs large enough to hold len bytes of data.
+ *
+ * The data length of each segment is set, so the total packet length is len.
+ * The first segment keeps the default headroom and the other segments start at
+ * the beginning of their buffer.
+ *
+ * @param pi
+ *   The pktmbuf_info_t pointer to allocate the mbufs from.
+ * @param len
+ *   The total length of the packet data.
+ * @return
+ *   The first segment of the packet or NULL on error.
+ */
+CNDP_API pktmbuf_t *pktmbuf_alloc_chain(pktmbuf_info_t *pi, uint32_t len);
+
+/**
+ * Concatenate two packets, the tail packet is appended to the head packet.
+ *
+ * @param head
+ *   The head of the packet to extend.
+ * @param tail
+ *   The packet to append, it must not be used as a separate packet afterwards.
+ * @return
+ *   0 on success or -1 if the resulting packet has too many segments.
+ */
+static inline int
+pktmbuf_chain(pktmbuf_t *head, pktmbuf_t *tail)
+{
+    if (head->nb_segs + tail->nb_segs > UINT16_MAX)
+        return -1;
+
+    pktmbuf_lastseg(head)->next = tail;
+    head->nb_segs               = (uint16_t)(head->nb_segs + tail->nb_segs);
+    tail->nb_segs               = 1;
+
+    return 0;
+}
+
+/**
+ * Append len bytes to a packet, adding a new segment when needed.
+ *
+ * Same as pktmbuf_append(), but when the last segment does not have enough tailroom,
+ * or its buffer is shared, a new segment is allocated from the pool of the packet and
+ * chained at the end of the packet.
+ *
+ * @param m
+ *   The packet mbuf.
+ * @param len
+ *   The amount of data to append (in bytes).
+ * @return
+ *   A pointer to the start of the newly appended data or NULL on error.
+ */
+CNDP_API char *pktmbuf_append_chain(pktmbuf_t *m, uint16_t len);
+
+/**
+ * Prepend len bytes to a packet, adding a new first segment when needed.
+ *
+ * Same as pktmbuf_prepend(), but when the first segment does not have enough headroom,
+ * or its buffer is shared, a new segment is allocated from the pool of the packet and
+ * becomes the first segment of the packet. The packet level fields are moved to the
+ * new first segment.
+ *
+ * @param mp
+ *   The address of the packet mbuf pointer, updated when a new segment is added.
+ * @param len
+ *   The amount of data to prepend (in bytes).
+ * @return
+ *   A pointer to the start of the newly prepended data or NULL on error.
+ */
+CNDP_API char *pktmbuf_prepend_chain(pktmbuf_t **mp, uint16_t len);
+
+/**
+ * Copy the data of all segments into the first segment and free the other segments.
+ *
+ * @param m
+ *   The packet mbuf, the first segment must be writable.
+ * @return
+ *   0 on success or -1 if the data does not fit in the first segment.
+ */
+CNDP_API int pktmbuf_linearize(pktmbuf_t *m);
+
+/**
+ * Reader cursor to walk the data of a packet across its segments.
+ */
+typedef struct pktmbuf_cursor {
+    const pktmbuf_t *seg; /**< Current segment or NULL at the end of the packet */
+    uint32_t off;         /**< Offset into the data of the current segment */
+    uint32_t pos;         /**< Offset from the start of the packet data */
+} pktmbuf_cursor_t;
+
+/**
+ * @internal Move the cursor to the next segment holding data.
+ */
+static inline void
+__pktmbuf_cursor_normalize(pktmbuf_cursor_t *c)
+{
+    while (c->seg && c->off >= pktmbuf_data_len(c->seg)) {
+        c->off -= pktmbuf_data_len(c->seg);
+        c->seg = c->seg->next;
+    }
+}
+
+/**
+ * Initialize a reader cursor at the given offset in the packet.
+ *
+ * @param c
+ *   The cursor to initialize.
+ * @param m
+ *   The packet mbuf.
+ * @param off
+ *   The offset from the start of the packet data.
+ * @return
+ *   0 on success or -1 if the offset is past the end of the packet.
+ */
+static inline int
+pktmbuf_cursor_init(pktmbuf_cursor_t *c, const pktmbuf_t *m, uint32_t off)
+{
+    c->seg = m;
+    c->off = off;
+    c->pos = off;
+
+    __pktmbuf_cursor_normalize(c);
+
+    return (c->seg == NULL && c->off > 0) ? -1 : 0;
+}
+
+/**
+ * Return the offset of the cursor from the start of the packet data.
+ *
+ * @param c
+ *   The reader cursor.
+ * @return
+ *   The offset in bytes.
+ */
+static inline uint32_t
+pktmbuf_cursor_pos(const pktmbuf_cursor_t *c)
+{
+    return c->pos;
+}
+
+/**
+ * Copy up to len bytes from the cursor position and advance the cursor.
+ *
+ * @param c
+ *   The reader cursor.
+ * @param buf
+ *   The buffer to copy the data into, at least len bytes long.
+ * @param len
+ *   The number of bytes to copy.
+ * @return
+ *   The number of bytes copied, less than len at the end of the packet.
+ */
+CNDP_API uint32_t pktmbuf_cursor_read(pktmbuf_cursor_t *c, void *buf, uint32_t len);
+
+/**
+ * Advance the cursor by up to len bytes.
+ *
+ * @param c
+ *   The reader cursor.
+ * @param len
+ *   The number of bytes to skip.
+ * @return
+ *   The number of bytes skipped, less than len at the end of the packet.
+ */
+CNDP_API uint32_t pktmbuf_cursor_skip(pktmbuf_cursor_t *c, uint32_t len);
+
+/**
+ * Get a pointer to len bytes of data at the cursor position without advancing it.
+ *
+ * When the data is contiguous in the current segment a pointer into the segment is
+ * returned, otherwise the data is copied into buf.
+ *
+ * @param c
+ *   The reader cursor.
+ * @param len
+ *   The number of bytes needed.
+ * @param buf
+ *   The buffer used when the data spans segments, at least len bytes long.
+ * @return
+ *   A pointer to the data or NULL if less than len bytes remain in the packet.
+ */
+static inline const void *
+pktmbuf_cursor_peek(const pktmbuf_cursor_t *c, uint32_t len, void *buf)
+{
+    pktmbuf_cursor_t tmp;
+
+    if (likely(c->seg && c->off + len <= pktmbuf_data_len(c->seg)))
+        return pktmbuf_mtod_offset(c->seg, char *, c->off);
+
+    tmp = *c;
+    return (pktmbuf_cursor_read(&tmp, buf, len) == len) ? buf : NULL;
+}
+
 /**
  * Dump an mbuf structure to a file.
  *
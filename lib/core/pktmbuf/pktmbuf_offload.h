@@ -179,13 +179,22 @@ extern "C" {
 #define CNE_MBUF_F_RX_OUTER_L4_CKSUM_GOOD    (1ULL << 22)
 #define CNE_MBUF_F_RX_OUTER_L4_CKSUM_INVALID ((1ULL << 21) | (1ULL << 22))
 
+/** RX hardware timestamp in nanoseconds is valid in the timestamp field of the mbuf. */
+#define CNE_MBUF_F_RX_TIMESTAMP (1ULL << 23)
+
 /* add new RX flags here, don't forget to update CNE_MBUF_F_FIRST_FREE */
 
-#define CNE_MBUF_F_FIRST_FREE (1ULL << 23)
-#define CNE_MBUF_F_LAST_FREE  (1ULL << 40)
+#define CNE_MBUF_F_FIRST_FREE (1ULL << 24)
+#define CNE_MBUF_F_LAST_FREE  (1ULL << 39)
 
 /* add new TX flags here, don't forget to update CNE_MBUF_F_LAST_FREE  */
 
+/**
+ * Request the NIC to transmit the packet at the time in nanoseconds held in the
+ * timestamp field of the mbuf.
+ */
+#define CNE_MBUF_F_TX_LAUNCH_TIME (1ULL << 40)
+
 /**
  * Outer UDP checksum offload flag. This flag is used for enabling
  * outer UDP checksum in PMD. To use outer UDP checksum, the user needs to
@@ -380,7 +389,8 @@ extern "C" {
      CNE_MBUF_F_TX_VLAN | CNE_MBUF_F_TX_IPV6 | CNE_MBUF_F_TX_IPV4 | CNE_MBUF_F_TX_IP_CKSUM | \
      CNE_MBUF_F_TX_L4_MASK | CNE_MBUF_F_TX_IEEE1588_TMST | CNE_MBUF_F_TX_TCP_SEG |           \
      CNE_MBUF_F_TX_QINQ | CNE_MBUF_F_TX_TUNNEL_MASK | CNE_MBUF_F_TX_MACSEC |                 \
-     CNE_MBUF_F_TX_SEC_OFFLOAD | CNE_MBUF_F_TX_UDP_SEG | CNE_MBUF_F_TX_OUTER_UDP_CKSUM)
+     CNE_MBUF_F_TX_SEC_OFFLOAD | CNE_MBUF_F_TX_UDP_SEG | CNE_MBUF_F_TX_OUTER_UDP_CKSUM |     \
+     CNE_MBUF_F_TX_LAUNCH_TIME)
 
 /**
  * Mbuf having an external buffer attached.
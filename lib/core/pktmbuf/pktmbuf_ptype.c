@@ -5,7 +5,11 @@
 
 #include <stdint.h>        // for uint32_t
 #include <stdio.h>         // for snprintf
+#include <stddef.h>        // for offsetof
+#include <string.h>        // for memcpy
 
+#include <cne_prefetch.h>
+#include <cne_vect.h>
 #include <pktmbuf.h>
 #include <pktmbuf_ptype.h>
 #include <cne_byteorder.h>
@@ -742,3 +746,257 @@ l3:
 
     return pkt_type;
 }
+
+/* Multipliers of the flow hash, the scalar and vector parsers must give the same hash */
+#define PTYPE_HASH_M1 0x9E3779B1
+#define PTYPE_HASH_M2 0x85EBCA77
+#define PTYPE_HASH_M3 0xC2B2AE3D
+#define PTYPE_HASH_M4 0x27D4EB2F
+
+static __cne_always_inline uint32_t
+ptype_hash_mix(uint32_t src, uint32_t dst, uint32_t ports, uint32_t proto)
+{
+    uint32_t h = (src * PTYPE_HASH_M1) ^ (dst * PTYPE_HASH_M2) ^ (ports * PTYPE_HASH_M3) ^ proto;
+
+    h ^= h >> 15;
+    h *= PTYPE_HASH_M4;
+    return h ^ (h >> 13);
+}
+
+/* The hash of an IP packet is set unless the driver provided one */
+static __cne_always_inline int
+ptype_want_hash(const pktmbuf_t *m, uint32_t ptype)
+{
+    return (ptype & (CNE_PTYPE_L3_IPV4 | CNE_PTYPE_L3_IPV6)) &&
+           !(m->ol_flags & CNE_MBUF_F_RX_RSS_HASH);
+}
+
+/* Flow hash of the addresses, IP protocol and ports, IPv6 addresses are folded to 32 bits */
+static uint32_t
+ptype_flow_hash(const pktmbuf_t *m, uint32_t ptype, uint32_t l2_len, uint32_t l3_len)
+{
+    const uint8_t *l3 = pktmbuf_mtod_offset(m, const uint8_t *, l2_len);
+    uint32_t l4       = ptype & CNE_PTYPE_L4_MASK;
+    uint32_t src, dst, ports = 0, proto;
+
+    if (CNE_ETH_IS_IPV4_HDR(ptype)) {
+        const struct cne_ipv4_hdr *ip4 = (const struct cne_ipv4_hdr *)l3;
+
+        src   = ip4->src_addr;
+        dst   = ip4->dst_addr;
+        proto = ip4->next_proto_id;
+    } else {
+        const struct cne_ipv6_hdr *ip6 = (const struct cne_ipv6_hdr *)l3;
+        uint32_t w[8];
+
+        memcpy(w, ip6->src_addr, sizeof(w));
+        src   = w[0] ^ w[1] ^ w[2] ^ w[3];
+        dst   = w[4] ^ w[5] ^ w[6] ^ w[7];
+        proto = ip6->proto;
+    }
+
+    if (l4 == CNE_PTYPE_L4_TCP || l4 == CNE_PTYPE_L4_UDP || l4 == CNE_PTYPE_L4_SCTP)
+        memcpy(&ports, l3 + l3_len, sizeof(ports));
+
+    return ptype_hash_mix(src, dst, ports, proto);
+}
+
+static __cne_always_inline void
+ptype_set(pktmbuf_t *m, uint32_t ptype, uint32_t l2_len, uint32_t l3_len, uint32_t l4_len)
+{
+    m->packet_type = ptype;
+    m->tx_offload  = 0;
+    m->l2_len      = l2_len;
+    m->l3_len      = l3_len;
+    m->l4_len      = l4_len;
+}
+
+static inline void
+ptype_parse_one(pktmbuf_t *m)
+{
+    struct cne_net_hdr_lens hdr_lens = {0};
+    uint32_t ptype;
+
+    ptype = cne_get_ptype(m, &hdr_lens, CNE_PTYPE_ALL_MASK);
+    ptype_set(m, ptype, hdr_lens.l2_len, hdr_lens.l3_len, hdr_lens.l4_len);
+
+    if (ptype_want_hash(m, ptype))
+        m->hash = ptype_flow_hash(m, ptype, hdr_lens.l2_len, hdr_lens.l3_len);
+}
+
+#ifdef CNE_MACHINE_CPUFLAG_AVX2
+#define PTYPE_VEC_PKTS 8 /**< Number of packets parsed at once */
+
+#define PTYPE_V(x)          _mm256_set1_epi32((int)(x))
+#define PTYPE_EQ(a, x)      _mm256_cmpeq_epi32((a), PTYPE_V(x))
+#define PTYPE_BYTE(a, s)    _mm256_and_si256(_mm256_srli_epi32((a), (s)), PTYPE_V(0xff))
+#define PTYPE_IF(m, x)      _mm256_and_si256((m), PTYPE_V(x))
+#define PTYPE_SEL(m, x, y)  _mm256_blendv_epi8(PTYPE_V(y), PTYPE_V(x), (m))
+#define PTYPE_MUL(a, x)     _mm256_mullo_epi32((a), PTYPE_V(x))
+
+/* Protocols following the IP header which only the scalar parser handles */
+static const uint8_t ptype_slow_protos[] = {
+    IPPROTO_HOPOPTS, IPPROTO_ROUTING, IPPROTO_FRAGMENT, IPPROTO_ESP, IPPROTO_AH,
+    IPPROTO_DSTOPTS, IPPROTO_GRE,     IPPROTO_IPIP,     IPPROTO_IPV6,
+};
+
+/* Gather the 32 bit word found off[i] bytes into the data of packet i */
+static __cne_always_inline __m256i
+ptype_gather(__m256i lo, __m256i hi, __m256i off)
+{
+    lo = _mm256_add_epi64(lo, _mm256_cvtepu32_epi64(_mm256_castsi256_si128(off)));
+    hi = _mm256_add_epi64(hi, _mm256_cvtepu32_epi64(_mm256_extracti128_si256(off, 1)));
+
+    return _mm256_set_m128i(_mm256_i64gather_epi32((const int *)0, hi, 1),
+                            _mm256_i64gather_epi32((const int *)0, lo, 1));
+}
+
+#define PTYPE_GATHER(off, x) ptype_gather(lo, hi, _mm256_add_epi32((off), PTYPE_V(x)))
+
+/*
+ * Parse the headers of 8 packets with AVX2, each lane holds one packet. Returns the mask
+ * of the packets the vector code could not parse, the caller parses them one at a time.
+ */
+static __cne_always_inline uint32_t
+ptype_parse_x8(pktmbuf_t **pkts)
+{
+    uint32_t res[5][PTYPE_VEC_PKTS] __cne_aligned(32);
+    __m256i lo, hi, w, vlan, et, vihl, is4, is6, ok, l2, l3, l4, a, proto, ihl;
+    __m256i p, tcp, udp, sctp, l4_len, dport, ptype, src, dst, ports, h;
+    uint32_t slow;
+
+#define PTYPE_PTR(i) (long long)(uintptr_t)pktmbuf_mtod(pkts[i], uint8_t *)
+    lo = _mm256_set_epi64x(PTYPE_PTR(3), PTYPE_PTR(2), PTYPE_PTR(1), PTYPE_PTR(0));
+    hi = _mm256_set_epi64x(PTYPE_PTR(7), PTYPE_PTR(6), PTYPE_PTR(5), PTYPE_PTR(4));
+#undef PTYPE_PTR
+
+    /* Ether type and the byte after it, both skip a single VLAN tag */
+    w    = PTYPE_GATHER(_mm256_setzero_si256(), offsetof(struct cne_ether_hdr, ether_type));
+    vlan = PTYPE_EQ(_mm256_and_si256(w, PTYPE_V(0xffff)), htobe16(CNE_ETHER_TYPE_VLAN));
+    if (!_mm256_testz_si256(vlan, vlan))
+        w = _mm256_blendv_epi8(w, PTYPE_GATHER(_mm256_setzero_si256(), 16), vlan);
+    et   = _mm256_and_si256(w, PTYPE_V(0xffff));
+    vihl = PTYPE_BYTE(w, 16);
+    l2   = _mm256_add_epi32(PTYPE_V(sizeof(struct cne_ether_hdr)),
+                            PTYPE_IF(vlan, sizeof(struct cne_vlan_hdr)));
+    is4  = PTYPE_EQ(et, htobe16(CNE_ETHER_TYPE_IPV4));
+    is6  = PTYPE_EQ(et, htobe16(CNE_ETHER_TYPE_IPV6));
+
+    /* IPv4 fragment offset or IPv6 next header, then the IPv4 protocol */
+    a     = PTYPE_GATHER(l2, 4);
+    ihl   = _mm256_slli_epi32(_mm256_and_si256(vihl, PTYPE_V(0x0f)), 2);
+    proto = _mm256_blendv_epi8(PTYPE_BYTE(PTYPE_GATHER(l2, 8), 8), PTYPE_BYTE(a, 16), is6);
+    l3    = _mm256_blendv_epi8(ihl, PTYPE_V(sizeof(struct cne_ipv6_hdr)), is6);
+
+    /* An IPv4 header with a valid length which is not a fragment */
+    ok = _mm256_and_si256(is4, PTYPE_EQ(_mm256_srli_epi32(vihl, 4), IPVERSION));
+    ok = _mm256_and_si256(ok, _mm256_cmpgt_epi32(ihl, PTYPE_V(sizeof(struct cne_ipv4_hdr) - 1)));
+    ok = _mm256_and_si256(
+        ok, PTYPE_EQ(_mm256_and_si256(_mm256_srli_epi32(a, 16),
+                                      PTYPE_V(htobe16(CNE_IPV4_HDR_OFFSET_MASK |
+                                                      CNE_IPV4_HDR_MF_FLAG))),
+                     0));
+    ok = _mm256_or_si256(ok, is6);
+    for (unsigned int i = 0; i < CNE_DIM(ptype_slow_protos); i++)
+        ok = _mm256_andnot_si256(PTYPE_EQ(proto, ptype_slow_protos[i]), ok);
+
+    slow = ~_mm256_movemask_ps(_mm256_castsi256_ps(ok)) & 0xff;
+    if (slow == 0xff)
+        return slow;
+
+    /* The L4 header */
+    l4     = _mm256_add_epi32(l2, l3);
+    p      = PTYPE_GATHER(l4, 0);
+    tcp    = PTYPE_EQ(proto, IPPROTO_TCP);
+    udp    = PTYPE_EQ(proto, IPPROTO_UDP);
+    sctp   = PTYPE_EQ(proto, IPPROTO_SCTP);
+    l4_len = _mm256_or_si256(PTYPE_IF(udp, sizeof(struct cne_udp_hdr)),
+                             PTYPE_IF(sctp, sizeof(struct cne_sctp_hdr)));
+    if (!_mm256_testz_si256(tcp, tcp)) {
+        __m256i doff = PTYPE_GATHER(l4, offsetof(struct cne_tcp_hdr, data_off));
+
+        doff   = _mm256_srli_epi32(_mm256_and_si256(doff, PTYPE_V(0xf0)), 2);
+        l4_len = _mm256_or_si256(l4_len, _mm256_and_si256(tcp, doff));
+    }
+    ports = _mm256_and_si256(p, _mm256_or_si256(_mm256_or_si256(tcp, udp), sctp));
+    dport = _mm256_srli_epi32(p, 16);
+
+    ptype = PTYPE_SEL(vlan, CNE_PTYPE_L2_ETHER_VLAN, CNE_PTYPE_L2_ETHER);
+    ptype = _mm256_or_si256(ptype, _mm256_blendv_epi8(PTYPE_SEL(PTYPE_EQ(vihl, 0x45),
+                                                                CNE_PTYPE_L3_IPV4,
+                                                                CNE_PTYPE_L3_IPV4_EXT),
+                                                      PTYPE_V(CNE_PTYPE_L3_IPV6), is6));
+    ptype = _mm256_or_si256(ptype, PTYPE_IF(tcp, CNE_PTYPE_L4_TCP));
+    ptype = _mm256_or_si256(ptype, PTYPE_IF(udp, CNE_PTYPE_L4_UDP));
+    ptype = _mm256_or_si256(ptype, PTYPE_IF(sctp, CNE_PTYPE_L4_SCTP));
+    ptype = _mm256_or_si256(ptype, PTYPE_IF(_mm256_and_si256(udp, PTYPE_EQ(dport, htobe16(
+                                                                       CNE_GTPU_UDP_PORT))),
+                                            CNE_PTYPE_TUNNEL_GTPU));
+    ptype = _mm256_or_si256(ptype, PTYPE_IF(_mm256_and_si256(udp, PTYPE_EQ(dport, htobe16(
+                                                                       CNE_GTPC_UDP_PORT))),
+                                            CNE_PTYPE_TUNNEL_GTPC));
+
+    /* Flow hash, the IPv6 addresses are folded with the words around the IPv4 addresses */
+    src = PTYPE_GATHER(l2, offsetof(struct cne_ipv4_hdr, src_addr));
+    dst = PTYPE_GATHER(l2, offsetof(struct cne_ipv4_hdr, dst_addr));
+    if (!_mm256_testz_si256(is6, is6)) {
+        __m256i s6, d6;
+
+        s6  = _mm256_xor_si256(_mm256_xor_si256(PTYPE_GATHER(l2, 8), src),
+                               _mm256_xor_si256(dst, PTYPE_GATHER(l2, 20)));
+        d6  = _mm256_xor_si256(_mm256_xor_si256(PTYPE_GATHER(l2, 24), PTYPE_GATHER(l2, 28)),
+                               _mm256_xor_si256(PTYPE_GATHER(l2, 32), PTYPE_GATHER(l2, 36)));
+        src = _mm256_blendv_epi8(src, s6, is6);
+        dst = _mm256_blendv_epi8(dst, d6, is6);
+    }
+    h = _mm256_xor_si256(PTYPE_MUL(src, PTYPE_HASH_M1), PTYPE_MUL(dst, PTYPE_HASH_M2));
+    h = _mm256_xor_si256(h, _mm256_xor_si256(PTYPE_MUL(ports, PTYPE_HASH_M3), proto));
+    h = _mm256_xor_si256(h, _mm256_srli_epi32(h, 15));
+    h = PTYPE_MUL(h, PTYPE_HASH_M4);
+    h = _mm256_xor_si256(h, _mm256_srli_epi32(h, 13));
+
+    _mm256_store_si256((__m256i *)res[0], ptype);
+    _mm256_store_si256((__m256i *)res[1], l2);
+    _mm256_store_si256((__m256i *)res[2], l3);
+    _mm256_store_si256((__m256i *)res[3], l4_len);
+    _mm256_store_si256((__m256i *)res[4], h);
+
+    for (int i = 0; i < PTYPE_VEC_PKTS; i++) {
+        pktmbuf_t *m = pkts[i];
+
+        if (slow & (1 << i))
+            continue;
+
+        ptype_set(m, res[0][i], res[1][i], res[2][i], res[3][i]);
+        if (!(m->ol_flags & CNE_MBUF_F_RX_RSS_HASH))
+            m->hash = res[4][i];
+    }
+
+    return slow;
+}
+#endif
+
+void
+cne_get_ptype_bulk(pktmbuf_t **pkts, uint16_t nb_pkts)
+{
+    uint16_t i = 0;
+
+#ifdef CNE_MACHINE_CPUFLAG_AVX2
+    for (int j = 0; j < PTYPE_VEC_PKTS && j < nb_pkts; j++)
+        cne_prefetch0(pktmbuf_mtod(pkts[j], void *));
+
+    for (; i + PTYPE_VEC_PKTS <= nb_pkts; i += PTYPE_VEC_PKTS) {
+        uint32_t slow;
+
+        /* Prefetch the headers of the next packets */
+        for (int j = i + PTYPE_VEC_PKTS; j < i + 2 * PTYPE_VEC_PKTS && j < nb_pkts; j++)
+            cne_prefetch0(pktmbuf_mtod(pkts[j], void *));
+
+        for (slow = ptype_parse_x8(&pkts[i]); slow; slow &= slow - 1)
+            ptype_parse_one(pkts[i + __builtin_ctz(slow)]);
+    }
+#endif
+
+    for (; i < nb_pkts; i++)
+        ptype_parse_one(pkts[i]);
+}
@@ -739,6 +739,24 @@ struct cne_net_hdr_lens {
 CNDP_API uint32_t cne_get_ptype(const pktmbuf_t *m, struct cne_net_hdr_lens *hdr_lens,
                                 uint32_t layers);
 
+/**
+ * Parse a burst of Ethernet packets to get their packet types.
+ *
+ * All of the layers are parsed as with cne_get_ptype() and CNE_PTYPE_ALL_MASK. The
+ * packet_type is set in each pktmbuf, tx_offload is cleared and l2_len, l3_len and l4_len
+ * are set. The hash of an IPv4 or IPv6 packet is set to a flow hash of its addresses, IP
+ * protocol and TCP, UDP or SCTP ports, unless CNE_MBUF_F_RX_RSS_HASH is set in ol_flags.
+ *
+ * With AVX2 the Ethernet or VLAN, IPv4 or IPv6 and TCP, UDP or SCTP headers of 8 packets
+ * are parsed at once, packets with any other headers are parsed one at a time.
+ *
+ * @param pkts
+ *   The packets to parse, the data offset is at the Ethernet header.
+ * @param nb_pkts
+ *   The number of packets in pkts[].
+ */
+CNDP_API void cne_get_ptype_bulk(pktmbuf_t **pkts, uint16_t nb_pkts);
+
 /**
  * Get the name of the l2 packet type
  *
@@ -3,7 +3,7 @@
  */
 
 #include <arpa/inet.h>              // for htons
-#include <linux/if_packet.h>        // for sockaddr_ll, tpacket2, PACKET_RX_RING, PACKET_TX_RING
+#include <linux/if_packet.h>        // for sockaddr_ll, tpacket3_hdr, PACKET_RX_RING, PACKET_FANOUT
 #include <net/if.h>                 // for if_nametoindex, IF_NAMESIZE
 #include <bsd/string.h>             // for memset, strlcpy
 #include <sys/mman.h>               // for mmap, munmap
@@ -11,8 +11,12 @@
 #include <sys/socket.h>             // for AF_PACKET, SOL_PACKET
 #include <stdint.h>                 // for uint16_t, uint64_t
 #include <stdlib.h>                 // for NULL, calloc, free, size_t
+#include <strings.h>                // for strcasecmp
+#include <errno.h>                  // for errno, ENOBUFS, EAGAIN
+#include <unistd.h>                 // for close
 #include <cne_log.h>                // for CNE_LOG, CNE_ERR_RET, CNE_ERR,GOTO, CNE_PTR_ADD
 #include <cne_lport.h>              // for lport_cfg_t, lport_stats_t
+#include <kvargs.h>                 // for kvargs_parse, kvargs_free, kvargs_uint32
 #include <pktdev.h>                 // for pktdev_info
 #include <pktdev_core.h>            // for cne_pktdev, pktdev_ops
 #include <pktdev_driver.h>          // for pktdev_allocate, pkt...
@@ -27,24 +31,49 @@
 #define BLK_CNT   512
 #define FRAME_CNT (BLK_CNT * BLK_SZ) / FRAME_SZ
 
+/* TPACKET_V3 RX blocks hold many frames, the kernel only hands over full or retired blocks */
+#define RX_BLK_SZ  (1 << 17)
+#define RX_BLK_CNT 64
+
+/* Linux 4.20 and later, older headers do not define it */
+#ifndef PACKET_IGNORE_OUTGOING
+#define PACKET_IGNORE_OUTGOING 23
+#endif
+
+/* pmd_opts keys, i.e. "pmd": "net_af_packet:fanout=hash,blk_tmo=1" */
+#define AF_PACKET_BLK_TMO_ARG       "blk_tmo"
+#define AF_PACKET_FANOUT_ARG        "fanout"
+#define AF_PACKET_FANOUT_ID_ARG     "fanout_id"
+#define AF_PACKET_QDISC_BYPASS_ARG  "qdisc_bypass"
+
+static const char *const valid_args[] = {AF_PACKET_BLK_TMO_ARG, AF_PACKET_FANOUT_ARG,
+                                         AF_PACKET_FANOUT_ID_ARG, AF_PACKET_QDISC_BYPASS_ARG, NULL};
+
 struct af_pkt_rx_q {
     int fd;
     void *map;
+    size_t map_sz;
     struct iovec *rd;
 
-    size_t frame_num;
-    size_t frame_cnt;
+    size_t blk_num;
+    size_t blk_cnt;
+    struct tpacket3_hdr *ppd; /**< Next packet in the current block */
+    uint32_t pkts_left;       /**< Packets left in the current block */
+    int drop_outgoing;        /**< Drop PACKET_OUTGOING frames, kernel cannot ignore them */
 
     struct pmd_lport *lport;
     uint16_t lport_id;
 
     uint64_t n_pkts;
     uint64_t n_bytes;
+    uint64_t n_missed;
+    uint64_t n_errors;
 };
 
 struct af_pkt_tx_q {
     int fd;
     void *map;
+    size_t map_sz;
     struct iovec *rd;
 
     size_t frame_num;
@@ -53,31 +82,46 @@ struct af_pkt_tx_q {
 
     uint64_t n_pkts;
     uint64_t n_bytes;
+    uint64_t n_errors;
+    uint64_t n_kicks;
 };
 
 struct pmd_lport {
     uint16_t lport_id;
     char if_name[IFNAMSIZ];
     int if_index;
-    int fd;
     pktmbuf_info_t *pi;
-    struct tpacket_req tp_req;
+    struct tpacket_req3 rx_req;
+    struct tpacket_req tx_req;
     struct ether_addr eth_addr;
 
+    uint32_t blk_tmo;      /**< RX block retire timeout in ms, 0 for the kernel default */
+    uint32_t fanout;       /**< PACKET_FANOUT_* mode and flags, 0 when fanout is not used */
+    uint32_t fanout_id;    /**< Fanout group ID, lports using the same ID share the packets */
+    uint32_t qdisc_bypass; /**< Send packets directly to the driver, skipping the qdisc layer */
+
     struct af_pkt_rx_q *rxq;
     struct af_pkt_tx_q *txq;
 };
 
+static inline void
+rx_block_release(struct af_pkt_rx_q *rxq, struct tpacket_block_desc *pbd)
+{
+    __atomic_store_n(&pbd->hdr.bh1.block_status, TP_STATUS_KERNEL, __ATOMIC_RELEASE);
+
+    if (++rxq->blk_num >= rxq->blk_cnt)
+        rxq->blk_num = 0;
+}
+
 static uint16_t
 pmd_af_packet_rx(void *queue, pktmbuf_t **bufs, uint16_t nb_pkts)
 {
     struct af_pkt_rx_q *rxq = queue;
-    struct tpacket2_hdr *tp_hdr;
+    struct tpacket_block_desc *pbd;
+    struct tpacket3_hdr *ppd;
     pktmbuf_t *mbuf;
-    uint8_t *pkt_buf;
     uint64_t n_rx_pkts  = 0;
     uint64_t n_rx_bytes = 0;
-    size_t frame_cnt, frame_num, i;
 
     if (!queue || !bufs)
         return 0;
@@ -85,34 +129,66 @@ pmd_af_packet_rx(void *queue, pktmbuf_t **bufs, uint16_t nb_pkts)
     if (unlikely(nb_pkts == 0))
         return 0;
 
-    frame_num = rxq->frame_num;
-    frame_cnt = rxq->frame_cnt;
+    /* Walk the packets of the current block and move to the next block once done */
+    while (n_rx_pkts < nb_pkts) {
+        pbd = (struct tpacket_block_desc *)rxq->rd[rxq->blk_num].iov_base;
+
+        if (rxq->pkts_left == 0) {
+            if ((__atomic_load_n(&pbd->hdr.bh1.block_status, __ATOMIC_ACQUIRE) &
+                 TP_STATUS_USER) == 0)
+                break;
+
+            rxq->pkts_left = pbd->hdr.bh1.num_pkts;
+            rxq->ppd = (struct tpacket3_hdr *)CNE_PTR_ADD(pbd, pbd->hdr.bh1.offset_to_first_pkt);
+            if (rxq->pkts_left == 0) {
+                rx_block_release(rxq, pbd);
+                continue;
+            }
+        }
+        ppd = rxq->ppd;
+
+        /* Skip the copies of the packets sent on the interface */
+        if (unlikely(rxq->drop_outgoing)) {
+            struct sockaddr_ll *sll =
+                CNE_PTR_ADD(ppd, TPACKET_ALIGN(sizeof(struct tpacket3_hdr)));
+
+            if (sll->sll_pkttype == PACKET_OUTGOING)
+                goto next;
+        }
 
-    /* Read packets from the AF_PACKET socket & store in allocated mbuf */
-    for (i = 0; i < nb_pkts; i++) {
-        tp_hdr = (struct tpacket2_hdr *)rxq->rd[frame_num].iov_base; /*next frame to rx */
-        if ((tp_hdr->tp_status & TP_STATUS_USER) == 0)
-            break;
-        /* Allocate mbuf */
         mbuf = pktmbuf_alloc(rxq->lport->pi);
         if (unlikely(mbuf == NULL))
             break;
-        /* Rx incoming  packet */
-        pktmbuf_data_len(mbuf) = tp_hdr->tp_snaplen;
-        pkt_buf                = (uint8_t *)tp_hdr + tp_hdr->tp_mac;
-        memcpy(pktmbuf_mtod(mbuf, void *), pkt_buf, pktmbuf_data_len(mbuf));
-
-        /* Process incoming frame, advance buf*/
-        tp_hdr->tp_status = TP_STATUS_KERNEL;
-        if (++frame_num >= frame_cnt)
-            frame_num = 0;
-        mbuf->lport = rxq->lport_id;
 
-        bufs[i] = mbuf;
-        n_rx_pkts++;
-        n_rx_bytes += mbuf->data_len;
+        if (unlikely(ppd->tp_snaplen > pktmbuf_tailroom(mbuf))) {
+            /* Too large for an mbuf, drop it and report it as an input error */
+            rxq->n_errors++;
+            pktmbuf_free(mbuf);
+        } else {
+            pktmbuf_data_len(mbuf) = ppd->tp_snaplen;
+            memcpy(pktmbuf_mtod(mbuf, void *), CNE_PTR_ADD(ppd, ppd->tp_mac), ppd->tp_snaplen);
+
+            mbuf->lport = rxq->lport_id;
+
+            /* A zero hash means the kernel had none for the packet */
+            if (ppd->hv1.tp_rxhash) {
+                mbuf->hash = ppd->hv1.tp_rxhash;
+                mbuf->ol_flags |= CNE_MBUF_F_RX_RSS_HASH;
+            }
+            if (ppd->tp_status & TP_STATUS_VLAN_VALID) {
+                mbuf->vlan_tci = ppd->hv1.tp_vlan_tci;
+                mbuf->ol_flags |= CNE_MBUF_F_RX_VLAN | CNE_MBUF_F_RX_VLAN_STRIPPED;
+            }
+
+            bufs[n_rx_pkts++] = mbuf;
+            n_rx_bytes += ppd->tp_snaplen;
+        }
+
+    next:
+        rxq->ppd = (struct tpacket3_hdr *)CNE_PTR_ADD(ppd, ppd->tp_next_offset);
+        if (--rxq->pkts_left == 0)
+            rx_block_release(rxq, pbd);
     }
-    rxq->frame_num = frame_num;
 
     rxq->n_pkts += n_rx_pkts;
     rxq->n_bytes += n_rx_bytes;
@@ -130,6 +206,7 @@ pmd_af_packet_tx(void *queue, pktmbuf_t **bufs, uint16_t nb_pkts)
     uint64_t n_tx_pkts  = 0;
     uint64_t n_tx_bytes = 0;
     size_t frame_cnt, frame_num, i;
+    uint32_t len;
 
     if (!queue || !bufs)
         return 0;
@@ -142,34 +219,55 @@ pmd_af_packet_tx(void *queue, pktmbuf_t **bufs, uint16_t nb_pkts)
 
     tp_hdr = (struct tpacket2_hdr *)txq->rd[frame_num].iov_base; /*next frame to tx */
     for (i = 0; i < nb_pkts; i++) {
-        mbuf = *bufs++;
-        if (tp_hdr->tp_status != TP_STATUS_AVAILABLE)
+        if (__atomic_load_n(&tp_hdr->tp_status, __ATOMIC_ACQUIRE) != TP_STATUS_AVAILABLE)
             break;
 
-        pkt_buf = (uint8_t *)tp_hdr + TPACKET2_HDRLEN - sizeof(struct sockaddr_ll);
-        memcpy(pkt_buf, pktmbuf_mtod(mbuf, void *), pktmbuf_data_len(mbuf));
+        mbuf = *bufs++;
+        len  = pktmbuf_pkt_len(mbuf);
+        if (unlikely(len > txq->data_sz)) {
+            /* Too large for a frame, drop it and report it as an output error */
+            txq->n_errors++;
+            pktmbuf_free(mbuf);
+            continue;
+        }
 
-        tp_hdr->tp_len     = pktmbuf_data_len(mbuf);
-        tp_hdr->tp_snaplen = pktmbuf_data_len(mbuf);
-        tp_hdr->tp_status  = TP_STATUS_SEND_REQUEST;
+        pkt_buf = (uint8_t *)tp_hdr + TPACKET2_HDRLEN - sizeof(struct sockaddr_ll);
+        if (likely(mbuf->nb_segs == 1))
+            memcpy(pkt_buf, pktmbuf_mtod(mbuf, void *), len);
+        else {
+            pktmbuf_cursor_t cur;
+
+            pktmbuf_cursor_init(&cur, mbuf, 0);
+            pktmbuf_cursor_read(&cur, pkt_buf, len);
+        }
+
+        tp_hdr->tp_len     = len;
+        tp_hdr->tp_snaplen = len;
+        __atomic_store_n(&tp_hdr->tp_status, TP_STATUS_SEND_REQUEST, __ATOMIC_RELEASE);
         if (++frame_num >= frame_cnt)
             frame_num = 0;
         tp_hdr = (struct tpacket2_hdr *)txq->rd[frame_num].iov_base;
         n_tx_pkts++;
-        n_tx_bytes += pktmbuf_data_len(mbuf);
+        n_tx_bytes += len;
         pktmbuf_free(mbuf);
     }
-    if (sendto(txq->fd, NULL, 0, MSG_DONTWAIT, NULL, 0) == -1 && errno != ENOBUFS &&
-        errno != EAGAIN) {
-        n_tx_pkts  = 0;
-        n_tx_bytes = 0;
-    }
     txq->frame_num = frame_num;
 
+    /*
+     * One kick for the whole burst. The frames stay queued in the TX ring when
+     * the kick fails and go out with the next kick, so the mbufs are consumed.
+     */
+    if (n_tx_pkts) {
+        txq->n_kicks++;
+        if (sendto(txq->fd, NULL, 0, MSG_DONTWAIT, NULL, 0) == -1 && errno != ENOBUFS &&
+            errno != EAGAIN)
+            txq->n_errors++;
+    }
+
     txq->n_pkts += n_tx_pkts;
     txq->n_bytes += n_tx_bytes;
 
-    return n_tx_pkts;
+    return i;
 }
 
 static int
@@ -195,35 +293,64 @@ pmd_stats_get(struct cne_pktdev *dev, lport_stats_t *stats)
     struct pmd_lport *lport = dev->data->dev_private;
     struct af_pkt_rx_q *rxq = lport->rxq;
     struct af_pkt_tx_q *txq = lport->txq;
+    struct tpacket_stats_v3 st;
+    socklen_t len = sizeof(st);
+
+    /* The kernel clears its counters on each read, so they are accumulated here */
+    if (getsockopt(rxq->fd, SOL_PACKET, PACKET_STATISTICS, &st, &len) == 0)
+        rxq->n_missed += st.tp_drops;
 
     /* RX stats */
     stats->ipackets = rxq->n_pkts;
     stats->ibytes   = rxq->n_bytes;
+    stats->imissed  = rxq->n_missed;
+    stats->ierrors  = rxq->n_errors;
 
     /* TX stats */
     stats->opackets = txq->n_pkts;
     stats->obytes   = txq->n_bytes;
+    stats->oerrors  = txq->n_errors;
+    stats->tx_kicks = txq->n_kicks;
 
     return 0;
 }
 
+static void
+af_packet_queues_free(struct pmd_lport *lport)
+{
+    struct af_pkt_rx_q *rxq = lport->rxq;
+    struct af_pkt_tx_q *txq = lport->txq;
+
+    if (rxq) {
+        if (rxq->map != MAP_FAILED)
+            munmap(rxq->map, rxq->map_sz);
+        if (rxq->fd != -1)
+            close(rxq->fd);
+        free(rxq->rd);
+        free(rxq);
+        lport->rxq = NULL;
+    }
+    if (txq) {
+        if (txq->map != MAP_FAILED)
+            munmap(txq->map, txq->map_sz);
+        if (txq->fd != -1)
+            close(txq->fd);
+        free(txq->rd);
+        free(txq);
+        lport->txq = NULL;
+    }
+}
+
 static void
 pmd_dev_close(struct cne_pktdev *dev)
 {
     struct pmd_lport *lport;
-    struct tpacket_req *rq;
 
     CNE_LOG(DEBUG, "Closing AF_PACKET on socket\n");
 
     lport = dev->data->dev_private;
-    rq    = &lport->tp_req;
-
-    munmap(lport->rxq->map, 2 * rq->tp_block_size * rq->tp_block_nr);
-    free(lport->rxq->rd);
-    free(lport->txq->rd);
-    close(lport->fd);
-    free(lport->rxq);
-    free(lport->txq);
+
+    af_packet_queues_free(lport);
     free(lport);
 
     dev->data->mac_addr = NULL;
@@ -256,125 +383,249 @@ static struct pktdev_driver af_packet_drv = {
 PMD_REGISTER_DEV(net_af_packet, af_packet_drv);
 
 static int
-pmd_af_packet_probe(lport_cfg_t *c)
+af_packet_parse_args(struct pmd_lport *lport, const char *pmd_opts)
+{
+    struct kvargs *kvlist;
+    char *fanout = NULL;
+    int ret      = -1;
+
+    lport->fanout_id = lport->if_index & 0xFFFF;
+
+    if (!pmd_opts || pmd_opts[0] == '\0')
+        return 0;
+
+    kvlist = kvargs_parse(pmd_opts, valid_args);
+    if (!kvlist)
+        CNE_ERR_RET("Invalid af_packet options '%s'\n", pmd_opts);
+
+    if (kvargs_uint32(kvlist, AF_PACKET_BLK_TMO_ARG, &lport->blk_tmo) < 0 ||
+        kvargs_uint32(kvlist, AF_PACKET_FANOUT_ID_ARG, &lport->fanout_id) < 0 ||
+        kvargs_uint32(kvlist, AF_PACKET_QDISC_BYPASS_ARG, &lport->qdisc_bypass) < 0 ||
+        kvargs_ptr(kvlist, AF_PACKET_FANOUT_ARG, &fanout) < 0)
+        CNE_ERR_GOTO(leave, "Failed to parse af_packet options '%s'\n", pmd_opts);
+
+    if (lport->fanout_id > 0xFFFF)
+        CNE_ERR_GOTO(leave, "Fanout group ID %u is too large\n", lport->fanout_id);
+
+    if (fanout) {
+        if (!strcasecmp(fanout, "hash"))
+            lport->fanout = PACKET_FANOUT_HASH | PACKET_FANOUT_FLAG_DEFRAG;
+        else if (!strcasecmp(fanout, "cpu"))
+            lport->fanout = PACKET_FANOUT_CPU;
+        else if (!strcasecmp(fanout, "qm"))
+            lport->fanout = PACKET_FANOUT_QM;
+        else if (!strcasecmp(fanout, "lb"))
+            lport->fanout = PACKET_FANOUT_LB;
+        else
+            CNE_ERR_GOTO(leave, "Unknown fanout mode '%s', use hash, cpu, qm or lb\n", fanout);
+        lport->fanout |= PACKET_FANOUT_FLAG_ROLLOVER;
+    }
+    ret = 0;
+
+leave:
+    kvargs_free(kvlist);
+    return ret;
+}
+
+static int
+af_packet_socket(struct pmd_lport *lport, uint16_t protocol, int ver)
 {
     struct sockaddr_ll addr;
-    struct pmd_lport *lport;
-    struct cne_pktdev *dev;
-    struct tpacket_req *rq;
-    struct af_pkt_rx_q *rxq;
-    struct af_pkt_tx_q *txq;
-    struct ifreq ifr;
-    int fd = -1, ver, num_q = 1, ret = 0;
-    size_t i, rd_sz, rq_sz;
+    int fd;
 
-    if (!c)
+    fd = socket(AF_PACKET, SOCK_RAW, protocol);
+    if (fd == -1)
+        CNE_ERR_RET("Failed to open AF_PACKET socket for %s\n", lport->if_name);
+
+    if (setsockopt(fd, SOL_PACKET, PACKET_VERSION, &ver, sizeof(ver)) == -1)
+        CNE_ERR_GOTO(err, "Err AF_PACKET: Failed to set PACKET_VERSION\n");
+
+    memset(&addr, 0, sizeof(addr));
+    addr.sll_family   = AF_PACKET;
+    addr.sll_protocol = protocol;
+    addr.sll_ifindex  = lport->if_index;
+
+    if (bind(fd, (const struct sockaddr *)&addr, sizeof(addr)) == -1)
+        CNE_ERR_GOTO(err, "Err: Failed to bind AF_PACKET socket\n");
+
+    return fd;
+err:
+    close(fd);
+    return -1;
+}
+
+static int
+af_packet_rx_setup(struct pmd_lport *lport)
+{
+    struct tpacket_req3 *rq = &lport->rx_req;
+    struct af_pkt_rx_q *rxq = lport->rxq;
+    size_t i;
+
+    rq->tp_block_size       = RX_BLK_SZ;
+    rq->tp_block_nr         = RX_BLK_CNT;
+    rq->tp_frame_size       = FRAME_SZ;
+    rq->tp_frame_nr         = (RX_BLK_SZ * RX_BLK_CNT) / FRAME_SZ;
+    rq->tp_retire_blk_tov   = lport->blk_tmo;
+    rq->tp_feature_req_word = TP_FT_REQ_FILL_RXHASH;
+
+    /* Bind with protocol 0 first so no packets are queued before the ring exists */
+    rxq->fd = af_packet_socket(lport, 0, TPACKET_V3);
+    if (rxq->fd == -1)
         return -1;
 
-    CNE_LOG(DEBUG, "Init %s\n", c->ifname);
+    if (setsockopt(rxq->fd, SOL_PACKET, PACKET_RX_RING, rq, sizeof(*rq)) == -1)
+        CNE_ERR_RET("Err AF_PACKET: Failed to set PACKET_RX_RING\n");
 
-    lport = calloc(1, sizeof(struct pmd_lport));
-    if (!lport)
-        CNE_ERR_RET("Failed to allocate memory\n");
+    rxq->map_sz = (size_t)rq->tp_block_size * rq->tp_block_nr;
+    rxq->map    = mmap(NULL, rxq->map_sz, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_LOCKED,
+                       rxq->fd, 0);
+    if (rxq->map == MAP_FAILED)
+        CNE_ERR_RET("Err AF_PACKET MMAP: Failed to get mmap on socket\n");
 
-    strlcpy(lport->if_name, c->ifname, sizeof(lport->if_name));
+    rxq->blk_cnt = rq->tp_block_nr;
+    rxq->rd      = calloc(rxq->blk_cnt, sizeof(*(rxq->rd)));
+    if (rxq->rd == NULL)
+        CNE_ERR_RET("Err iovec\n");
 
-    dev = pktdev_allocate(c->name, c->ifname);
-    if (!dev)
-        CNE_ERR_GOTO(err_exit, "pktdev_allocate(%s, %s) failed\n", c->name, c->ifname);
-    dev->drv = &af_packet_drv;
+    for (i = 0; i < rxq->blk_cnt; ++i) {
+        rxq->rd[i].iov_base = CNE_PTR_ADD(rxq->map, (i * rq->tp_block_size));
+        rxq->rd[i].iov_len  = rq->tp_block_size;
+    }
+    rxq->lport    = lport;
+    rxq->lport_id = lport->lport_id;
 
-    lport->lport_id = dev->data->lport_id;
-    lport->pi       = c->pi;
+    /* The RX socket is bound to ETH_P_ALL and would also see the packets sent by the TX socket */
+    {
+        int ignore = 1;
 
-    ret = netdev_get_mac_addr(c->ifname, &lport->eth_addr);
-    if (ret)
-        CNE_ERR_GOTO(err_exit, "netdev_get_mac_addr() failed\n");
+        if (setsockopt(rxq->fd, SOL_PACKET, PACKET_IGNORE_OUTGOING, &ignore, sizeof(ignore)) ==
+            -1) {
+            CNE_DEBUG("AF_PACKET: PACKET_IGNORE_OUTGOING not supported, drop outgoing frames\n");
+            rxq->drop_outgoing = 1;
+        }
+    }
 
-    fd = socket(AF_PACKET, SOCK_RAW, htons(ETH_P_ALL));
-    if (fd == -1)
-        CNE_ERR_GOTO(err_exit, "Failed to open AF_PACKET socket for %s\n", c->ifname);
+    {
+        struct sockaddr_ll addr = {0};
 
-    strlcpy(ifr.ifr_name, lport->if_name, IFNAMSIZ);
+        addr.sll_family   = AF_PACKET;
+        addr.sll_protocol = htons(ETH_P_ALL);
+        addr.sll_ifindex  = lport->if_index;
 
-    if (ioctl(fd, SIOCGIFINDEX, &ifr) == -1)
-        CNE_ERR_GOTO(err_exit, "Err ioctl\n");
-    lport->if_index = ifr.ifr_ifindex;
+        if (bind(rxq->fd, (const struct sockaddr *)&addr, sizeof(addr)) == -1)
+            CNE_ERR_RET("Err: Failed to bind AF_PACKET RX socket\n");
+    }
 
-    memset(&addr, 0, sizeof(addr));
-    addr.sll_family   = AF_PACKET;
-    addr.sll_protocol = htons(ETH_P_ALL);
-    addr.sll_ifindex  = lport->if_index;
+    if (lport->fanout) {
+        int arg = (int)(lport->fanout_id | (lport->fanout << 16));
 
-    ret = bind(fd, (const struct sockaddr *)&addr, sizeof(addr));
-    if (ret == -1)
-        CNE_ERR_GOTO(err_exit, "Err: Failed to bind AF_PACKET socket\n");
+        if (setsockopt(rxq->fd, SOL_PACKET, PACKET_FANOUT, &arg, sizeof(arg)) == -1)
+            CNE_ERR_RET("Err AF_PACKET: Failed to join fanout group %u\n", lport->fanout_id);
+    }
 
-    lport->rxq = calloc(num_q, sizeof(struct af_pkt_rx_q));
-    lport->txq = calloc(num_q, sizeof(struct af_pkt_tx_q));
-    if (!(lport->rxq) || !(lport->txq))
-        CNE_ERR_GOTO(err_exit, "Failed to allocate rx_tx queue\n");
+    return 0;
+}
 
-    lport->rxq->map = MAP_FAILED;
-    lport->txq->map = MAP_FAILED;
-    lport->rxq->fd  = -1;
-    lport->txq->fd  = -1;
+static int
+af_packet_tx_setup(struct pmd_lport *lport)
+{
+    struct tpacket_req *rq  = &lport->tx_req;
+    struct af_pkt_tx_q *txq = lport->txq;
+    int loss                = 1;
+    size_t i;
 
-    rq                = &(lport->tp_req);
     rq->tp_block_size = BLK_SZ;
     rq->tp_block_nr   = BLK_CNT;
     rq->tp_frame_size = FRAME_SZ;
     rq->tp_frame_nr   = FRAME_CNT;
 
-    rq_sz     = rq->tp_block_size * rq->tp_block_nr;
-    lport->fd = fd;
-    ver       = TPACKET_V2;
-    ret       = setsockopt(fd, SOL_PACKET, PACKET_VERSION, &ver, sizeof(ver));
-    if (ret == -1)
-        CNE_ERR_GOTO(err_exit, "Err AF_PACKET: Failed to set PACKET_VERSION\n");
+    /* The TX socket is bound with protocol 0, it never receives packets */
+    txq->fd = af_packet_socket(lport, 0, TPACKET_V2);
+    if (txq->fd == -1)
+        return -1;
 
-    ret = setsockopt(fd, SOL_PACKET, PACKET_RX_RING, rq, sizeof(*rq));
-    if (ret == -1)
-        CNE_ERR_GOTO(err_exit, "Err AF_PACKET: Failed to set PACKET_RX_RING\n");
+    /* Drop malformed frames instead of stopping the TX ring */
+    if (setsockopt(txq->fd, SOL_PACKET, PACKET_LOSS, &loss, sizeof(loss)) == -1)
+        CNE_ERR_RET("Err AF_PACKET: Failed to set PACKET_LOSS\n");
 
-    ret = setsockopt(fd, SOL_PACKET, PACKET_TX_RING, rq, sizeof(*rq));
-    if (ret == -1)
-        CNE_ERR_GOTO(err_exit, "Err AF_PACKET: Failed to set PACKET_TX_RING\n");
+    if (lport->qdisc_bypass &&
+        setsockopt(txq->fd, SOL_PACKET, PACKET_QDISC_BYPASS, &lport->qdisc_bypass,
+                   sizeof(lport->qdisc_bypass)) == -1)
+        CNE_ERR_RET("Err AF_PACKET: Failed to set PACKET_QDISC_BYPASS\n");
 
-    rxq            = lport->rxq;
-    rxq->frame_cnt = rq->tp_frame_nr;
-    rxq->map       = mmap(NULL, 2 * rq_sz, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_LOCKED, fd, 0);
-    if (rxq->map == MAP_FAILED)
-        CNE_ERR_GOTO(err_exit, "Err AF_PACKET MMAP: Failed to get mmap on socket\n");
-
-    rd_sz   = rq->tp_frame_nr * sizeof(*(rxq->rd));
-    rxq->rd = calloc(1, rd_sz);
-    if (rxq->rd == NULL)
-        CNE_ERR_GOTO(err_exit, "Err iovec\n");
+    if (setsockopt(txq->fd, SOL_PACKET, PACKET_TX_RING, rq, sizeof(*rq)) == -1)
+        CNE_ERR_RET("Err AF_PACKET: Failed to set PACKET_TX_RING\n");
 
-    for (i = 0; i < rq->tp_frame_nr; ++i) {
-        rxq->rd[i].iov_base = CNE_PTR_ADD(rxq->map, (i * FRAME_SZ));
-        rxq->rd[i].iov_len  = rq->tp_frame_size;
-    }
-    rxq->fd       = fd;
-    rxq->lport    = lport;
-    rxq->lport_id = lport->lport_id;
+    txq->map_sz = (size_t)rq->tp_block_size * rq->tp_block_nr;
+    txq->map    = mmap(NULL, txq->map_sz, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_LOCKED,
+                       txq->fd, 0);
+    if (txq->map == MAP_FAILED)
+        CNE_ERR_RET("Err AF_PACKET MMAP: Failed to get mmap on socket\n");
 
-    txq            = lport->txq;
     txq->frame_cnt = rq->tp_frame_nr;
     txq->data_sz   = rq->tp_frame_size;
     txq->data_sz -= TPACKET2_HDRLEN - sizeof(struct sockaddr_ll);
-    txq->map = CNE_PTR_ADD(rxq->map, rq_sz);
 
-    txq->rd = calloc(1, rd_sz);
+    txq->rd = calloc(txq->frame_cnt, sizeof(*(txq->rd)));
     if (txq->rd == NULL)
-        CNE_ERR_GOTO(err_exit, "Err iovec\n");
+        CNE_ERR_RET("Err iovec\n");
 
-    for (i = 0; i < rq->tp_frame_nr; ++i) {
+    for (i = 0; i < txq->frame_cnt; ++i) {
         txq->rd[i].iov_base = CNE_PTR_ADD(txq->map, (i * FRAME_SZ));
         txq->rd[i].iov_len  = rq->tp_frame_size;
     }
-    txq->fd = fd;
+
+    return 0;
+}
+
+static int
+pmd_af_packet_probe(lport_cfg_t *c)
+{
+    struct pmd_lport *lport;
+    struct cne_pktdev *dev = NULL;
+    int num_q = 1, ret = -1;
+
+    if (!c)
+        return -1;
+
+    CNE_LOG(DEBUG, "Init %s\n", c->ifname);
+
+    lport = calloc(1, sizeof(struct pmd_lport));
+    if (!lport)
+        CNE_ERR_RET("Failed to allocate memory\n");
+
+    strlcpy(lport->if_name, c->ifname, sizeof(lport->if_name));
+
+    dev = pktdev_allocate(c->name, c->ifname);
+    if (!dev)
+        CNE_ERR_GOTO(err_exit, "pktdev_allocate(%s, %s) failed\n", c->name, c->ifname);
+    dev->drv = &af_packet_drv;
+
+    lport->lport_id = dev->data->lport_id;
+    lport->pi       = c->pi;
+
+    if (netdev_get_mac_addr(c->ifname, &lport->eth_addr))
+        CNE_ERR_GOTO(err_exit, "netdev_get_mac_addr() failed\n");
+
+    lport->if_index = if_nametoindex(lport->if_name);
+    if (lport->if_index == 0)
+        CNE_ERR_GOTO(err_exit, "Failed to get ifindex of %s\n", lport->if_name);
+
+    if (af_packet_parse_args(lport, c->pmd_opts) < 0)
+        goto err_exit;
+
+    lport->rxq = calloc(num_q, sizeof(struct af_pkt_rx_q));
+    lport->txq = calloc(num_q, sizeof(struct af_pkt_tx_q));
+    if (!(lport->rxq) || !(lport->txq))
+        CNE_ERR_GOTO(err_exit, "Failed to allocate rx_tx queue\n");
+
+    lport->rxq->map = MAP_FAILED;
+    lport->txq->map = MAP_FAILED;
+    lport->rxq->fd  = -1;
+    lport->txq->fd  = -1;
+
+    if (af_packet_rx_setup(lport) < 0 || af_packet_tx_setup(lport) < 0)
+        goto err_exit;
 
     dev->data->dev_private = lport;
     dev->data->mac_addr    = &lport->eth_addr;
@@ -387,24 +638,11 @@ pmd_af_packet_probe(lport_cfg_t *c)
     return (pktdev_portid(dev));
 
 err_exit:
-    if (lport->rxq != NULL) {
-        free(lport->rxq->rd);
-        if (lport->rxq->map != MAP_FAILED)
-            munmap(lport->rxq->map, 2 * lport->tp_req.tp_block_size * lport->tp_req.tp_block_nr);
-        free(lport->rxq);
-    }
-    if (lport->txq != NULL) {
-        free(lport->txq->rd);
-        free(lport->txq);
-    }
-
-    if (fd != -1)
-        close(fd);
+    af_packet_queues_free(lport);
 
     pktdev_release_port(dev);
 
-    if (lport)
-        free(lport);
+    free(lport);
 
     return ret;
 }
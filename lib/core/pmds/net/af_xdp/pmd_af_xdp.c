@@ -68,15 +68,16 @@ struct pkt_tx_queue {
 struct pmd_lport {
     char if_name[IF_NAMESIZE + 1];
     int qid;
+    uint16_t nb_queues;
     uint64_t umem_begin;
     size_t umem_size;
     unsigned int prog_id;
-    xskdev_info_t *xi;
+    xskdev_info_t *xi[LPORT_MAX_QUEUES]; /* One AF_XDP socket per queue */
     struct ether_addr eth_addr;
     struct offloads off;
 
-    struct pkt_rx_queue rxq;
-    struct pkt_tx_queue txq;
+    struct pkt_rx_queue rxq[LPORT_MAX_QUEUES];
+    struct pkt_tx_queue txq[LPORT_MAX_QUEUES];
 };
 
 static uint16_t
@@ -107,12 +108,18 @@ pmd_dev_info(struct cne_pktdev *dev, struct pktdev_info *dev_info)
     dev_info->min_mtu = ETH_MIN_MTU;
     dev_info->max_mtu = ETH_AF_XDP_FRAME_SIZE - ETH_AF_XDP_DATA_HEADROOM;
 
+    /* With multi-buffer enabled a packet can span up to XSKDEV_MAX_SEGS frames */
+    if (lport->xi[0] && lport->xi[0]->multi_buffer) {
+        dev_info->max_mtu *= XSKDEV_MAX_SEGS;
+        dev_info->max_rx_pktlen = dev_info->max_mtu;
+    }
+
     dev_info->default_rxportconf.ring_size = ETH_AF_XDP_DFLT_NUM_DESCS;
     dev_info->default_txportconf.ring_size = ETH_AF_XDP_DFLT_NUM_DESCS;
 
     dev_info->rx_fd = -1;
     dev_info->tx_fd = -1;
-    if (xskdev_get_fd(lport->xi, &dev_info->rx_fd, &dev_info->tx_fd) < 0)
+    if (xskdev_get_fd(lport->xi[0], &dev_info->rx_fd, &dev_info->tx_fd) < 0)
         return -1;
 
     return 0;
@@ -122,16 +129,54 @@ static int
 pmd_stats_get(struct cne_pktdev *dev, lport_stats_t *stats)
 {
     struct pmd_lport *lport = dev->data->dev_private;
+    lport_stats_t qstats;
+
+    if (lport->nb_queues == 1)
+        return xskdev_stats_get(lport->xi[0], stats);
+
+    memset(stats, 0, sizeof(lport_stats_t));
+    for (uint16_t q = 0; q < lport->nb_queues; q++) {
+        if (xskdev_stats_get(lport->xi[q], &qstats) < 0)
+            return -1;
+        lport_stats_add(stats, &qstats);
+    }
+
+    return 0;
+}
+
+static int
+pmd_queue_stats_get(struct cne_pktdev *dev, uint16_t qid, lport_stats_t *stats)
+{
+    struct pmd_lport *lport = dev->data->dev_private;
+
+    if (qid >= lport->nb_queues)
+        return -EINVAL;
 
-    return xskdev_stats_get(lport->xi, stats);
+    return xskdev_stats_get(lport->xi[qid], stats);
 }
 
 static int
 pmd_stats_reset(struct cne_pktdev *dev)
 {
     struct pmd_lport *lport = dev->data->dev_private;
+    int ret                 = 0;
 
-    return xskdev_stats_reset(lport->xi);
+    for (uint16_t q = 0; q < lport->nb_queues; q++)
+        if (xskdev_stats_reset(lport->xi[q]) < 0)
+            ret = -1;
+
+    return ret;
+}
+
+static void
+destroy_queues(struct pmd_lport *lport)
+{
+    /* Destroy in reverse order, so queue 0 which loaded the XDP program is last */
+    for (int q = lport->nb_queues - 1; q >= 0; q--) {
+        if (lport->xi[q])
+            xskdev_socket_destroy(lport->xi[q]);
+        lport->xi[q] = NULL;
+    }
 }
 
 static void
@@ -141,8 +186,7 @@ pmd_dev_close(struct cne_pktdev *dev)
 
     CNE_LOG(DEBUG, "Closing AF_XDP\n");
 
-    if (lport->xi)
-        xskdev_socket_destroy(lport->xi);
+    destroy_queues(lport);
 
     free(dev->data->dev_private);
 
@@ -157,15 +201,16 @@ pmd_pkt_alloc(struct cne_pktdev *dev, pktmbuf_t **pkts, uint16_t nb_pkts)
     if (!lport)
         return -1;
 
-    return pktmbuf_alloc_bulk(lport->xi->buf_mgmt.buf_arg, pkts, nb_pkts);
+    return pktmbuf_alloc_bulk(lport->xi[0]->buf_mgmt.buf_arg, pkts, nb_pkts);
 }
 
 static const struct pktdev_ops ops = {
-    .dev_close     = pmd_dev_close,
-    .dev_infos_get = pmd_dev_info,
-    .stats_get     = pmd_stats_get,
-    .stats_reset   = pmd_stats_reset,
-    .pkt_alloc     = pmd_pkt_alloc,
+    .dev_close       = pmd_dev_close,
+    .dev_infos_get   = pmd_dev_info,
+    .stats_get       = pmd_stats_get,
+    .queue_stats_get = pmd_queue_stats_get,
+    .stats_reset     = pmd_stats_reset,
+    .pkt_alloc       = pmd_pkt_alloc,
 };
 
 static int pmd_af_xdp_probe(lport_cfg_t *c);
@@ -180,11 +225,14 @@ static struct cne_pktdev *
 init_lport(lport_cfg_t *c)
 {
     struct pmd_lport *lport;
-    struct cne_pktdev *dev;
+    struct cne_pktdev *dev = NULL;
     int ret;
 
     CNE_LOG(DEBUG, "Init %s\n", c->ifname);
 
+    if (c->nb_queues > LPORT_MAX_QUEUES)
+        CNE_NULL_RET("Number of queues %u > %u\n", c->nb_queues, LPORT_MAX_QUEUES);
+
     lport = calloc(1, sizeof(struct pmd_lport));
     if (lport == NULL)
         CNE_NULL_RET("Failed to allocate internal memory\n");
@@ -193,8 +241,8 @@ init_lport(lport_cfg_t *c)
 
     lport->umem_begin = (uint64_t)c->umem_addr;
     lport->umem_size  = c->umem_size;
-    lport->rxq.qid    = c->qid;
-    lport->txq.qid    = c->qid;
+    lport->qid        = c->qid;
+    lport->nb_queues  = (c->nb_queues) ? c->nb_queues : 1;
 
     ret = netdev_get_mac_addr(c->ifname, &lport->eth_addr);
     if (ret)
@@ -216,18 +264,39 @@ init_lport(lport_cfg_t *c)
     dev->rx_pkt_burst      = pmd_af_xdp_rx;
     dev->tx_pkt_burst      = pmd_af_xdp_tx;
 
-    lport->xi = xskdev_socket_create(c);
-    if (!lport->xi)
-        CNE_ERR_GOTO(err_exit, "xskdev_socket_create() failed\n");
+    /* Each queue gets its own AF_XDP socket, all sharing the lport's buffer pool */
+    for (uint16_t q = 0; q < lport->nb_queues; q++) {
+        lport_cfg_t qcfg = *c;
+
+        qcfg.qid     = c->qid + q;
+        lport->xi[q] = xskdev_socket_create(&qcfg);
+        if (!lport->xi[q])
+            CNE_ERR_GOTO(err_exit, "xskdev_socket_create(%s:%u) failed\n", c->ifname, qcfg.qid);
+
+        lport->rxq[q].qid  = qcfg.qid;
+        lport->txq[q].qid  = qcfg.qid;
+        lport->rxq[q].info = lport->xi[q];
+        lport->txq[q].info = lport->xi[q];
+
+        dev->data->rx_queues[q] = &lport->rxq[q];
+        dev->data->tx_queues[q] = &lport->txq[q];
+    }
+
+    dev->data->rx_queue     = &lport->rxq[0];
+    dev->data->tx_queue     = &lport->txq[0];
+    dev->data->nb_rx_queues = lport->nb_queues;
+    dev->data->nb_tx_queues = lport->nb_queues;
 
-    dev->data->rx_queue = &lport->rxq;
-    dev->data->tx_queue = &lport->txq;
-    lport->rxq.info     = lport->xi;
-    lport->txq.info     = lport->xi;
+    /* The NIC checksum offload is only reachable through the AF_XDP TX metadata */
+    if (!lport->xi[0]->tx_metadata)
+        lport->off.tx_checksum_offload = 0;
 
     return dev;
 
 err_exit:
+    destroy_queues(lport);
+    if (dev)
+        pktdev_release_port(dev);
     free(lport);
     return NULL;
 }
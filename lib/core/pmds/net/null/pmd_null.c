@@ -5,6 +5,8 @@
 #include <stdatomic.h>
 #include <stdint.h>
 #include <stdlib.h>
+#include <string.h>
+#include <cne_log.h>
 #include <cne_common.h>
 #include <cne_lport.h>
 #include <pktdev.h>
@@ -60,20 +62,38 @@ pmd_null_tx_burst(void *priv_, pktmbuf_t **bufs, uint16_t n_bufs)
 }
 
 static int
-pmd_null_stats_get(struct cne_pktdev *dev, lport_stats_t *stats)
+pmd_null_queue_stats_get(struct cne_pktdev *dev, uint16_t qid, lport_stats_t *stats)
 {
     struct pmd_null_private *priv;
 
-    if (!dev || !stats)
+    if (!dev || !stats || qid >= dev->data->nb_rx_queues)
         return -1;
 
-    priv            = dev->data->dev_private;
+    priv            = dev->data->rx_queues[qid];
     stats->ipackets = atomic_load_explicit(&priv->rx_pkts, memory_order_relaxed);
     stats->opackets = atomic_load_explicit(&priv->tx_pkts, memory_order_relaxed);
 
     return 0;
 }
 
+static int
+pmd_null_stats_get(struct cne_pktdev *dev, lport_stats_t *stats)
+{
+    lport_stats_t qstats = {0};
+
+    if (!dev || !stats)
+        return -1;
+
+    memset(stats, 0, sizeof(lport_stats_t));
+    for (uint16_t q = 0; q < dev->data->nb_rx_queues; q++) {
+        if (pmd_null_queue_stats_get(dev, q, &qstats) < 0)
+            return -1;
+        lport_stats_add(stats, &qstats);
+    }
+
+    return 0;
+}
+
 static int
 pmd_null_stats_reset(struct cne_pktdev *dev)
 {
@@ -82,9 +102,11 @@ pmd_null_stats_reset(struct cne_pktdev *dev)
     if (!dev)
         return -1;
 
-    priv = dev->data->dev_private;
-    atomic_store_explicit(&priv->rx_pkts, 0, memory_order_relaxed);
-    atomic_store_explicit(&priv->tx_pkts, 0, memory_order_relaxed);
+    for (uint16_t q = 0; q < dev->data->nb_rx_queues; q++) {
+        priv = dev->data->rx_queues[q];
+        atomic_store_explicit(&priv->rx_pkts, 0, memory_order_relaxed);
+        atomic_store_explicit(&priv->tx_pkts, 0, memory_order_relaxed);
+    }
 
     return 0;
 }
@@ -112,10 +134,11 @@ pmd_null_close(struct cne_pktdev *dev)
 }
 
 static const struct pktdev_ops pmd_null_ops = {
-    .dev_close     = pmd_null_close,
-    .dev_infos_get = pmd_null_infos_get,
-    .stats_get     = pmd_null_stats_get,
-    .stats_reset   = pmd_null_stats_reset,
+    .dev_close       = pmd_null_close,
+    .dev_infos_get   = pmd_null_infos_get,
+    .stats_get       = pmd_null_stats_get,
+    .queue_stats_get = pmd_null_queue_stats_get,
+    .stats_reset     = pmd_null_stats_reset,
 };
 
 static int pmd_null_probe(lport_cfg_t *cfg);
@@ -131,32 +154,45 @@ pmd_null_probe(lport_cfg_t *cfg)
 {
     struct pmd_null_private *priv;
     struct cne_pktdev *dev;
+    uint16_t nb_queues;
 
     if (!cfg)
         return -1;
 
+    nb_queues = (cfg->nb_queues) ? cfg->nb_queues : 1;
+    if (nb_queues > LPORT_MAX_QUEUES)
+        CNE_ERR_RET("Number of queues %u > %u\n", nb_queues, LPORT_MAX_QUEUES);
+
     dev = pktdev_allocate(cfg->name, NULL);
     if (!dev)
         return -1;
     dev->drv = &null_drv;
 
-    priv = calloc(1, sizeof(*priv));
+    /* One private structure per queue, the first one is also the dev_private */
+    priv = calloc(nb_queues, sizeof(*priv));
     if (!priv)
         return -1;
 
-    /* copy lport_id to private data as its used in fast path */
-    priv->lport_id = dev->data->lport_id;
+    for (uint16_t q = 0; q < nb_queues; q++) {
+        /* copy lport_id to private data as its used in fast path */
+        priv[q].lport_id = dev->data->lport_id;
 
-    /* cfg->pi can be NULL, but no buffers will be allocated on rx */
-    priv->pi = cfg->pi;
+        /* cfg->pi can be NULL, but no buffers will be allocated on rx */
+        priv[q].pi = cfg->pi;
+
+        /* rx_burst and tx_burst get the private data as their "queue" */
+        dev->data->rx_queues[q] = &priv[q];
+        dev->data->tx_queues[q] = &priv[q];
+    }
 
-    /* rx_burst and tx_burst get the private data as their "queue" */
-    dev->data->dev_private = priv;
-    dev->data->rx_queue    = priv;
-    dev->data->tx_queue    = priv;
-    dev->dev_ops           = &pmd_null_ops;
-    dev->rx_pkt_burst      = pmd_null_rx_burst;
-    dev->tx_pkt_burst      = pmd_null_tx_burst;
+    dev->data->dev_private  = priv;
+    dev->data->rx_queue     = priv;
+    dev->data->tx_queue     = priv;
+    dev->data->nb_rx_queues = nb_queues;
+    dev->data->nb_tx_queues = nb_queues;
+    dev->dev_ops            = &pmd_null_ops;
+    dev->rx_pkt_burst       = pmd_null_rx_burst;
+    dev->tx_pkt_burst       = pmd_null_tx_burst;
 
     return dev->data->lport_id;
 }
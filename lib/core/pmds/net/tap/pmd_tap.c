@@ -18,39 +18,60 @@
 #include <pktmbuf.h>                // for pktmbuf_info_t, pktmbuf_t, pktmbuf...
 #include "netdev_funcs.h"           // for netdev_get_mac_addr
 #include <net/ethernet.h>           // for ether_addr
-#include <sys/uio.h>
-#include <linux/if_tun.h>        // for if_nametoindex, IF_NAMESIZE
+#include <sys/uio.h>                // for readv, writev, iovec
+#include <linux/if_tun.h>           // for tun_pi, IFF_TAP, IFF_TUN, IFF_VNET_HDR
+#include <linux/virtio_net.h>       // for virtio_net_hdr, VIRTIO_NET_HDR_F_NEEDS_CSUM
+#include <stddef.h>                 // for offsetof
+#include <errno.h>                  // for errno, EAGAIN, EINVAL
+#include <kvargs.h>                 // for kvargs_parse, kvargs_uint32, kvargs_free
+#include <net/cne_tcp.h>            // for cne_tcp_hdr
+#include <net/cne_udp.h>            // for cne_udp_hdr
 #include <tun_alloc.h>
 
 #include "pmd_tap.h"
 
 #define TAP_RX_MBUF_COUNT 128
+#define TAP_TX_MAX_SEGS   16 /**< Max segments of a chained mbuf sent with one writev() */
+
+/* pmd_opts keys, i.e. "pmd": "net_tap:vnet_hdr=0" */
+#define TAP_VNET_HDR_ARG "vnet_hdr"
+
+static const char *const valid_args[] = {TAP_VNET_HDR_ARG, NULL};
 
 struct tap_rx_q {
     int fd;                                /**< File descriptor for tun/tap interface */
     uint16_t lport_id;                     /**< lport ID for this tun/tap interface */
     uint16_t idx;                          /**< Current index into the rx_bufs array */
     uint16_t cnt;                          /**< Current number of mbufs in the array */
+    uint16_t vnet_hdr_sz;                  /**< Size of the virtio_net_hdr, 0 if not used */
     pktmbuf_t *rx_bufs[TAP_RX_MBUF_COUNT]; /**< Cache of mbuf pointers */
     struct pmd_lport *lport;               /**< Pointer to internal lport structure */
     uint64_t n_pkts;                       /**< Number of packets received */
     uint64_t n_bytes;                      /**< Number of bytes received */
+    uint64_t n_errors;                     /**< Number of packets truncated or failed to read */
+    uint64_t n_empty;                      /**< Number of times the queue was found empty */
 };
 
 struct tap_tx_q {
-    int fd;           /**< File descriptor for tun/tap interface */
-    uint64_t n_pkts;  /**< Number of packets transmitted */
-    uint64_t n_bytes; /**< Number of bytes transmitted */
+    int fd;               /**< File descriptor for tun/tap interface */
+    uint16_t vnet_hdr_sz; /**< Size of the virtio_net_hdr, 0 if not used */
+    int tap_type;         /**< IFF_TAP or IFF_TUN */
+    uint64_t n_pkts;      /**< Number of packets transmitted */
+    uint64_t n_bytes;     /**< Number of bytes transmitted */
+    uint64_t n_errors;    /**< Number of packets failed to transmit */
 };
 
 struct pmd_lport {
     uint16_t lport_id;             /**< lport ID for this tun/tap interface */
+    uint16_t nb_queues;            /**< Number of RX/TX queue pairs */
+    uint32_t vnet_hdr;             /**< Use IFF_VNET_HDR for checksum offloads */
     char if_name[IF_NAMESIZE + 1]; /**< tun/tap interface name */
     pktmbuf_info_t *pi;            /**< tun/tap mbuf info structure */
     struct tap_info *ti;           /**< Pointer for tun/tap setup */
     struct ether_addr eth_addr;    /**< MAC address of the interface */
-    struct tap_rx_q *rxq;          /**< Receive queue pointer */
-    struct tap_tx_q *txq;          /*<< Transmit queue pointer */
+    struct offloads off;           /**< Checksum offloads of the interface */
+    struct tap_rx_q *rxq;          /**< Receive queue array, one per queue */
+    struct tap_tx_q *txq;          /*<< Transmit queue array, one per queue */
 };
 
 static inline pktmbuf_t *
@@ -80,22 +101,74 @@ pmd_free_rx_mbuf(struct tap_rx_q *rxq)
     rxq->idx--;
 }
 
+/* Convert the virtio_net_hdr of a received packet into mbuf offload flags */
+static inline void
+pmd_rx_vnet_hdr(pktmbuf_t *m, const struct virtio_net_hdr *vh)
+{
+    if (vh->flags & VIRTIO_NET_HDR_F_NEEDS_CSUM)
+        m->ol_flags |= CNE_MBUF_F_RX_L4_CKSUM_NONE; /* Data is valid, checksum is partial */
+    else if (vh->flags & VIRTIO_NET_HDR_F_DATA_VALID)
+        m->ol_flags |= CNE_MBUF_F_RX_L4_CKSUM_GOOD;
+}
+
+/* Build the virtio_net_hdr for a packet to send from the mbuf offload flags */
+static inline void
+pmd_tx_vnet_hdr(const pktmbuf_t *m, struct virtio_net_hdr *vh)
+{
+    uint64_t ol_flags = m->ol_flags;
+
+    memset(vh, 0, sizeof(*vh));
+
+    switch (ol_flags & CNE_MBUF_F_TX_L4_MASK) {
+    case CNE_MBUF_F_TX_TCP_CKSUM:
+        vh->csum_offset = offsetof(struct cne_tcp_hdr, cksum);
+        break;
+    case CNE_MBUF_F_TX_UDP_CKSUM:
+        vh->csum_offset = offsetof(struct cne_udp_hdr, dgram_cksum);
+        break;
+    default:
+        if (!(ol_flags & CNE_MBUF_F_TX_TCP_SEG))
+            return;
+        vh->csum_offset = offsetof(struct cne_tcp_hdr, cksum);
+        break;
+    }
+
+    /* The L4 checksum field already holds the pseudo header checksum */
+    vh->flags      = VIRTIO_NET_HDR_F_NEEDS_CSUM;
+    vh->csum_start = m->l2_len + m->l3_len;
+
+    if (ol_flags & CNE_MBUF_F_TX_TCP_SEG) {
+        vh->gso_type = (ol_flags & CNE_MBUF_F_TX_IPV6) ? VIRTIO_NET_HDR_GSO_TCPV6
+                                                       : VIRTIO_NET_HDR_GSO_TCPV4;
+        vh->gso_size = m->tso_segsz;
+        vh->hdr_len  = m->l2_len + m->l3_len + m->l4_len;
+    }
+}
+
 static uint16_t
 pmd_tuntap_rx(void *queue, pktmbuf_t **bufs, uint16_t nb_pkts)
 {
     struct tap_rx_q *rxq = queue;
     int n_rx_pkts        = 0;
     int n_rx_bytes       = 0;
+    struct virtio_net_hdr vh;
     struct tun_pi pi;
-    uint16_t len;
+    size_t hdr_len;
+    ssize_t len;
 
     if (!rxq || !bufs || nb_pkts == 0)
         return 0;
 
-    /* Read packets from the TAP socket & store in allocated mbuf */
+    hdr_len = sizeof(struct tun_pi) + rxq->vnet_hdr_sz;
+
+    /*
+     * A tun/tap fd has no batched receive call, read packets until the burst is
+     * full or the fd is empty. An empty fd ends the burst, so an idle queue only
+     * costs one read() and the caller can wait on the fd using the idlemgr.
+     */
     for (int i = 0; i < nb_pkts; i++) {
         pktmbuf_t *m = pmd_alloc_rx_mbuf(rxq);
-        struct iovec iov[2];
+        struct iovec iov[3];
         int k;
 
         if (!m)
@@ -105,25 +178,36 @@ pmd_tuntap_rx(void *queue, pktmbuf_t **bufs, uint16_t nb_pkts)
 
         iov[k].iov_base  = &pi;
         iov[k++].iov_len = sizeof(struct tun_pi);
+        if (rxq->vnet_hdr_sz) {
+            iov[k].iov_base  = &vh;
+            iov[k++].iov_len = rxq->vnet_hdr_sz;
+        }
         iov[k].iov_base  = pktmbuf_mtod(m, void *);
         iov[k++].iov_len = pktmbuf_tailroom(m);
 
         len = readv(rxq->fd, iov, k);
-        if (len < sizeof(struct tun_pi) || len == 0xFFFF) {
+        if (len < (ssize_t)hdr_len) {
             pmd_free_rx_mbuf(rxq);
+            if (len < 0 && errno == EAGAIN)
+                rxq->n_empty++;
+            else
+                rxq->n_errors++;
             break;
         }
 
         if (pi.flags & TUN_PKT_STRIP) {
             pmd_free_rx_mbuf(rxq);
+            rxq->n_errors++;
             continue;
         }
-        len -= sizeof(struct tun_pi);
+        len -= hdr_len;
 
         *bufs++ = m;
 
         pktmbuf_port(m)     = rxq->lport_id;
         pktmbuf_data_len(m) = len;
+        if (rxq->vnet_hdr_sz)
+            pmd_rx_vnet_hdr(m, &vh);
 
         n_rx_pkts++;
         n_rx_bytes += len;
@@ -136,7 +220,7 @@ pmd_tuntap_rx(void *queue, pktmbuf_t **bufs, uint16_t nb_pkts)
 }
 
 static uint16_t
-pmd_tuntap_tx(void *queue, pktmbuf_t **bufs, uint16_t nb_pkts, int tap_type)
+pmd_tuntap_tx(void *queue, pktmbuf_t **bufs, uint16_t nb_pkts)
 {
     struct tap_tx_q *txq = queue;
     uint64_t tx_pkts = 0, tx_bytes = 0;
@@ -146,16 +230,22 @@ pmd_tuntap_tx(void *queue, pktmbuf_t **bufs, uint16_t nb_pkts, int tap_type)
 
     if (nb_pkts) {
         struct tun_pi pi = {.flags = 0, .proto = 0};
-        struct iovec iov[2];
+        struct iovec iov[TAP_TX_MAX_SEGS + 2];
+        struct virtio_net_hdr vh;
         int k;
 
         for (int i = 0; i < nb_pkts; i++) {
             pktmbuf_t *m = bufs[i];
             ssize_t len;
 
+            if (unlikely(m->nb_segs > TAP_TX_MAX_SEGS)) {
+                txq->n_errors++;
+                continue;
+            }
+
             pi.flags = 0;
             pi.proto = 0;
-            if (tap_type == IFF_TUN) {
+            if (txq->tap_type == IFF_TUN) {
                 char proto = (*pktmbuf_mtod(m, char *) & 0xF0);
 
                 if (proto == 0x40)
@@ -168,14 +258,25 @@ pmd_tuntap_tx(void *queue, pktmbuf_t **bufs, uint16_t nb_pkts, int tap_type)
 
             iov[k].iov_base  = (void *)&pi;
             iov[k++].iov_len = sizeof(struct tun_pi);
-            iov[k].iov_base  = pktmbuf_mtod(m, void *);
-            iov[k++].iov_len = pktmbuf_data_len(m);
+            if (txq->vnet_hdr_sz) {
+                pmd_tx_vnet_hdr(m, &vh);
+                iov[k].iov_base  = (void *)&vh;
+                iov[k++].iov_len = txq->vnet_hdr_sz;
+            }
 
-            if ((len = writev(txq->fd, iov, k)) < 0)
-                break;
+            /* Chained mbufs are sent as a single packet using one iovec per segment */
+            for (pktmbuf_t *seg = m; seg; seg = seg->next) {
+                iov[k].iov_base  = pktmbuf_mtod(seg, void *);
+                iov[k++].iov_len = pktmbuf_data_len(seg);
+            }
+
+            if ((len = writev(txq->fd, iov, k)) < 0) {
+                txq->n_errors++;
+                continue;
+            }
 
             tx_pkts++;
-            tx_bytes += len;
+            tx_bytes += len - sizeof(struct tun_pi) - txq->vnet_hdr_sz;
         }
         txq->n_pkts += tx_pkts;
         txq->n_bytes += tx_bytes;
@@ -183,19 +284,7 @@ pmd_tuntap_tx(void *queue, pktmbuf_t **bufs, uint16_t nb_pkts, int tap_type)
         pktmbuf_free_bulk(bufs, nb_pkts);
     }
 
-    return tx_pkts;
-}
-
-static uint16_t
-pmd_tap_tx(void *queue, pktmbuf_t **bufs, uint16_t nb_pkts)
-{
-    return pmd_tuntap_tx(queue, bufs, nb_pkts, IFF_TAP);
-}
-
-static uint16_t
-pmd_tun_tx(void *queue, pktmbuf_t **bufs, uint16_t nb_pkts)
-{
-    return pmd_tuntap_tx(queue, bufs, nb_pkts, IFF_TUN);
+    return nb_pkts;
 }
 
 static int
@@ -236,7 +325,7 @@ pmd_tun_dev_info(struct cne_pktdev *dev, struct pktdev_info *dev_info)
 }
 
 static int
-pmd_stats_get(struct cne_pktdev *dev, lport_stats_t *stats)
+pmd_queue_stats_get(struct cne_pktdev *dev, uint16_t qid, lport_stats_t *stats)
 {
     struct pmd_lport *lport;
     struct tap_rx_q *rxq;
@@ -246,16 +335,59 @@ pmd_stats_get(struct cne_pktdev *dev, lport_stats_t *stats)
         CNE_ERR_RET("device or data or stats pointer is NULL\n");
 
     lport = dev->data->dev_private;
-    rxq   = lport->rxq;
-    txq   = lport->txq;
+    if (qid >= lport->nb_queues)
+        return -EINVAL;
+    rxq = &lport->rxq[qid];
+    txq = &lport->txq[qid];
 
     /* RX stats */
-    stats->ipackets = rxq->n_pkts;
-    stats->ibytes   = rxq->n_bytes;
+    stats->ipackets      = rxq->n_pkts;
+    stats->ibytes        = rxq->n_bytes;
+    stats->ierrors       = rxq->n_errors;
+    stats->rx_ring_empty = rxq->n_empty;
 
     /* TX stats */
     stats->opackets = txq->n_pkts;
     stats->obytes   = txq->n_bytes;
+    stats->oerrors  = txq->n_errors;
+
+    return 0;
+}
+
+static int
+pmd_stats_get(struct cne_pktdev *dev, lport_stats_t *stats)
+{
+    struct pmd_lport *lport;
+    lport_stats_t qstats;
+
+    if (!dev || !dev->data || !dev->data->dev_private || !stats)
+        CNE_ERR_RET("device or data or stats pointer is NULL\n");
+
+    lport = dev->data->dev_private;
+
+    memset(stats, 0, sizeof(lport_stats_t));
+    for (uint16_t q = 0; q < lport->nb_queues; q++) {
+        memset(&qstats, 0, sizeof(qstats));
+        if (pmd_queue_stats_get(dev, q, &qstats) < 0)
+            return -1;
+        lport_stats_add(stats, &qstats);
+    }
+
+    return 0;
+}
+
+static int
+pmd_queue_fd_get(struct cne_pktdev *dev, uint16_t qid, int *rx_fd, int *tx_fd)
+{
+    struct pmd_lport *lport = dev->data->dev_private;
+
+    if (!lport || qid >= lport->nb_queues)
+        return -EINVAL;
+
+    if (rx_fd)
+        *rx_fd = lport->rxq[qid].fd;
+    if (tx_fd)
+        *tx_fd = lport->txq[qid].fd;
 
     return 0;
 }
@@ -276,6 +408,7 @@ pmd_dev_close(struct cne_pktdev *dev)
             free(lport);
         }
         dev->data->mac_addr = NULL;
+        dev->data->offloads = NULL;
     }
 }
 
@@ -291,17 +424,21 @@ pmd_pkt_alloc(struct cne_pktdev *dev, pktmbuf_t **bufs, uint16_t nb_pkts)
 }
 
 static const struct pktdev_ops tap_ops = {
-    .dev_close     = pmd_dev_close,
-    .dev_infos_get = pmd_tap_dev_info,
-    .stats_get     = pmd_stats_get,
-    .pkt_alloc     = pmd_pkt_alloc,
+    .dev_close       = pmd_dev_close,
+    .dev_infos_get   = pmd_tap_dev_info,
+    .stats_get       = pmd_stats_get,
+    .queue_stats_get = pmd_queue_stats_get,
+    .queue_fd_get    = pmd_queue_fd_get,
+    .pkt_alloc       = pmd_pkt_alloc,
 };
 
 static const struct pktdev_ops tun_ops = {
-    .dev_close     = pmd_dev_close,
-    .dev_infos_get = pmd_tun_dev_info,
-    .stats_get     = pmd_stats_get,
-    .pkt_alloc     = pmd_pkt_alloc,
+    .dev_close       = pmd_dev_close,
+    .dev_infos_get   = pmd_tun_dev_info,
+    .stats_get       = pmd_stats_get,
+    .queue_stats_get = pmd_queue_stats_get,
+    .queue_fd_get    = pmd_queue_fd_get,
+    .pkt_alloc       = pmd_pkt_alloc,
 };
 
 static int pmd_tap_probe(lport_cfg_t *c);
@@ -317,14 +454,36 @@ static struct pktdev_driver tun_drv = {
     .probe = pmd_tun_probe,
 };
 
+static int
+tap_parse_args(struct pmd_lport *lport, const char *pmd_opts)
+{
+    struct kvargs *kvlist;
+    int ret = 0;
+
+    lport->vnet_hdr = 1;
+
+    if (!pmd_opts || pmd_opts[0] == '\0')
+        return 0;
+
+    kvlist = kvargs_parse(pmd_opts, valid_args);
+    if (!kvlist)
+        CNE_ERR_RET("Invalid tun/tap options '%s'\n", pmd_opts);
+
+    if (kvargs_uint32(kvlist, TAP_VNET_HDR_ARG, &lport->vnet_hdr) < 0)
+        ret = -1;
+
+    kvargs_free(kvlist);
+
+    return ret;
+}
+
 static int
 _tap_probe(int tap_type, lport_cfg_t *c)
 {
     struct pmd_lport *lport = NULL;
     struct cne_pktdev *dev  = NULL;
-    struct tap_rx_q *rxq    = NULL;
-    struct tap_tx_q *txq    = NULL;
-    int ret                 = 0;
+    int tun_flags           = tap_type;
+    int ret                 = -1;
 
     if (!c || c->pi == NULL)
         return -1;
@@ -337,6 +496,13 @@ _tap_probe(int tap_type, lport_cfg_t *c)
 
     strlcpy(lport->if_name, c->name, sizeof(lport->if_name));
 
+    lport->nb_queues = (c->nb_queues) ? c->nb_queues : 1;
+    if (lport->nb_queues > CNE_MIN(LPORT_MAX_QUEUES, CNE_TAP_MAX_QUEUES))
+        CNE_ERR_GOTO(err_exit, "Number of queues %u is too large\n", lport->nb_queues);
+
+    if (tap_parse_args(lport, c->pmd_opts) < 0)
+        CNE_ERR_GOTO(err_exit, "Failed to parse options '%s'\n", c->pmd_opts);
+
     dev = pktdev_allocate(c->name, c->name);
     if (!dev)
         CNE_ERR_GOTO(err_exit, "pktdev_allocate(%s, %s) failed\n", c->name, c->name);
@@ -345,36 +511,50 @@ _tap_probe(int tap_type, lport_cfg_t *c)
     lport->lport_id = dev->data->lport_id;
     lport->pi       = c->pi;
 
-    lport->ti = tun_alloc(tap_type, lport->if_name);
+    if (lport->nb_queues > 1)
+        tun_flags |= IFF_MULTI_QUEUE;
+    if (lport->vnet_hdr)
+        tun_flags |= IFF_VNET_HDR;
+
+    lport->ti = tun_alloc_mq(tun_flags, lport->if_name, lport->nb_queues);
     if (lport->ti == NULL)
         CNE_ERR_GOTO(err_exit, "Failed to create %s\n", lport->if_name);
 
-    lport->rxq = calloc(1, sizeof(struct tap_rx_q));
-    lport->txq = calloc(1, sizeof(struct tap_tx_q));
+    lport->rxq = calloc(lport->nb_queues, sizeof(struct tap_rx_q));
+    lport->txq = calloc(lport->nb_queues, sizeof(struct tap_tx_q));
     if (!lport->rxq || !lport->txq)
         CNE_ERR_GOTO(err_exit, "Failed to allocate rx_tx queue\n");
 
-    rxq           = lport->rxq;
-    rxq->lport    = lport;
-    rxq->lport_id = lport->lport_id;
-    rxq->fd       = tun_get_fd(lport->ti);
-    txq           = lport->txq;
-    txq->fd       = tun_get_fd(lport->ti);
-
-    dev->data->dev_private = lport;
-    dev->data->mac_addr    = &lport->eth_addr;
-    dev->data->rx_queue    = lport->rxq;
-    dev->data->tx_queue    = lport->txq;
-    if (tap_type == IFF_TAP) {
-        dev->dev_ops      = &tap_ops;
-        dev->rx_pkt_burst = pmd_tuntap_rx;
-        dev->tx_pkt_burst = pmd_tap_tx;
-    } else {
-        dev->dev_ops      = &tun_ops;
-        dev->rx_pkt_burst = pmd_tuntap_rx;
-        dev->tx_pkt_burst = pmd_tun_tx;
+    for (uint16_t q = 0; q < lport->nb_queues; q++) {
+        struct tap_rx_q *rxq = &lport->rxq[q];
+        struct tap_tx_q *txq = &lport->txq[q];
+
+        rxq->lport       = lport;
+        rxq->lport_id    = lport->lport_id;
+        rxq->fd          = tun_get_queue_fd(lport->ti, q);
+        rxq->vnet_hdr_sz = lport->ti->vnet_hdr_sz;
+        txq->fd          = rxq->fd;
+        txq->vnet_hdr_sz = lport->ti->vnet_hdr_sz;
+        txq->tap_type    = tap_type;
+
+        dev->data->rx_queues[q] = rxq;
+        dev->data->tx_queues[q] = txq;
     }
 
+    /* The kernel does the checksum for packets sent with a partial checksum */
+    lport->off.tx_checksum_offload = (lport->ti->vnet_hdr_sz != 0);
+
+    dev->data->dev_private  = lport;
+    dev->data->mac_addr     = &lport->eth_addr;
+    dev->data->offloads     = &lport->off;
+    dev->data->rx_queue     = lport->rxq;
+    dev->data->tx_queue     = lport->txq;
+    dev->data->nb_rx_queues = lport->nb_queues;
+    dev->data->nb_tx_queues = lport->nb_queues;
+    dev->dev_ops            = (tap_type == IFF_TAP) ? &tap_ops : &tun_ops;
+    dev->rx_pkt_burst       = pmd_tuntap_rx;
+    dev->tx_pkt_burst       = pmd_tuntap_tx;
+
     return pktdev_portid(dev);
 
 err_exit:
@@ -7,6 +7,7 @@
 #include <fcntl.h>
 #include <net/if.h>
 #include <linux/if_tun.h>
+#include <linux/virtio_net.h>
 #include <sys/ioctl.h>
 #include <bsd/string.h>
 
@@ -90,17 +91,74 @@ tap_link_set_up(struct tap_info *ti)
     return tap_ioctl(ti, SIOCSIFFLAGS, &ifr, 1);
 }
 
+static int
+tun_queue_open(struct tap_info *ti, struct ifreq *ifr)
+{
+    int fd, flags;
+
+    fd = open(TUN_TAP_DEV_PATH, O_RDWR);
+    if (fd < 0)
+        CNE_ERR_RET("[cyan]Failed to open [orange]%s [cyan]interface[]\n", TUN_TAP_DEV_PATH);
+
+    /* Set the TUN/TAP configuration and set the name if needed */
+    if (ioctl(fd, TUNSETIFF, (void *)ifr) < 0)
+        CNE_ERR_GOTO(error, "[cyan]Failed to set TUNSETIFF for [orange]%s[]: [orange]%s[]\n",
+                     ifr->ifr_name, strerror(errno));
+
+    flags = fcntl(fd, F_GETFL);
+    if (flags == -1)
+        CNE_ERR_GOTO(error, "[cyan]Failed to get [orange]%s [cyan]current flags[]\n",
+                     ifr->ifr_name);
+
+    /* Always set the file descriptor to non-blocking */
+    flags |= O_NONBLOCK;
+    if (fcntl(fd, F_SETFL, flags) < 0)
+        CNE_ERR_GOTO(error, "[cyan]Failed to set [orange]%s [cyan]to nonblocking[]: [orange]%s[]\n",
+                     ifr->ifr_name, strerror(errno));
+
+    ti->fds[ti->nb_queues++] = fd;
+
+    return fd;
+error:
+    close(fd);
+    return -1;
+}
+
+static int
+tun_vnet_hdr_setup(struct tap_info *ti)
+{
+    int sz = sizeof(struct virtio_net_hdr);
+
+    if (ioctl(ti->fd, TUNSETVNETHDRSZ, &sz) < 0)
+        CNE_ERR_RET("[cyan]Failed to set vnet header size for [orange]%s[]: [orange]%s[]\n",
+                    ti->name, strerror(errno));
+
+    /*
+     * No receive offloads, the kernel finishes checksums and segments packets
+     * before handing them over, as the packets may be forwarded to another port.
+     */
+    if (ioctl(ti->fd, TUNSETOFFLOAD, 0) < 0)
+        CNE_ERR_RET("[cyan]Failed to set offloads for [orange]%s[]: [orange]%s[]\n", ti->name,
+                    strerror(errno));
+
+    ti->vnet_hdr_sz = sz;
+
+    return 0;
+}
+
 struct tap_info *
-tun_alloc(int tun_flags, const char *if_name)
+tun_alloc_mq(int tun_flags, const char *if_name, uint16_t nb_queues)
 {
     struct tap_info *ti     = NULL;
     struct ifreq ifr        = {0};
     char name[IFNAMSIZ + 1] = {0};
-    int flags;
 
     if (!if_name)
         if_name = name;
 
+    if (nb_queues == 0 || nb_queues > CNE_TAP_MAX_QUEUES)
+        CNE_NULL_RET("[cyan]Invalid number of queues [orange]%u[]\n", nb_queues);
+
     ti = calloc(1, sizeof(struct tap_info));
     if (!ti)
         return NULL;
@@ -110,50 +168,49 @@ tun_alloc(int tun_flags, const char *if_name)
     ti->fd       = -1;
     ti->sock     = -1;
 
+    /* Grab the TUN features to verify we can work multi-queue */
     ti->fd = open(TUN_TAP_DEV_PATH, O_RDWR);
     if (ti->fd < 0)
         CNE_ERR_GOTO(error, "[cyan]Failed to open [orange]%s [cyan]interface[]\n",
                      TUN_TAP_DEV_PATH);
+    if (ioctl(ti->fd, TUNGETFEATURES, &ti->features) < 0)
+        CNE_ERR_GOTO(error, "[cyan]Failed to get TUN/TAP features[]\n");
+    close(ti->fd);
+    ti->fd = -1;
 
-    ifr.ifr_flags = ti->flags;
-
-#ifdef IFF_MULTI_QUEUE
-    if (ti->flags & IFF_MULTI_QUEUE) {
-        /* Grab the TUN features to verify we can work multi-queue */
-        if (ioctl(ti->fd, TUNGETFEATURES, &ti->features) < 0)
-            CNE_ERR_GOTO(error, "[cyan]Failed to get TUN/TAP features[]\n");
+    ifr.ifr_flags = ti->flags & ~IFF_MULTI_QUEUE;
 
+    if ((ti->flags & IFF_MULTI_QUEUE) || nb_queues > 1) {
         if (ti->features & IFF_MULTI_QUEUE)
             ifr.ifr_flags |= IFF_MULTI_QUEUE;
+        else if (nb_queues > 1)
+            CNE_ERR_GOTO(error, "[cyan]TUN/TAP multi-queue is not supported[]\n");
         else
             ifr.ifr_flags |= IFF_ONE_QUEUE;
     } else
         ifr.ifr_flags |= IFF_ONE_QUEUE;
-#else
-    ifr.ifr_flags |= IFF_ONE_QUEUE;
-#endif
 
-    strlcpy(ifr.ifr_name, if_name, sizeof(ifr.ifr_name));
+    if ((ti->flags & IFF_VNET_HDR) && !(ti->features & IFF_VNET_HDR))
+        CNE_ERR_GOTO(error, "[cyan]TUN/TAP vnet header is not supported[]\n");
 
-    /* Set the TUN/TAP configuration and set the name if needed */
-    if (ioctl(ti->fd, TUNSETIFF, (void *)&ifr) < 0)
-        CNE_ERR_GOTO(error, "[cyan]Failed to set TUNSETIFF for [orange]%s[]: [orange]%s[]\n",
-                     ifr.ifr_name, strerror(errno));
-    /*
-     * Name passed to kernel might be wildcard like tun%d
-     * and need to find the resulting device name.
-     */
-    strlcpy(ti->name, ifr.ifr_name, sizeof(ifr.ifr_name));
+    strlcpy(ifr.ifr_name, if_name, sizeof(ifr.ifr_name));
 
-    flags = fcntl(ti->fd, F_GETFL);
-    if (flags == -1)
-        CNE_ERR_GOTO(error, "[cyan]Failed to get [orange]%s [cyan]current flags[]\n", ifr.ifr_name);
+    /* The first TUNSETIFF creates the interface, the others attach a queue to it */
+    for (uint16_t q = 0; q < nb_queues; q++) {
+        if (tun_queue_open(ti, &ifr) < 0)
+            goto error;
+        if (q == 0) {
+            /*
+             * Name passed to kernel might be wildcard like tun%d
+             * and need to find the resulting device name.
+             */
+            strlcpy(ti->name, ifr.ifr_name, sizeof(ifr.ifr_name));
+            ti->fd = ti->fds[0];
+        }
+    }
 
-    /* Always set the file descriptor to non-blocking */
-    flags |= O_NONBLOCK;
-    if (fcntl(ti->fd, F_SETFL, flags) < 0)
-        CNE_ERR_GOTO(error, "[cyan]Failed to set [orange]%s [cyan]to nonblocking[]: [orange]%s[]\n",
-                     ifr.ifr_name, strerror(errno));
+    if ((ti->flags & IFF_VNET_HDR) && tun_vnet_hdr_setup(ti) < 0)
+        goto error;
 
     if (ti->flags & IFF_TAP) {
         if (ioctl(ti->fd, SIOCGIFHWADDR, &ifr) < 0)
@@ -185,6 +242,12 @@ error:
     return NULL;
 }
 
+struct tap_info *
+tun_alloc(int tun_flags, const char *if_name)
+{
+    return tun_alloc_mq(tun_flags, if_name, 1);
+}
+
 int
 tun_free(struct tap_info *ti)
 {
@@ -192,7 +255,9 @@ tun_free(struct tap_info *ti)
         if (tap_link_set_down(ti) < 0)
             CNE_ERR_RET("[cyan]Failed to set [orange]%s [cyan]interface down[]\n", ti->name);
 
-        if (ti->fd >= 0)
+        for (uint16_t q = 0; q < ti->nb_queues; q++)
+            close(ti->fds[q]);
+        if (ti->nb_queues == 0 && ti->fd >= 0)
             close(ti->fd);
         if (ti->sock != -1)
             close(ti->sock);
@@ -221,11 +286,12 @@ tun_dump(const char *msg, struct tap_info *ti)
         cne_printf("[cyan]Type[]:[yellow]%-4s[] - '[orange]%-12s[]' [cyan]fd [orange]%d[]",
                    (ti->flags & IFF_TAP) ? "TAP" : "TUN", ti->name, ti->fd);
 
-#ifdef IFF_MULTI_QUEUE
-    if (ti->features & IFF_MULTI_QUEUE)
-        cne_printf(" [cyan]Multi-queue[]: [orange]%d [cyan]queues[]\n", CNE_TAP_MAX_QUEUES);
+    if (ti->nb_queues > 1)
+        cne_printf(" [cyan]Multi-queue[]: [orange]%u [cyan]queues[]", ti->nb_queues);
     else
-#endif
-        cne_printf("  [cyan]Multi-queue[]: [orange]1 [cyan]queue[]\n");
+        cne_printf("  [cyan]Multi-queue[]: [orange]1 [cyan]queue[]");
+    if (ti->vnet_hdr_sz)
+        cne_printf(" [cyan]vnet_hdr[]: [orange]%u [cyan]bytes[]", ti->vnet_hdr_sz);
+    cne_printf("\n");
     return 0;
 }
@@ -21,13 +21,16 @@ extern "C" {
 #define CNE_TAP_MAX_QUEUES 16
 
 struct tap_info {
-    char name[IFNAMSIZ + 1];    /**< Internal Tap device name */
-    struct ether_addr eth_addr; /**< Mac address of the device port */
-    int if_index;               /**< IF_INDEX for the port */
-    uint32_t features;          /**< Features used in creating the interface */
-    int flags;                  /**< Flags used in creating the interface */
-    int fd;                     /**< TUN/TAP file descriptor */
-    int sock;                   /**< socket for ioctl calls */
+    char name[IFNAMSIZ + 1];     /**< Internal Tap device name */
+    struct ether_addr eth_addr;  /**< Mac address of the device port */
+    int if_index;                /**< IF_INDEX for the port */
+    uint32_t features;           /**< Features used in creating the interface */
+    int flags;                   /**< Flags used in creating the interface */
+    int fd;                      /**< TUN/TAP file descriptor, same as fds[0] */
+    int sock;                    /**< socket for ioctl calls */
+    uint16_t nb_queues;          /**< Number of queues, one file descriptor per queue */
+    uint16_t vnet_hdr_sz;        /**< Size of the virtio_net_hdr per packet, 0 if not used */
+    int fds[CNE_TAP_MAX_QUEUES]; /**< TUN/TAP file descriptor for each queue */
 };
 
 /**
@@ -42,6 +45,25 @@ struct tap_info {
  */
 CNDP_API struct tap_info *tun_alloc(int tun_flags, const char *if_name);
 
+/**
+ * Allocate and setup a multi-queue TUN/TAP interface
+ *
+ * Opens one file descriptor per queue using IFF_MULTI_QUEUE, the kernel spreads
+ * the packets sent to the interface across the queues by flow. When IFF_VNET_HDR
+ * is in tun_flags every packet is prefixed by a struct virtio_net_hdr, which lets
+ * the application send packets with a partial checksum or needing segmentation.
+ *
+ * @param tun_flags
+ *   Flags to help create the interface
+ * @param if_name
+ *   Name of the interface to create
+ * @param nb_queues
+ *   Number of queues to create, 1 to CNE_TAP_MAX_QUEUES
+ * @return
+ *   NULL on error or pointer to struct tap_info structure
+ */
+CNDP_API struct tap_info *tun_alloc_mq(int tun_flags, const char *if_name, uint16_t nb_queues);
+
 /**
  * Free resources for a given tun/tap interface.
  *
@@ -80,6 +102,23 @@ tun_get_fd(struct tap_info *ti)
     return -1;
 }
 
+/**
+ * Return the tun/tap file descriptor value of a queue
+ * @param ti
+ *   Pointer to the tap_info structure
+ * @param qid
+ *   The queue index, 0 to nb_queues - 1
+ * @return
+ *   -1 on error or tun/tap fd of the queue
+ */
+static inline int
+tun_get_queue_fd(struct tap_info *ti, uint16_t qid)
+{
+    if (ti && qid < ti->nb_queues)
+        return ti->fds[qid];
+    return -1;
+}
+
 /**
  * Get tun/tap interface name
  *
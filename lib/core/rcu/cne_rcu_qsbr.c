@@ -0,0 +1,466 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright (c) 2018-2020 Arm Limited
+ * Copyright (c) 2023 Intel Corporation
+ */
+
+#include <stdio.h>              // for fprintf, FILE
+#include <string.h>             // for memset, memcpy
+#include <stdint.h>             // for uint64_t, uint32_t
+#include <stdlib.h>             // for free, aligned_alloc
+#include <errno.h>              // for EINVAL, ENOMEM, ENOSPC, EAGAIN
+#include <inttypes.h>           // for PRIu64
+#include <bsd/string.h>         // for strlcpy
+#include <cne_common.h>         // for CNE_ALIGN, CNE_CACHE_LINE_SIZE
+#include <cne_log.h>            // for CNE_LOG_ERR, CNE_ERR_RET
+#include <cne_spinlock.h>       // for cne_spinlock_t
+#include <cne.h>                // for cne_max_threads
+
+#include "cne_rcu_qsbr.h"
+
+/* Defer queue element, the token is followed by 'esize' bytes of user data */
+struct __cne_rcu_qsbr_dq_elem {
+    uint64_t token; /**< Token returned from cne_rcu_qsbr_start() */
+    __extension__ uint8_t elem[0];
+};
+
+struct cne_rcu_qsbr_dq {
+    struct cne_rcu_qsbr *v;               /**< RCU QSBR variable used by this queue */
+    cne_spinlock_t lock;                  /**< Lock used when the queue is MT safe */
+    uint32_t flags;                       /**< Flags from the create parameters */
+    uint32_t size;                        /**< Number of entries in the queue */
+    uint32_t esize;                       /**< Size of the user data in an entry */
+    uint32_t qsize;                       /**< Size of an entry, token plus user data */
+    uint32_t head;                        /**< Index of the oldest entry */
+    uint32_t count;                       /**< Number of entries in the queue */
+    uint32_t trigger_reclaim_limit;       /**< Reclaim when this many entries are queued */
+    uint32_t max_reclaim_size;            /**< Entries to reclaim when triggered */
+    cne_rcu_qsbr_free_resource_t free_fn; /**< Function to free a resource */
+    void *p;                              /**< Pointer passed to free_fn */
+    char name[CNE_RCU_QSBR_DQ_NAMESIZE];  /**< Name of the defer queue */
+    uint8_t *entries;                     /**< Array of 'size' entries of qsize bytes */
+};
+
+#define DQ_ELEM(dq, i) ((struct __cne_rcu_qsbr_dq_elem *)&(dq)->entries[(size_t)(i) * (dq)->qsize])
+
+size_t
+cne_rcu_qsbr_get_memsize(uint32_t max_threads)
+{
+    size_t sz;
+
+    if (max_threads == 0) {
+        CNE_ERR("Invalid max_threads %u\n", max_threads);
+        errno = EINVAL;
+
+        return 1;
+    }
+
+    sz = sizeof(struct cne_rcu_qsbr);
+
+    /* Add the size of quiescent state counter array */
+    sz += sizeof(struct cne_rcu_qsbr_cnt) * max_threads;
+
+    /* Add the size of the registered thread ID bitmap array */
+    sz += __CNE_QSBR_THRID_ARRAY_SIZE(max_threads);
+
+    return sz;
+}
+
+int
+cne_rcu_qsbr_init(struct cne_rcu_qsbr *v, uint32_t max_threads)
+{
+    size_t sz;
+
+    if (v == NULL) {
+        CNE_ERR("Invalid input parameter\n");
+        errno = EINVAL;
+
+        return 1;
+    }
+
+    sz = cne_rcu_qsbr_get_memsize(max_threads);
+    if (sz == 1)
+        return 1;
+
+    /* Set all the threads to offline */
+    memset(v, 0, sz);
+    v->max_threads = max_threads;
+    v->num_elems   = CNE_ALIGN_MUL_CEIL(max_threads, __CNE_QSBR_THRID_ARRAY_ELM_SIZE) /
+                   __CNE_QSBR_THRID_ARRAY_ELM_SIZE;
+    v->token       = __CNE_QSBR_CNT_INIT;
+    v->acked_token = __CNE_QSBR_CNT_INIT - 1;
+
+    return 0;
+}
+
+struct cne_rcu_qsbr *
+cne_rcu_qsbr_create(void)
+{
+    struct cne_rcu_qsbr *v;
+    int max_threads = cne_max_threads();
+    size_t sz;
+
+    if (max_threads <= 0)
+        CNE_NULL_RET("Unable to get the max number of threads\n");
+
+    sz = cne_rcu_qsbr_get_memsize(max_threads);
+    if (sz == 1)
+        return NULL;
+
+    v = aligned_alloc(CNE_CACHE_LINE_SIZE, CNE_ALIGN(sz, CNE_CACHE_LINE_SIZE));
+    if (!v)
+        CNE_NULL_RET("Unable to allocate QSBR variable\n");
+
+    if (cne_rcu_qsbr_init(v, max_threads)) {
+        free(v);
+        return NULL;
+    }
+
+    return v;
+}
+
+void
+cne_rcu_qsbr_free(struct cne_rcu_qsbr *v)
+{
+    free(v);
+}
+
+int
+cne_rcu_qsbr_thread_register(struct cne_rcu_qsbr *v, unsigned int thread_id)
+{
+    unsigned int i, id;
+    uint64_t old_bmap;
+
+    if (v == NULL || thread_id >= v->max_threads) {
+        CNE_ERR("Invalid input parameter\n");
+        errno = EINVAL;
+
+        return 1;
+    }
+
+    id = thread_id & __CNE_QSBR_THRID_MASK;
+    i  = thread_id >> __CNE_QSBR_THRID_INDEX_SHIFT;
+
+    /* Add the thread to the bitmap of registered threads */
+    old_bmap = __atomic_fetch_or(__CNE_QSBR_THRID_ARRAY_ELM(v, i), (1UL << id), __ATOMIC_RELEASE);
+
+    /* Increment the number of threads registered only if the thread was not already
+     * registered
+     */
+    if (!(old_bmap & (1UL << id)))
+        __atomic_fetch_add(&v->num_threads, 1, __ATOMIC_RELAXED);
+
+    return 0;
+}
+
+int
+cne_rcu_qsbr_thread_unregister(struct cne_rcu_qsbr *v, unsigned int thread_id)
+{
+    unsigned int i, id;
+    uint64_t old_bmap;
+
+    if (v == NULL || thread_id >= v->max_threads) {
+        CNE_ERR("Invalid input parameter\n");
+        errno = EINVAL;
+
+        return 1;
+    }
+
+    id = thread_id & __CNE_QSBR_THRID_MASK;
+    i  = thread_id >> __CNE_QSBR_THRID_INDEX_SHIFT;
+
+    /* Make sure any loads of the shared data structure are
+     * completed before removal of the thread from the list of
+     * reporting threads.
+     */
+    old_bmap =
+        __atomic_fetch_and(__CNE_QSBR_THRID_ARRAY_ELM(v, i), ~(1UL << id), __ATOMIC_RELEASE);
+
+    /* Decrement the number of threads unregistered only if the thread was
+     * registered
+     */
+    if (old_bmap & (1UL << id))
+        __atomic_fetch_sub(&v->num_threads, 1, __ATOMIC_RELAXED);
+
+    return 0;
+}
+
+void
+cne_rcu_qsbr_synchronize(struct cne_rcu_qsbr *v, unsigned int thread_id)
+{
+    uint64_t t;
+
+    if (v == NULL)
+        return;
+
+    t = cne_rcu_qsbr_start(v);
+
+    /* If the current thread has readside critical section,
+     * update its quiescent state status.
+     */
+    if (thread_id != CNE_QSBR_THRID_INVALID)
+        cne_rcu_qsbr_quiescent(v, thread_id);
+
+    /* Wait for other readers to enter quiescent state */
+    cne_rcu_qsbr_check(v, t, true);
+}
+
+int
+cne_rcu_qsbr_dump(FILE *f, struct cne_rcu_qsbr *v)
+{
+    uint64_t bmap;
+    uint32_t i, t, id;
+
+    if (v == NULL || f == NULL) {
+        CNE_ERR("Invalid input parameter\n");
+        errno = EINVAL;
+
+        return 1;
+    }
+
+    fprintf(f, "\nQuiescent State Variable @%p\n", (void *)v);
+
+    fprintf(f, "  QS variable memory size = %zu\n", cne_rcu_qsbr_get_memsize(v->max_threads));
+    fprintf(f, "  Given # max threads = %u\n", v->max_threads);
+    fprintf(f, "  Current # threads = %u\n", v->num_threads);
+
+    fprintf(f, "  Registered thread IDs = ");
+    for (i = 0; i < v->num_elems; i++) {
+        bmap = __atomic_load_n(__CNE_QSBR_THRID_ARRAY_ELM(v, i), __ATOMIC_ACQUIRE);
+        id   = i << __CNE_QSBR_THRID_INDEX_SHIFT;
+        while (bmap) {
+            t = __builtin_ctzll(bmap);
+            fprintf(f, "%u ", id + t);
+
+            bmap &= ~(1UL << t);
+        }
+    }
+
+    fprintf(f, "\n");
+
+    fprintf(f, "  Token = %" PRIu64 "\n", __atomic_load_n(&v->token, __ATOMIC_ACQUIRE));
+
+    fprintf(f, "  Least Acknowledged Token = %" PRIu64 "\n",
+            __atomic_load_n(&v->acked_token, __ATOMIC_ACQUIRE));
+
+    fprintf(f, "Quiescent State Counts for readers:\n");
+    for (i = 0; i < v->num_elems; i++) {
+        bmap = __atomic_load_n(__CNE_QSBR_THRID_ARRAY_ELM(v, i), __ATOMIC_ACQUIRE);
+        id   = i << __CNE_QSBR_THRID_INDEX_SHIFT;
+        while (bmap) {
+            t = __builtin_ctzll(bmap);
+            fprintf(f, "thread ID = %u, count = %" PRIu64 "\n", id + t,
+                    __atomic_load_n(&v->qsbr_cnt[id + t].cnt, __ATOMIC_RELAXED));
+            bmap &= ~(1UL << t);
+        }
+    }
+
+    return 0;
+}
+
+static inline void
+dq_lock(struct cne_rcu_qsbr_dq *dq)
+{
+    if (!(dq->flags & CNE_RCU_QSBR_DQ_MT_UNSAFE))
+        cne_spinlock_lock(&dq->lock);
+}
+
+static inline void
+dq_unlock(struct cne_rcu_qsbr_dq *dq)
+{
+    if (!(dq->flags & CNE_RCU_QSBR_DQ_MT_UNSAFE))
+        cne_spinlock_unlock(&dq->lock);
+}
+
+struct cne_rcu_qsbr_dq *
+cne_rcu_qsbr_dq_create(const struct cne_rcu_qsbr_dq_parameters *params)
+{
+    struct cne_rcu_qsbr_dq *dq;
+
+    if (params == NULL || params->free_fn == NULL || params->v == NULL ||
+        params->name == NULL || params->size == 0 || params->esize == 0 ||
+        (params->esize % 4 != 0)) {
+        CNE_ERR("Invalid input parameter\n");
+        errno = EINVAL;
+
+        return NULL;
+    }
+    /* If auto reclamation is configured, reclaim limit
+     * should be a valid value.
+     */
+    if ((params->trigger_reclaim_limit <= params->size) && (params->max_reclaim_size == 0)) {
+        CNE_ERR("Invalid input parameter, size = %u, trigger_reclaim_limit = %u, "
+                "max_reclaim_size = %u\n",
+                params->size, params->trigger_reclaim_limit, params->max_reclaim_size);
+        errno = EINVAL;
+
+        return NULL;
+    }
+
+    dq = calloc(1, sizeof(struct cne_rcu_qsbr_dq));
+    if (dq == NULL) {
+        errno = ENOMEM;
+
+        return NULL;
+    }
+
+    dq->qsize   = __CNE_QSBR_TOKEN_SIZE + params->esize;
+    dq->entries = calloc(params->size, dq->qsize);
+    if (dq->entries == NULL) {
+        free(dq);
+        errno = ENOMEM;
+
+        return NULL;
+    }
+
+    strlcpy(dq->name, params->name, sizeof(dq->name));
+    cne_spinlock_init(&dq->lock);
+    dq->v                     = params->v;
+    dq->flags                 = params->flags;
+    dq->size                  = params->size;
+    dq->esize                 = params->esize;
+    dq->trigger_reclaim_limit = params->trigger_reclaim_limit;
+    dq->max_reclaim_size      = params->max_reclaim_size;
+    dq->free_fn               = params->free_fn;
+    dq->p                     = params->p;
+
+    return dq;
+}
+
+int
+cne_rcu_qsbr_dq_enqueue(struct cne_rcu_qsbr_dq *dq, void *e)
+{
+    struct __cne_rcu_qsbr_dq_elem *dq_elem;
+    uint32_t cur_size;
+
+    if (dq == NULL || e == NULL) {
+        CNE_ERR("Invalid input parameter\n");
+        errno = EINVAL;
+
+        return 1;
+    }
+
+    /* Start the grace period */
+    uint64_t token = cne_rcu_qsbr_start(dq->v);
+
+    /* Reclaim resources if the queue size has hit the reclaim
+     * limit. This helps the queue from growing too large and
+     * allows time for reader threads to report their quiescent state.
+     */
+    cur_size = __atomic_load_n(&dq->count, __ATOMIC_RELAXED);
+    if (cur_size > dq->trigger_reclaim_limit) {
+        CNE_DEBUG("Triggering reclamation on %s\n", dq->name);
+        cne_rcu_qsbr_dq_reclaim(dq, dq->max_reclaim_size, NULL, NULL, NULL);
+    }
+
+    dq_lock(dq);
+
+    /* The queue is full, wait for the oldest entry to pass through a grace period */
+    if (dq->count == dq->size) {
+        dq_unlock(dq);
+        cne_rcu_qsbr_dq_reclaim(dq, dq->max_reclaim_size ?: 1, NULL, NULL, NULL);
+        dq_lock(dq);
+
+        if (dq->count == dq->size) {
+            dq_unlock(dq);
+            CNE_ERR("Defer queue %s is full\n", dq->name);
+            errno = ENOSPC;
+
+            return 1;
+        }
+    }
+
+    /* Enqueue the token and resource. Generating the token and
+     * enqueuing (token + resource) on the queue is not an
+     * atomic operation. When the defer queue is shared by multiple
+     * writers, this might result in tokens enqueued out of order
+     * on the queue. So, some tokens might wait longer than they
+     * are required to be reclaimed.
+     */
+    dq_elem        = DQ_ELEM(dq, (dq->head + dq->count) % dq->size);
+    dq_elem->token = token;
+    memcpy(dq_elem->elem, e, dq->esize);
+    __atomic_store_n(&dq->count, dq->count + 1, __ATOMIC_RELAXED);
+
+    dq_unlock(dq);
+
+    return 0;
+}
+
+int
+cne_rcu_qsbr_dq_reclaim(struct cne_rcu_qsbr_dq *dq, unsigned int n, unsigned int *freed,
+                        unsigned int *pending, unsigned int *available)
+{
+    uint32_t cnt = 0;
+
+    if (dq == NULL || n == 0) {
+        CNE_ERR("Invalid input parameter\n");
+        errno = EINVAL;
+
+        return 1;
+    }
+
+    uint8_t data[dq->esize];
+
+    /* Check reader threads quiescent state and reclaim resources */
+    while (cnt < n) {
+        struct __cne_rcu_qsbr_dq_elem *dq_elem;
+
+        dq_lock(dq);
+        if (dq->count == 0) {
+            dq_unlock(dq);
+            break;
+        }
+
+        dq_elem = DQ_ELEM(dq, dq->head);
+        if (cne_rcu_qsbr_check(dq->v, dq_elem->token, false) != 1) {
+            dq_unlock(dq);
+            break;
+        }
+
+        memcpy(data, dq_elem->elem, dq->esize);
+        dq->head = (dq->head + 1) % dq->size;
+        __atomic_store_n(&dq->count, dq->count - 1, __ATOMIC_RELAXED);
+        dq_unlock(dq);
+
+        /* Reclaim the resource outside of the lock */
+        dq->free_fn(dq->p, data, 1);
+
+        cnt++;
+    }
+
+    CNE_DEBUG("Reclaimed %u resources from %s\n", cnt, dq->name);
+
+    if (freed != NULL)
+        *freed = cnt;
+    if (pending != NULL)
+        *pending = __atomic_load_n(&dq->count, __ATOMIC_RELAXED);
+    if (available != NULL)
+        *available = dq->size - __atomic_load_n(&dq->count, __ATOMIC_RELAXED);
+
+    return 0;
+}
+
+int
+cne_rcu_qsbr_dq_delete(struct cne_rcu_qsbr_dq *dq)
+{
+    unsigned int pending;
+
+    if (dq == NULL) {
+        CNE_DEBUG("Invalid input parameter\n");
+
+        return 0;
+    }
+
+    /* Reclaim all the resources */
+    cne_rcu_qsbr_dq_reclaim(dq, ~0, NULL, &pending, NULL);
+    if (pending != 0) {
+        errno = EAGAIN;
+
+        return 1;
+    }
+
+    free(dq->entries);
+    free(dq);
+
+    return 0;
+}
@@ -5,7 +5,7 @@
 #include <stdlib.h>         // for free, calloc, NULL
 #include <stdint.h>         // for uint16_t, uint64_t
 #include <pktmbuf.h>        // for pktmbuf_free_bulk, pktmbuf_t
-#include <pktdev.h>         // for pktdev_tx_burst
+#include <pktdev.h>         // for pktdev_tx_burst_q
 #include <xskdev.h>         // for xskdev_tx_burst
 
 #include "txbuff.h"
@@ -70,6 +70,13 @@ txbuff_init(txbuff_t *buffer, uint16_t size, txbuff_error_fn cbfn, void *cb_arg)
 
 txbuff_t *
 txbuff_pktdev_create(uint16_t size, txbuff_error_fn cbfn, void *cb_arg, uint16_t lport_id)
+{
+    return txbuff_pktdev_queue_create(size, cbfn, cb_arg, lport_id, 0);
+}
+
+txbuff_t *
+txbuff_pktdev_queue_create(uint16_t size, txbuff_error_fn cbfn, void *cb_arg, uint16_t lport_id,
+                           uint16_t qid)
 {
     txbuff_t *buffer;
 
@@ -77,6 +84,7 @@ txbuff_pktdev_create(uint16_t size, txbuff_error_fn cbfn, void *cb_arg, uint16_t
     if (buffer) {
         buffer->txtype   = TXBUFF_PKTDEV_FLAG;
         buffer->lport_id = lport_id;
+        buffer->qid      = qid;
         if (txbuff_init(buffer, size, cbfn, cb_arg)) {
             free(buffer);
             return NULL;
@@ -126,7 +134,7 @@ txbuff_flush(txbuff_t *buffer)
 
         switch (buffer->txtype) {
         case TXBUFF_PKTDEV_FLAG:
-            sent = pktdev_tx_burst(buffer->lport_id, buffer->pkts, npkts);
+            sent = pktdev_tx_burst_q(buffer->lport_id, buffer->qid, buffer->pkts, npkts);
             if (sent == PKTDEV_ADMIN_STATE_DOWN)
                 return sent;
             break;
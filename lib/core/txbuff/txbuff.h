@@ -44,8 +44,12 @@ typedef void (*txbuff_error_fn)(struct txbuff *buffer, uint16_t unsent, uint16_t
 typedef struct txbuff {
     CNE_STD_C11
     union {
-        void *info;        /**< xskdev_info_t pointer for TXBUFF_XSKDEV_FLAG */
-        uint16_t lport_id; /**< lport ID for pktdev API */
+        void *info; /**< xskdev_info_t pointer for TXBUFF_XSKDEV_FLAG */
+        CNE_STD_C11
+        struct {
+            uint16_t lport_id; /**< lport ID for pktdev API */
+            uint16_t qid;      /**< Queue index within the lport for pktdev API */
+        };
     };
     txbuff_error_fn error_cb; /**< TX Buffer error callback function */
     void *userdata;           /**< Userdata for error and count callbacks */
@@ -85,6 +89,26 @@ enum { TXBUFF_PKTDEV_FLAG = 0, TXBUFF_XSKDEV_FLAG = 1 };
 CNDP_API txbuff_t *txbuff_pktdev_create(uint16_t size, txbuff_error_fn cbfn, void *cb_arg,
                                         uint16_t lport_id);
 
+/**
+ * Initialize default values for buffered transmitting on a given queue of a multi-queue
+ * lport and return txbuff pointer for pktdev
+ *
+ * @param size
+ *   Buffer size
+ * @param cbfn
+ *   Callback on error function, if null use txbuff_drop_callback().
+ * @param cb_arg
+ *   Argument for callback function.
+ * @param lport_id
+ *   The lport ID to be used with pktdev_tx_burst_q() call.
+ * @param qid
+ *   The queue index within the lport, queue 0 is the queue used by txbuff_pktdev_create().
+ * @return
+ *   NULL on error or pointer to structure txbuff
+ */
+CNDP_API txbuff_t *txbuff_pktdev_queue_create(uint16_t size, txbuff_error_fn cbfn, void *cb_arg,
+                                              uint16_t lport_id, uint16_t qid);
+
 /**
  * Initialize default values for buffered transmitting and return txbuff pointer for xskdev
  *
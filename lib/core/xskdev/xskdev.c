@@ -24,12 +24,14 @@
 #include <linux/sched.h>          // for sched_yield
 #include <netdev_funcs.h>         // for netdev_get_ring_params
 #include <cne_mutex_helper.h>
+#include <cne_ring.h>             // for CNE_RING_NAMESIZE
 #include <dirent.h>
 #include <limits.h>        // for PATH_MAX
 #include <bpf/bpf.h>
 #include <error.h>
 
 #include "xskdev.h"
+#include "xskdev_priv.h"      // for xskdev_rx_meta_fill, xskdev_tx_meta_fill
 #include "cne_lport.h"        // for lport_stats_t, lport_cfg, lport_cfg_t
 
 #define FQ_ADD_BURST_COUNT 64
@@ -218,10 +220,17 @@ fq_add(xskdev_info_t *xi, int times)
             break;
         }
 
-        nb_bufs = xskdev_buf_alloc(xi, (void **)bufs, FQ_ADD_BURST_COUNT);
+        if (xi->rx_cache)
+            nb_bufs = pktmbuf_alloc_bulk_cache(xi->pi, (pktmbuf_t **)bufs, FQ_ADD_BURST_COUNT,
+                                               xi->rx_cache);
+        else
+            nb_bufs = xskdev_buf_alloc(xi, (void **)bufs, FQ_ADD_BURST_COUNT);
         if (nb_bufs != FQ_ADD_BURST_COUNT) {
             xi->stats.fq_alloc_zero++;
-            xsk_ring_prod__cancel(fq, nb_bufs);
+            /* Give back all of the reserved entries and any partial allocation */
+            xsk_ring_prod__cancel(fq, FQ_ADD_BURST_COUNT);
+            if (nb_bufs > 0 && nb_bufs < FQ_ADD_BURST_COUNT)
+                xskdev_buf_free(xi, (void **)bufs, nb_bufs);
             break;
         }
         xi->stats.rx_buf_alloc += nb_bufs;
@@ -302,6 +311,23 @@ __rx_burst(xskdev_info_t *xi, xskdev_rxq_t *rxq, void *umem_addr, uint32_t idx_r
     return rx_bytes;
 }
 
+static __cne_always_inline void
+rx_wakeup(xskdev_info_t *xi, xskdev_rxq_t *rxq, struct xskdev_umem *ux)
+{
+    xi->stats.rx_ring_empty++;
+    /*
+     * Assuming a kernel >= 5.11 is used and busy_polling is enabled,
+     * we can use the recvfrom() syscall for AF_XDP sockets.
+     */
+    if (xi->busy_polling) {
+        xi->stats.rx_busypoll_wakeup++;
+        (void)recvfrom(xsk_socket__fd(rxq->xsk), NULL, 0, MSG_DONTWAIT, NULL, NULL);
+    } else if (xi->needs_wakeup || xsk_ring_prod__needs_wakeup(&ux->fq)) {
+        xi->stats.rx_poll_wakeup++;
+        (void)poll(&rxq->fds, 1, POLL_TIMEOUT);
+    }
+}
+
 static uint16_t
 xskdev_rx_burst_default(void *_xi, void **bufs, uint16_t nb_pkts)
 {
@@ -320,21 +346,14 @@ xskdev_rx_burst_default(void *_xi, void **bufs, uint16_t nb_pkts)
 
     xi->stats.rx_burst_called++;
 
+    /* The TX owner sends the packets staged by other threads each time it polls RX */
+    if (xi->tx_owner_mode)
+        xskdev_tx_flush(xi);
+
     idx_rx = 0;
     rcvd   = xsk_ring_cons__peek(rx, nb_pkts, &idx_rx);
     if (!rcvd) {
-        xi->stats.rx_ring_empty++;
-        /*
-         * Assuming a kernel >= 5.11 is used and busy_polling is enabled,
-         * we can use the recvfrom() syscall for AF_XDP sockets.
-         */
-        if (xi->busy_polling) {
-            xi->stats.rx_busypoll_wakeup++;
-            (void)recvfrom(xsk_socket__fd(rxq->xsk), NULL, 0, MSG_DONTWAIT, NULL, NULL);
-        } else if (xi->needs_wakeup || xsk_ring_prod__needs_wakeup(&ux->fq)) {
-            xi->stats.rx_poll_wakeup++;
-            (void)poll(&rxq->fds, 1, POLL_TIMEOUT);
-        }
+        rx_wakeup(xi, rxq, ux);
         return 0;
     } else
         xi->stats.rx_rcvd_count += rcvd;
@@ -369,6 +388,11 @@ xskdev_rx_burst_default(void *_xi, void **bufs, uint16_t nb_pkts)
         break;
     }
 
+    if (xi->rx_metadata) {
+        for (uint16_t n = 0; n < rcvd; n++)
+            xskdev_rx_meta_fill(bufs[n]);
+    }
+
     xi->stats.ipackets += rcvd;
     xi->stats.ibytes += rx_bytes;
 
@@ -379,6 +403,79 @@ xskdev_rx_burst_default(void *_xi, void **bufs, uint16_t nb_pkts)
     return (uint16_t)rcvd;
 }
 
+/*
+ * Multi-buffer receive, a packet larger than a single frame arrives as a
+ * sequence of descriptors with XDP_PKT_CONTD set on all but the last one.
+ * The segments are chained together using pktmbuf_t.next and a packet is only
+ * returned once its last descriptor has been seen. A partial chain is held in
+ * the xskdev_info_t structure until the next call.
+ */
+static uint16_t
+xskdev_rx_burst_sg(void *_xi, void **bufs, uint16_t nb_pkts)
+{
+    xskdev_info_t *xi = (xskdev_info_t *)_xi;
+    xskdev_rxq_t *rxq = &xi->rxq;
+    pktmbuf_t **pkts  = (pktmbuf_t **)bufs;
+    struct xsk_ring_cons *rx;
+    struct xskdev_umem *ux;
+    uint64_t rx_bytes;
+    unsigned int idx_rx;
+    uint16_t rcvd, nb_rx;
+
+    if ((ux = rxq->ux) == NULL)
+        return 0;
+    rx = &rxq->rx;
+
+    xi->stats.rx_burst_called++;
+
+    if (xi->tx_owner_mode)
+        xskdev_tx_flush(xi);
+
+    /* Descriptors are peeked, which limits the number of packets to nb_pkts */
+    idx_rx = 0;
+    rcvd   = xsk_ring_cons__peek(rx, nb_pkts, &idx_rx);
+    if (!rcvd) {
+        rx_wakeup(xi, rxq, ux);
+        return 0;
+    } else
+        xi->stats.rx_rcvd_count += rcvd;
+
+    rx_bytes = 0;
+    nb_rx    = 0;
+    for (uint16_t n = 0; n < rcvd; n++) {
+        const struct xdp_desc *d = xsk_ring_cons__rx_desc(rx, idx_rx++);
+        pktmbuf_t *m;
+
+        rx_bytes += xi->__get_mbuf_rx(xi, ux->umem_addr, d, (void **)&m);
+
+        if (xi->sg_head) {
+            xi->sg_tail->next = m;
+            xi->sg_head->nb_segs++;
+        } else {
+            /* The metadata is only in front of the first segment */
+            if (xi->rx_metadata)
+                xskdev_rx_meta_fill(m);
+            xi->sg_head = m;
+        }
+        xi->sg_tail = m;
+
+        if (d->options & XDP_PKT_CONTD)
+            continue;
+
+        pkts[nb_rx++] = xi->sg_head;
+        xi->sg_head = xi->sg_tail = NULL;
+    }
+
+    xi->stats.ipackets += nb_rx;
+    xi->stats.ibytes += rx_bytes;
+
+    xsk_ring_cons__release(rx, rcvd);
+
+    fq_add(xi, 2); /* Attempt to keep the FQ as full as possible */
+
+    return nb_rx;
+}
+
 static __cne_always_inline void
 kick_tx(xskdev_info_t *xi)
 {
@@ -427,7 +524,7 @@ pull_umem_cq(xskdev_info_t *xi)
     unsigned int mbuf_cnt = LPORT_TX_BATCH_SIZE;
     uint64_t umem_addr    = (uint64_t)ux->umem_addr;
     uint64_t mask         = ~(xi->buf_mgmt.frame_size - 1);
-    unsigned int n, idx_cq = 0;
+    unsigned int n, nb_free = 0, idx_cq = 0;
 
     kick_tx(xi);
 
@@ -439,16 +536,29 @@ pull_umem_cq(xskdev_info_t *xi)
 
     for (uint32_t i = 0; i < n && i < mbuf_cnt; i++) {
         uint64_t offset = *xsk_ring_cons__comp_addr(cq, idx_cq++);
+        void *buf = xi->__pull_cq_addr(offset, umem_addr, mask, xi->buf_mgmt.pool_header_sz);
 
-        mbufs[i] = xi->__pull_cq_addr(offset, umem_addr, mask, xi->buf_mgmt.pool_header_sz);
-        xskdev_buf_reset(xi, mbufs[i], xi->rxq.ux->obj_sz, xi->buf_mgmt.buf_headroom);
+        /* Each descriptor holds one reference on the buffer, the buffer can still be
+         * used by other packets, e.g. the payload of IP fragments.
+         */
+        if (xi->pi) {
+            buf = pktmbuf_prefree_seg(buf);
+            if (!buf)
+                continue;
+        } else
+            xskdev_buf_reset(xi, buf, xi->rxq.ux->obj_sz, xi->buf_mgmt.buf_headroom);
+
+        mbufs[nb_free++] = buf;
     }
 
     xsk_ring_cons__release(cq, n);
 
-    xskdev_buf_free(xi, mbufs, n);
+    if (xi->tx_cache)
+        pktmbuf_free_bulk_cache(xi->pi, (pktmbuf_t **)mbufs, nb_free, xi->tx_cache);
+    else if (nb_free)
+        xskdev_buf_free(xi, mbufs, nb_free);
 
-    xi->stats.cq_buf_freed += n;
+    xi->stats.cq_buf_freed += nb_free;
 }
 
 static __cne_always_inline uint64_t
@@ -475,6 +585,27 @@ __get_mbuf_addr_tx_aligned(void *_xi, void *mb, uint64_t umem_addr)
            xskdev_buf_get_data(xi, mb);
 }
 
+/*
+ * The descriptor of an indirect mbuf points into the buffer of the mbuf owning it,
+ * which is what the CQ returns. Move the reference of the indirect mbuf over to the
+ * descriptor and free the indirect mbuf itself, it is not used after this point.
+ */
+static __cne_always_inline void
+__tx_seg_done(pktmbuf_t *m)
+{
+    if (unlikely(!pktmbuf_is_direct(m))) {
+        pktmbuf_refcnt_update(pktmbuf_from_indirect(m), 1);
+        pktmbuf_free_seg(m);
+    }
+}
+
+/*
+ * A chained mbuf can not be sent without multi-buffer support, only its first segment
+ * would be on the wire. The segments are copied into the first segment and counted in
+ * tx_copied, when they do not fit the packet is freed and counted in tx_seg_limit. A
+ * dropped packet is part of the returned count like the sent packets. User managed
+ * buffers have no segments.
+ */
 static uint16_t
 xskdev_tx_burst_locked(xskdev_info_t *xi, void **bufs, uint16_t nb_pkts)
 {
@@ -483,6 +614,7 @@ xskdev_tx_burst_locked(xskdev_info_t *xi, void **bufs, uint16_t nb_pkts)
     void **mbs             = bufs;
     uint32_t idx_tx        = 0;
     uint16_t nb_free       = 0;
+    uint16_t nb_tx, nb_sent = 0;
     struct xdp_desc *desc;
     uint64_t tx_bytes = 0;
     uint64_t umem_addr;
@@ -491,30 +623,167 @@ xskdev_tx_burst_locked(xskdev_info_t *xi, void **bufs, uint16_t nb_pkts)
 
     nb_free = xsk_ring_prod__reserve(&txq->tx, nb_pkts, &idx_tx);
 
-    for (uint32_t j = 0; j < nb_free; j++) {
-        desc       = xsk_ring_prod__tx_desc(&txq->tx, idx_tx++);
-        desc->addr = xi->__get_mbuf_addr_tx(xi, *mbs, umem_addr);
-        desc->len  = xskdev_buf_get_data_len(xi, *mbs);
+    for (nb_tx = 0; nb_tx < nb_pkts && nb_sent < nb_free; nb_tx++) {
+        if (xi->pi && unlikely(((pktmbuf_t *)*mbs)->nb_segs > 1)) {
+            if (pktmbuf_linearize(*mbs) < 0) {
+                xi->stats.tx_seg_limit++;
+                pktmbuf_free(*mbs);
+                mbs = xskdev_buf_inc_ptr(xi, mbs);
+                continue;
+            }
+            xi->stats.tx_copied++;
+        }
+
+        desc          = xsk_ring_prod__tx_desc(&txq->tx, idx_tx++);
+        desc->addr    = xi->__get_mbuf_addr_tx(xi, *mbs, umem_addr);
+        desc->len     = xskdev_buf_get_data_len(xi, *mbs);
+        desc->options = (xi->tx_metadata) ? xskdev_tx_meta_fill(*mbs) : 0;
 
         tx_bytes += xskdev_buf_get_data_len(xi, *mbs);
+        if (xi->pi)
+            __tx_seg_done(*mbs);
         mbs = xskdev_buf_inc_ptr(xi, mbs);
+        nb_sent++;
     }
 
-    xsk_ring_prod__submit(&txq->tx, nb_free);
+    xsk_ring_prod__cancel(&txq->tx, nb_free - nb_sent);
+    xsk_ring_prod__submit(&txq->tx, nb_sent);
 
     pull_umem_cq(xi);
-    xi->stats.opackets += nb_free;
+    xi->stats.opackets += nb_sent;
     xi->stats.obytes += tx_bytes;
 
-    return nb_free;
+    return nb_tx;
 }
 
+/*
+ * Multi-buffer transmit, each segment of a packet uses one descriptor and all
+ * but the last descriptor of the packet have XDP_PKT_CONTD set. The descriptors
+ * for a packet are reserved all at once, so a packet is never partially queued.
+ * A packet with more than XSKDEV_MAX_SEGS segments is freed and counted in
+ * tx_seg_limit, it is part of the returned count like the sent packets.
+ */
 static uint16_t
-xskdev_tx_burst_default(void *_xi, void **bufs, uint16_t nb_pkts)
+xskdev_tx_burst_sg_locked(xskdev_info_t *xi, void **bufs, uint16_t nb_pkts)
+{
+    xskdev_txq_t *txq = &xi->txq;
+    pktmbuf_t **pkts  = (pktmbuf_t **)bufs;
+    uint32_t idx_tx   = 0;
+    uint32_t nb_descs = 0;
+    uint64_t tx_bytes = 0;
+    struct xdp_desc *desc;
+    uint64_t umem_addr;
+    uint16_t nb_tx, nb_sent = 0;
+
+    umem_addr = (uint64_t)txq->ux->umem_addr;
+
+    for (nb_tx = 0; nb_tx < nb_pkts; nb_tx++) {
+        pktmbuf_t *m     = pkts[nb_tx];
+        uint16_t nb_segs = m->nb_segs;
+        uint32_t options;
+
+        /* The packet can never be sent, drop it or it stops every later burst */
+        if (unlikely(nb_segs > XSKDEV_MAX_SEGS)) {
+            xi->stats.tx_seg_limit++;
+            pktmbuf_free(m);
+            continue;
+        }
+
+        if (xsk_ring_prod__reserve(&txq->tx, nb_segs, &idx_tx) != nb_segs) {
+            xi->stats.tx_ring_full++;
+            break;
+        }
+
+        /* The TX metadata is only in front of the first segment */
+        options = (xi->tx_metadata) ? xskdev_tx_meta_fill(m) : 0;
+
+        for (pktmbuf_t *next; m; m = next, options = 0) {
+            next          = m->next;
+            desc          = xsk_ring_prod__tx_desc(&txq->tx, idx_tx++);
+            desc->addr    = xi->__get_mbuf_addr_tx(xi, m, umem_addr);
+            desc->len     = pktmbuf_data_len(m);
+            desc->options = ((next) ? XDP_PKT_CONTD : 0) | options;
+
+            tx_bytes += desc->len;
+            __tx_seg_done(m);
+        }
+        nb_descs += nb_segs;
+        nb_sent++;
+    }
+
+    if (nb_descs)
+        xsk_ring_prod__submit(&txq->tx, nb_descs);
+
+    pull_umem_cq(xi);
+    xi->stats.opackets += nb_sent;
+    xi->stats.obytes += tx_bytes;
+
+    return nb_tx;
+}
+
+typedef uint16_t (*xskdev_tx_burst_fn_t)(xskdev_info_t *xi, void **bufs, uint16_t nb_pkts);
+
+static __cne_always_inline uintptr_t
+__tx_self(void)
+{
+    return (uintptr_t)pthread_self();
+}
+
+/*
+ * Move packets staged by other threads onto the TX ring, only called by the TX
+ * owner. Packets not accepted by the TX ring stay in the stash for the next call.
+ */
+static __cne_always_inline uint16_t
+__tx_drain(xskdev_info_t *xi, xskdev_tx_burst_fn_t tx_fn)
+{
+    uint16_t nb = xi->tx_stash_cnt;
+    uint16_t sent;
+
+    if (nb < XSKDEV_TX_STASH_SIZE)
+        nb += cne_ring_dequeue_burst(xi->tx_ring, &xi->tx_stash[nb], XSKDEV_TX_STASH_SIZE - nb,
+                                     NULL);
+    if (nb == 0)
+        return 0;
+
+    sent = tx_fn(xi, xi->tx_stash, nb);
+    if (sent < nb)
+        memmove(xi->tx_stash, &xi->tx_stash[sent], (nb - sent) * sizeof(void *));
+    xi->tx_stash_cnt = nb - sent;
+    xi->stats.tx_staged += sent;
+
+    return sent;
+}
+
+/*
+ * TX owner mode, the owning thread writes the TX ring without a lock and every
+ * other thread hands its packets to the owner through the MPSC staging ring.
+ */
+static __cne_always_inline uint16_t
+__tx_burst_owner(xskdev_info_t *xi, void **bufs, uint16_t nb_pkts, xskdev_tx_burst_fn_t tx_fn)
+{
+    uintptr_t self  = __tx_self();
+    uintptr_t owner = __atomic_load_n(&xi->tx_owner, __ATOMIC_ACQUIRE);
+
+    if (unlikely(owner != self)) {
+        /* The first thread to transmit claims the TX ring when no owner was set */
+        if (owner || !__atomic_compare_exchange_n(&xi->tx_owner, &owner, self, false,
+                                                  __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE))
+            return cne_ring_enqueue_burst(xi->tx_ring, bufs, nb_pkts, NULL);
+    }
+
+    __tx_drain(xi, tx_fn);
+
+    return (nb_pkts) ? tx_fn(xi, bufs, nb_pkts) : 0;
+}
+
+static __cne_always_inline uint16_t
+__tx_burst(xskdev_info_t *xi, void **bufs, uint16_t nb_pkts, xskdev_tx_burst_fn_t tx_fn)
 {
-    xskdev_info_t *xi = (xskdev_info_t *)_xi;
     uint16_t ret;
 
+    if (xi->tx_owner_mode)
+        return __tx_burst_owner(xi, bufs, nb_pkts, tx_fn);
+
     if (xskdev_use_tx_lock) {
         int err;
 
@@ -524,19 +793,58 @@ xskdev_tx_burst_default(void *_xi, void **bufs, uint16_t nb_pkts)
             return 0;
         }
 
-        ret = xskdev_tx_burst_locked(xi, bufs, nb_pkts);
+        ret = tx_fn(xi, bufs, nb_pkts);
 
         err = pthread_mutex_unlock(&xi->tx_lock);
         if (err)
             CNE_ERR("Failed to unlock xskdev: %d: %s\n", err, strerror(err));
     } else {
         /* Lock is disabled, call tx_burst function directly. */
-        ret = xskdev_tx_burst_locked(xi, bufs, nb_pkts);
+        ret = tx_fn(xi, bufs, nb_pkts);
     }
 
     return ret;
 }
 
+static uint16_t
+xskdev_tx_burst_default(void *_xi, void **bufs, uint16_t nb_pkts)
+{
+    return __tx_burst((xskdev_info_t *)_xi, bufs, nb_pkts, xskdev_tx_burst_locked);
+}
+
+static uint16_t
+xskdev_tx_burst_sg(void *_xi, void **bufs, uint16_t nb_pkts)
+{
+    return __tx_burst((xskdev_info_t *)_xi, bufs, nb_pkts, xskdev_tx_burst_sg_locked);
+}
+
+int
+xskdev_tx_owner_set(xskdev_info_t *xi)
+{
+    uintptr_t self  = __tx_self();
+    uintptr_t owner = 0;
+
+    if (!xi || !xi->tx_owner_mode)
+        return -EINVAL;
+
+    if (!__atomic_compare_exchange_n(&xi->tx_owner, &owner, self, false, __ATOMIC_ACQ_REL,
+                                     __ATOMIC_ACQUIRE) &&
+        owner != self)
+        return -EBUSY;
+
+    return 0;
+}
+
+uint16_t
+xskdev_tx_flush(xskdev_info_t *xi)
+{
+    if (!xi || !xi->tx_owner_mode ||
+        __atomic_load_n(&xi->tx_owner, __ATOMIC_ACQUIRE) != __tx_self())
+        return 0;
+
+    return __tx_drain(xi, (xi->multi_buffer) ? xskdev_tx_burst_sg_locked : xskdev_tx_burst_locked);
+}
+
 static struct xskdev_umem *
 umem_create(lport_cfg_t *cfg)
 {
@@ -571,6 +879,12 @@ umem_create(lport_cfg_t *cfg)
     if (cfg->flags & LPORT_UMEM_UNALIGNED_BUFFERS)
         umem_cfg.flags = XDP_UMEM_UNALIGNED_CHUNK_FLAG;
 
+#ifdef CAN_USE_XSK_TX_METADATA
+    /* Reserve room for the TX metadata in front of the packet data of each frame */
+    if (cfg->flags & LPORT_XDP_METADATA)
+        umem_cfg.tx_metadata_len = sizeof(struct xsk_tx_metadata);
+#endif
+
     xu->fq_size = umem_cfg.fill_size;
 
     ret = netdev_get_ring_params(cfg->ifname, &hw_rx_nb_desc, NULL);
@@ -680,6 +994,19 @@ xskdev_buf_reset_default(void *mb, uint32_t buf_len, size_t headroom)
     CNE_SET_USED(headroom);
 }
 
+static __cne_always_inline void
+xskdev_buf_reset_sg(void *mb, uint32_t buf_len, size_t headroom)
+{
+    pktmbuf_t *p = (pktmbuf_t *)mb;
+
+    CNE_SET_USED(buf_len);
+    CNE_SET_USED(headroom);
+
+    /* A buffer given to the FQ is the first segment of a new packet */
+    p->next    = NULL;
+    p->nb_segs = 1;
+}
+
 static __cne_always_inline uint16_t
 xskdev_buf_get_data_len_default(void *mb)
 {
@@ -761,7 +1088,8 @@ xskdev_socket_create(struct lport_cfg *c)
         CNE_DEBUG("xi->xsk_map_fd = %d\n", xi->xsk_map_fd);
     }
 
-    if (xskdev_use_tx_lock) {
+    /* The TX lock is not used when a single thread owns the TX ring */
+    if (xskdev_use_tx_lock && !(c->flags & LPORT_TX_OWNER)) {
         ret = cne_mutex_create(&xi->tx_lock, 0);
         if (ret)
             CNE_ERR_GOTO(err, "Failed to initialize xskdev tx lock: %s\n", strerror(errno));
@@ -821,10 +1149,63 @@ xskdev_socket_create(struct lport_cfg *c)
         xi->buf_mgmt.pool_header_sz   = 0;
     }
 
+    if (c->flags & LPORT_MULTI_BUFFER) {
+        if (c->flags & LPORT_USER_MANAGED_BUFFERS)
+            CNE_ERR_GOTO(err, "Multi-buffer is not supported with user managed buffers\n");
+
+        xi->multi_buffer       = true;
+        xi->buf_mgmt.buf_reset = xskdev_buf_reset_sg;
+    }
+
+    if (c->flags & LPORT_XDP_METADATA) {
+        if (c->flags & LPORT_USER_MANAGED_BUFFERS)
+            CNE_ERR_GOTO(err, "XDP metadata is not supported with user managed buffers\n");
+
+        xi->rx_metadata = true;
+#ifdef CAN_USE_XSK_TX_METADATA
+        xi->tx_metadata = true;
+#else
+        CNE_INFO("AF_XDP TX metadata is not supported by kernel or libxdp\n");
+#endif
+    }
+
+    if (c->flags & LPORT_TX_OWNER) {
+        char name[CNE_RING_NAMESIZE];
+
+        if (c->flags & LPORT_USER_MANAGED_BUFFERS)
+            CNE_ERR_GOTO(err, "TX owner mode is not supported with user managed buffers\n");
+
+        xi->tx_owner_mode = true;
+
+        /* Other threads can stage up to a full TX ring of packets for the owner */
+        snprintf(name, sizeof(name), "xsk_tx_%u_%u", if_index, c->qid);
+        xi->tx_ring = cne_ring_create(name, 0, c->tx_nb_desc, RING_F_SC_DEQ | RING_F_EXACT_SZ);
+        if (!xi->tx_ring)
+            CNE_ERR_GOTO(err, "Failed to create TX staging ring %s\n", name);
+    }
+
+    if (c->cache_sz) {
+        if (c->flags & LPORT_USER_MANAGED_BUFFERS)
+            CNE_ERR_GOTO(err, "mbuf caches are not supported with user managed buffers\n");
+
+        xi->rx_cache =
+            pktmbuf_cache_create(xi->pi, c->cache_sz, c->cache_low_wm, c->cache_high_wm);
+        xi->tx_cache =
+            pktmbuf_cache_create(xi->pi, c->cache_sz, c->cache_low_wm, c->cache_high_wm);
+        if (!xi->rx_cache || !xi->tx_cache)
+            CNE_ERR_GOTO(err, "Failed to create mbuf caches size %u low %u high %u\n", c->cache_sz,
+                         c->cache_low_wm, c->cache_high_wm);
+    }
+
     if (!c->buf_mgmt.buf_rx_burst || !c->buf_mgmt.buf_tx_burst) {
         /* If no external rx and tx functions were registered*/
-        xi->buf_mgmt.buf_rx_burst = xskdev_rx_burst_default;
-        xi->buf_mgmt.buf_tx_burst = xskdev_tx_burst_default;
+        if (xi->multi_buffer) {
+            xi->buf_mgmt.buf_rx_burst = xskdev_rx_burst_sg;
+            xi->buf_mgmt.buf_tx_burst = xskdev_tx_burst_sg;
+        } else {
+            xi->buf_mgmt.buf_rx_burst = xskdev_rx_burst_default;
+            xi->buf_mgmt.buf_tx_burst = xskdev_tx_burst_default;
+        }
     }
 
     if (!(c->flags & LPORT_UMEM_UNALIGNED_BUFFERS)) {
@@ -860,6 +1241,9 @@ xskdev_socket_create(struct lport_cfg *c)
     cfg.tx_size      = c->tx_nb_desc;
     cfg.libbpf_flags = xi->unprivileged ? XSK_LIBBPF_FLAGS__INHIBIT_PROG_LOAD : 0;
 
+    if (xi->multi_buffer)
+        cfg.bind_flags |= XDP_USE_SG;
+
     if (xi->busy_polling) {
         xi->busy_budget  = (c->busy_budget) ? c->busy_budget : AF_XDP_DFLT_BUSY_BUDGET;
         xi->busy_timeout = (c->busy_timeout) ? c->busy_timeout : AF_XDP_DFLT_BUSY_TIMEOUT;
@@ -929,6 +1313,29 @@ xskdev_socket_destroy(xskdev_info_t *xi)
     uint32_t curr_prog_id = 0;
 
     if (xi) {
+        if (xi->sg_head) {
+            /* Drop a partially received multi-buffer packet */
+            pktmbuf_free(xi->sg_head);
+            xi->sg_head = xi->sg_tail = NULL;
+        }
+
+        if (xi->tx_ring) {
+            unsigned int n;
+
+            /* Drop the packets staged for the TX owner and never sent */
+            pktmbuf_free_bulk((pktmbuf_t **)xi->tx_stash, xi->tx_stash_cnt);
+            while ((n = cne_ring_dequeue_burst(xi->tx_ring, xi->tx_stash, XSKDEV_TX_STASH_SIZE,
+                                               NULL)) > 0)
+                pktmbuf_free_bulk((pktmbuf_t **)xi->tx_stash, n);
+            cne_ring_free(xi->tx_ring);
+            xi->tx_ring = NULL;
+        }
+
+        /* Return the cached mbufs to the pool */
+        pktmbuf_cache_destroy(xi->pi, xi->rx_cache);
+        pktmbuf_cache_destroy(xi->pi, xi->tx_cache);
+        xi->rx_cache = xi->tx_cache = NULL;
+
         if (xi->if_index) {
             if (!xi->xsk_map_fd) {        // Don't unload programs we didn't load.
                 if (xi->unprivileged == 0) {
@@ -962,7 +1369,7 @@ xskdev_socket_destroy(xskdev_info_t *xi)
                 xi->rxq.ux->umem = NULL;
             }
 
-            if (xskdev_use_tx_lock) {
+            if (xskdev_use_tx_lock && !xi->tx_owner_mode) {
                 int err = cne_mutex_destroy(&xi->tx_lock);
 
                 if (err)
@@ -1165,6 +1572,8 @@ xskdev_print_stats(const char *name, lport_stats_t *s, bool dbg_stats)
         cne_printf("[beige]tx_kick_again      : [cyan]%'lu[]\n", s->tx_kick_again);
         cne_printf("[beige]tx_ring_full       : [cyan]%'lu[]\n", s->tx_ring_full);
         cne_printf("[beige]tx_copied          : [cyan]%'lu[]\n", s->tx_copied);
+        cne_printf("[beige]tx_seg_limit       : [cyan]%'lu[]\n", s->tx_seg_limit);
+        cne_printf("[beige]tx_staged          : [cyan]%'lu[]\n", s->tx_staged);
 
         cne_printf("[beige]cq_empty           : [cyan]%'lu[]\n", s->cq_empty);
         cne_printf("[beige]cq_buf_freed       : [cyan]%'lu[]\n", s->cq_buf_freed);
@@ -26,6 +26,7 @@
 
 #include <cne_common.h>        // for CNDP_API, CNE_STD_C11
 #include <cne_lport.h>         // for lport_stats_t, buf_alloc_t, buf_free_t
+#include <cne_ring_api.h>      // for cne_ring_t
 #include <pktmbuf.h>           // for pktmbuf_t
 #include <uds.h>
 
@@ -57,6 +58,48 @@ extern "C" {
 #define XDP_USE_NEED_WAKEUP (1 << 3)
 #endif
 
+#ifndef XDP_USE_SG
+/* Enable multi-buffer (scatter-gather) support on the socket, a packet can
+ * then span more than one descriptor in the RX and TX rings.
+ */
+#define XDP_USE_SG (1 << 4)
+#endif
+
+#ifndef XDP_PKT_CONTD
+/* Set in the xdp_desc.options field when the packet continues in the next descriptor */
+#define XDP_PKT_CONTD (1 << 0)
+#endif
+
+#define XSKDEV_MAX_SEGS 17 /**< Max number of descriptors/segments per packet in multi-buffer */
+
+#define XSKDEV_TX_STASH_SIZE 64 /**< Max staged packets the TX owner sends per burst */
+
+/**
+ * RX metadata written by an XDP-hints program in front of the packet data.
+ *
+ * When LPORT_XDP_METADATA is set the XDP program attached to the interface is expected to
+ * reserve sizeof(struct xskdev_rx_meta) bytes with bpf_xdp_adjust_meta() and fill them in
+ * from the bpf_xdp_metadata_rx_hash(), bpf_xdp_metadata_rx_timestamp() and
+ * bpf_xdp_metadata_rx_vlan_tag() kfuncs before redirecting the packet to the XSKMAP.
+ * Only the fields with a XSKDEV_RX_META_* bit set in flags are valid and the metadata is
+ * ignored unless magic is XSKDEV_RX_META_MAGIC. The AF_XDP PMD guide has an example program.
+ */
+struct xskdev_rx_meta {
+    uint64_t rx_timestamp; /**< Hardware RX timestamp in nanoseconds */
+    uint32_t rx_hash;      /**< RSS hash of the packet */
+    uint32_t rx_hash_type; /**< The enum xdp_rss_hash_type of rx_hash */
+    uint16_t vlan_proto;   /**< Protocol of the stripped VLAN tag in network byte order */
+    uint16_t vlan_tci;     /**< TCI of the stripped VLAN tag in host byte order */
+    uint32_t flags;        /**< XSKDEV_RX_META_* bits of the valid fields */
+    uint32_t reserved;     /**< Reserved, keeps magic next to the packet data */
+    uint32_t magic;        /**< Set to XSKDEV_RX_META_MAGIC by the XDP program */
+};
+
+#define XSKDEV_RX_META_MAGIC     0x434e4450 /**< "CNDP" marks valid RX metadata */
+#define XSKDEV_RX_META_HASH      (1 << 0)   /**< rx_hash and rx_hash_type are valid */
+#define XSKDEV_RX_META_TIMESTAMP (1 << 1)   /**< rx_timestamp is valid */
+#define XSKDEV_RX_META_VLAN      (1 << 2)   /**< vlan_proto and vlan_tci are valid */
+
 #define XSKDEV_STATS_FLAG       (1 << 0) /**< flag to xskdev_dump() to dump out the stats */
 #define XSKDEV_RX_FQ_TX_CQ_FLAG (1 << 1) /**< Flag to dump the RX/FQ/TX/CQ rings/queues */
 
@@ -125,6 +168,23 @@ typedef struct xskdev_info {
     bool skb_mode;     /**< Force lport to use SKB Copy mode */
     bool busy_polling; /**< Enable the lport to use busy polling if available */
     bool shared_umem;  /**< Enable Shared UMEM support */
+    bool multi_buffer; /**< Enable multi-buffer (XDP_USE_SG) support */
+    bool rx_metadata;  /**< Fill the mbuf from the XDP RX metadata */
+    bool tx_metadata;  /**< Pass mbuf TX offloads to the kernel as AF_XDP TX metadata */
+
+    pktmbuf_t *sg_head; /**< First segment of a partially received multi-buffer packet */
+    pktmbuf_t *sg_tail; /**< Last segment of a partially received multi-buffer packet */
+
+    /* TX owner mode, only the owner thread touches the TX ring, see xskdev_tx_owner_set() */
+    bool tx_owner_mode;                   /**< TX ring is owned by one thread, no TX lock is used */
+    uintptr_t tx_owner;                   /**< Thread owning the TX ring or zero if not claimed */
+    cne_ring_t *tx_ring;                  /**< MPSC staging ring for TX from non-owner threads */
+    uint16_t tx_stash_cnt;                /**< Number of staged packets held in tx_stash */
+    void *tx_stash[XSKDEV_TX_STASH_SIZE]; /**< Staged packets waiting for TX ring space */
+
+    /* RX and TX can run on different threads, so each side has its own mbuf cache */
+    struct mempool_cache *rx_cache; /**< mbuf cache used to refill the fill queue */
+    struct mempool_cache *tx_cache; /**< mbuf cache used to free completed TX buffers */
 
     lport_buf_mgmt_t buf_mgmt; /**< Buffer management routines structure */
     xskdev_get_mbuf_addr_tx_t
@@ -188,6 +248,38 @@ xskdev_tx_burst(xskdev_info_t *xi, void **bufs, uint16_t nb_pkts)
     return xi->buf_mgmt.buf_tx_burst(xi, bufs, nb_pkts);
 }
 
+/**
+ * Claim the TX ring of a socket created with LPORT_TX_OWNER for the calling thread.
+ *
+ * The owner transmits directly on the TX ring without taking a lock, all other
+ * threads calling xskdev_tx_burst() enqueue their packets on a multi-producer
+ * staging ring, which the owner drains at the start of each of its own TX bursts
+ * and each time it calls xskdev_rx_burst(), so an owner polling RX with nothing to
+ * send still flushes the staged packets. An owner that does neither must call
+ * xskdev_tx_flush(). If this routine is not called the first thread to transmit
+ * becomes the owner.
+ *
+ * @param xi
+ *   The xskdev_info_t structure pointer
+ * @return
+ *   0 on success, -EINVAL if the socket is not in TX owner mode or -EBUSY if
+ *   another thread already owns the TX ring.
+ */
+CNDP_API int xskdev_tx_owner_set(xskdev_info_t *xi);
+
+/**
+ * Transmit the packets staged by non-owner threads. xskdev_rx_burst() calls this
+ * for the TX owner, an owner not polling RX must call it when it has no packets
+ * of its own to send.
+ *
+ * @param xi
+ *   The xskdev_info_t structure pointer
+ * @return
+ *   The number of staged packets placed on the TX ring, always 0 when the
+ *   caller is not the TX owner.
+ */
+CNDP_API uint16_t xskdev_tx_flush(xskdev_info_t *xi);
+
 /**
  * Get the stats for the interface
  *
@@ -0,0 +1,124 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright (c) 2019-2023 Intel Corporation
+ */
+
+#ifndef _XSKDEV_PRIV_H_
+#define _XSKDEV_PRIV_H_
+
+/**
+ * @file
+ * @internal
+ *
+ * XDP RX metadata and AF_XDP TX metadata helpers of the xskdev burst functions.
+ */
+
+#include <stddef.h>               // for offsetof
+#include <stdint.h>               // for uint32_t, uint64_t
+#include <linux/if_xdp.h>         // for xsk_tx_metadata, XDP_TX_METADATA
+#include <cne_common.h>           // for __cne_always_inline, CNE_SET_USED
+#include <pktmbuf.h>              // for pktmbuf_t, pktmbuf_mtod_offset
+#include <net/cne_tcp.h>          // for cne_tcp_hdr
+#include <net/cne_udp.h>          // for cne_udp_hdr
+
+#include "xskdev.h"        // for xskdev_rx_meta, XSKDEV_RX_META_*
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * AF_XDP TX metadata needs the kernel headers >= 6.8 and we detect in the
+ * top-level meson.build a libxdp with xsk_umem_config.tx_metadata_len
+ */
+#if defined(XDP_TX_METADATA) && HAS_XSK_TX_METADATA == 1
+#define CAN_USE_XSK_TX_METADATA 1
+#endif
+
+/**
+ * @internal
+ *
+ * Copy the XDP RX metadata in front of the packet data into the mbuf. The magic
+ * value is cleared so stale metadata is not used when the frame is reused.
+ *
+ * @param m
+ *   The pktmbuf_t pointer of the packet, or of its first segment.
+ */
+static __cne_always_inline void
+xskdev_rx_meta_fill(pktmbuf_t *m)
+{
+    struct xskdev_rx_meta *meta;
+
+    meta = pktmbuf_mtod_offset(m, struct xskdev_rx_meta *, -(int)sizeof(struct xskdev_rx_meta));
+    if (meta->magic != XSKDEV_RX_META_MAGIC)
+        return;
+
+    if (meta->flags & XSKDEV_RX_META_HASH) {
+        m->hash = meta->rx_hash;
+        m->ol_flags |= CNE_MBUF_F_RX_RSS_HASH;
+    }
+    if (meta->flags & XSKDEV_RX_META_TIMESTAMP) {
+        m->timestamp = meta->rx_timestamp;
+        m->ol_flags |= CNE_MBUF_F_RX_TIMESTAMP;
+    }
+    if (meta->flags & XSKDEV_RX_META_VLAN) {
+        m->vlan_tci = meta->vlan_tci;
+        m->ol_flags |= CNE_MBUF_F_RX_VLAN | CNE_MBUF_F_RX_VLAN_STRIPPED;
+    }
+    meta->magic = 0;
+}
+
+/**
+ * @internal
+ *
+ * Convert the mbuf TX offload flags into AF_XDP TX metadata in front of the packet
+ * data. The L4 checksum field must hold the pseudo header checksum, the same as the
+ * other CNE_MBUF_F_TX_*_CKSUM users.
+ *
+ * @param m
+ *   The pktmbuf_t pointer of the packet, or of its first segment.
+ * @return
+ *   XDP_TX_METADATA to set in the xdp_desc.options of the first descriptor of the packet
+ *   or 0 if the mbuf has no such offload, has no headroom for the metadata or
+ *   CAN_USE_XSK_TX_METADATA is not set.
+ */
+static __cne_always_inline uint32_t
+xskdev_tx_meta_fill(pktmbuf_t *m)
+{
+#ifdef CAN_USE_XSK_TX_METADATA
+    struct xsk_tx_metadata *meta;
+    uint64_t l4 = m->ol_flags & CNE_MBUF_F_TX_L4_MASK;
+
+    if ((l4 != CNE_MBUF_F_TX_TCP_CKSUM && l4 != CNE_MBUF_F_TX_UDP_CKSUM &&
+         !(m->ol_flags & CNE_MBUF_F_TX_LAUNCH_TIME)) ||
+        unlikely(pktmbuf_headroom(m) < sizeof(struct xsk_tx_metadata)))
+        return 0;
+
+    meta = pktmbuf_mtod_offset(m, struct xsk_tx_metadata *, -(int)sizeof(struct xsk_tx_metadata));
+    meta->flags = 0;
+
+    if (l4 == CNE_MBUF_F_TX_TCP_CKSUM || l4 == CNE_MBUF_F_TX_UDP_CKSUM) {
+        meta->flags |= XDP_TXMD_FLAGS_CHECKSUM;
+        meta->request.csum_start  = m->l2_len + m->l3_len;
+        meta->request.csum_offset = (l4 == CNE_MBUF_F_TX_TCP_CKSUM)
+                                        ? offsetof(struct cne_tcp_hdr, cksum)
+                                        : offsetof(struct cne_udp_hdr, dgram_cksum);
+    }
+#ifdef XDP_TXMD_FLAGS_LAUNCH_TIME
+    if (m->ol_flags & CNE_MBUF_F_TX_LAUNCH_TIME) {
+        meta->flags |= XDP_TXMD_FLAGS_LAUNCH_TIME;
+        meta->request.launch_time = m->timestamp;
+    }
+#endif
+
+    return (meta->flags) ? XDP_TX_METADATA : 0;
+#else
+    CNE_SET_USED(m);
+    return 0;
+#endif
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _XSKDEV_PRIV_H_ */
@@ -36,7 +36,7 @@ extern "C" {
 #define CNE_VER_PREFIX       "CNDP"
 #define CNE_NAME_LEN         24
 #define XDP_PKT_HEADROOM     256 /**< Must mirror XDP_PACKET_HEADROOM */
-#define CNE_PKTMBUF_HEADROOM (XDP_PKT_HEADROOM - sizeof(pktmbuf_t))
+#define CNE_PKTMBUF_HEADROOM ((size_t)(XDP_PKT_HEADROOM - CNE_CACHE_LINE_SIZE))
 #define CNE_CACHE_LINE_SIZE  64
 
 #define PKTDEV_QUEUE_STAT_CNTRS 16
@@ -31,6 +31,7 @@ extern "C" {
 #define LPORT_FRAME_SHIFT          11 /* Log2(2048) of LPORT_FRAME_SIZE to avoid a divide */
 #define LPORT_DFLT_START_QUEUE_IDX 0
 #define LPORT_DFLT_QUEUE_COUNT     1
+#define LPORT_MAX_QUEUES           16 /* Max number of queues a single lport can own */
 #define LPORT_RX_BATCH_SIZE        256
 #define LPORT_TX_BATCH_SIZE        256
 
@@ -72,13 +73,17 @@ typedef struct lport_cfg {
     char ifname[LPORT_NAME_LEN];   /**< Interface name or netdev name */
     char pmd_name[LPORT_NAME_LEN]; /**< Name of the PMD i.e. net_af_xdp, net_ring */
     uint16_t flags;                /**< Flags to configure the AF_XDP interface */
-    uint16_t qid;                  /**< Queue ID */
+    uint16_t qid;                  /**< Queue ID, or first queue ID when nb_queues > 1 */
+    uint16_t nb_queues;            /**< Number of queues starting at qid, 0 is the same as 1 */
     uint32_t bufcnt;               /**< Number of buffers in the pool */
     uint32_t bufsz;                /**< Size of the buffers in the UMEM space */
     uint32_t rx_nb_desc;           /**< Number of RX descriptor entries */
     uint32_t tx_nb_desc;           /**< Number of TX descriptor entries */
     uint16_t busy_timeout;         /**< 1-65535 or 0 - use default value, value in milliseconds */
     uint16_t busy_budget;          /**< -1 disabled, 0 use default, >0 budget value */
+    uint16_t cache_sz;             /**< Size of the RX/TX mbuf caches, 0 to disable the caches */
+    uint16_t cache_low_wm;         /**< mbuf cache low watermark, refill below this level */
+    uint16_t cache_high_wm;        /**< mbuf cache high watermark, flush at this level */
     void *addr;                    /**< Start address of the buffers */
     char *umem_addr;               /**< Address of the allocated UMEM area */
     char *pmd_opts;                /**< options string from jasonc file */
@@ -97,6 +102,9 @@ typedef struct lport_cfg {
 #define LPORT_SHARED_UMEM            (1 << 4) /**< Enable UMEM Shared mode if available */
 #define LPORT_USER_MANAGED_BUFFERS   (1 << 5) /**< Enable Buffer Manager outside of CNDP */
 #define LPORT_UMEM_UNALIGNED_BUFFERS (1 << 6) /**< Enable unaligned frame UMEM support */
+#define LPORT_MULTI_BUFFER           (1 << 7) /**< Enable AF_XDP multi-buffer (XDP_USE_SG) */
+#define LPORT_TX_OWNER               (1 << 8) /**< Lockless TX owner, others stage TX */
+#define LPORT_XDP_METADATA           (1 << 9) /**< Enable XDP RX and AF_XDP TX metadata */
 
 typedef struct lport_stats {
     uint64_t ipackets;           /**< Total number of successfully received packets. */
@@ -133,11 +141,33 @@ typedef struct lport_stats {
     uint64_t tx_kick_again;  /**< Number of times tx kick needed to be restarted */
     uint64_t tx_ring_full;   /**< TX Ring is full */
     uint64_t tx_copied;      /**< TX packet was copied */
+    uint64_t tx_seg_limit;   /**< TX packet dropped, more segments than allowed */
+    uint64_t tx_staged;      /**< TX packets sent by the TX owner for other threads */
                              /* CQ debug stats */
     uint64_t cq_empty;       /**< CQ is empty counter */
     uint64_t cq_buf_freed;   /**< Number of buffers freed */
 } lport_stats_t;
 
+/**
+ * Add the counters in one lport_stats_t structure to another, used to aggregate
+ * the per queue statistics of a multi-queue lport.
+ *
+ * @param sum
+ *   The lport_stats_t structure to add the counters to.
+ * @param stats
+ *   The lport_stats_t structure holding the counters to add.
+ */
+static inline void
+lport_stats_add(lport_stats_t *sum, const lport_stats_t *stats)
+{
+    uint64_t *d       = (uint64_t *)sum;
+    const uint64_t *s = (const uint64_t *)stats;
+
+    /* All members of lport_stats_t are uint64_t counters */
+    for (size_t i = 0; i < sizeof(lport_stats_t) / sizeof(uint64_t); i++)
+        d[i] += s[i];
+}
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,236 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright (c) 2023 Intel Corporation
+ */
+
+#ifndef _CNE_CKSUM_H_
+#define _CNE_CKSUM_H_
+
+/**
+ * @file
+ *
+ * One's complement checksum helpers shared by the IP, UDP and TCP code.
+ *
+ * cne_cksum_sum() adds 32 bit words into 64 bit accumulators, using AVX512 or AVX2 when the
+ * build enables them, and folds the result back to 16 bits. The folded sum can be added to
+ * other sums and reduced with __cne_raw_cksum_reduce() like the sum of 16 bit words.
+ *
+ * The update helpers apply RFC 1624 eqn. 3 to change a checksum after one field of the
+ * checksummed data changed, without summing the data again.
+ */
+
+#include <stdint.h>
+#include <stddef.h>
+#include <cne_common.h>
+#include <cne_vect.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @internal Fold a 64 bit one's complement sum to 16 bits.
+ *
+ * @param sum
+ *   The 64 bit sum.
+ * @return
+ *   The sum folded to 16 bits, not complemented.
+ */
+static __cne_always_inline uint32_t
+__cne_cksum_fold64(uint64_t sum)
+{
+    sum = (sum >> 32) + (sum & 0xffffffff);
+    sum = (sum >> 32) + (sum & 0xffffffff);
+    sum = (sum >> 16) + (sum & 0xffff);
+    sum = (sum >> 16) + (sum & 0xffff);
+
+    return (uint32_t)sum;
+}
+
+#if defined(CNE_MACHINE_CPUFLAG_AVX512F)
+/**
+ * @internal Sum the 64 byte blocks of a buffer, the remaining bytes are left to the caller.
+ */
+static __cne_always_inline uint64_t
+__cne_cksum_sum_vec(const uint8_t **buf, size_t *len)
+{
+    const __m512i mask = _mm512_set1_epi64(0xffffffff);
+    __m512i acc0 = _mm512_setzero_si512(), acc1 = _mm512_setzero_si512();
+    const uint8_t *p = *buf;
+    size_t n         = *len;
+
+    /* The high and low 32 bit word of each lane go to separate 64 bit adds, no carry is lost */
+    for (; n >= 128; n -= 128, p += 128) {
+        __m512i a = _mm512_loadu_si512((const void *)p);
+        __m512i b = _mm512_loadu_si512((const void *)(p + 64));
+
+        acc0 = _mm512_add_epi64(acc0, _mm512_and_si512(a, mask));
+        acc1 = _mm512_add_epi64(acc1, _mm512_srli_epi64(a, 32));
+        acc0 = _mm512_add_epi64(acc0, _mm512_and_si512(b, mask));
+        acc1 = _mm512_add_epi64(acc1, _mm512_srli_epi64(b, 32));
+    }
+    if (n >= 64) {
+        __m512i a = _mm512_loadu_si512((const void *)p);
+
+        acc0 = _mm512_add_epi64(acc0, _mm512_and_si512(a, mask));
+        acc1 = _mm512_add_epi64(acc1, _mm512_srli_epi64(a, 32));
+        n -= 64;
+        p += 64;
+    }
+    *buf = p;
+    *len = n;
+
+    return (uint64_t)_mm512_reduce_add_epi64(_mm512_add_epi64(acc0, acc1));
+}
+#define CNE_CKSUM_VEC_MIN 64 /**< Smallest buffer summed with vector instructions */
+#elif defined(CNE_MACHINE_CPUFLAG_AVX2)
+/**
+ * @internal Sum the 32 byte blocks of a buffer, the remaining bytes are left to the caller.
+ */
+static __cne_always_inline uint64_t
+__cne_cksum_sum_vec(const uint8_t **buf, size_t *len)
+{
+    const __m256i mask = _mm256_set1_epi64x(0xffffffff);
+    __m256i acc0 = _mm256_setzero_si256(), acc1 = _mm256_setzero_si256();
+    const uint8_t *p = *buf;
+    size_t n         = *len;
+    __m128i s;
+
+    /* The high and low 32 bit word of each lane go to separate 64 bit adds, no carry is lost */
+    for (; n >= 64; n -= 64, p += 64) {
+        __m256i a = _mm256_loadu_si256((const __m256i *)p);
+        __m256i b = _mm256_loadu_si256((const __m256i *)(p + 32));
+
+        acc0 = _mm256_add_epi64(acc0, _mm256_and_si256(a, mask));
+        acc1 = _mm256_add_epi64(acc1, _mm256_srli_epi64(a, 32));
+        acc0 = _mm256_add_epi64(acc0, _mm256_and_si256(b, mask));
+        acc1 = _mm256_add_epi64(acc1, _mm256_srli_epi64(b, 32));
+    }
+    if (n >= 32) {
+        __m256i a = _mm256_loadu_si256((const __m256i *)p);
+
+        acc0 = _mm256_add_epi64(acc0, _mm256_and_si256(a, mask));
+        acc1 = _mm256_add_epi64(acc1, _mm256_srli_epi64(a, 32));
+        n -= 32;
+        p += 32;
+    }
+    *buf = p;
+    *len = n;
+
+    acc0 = _mm256_add_epi64(acc0, acc1);
+    s    = _mm_add_epi64(_mm256_castsi256_si128(acc0), _mm256_extracti128_si256(acc0, 1));
+
+    return (uint64_t)_mm_cvtsi128_si64(s) + (uint64_t)_mm_extract_epi64(s, 1);
+}
+#define CNE_CKSUM_VEC_MIN 32 /**< Smallest buffer summed with vector instructions */
+#endif
+
+/**
+ * Calculate the one's complement sum of a buffer.
+ *
+ * The buffer is summed as 32 bit words into a 64 bit sum, with vector instructions when
+ * the build enables AVX2 or AVX512. The result is congruent to the sum of the 16 bit words
+ * of the buffer and is reduced with __cne_raw_cksum_reduce().
+ *
+ * @param buf
+ *   Pointer to the buffer, no alignment is required.
+ * @param len
+ *   Length of the buffer in bytes, an odd last byte is padded with zero.
+ * @param sum
+ *   Initial value of the sum.
+ * @return
+ *   The sum folded to 16 bits, not complemented.
+ */
+static inline uint32_t
+cne_cksum_sum(const void *buf, size_t len, uint32_t sum)
+{
+    typedef uint32_t __attribute__((__may_alias__)) u32_p;
+    typedef uint16_t __attribute__((__may_alias__)) u16_p;
+    const uint8_t *p = (const uint8_t *)(uintptr_t)buf;
+    uint64_t s       = sum;
+
+#ifdef CNE_CKSUM_VEC_MIN
+    if (len >= CNE_CKSUM_VEC_MIN)
+        s += __cne_cksum_sum_vec(&p, &len);
+#endif
+
+    for (; len >= 16; len -= 16, p += 16) {
+        s += ((const u32_p *)p)[0];
+        s += ((const u32_p *)p)[1];
+        s += ((const u32_p *)p)[2];
+        s += ((const u32_p *)p)[3];
+    }
+    for (; len >= 4; len -= 4, p += 4)
+        s += *(const u32_p *)p;
+    if (len >= 2) {
+        s += *(const u16_p *)p;
+        len -= 2;
+        p += 2;
+    }
+
+    /* if length is in odd bytes */
+    if (len == 1) {
+        uint16_t left     = 0;
+        *(uint8_t *)&left = *p;
+        s += left;
+    }
+
+    return __cne_cksum_fold64(s);
+}
+
+/**
+ * Update a checksum after a 16 bit word of the checksummed data changed (RFC 1624).
+ *
+ * The checksum and the words are in the byte order they have in the packet.
+ *
+ * @param cksum
+ *   The current checksum, as found in the header.
+ * @param old_val
+ *   The old value of the word.
+ * @param new_val
+ *   The new value of the word.
+ * @return
+ *   The checksum to store in the header.
+ */
+static inline uint16_t
+cne_cksum_update16(uint16_t cksum, uint16_t old_val, uint16_t new_val)
+{
+    uint32_t sum;
+
+    /* HC' = ~(~HC + ~m + m') */
+    sum = (uint16_t)~cksum + (uint32_t)(uint16_t)~old_val + new_val;
+    sum = (sum >> 16) + (sum & 0xffff);
+    sum = (sum >> 16) + (sum & 0xffff);
+
+    return (uint16_t)~sum;
+}
+
+/**
+ * Update a checksum after a 32 bit word of the checksummed data changed (RFC 1624).
+ *
+ * The checksum and the words are in the byte order they have in the packet, e.g. an IPv4
+ * address rewritten in the IP header and in the TCP or UDP pseudo header.
+ *
+ * @param cksum
+ *   The current checksum, as found in the header.
+ * @param old_val
+ *   The old value of the 32 bit word.
+ * @param new_val
+ *   The new value of the 32 bit word.
+ * @return
+ *   The checksum to store in the header.
+ */
+static inline uint16_t
+cne_cksum_update32(uint16_t cksum, uint32_t old_val, uint32_t new_val)
+{
+    uint64_t sum;
+
+    sum = (uint16_t)~cksum + (uint64_t)(uint32_t)~old_val + new_val;
+
+    return (uint16_t)~__cne_cksum_fold64(sum);
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _CNE_CKSUM_H_ */
@@ -23,6 +23,7 @@
 
 #include <cne_byteorder.h>
 #include <pktmbuf_offload.h>
+#include <net/cne_cksum.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -117,7 +118,7 @@ cne_ipv4_hdr_len(const struct cne_ipv4_hdr *ipv4_hdr)
 
 /**
  * @internal Calculate a sum of all words in the buffer.
- * Helper routine for the cne_raw_cksum().
+ * Helper routine for the cne_raw_cksum(), see cne_cksum_sum().
  *
  * @param buf
  *   Pointer to the buffer.
@@ -126,38 +127,12 @@ cne_ipv4_hdr_len(const struct cne_ipv4_hdr *ipv4_hdr)
  * @param sum
  *   Initial value of the sum.
  * @return
- *   sum += Sum of all words in the buffer.
+ *   sum += Sum of all words in the buffer, folded to 16 bits.
  */
 static inline uint32_t
 __cne_raw_cksum(const void *buf, size_t len, uint32_t sum)
 {
-    /* workaround gcc strict-aliasing warning */
-    uintptr_t ptr = (uintptr_t)buf;
-    typedef uint16_t __attribute__((__may_alias__)) u16_p;
-    const u16_p *u16_buf = (const u16_p *)ptr;
-
-    while (len >= (sizeof(*u16_buf) * 4)) {
-        sum += u16_buf[0];
-        sum += u16_buf[1];
-        sum += u16_buf[2];
-        sum += u16_buf[3];
-        len -= sizeof(*u16_buf) * 4;
-        u16_buf += 4;
-    }
-    while (len >= sizeof(*u16_buf)) {
-        sum += *u16_buf;
-        len -= sizeof(*u16_buf);
-        u16_buf += 1;
-    }
-
-    /* if length is in odd bytes */
-    if (len == 1) {
-        uint16_t left     = 0;
-        *(uint8_t *)&left = *(const uint8_t *)u16_buf;
-        sum += left;
-    }
-
-    return sum;
+    return cne_cksum_sum(buf, len, sum);
 }
 
 /**
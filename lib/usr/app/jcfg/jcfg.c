@@ -392,6 +392,7 @@ _object_free(jcfg_hdr_t *hdr)
         free(((jcfg_thd_t *)hdr)->group_name);
         free(((jcfg_thd_t *)hdr)->lport_names);
         free(((jcfg_thd_t *)hdr)->lports);
+        free(((jcfg_thd_t *)hdr)->lport_qids);
         break;
     case JCFG_USER_TYPE:
         break;
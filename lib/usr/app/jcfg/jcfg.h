@@ -153,6 +153,10 @@ typedef struct jcfg_umem {
     uint16_t idx;               /**< The UMEM index id 0 to N */
     uint16_t shared_umem;       /**< Enable shared umem support */
     uint16_t region_cnt;        /**< Number of regions defined */
+    uint16_t cache_sz;          /**< Size of the per lport mbuf caches, 0 to disable */
+    uint16_t cache_low_wm;      /**< mbuf cache low watermark */
+    uint16_t cache_high_wm;     /**< mbuf cache high watermark, 0 to use the default */
+    int16_t numa_node;          /**< NUMA node of the UMEM, -1 to follow its netdevs */
     region_info_t *rinfo;       /**< Region information data */
 } jcfg_umem_t;
 
@@ -168,7 +172,9 @@ typedef struct jcfg_lport {
     jcfg_umem_t *umem;           /**< UMEM configuration structure */
     uint16_t region_idx;         /**< UMEM region index */
     uint16_t lpid;               /**< The lport index number */
-    uint16_t qid;                /**< The queue ID number */
+    uint16_t qid;                /**< The queue ID number, first queue ID if nb_queues > 1 */
+    uint16_t nb_queues;          /**< Number of queues starting at qid, 0 or 1 for one queue */
+    uint16_t qrefs;              /**< Number of thread references, used to spread the queues */
     uint16_t busy_timeout;       /**< busy timeout value in milliseconds */
     uint16_t busy_budget;        /**< busy budget 0xFFFF disabled, 0 use default, >0 budget */
     uint16_t flags;     /**< Flags to configure lport in lport_cfg_t.flags in cne_lport.h */
@@ -181,6 +187,7 @@ typedef struct jcfg_lport {
 #define JCFG_LPORT_UMEM_NAME         "umem"
 #define JCFG_LPORT_REGION_NAME       "region"
 #define JCFG_LPORT_QID_NAME          "qid"
+#define JCFG_LPORT_NB_QUEUES_NAME    "nb_queues"
 #define JCFG_LPORT_DESCRIPTION_NAME  "description"
 #define JCFG_LPORT_DESC_NAME         "desc"
 #define JCFG_LPORT_BUSY_POLL_NAME    "busy_poll"
@@ -191,6 +198,9 @@ typedef struct jcfg_lport {
 #define JCFG_UDS_NAME                "uds_path"
 #define JCFG_LPORT_FORCE_WAKEUP_NAME "force_wakeup"
 #define JCFG_LPORT_SKB_MODE_NAME     "skb_mode"
+#define JCFG_LPORT_MULTI_BUFFER_NAME "multi_buffer"
+#define JCFG_LPORT_TX_OWNER_NAME     "tx_owner"
+#define JCFG_LPORT_XDP_METADATA_NAME "xdp_metadata"
 
 /**
  * JCFG  lgroup for lcore allocations
@@ -214,6 +224,7 @@ typedef struct jcfg_thd {
     uint16_t idx;              /**< Thread index value */
     char **lport_names;        /**< List of lport names */
     jcfg_lport_t **lports;     /**< The lports attached to this configuration */
+    uint16_t *lport_qids;      /**< Queue index in each of the lports[] this thread polls */
     int tid;                   /**< System Thread id value */
     volatile uint16_t quit;    /**< Set to non-zero to force thread to quit */
     volatile uint16_t pause;   /**< Set to non-zero to pause thread */
@@ -240,13 +251,14 @@ typedef struct jcfg_lport_group {
     uint16_t busy_timeout;             /**< busy timeout value in milliseconds */
     uint16_t busy_budget;              /**< busy budget 0xFFFF disabled, 0 use default, >0 budget */
     uint16_t flags;                    /**< Flags to configure lport in lport_cfg_t.flags */
-
+    uint16_t multi_queue;              /**< One multi-queue lport per netdev, not one per queue */
 } jcfg_lport_group_t;
 
 /** JCFG lport group configuration names */
 #define JCFG_LPORT_GROUP_NETDEV_NAMES_NAME "netdevs"
 #define JCFG_LPORT_GROUP_QUEUES_NAME       "queues"
 #define JCFG_LPORT_GROUP_THREAD_NAMES_NAME "threads"
+#define JCFG_LPORT_GROUP_MULTI_QUEUE_NAME  "multi_queue"
 
 /**
  *  A user defined object type
@@ -743,6 +755,21 @@ CNDP_API jcfg_data_t *jcfg_get_data(jcfg_info_t *jinfo);
  */
 CNDP_API jcfg_umem_t *jcfg_umem_by_index(jcfg_info_t *jinfo, int idx);
 
+/**
+ * Return the NUMA node to allocate the UMEM memory on.
+ *
+ * The node set with the 'numa' key of the UMEM is used when present, otherwise the node of
+ * the netdevs of the lports using the UMEM, from /sys/class/net/<netdev>/device/numa_node.
+ *
+ * @param jinfo
+ *   The jcfg information structure pointer.
+ * @param umem
+ *   The UMEM configuration structure pointer.
+ * @return
+ *   The NUMA node or MMAP_NUMA_NODE_ANY if the node is not known.
+ */
+CNDP_API int jcfg_umem_numa_node(jcfg_info_t *jinfo, jcfg_umem_t *umem);
+
 /**
  * Return the memory address of the region in UMEM area.
  *
@@ -755,6 +782,23 @@ CNDP_API jcfg_umem_t *jcfg_umem_by_index(jcfg_info_t *jinfo, int idx);
  */
 CNDP_API char *jcfg_lport_region(jcfg_lport_t *lport, uint32_t *objcnt);
 
+struct lport_cfg;
+
+/**
+ * Fill in the lport configuration of a jcfg lport, from the lport and its UMEM.
+ *
+ * The caller sets the fields not in the JSON file, like xsk_uds or xsk_map_path, before
+ * calling pktdev_port_setup() or xskdev_socket_create().
+ *
+ * @param lport
+ *   The jcfg_lport_t pointer for the lport.
+ * @param pcfg
+ *   The lport configuration to fill in.
+ * @return
+ *   0 on success or -1 if the lport region is not configured correctly.
+ */
+CNDP_API int jcfg_lport_cfg(jcfg_lport_t *lport, struct lport_cfg *pcfg);
+
 /**
  * Set the JSON string data for parsing later
  *
@@ -310,6 +310,11 @@ _decode_sections_end(jcfg_info_t *jinfo, void *arg)
                 CNE_ERR("lport '%s' not found\n", thd->lport_names[i]);
                 return -1;
             }
+            lport = thd->lports[i];
+
+            /* Threads sharing a multi-queue lport each poll the next queue of the lport */
+            if (lport->nb_queues > 1)
+                thd->lport_qids[i] = lport->qrefs++ % lport->nb_queues;
         }
     }
 
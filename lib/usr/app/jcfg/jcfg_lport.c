@@ -57,6 +57,45 @@ jcfg_lport_region(jcfg_lport_t *lport, uint32_t *objcnt)
     return umem->rinfo[lport->region_idx].addr;
 }
 
+int
+jcfg_lport_cfg(jcfg_lport_t *lport, struct lport_cfg *pcfg)
+{
+    jcfg_umem_t *umem;
+
+    if (!lport || !lport->umem || !pcfg)
+        CNE_ERR_RET("Invalid lport or lport_cfg pointer\n");
+
+    umem = lport->umem;
+
+    pcfg->qid           = lport->qid;
+    pcfg->nb_queues     = lport->nb_queues;
+    pcfg->bufsz         = umem->bufsz;
+    pcfg->rx_nb_desc    = umem->rxdesc;
+    pcfg->tx_nb_desc    = umem->txdesc;
+    pcfg->cache_sz      = umem->cache_sz;
+    pcfg->cache_low_wm  = umem->cache_low_wm;
+    pcfg->cache_high_wm = umem->cache_high_wm;
+    pcfg->umem_addr     = mmap_addr(umem->mm);
+    pcfg->umem_size     = mmap_size(umem->mm, NULL, NULL);
+    pcfg->pmd_opts      = lport->pmd_opts;
+    pcfg->busy_timeout  = lport->busy_timeout;
+    pcfg->busy_budget   = lport->busy_budget;
+    pcfg->flags         = lport->flags;
+    pcfg->flags |= (umem->shared_umem == 1) ? LPORT_SHARED_UMEM : 0;
+
+    pcfg->addr = jcfg_lport_region(lport, &pcfg->bufcnt);
+    if (!pcfg->addr)
+        CNE_ERR_RET("lport %s region index %d >= %d or not configured correctly\n", lport->name,
+                    lport->region_idx, umem->region_cnt);
+    pcfg->pi = umem->rinfo[lport->region_idx].pool;
+
+    strlcpy(pcfg->pmd_name, lport->pmd_name, sizeof(pcfg->pmd_name));
+    strlcpy(pcfg->ifname, lport->netdev, sizeof(pcfg->ifname));
+    strlcpy(pcfg->name, lport->name, sizeof(pcfg->name));
+
+    return 0;
+}
+
 #define JCFG_OPT_NUM 2
 
 static int
@@ -89,6 +128,15 @@ _lport(struct json_object *obj, int flags, struct json_object *parent __cne_unus
             lport->region_idx = json_object_get_int(obj);
         else if (!strncmp(key, JCFG_LPORT_QID_NAME, keylen))
             lport->qid = json_object_get_int(obj);
+        else if (!strncmp(key, JCFG_LPORT_NB_QUEUES_NAME, keylen)) {
+            int val;
+
+            val = json_object_get_int(obj);
+            if (val < 1 || val > LPORT_MAX_QUEUES)
+                CNE_ERR_RET_VAL(JSON_C_VISIT_RETURN_ERROR, "%s: Invalid Range 1-%d\n",
+                                JCFG_LPORT_NB_QUEUES_NAME, LPORT_MAX_QUEUES);
+            lport->nb_queues = (uint16_t)val;
+        }
         else if (!strncmp(key, JCFG_LPORT_DESC_NAME, keylen) ||
                  !strncmp(key, JCFG_LPORT_DESCRIPTION_NAME, keylen))
             lport->desc = strdup(json_object_get_string(obj));
@@ -118,6 +166,12 @@ _lport(struct json_object *obj, int flags, struct json_object *parent __cne_unus
             lport->flags |= json_object_get_boolean(obj) ? LPORT_FORCE_WAKEUP : 0;
         else if (!strncmp(key, JCFG_LPORT_SKB_MODE_NAME, keylen))
             lport->flags |= json_object_get_boolean(obj) ? LPORT_SKB_MODE : 0;
+        else if (!strncmp(key, JCFG_LPORT_MULTI_BUFFER_NAME, keylen))
+            lport->flags |= json_object_get_boolean(obj) ? LPORT_MULTI_BUFFER : 0;
+        else if (!strncmp(key, JCFG_LPORT_TX_OWNER_NAME, keylen))
+            lport->flags |= json_object_get_boolean(obj) ? LPORT_TX_OWNER : 0;
+        else if (!strncmp(key, JCFG_LPORT_XDP_METADATA_NAME, keylen))
+            lport->flags |= json_object_get_boolean(obj) ? LPORT_XDP_METADATA : 0;
         else if (!strncmp(key, JCFG_LPORT_BUSY_POLL_NAME, keylen) ||
                  !strncmp(key, JCFG_LPORT_BUSY_POLLING_NAME, keylen))
             lport->flags |= json_object_get_boolean(obj) ? LPORT_BUSY_POLLING : 0;
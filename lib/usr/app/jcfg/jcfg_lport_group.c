@@ -202,42 +202,61 @@ free_lport_group_obj(jcfg_lport_group_t *lpg)
     }
 }
 
-static int
-setup_lport(jcfg_data_t *data, jcfg_lport_group_t *lpg, const char *netdev, uint16_t qid,
-            jcfg_thd_t *thd)
+/* Assign queue index qidx of the lport to the thread */
+static void
+assign_lport(jcfg_thd_t *thd, jcfg_lport_t *lport, uint16_t qidx)
+{
+    thd->lport_names[thd->lport_cnt] = strdup(lport->name);
+    thd->lports[thd->lport_cnt]      = lport;
+    thd->lport_qids[thd->lport_cnt]  = qidx;
+    thd->lport_cnt++;
+}
+
+static jcfg_lport_t *
+create_lport(jcfg_data_t *data, jcfg_lport_group_t *lpg, const char *netdev, uint16_t qid,
+             uint16_t nb_queues)
 {
     char name[CNE_NAME_LEN];
     jcfg_lport_t *lport;
+    uint16_t last = qid + nb_queues - 1;
     int ret;
 
-    ret = snprintf(name, sizeof(name), "%s:%u", netdev, qid);
+    if (nb_queues > 1)
+        ret = snprintf(name, sizeof(name), "%s:%u-%u", netdev, qid, last);
+    else
+        ret = snprintf(name, sizeof(name), "%s:%u", netdev, qid);
     if (ret < 3 || (size_t)ret >= sizeof(name))
-        CNE_ERR_RET("Cannot configure name for netdev '%s' queue %u\n", netdev, qid);
+        CNE_NULL_RET("Cannot configure name for netdev '%s' queue %u\n", netdev, qid);
 
-    /* Make sure a logical port with this name or netdev:qid does not already exist */
+    /* Make sure a logical port with this name or any of its netdev queues does not exist */
     STAILQ_FOREACH (lport, &data->lports, next) {
+        uint16_t lport_last = lport->qid + (lport->nb_queues ? lport->nb_queues : 1) - 1;
+
         if (!strncmp(lport->name, name, CNE_NAME_LEN))
-            CNE_ERR_RET("Logical port '%s' is already configured\n", name);
+            CNE_NULL_RET("Logical port '%s' is already configured\n", name);
 
-        if (!strncmp(lport->netdev, netdev, JCFG_MAX_STRING_SIZE) && lport->qid == qid)
-            CNE_ERR_RET("Netdev '%s' queue %u is already configured\n", netdev, qid);
+        if (!strncmp(lport->netdev, netdev, JCFG_MAX_STRING_SIZE) && lport->qid <= last &&
+            qid <= lport_last)
+            CNE_NULL_RET("Netdev '%s' queue %u is already configured\n", netdev,
+                         CNE_MAX(qid, lport->qid));
     }
 
     lport = calloc(1, sizeof(*lport));
     if (!lport)
-        CNE_ERR_RET("Out of memory\n");
+        CNE_NULL_RET("Out of memory\n");
 
     ret = jcfg_list_add(&data->lport_list, lport);
     if (ret < 0) {
         free(lport);
-        CNE_ERR_RET("Out of memory\n");
+        CNE_NULL_RET("Out of memory\n");
     }
     lport->lpid = ret;
 
-    lport->cbtype = JCFG_LPORT_TYPE;
-    lport->qid    = qid;
-    lport->netdev = strdup(netdev);
-    lport->name   = strdup(name);
+    lport->cbtype    = JCFG_LPORT_TYPE;
+    lport->qid       = qid;
+    lport->nb_queues = nb_queues;
+    lport->netdev    = strdup(netdev);
+    lport->name      = strdup(name);
 
     if (lpg->pmd_name)
         lport->pmd_name = strdup(lpg->pmd_name);
@@ -256,10 +275,21 @@ setup_lport(jcfg_data_t *data, jcfg_lport_group_t *lpg, const char *netdev, uint
     STAILQ_INSERT_TAIL(&data->lports, lport, next);
     data->lport_count++;
 
+    return lport;
+}
+
+static int
+setup_lport(jcfg_data_t *data, jcfg_lport_group_t *lpg, const char *netdev, uint16_t qid,
+            jcfg_thd_t *thd)
+{
+    jcfg_lport_t *lport;
+
+    lport = create_lport(data, lpg, netdev, qid, 1);
+    if (!lport)
+        return -1;
+
     /* Assign the lport to the thread */
-    thd->lport_names[thd->lport_cnt] = strdup(name);
-    thd->lports[thd->lport_cnt]      = lport;
-    thd->lport_cnt++;
+    assign_lport(thd, lport, 0);
     return 0;
 }
 
@@ -320,6 +350,52 @@ setup_lports_without_qlist(jcfg_info_t *jinfo, jcfg_data_t *data, jcfg_lport_gro
     return 0;
 }
 
+/*
+ * Create one multi-queue lport per netdev and spread its queues across the threads
+ */
+static int
+setup_lports_multi_queue(jcfg_info_t *jinfo, jcfg_data_t *data, jcfg_lport_group_t *lpg)
+{
+    struct queue_list *qlist = (struct queue_list *)lpg->qlist;
+    uint16_t count           = 0;
+    int i;
+
+    /* A multi-queue lport owns a contiguous range of queue IDs */
+    if (qlist && (qlist->max - qlist->min + 1) != qlist->num)
+        CNE_ERR_RET("lport group '%s' queues must be contiguous for %s\n", lpg->name,
+                    JCFG_LPORT_GROUP_MULTI_QUEUE_NAME);
+
+    for (i = 0; i < lpg->num_netdev_names; i++) {
+        char *netdev       = lpg->netdev_names[i];
+        uint16_t first     = qlist ? qlist->min : 0;
+        uint16_t nb_queues = qlist ? qlist->num : lpg->max_q[i];
+        jcfg_lport_t *lport;
+
+        if (nb_queues > LPORT_MAX_QUEUES)
+            CNE_ERR_RET("Netdev '%s' has %u queues, a multi-queue lport supports %u\n", netdev,
+                        nb_queues, LPORT_MAX_QUEUES);
+
+        lport = create_lport(data, lpg, netdev, first, nb_queues);
+        if (!lport)
+            return -1;
+
+        for (uint16_t q = 0; q < nb_queues; q++) {
+            char *thread_name = lpg->thread_names[count % lpg->num_thread_names];
+            jcfg_thd_t *thd   = jcfg_lookup_thread(jinfo, thread_name);
+
+            if (!thd)
+                CNE_ERR_RET("Thread '%s' not found\n", thread_name);
+
+            assign_lport(thd, lport, q);
+            count++;
+        }
+    }
+
+    if (count != lpg->total_q)
+        CNE_ERR_RET("Assigned %d queues but expected %d\n", count, lpg->total_q);
+    return 0;
+}
+
 /*
  * Configure total number of queues based on each netdev's maximum
  *
@@ -421,12 +497,19 @@ jcfg_decode_one_lport_group_end(jcfg_info_t *jinfo, jcfg_data_t *data, jcfg_lpor
             if (!p)
                 CNE_ERR_RET("Out of memory\n");
             thd->lports = p;
+
+            p = realloc(thd->lport_qids, (thd->lport_sz + qs_to_add) * sizeof(*thd->lport_qids));
+            if (!p)
+                CNE_ERR_RET("Out of memory\n");
+            thd->lport_qids = p;
             thd->lport_sz += qs_to_add;
         }
     }
 
     /* create lport(s) and assign to thread(s) */
-    if (lpg->qlist)
+    if (lpg->multi_queue)
+        return setup_lports_multi_queue(jinfo, data, lpg);
+    else if (lpg->qlist)
         return setup_lports_with_qlist(jinfo, data, lpg);
     else
         return setup_lports_without_qlist(jinfo, data, lpg);
@@ -448,10 +531,10 @@ setup_common_umem(jcfg_info_t *jinfo, jcfg_data_t *data)
     if (jcfg_lookup_umem(jinfo, LPORT_GROUP_UMEM_NAME))
         return 0;
 
-    /* Count total lports using the common umem */
+    /* Count total lport queues using the common umem, each queue needs its own buffers */
     STAILQ_FOREACH (lport, &data->lports, next)
         if (!strncmp(lport->umem_name, LPORT_GROUP_UMEM_NAME, JCFG_MAX_STRING_SIZE))
-            total_lport++;
+            total_lport += (lport->nb_queues) ? lport->nb_queues : 1;
 
     if (!total_lport)
         return 0;
@@ -752,6 +835,14 @@ _lport_group(struct json_object *obj, int flags, struct json_object *parent __cn
         lpg->flags |= json_object_get_boolean(obj) ? LPORT_FORCE_WAKEUP : 0;
     else if (!strncmp(key, JCFG_LPORT_SKB_MODE_NAME, keylen))
         lpg->flags |= json_object_get_boolean(obj) ? LPORT_SKB_MODE : 0;
+    else if (!strncmp(key, JCFG_LPORT_MULTI_BUFFER_NAME, keylen))
+        lpg->flags |= json_object_get_boolean(obj) ? LPORT_MULTI_BUFFER : 0;
+    else if (!strncmp(key, JCFG_LPORT_TX_OWNER_NAME, keylen))
+        lpg->flags |= json_object_get_boolean(obj) ? LPORT_TX_OWNER : 0;
+    else if (!strncmp(key, JCFG_LPORT_XDP_METADATA_NAME, keylen))
+        lpg->flags |= json_object_get_boolean(obj) ? LPORT_XDP_METADATA : 0;
+    else if (!strncmp(key, JCFG_LPORT_GROUP_MULTI_QUEUE_NAME, keylen))
+        lpg->multi_queue = json_object_get_boolean(obj) ? 1 : 0;
     else if (!strncmp(key, JCFG_LPORT_BUSY_POLL_NAME, keylen) ||
              !strncmp(key, JCFG_LPORT_BUSY_POLLING_NAME, keylen))
         lpg->flags |= json_object_get_boolean(obj) ? LPORT_BUSY_POLLING : 0;
@@ -69,6 +69,18 @@ __print_umem(jcfg_hdr_t *hdr, obj_value_t *val __cne_unused)
     cne_printf(" [green]type[]: [magenta]%s[] [green]rxdesc[]: [magenta]%u[] [green]txdesc[]: "
                "[magenta]%u[]\n",
                mmap_name_by_type(u->mtype), u->rxdesc, u->txdesc);
+    if (u->mm) {
+        uint64_t remote;
+        int node = mmap_numa_node(u->mm, &remote);
+
+        cne_printf("                  [green]numa[]: [magenta]%d[] [green]remote pages[]: "
+                   "[magenta]%lu[]\n",
+                   node, remote);
+    }
+    if (u->cache_sz)
+        cne_printf("                  [green]cache[]: [magenta]%u[] [green]low[]: [magenta]%u[] "
+                   "[green]high[]: [magenta]%u[]\n",
+                   u->cache_sz, u->cache_low_wm, u->cache_high_wm);
     cne_printf("                  [green]regions[]: [magenta]%u[] [ ", u->region_cnt);
     for (int i = 0; i < u->region_cnt; i++)
         cne_printf("[magenta]%u[] ", u->rinfo[i].bufcnt);
@@ -82,10 +94,11 @@ __print_lport(jcfg_hdr_t *hdr, obj_value_t *val __cne_unused)
 
     cne_printf("   '[cyan]%-12s[]' [green]netdev[]: [magenta]%s[] [green]pmd[]: "
                "[magenta]%s[] [green]lport[]: [magenta]%d[] [green]qid[]: [magenta]%d[] "
-               "[green]region[]: [magenta]%d[] "
+               "[green]queues[]: [magenta]%d[] [green]region[]: [magenta]%d[] "
                "[green]umem[]: [magenta]%s[] ([yellow]%s[])\n",
                lport->name, lport->netdev, lport->pmd_name, lport->lpid, lport->qid,
-               lport->region_idx, lport->umem_name, lport->desc);
+               lport->nb_queues ? lport->nb_queues : 1, lport->region_idx, lport->umem_name,
+               lport->desc);
 }
 
 void
@@ -110,8 +123,12 @@ __print_thread(jcfg_hdr_t *hdr, obj_value_t *val __cne_unused)
                "'[yellow]%-10s[]' [green]lports[]: [ ",
                thd->name, thd->group_name, thd->thread_type ? thd->thread_type : "");
 
-    for (int i = 0; i < thd->lport_cnt; i++)
-        cne_printf("'[magenta]%s[]' ", thd->lport_names[i]);
+    for (int i = 0; i < thd->lport_cnt; i++) {
+        if (thd->lports && thd->lports[i] && thd->lports[i]->nb_queues > 1)
+            cne_printf("'[magenta]%s[]'/[magenta]%u[] ", thd->lport_names[i], thd->lport_qids[i]);
+        else
+            cne_printf("'[magenta]%s[]' ", thd->lport_names[i]);
+    }
 
     cne_printf("] ([yellow]%s[])\n", thd->desc);
 }
@@ -82,7 +82,8 @@ _thd(struct json_object *obj, int flags, struct json_object *parent __cne_unused
                 }
                 thd->lport_names[thd->lport_cnt++] = strdup(json_object_get_string(val));
             }
-            thd->lports = calloc(thd->lport_sz, sizeof(void *));
+            thd->lports     = calloc(thd->lport_sz, sizeof(void *));
+            thd->lport_qids = calloc(thd->lport_sz, sizeof(uint16_t));
         }
     } else
         ret = JSON_C_VISIT_RETURN_ERROR;
@@ -6,6 +6,7 @@
 
 #include <string.h>                    // for strcmp, strdup, strlen
 #include <cne_mmap.h>                  // for mmap_type_by_name, mmap_name_by_type
+#include <cne_system.h>                // for cne_device_numa_node
 #include <json-c/json_object.h>        // for json_object_get_int, json_object_get...
 #include <json-c/json_visit.h>         // for json_c_visit, JSON_C_VISIT_RETURN_CO...
 #include <stdint.h>                    // for uint32_t
@@ -34,6 +35,38 @@ jcfg_umem_by_index(jcfg_info_t *jinfo, int idx)
     return (jcfg_umem_t *)((idx < lst->cnt) ? lst->list[idx] : NULL);
 }
 
+int
+jcfg_umem_numa_node(jcfg_info_t *jinfo, jcfg_umem_t *umem)
+{
+    struct jcfg *cfg;
+    jcfg_lport_t *lport;
+    int node = MMAP_NUMA_NODE_ANY;
+
+    if (!jinfo || !(cfg = jinfo->cfg) || !umem)
+        return MMAP_NUMA_NODE_ANY;
+
+    if (umem->numa_node >= 0)
+        return umem->numa_node;
+
+    /* Follow the netdevs of the UMEM, a UMEM shared across nodes stays on the first one */
+    STAILQ_FOREACH (lport, &cfg->data.lports, next) {
+        int n;
+
+        if (lport->umem != umem || (n = cne_device_numa_node(lport->netdev)) < 0)
+            continue;
+
+        if (node == MMAP_NUMA_NODE_ANY)
+            node = n;
+        else if (n != node) {
+            CNE_WARN("UMEM '%s' is used by netdevs on NUMA nodes %d and %d, using node %d\n",
+                     umem->name, node, n, node);
+            break;
+        }
+    }
+
+    return node;
+}
+
 static int
 _umem(struct json_object *obj, int flags, struct json_object *parent __cne_unused,
       const char *key __cne_unused, size_t *index __cne_unused, void *arg)
@@ -81,6 +114,14 @@ _umem(struct json_object *obj, int flags, struct json_object *parent __cne_unuse
                 umem->mtype = mmap_type_by_name(str);
         } else if (!strcmp(key, "shared_umem"))
             umem->shared_umem = json_object_get_boolean(obj) ? 1 : 0;
+        else if (!strcmp(key, "cache_sz"))
+            umem->cache_sz = json_object_get_int(obj);
+        else if (!strcmp(key, "cache_low"))
+            umem->cache_low_wm = json_object_get_int(obj);
+        else if (!strcmp(key, "cache_high"))
+            umem->cache_high_wm = json_object_get_int(obj);
+        else if (!strcmp(key, "numa"))
+            umem->numa_node = json_object_get_int(obj);
     }
 
     return JSON_C_VISIT_RETURN_CONTINUE;
@@ -110,8 +151,9 @@ _umem_obj(struct json_object *obj, int flags, struct json_object *parent __cne_u
             int idx;
             char *v;
 
-            umem->cbtype = JCFG_UMEM_TYPE;
-            umem->name   = strdup(key);
+            umem->cbtype    = JCFG_UMEM_TYPE;
+            umem->name      = strdup(key);
+            umem->numa_node = MMAP_NUMA_NODE_ANY;
             idx          = jcfg_list_add(&data->umem_list, umem);
             if (idx < 0)
                 CNE_ERR_RET("Failed to add UMEM object to list\n");
@@ -253,6 +253,17 @@ cne_acl_reset(struct cne_acl_ctx *ctx)
     }
 }
 
+/*
+ * Return the memory used by the ACL context, its rules and RT structures.
+ */
+size_t
+cne_acl_mem_size(const struct cne_acl_ctx *ctx)
+{
+    if (!ctx)
+        return 0;
+    return sizeof(*ctx) + (size_t)ctx->max_rules * ctx->rule_sz + ctx->mem_sz;
+}
+
 /*
  * Dump ACL context to the stdout.
  */
@@ -268,4 +279,5 @@ cne_acl_dump(const struct cne_acl_ctx *ctx)
     cne_printf("  num_rules=%" PRIu32 "\n", ctx->num_rules);
     cne_printf("  num_categories=%" PRIu32 "\n", ctx->num_categories);
     cne_printf("  num_tries=%" PRIu32 "\n", ctx->num_tries);
+    cne_printf("  mem_size=%zu\n", cne_acl_mem_size(ctx));
 }
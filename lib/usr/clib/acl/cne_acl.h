@@ -323,6 +323,16 @@ extern int cne_acl_classify_alg(const struct cne_acl_ctx *ctx, const uint8_t **d
  */
 extern int cne_acl_set_ctx_classify(struct cne_acl_ctx *ctx, enum cne_acl_classify_alg alg);
 
+/**
+ * Get the amount of memory used by an ACL context.
+ *
+ * @param ctx
+ *   ACL context.
+ * @return
+ *   Bytes allocated for the context, its rules and its run-time structures, 0 if ctx is NULL.
+ */
+size_t cne_acl_mem_size(const struct cne_acl_ctx *ctx);
+
 /**
  * Dump an ACL context structure to the console.
  *
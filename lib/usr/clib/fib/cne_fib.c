@@ -9,8 +9,8 @@
 #include <cne_rib.h>           // for cne_rib_free, cne_rib_conf, cne_rib_create
 #include <cne_fib.h>
 #include <bsd/string.h>        // for strlcpy
-#include <errno.h>             // for EINVAL, ENOENT
-#include <stdlib.h>            // for NULL, free, calloc
+#include <errno.h>             // for EINVAL, ENOENT, ENOTSUP, ENOMEM
+#include <stdlib.h>            // for NULL, free, calloc, qsort
 
 #include "dir24_8.h"        // for dir24_8_get_lookup_fn, dir24_8_create, dir24...
 
@@ -108,10 +108,178 @@ cne_fib_delete(struct cne_fib *fib, uint32_t ip, uint8_t depth)
     return fib->modify(fib, ip, depth, 0, CNE_FIB_DEL);
 }
 
+/* A batch entry, seq keeps the order of the changes to a prefix after sorting */
+struct fib_bulk_ent {
+    struct cne_fib_route r;
+    unsigned int seq;
+};
+
+/* The state of a prefix before the batch, to undo a failed batch */
+struct fib_undo_ent {
+    uint32_t ip;
+    uint8_t depth;
+    uint8_t existed;
+    uint64_t nh;
+};
+
+static int
+bulk_ent_cmp(const void *a, const void *b)
+{
+    const struct fib_bulk_ent *e1 = a, *e2 = b;
+
+    if (e1->r.ip != e2->r.ip)
+        return (e1->r.ip < e2->r.ip) ? -1 : 1;
+    if (e1->r.depth != e2->r.depth)
+        return (e1->r.depth < e2->r.depth) ? -1 : 1;
+    return (e1->seq < e2->seq) ? -1 : (e1->seq > e2->seq);
+}
+
+static void
+rib_undo(struct cne_rib *rib, struct fib_undo_ent *undo, unsigned int n)
+{
+    struct cne_rib_node *node;
+
+    while (n-- > 0) {
+        if (!undo[n].existed) {
+            cne_rib_remove(rib, undo[n].ip, undo[n].depth);
+            continue;
+        }
+        node = cne_rib_lookup_exact(rib, undo[n].ip, undo[n].depth);
+        if (node == NULL)
+            node = cne_rib_insert(rib, undo[n].ip, undo[n].depth);
+        if (node == NULL)
+            CNE_ERR("Failed to restore route %08x/%u\n", undo[n].ip, undo[n].depth);
+        else
+            cne_rib_set_nh(node, undo[n].nh);
+    }
+}
+
+/* Rebuild the dataplane from the RIB and publish it to the lookups */
+static int
+update_dataplane(struct cne_fib *fib)
+{
+    struct dir24_8_tbl *dp;
+    void *old;
+    int ret;
+
+    switch (fib->type) {
+    case CNE_FIB_DUMMY:
+        return 0;
+    case CNE_FIB_DIR24_8:
+        ret = dir24_8_build(fib->dp, fib->rib, &dp);
+        if (ret < 0)
+            return ret;
+        old = fib->dp;
+        __atomic_store_n(&fib->dp, dp, __ATOMIC_RELEASE);
+
+        /* The batch is in use now, it can not be undone if the RCU config is not moved */
+        ret = dir24_8_retire(old, dp, fib->name);
+        if (ret < 0)
+            CNE_ERR("FIB %s RCU config not applied to the new tables: %d\n", fib->name, ret);
+        return 0;
+    default:
+        return -ENOTSUP;
+    }
+}
+
+int
+cne_fib_update_bulk(struct cne_fib *fib, const struct cne_fib_route *routes, unsigned int n)
+{
+    struct fib_bulk_ent *ents;
+    struct fib_undo_ent *undo;
+    struct cne_rib_node *node;
+    unsigned int i, j, nundo = 0;
+    uint64_t nh, old_nh;
+    int existed, exists, ret = 0;
+
+    if ((fib == NULL) || ((routes == NULL) && (n != 0)))
+        return -EINVAL;
+    if (n == 0)
+        return 0;
+
+    /* Without a RCU variable the old tables can not be freed safely after the swap */
+    if ((fib->type == CNE_FIB_DIR24_8) && (((struct dir24_8_tbl *)fib->dp)->v == NULL))
+        return -ENOTSUP;
+
+    ents = calloc(n, sizeof(*ents));
+    undo = calloc(n, sizeof(*undo));
+    if ((ents == NULL) || (undo == NULL)) {
+        ret = -ENOMEM;
+        goto exit;
+    }
+
+    for (i = 0; i < n; i++) {
+        if ((routes[i].depth > CNE_FIB_MAXDEPTH) ||
+            ((routes[i].op != CNE_FIB_ADD) && (routes[i].op != CNE_FIB_DEL))) {
+            ret = -EINVAL;
+            goto exit;
+        }
+        ents[i].r = routes[i];
+        ents[i].r.ip &= cne_rib_depth_to_mask(routes[i].depth);
+        ents[i].seq = i;
+    }
+    qsort(ents, n, sizeof(*ents), bulk_ent_cmp);
+
+    /* Reduce the changes to each prefix to its final state and apply it to the RIB */
+    for (i = 0; i < n; i = j) {
+        node    = cne_rib_lookup_exact(fib->rib, ents[i].r.ip, ents[i].r.depth);
+        existed = (node != NULL);
+        old_nh  = 0;
+        if (existed)
+            cne_rib_get_nh(node, &old_nh);
+        exists = existed;
+        nh     = old_nh;
+
+        for (j = i; (j < n) && (ents[j].r.ip == ents[i].r.ip) &&
+                    (ents[j].r.depth == ents[i].r.depth);
+             j++) {
+            if (ents[j].r.op == CNE_FIB_ADD) {
+                exists = 1;
+                nh     = ents[j].r.next_hop;
+            } else if (!exists) {
+                ret = -ENOENT;
+                goto undo;
+            } else
+                exists = 0;
+        }
+        if ((exists == existed) && (!exists || (nh == old_nh)))
+            continue;
+
+        undo[nundo++] = (struct fib_undo_ent){ents[i].r.ip, ents[i].r.depth, existed, old_nh};
+        if (!exists) {
+            cne_rib_remove(fib->rib, ents[i].r.ip, ents[i].r.depth);
+            continue;
+        }
+        if (node == NULL)
+            node = cne_rib_insert(fib->rib, ents[i].r.ip, ents[i].r.depth);
+        if (node == NULL) {
+            ret = -ENOMEM;
+            goto undo;
+        }
+        cne_rib_set_nh(node, nh);
+    }
+
+    if (nundo != 0) {
+        ret = update_dataplane(fib);
+        if (ret < 0)
+            goto undo;
+    }
+    goto exit;
+
+undo:
+    rib_undo(fib->rib, undo, nundo);
+exit:
+    free(undo);
+    free(ents);
+
+    return ret;
+}
+
 int
 cne_fib_lookup_bulk(struct cne_fib *fib, uint32_t *ips, uint64_t *next_hops, int n)
 {
-    fib->lookup(fib->dp, ips, next_hops, n);
+    /* Pairs with the store of a rebuilt dataplane in update_dataplane() */
+    fib->lookup(__atomic_load_n(&fib->dp, __ATOMIC_ACQUIRE), ips, next_hops, n);
     return 0;
 }
 
@@ -218,3 +386,20 @@ cne_fib_select_lookup(struct cne_fib *fib, enum cne_fib_lookup_type type)
         return -EINVAL;
     }
 }
+
+int
+cne_fib_rcu_qsbr_add(struct cne_fib *fib, struct cne_fib_rcu_config *cfg)
+{
+    if ((fib == NULL) || (cfg == NULL))
+        return -EINVAL;
+
+    switch (fib->type) {
+    case CNE_FIB_DUMMY:
+        /* Lookups walk the RIB directly, defer freeing of its nodes */
+        return cne_rib_rcu_qsbr_add(fib->rib, cfg->v);
+    case CNE_FIB_DIR24_8:
+        return dir24_8_rcu_qsbr_add(fib->dp, cfg, fib->name);
+    default:
+        return -ENOTSUP;
+    }
+}
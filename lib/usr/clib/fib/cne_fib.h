@@ -26,6 +26,7 @@ extern "C" {
 
 struct cne_fib;
 struct cne_rib;
+struct cne_rcu_qsbr;
 
 /** Maximum depth value possible for IPv4 FIB. */
 #define CNE_FIB_MAXDEPTH 32
@@ -68,8 +69,9 @@ enum cne_fib_lookup_type {
     CNE_FIB_LOOKUP_DIR24_8_SCALAR_UNI,    /**< Unified lookup function for all next hop sizes */
     CNE_FIB_LOOKUP_DIR24_8_VECTOR_AVX512, /**< Vector implementation using AVX512 */
     CNE_FIB_LOOKUP_TRIE_SCALAR,           /**< Scalar lookup function implementation*/
-    CNE_FIB_LOOKUP_TRIE_VECTOR_AVX512     /**< Vector implementation using AVX512 */
-
+    CNE_FIB_LOOKUP_TRIE_VECTOR_AVX512,    /**< Vector implementation using AVX512 */
+    CNE_FIB_LOOKUP_DIR24_8_VECTOR_AVX2    /**< Vector implementation using AVX2, 1 to 4 byte
+                                             next hops */
 };
 
 /** FIB configuration structure */
@@ -90,6 +92,29 @@ struct cne_fib_conf {
     };
 };
 
+/** FIB RCU QSBR reclamation modes */
+enum cne_fib_qsbr_mode {
+    CNE_FIB_QSBR_MODE_DQ = 0, /**< Create defer queue for reclaim */
+    CNE_FIB_QSBR_MODE_SYNC    /**< Use blocking mode reclaim, no defer queue created */
+};
+
+/** FIB RCU QSBR configuration structure */
+struct cne_fib_rcu_config {
+    struct cne_rcu_qsbr *v;      /**< RCU QSBR variable */
+    enum cne_fib_qsbr_mode mode; /**< Mode of RCU QSBR, CNE_FIB_QSBR_MODE_xxx */
+    uint32_t dq_size;            /**< Defer queue size, zero uses the number of tbl8s */
+    uint32_t reclaim_thd;        /**< Threshold to trigger auto reclaim */
+    uint32_t reclaim_max;        /**< Max entries to reclaim in one go, zero uses default */
+};
+
+/** One route change of a batch given to cne_fib_update_bulk() */
+struct cne_fib_route {
+    uint32_t ip;       /**< IPv4 prefix address */
+    uint8_t depth;     /**< Prefix length */
+    uint8_t op;        /**< CNE_FIB_ADD or CNE_FIB_DEL */
+    uint64_t next_hop; /**< Next hop of an added route, unused for a delete */
+};
+
 /**
  * Create a FIB structure using the configuration specified.
  *
@@ -142,6 +167,34 @@ int cne_fib_add(struct cne_fib *fib, uint32_t ip, uint8_t depth, uint64_t next_h
  */
 int cne_fib_delete(struct cne_fib *fib, uint32_t ip, uint8_t depth);
 
+/**
+ * Apply a batch of route adds and deletes to the FIB as one transaction.
+ *
+ * The batch gives the same routes as applying its entries one at a time in order, but the
+ * changes to a prefix are coalesced and the DIR24_8 tables are built once from the updated
+ * RIB. The new tables are swapped in with a single pointer store, lookups see either all or
+ * none of the batch. A DIR24_8 FIB must have a RCU config added with cne_fib_rcu_qsbr_add(),
+ * the old tables are freed after a RCU QSBR synchronize on it. Building needs memory for a
+ * second copy of the tables.
+ *
+ * A DUMMY FIB looks up the RIB itself and sees the batch one prefix at a time.
+ *
+ * If any entry fails, e.g. the delete of a missing route or a next hop too large for the
+ * FIB, none of the batch is applied. Updates must not run concurrently with other updates.
+ *
+ * @param fib
+ *   FIB object handle
+ * @param routes
+ *   Array of route changes
+ * @param n
+ *   Number of entries in routes
+ * @return
+ *   0 on success, -EINVAL for incorrect arguments, -ENOTSUP for a DIR24_8 FIB without a
+ *   RCU config, -ENOENT for a missing deleted route, -ENOSPC if the tbl8 groups run out,
+ *   -ENOMEM otherwise
+ */
+int cne_fib_update_bulk(struct cne_fib *fib, const struct cne_fib_route *routes, unsigned int n);
+
 /**
  * Lookup multiple IP addresses in the FIB.
  *
@@ -196,6 +249,27 @@ struct cne_rib *cne_fib_get_rib(struct cne_fib *fib);
  */
 int cne_fib_select_lookup(struct cne_fib *fib, enum cne_fib_lookup_type type);
 
+/**
+ * Associate a RCU QSBR variable with the FIB.
+ *
+ * When a route delete empties a tbl8 group, the group is no longer cleared and
+ * returned to the free pool right away, as a lookup thread could still be
+ * reading it. Instead it is reclaimed once the reader threads registered with
+ * the QSBR variable have reported a quiescent state, so the control thread never
+ * has to stop the forwarding threads to update the table.
+ * For CNE_FIB_DUMMY the lookups walk the RIB, so its nodes are deferred instead.
+ *
+ * @param fib
+ *   FIB object handle
+ * @param cfg
+ *   RCU QSBR configuration
+ * @return
+ *   0 on success
+ *   -EINVAL for invalid arguments, -EEXIST if already added,
+ *   -ENOMEM on allocation failure or -ENOTSUP if the FIB type has no tbl8 groups
+ */
+int cne_fib_rcu_qsbr_add(struct cne_fib *fib, struct cne_fib_rcu_config *cfg);
+
 #ifdef __cplusplus
 }
 #endif
@@ -10,7 +10,7 @@
 #include "private_fib6.h"        // for IPV6_ADDR_LEN, CNE_FIB6_TRIE
 #include <cne_fib6.h>
 #include <bsd/string.h>        // for strlcpy
-#include <errno.h>             // for EINVAL, ENOENT
+#include <errno.h>             // for EINVAL, ENOENT, ENOTSUP
 #include <stdio.h>             // for NULL, snprintf
 #include <stdlib.h>            // for free, calloc
 
@@ -220,3 +220,20 @@ cne_fib6_select_lookup(struct cne_fib6 *fib, enum cne_fib_lookup_type type)
         return -EINVAL;
     }
 }
+
+int
+cne_fib6_rcu_qsbr_add(struct cne_fib6 *fib, struct cne_fib_rcu_config *cfg)
+{
+    if ((fib == NULL) || (cfg == NULL))
+        return -EINVAL;
+
+    switch (fib->type) {
+    case CNE_FIB_DUMMY:
+        /* Lookups walk the RIB directly, defer freeing of its nodes */
+        return cne_rib6_rcu_qsbr_add(fib->rib, cfg->v);
+    case CNE_FIB_TRIE:
+        return trie_rcu_qsbr_add(fib->dp, cfg, fib->name);
+    default:
+        return -ENOTSUP;
+    }
+}
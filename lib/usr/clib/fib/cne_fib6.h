@@ -137,6 +137,20 @@ struct cne_rib6 *cne_fib6_get_rib(struct cne_fib6 *fib);
  */
 int cne_fib6_select_lookup(struct cne_fib6 *fib, enum cne_fib_lookup_type type);
 
+/**
+ * Associate a RCU QSBR variable with the FIB, see cne_fib_rcu_qsbr_add().
+ *
+ * @param fib
+ *   FIB object handle
+ * @param cfg
+ *   RCU QSBR configuration
+ * @return
+ *   0 on success
+ *   -EINVAL for invalid arguments, -EEXIST if already added,
+ *   -ENOMEM on allocation failure or -ENOTSUP if the FIB type has no tbl8 groups
+ */
+int cne_fib6_rcu_qsbr_add(struct cne_fib6 *fib, struct cne_fib_rcu_config *cfg);
+
 #ifdef __cplusplus
 }
 #endif
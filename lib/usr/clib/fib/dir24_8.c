@@ -5,11 +5,15 @@
 
 #include <stdint.h>         // for uint64_t, uint32_t, uint8_t, uint16_t, UINT64_MAX
 #include <stdlib.h>         // for free, calloc
-#include <stdio.h>          // for NULL
+#include <stdio.h>          // for NULL, snprintf
 #include <cne_log.h>        // for CNE_ASSERT
 #include <cne_rib.h>        // for cne_rib_get_nh, cne_rib_get_nxt, cne_rib_depth_...
 #include <cne_fib.h>        // for cne_fib_conf, cne_fib_conf::(anonymous union)::...
 #include <errno.h>          // for ENOSPC, EINVAL, ENOENT
+#include <string.h>         // for memset
+#include <cne_rcu_qsbr.h>   // for cne_rcu_qsbr_dq_enqueue, cne_rcu_qsbr_dq_reclaim
+#include <cne_cpuflags.h>   // for cne_cpu_get_flag_enabled, CNE_CPUFLAG_AVX2
+#include <cne_vect.h>       // for cne_vect_get_max_simd_bitwidth, CNE_VECT_SIMD_256
 
 #include "dir24_8.h"
 
@@ -22,8 +26,17 @@ struct cne_rib;
 
 #endif /* CC_DIR24_8_AVX512_SUPPORT */
 
+#ifdef CC_DIR24_8_AVX2_SUPPORT
+
+#include "dir24_8_avx2.h"
+
+#endif /* CC_DIR24_8_AVX2_SUPPORT */
+
 #define DIR24_8_NAMESIZE 64
 
+/* Default number of tbl8 groups reclaimed from the defer queue in one call */
+#define DIR24_8_RCU_DQ_RECLAIM_MAX 16
+
 #define ROUNDUP(x, y) CNE_ALIGN_CEIL(x, (1 << (32 - y)))
 
 static inline cne_fib_lookup_fn_t
@@ -61,7 +74,7 @@ get_scalar_fn_inlined(enum cne_fib_dir24_8_nh_sz nh_sz)
 }
 
 static inline cne_fib_lookup_fn_t
-get_vector_fn(enum cne_fib_dir24_8_nh_sz nh_sz)
+get_avx512_fn(enum cne_fib_dir24_8_nh_sz nh_sz)
 {
 #ifdef CC_DIR24_8_AVX512_SUPPORT
     if ((cne_cpu_get_flag_enabled(CNE_CPUFLAG_AVX512F) <= 0) ||
@@ -86,6 +99,40 @@ get_vector_fn(enum cne_fib_dir24_8_nh_sz nh_sz)
     return NULL;
 }
 
+static inline cne_fib_lookup_fn_t
+get_avx2_fn(enum cne_fib_dir24_8_nh_sz nh_sz)
+{
+#ifdef CC_DIR24_8_AVX2_SUPPORT
+    if ((cne_cpu_get_flag_enabled(CNE_CPUFLAG_AVX2) <= 0) ||
+        (cne_vect_get_max_simd_bitwidth() < CNE_VECT_SIMD_256))
+        return NULL;
+
+    switch (nh_sz) {
+    case CNE_FIB_DIR24_8_1B:
+        return cne_dir24_8_avx2_lookup_bulk_1b;
+    case CNE_FIB_DIR24_8_2B:
+        return cne_dir24_8_avx2_lookup_bulk_2b;
+    case CNE_FIB_DIR24_8_4B:
+        return cne_dir24_8_avx2_lookup_bulk_4b;
+    default:
+        /* 4 lane 64 bit gathers are no faster than the scalar lookup */
+        return NULL;
+    }
+#else
+    CNE_SET_USED(nh_sz);
+#endif
+    return NULL;
+}
+
+/* The widest vector implementation allowed by the CPU and the max SIMD bitwidth */
+static inline cne_fib_lookup_fn_t
+get_vector_fn(enum cne_fib_dir24_8_nh_sz nh_sz)
+{
+    cne_fib_lookup_fn_t ret_fn = get_avx512_fn(nh_sz);
+
+    return (ret_fn != NULL) ? ret_fn : get_avx2_fn(nh_sz);
+}
+
 cne_fib_lookup_fn_t
 dir24_8_get_lookup_fn(void *p, enum cne_fib_lookup_type type)
 {
@@ -106,7 +153,9 @@ dir24_8_get_lookup_fn(void *p, enum cne_fib_lookup_type type)
     case CNE_FIB_LOOKUP_DIR24_8_SCALAR_UNI:
         return dir24_8_lookup_bulk_uni;
     case CNE_FIB_LOOKUP_DIR24_8_VECTOR_AVX512:
-        return get_vector_fn(nh_sz);
+        return get_avx512_fn(nh_sz);
+    case CNE_FIB_LOOKUP_DIR24_8_VECTOR_AVX2:
+        return get_avx2_fn(nh_sz);
     case CNE_FIB_LOOKUP_DEFAULT:
         ret_fn = get_vector_fn(nh_sz);
         return (ret_fn != NULL) ? ret_fn : get_scalar_fn(nh_sz);
@@ -151,7 +200,9 @@ tbl8_get_idx(struct dir24_8_tbl *dp)
 {
     uint32_t i;
     int bit_idx;
+    bool reclaimed = false;
 
+again:
     for (i = 0;
          (i < (dp->number_tbl8s >> BITMAP_SLAB_BIT_SIZE_LOG2)) && (dp->tbl8_idxes[i] == UINT64_MAX);
          i++)
@@ -161,6 +212,13 @@ tbl8_get_idx(struct dir24_8_tbl *dp)
         dp->tbl8_idxes[i] |= (1ULL << bit_idx);
         return (i << BITMAP_SLAB_BIT_SIZE_LOG2) + bit_idx;
     }
+
+    /* If there are no free tbl8 groups try to reclaim one from the defer queue */
+    if (dp->dq != NULL && !reclaimed) {
+        reclaimed = true;
+        if (cne_rcu_qsbr_dq_reclaim(dp->dq, 1, NULL, NULL, NULL) == 0)
+            goto again;
+    }
     return -ENOSPC;
 }
 
@@ -186,6 +244,24 @@ tbl8_alloc(struct dir24_8_tbl *dp, uint64_t nh)
     return tbl8_idx;
 }
 
+static void
+tbl8_cleanup_and_free(struct dir24_8_tbl *dp, uint64_t tbl8_idx)
+{
+    uint8_t *ptr = (uint8_t *)dp->tbl8 + ((tbl8_idx * DIR24_8_TBL8_GRP_NUM_ENT) << dp->nh_sz);
+
+    memset(ptr, 0, DIR24_8_TBL8_GRP_NUM_ENT << dp->nh_sz);
+    tbl8_free_idx(dp, tbl8_idx);
+    dp->cur_tbl8s--;
+}
+
+static void
+__rcu_qsbr_free_resource(void *p, void *data, unsigned int n __cne_unused)
+{
+    struct dir24_8_tbl *dp = p;
+
+    tbl8_cleanup_and_free(dp, *(uint64_t *)data);
+}
+
 static void
 tbl8_recycle(struct dir24_8_tbl *dp, uint32_t ip, uint64_t tbl8_idx)
 {
@@ -205,8 +281,6 @@ tbl8_recycle(struct dir24_8_tbl *dp, uint32_t ip, uint64_t tbl8_idx)
                 return;
         }
         ((uint8_t *)dp->tbl24)[ip >> 8] = nh & ~DIR24_8_EXT_ENT;
-        for (i = 0; i < DIR24_8_TBL8_GRP_NUM_ENT; i++)
-            ptr8[i] = 0;
         break;
     case CNE_FIB_DIR24_8_2B:
         ptr16 = &((uint16_t *)dp->tbl8)[tbl8_idx * DIR24_8_TBL8_GRP_NUM_ENT];
@@ -216,8 +290,6 @@ tbl8_recycle(struct dir24_8_tbl *dp, uint32_t ip, uint64_t tbl8_idx)
                 return;
         }
         ((uint16_t *)dp->tbl24)[ip >> 8] = nh & ~DIR24_8_EXT_ENT;
-        for (i = 0; i < DIR24_8_TBL8_GRP_NUM_ENT; i++)
-            ptr16[i] = 0;
         break;
     case CNE_FIB_DIR24_8_4B:
         ptr32 = &((uint32_t *)dp->tbl8)[tbl8_idx * DIR24_8_TBL8_GRP_NUM_ENT];
@@ -227,8 +299,6 @@ tbl8_recycle(struct dir24_8_tbl *dp, uint32_t ip, uint64_t tbl8_idx)
                 return;
         }
         ((uint32_t *)dp->tbl24)[ip >> 8] = nh & ~DIR24_8_EXT_ENT;
-        for (i = 0; i < DIR24_8_TBL8_GRP_NUM_ENT; i++)
-            ptr32[i] = 0;
         break;
     case CNE_FIB_DIR24_8_8B:
         ptr64 = &((uint64_t *)dp->tbl8)[tbl8_idx * DIR24_8_TBL8_GRP_NUM_ENT];
@@ -238,12 +308,17 @@ tbl8_recycle(struct dir24_8_tbl *dp, uint32_t ip, uint64_t tbl8_idx)
                 return;
         }
         ((uint64_t *)dp->tbl24)[ip >> 8] = nh & ~DIR24_8_EXT_ENT;
-        for (i = 0; i < DIR24_8_TBL8_GRP_NUM_ENT; i++)
-            ptr64[i] = 0;
         break;
     }
-    tbl8_free_idx(dp, tbl8_idx);
-    dp->cur_tbl8s--;
+
+    if (dp->v == NULL)
+        tbl8_cleanup_and_free(dp, tbl8_idx);
+    else if (dp->rcu_mode == CNE_FIB_QSBR_MODE_SYNC) {
+        /* Wait for the lookup threads to stop using the tbl8 group */
+        cne_rcu_qsbr_synchronize(dp->v, CNE_QSBR_THRID_INVALID);
+        tbl8_cleanup_and_free(dp, tbl8_idx);
+    } else if (cne_rcu_qsbr_dq_enqueue(dp->dq, &tbl8_idx) != 0)
+        CNE_ERR("Failed to push QSBR FIFO\n");
 }
 
 static int
@@ -452,26 +527,17 @@ dir24_8_modify(struct cne_fib *fib, uint32_t ip, uint8_t depth, uint64_t next_ho
     return -EINVAL;
 }
 
-void *
-dir24_8_create(struct cne_fib_conf *fib_conf)
+static struct dir24_8_tbl *
+dir24_8_alloc(enum cne_fib_dir24_8_nh_sz nh_sz, uint32_t num_tbl8, uint64_t def_nh)
 {
     struct dir24_8_tbl *dp;
-    uint64_t def_nh;
-    uint32_t num_tbl8;
-    enum cne_fib_dir24_8_nh_sz nh_sz;
-
-    if ((fib_conf == NULL) || (fib_conf->dir24_8.nh_sz < CNE_FIB_DIR24_8_1B) ||
-        (fib_conf->dir24_8.nh_sz > CNE_FIB_DIR24_8_8B) ||
-        (fib_conf->dir24_8.num_tbl8 > get_max_nh(fib_conf->dir24_8.nh_sz)) ||
-        (fib_conf->dir24_8.num_tbl8 == 0) ||
-        (fib_conf->default_nh > get_max_nh(fib_conf->dir24_8.nh_sz)))
-        return NULL;
-
-    def_nh   = fib_conf->default_nh;
-    nh_sz    = fib_conf->dir24_8.nh_sz;
-    num_tbl8 = CNE_ALIGN_CEIL(fib_conf->dir24_8.num_tbl8, BITMAP_SLAB_BIT_SIZE);
 
-    dp = calloc(1, sizeof(struct dir24_8_tbl) + DIR24_8_TBL24_NUM_ENT * (1 << nh_sz));
+    /*
+     * The vector lookups gather 4 bytes per entry for 1 and 2 byte next hops, pad the tables so
+     * the gathers of the last entries stay inside the allocation.
+     */
+    dp = calloc(1, sizeof(struct dir24_8_tbl) + DIR24_8_TBL24_NUM_ENT * (1 << nh_sz) +
+                       sizeof(uint64_t));
     if (dp == NULL)
         return NULL;
 
@@ -479,7 +545,7 @@ dir24_8_create(struct cne_fib_conf *fib_conf)
     write_to_fib(dp->tbl24, (def_nh << 1), nh_sz, 1 << 24);
 
     uint64_t tbl8_sz = DIR24_8_TBL8_GRP_NUM_ENT * (1ULL << nh_sz) * (num_tbl8 + 1);
-    dp->tbl8         = calloc(1, tbl8_sz);
+    dp->tbl8         = calloc(1, tbl8_sz + sizeof(uint64_t));
     if (dp->tbl8 == NULL) {
         free(dp);
         return NULL;
@@ -498,11 +564,183 @@ dir24_8_create(struct cne_fib_conf *fib_conf)
     return dp;
 }
 
+void *
+dir24_8_create(struct cne_fib_conf *fib_conf)
+{
+    if ((fib_conf == NULL) || (fib_conf->dir24_8.nh_sz < CNE_FIB_DIR24_8_1B) ||
+        (fib_conf->dir24_8.nh_sz > CNE_FIB_DIR24_8_8B) ||
+        (fib_conf->dir24_8.num_tbl8 > get_max_nh(fib_conf->dir24_8.nh_sz)) ||
+        (fib_conf->dir24_8.num_tbl8 == 0) ||
+        (fib_conf->default_nh > get_max_nh(fib_conf->dir24_8.nh_sz)))
+        return NULL;
+
+    return dir24_8_alloc(fib_conf->dir24_8.nh_sz,
+                         CNE_ALIGN_CEIL(fib_conf->dir24_8.num_tbl8, BITMAP_SLAB_BIT_SIZE),
+                         fib_conf->default_nh);
+}
+
+/* Write one route to a table holding all of its less specific routes and none of the others */
+static int
+build_route(struct dir24_8_tbl *dp, uint32_t ip, uint8_t depth, uint64_t nh)
+{
+    uint64_t tbl24;
+    uint8_t *tbl8_ptr;
+    int tbl8_idx;
+
+    if (depth <= 24) {
+        write_to_fib(get_tbl24_p(dp, ip, dp->nh_sz), nh << 1, dp->nh_sz, 1 << (24 - depth));
+        return 0;
+    }
+
+    tbl24 = get_tbl24(dp, ip, dp->nh_sz);
+    if ((tbl24 & DIR24_8_EXT_ENT) != DIR24_8_EXT_ENT) {
+        if ((tbl24 >> 1) == nh)
+            return 0;
+        tbl8_idx = tbl8_alloc(dp, tbl24);
+        if (tbl8_idx < 0)
+            return -ENOSPC;
+        write_to_fib(get_tbl24_p(dp, ip, dp->nh_sz), ((uint64_t)tbl8_idx << 1) | DIR24_8_EXT_ENT,
+                     dp->nh_sz, 1);
+    } else
+        tbl8_idx = tbl24 >> 1;
+
+    tbl8_ptr = (uint8_t *)dp->tbl8 +
+               (((uint32_t)tbl8_idx * DIR24_8_TBL8_GRP_NUM_ENT + (uint8_t)ip) << dp->nh_sz);
+    write_to_fib(tbl8_ptr, (nh << 1) | DIR24_8_EXT_ENT, dp->nh_sz, 1 << (32 - depth));
+
+    return 0;
+}
+
+int
+dir24_8_build(struct dir24_8_tbl *dp, struct cne_rib *rib, struct dir24_8_tbl **new_dp)
+{
+    struct dir24_8_tbl *tbl;
+    struct cne_rib_node *node = NULL;
+    struct dir24_8_route {
+        uint32_t ip;
+        uint8_t depth;
+        uint64_t nh;
+    } *routes = NULL;
+    uint32_t n = 0, i, blk, last_blk = 0;
+    int ret = -ENOMEM;
+
+    if ((dp == NULL) || (rib == NULL) || (new_dp == NULL))
+        return -EINVAL;
+
+    /* The default route is not returned by cne_rib_get_nxt() */
+    while ((node = cne_rib_get_nxt(rib, 0, 0, node, CNE_RIB_GET_NXT_ALL)) != NULL)
+        n++;
+    routes = calloc(n + 1, sizeof(*routes));
+    if (routes == NULL)
+        return -ENOMEM;
+
+    /* Routes are returned with the more specific routes first */
+    for (i = n; (node = cne_rib_get_nxt(rib, 0, 0, node, CNE_RIB_GET_NXT_ALL)) != NULL; i--) {
+        cne_rib_get_ip(node, &routes[i].ip);
+        cne_rib_get_depth(node, &routes[i].depth);
+        cne_rib_get_nh(node, &routes[i].nh);
+    }
+    node = cne_rib_lookup_exact(rib, 0, 0);
+    if (node != NULL)
+        cne_rib_get_nh(node, &routes[0].nh);
+    else
+        routes[0].nh = dp->def_nh;
+
+    tbl = dir24_8_alloc(dp->nh_sz, dp->number_tbl8s, dp->def_nh);
+    if (tbl == NULL)
+        goto exit;
+
+    /* Each route is written before the routes it covers, the routes below a /24 are adjacent */
+    for (i = 0; i <= n; i++) {
+        if (routes[i].nh > get_max_nh(tbl->nh_sz)) {
+            ret = -EINVAL;
+            goto free_tbl;
+        }
+        if (routes[i].depth > 24) {
+            blk = routes[i].ip >> 8;
+            if ((tbl->rsvd_tbl8s == 0) || (blk != last_blk))
+                tbl->rsvd_tbl8s++;
+            last_blk = blk;
+            if (tbl->rsvd_tbl8s > tbl->number_tbl8s) {
+                ret = -ENOSPC;
+                goto free_tbl;
+            }
+        }
+        ret = build_route(tbl, routes[i].ip, routes[i].depth, routes[i].nh);
+        if (ret < 0)
+            goto free_tbl;
+    }
+    free(routes);
+    *new_dp = tbl;
+
+    return 0;
+
+free_tbl:
+    dir24_8_free(tbl);
+exit:
+    free(routes);
+
+    return ret;
+}
+
+int
+dir24_8_retire(struct dir24_8_tbl *old, struct dir24_8_tbl *dp, const char *name)
+{
+    struct cne_fib_rcu_config cfg = old->rcu_cfg;
+
+    /* Wait for the lookup threads to stop using the old table */
+    cne_rcu_qsbr_synchronize(old->v, CNE_QSBR_THRID_INVALID);
+    dir24_8_free(old);
+
+    return dir24_8_rcu_qsbr_add(dp, &cfg, name);
+}
+
+int
+dir24_8_rcu_qsbr_add(struct dir24_8_tbl *dp, struct cne_fib_rcu_config *cfg, const char *name)
+{
+    struct cne_rcu_qsbr_dq_parameters params = {0};
+    char rcu_dq_name[CNE_RCU_QSBR_DQ_NAMESIZE];
+
+    if ((dp == NULL) || (cfg == NULL) || (cfg->v == NULL))
+        return -EINVAL;
+
+    if (dp->v != NULL)
+        return -EEXIST;
+
+    if (cfg->mode == CNE_FIB_QSBR_MODE_DQ) {
+        snprintf(rcu_dq_name, sizeof(rcu_dq_name), "FIB_RCU_%s", name);
+        params.name                  = rcu_dq_name;
+        params.size                  = (cfg->dq_size) ? cfg->dq_size : dp->number_tbl8s;
+        params.trigger_reclaim_limit = cfg->reclaim_thd;
+        params.max_reclaim_size =
+            (cfg->reclaim_max) ? cfg->reclaim_max : DIR24_8_RCU_DQ_RECLAIM_MAX;
+        params.esize   = sizeof(uint64_t);
+        params.free_fn = __rcu_qsbr_free_resource;
+        params.p       = dp;
+        params.v       = cfg->v;
+
+        dp->dq = cne_rcu_qsbr_dq_create(&params);
+        if (dp->dq == NULL) {
+            CNE_ERR("FIB defer queue creation failed\n");
+            return -ENOMEM;
+        }
+    } else if (cfg->mode != CNE_FIB_QSBR_MODE_SYNC)
+        return -EINVAL;
+
+    dp->rcu_cfg  = *cfg;
+    dp->rcu_mode = cfg->mode;
+    dp->v        = cfg->v;
+
+    return 0;
+}
+
 void
 dir24_8_free(void *p)
 {
     struct dir24_8_tbl *dp = (struct dir24_8_tbl *)p;
 
+    if (dp->dq)
+        cne_rcu_qsbr_dq_delete(dp->dq);
     free(dp->tbl8_idxes);
     free(dp->tbl8);
     free(dp);
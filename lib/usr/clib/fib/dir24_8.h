@@ -14,6 +14,8 @@
 #include "cne_fib.h"           // for cne_fib_conf (ptr only), cne_fib_...
 
 struct cne_fib;
+struct cne_rib;
+struct cne_rcu_qsbr_dq;
 
 /**
  * @file
@@ -34,13 +36,17 @@ extern "C" {
 #define BITMAP_SLAB_BITMASK       (BITMAP_SLAB_BIT_SIZE - 1)
 
 struct dir24_8_tbl {
-    uint32_t number_tbl8s;            /**< Total number of tbl8s */
-    uint32_t rsvd_tbl8s;              /**< Number of reserved tbl8s */
-    uint32_t cur_tbl8s;               /**< Current number of tbl8s */
-    enum cne_fib_dir24_8_nh_sz nh_sz; /**< Size of nexthop entry */
-    uint64_t def_nh;                  /**< Default next hop */
-    uint64_t *tbl8;                   /**< tbl8 table. */
-    uint64_t *tbl8_idxes;             /**< bitmap containing free tbl8 idxes*/
+    uint32_t number_tbl8s;             /**< Total number of tbl8s */
+    uint32_t rsvd_tbl8s;               /**< Number of reserved tbl8s */
+    uint32_t cur_tbl8s;                /**< Current number of tbl8s */
+    enum cne_fib_dir24_8_nh_sz nh_sz;  /**< Size of nexthop entry */
+    uint64_t def_nh;                   /**< Default next hop */
+    uint64_t *tbl8;                    /**< tbl8 table. */
+    uint64_t *tbl8_idxes;              /**< bitmap containing free tbl8 idxes*/
+    struct cne_rcu_qsbr *v;            /**< RCU QSBR variable or NULL */
+    enum cne_fib_qsbr_mode rcu_mode;   /**< Blocking or defer queue mode */
+    struct cne_rcu_qsbr_dq *dq;        /**< RCU QSBR defer queue */
+    struct cne_fib_rcu_config rcu_cfg; /**< RCU config, applied again to a rebuilt table */
     /* tbl24 table. */
     __extension__ uint64_t tbl24[0] __cne_cache_aligned;
 };
@@ -243,6 +249,23 @@ cne_fib_lookup_fn_t dir24_8_get_lookup_fn(void *p, enum cne_fib_lookup_type type
 
 int dir24_8_modify(struct cne_fib *fib, uint32_t ip, uint8_t depth, uint64_t next_hop, int op);
 
+int dir24_8_rcu_qsbr_add(struct dir24_8_tbl *dp, struct cne_fib_rcu_config *cfg,
+                         const char *name);
+
+/**
+ * Build a new table holding all the routes of a RIB, the table in use is not changed.
+ *
+ * @return
+ *   0 and the new table in new_dp on success, negative errno otherwise
+ */
+int dir24_8_build(struct dir24_8_tbl *dp, struct cne_rib *rib, struct dir24_8_tbl **new_dp);
+
+/**
+ * Free a table replaced by dp, once no lookup uses it, and move its RCU config to dp.
+ * The old table must have a RCU config.
+ */
+int dir24_8_retire(struct dir24_8_tbl *old, struct dir24_8_tbl *dp, const char *name);
+
 #ifdef __cplusplus
 }
 #endif
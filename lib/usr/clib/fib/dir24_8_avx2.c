@@ -0,0 +1,94 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright (c) 2023 Intel Corporation
+ */
+
+#include <immintrin.h>        // for __m256i, _mm256_i32gather_epi32, _mm256_set1_epi32
+
+#include "dir24_8.h"        // for dir24_8_tbl, dir24_8_lookup_bulk_1b, dir24_8...
+#include "dir24_8_avx2.h"
+#include "cne_common.h"        // for __cne_always_inline
+
+static __cne_always_inline void
+dir24_8_avx2_lookup_x8(void *p, const uint32_t *ips, uint64_t *next_hops, int size)
+{
+    struct dir24_8_tbl *dp   = (struct dir24_8_tbl *)p;
+    const __m256i lsb        = _mm256_set1_epi32(1);
+    const __m256i lsbyte_msk = _mm256_set1_epi32(0xff);
+    /* used to mask gather values if size is 1/2 (8/16 bit next hops) */
+    const __m256i res_msk =
+        _mm256_set1_epi32((size == sizeof(uint8_t)) ? UINT8_MAX : UINT16_MAX);
+    __m256i ip_vec, idxes, res, msk_ext;
+
+    ip_vec = _mm256_loadu_si256((const __m256i *)ips);
+    /* mask 24 most significant bits */
+    idxes = _mm256_srli_epi32(ip_vec, 8);
+
+    /**
+     * lookup in tbl24
+     * Put it inside branch to make compiler happy with -O0
+     */
+    if (size == sizeof(uint8_t)) {
+        res = _mm256_i32gather_epi32((const int *)dp->tbl24, idxes, 1);
+        res = _mm256_and_si256(res, res_msk);
+    } else if (size == sizeof(uint16_t)) {
+        res = _mm256_i32gather_epi32((const int *)dp->tbl24, idxes, 2);
+        res = _mm256_and_si256(res, res_msk);
+    } else
+        res = _mm256_i32gather_epi32((const int *)dp->tbl24, idxes, 4);
+
+    /* get extended entries indexes */
+    msk_ext = _mm256_cmpeq_epi32(_mm256_and_si256(res, lsb), lsb);
+
+    if (!_mm256_testz_si256(msk_ext, msk_ext)) {
+        idxes = _mm256_srli_epi32(res, 1);
+        idxes = _mm256_slli_epi32(idxes, 8);
+        idxes = _mm256_add_epi32(idxes, _mm256_and_si256(ip_vec, lsbyte_msk));
+        /* the entries which are not extended are kept as they are */
+        if (size == sizeof(uint8_t)) {
+            res = _mm256_mask_i32gather_epi32(res, (const int *)dp->tbl8, idxes, msk_ext, 1);
+            res = _mm256_and_si256(res, res_msk);
+        } else if (size == sizeof(uint16_t)) {
+            res = _mm256_mask_i32gather_epi32(res, (const int *)dp->tbl8, idxes, msk_ext, 2);
+            res = _mm256_and_si256(res, res_msk);
+        } else
+            res = _mm256_mask_i32gather_epi32(res, (const int *)dp->tbl8, idxes, msk_ext, 4);
+    }
+
+    res = _mm256_srli_epi32(res, 1);
+    _mm256_storeu_si256((__m256i *)next_hops, _mm256_cvtepu32_epi64(_mm256_castsi256_si128(res)));
+    _mm256_storeu_si256((__m256i *)(next_hops + 4),
+                        _mm256_cvtepu32_epi64(_mm256_extracti128_si256(res, 1)));
+}
+
+void
+cne_dir24_8_avx2_lookup_bulk_1b(void *p, const uint32_t *ips, uint64_t *next_hops,
+                                const unsigned int n)
+{
+    uint32_t i;
+    for (i = 0; i < (n / 8); i++)
+        dir24_8_avx2_lookup_x8(p, ips + i * 8, next_hops + i * 8, sizeof(uint8_t));
+
+    dir24_8_lookup_bulk_1b(p, ips + i * 8, next_hops + i * 8, n - i * 8);
+}
+
+void
+cne_dir24_8_avx2_lookup_bulk_2b(void *p, const uint32_t *ips, uint64_t *next_hops,
+                                const unsigned int n)
+{
+    uint32_t i;
+    for (i = 0; i < (n / 8); i++)
+        dir24_8_avx2_lookup_x8(p, ips + i * 8, next_hops + i * 8, sizeof(uint16_t));
+
+    dir24_8_lookup_bulk_2b(p, ips + i * 8, next_hops + i * 8, n - i * 8);
+}
+
+void
+cne_dir24_8_avx2_lookup_bulk_4b(void *p, const uint32_t *ips, uint64_t *next_hops,
+                                const unsigned int n)
+{
+    uint32_t i;
+    for (i = 0; i < (n / 8); i++)
+        dir24_8_avx2_lookup_x8(p, ips + i * 8, next_hops + i * 8, sizeof(uint32_t));
+
+    dir24_8_lookup_bulk_4b(p, ips + i * 8, next_hops + i * 8, n - i * 8);
+}
@@ -5,12 +5,14 @@
 
 #include <stdint.h>              // for uint8_t, uint64_t, uint32_t, uint...
 #include <stdlib.h>              // for free, calloc
-#include <stdio.h>               // for NULL
+#include <stdio.h>               // for NULL, snprintf
+#include <string.h>              // for memset
 #include <cne_log.h>             // for CNE_ASSERT
 #include <cne_rib6.h>            // for cne_rib6_copy_addr, cne_rib6_get_nh
 #include "private_fib6.h"        // for IPV6_ADDR_LEN, cne_fib6...
 #include <cne_fib6.h>            // for cne_fib6_conf, cne_fib6_conf::(an...
 #include <errno.h>               // for EINVAL, ENOSPC, ENOENT
+#include <cne_rcu_qsbr.h>        // for cne_rcu_qsbr_dq_enqueue, cne_rcu_qsbr_dq_reclaim
 
 #include "trie.h"
 #include "cne_branch_prediction.h"        // for unlikely
@@ -26,6 +28,9 @@ struct cne_rib6;
 
 #define TRIE_NAMESIZE 64
 
+/* Default number of tbl8 groups reclaimed from the defer queue in one call */
+#define TRIE_RCU_DQ_RECLAIM_MAX 16
+
 enum edge { LEDGE, REDGE };
 
 static inline cne_fib6_lookup_fn_t
@@ -134,6 +139,10 @@ tbl8_pool_init(struct cne_trie_tbl *dp)
 static inline int32_t
 tbl8_get(struct cne_trie_tbl *dp)
 {
+    /* If there are no free tbl8 groups try to reclaim one from the defer queue */
+    if (dp->tbl8_pool_pos == dp->number_tbl8s && dp->dq != NULL)
+        cne_rcu_qsbr_dq_reclaim(dp->dq, 1, NULL, NULL, NULL);
+
     if (dp->tbl8_pool_pos == dp->number_tbl8s)
         /* no more free tbl8 */
         return -ENOSPC;
@@ -166,6 +175,23 @@ tbl8_alloc(struct cne_trie_tbl *dp, uint64_t nh)
     return tbl8_idx;
 }
 
+static void
+tbl8_cleanup_and_free(struct cne_trie_tbl *dp, uint64_t tbl8_idx)
+{
+    uint8_t *ptr = (uint8_t *)dp->tbl8 + ((tbl8_idx * TRIE_TBL8_GRP_NUM_ENT) << dp->nh_sz);
+
+    memset(ptr, 0, TRIE_TBL8_GRP_NUM_ENT << dp->nh_sz);
+    tbl8_put(dp, tbl8_idx);
+}
+
+static void
+__rcu_qsbr_free_resource(void *p, void *data, unsigned int n __cne_unused)
+{
+    struct cne_trie_tbl *dp = p;
+
+    tbl8_cleanup_and_free(dp, *(uint64_t *)data);
+}
+
 static void
 tbl8_recycle(struct cne_trie_tbl *dp, void *par, uint64_t tbl8_idx)
 {
@@ -186,8 +212,6 @@ tbl8_recycle(struct cne_trie_tbl *dp, void *par, uint64_t tbl8_idx)
                 return;
         }
         write_to_dp(par, nh, dp->nh_sz, 1);
-        for (i = 0; i < TRIE_TBL8_GRP_NUM_ENT; i++)
-            ptr16[i] = 0;
         break;
     case CNE_FIB_TRIE_4B:
         ptr32 = &((uint32_t *)dp->tbl8)[tbl8_idx * TRIE_TBL8_GRP_NUM_ENT];
@@ -199,8 +223,6 @@ tbl8_recycle(struct cne_trie_tbl *dp, void *par, uint64_t tbl8_idx)
                 return;
         }
         write_to_dp(par, nh, dp->nh_sz, 1);
-        for (i = 0; i < TRIE_TBL8_GRP_NUM_ENT; i++)
-            ptr32[i] = 0;
         break;
     case CNE_FIB_TRIE_8B:
         ptr64 = &((uint64_t *)dp->tbl8)[tbl8_idx * TRIE_TBL8_GRP_NUM_ENT];
@@ -212,11 +234,17 @@ tbl8_recycle(struct cne_trie_tbl *dp, void *par, uint64_t tbl8_idx)
                 return;
         }
         write_to_dp(par, nh, dp->nh_sz, 1);
-        for (i = 0; i < TRIE_TBL8_GRP_NUM_ENT; i++)
-            ptr64[i] = 0;
         break;
     }
-    tbl8_put(dp, tbl8_idx);
+
+    if (dp->v == NULL)
+        tbl8_cleanup_and_free(dp, tbl8_idx);
+    else if (dp->rcu_mode == CNE_FIB_QSBR_MODE_SYNC) {
+        /* Wait for the lookup threads to stop using the tbl8 group */
+        cne_rcu_qsbr_synchronize(dp->v, CNE_QSBR_THRID_INVALID);
+        tbl8_cleanup_and_free(dp, tbl8_idx);
+    } else if (cne_rcu_qsbr_dq_enqueue(dp->dq, &tbl8_idx) != 0)
+        CNE_ERR("Failed to push QSBR FIFO\n");
 }
 
 #define BYTE_SIZE 8
@@ -621,11 +649,51 @@ trie_create(const char *name, struct cne_fib_conf *conf)
     return dp;
 }
 
+int
+trie_rcu_qsbr_add(struct cne_trie_tbl *dp, struct cne_fib_rcu_config *cfg, const char *name)
+{
+    struct cne_rcu_qsbr_dq_parameters params = {0};
+    char rcu_dq_name[CNE_RCU_QSBR_DQ_NAMESIZE];
+
+    if ((dp == NULL) || (cfg == NULL) || (cfg->v == NULL))
+        return -EINVAL;
+
+    if (dp->v != NULL)
+        return -EEXIST;
+
+    if (cfg->mode == CNE_FIB_QSBR_MODE_DQ) {
+        snprintf(rcu_dq_name, sizeof(rcu_dq_name), "FIB6_RCU_%s", name);
+        params.name                  = rcu_dq_name;
+        params.size                  = (cfg->dq_size) ? cfg->dq_size : dp->number_tbl8s;
+        params.trigger_reclaim_limit = cfg->reclaim_thd;
+        params.max_reclaim_size =
+            (cfg->reclaim_max) ? cfg->reclaim_max : TRIE_RCU_DQ_RECLAIM_MAX;
+        params.esize   = sizeof(uint64_t);
+        params.free_fn = __rcu_qsbr_free_resource;
+        params.p       = dp;
+        params.v       = cfg->v;
+
+        dp->dq = cne_rcu_qsbr_dq_create(&params);
+        if (dp->dq == NULL) {
+            CNE_ERR("FIB6 defer queue creation failed\n");
+            return -ENOMEM;
+        }
+    } else if (cfg->mode != CNE_FIB_QSBR_MODE_SYNC)
+        return -EINVAL;
+
+    dp->rcu_mode = cfg->mode;
+    dp->v        = cfg->v;
+
+    return 0;
+}
+
 void
 trie_free(void *p)
 {
     struct cne_trie_tbl *dp = (struct cne_trie_tbl *)p;
 
+    if (dp->dq)
+        cne_rcu_qsbr_dq_delete(dp->dq);
     free(dp->tbl8_pool);
     free(dp->tbl8);
     free(dp);
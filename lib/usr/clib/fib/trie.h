@@ -19,6 +19,7 @@
 #include "private_fib6.h"        // for IPV6_ADDR_LEN, cne_fib6_lookup_fn_t
 
 struct cne_fib6;
+struct cne_rcu_qsbr_dq;
 
 #ifdef __cplusplus
 extern "C" {
@@ -40,14 +41,17 @@ extern "C" {
 #define BITMAP_SLAB_BITMASK       (BITMAP_SLAB_BIT_SIZE - 1)
 
 struct cne_trie_tbl {
-    uint32_t number_tbl8s;         /**< Total number of tbl8s */
-    uint32_t rsvd_tbl8s;           /**< Number of reserved tbl8s */
-    uint32_t cur_tbl8s;            /**< Current cumber of tbl8s */
-    uint64_t def_nh;               /**< Default next hop */
-    enum cne_fib_trie_nh_sz nh_sz; /**< Size of nexthop entry */
-    uint64_t *tbl8;                /**< tbl8 table. */
-    uint32_t *tbl8_pool;           /**< bitmap containing free tbl8 idxes*/
+    uint32_t number_tbl8s;           /**< Total number of tbl8s */
+    uint32_t rsvd_tbl8s;             /**< Number of reserved tbl8s */
+    uint32_t cur_tbl8s;              /**< Current cumber of tbl8s */
+    uint64_t def_nh;                 /**< Default next hop */
+    enum cne_fib_trie_nh_sz nh_sz;   /**< Size of nexthop entry */
+    uint64_t *tbl8;                  /**< tbl8 table. */
+    uint32_t *tbl8_pool;             /**< bitmap containing free tbl8 idxes*/
     uint32_t tbl8_pool_pos;
+    struct cne_rcu_qsbr *v;          /**< RCU QSBR variable or NULL */
+    enum cne_fib_qsbr_mode rcu_mode; /**< Blocking or defer queue mode */
+    struct cne_rcu_qsbr_dq *dq;      /**< RCU QSBR defer queue */
     /* tbl24 table. */
     __extension__ uint64_t tbl24[0] __cne_cache_aligned;
 };
@@ -116,21 +120,55 @@ is_entry_extended(uint64_t ent)
     return (ent & TRIE_EXT_ENT) == TRIE_EXT_ENT;
 }
 
+/*
+ * The lookups are software pipelined over blocks of TRIE_LOOKUP_BLOCK addresses. The tbl24
+ * entries are prefetched a block ahead, then every pass over a block takes the addresses
+ * still on extended entries one level down the trie, prefetching the tbl8 entry it reads
+ * on the next pass.
+ */
+#define TRIE_LOOKUP_BLOCK 16
+
 #define LOOKUP_FUNC(suffix, type, nh_sz)                                                        \
     static inline void cne_trie_lookup_bulk_##suffix(void *p, uint8_t ips[][IPV6_ADDR_LEN],     \
                                                      uint64_t *next_hops, const unsigned int n) \
     {                                                                                           \
-        struct cne_trie_tbl *dp = (struct cne_trie_tbl *)p;                                     \
+        struct cne_trie_tbl *dp  = (struct cne_trie_tbl *)p;                                    \
+        uint32_t prefetch_offset = CNE_MIN((unsigned int)TRIE_LOOKUP_BLOCK, n);                 \
+        uint32_t i, j, k, end, ext, msk;                                                        \
         uint64_t tmp;                                                                           \
-        uint32_t i, j;                                                                          \
                                                                                                 \
-        for (i = 0; i < n; i++) {                                                               \
-            tmp = ((type *)dp->tbl24)[get_tbl24_idx(&ips[i][0])];                               \
-            j   = 3;                                                                            \
-            while (is_entry_extended(tmp)) {                                                    \
-                tmp = ((type *)dp->tbl8)[ips[i][j++] + ((tmp >> 1) * TRIE_TBL8_GRP_NUM_ENT)];   \
+        for (i = 0; i < prefetch_offset; i++)                                                   \
+            cne_prefetch0(get_tbl24_p(dp, &ips[i][0], nh_sz));                                  \
+        for (i = 0; i < n; i = end) {                                                           \
+            end = CNE_MIN(i + TRIE_LOOKUP_BLOCK, n);                                            \
+            ext = 0;                                                                            \
+            for (k = i; k < end; k++) {                                                         \
+                if (k + prefetch_offset < n)                                                    \
+                    cne_prefetch0(get_tbl24_p(dp, &ips[k + prefetch_offset][0], nh_sz));        \
+                tmp = ((type *)dp->tbl24)[get_tbl24_idx(&ips[k][0])];                           \
+                if (is_entry_extended(tmp)) {                                                   \
+                    /* Keep the tbl8 index until the next pass */                               \
+                    tmp = ips[k][3] + ((tmp >> 1) * TRIE_TBL8_GRP_NUM_ENT);                     \
+                    cne_prefetch0(&((type *)dp->tbl8)[tmp]);                                    \
+                    ext |= 1U << (k - i);                                                       \
+                    next_hops[k] = tmp;                                                         \
+                } else                                                                          \
+                    next_hops[k] = tmp >> 1;                                                    \
+            }                                                                                   \
+            for (j = 4; ext; j++) {                                                             \
+                for (msk = ext; msk; msk &= msk - 1) {                                          \
+                    k   = i + __builtin_ctz(msk);                                               \
+                    tmp = ((type *)dp->tbl8)[next_hops[k]];                                     \
+                    if (is_entry_extended(tmp)) {                                               \
+                        tmp = ips[k][j] + ((tmp >> 1) * TRIE_TBL8_GRP_NUM_ENT);                 \
+                        cne_prefetch0(&((type *)dp->tbl8)[tmp]);                                \
+                        next_hops[k] = tmp;                                                     \
+                    } else {                                                                    \
+                        next_hops[k] = tmp >> 1;                                                \
+                        ext &= ~(1U << (k - i));                                                \
+                    }                                                                           \
+                }                                                                               \
             }                                                                                   \
-            next_hops[i] = tmp >> 1;                                                            \
         }                                                                                       \
     }
 LOOKUP_FUNC(2b, uint16_t, 1)
@@ -146,6 +184,8 @@ cne_fib6_lookup_fn_t trie_get_lookup_fn(void *p, enum cne_fib_lookup_type type);
 int trie_modify(struct cne_fib6 *fib, const uint8_t ip[IPV6_ADDR_LEN], uint8_t depth,
                 uint64_t next_hop, int op);
 
+int trie_rcu_qsbr_add(struct cne_trie_tbl *dp, struct cne_fib_rcu_config *cfg, const char *name);
+
 #ifdef __cplusplus
 }
 #endif
@@ -10,6 +10,9 @@
 #include <cne_mmap.h>          // for mmap_free, mmap_addr, mmap_alloc
 #include <cne_rib.h>
 #include <bsd/string.h>        // for strlcpy
+#include <stdio.h>             // for snprintf
+#include <errno.h>             // for EINVAL, EEXIST, ENOMEM
+#include <cne_rcu_qsbr.h>      // for cne_rcu_qsbr_dq_enqueue, cne_rcu...
 
 #include "cne_branch_prediction.h"        // for unlikely
 #include "cne_common.h"                   // for CNE_MIN
@@ -22,6 +25,8 @@ static cne_rwlock_t __rib_lock;
 #define RIB_MAXDEPTH 32
 /* Maximum length of a RIB name. */
 #define CNE_RIB_NAMESIZE 64
+/* Default number of nodes reclaimed from the defer queue in one call */
+#define RIB_RCU_DQ_RECLAIM_MAX 16
 
 struct cne_rib_node {
     struct cne_rib_node *left;
@@ -36,6 +41,8 @@ struct cne_rib_node {
 
 struct cne_rib {
     char name[CNE_RIB_NAMESIZE];
+    struct cne_rcu_qsbr *v;     /* RCU QSBR variable of the readers */
+    struct cne_rcu_qsbr_dq *dq; /* RCU QSBR defer queue for removed nodes */
     struct cne_rib_node *tree;
     mmap_t *mm;
     mempool_t *node_pool;
@@ -76,8 +83,12 @@ node_alloc(struct cne_rib *rib)
 {
     struct cne_rib_node *ent;
 
-    if (unlikely(mempool_get(rib->node_pool, (void *)&ent) < 0))
-        return NULL;
+    if (unlikely(mempool_get(rib->node_pool, (void *)&ent) < 0)) {
+        /* Try to get back some of the nodes waiting on the readers */
+        if (rib->dq == NULL || cne_rcu_qsbr_dq_reclaim(rib->dq, 1, NULL, NULL, NULL) != 0 ||
+            mempool_get(rib->node_pool, (void *)&ent) < 0)
+            return NULL;
+    }
     ++rib->cur_nodes;
     return ent;
 }
@@ -89,6 +100,33 @@ node_free(struct cne_rib *rib, struct cne_rib_node *ent)
     mempool_put(rib->node_pool, ent);
 }
 
+static void
+__rcu_qsbr_free_resource(void *p, void *data, unsigned int n __cne_unused)
+{
+    node_free(p, *(struct cne_rib_node **)data);
+}
+
+/*
+ * Free a node unlinked from the tree, readers may still be walking it so
+ * with a QSBR variable attached the node is put on the defer queue.
+ */
+static void
+node_retire(struct cne_rib *rib, struct cne_rib_node *ent)
+{
+    if (rib->dq == NULL) {
+        node_free(rib, ent);
+        return;
+    }
+
+    if (cne_rcu_qsbr_dq_enqueue(rib->dq, &ent) == 0)
+        return;
+
+    /* The defer queue stays full until the readers report, wait for them before freeing */
+    CNE_WARN("QSBR defer queue full, waiting for readers\n");
+    cne_rcu_qsbr_synchronize(rib->v, CNE_QSBR_THRID_INVALID);
+    node_free(rib, ent);
+}
+
 struct cne_rib_node *
 cne_rib_lookup(struct cne_rib *rib, uint32_t ip)
 {
@@ -202,7 +240,7 @@ cne_rib_remove(struct cne_rib *rib, uint32_t ip, uint8_t depth)
             child->parent = cur->parent;
         if (cur->parent == NULL) {
             rib->tree = child;
-            node_free(rib, cur);
+            node_retire(rib, cur);
             return;
         }
         if (cur->parent->left == cur)
@@ -211,7 +249,7 @@ cne_rib_remove(struct cne_rib *rib, uint32_t ip, uint8_t depth)
             cur->parent->right = child;
         prev = cur;
         cur  = cur->parent;
-        node_free(rib, prev);
+        node_retire(rib, prev);
     }
 }
 
@@ -414,6 +452,12 @@ cne_rib_free(struct cne_rib *rib)
     if (rib == NULL)
         return;
 
+    /* Reclaim the deferred nodes, the remaining ones are freed directly */
+    if (rib->dq && cne_rcu_qsbr_dq_delete(rib->dq) != 0)
+        CNE_WARN("RIB %s has nodes still in use by readers\n", rib->name);
+    rib->dq = NULL;
+    rib->v  = NULL;
+
     while ((tmp = cne_rib_get_nxt(rib, 0, 0, tmp, CNE_RIB_GET_NXT_ALL)) != NULL)
         cne_rib_remove(rib, tmp->ip, tmp->depth);
 
@@ -421,3 +465,33 @@ cne_rib_free(struct cne_rib *rib)
     mmap_free(rib->mm);
     free(rib);
 }
+
+int
+cne_rib_rcu_qsbr_add(struct cne_rib *rib, struct cne_rcu_qsbr *v)
+{
+    struct cne_rcu_qsbr_dq_parameters params = {0};
+    char rcu_dq_name[CNE_RCU_QSBR_DQ_NAMESIZE];
+
+    if (rib == NULL || v == NULL)
+        return -EINVAL;
+
+    if (rib->dq != NULL)
+        return -EEXIST;
+
+    snprintf(rcu_dq_name, sizeof(rcu_dq_name), "RIB_RCU_%s", rib->name);
+    params.name             = rcu_dq_name;
+    params.size             = rib->max_nodes;
+    params.max_reclaim_size = RIB_RCU_DQ_RECLAIM_MAX;
+    params.esize            = sizeof(struct cne_rib_node *);
+    params.free_fn          = __rcu_qsbr_free_resource;
+    params.p                = rib;
+    params.v                = v;
+
+    rib->dq = cne_rcu_qsbr_dq_create(&params);
+    if (rib->dq == NULL)
+        CNE_ERR_RET_VAL(-ENOMEM, "RIB defer queue creation failed\n");
+
+    rib->v = v;
+
+    return 0;
+}
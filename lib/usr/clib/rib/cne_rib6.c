@@ -10,6 +10,9 @@
 #include <cne_mmap.h>          // for mmap_free, mmap_addr, mmap_alloc
 #include <cne_rib6.h>
 #include <bsd/string.h>        // for strlcpy
+#include <stdio.h>             // for snprintf
+#include <errno.h>             // for EINVAL, EEXIST, ENOMEM
+#include <cne_rcu_qsbr.h>      // for cne_rcu_qsbr_dq_enqueue, cne_rcu...
 #include <stdlib.h>            // for NULL, calloc, free
 
 #include "cne_branch_prediction.h"        // for unlikely
@@ -20,6 +23,9 @@
 #define RIB6_MAXDEPTH      128
 #define CNE_RIB6_NAMESIZE  64 /**< Maximum length of a RIB6 name. */
 
+/* Default number of nodes reclaimed from the defer queue in one call */
+#define RIB_RCU_DQ_RECLAIM_MAX 16
+
 static cne_rwlock_t __rib6_lock;
 
 struct cne_rib6_node {
@@ -35,6 +41,8 @@ struct cne_rib6_node {
 
 struct cne_rib6 {
     char name[CNE_RIB6_NAMESIZE];
+    struct cne_rcu_qsbr *v;     /* RCU QSBR variable of the readers */
+    struct cne_rcu_qsbr_dq *dq; /* RCU QSBR defer queue for removed nodes */
     struct cne_rib6_node *tree;
     mmap_t *mm;
     mempool_t *node_pool;
@@ -95,8 +103,12 @@ node_alloc(struct cne_rib6 *rib)
 {
     struct cne_rib6_node *ent;
 
-    if (unlikely(mempool_get(rib->node_pool, (void *)&ent) < 0))
-        return NULL;
+    if (unlikely(mempool_get(rib->node_pool, (void *)&ent) < 0)) {
+        /* Try to get back some of the nodes waiting on the readers */
+        if (rib->dq == NULL || cne_rcu_qsbr_dq_reclaim(rib->dq, 1, NULL, NULL, NULL) != 0 ||
+            mempool_get(rib->node_pool, (void *)&ent) < 0)
+            return NULL;
+    }
 
     ++rib->cur_nodes;
     return ent;
@@ -109,6 +121,33 @@ node_free(struct cne_rib6 *rib, struct cne_rib6_node *ent)
     mempool_put(rib->node_pool, ent);
 }
 
+static void
+__rcu_qsbr_free_resource(void *p, void *data, unsigned int n __cne_unused)
+{
+    node_free(p, *(struct cne_rib6_node **)data);
+}
+
+/*
+ * Free a node unlinked from the tree, readers may still be walking it so
+ * with a QSBR variable attached the node is put on the defer queue.
+ */
+static void
+node_retire(struct cne_rib6 *rib, struct cne_rib6_node *ent)
+{
+    if (rib->dq == NULL) {
+        node_free(rib, ent);
+        return;
+    }
+
+    if (cne_rcu_qsbr_dq_enqueue(rib->dq, &ent) == 0)
+        return;
+
+    /* The defer queue stays full until the readers report, wait for them before freeing */
+    CNE_WARN("QSBR defer queue full, waiting for readers\n");
+    cne_rcu_qsbr_synchronize(rib->v, CNE_QSBR_THRID_INVALID);
+    node_free(rib, ent);
+}
+
 struct cne_rib6_node *
 cne_rib6_lookup(struct cne_rib6 *rib, const uint8_t ip[CNE_RIB6_IPV6_ADDR_SIZE])
 {
@@ -232,7 +271,7 @@ cne_rib6_remove(struct cne_rib6 *rib, const uint8_t ip[CNE_RIB6_IPV6_ADDR_SIZE],
             child->parent = cur->parent;
         if (cur->parent == NULL) {
             rib->tree = child;
-            node_free(rib, cur);
+            node_retire(rib, cur);
             return;
         }
         if (cur->parent->left == cur)
@@ -241,7 +280,7 @@ cne_rib6_remove(struct cne_rib6 *rib, const uint8_t ip[CNE_RIB6_IPV6_ADDR_SIZE],
             cur->parent->right = child;
         prev = cur;
         cur  = cur->parent;
-        node_free(rib, prev);
+        node_retire(rib, prev);
     }
 }
 
@@ -459,6 +498,12 @@ cne_rib6_free(struct cne_rib6 *rib)
     if (unlikely(rib == NULL))
         return;
 
+    /* Reclaim the deferred nodes, the remaining ones are freed directly */
+    if (rib->dq && cne_rcu_qsbr_dq_delete(rib->dq) != 0)
+        CNE_WARN("RIB6 %s has nodes still in use by readers\n", rib->name);
+    rib->dq = NULL;
+    rib->v  = NULL;
+
     while ((tmp = cne_rib6_get_nxt(rib, 0, 0, tmp, CNE_RIB6_GET_NXT_ALL)) != NULL)
         cne_rib6_remove(rib, tmp->ip, tmp->depth);
 
@@ -466,3 +511,33 @@ cne_rib6_free(struct cne_rib6 *rib)
     mmap_free(rib->mm);
     free(rib);
 }
+
+int
+cne_rib6_rcu_qsbr_add(struct cne_rib6 *rib, struct cne_rcu_qsbr *v)
+{
+    struct cne_rcu_qsbr_dq_parameters params = {0};
+    char rcu_dq_name[CNE_RCU_QSBR_DQ_NAMESIZE];
+
+    if (rib == NULL || v == NULL)
+        return -EINVAL;
+
+    if (rib->dq != NULL)
+        return -EEXIST;
+
+    snprintf(rcu_dq_name, sizeof(rcu_dq_name), "RIB6_RCU_%s", rib->name);
+    params.name             = rcu_dq_name;
+    params.size             = rib->max_nodes;
+    params.max_reclaim_size = RIB_RCU_DQ_RECLAIM_MAX;
+    params.esize            = sizeof(struct cne_rib6_node *);
+    params.free_fn          = __rcu_qsbr_free_resource;
+    params.p                = rib;
+    params.v                = v;
+
+    rib->dq = cne_rcu_qsbr_dq_create(&params);
+    if (rib->dq == NULL)
+        CNE_ERR_RET_VAL(-ENOMEM, "RIB6 defer queue creation failed\n");
+
+    rib->v = v;
+
+    return 0;
+}
@@ -35,6 +35,7 @@ enum {
 };
 
 struct cne_rib6;
+struct cne_rcu_qsbr;
 struct cne_rib6_node;
 
 /** RIB configuration structure */
@@ -300,6 +301,24 @@ CNDP_API struct cne_rib6 *cne_rib6_create(const char *name, const struct cne_rib
  */
 CNDP_API void cne_rib6_free(struct cne_rib6 *rib);
 
+/**
+ * Associate a RCU QSBR variable with the RIB.
+ *
+ * Nodes unlinked by cne_rib6_remove() are placed on a defer queue and only
+ * returned to the node pool once the reader threads registered with the QSBR
+ * variable have reported a quiescent state, so lookups running on other
+ * threads never walk a recycled node.
+ *
+ * @param rib
+ *   RIB object handle
+ * @param v
+ *   RCU QSBR variable
+ * @return
+ *   0 on success, -EINVAL for invalid arguments, -EEXIST if already added
+ *   or -ENOMEM if the defer queue can not be created.
+ */
+CNDP_API int cne_rib6_rcu_qsbr_add(struct cne_rib6 *rib, struct cne_rcu_qsbr *v);
+
 #ifdef __cplusplus
 }
 #endif
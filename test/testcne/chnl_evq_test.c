@@ -0,0 +1,379 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright (c) 2023 Intel Corporation
+ */
+
+#include <stdio.h>                  // for NULL, EOF
+#include <stdint.h>                 // for uint32_t, uint64_t
+#include <stdlib.h>                 // for calloc, free
+#include <errno.h>                  // for EBUSY, EXDEV, EINVAL
+#include <getopt.h>                 // for getopt_long, option
+#include <pthread.h>                // for PTHREAD_MUTEX_RECURSIVE
+#include <sys/socket.h>             // for AF_INET, SOCK_DGRAM, SHUT_RDWR
+#include <netinet/in.h>             // for IPPROTO_UDP
+#include <tst_info.h>               // for tst_end, tst_ok, TST_ASSERT_GOTO, tst_start
+#include <cne_cycles.h>             // for cne_rdtsc, cne_get_timer_hz
+#include <cne_mutex_helper.h>       // for cne_mutex_create, cne_mutex_destroy
+#include <cne_vec.h>                // for vec_free, vec_len
+#include <mempool.h>                // for mempool_cfg, mempool_create, mempool_destroy
+#include <cnet.h>                   // for cnet, this_cnet
+#include <cnet_stk.h>               // for stk_t, stk_get, stk_set
+#include <cnet_pcb.h>               // for pcb_entry
+#include <cnet_udp.h>               // for udp_entry
+#include <cnet_protosw.h>           // for cnet_protosw_add, protosw_entry
+#include <cnet_chnl.h>              // for channel, chnl_evq_create, chnl_evq_wait
+#include <chnl_priv.h>              // for chnl, ch_get, chnl_notify
+
+#include "chnl_evq_test.h"
+
+#define EVQ_NB_CHNLS 4    /**< Channels used by the tests */
+#define EVQ_NB_PCBS  16   /**< PCBs of the test stack instance */
+#define EVQ_BUF_SIZE 4096 /**< UDP send and receive buffer size */
+#define EVQ_WAIT_MS  10   /**< Timeout of a wait with no event */
+
+/* The stack instance of the channels, only the parts used to open and free UDP channels */
+struct evq_stk {
+    stk_t stk;
+    struct udp_entry udp;
+};
+
+static void
+evq_stk_destroy(struct evq_stk *es)
+{
+    struct protosw_entry *psw;
+
+    if (!es)
+        return;
+
+    vec_foreach_ptr (psw, es->stk.protosw_vec)
+        free(psw);
+    vec_free(es->stk.protosw_vec);
+    vec_free(es->udp.udp_hd.vec);
+    mempool_destroy(es->stk.chnl_objs);
+    mempool_destroy(es->stk.pcb_objs);
+    cne_mutex_destroy(&es->stk.mutex);
+    free(es);
+}
+
+static struct evq_stk *
+evq_stk_create(void)
+{
+    struct mempool_cfg cfg = {0};
+    struct evq_stk *es;
+
+    es = calloc(1, sizeof(struct evq_stk));
+    if (!es)
+        return NULL;
+
+    if (cne_mutex_create(&es->stk.mutex, PTHREAD_MUTEX_RECURSIVE)) {
+        free(es);
+        return NULL;
+    }
+    es->stk.udp      = &es->udp;
+    es->udp.rcv_size = EVQ_BUF_SIZE;
+    es->udp.snd_size = EVQ_BUF_SIZE;
+
+    cfg.objcnt       = EVQ_NB_PCBS;
+    cfg.objsz        = sizeof(struct pcb_entry);
+    es->stk.pcb_objs = mempool_create(&cfg);
+    if (!es->stk.pcb_objs) {
+        evq_stk_destroy(es);
+        return NULL;
+    }
+
+    /* The channels are created on this stack instance, cnet_protosw_add() uses this_stk */
+    stk_set(&es->stk);
+    if (!cnet_protosw_add("UDP", AF_INET, SOCK_DGRAM, IPPROTO_UDP)) {
+        evq_stk_destroy(es);
+        return NULL;
+    }
+
+    return es;
+}
+
+/* Open the channels of a test, no channel callback is set */
+static int
+evq_open(int *cds, int nb)
+{
+    for (int i = 0; i < nb; i++) {
+        cds[i] = channel(AF_INET, SOCK_DGRAM, IPPROTO_UDP, NULL);
+        if (cds[i] < 0) {
+            while (i--)
+                chnl_shutdown(cds[i], SHUT_RDWR);
+            return -1;
+        }
+    }
+    return 0;
+}
+
+/* Shutting down both directions frees the channel */
+static void
+evq_close(int *cds, int nb)
+{
+    for (int i = 0; i < nb; i++) {
+        if (cds[i] >= 0 && ch_get(cds[i]))
+            chnl_shutdown(cds[i], SHUT_RDWR);
+        cds[i] = -1;
+    }
+}
+
+/* Collect the events without waiting and check them against the expected events */
+static int
+evq_expect(struct chnl_evq *evq, int *cds, uint32_t *want, int nb)
+{
+    struct chnl_event evs[EVQ_NB_CHNLS + 1];
+    int n, found = 0;
+
+    for (int i = 0; i < nb; i++)
+        found += (want[i] != 0);
+
+    n = chnl_evq_wait(evq, evs, EVQ_NB_CHNLS + 1, 0);
+    TST_ASSERT_GOTO(n == found, "Got %d channels with events expected %d", err, n, found);
+
+    for (int j = 0; j < n; j++) {
+        int i;
+
+        for (i = 0; i < nb; i++)
+            if (evs[j].cd == cds[i])
+                break;
+        TST_ASSERT_GOTO(i < nb && evs[j].events == want[i],
+                        "Channel %d events %02x are not expected", err, evs[j].cd,
+                        evs[j].events);
+    }
+    return 0;
+err:
+    return -1;
+}
+
+/* Channels report their masked events once per wait, removed channels report nothing */
+static int
+test_evq_add_del_wait(void)
+{
+    struct chnl_evq *evq = NULL, *evq2 = NULL;
+    struct chnl_event evs[EVQ_NB_CHNLS];
+    int cds[EVQ_NB_CHNLS] = {-1, -1, -1, -1};
+    uint32_t want[EVQ_NB_CHNLS];
+    uint64_t start, hz = cne_get_timer_hz();
+    struct chnl *ch;
+    int n;
+
+    evq  = chnl_evq_create("evq_test");
+    evq2 = chnl_evq_create("evq_test2");
+    TST_ASSERT_GOTO(evq && evq2, "Failed to create the event queues", err);
+    TST_ASSERT_GOTO(evq_open(cds, 3) == 0, "Failed to open the channels", err);
+
+    TST_ASSERT_GOTO(chnl_evq_add(evq, cds[0], 0) < 0 && errno == EINVAL,
+                    "Channel added without events", err);
+    TST_ASSERT_GOTO(chnl_evq_add(evq, cds[0], 0x100) < 0 && errno == EINVAL,
+                    "Channel added with an unknown event", err);
+    TST_ASSERT_GOTO(chnl_evq_add(evq, -1, CHNL_EV_RECV) < 0, "Invalid channel added", err);
+    TST_ASSERT_GOTO(chnl_evq_del(cds[0]) < 0, "Channel removed before it was added", err);
+
+    TST_ASSERT_GOTO(chnl_evq_add(evq, cds[0], CHNL_EV_RECV | CHNL_EV_CLOSE) == 0 &&
+                        chnl_evq_add(evq, cds[1], CHNL_EV_RECV) == 0 &&
+                        chnl_evq_add(evq, cds[2], CHNL_EV_ALL) == 0,
+                    "Failed to add the channels", err);
+    TST_ASSERT_GOTO(chnl_evq_add(evq2, cds[0], CHNL_EV_RECV) < 0 && errno == EBUSY,
+                    "Channel added to a second queue", err);
+    if (evq_expect(evq, cds, (uint32_t[]){0, 0, 0}, 3) < 0)
+        goto err;
+
+    /* Events are merged until collected and the masked ones are dropped */
+    chnl_notify(ch_get(cds[0]), CHNL_UDP_RECV_TYPE);
+    chnl_notify(ch_get(cds[0]), CHNL_UDP_RECV_TYPE);
+    chnl_notify(ch_get(cds[0]), CHNL_UDP_CLOSE_TYPE);
+    chnl_notify(ch_get(cds[1]), CHNL_UDP_SENT_TYPE);
+    chnl_notify(ch_get(cds[2]), CHNL_TCP_ESTABLISHED_TYPE);
+    chnl_notify(ch_get(cds[2]), CHNL_UDP_SENT_TYPE);
+    want[0] = CHNL_EV_RECV | CHNL_EV_CLOSE;
+    want[1] = 0;
+    want[2] = CHNL_EV_ESTABLISHED | CHNL_EV_SENT;
+    if (evq_expect(evq, cds, want, 3) < 0 || evq_expect(evq, cds, (uint32_t[]){0, 0, 0}, 3) < 0)
+        goto err;
+    tst_ok("Events are merged per channel and masked events are dropped");
+
+    /* A smaller array leaves the other channels queued for the next wait */
+    chnl_notify(ch_get(cds[1]), CHNL_UDP_RECV_TYPE);
+    chnl_notify(ch_get(cds[2]), CHNL_UDP_RECV_TYPE);
+    n = chnl_evq_wait(evq, evs, 1, 0);
+    TST_ASSERT_GOTO(n == 1, "Got %d channels with an array of one", err, n);
+    n = chnl_evq_wait(evq, evs, EVQ_NB_CHNLS, 0);
+    TST_ASSERT_GOTO(n == 1, "Got %d channels left in the queue", err, n);
+
+    start = cne_rdtsc();
+    n     = chnl_evq_wait(evq, evs, EVQ_NB_CHNLS, EVQ_WAIT_MS);
+    TST_ASSERT_GOTO(n == 0 && cne_rdtsc() - start >= (hz * EVQ_WAIT_MS) / 1000,
+                    "Wait with no event returned %d before the timeout", err, n);
+    tst_ok("Waits return up to max channels and time out without events");
+
+    /* A removed channel reports nothing, it can only be removed once */
+    TST_ASSERT_GOTO(chnl_evq_del(cds[1]) == 0, "Failed to remove a channel", err);
+    TST_ASSERT_GOTO(chnl_evq_del(cds[1]) < 0, "Channel removed twice", err);
+    chnl_notify(ch_get(cds[1]), CHNL_UDP_RECV_TYPE);
+    if (evq_expect(evq, cds, (uint32_t[]){0, 0, 0}, 3) < 0)
+        goto err;
+
+    /* Data received before the channel is added is reported when it is added */
+    ch               = ch_get(cds[1]);
+    ch->ch_rcv.cb_cc = 100;
+    TST_ASSERT_GOTO(chnl_evq_add(evq, cds[1], CHNL_EV_RECV) == 0, "Failed to add again", err);
+    ch->ch_rcv.cb_cc = 0;
+    if (evq_expect(evq, cds, (uint32_t[]){0, CHNL_EV_RECV, 0}, 3) < 0)
+        goto err;
+
+    /* All of the channels of a queue are on the same stack instance */
+    TST_ASSERT_GOTO(evq_open(&cds[3], 1) == 0, "Failed to open a channel", err);
+    ch         = ch_get(cds[3]);
+    ch->stk_id = 5;
+    TST_ASSERT_GOTO(chnl_evq_add(evq, cds[3], CHNL_EV_RECV) < 0 && errno == EXDEV,
+                    "Channel of another stack instance added", err);
+    ch->stk_id = 0;
+    tst_ok("Channels are removed and added again");
+
+    evq_close(cds, EVQ_NB_CHNLS);
+    chnl_evq_destroy(evq);
+    chnl_evq_destroy(evq2);
+    return 0;
+err:
+    evq_close(cds, EVQ_NB_CHNLS);
+    chnl_evq_destroy(evq);
+    chnl_evq_destroy(evq2);
+    return -1;
+}
+
+/* A channel removed and added again while its descriptor is queued is queued only once */
+static int
+test_evq_readd(void)
+{
+    struct chnl_evq *evq = NULL, *evq2 = NULL;
+    int cds[EVQ_NB_CHNLS] = {-1, -1, -1, -1};
+    uint32_t loops;
+
+    evq  = chnl_evq_create("evq_test");
+    evq2 = chnl_evq_create("evq_test2");
+    TST_ASSERT_GOTO(evq && evq2, "Failed to create the event queues", err);
+    TST_ASSERT_GOTO(evq_open(cds, 1) == 0, "Failed to open a channel", err);
+
+    /* More cycles than the ring has room for, the ring would fill if each one queued again */
+    loops = 2 * this_cnet->num_chnls + 2;
+    for (uint32_t i = 0; i < loops; i++) {
+        TST_ASSERT_GOTO(chnl_evq_add(evq, cds[0], CHNL_EV_RECV) == 0, "Failed to add", err);
+        chnl_notify(ch_get(cds[0]), CHNL_UDP_RECV_TYPE);
+        TST_ASSERT_GOTO(chnl_evq_del(cds[0]) == 0, "Failed to remove", err);
+    }
+    TST_ASSERT_GOTO(chnl_evq_add(evq, cds[0], CHNL_EV_RECV) == 0, "Failed to add", err);
+    chnl_notify(ch_get(cds[0]), CHNL_UDP_RECV_TYPE);
+    if (evq_expect(evq, cds, (uint32_t[]){CHNL_EV_RECV}, 1) < 0 ||
+        evq_expect(evq, cds, (uint32_t[]){0}, 1) < 0)
+        goto err;
+    tst_ok("Channel added again while queued is reported once");
+
+    /* The descriptor left in the first queue does not hide the events from the second one */
+    chnl_notify(ch_get(cds[0]), CHNL_UDP_RECV_TYPE);
+    TST_ASSERT_GOTO(chnl_evq_del(cds[0]) == 0, "Failed to remove", err);
+    TST_ASSERT_GOTO(chnl_evq_add(evq2, cds[0], CHNL_EV_RECV) == 0, "Failed to add", err);
+    chnl_notify(ch_get(cds[0]), CHNL_UDP_RECV_TYPE);
+    if (evq_expect(evq2, cds, (uint32_t[]){CHNL_EV_RECV}, 1) < 0 ||
+        evq_expect(evq, cds, (uint32_t[]){0}, 1) < 0)
+        goto err;
+    tst_ok("Channel moved while queued is reported by its new queue");
+
+    evq_close(cds, EVQ_NB_CHNLS);
+    chnl_evq_destroy(evq);
+    chnl_evq_destroy(evq2);
+    return 0;
+err:
+    evq_close(cds, EVQ_NB_CHNLS);
+    chnl_evq_destroy(evq);
+    chnl_evq_destroy(evq2);
+    return -1;
+}
+
+/* A channel freed while it is queued leaves the queue and its descriptor is skipped */
+static int
+test_evq_close(void)
+{
+    int cds[EVQ_NB_CHNLS] = {-1, -1, -1, -1};
+    struct chnl_evq *evq;
+    struct chnl *ch;
+    int cd;
+
+    evq = chnl_evq_create("evq_test");
+    TST_ASSERT_GOTO(evq, "Failed to create the event queue", err);
+    TST_ASSERT_GOTO(evq_open(cds, 2) == 0, "Failed to open the channels", err);
+
+    TST_ASSERT_GOTO(chnl_evq_add(evq, cds[0], CHNL_EV_ALL) == 0 &&
+                        chnl_evq_add(evq, cds[1], CHNL_EV_ALL) == 0,
+                    "Failed to add the channels", err);
+    chnl_notify(ch_get(cds[0]), CHNL_UDP_RECV_TYPE);
+    chnl_notify(ch_get(cds[1]), CHNL_UDP_RECV_TYPE);
+
+    /* Free the first channel while it is queued and reuse its descriptor */
+    cd = cds[0];
+    evq_close(cds, 1);
+    TST_ASSERT_GOTO(ch_get(cd) == NULL, "Channel %d not freed", err, cd);
+    if (evq_expect(evq, &cds[1], (uint32_t[]){CHNL_EV_RECV}, 1) < 0)
+        goto err;
+
+    TST_ASSERT_GOTO(evq_open(&cds[2], 1) == 0, "Failed to open a channel", err);
+    ch = ch_get(cds[2]);
+    TST_ASSERT_GOTO(ch->ch_evq == NULL && ch->ch_evmask == 0 && ch->ch_evpend == 0,
+                    "New channel is in the event queue", err);
+    chnl_notify(ch, CHNL_UDP_RECV_TYPE);
+    if (evq_expect(evq, &cds[1], (uint32_t[]){0}, 1) < 0)
+        goto err;
+    tst_ok("Channel freed while queued leaves the queue");
+
+    /*
+     * Once the last channel is freed the queue is empty and takes the channels of any stack
+     * instance again.
+     */
+    chnl_notify(ch_get(cds[1]), CHNL_UDP_RECV_TYPE);
+    evq_close(&cds[1], 1);
+    if (evq_expect(evq, cds, (uint32_t[]){0}, 0) < 0)
+        goto err;
+    ch->stk_id = 5;
+    TST_ASSERT_GOTO(chnl_evq_add(evq, cds[2], CHNL_EV_RECV) == 0,
+                    "Queue still holds the freed channels", err);
+    ch->stk_id = 0;
+    evq_close(&cds[2], 1);
+    tst_ok("Queue is empty once all of its channels are freed");
+
+    chnl_evq_destroy(evq);
+    return 0;
+err:
+    evq_close(cds, EVQ_NB_CHNLS);
+    chnl_evq_destroy(evq);
+    return -1;
+}
+
+int
+chnl_evq_main(int argc, char **argv)
+{
+    static const struct option lgopts[] = {{NULL, 0, 0, 0}};
+    stk_t *saved_stk   = stk_get();
+    struct evq_stk *es = NULL;
+    tst_info_t *tst;
+    int option_index, opt;
+
+    optind = 0;
+    while ((opt = getopt_long(argc, argv, "", lgopts, &option_index)) != EOF)
+        ;
+
+    tst = tst_start("Channel event queue");
+
+    es = evq_stk_create();
+    TST_ASSERT_GOTO(es != NULL, "Failed to create the stack instance", err);
+
+    if (test_evq_add_del_wait() < 0 || test_evq_readd() < 0 || test_evq_close() < 0)
+        goto err;
+
+    stk_set(saved_stk);
+    evq_stk_destroy(es);
+    tst_end(tst, TST_PASSED);
+    return 0;
+err:
+    stk_set(saved_stk);
+    evq_stk_destroy(es);
+    tst_end(tst, TST_FAILED);
+    return -1;
+}
@@ -0,0 +1,24 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright (c) 2023 Intel Corporation
+ */
+
+#ifndef _CHNL_EVQ_TEST_H_
+#define _CHNL_EVQ_TEST_H_
+
+/**
+ * @file
+ * CNET channel event queue Test
+ *
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+int chnl_evq_main(int argc, char **argv);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _CHNL_EVQ_TEST_H_ */
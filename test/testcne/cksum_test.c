@@ -0,0 +1,182 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright (c) 2023 Intel Corporation
+ */
+
+// IWYU pragma: no_include <bits/getopt_core.h>
+
+#include <stdio.h>             // for EOF, NULL, size_t
+#include <stdint.h>            // for uint64_t, uint32_t, uint16_t
+#include <stdlib.h>            // for rand, malloc, free
+#include <string.h>            // for memcpy, memset
+#include <getopt.h>            // for getopt_long, option
+#include <tst_info.h>          // for tst_ok, tst_end, tst_start, tst_info_t
+#include <cne_common.h>        // for CNE_SET_USED
+#include <cne_cycles.h>        // for cne_rdtsc_precise
+#include <net/cne_ip.h>        // for __cne_raw_cksum_reduce
+#include <net/cne_cksum.h>     // for cne_cksum_sum, cne_cksum_update16, cne_cksum_update32
+
+#include "cksum_test.h"
+
+#define CKSUM_BUF_SIZE  (64 * 1024 + 64) /**< Largest buffer plus room for the offsets */
+#define CKSUM_MAX_CHECK 2048             /**< Largest length checked against the reference */
+#define CKSUM_PROF_SIZE (256 * 1024 * 1024ULL) /**< Bytes summed for each profiled size */
+
+static uint64_t sizes[] = {20, 40, 64, 128, 256, 512, 1024, 1500, 2048, 4096, 9000, 65535, 0};
+
+/* The sum of 16 bit words, as done before the vector sum was added */
+static uint32_t
+cksum_ref(const void *buf, size_t len, uint32_t sum)
+{
+    const uint8_t *p = buf;
+
+    for (; len >= 2; len -= 2, p += 2) {
+        uint16_t w;
+
+        memcpy(&w, p, sizeof(w));
+        sum += w;
+    }
+    if (len == 1) {
+        uint16_t left     = 0;
+        *(uint8_t *)&left = *p;
+        sum += left;
+    }
+
+    return sum;
+}
+
+static uint16_t
+cksum_of(const uint8_t *buf, size_t len)
+{
+    return ~__cne_raw_cksum_reduce(cksum_ref(buf, len, 0));
+}
+
+/* Checksums differing only in the representation of zero are the same */
+static int
+cksum_same(uint16_t a, uint16_t b)
+{
+    return a == b || ((uint16_t)(a + 1) <= 1 && (uint16_t)(b + 1) <= 1);
+}
+
+static int
+cksum_check(uint8_t *buf)
+{
+    for (int off = 0; off < 8; off++) {
+        for (size_t len = 0; len <= CKSUM_MAX_CHECK; len++) {
+            uint32_t init = rand() & 0xffff;
+            uint16_t ref  = __cne_raw_cksum_reduce(cksum_ref(buf + off, len, init));
+            uint16_t sum  = __cne_raw_cksum_reduce(cne_cksum_sum(buf + off, len, init));
+
+            TST_ASSERT(ref == sum, "Sum of %zu bytes at offset %d is %04x, expected %04x", len,
+                       off, sum, ref);
+        }
+    }
+
+    /* All ones data keeps the 64 bit sum at its largest */
+    memset(buf, 0xff, CKSUM_BUF_SIZE);
+    TST_ASSERT(__cne_raw_cksum_reduce(cne_cksum_sum(buf, 65535, 0xffff)) ==
+                   __cne_raw_cksum_reduce(cksum_ref(buf, 65535, 0xffff)),
+               "Sum of all ones mismatch");
+
+    return 0;
+}
+
+static int
+cksum_check_update(uint8_t *buf)
+{
+    for (int i = 0; i < 100000; i++) {
+        uint16_t w16, n16, cksum, upd;
+        uint32_t w32, n32;
+
+        for (int j = 0; j < 40; j++)
+            buf[j] = rand();
+
+        cksum = cksum_of(buf, 40);
+        n16   = rand();
+        memcpy(&w16, &buf[10], sizeof(w16));
+        memcpy(&buf[10], &n16, sizeof(n16));
+        upd = cne_cksum_update16(cksum, w16, n16);
+        TST_ASSERT(cksum_same(upd, cksum_of(buf, 40)), "16 bit update %04x, expected %04x", upd,
+                   cksum_of(buf, 40));
+
+        cksum = cksum_of(buf, 40);
+        n32   = ((uint32_t)rand() << 16) ^ rand();
+        memcpy(&w32, &buf[12], sizeof(w32));
+        memcpy(&buf[12], &n32, sizeof(n32));
+        upd = cne_cksum_update32(cksum, w32, n32);
+        TST_ASSERT(cksum_same(upd, cksum_of(buf, 40)), "32 bit update %04x, expected %04x", upd,
+                   cksum_of(buf, 40));
+    }
+
+    return 0;
+}
+
+static uint64_t
+runsum(const uint8_t *buf, uint64_t len, uint32_t (*fn)(const void *b, size_t l, uint32_t s))
+{
+    uint64_t iter  = CKSUM_PROF_SIZE / len;
+    uint64_t begin = cne_rdtsc_precise();
+    volatile uint32_t sum;
+
+    for (uint64_t i = 0; i < iter; i++)
+        sum = fn(buf, len, 0);
+    CNE_SET_USED(sum);
+
+    return (cne_rdtsc_precise() - begin) / iter;
+}
+
+int
+cksum_main(int argc, char **argv)
+{
+    tst_info_t *tst;
+    int verbose = 0, opt;
+    char **argvopt;
+    int option_index;
+    static const struct option lgopts[] = {{NULL, 0, 0, 0}};
+    uint8_t *buf;
+
+    argvopt = argv;
+
+    optind = 0;
+    while ((opt = getopt_long(argc, argvopt, "V", lgopts, &option_index)) != EOF) {
+        switch (opt) {
+        case 'V':
+            verbose = 1;
+            break;
+        default:
+            break;
+        }
+    }
+    CNE_SET_USED(verbose);
+
+    tst = tst_start("checksum test/profile");
+
+    buf = malloc(CKSUM_BUF_SIZE);
+    if (!buf)
+        goto err;
+    for (int i = 0; i < CKSUM_BUF_SIZE; i++)
+        buf[i] = rand();
+
+    if (cksum_check(buf) < 0 || cksum_check_update(buf) < 0)
+        goto err;
+    tst_ok("Sums of 0 to %d bytes and RFC 1624 updates match the reference", CKSUM_MAX_CHECK);
+
+    tst_ok("%10s|%10s|%10s|%10s|\n", " ", "cksum_sum", "reference", " ");
+    tst_ok("%10s|%10s|%10s|%10s|\n", "bytes", "cycles", "cycles", "speedup");
+    for (int i = 0; sizes[i]; i++) {
+        uint64_t vec_cycles = runsum(buf, sizes[i], cne_cksum_sum);
+        uint64_t ref_cycles = runsum(buf, sizes[i], cksum_ref);
+
+        tst_ok("%10ld|%10ld|%10ld|%9.1fx|\n", sizes[i], vec_cycles, ref_cycles,
+               (vec_cycles) ? (double)ref_cycles / vec_cycles : 0.0);
+    }
+
+    free(buf);
+    tst_end(tst, TST_PASSED);
+
+    return 0;
+err:
+    free(buf);
+    tst_end(tst, TST_FAILED);
+
+    return -1;
+}
@@ -14,6 +14,8 @@
 
 #include "testcne.h"                  // for init_tree, my_prompt, setup_cli
 #include "acl_test.h"                 // for acl_main
+#include "chnl_evq_test.h"            // for chnl_evq_main
+#include "cksum_test.h"               // for cksum_main
 #include "cne_register_test.h"        // for cne_register_main
 #include "cthread_test.h"             // for cthread_main
 #include "dsa_test.h"                 // for dsa_main
@@ -26,6 +28,15 @@
 #include "pktcpy_test.h"              // for pktcpy_main
 #include "cne_lport.h"                // for lport_stats_t
 #include "pkt_test.h"                 // for pkt_main
+#include "pcb_test.h"                 // for pcb_perf_main
+#include "pcb_reuseport_test.h"       // for pcb_reuseport_main
+#include "frag_test.h"                // for frag_main
+#include "tcp_cc_test.h"              // for tcp_cc_main
+#include "tcp_gro_test.h"             // for tcp_gro_main
+#include "tcp_gso_test.h"             // for tcp_gso_main
+#include "tcp_pace_test.h"            // for tcp_pace_main
+#include "tcp_sack_test.h"            // for tcp_sack_main
+#include "tcp_timer_test.h"           // for tcp_timer_main
 #include "ring_test.h"                // for ring_main
 #include "ring_api.h"                 // for ring_api_main
 #include "ring_profile.h"             // for ring_profile
@@ -40,6 +51,7 @@
 #include "netdev_funcs.h"             // for netdev_link
 #include "log_test.h"                 // for log_main
 #include "hash_test.h"                // for hash_main, hash_perf_main
+#include "rcu_test.h"                 // for rcu_main
 #include "rib_test.h"                 // for rib_main, rib6_main
 #include "fib_test.h"                 // for fib_main, fib_perf_main, fib6_main, fib6_perf_main
 #ifdef HAS_UINTR_SUPPORT
@@ -64,7 +76,7 @@ sizeof_cmd(int argc, char **argv)
     struct struct_sizes ssizes[] = {
         {"mmap_sizes_t", sizeof(mmap_sizes_t)},
         {"mmap_stats_t", sizeof(mmap_stats_t)},
-        {"pktmbuf_t", sizeof(pktmbuf_t), 64},
+        {"pktmbuf_t", sizeof(pktmbuf_t), 128},
         {"lport_stats", sizeof(lport_stats_t)},
         {"netdev_link", sizeof(struct netdev_link)},
         {"pktdev_info", sizeof(struct pktdev_info)},
@@ -102,6 +114,8 @@ static int
 all_tests(int argc, char **argv)
 {
     acl_main(argc, argv);
+    chnl_evq_main(argc, argv);
+    cksum_main(argc, argv);
     cne_register_main(argc, argv);
     cthread_main(argc, argv);
     dsa_main(argc, argv);
@@ -109,6 +123,7 @@ all_tests(int argc, char **argv)
     fib_perf_main(argc, argv);
     fib6_main(argc, argv);
     fib6_perf_main(argc, argv);
+    frag_main(argc, argv);
     graph_main(argc, argv);
     graph_perf_main(argc, argv);
     hash_main(argc, argv);
@@ -127,15 +142,24 @@ all_tests(int argc, char **argv)
     mmap_main(argc, argv);
     meter_main(argc, argv);
     msgchan_main(argc, argv);
+    pcb_perf_main(argc, argv);
+    pcb_reuseport_main(argc, argv);
     pkt_main(argc, argv);
     pktcpy_main(argc, argv);
     pktdev_main(argc, argv);
+    rcu_main(argc, argv);
     rib_main(argc, argv);
     rib6_main(argc, argv);
     ring_api_main(argc, argv);
     ring_main(argc, argv);
     ring_profile(argc, argv);
     tailqs_main(argc, argv);
+    tcp_cc_main(argc, argv);
+    tcp_gro_main(argc, argv);
+    tcp_gso_main(argc, argv);
+    tcp_pace_main(argc, argv);
+    tcp_sack_main(argc, argv);
+    tcp_timer_main(argc, argv);
     thread_main(argc, argv);
     timer_main(argc, argv);
     uid_main(argc, argv);
@@ -151,6 +175,8 @@ static struct cli_tree default_tree[] = {
 
     c_cmd("acl", acl_main, "Run the ACL tests"),
     c_cmd("all", all_tests, "Run all tests"),
+    c_cmd("chnl_evq", chnl_evq_main, "Run the channel event queue test"),
+    c_cmd("cksum", cksum_main, "Run the checksum test/profile"),
     c_cmd("cne", cne_register_main, "Run the CNE registration tests"),
     c_cmd("cthread", cthread_main, "Run the cthread API test"),
     c_cmd("dsa", dsa_main, "Run the dsa API test"),
@@ -158,6 +184,7 @@ static struct cli_tree default_tree[] = {
     c_cmd("fib_perf", fib_perf_main, "Run the FIB Perf test"),
     c_cmd("fib6", fib6_main, "Run the FIB6 test"),
     c_cmd("fib6_perf", fib6_perf_main, "Run the FIB6 Perf test"),
+    c_cmd("frag", frag_main, "Run the IP fragmentation test"),
     c_cmd("graph_perf", graph_perf_main, "Run the graph perf test"),
     c_cmd("graph", graph_main, "Run the graph test"),
     c_cmd("hash_perf", hash_perf_main, "Run the hash perf test"),
@@ -177,15 +204,24 @@ static struct cli_tree default_tree[] = {
     c_cmd("mmap", mmap_main, "Run MMAP test"),
     c_cmd("meter", meter_main, "Run Meter test"),
     c_cmd("msgchan", msgchan_main, "Run Message Channel test"),
+    c_cmd("pcb_perf", pcb_perf_main, "Run the PCB lookup perf test"),
+    c_cmd("pcb_reuseport", pcb_reuseport_main, "Run the PCB SO_REUSEPORT test"),
     c_cmd("pkt", pkt_main, "Run PKT test"),
     c_cmd("pktcpy", pktcpy_main, "Run pktcpy test"),
     c_cmd("pktdev", pktdev_main, "Run the pktdev tests"),
+    c_cmd("rcu", rcu_main, "Run the RCU QSBR test"),
     c_cmd("rib", rib_main, "Run RIB tests"),
     c_cmd("rib6", rib6_main, "Run RIB6 tests"),
     c_cmd("ring_api", ring_api_main, "Run RING api tests"),
     c_cmd("ring_profile", ring_profile, "Run RING profile test"),
     c_cmd("ring", ring_main, "Run RING test"),
     c_cmd("tailqs", tailqs_main, "Run TailQ test"),
+    c_cmd("tcp_cc", tcp_cc_main, "Run the TCP congestion control test"),
+    c_cmd("tcp_gro", tcp_gro_main, "Run the TCP GRO test"),
+    c_cmd("tcp_gso", tcp_gso_main, "Run the TCP GSO test"),
+    c_cmd("tcp_pace", tcp_pace_main, "Run the TCP pacing test"),
+    c_cmd("tcp_sack", tcp_sack_main, "Run the TCP SACK and RACK test"),
+    c_cmd("tcp_timer", tcp_timer_main, "Run the TCP timer wheel test"),
     c_cmd("sizeof", sizeof_cmd, "Size of structures"),
     c_cmd("thread", thread_main, "Run the Thread test"),
     c_cmd("timer", timer_main, "Run the Timer test"),
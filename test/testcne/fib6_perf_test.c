@@ -65,16 +65,55 @@ get_max_nh(uint8_t nh_sz)
     return ((1ULL << (bits_in_nh(nh_sz) - 1)) - 1);
 }
 
+struct lookup_type {
+    enum cne_fib_lookup_type type; /**< Lookup implementation to select */
+    const char *name;              /**< Name printed with the result */
+};
+
+static const struct lookup_type lookup_types[] = {
+    {CNE_FIB_LOOKUP_TRIE_SCALAR, "scalar"},
+    {CNE_FIB_LOOKUP_TRIE_VECTOR_AVX512, "vector AVX512"},
+    {CNE_FIB_LOOKUP_DEFAULT, "default"},
+};
+
+static void
+measure_lookup(struct cne_fib6 *fib, const struct lookup_type *lt,
+               uint8_t ip_batch[NUM_IPS_ENTRIES][16], uint64_t *next_hops)
+{
+    uint64_t begin, total_time = 0;
+    int64_t count = 0;
+    unsigned int i, j;
+
+    if (cne_fib6_select_lookup(fib, lt->type) < 0) {
+        cne_printf("BULK FIB Lookup (%s): not supported\n", lt->name);
+        return;
+    }
+
+    for (i = 0; i < ITERATIONS; i++) {
+
+        /* Lookup per batch */
+        begin = cne_rdtsc();
+        cne_fib6_lookup_bulk(fib, ip_batch, next_hops, NUM_IPS_ENTRIES);
+        total_time += cne_rdtsc() - begin;
+
+        for (j = 0; j < NUM_IPS_ENTRIES; j++)
+            if (next_hops[j] == 0)
+                count++;
+    }
+    cne_printf("BULK FIB Lookup (%s): %.1f cycles (fails = %.1f%%)\n", lt->name,
+               (double)total_time / ((double)ITERATIONS * BATCH_SIZE),
+               (count * 100.0) / (double)(ITERATIONS * BATCH_SIZE));
+}
+
 static int
 test_fib6_perf(void)
 {
     struct cne_fib6 *fib = NULL;
     struct cne_fib_conf conf;
     uint64_t begin, total_time;
-    unsigned int i, j;
+    unsigned int i;
     uint64_t next_hop_add;
-    int status    = 0;
-    int64_t count = 0;
+    int status = 0;
     uint8_t ip_batch[NUM_IPS_ENTRIES][16];
     uint64_t next_hops[NUM_IPS_ENTRIES];
 
@@ -113,27 +152,13 @@ test_fib6_perf(void)
     cne_printf("Unique added entries = %d\n", status);
     cne_printf("Average FIB Add: %g cycles\n", (double)total_time / NUM_ROUTE_ENTRIES);
 
-    /* Measure bulk Lookup */
-    total_time = 0;
-    count      = 0;
-
+    /* Measure bulk Lookup with every implementation the host supports */
     for (i = 0; i < NUM_IPS_ENTRIES; i++)
         memcpy(ip_batch[i], large_ips_table[i].ip, 16);
 
-    for (i = 0; i < ITERATIONS; i++) {
-
-        /* Lookup per batch */
-        begin = cne_rdtsc();
-        cne_fib6_lookup_bulk(fib, ip_batch, next_hops, NUM_IPS_ENTRIES);
-        total_time += cne_rdtsc() - begin;
-
-        for (j = 0; j < NUM_IPS_ENTRIES; j++)
-            if (next_hops[j] == 0)
-                count++;
-    }
-    cne_printf("BULK FIB Lookup: %.1f cycles (fails = %.1f%%)\n",
-               (double)total_time / ((double)ITERATIONS * BATCH_SIZE),
-               (count * 100.0) / (double)(ITERATIONS * BATCH_SIZE));
+    for (i = 0; i < CNE_DIM(lookup_types); i++)
+        measure_lookup(fib, &lookup_types[i], ip_batch, next_hops);
+    TEST_FIB_ASSERT(cne_fib6_select_lookup(fib, CNE_FIB_LOOKUP_DEFAULT) == 0);
 
     /* Delete */
     status = 0;
@@ -5,12 +5,15 @@
 
 #include <stdio.h>               // for NULL, EOF
 #include <stdint.h>              // for int32_t, uint64_t, uint8_t, uint32_t
+#include <stdlib.h>              // for rand
+#include <string.h>              // for memset
 #include <getopt.h>              // for getopt_long, option
 #include <cne_log.h>             // for CNE_LOG_ERR
 #include <cne_rib6.h>            // for get_msk_part
 #include <private_fib6.h>        // for CNE_FIB6_MAXDEPTH, IPV6_ADDR_LEN
 #include <cne_fib6.h>            // for cne_fib6_create, cne_fib6_conf, cne_fib6_free
 #include <tst_info.h>            // for tst_end, tst_start, TST_FAILED, TST_PASSED
+#include <trie.h>                // for cne_trie_tbl, get_tbl24_idx, is_entry_extended
 
 #include "test.h"            // for TEST_SUCCESS, TEST_CASE, unit_test_suite_r...
 #include "fib_test.h"        // for fib6_main
@@ -26,6 +29,7 @@ static int32_t test_free_null(void);
 static int32_t test_add_del_invalid(void);
 static int32_t test_get_invalid(void);
 static int32_t test_lookup(void);
+static int32_t test_lookup_pipelined(void);
 
 #define MAX_ROUTES (1 << 16)
 /** Maximum number of tbl8 for 2-byte entries */
@@ -343,13 +347,133 @@ test_lookup(void)
     return TEST_SUCCESS;
 }
 
+#define PIPE_NB_ROUTES 128
+#define PIPE_NB_IPS    1024
+
+/* Burst sizes given to the lookup, around and across the blocks of the pipelined lookup */
+static const unsigned int pipe_bursts[] = {1, 5, 15, 16, 17, 31, 33, 100, PIPE_NB_IPS};
+
+static uint64_t
+trie_ent(const void *tbl, uint64_t idx, enum cne_fib_trie_nh_sz nh_sz)
+{
+    switch (nh_sz) {
+    case CNE_FIB_TRIE_2B:
+        return ((const uint16_t *)tbl)[idx];
+    case CNE_FIB_TRIE_4B:
+        return ((const uint32_t *)tbl)[idx];
+    default:
+        return ((const uint64_t *)tbl)[idx];
+    }
+}
+
+/* The trie lookup one address at a time, as it was before it was pipelined */
+static uint64_t
+trie_lookup_ref(struct cne_trie_tbl *dp, const uint8_t ip[IPV6_ADDR_LEN])
+{
+    uint64_t tmp = trie_ent(dp->tbl24, get_tbl24_idx(ip), dp->nh_sz);
+    uint32_t j   = 3;
+
+    while (is_entry_extended(tmp))
+        tmp = trie_ent(dp->tbl8, ip[j++] + ((tmp >> 1) * TRIE_TBL8_GRP_NUM_ENT), dp->nh_sz);
+
+    return tmp >> 1;
+}
+
+/* Compare the scalar trie lookup with the per address lookup for every burst size */
+static int
+check_lookup_pipelined(struct cne_fib6 *fib, uint64_t max_nh)
+{
+    static uint8_t ips[PIPE_NB_IPS][IPV6_ADDR_LEN];
+    static uint64_t nh[PIPE_NB_IPS];
+    uint8_t route_ips[PIPE_NB_ROUTES][IPV6_ADDR_LEN];
+    uint8_t route_depths[PIPE_NB_ROUTES];
+    struct cne_trie_tbl *dp = cne_fib6_get_dp(fib);
+    unsigned int i, j, b, off;
+    uint64_t ref;
+    int ret;
+
+    /* Every eight routes are nested under one prefix, down to /128 through the tbl8 levels */
+    for (i = 0; i < PIPE_NB_ROUTES; i++) {
+        uint8_t prev_depth = (i & 7) ? route_depths[i - 1] : 0;
+
+        route_depths[i] = (i & 7) ? 16 + (i & 7) * 16 : 1 + (uint32_t)rand() % 24;
+        for (j = 0; j < IPV6_ADDR_LEN; j++) {
+            route_ips[i][j] = (j * 8 < prev_depth) ? route_ips[i - 1][j] : (uint8_t)rand();
+            route_ips[i][j] &= get_msk_part(route_depths[i], j);
+        }
+        ret = cne_fib6_add(fib, route_ips[i], route_depths[i], 1 + (rand() % max_nh));
+        CNE_TEST_ASSERT(ret == 0, "Failed to add a route\n");
+    }
+
+    /* Half of the addresses are under a route, the others are mostly missing */
+    for (i = 0; i < PIPE_NB_IPS; i++) {
+        uint32_t r = i % PIPE_NB_ROUTES;
+
+        for (j = 0; j < IPV6_ADDR_LEN; j++)
+            ips[i][j] = (i & 1) ? (uint8_t)rand()
+                                : route_ips[r][j] | ((uint8_t)rand() &
+                                                     ~get_msk_part(route_depths[r], j));
+    }
+
+    ret = cne_fib6_select_lookup(fib, CNE_FIB_LOOKUP_TRIE_SCALAR);
+    CNE_TEST_ASSERT(ret == 0, "Failed to select the scalar lookup\n");
+
+    for (b = 0; b < cne_countof(pipe_bursts); b++) {
+        memset(nh, 0xff, sizeof(nh));
+        for (off = 0; off + pipe_bursts[b] <= PIPE_NB_IPS; off += pipe_bursts[b])
+            cne_fib6_lookup_bulk(fib, &ips[off], &nh[off], pipe_bursts[b]);
+        for (i = 0; i < off; i++) {
+            ref = trie_lookup_ref(dp, ips[i]);
+            CNE_TEST_ASSERT(nh[i] == ref, "Address %u next hop %lu, %lu expected, burst %u\n", i,
+                            nh[i], ref, pipe_bursts[b]);
+        }
+    }
+
+    return TEST_SUCCESS;
+}
+
+int32_t
+test_lookup_pipelined(void)
+{
+    static const struct {
+        enum cne_fib_trie_nh_sz nh_sz;
+        uint64_t max_nh;
+        const char *name;
+    } sizes[] = {
+        {CNE_FIB_TRIE_2B, UINT16_MAX >> 1, "2B"},
+        {CNE_FIB_TRIE_4B, UINT32_MAX >> 1, "4B"},
+        {CNE_FIB_TRIE_8B, UINT32_MAX, "8B"},
+    };
+    struct cne_fib6 *fib = NULL;
+    struct cne_fib_conf config;
+    int ret;
+
+    config.max_routes    = MAX_ROUTES;
+    config.default_nh    = 0;
+    config.type          = CNE_FIB_TRIE;
+    config.trie.num_tbl8 = MAX_TBL8 - 1;
+
+    for (unsigned int i = 0; i < cne_countof(sizes); i++) {
+        config.trie.nh_sz = sizes[i].nh_sz;
+        fib               = cne_fib6_create(__func__, &config);
+        CNE_TEST_ASSERT(fib != NULL, "Failed to create FIB\n");
+        ret = check_lookup_pipelined(fib, sizes[i].max_nh);
+        cne_fib6_free(fib);
+        CNE_TEST_ASSERT(ret == TEST_SUCCESS, "Pipelined lookup mismatch for TRIE_%s type\n",
+                        sizes[i].name);
+    }
+
+    return TEST_SUCCESS;
+}
+
 static struct unit_test_suite fib6_fast_tests = {
     .suite_name      = "fib6 autotest",
     .setup           = NULL,
     .teardown        = NULL,
     .unit_test_cases = {TEST_CASE(test_create_invalid), TEST_CASE(test_free_null),
                         TEST_CASE(test_add_del_invalid), TEST_CASE(test_get_invalid),
-                        TEST_CASE(test_lookup), TEST_CASES_END()}};
+                        TEST_CASE(test_lookup), TEST_CASE(test_lookup_pipelined),
+                        TEST_CASES_END()}};
 
 static struct unit_test_suite fib6_slow_tests = {
     .suite_name      = "fib6 slow autotest",
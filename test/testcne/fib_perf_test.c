@@ -13,6 +13,7 @@
 #include <cne_branch_prediction.h>
 #include <net/cne_ip.h>
 #include <cne_fib.h>
+#include <cne_rcu_qsbr.h>
 #include <tst_info.h>
 #include <cne_log.h>
 
@@ -322,6 +323,130 @@ print_route_distribution(const struct route_rule *table, uint32_t n)
     cne_printf("\n");
 }
 
+struct lookup_type {
+    enum cne_fib_lookup_type type; /**< Lookup implementation to select */
+    const char *name;              /**< Name printed with the result */
+};
+
+static const struct lookup_type lookup_types[] = {
+    {CNE_FIB_LOOKUP_DIR24_8_SCALAR_MACRO, "scalar macro"},
+    {CNE_FIB_LOOKUP_DIR24_8_SCALAR_INLINE, "scalar inline"},
+    {CNE_FIB_LOOKUP_DIR24_8_SCALAR_UNI, "scalar unified"},
+    {CNE_FIB_LOOKUP_DIR24_8_VECTOR_AVX2, "vector AVX2"},
+    {CNE_FIB_LOOKUP_DIR24_8_VECTOR_AVX512, "vector AVX512"},
+    {CNE_FIB_LOOKUP_DEFAULT, "default"},
+};
+
+static void
+measure_lookup(struct cne_fib *fib, const struct lookup_type *lt)
+{
+    uint64_t begin, total_time = 0;
+    int64_t count = 0;
+    unsigned int i, j;
+
+    if (cne_fib_select_lookup(fib, lt->type) < 0) {
+        cne_printf("BULK FIB Lookup (%s): not supported\n", lt->name);
+        return;
+    }
+
+    for (i = 0; i < ITERATIONS; i++) {
+        static uint32_t ip_batch[BATCH_SIZE];
+        uint64_t next_hops[BULK_SIZE];
+
+        /* Create array of random IP addresses */
+        for (j = 0; j < BATCH_SIZE; j++)
+            ip_batch[j] = rand();
+
+        /* Lookup per batch */
+        begin = cne_rdtsc();
+        for (j = 0; j < BATCH_SIZE; j += BULK_SIZE) {
+            uint32_t k;
+            cne_fib_lookup_bulk(fib, &ip_batch[j], next_hops, BULK_SIZE);
+            for (k = 0; k < BULK_SIZE; k++)
+                if (unlikely(!(next_hops[k] != 0)))
+                    count++;
+        }
+
+        total_time += cne_rdtsc() - begin;
+    }
+    cne_printf("BULK FIB Lookup (%s): %.1f cycles (fails = %.1f%%)\n", lt->name,
+               (double)total_time / ((double)ITERATIONS * BATCH_SIZE),
+               (count * 100.0) / (double)(ITERATIONS * BATCH_SIZE));
+}
+
+/* Load the whole table one route at a time and in one batch, both must give the same FIB */
+static int
+test_fib_bulk_load(struct cne_fib_conf *config)
+{
+    struct cne_fib *fib = NULL, *bulk_fib = NULL;
+    struct cne_fib_rcu_config cfg = {0};
+    struct cne_fib_route *routes;
+    static uint32_t ip_batch[BATCH_SIZE];
+    static uint64_t next_hops[BATCH_SIZE], bulk_next_hops[BATCH_SIZE];
+    uint64_t begin, seq_time, bulk_time;
+    unsigned int i, j;
+    int ret = -1;
+
+    routes = calloc(NUM_ROUTE_ENTRIES, sizeof(*routes));
+    if (routes == NULL)
+        return -1;
+    for (i = 0; i < NUM_ROUTE_ENTRIES; i++) {
+        routes[i].ip       = large_route_table[i].ip;
+        routes[i].depth    = large_route_table[i].depth;
+        routes[i].op       = CNE_FIB_ADD;
+        routes[i].next_hop = (i % 1000) + 1;
+    }
+
+    fib      = cne_fib_create("fib_seq_load", config);
+    bulk_fib = cne_fib_create("fib_bulk_load", config);
+    if ((fib == NULL) || (bulk_fib == NULL))
+        goto exit;
+
+    /* A batch frees the replaced tables after a grace period, there are no readers here */
+    cfg.v    = cne_rcu_qsbr_create();
+    cfg.mode = CNE_FIB_QSBR_MODE_SYNC;
+    if ((cfg.v == NULL) || (cne_fib_rcu_qsbr_add(bulk_fib, &cfg) < 0))
+        goto exit;
+
+    begin = cne_rdtsc();
+    for (i = 0; i < NUM_ROUTE_ENTRIES; i++)
+        cne_fib_add(fib, routes[i].ip, routes[i].depth, routes[i].next_hop);
+    seq_time = cne_rdtsc() - begin;
+
+    begin = cne_rdtsc();
+    if (cne_fib_update_bulk(bulk_fib, routes, NUM_ROUTE_ENTRIES) < 0) {
+        cne_printf("Error at line %d:\n", __LINE__);
+        goto exit;
+    }
+    bulk_time = cne_rdtsc() - begin;
+
+    for (i = 0; i < ITERATIONS; i++) {
+        for (j = 0; j < BATCH_SIZE; j++)
+            ip_batch[j] = (j & 1) ? (uint32_t)rand() : routes[rand() % NUM_ROUTE_ENTRIES].ip;
+        cne_fib_lookup_bulk(fib, ip_batch, next_hops, BATCH_SIZE);
+        cne_fib_lookup_bulk(bulk_fib, ip_batch, bulk_next_hops, BATCH_SIZE);
+        for (j = 0; j < BATCH_SIZE; j++) {
+            if (next_hops[j] != bulk_next_hops[j]) {
+                cne_printf("Error: %08x next hop %lu after batch load, %lu expected\n",
+                           ip_batch[j], bulk_next_hops[j], next_hops[j]);
+                goto exit;
+            }
+        }
+    }
+
+    cne_printf("Full table load: %.1f Mcycles one route at a time, %.1f Mcycles in one batch\n",
+               (double)seq_time / 1e6, (double)bulk_time / 1e6);
+    ret = 0;
+
+exit:
+    cne_fib_free(bulk_fib);
+    cne_fib_free(fib);
+    cne_rcu_qsbr_free(cfg.v);
+    free(routes);
+
+    return ret;
+}
+
 static int
 test_fib_perf(void)
 {
@@ -334,10 +459,9 @@ test_fib_perf(void)
     config.dir24_8.nh_sz    = CNE_FIB_DIR24_8_4B;
     config.dir24_8.num_tbl8 = 65535;
     uint64_t begin, total_time;
-    unsigned int i, j;
+    unsigned int i;
     uint32_t next_hop_add = 0xAA;
     int status            = 0;
-    int64_t count         = 0;
 
     srand(cne_rdtsc());
 
@@ -367,32 +491,10 @@ test_fib_perf(void)
 
     cne_printf("Average FIB Add: %g cycles\n", (double)total_time / NUM_ROUTE_ENTRIES);
 
-    /* Measure bulk Lookup */
-    total_time = 0;
-    count      = 0;
-    for (i = 0; i < ITERATIONS; i++) {
-        static uint32_t ip_batch[BATCH_SIZE];
-        uint64_t next_hops[BULK_SIZE];
-
-        /* Create array of random IP addresses */
-        for (j = 0; j < BATCH_SIZE; j++)
-            ip_batch[j] = rand();
-
-        /* Lookup per batch */
-        begin = cne_rdtsc();
-        for (j = 0; j < BATCH_SIZE; j += BULK_SIZE) {
-            uint32_t k;
-            cne_fib_lookup_bulk(fib, &ip_batch[j], next_hops, BULK_SIZE);
-            for (k = 0; k < BULK_SIZE; k++)
-                if (unlikely(!(next_hops[k] != 0)))
-                    count++;
-        }
-
-        total_time += cne_rdtsc() - begin;
-    }
-    cne_printf("BULK FIB Lookup: %.1f cycles (fails = %.1f%%)\n",
-               (double)total_time / ((double)ITERATIONS * BATCH_SIZE),
-               (count * 100.0) / (double)(ITERATIONS * BATCH_SIZE));
+    /* Measure bulk Lookup with every implementation the host supports */
+    for (i = 0; i < CNE_DIM(lookup_types); i++)
+        measure_lookup(fib, &lookup_types[i]);
+    TEST_FIB_ASSERT(cne_fib_select_lookup(fib, CNE_FIB_LOOKUP_DEFAULT) == 0);
 
     /* Delete */
     status = 0;
@@ -402,13 +504,13 @@ test_fib_perf(void)
         status += cne_fib_delete(fib, large_route_table[i].ip, large_route_table[i].depth);
     }
 
-    total_time += cne_rdtsc() - begin;
+    total_time = cne_rdtsc() - begin;
 
     cne_printf("Average FIB Delete: %g cycles\n", (double)total_time / NUM_ROUTE_ENTRIES);
 
     cne_fib_free(fib);
 
-    return 0;
+    return test_fib_bulk_load(&config);
 }
 
 int
@@ -6,11 +6,15 @@
 #include <stdio.h>
 #include <stdint.h>
 #include <stdlib.h>
+#include <string.h>
+#include <errno.h>
 #include <getopt.h>
 
 #include <net/cne_ip.h>
 #include <cne_log.h>
 #include <cne_fib.h>
+#include <cne_rib.h>
+#include <cne_rcu_qsbr.h>
 #include <tst_info.h>
 
 #include "test.h"
@@ -24,6 +28,9 @@ static int32_t test_free_null(void);
 static int32_t test_add_del_invalid(void);
 static int32_t test_get_invalid(void);
 static int32_t test_lookup(void);
+static int32_t test_lookup_avx2(void);
+static int32_t test_lookup_tbl24_end(void);
+static int32_t test_update_bulk(void);
 
 #define MAX_ROUTES (1 << 16)
 #define MAX_TBL8   (1 << 15)
@@ -341,6 +348,331 @@ test_lookup(void)
     return TEST_SUCCESS;
 }
 
+#define VEC_NB_ROUTES 256
+#define VEC_NB_IPS    1024
+
+/* Burst sizes given to the lookups, most of them not a multiple of the 8 AVX2 lanes */
+static const unsigned int vec_bursts[] = {1, 3, 7, 8, 9, 15, 17, 31, 64, 100, VEC_NB_IPS};
+
+/* Compare the AVX2 lookup of a FIB with the scalar lookup for every burst size */
+static int
+check_lookup_avx2(struct cne_fib *fib, uint64_t max_nh)
+{
+    static uint32_t ips[VEC_NB_IPS];
+    static uint64_t ref_nh[VEC_NB_IPS], vec_nh[VEC_NB_IPS];
+    uint32_t route_ips[VEC_NB_ROUTES];
+    uint8_t route_depths[VEC_NB_ROUTES];
+    unsigned int i, b, off;
+    int ret;
+
+    /* One route in four is deeper than /24 and uses a tbl8 group */
+    for (i = 0; i < VEC_NB_ROUTES; i++) {
+        route_depths[i] = (i & 3) ? 8 + (rand() % 17) : 25 + (rand() % 8);
+        route_ips[i]    = (uint32_t)rand() & cne_rib_depth_to_mask(route_depths[i]);
+        ret = cne_fib_add(fib, route_ips[i], route_depths[i], 1 + (rand() % max_nh));
+        CNE_TEST_ASSERT(ret == 0, "Failed to add a route\n");
+    }
+
+    /* Half of the addresses are covered by a route, the others are mostly missing */
+    for (i = 0; i < VEC_NB_IPS; i++) {
+        uint32_t r = i % VEC_NB_ROUTES;
+
+        ips[i] = (i & 1) ? (uint32_t)rand()
+                         : route_ips[r] | ((uint32_t)rand() & ~cne_rib_depth_to_mask(route_depths[r]));
+    }
+
+    for (b = 0; b < cne_countof(vec_bursts); b++) {
+        for (off = 0; off + vec_bursts[b] <= VEC_NB_IPS; off += vec_bursts[b]) {
+            ret = cne_fib_select_lookup(fib, CNE_FIB_LOOKUP_DIR24_8_SCALAR_MACRO);
+            CNE_TEST_ASSERT(ret == 0, "Failed to select the scalar lookup\n");
+            cne_fib_lookup_bulk(fib, &ips[off], &ref_nh[off], vec_bursts[b]);
+
+            ret = cne_fib_select_lookup(fib, CNE_FIB_LOOKUP_DIR24_8_VECTOR_AVX2);
+            CNE_TEST_ASSERT(ret == 0, "Failed to select the AVX2 lookup\n");
+            cne_fib_lookup_bulk(fib, &ips[off], &vec_nh[off], vec_bursts[b]);
+        }
+        for (i = 0; i < off; i++)
+            CNE_TEST_ASSERT(vec_nh[i] == ref_nh[i],
+                            "%08x next hop %lu with AVX2, %lu scalar, burst %u\n", ips[i],
+                            vec_nh[i], ref_nh[i], vec_bursts[b]);
+    }
+
+    return TEST_SUCCESS;
+}
+
+int32_t
+test_lookup_avx2(void)
+{
+    static const struct {
+        enum cne_fib_dir24_8_nh_sz nh_sz;
+        uint64_t max_nh;
+        const char *name;
+    } sizes[] = {
+        {CNE_FIB_DIR24_8_1B, UINT8_MAX >> 1, "1B"},
+        {CNE_FIB_DIR24_8_2B, UINT16_MAX >> 1, "2B"},
+        {CNE_FIB_DIR24_8_4B, UINT32_MAX >> 1, "4B"},
+    };
+    struct cne_fib *fib = NULL;
+    struct cne_fib_conf config;
+    int ret;
+
+    config.max_routes       = MAX_ROUTES;
+    config.default_nh       = 0;
+    config.type             = CNE_FIB_DIR24_8;
+    config.dir24_8.num_tbl8 = 127;
+
+    for (unsigned int i = 0; i < cne_countof(sizes); i++) {
+        config.dir24_8.nh_sz = sizes[i].nh_sz;
+        fib                  = cne_fib_create(__func__, &config);
+        CNE_TEST_ASSERT(fib != NULL, "Failed to create FIB\n");
+
+        /* Not built with AVX2 or not supported by the CPU */
+        if (cne_fib_select_lookup(fib, CNE_FIB_LOOKUP_DIR24_8_VECTOR_AVX2) < 0) {
+            cne_fib_free(fib);
+            return TEST_SKIPPED;
+        }
+
+        ret = check_lookup_avx2(fib, sizes[i].max_nh);
+        cne_fib_free(fib);
+        CNE_TEST_ASSERT(ret == TEST_SUCCESS, "AVX2 lookup mismatch for DIR24_8_%s type\n",
+                        sizes[i].name);
+    }
+
+    return TEST_SUCCESS;
+}
+
+#define END_NH 5
+
+/*
+ * Lookup the addresses of the last tbl24 entry with the vector lookups, the gathers of 1 and
+ * 2 byte next hops read past the entry and must stay inside the table.
+ */
+int32_t
+test_lookup_tbl24_end(void)
+{
+    static const enum cne_fib_lookup_type types[] = {CNE_FIB_LOOKUP_DIR24_8_VECTOR_AVX2,
+                                                     CNE_FIB_LOOKUP_DIR24_8_VECTOR_AVX512};
+    static const enum cne_fib_dir24_8_nh_sz sizes[] = {CNE_FIB_DIR24_8_1B, CNE_FIB_DIR24_8_2B};
+    uint32_t ips[UINT8_MAX + 1];
+    uint64_t nh[UINT8_MAX + 1];
+    struct cne_fib *fib = NULL;
+    struct cne_fib_conf config;
+    int ret, tested = 0;
+
+    config.max_routes       = MAX_ROUTES;
+    config.default_nh       = 0;
+    config.type             = CNE_FIB_DIR24_8;
+    config.dir24_8.num_tbl8 = 127;
+
+    for (unsigned int i = 0; i < cne_countof(ips); i++)
+        ips[i] = CNE_IPV4(255, 255, 255, i);
+
+    for (unsigned int s = 0; s < cne_countof(sizes); s++) {
+        config.dir24_8.nh_sz = sizes[s];
+        fib                  = cne_fib_create(__func__, &config);
+        CNE_TEST_ASSERT(fib != NULL, "Failed to create FIB\n");
+
+        ret = cne_fib_add(fib, CNE_IPV4(255, 255, 255, 0), 24, END_NH);
+        CNE_TEST_ASSERT(ret == 0, "Failed to add a route\n");
+
+        for (unsigned int t = 0; t < cne_countof(types); t++) {
+            /* Not built with this lookup or not supported by the CPU */
+            if (cne_fib_select_lookup(fib, types[t]) < 0)
+                continue;
+            tested++;
+
+            /* Every burst size, so the last entry is looked up in each lane */
+            for (unsigned int b = 1; b <= cne_countof(ips); b++) {
+                memset(nh, 0, sizeof(nh));
+                cne_fib_lookup_bulk(fib, &ips[cne_countof(ips) - b], nh, b);
+                for (unsigned int i = 0; i < b; i++)
+                    CNE_TEST_ASSERT(nh[i] == END_NH, "%08x next hop %lu, expected %u\n",
+                                    ips[cne_countof(ips) - b + i], nh[i], END_NH);
+            }
+        }
+        cne_fib_free(fib);
+    }
+
+    return (tested) ? TEST_SUCCESS : TEST_SKIPPED;
+}
+
+#define BULK_DEF_NH   100
+#define BULK_READER   0 /**< QSBR thread id of the lookups done by the test */
+#define BULK_NB_CHECK 6
+
+/* Addresses looked up after each batch, the last two are covered by routes deeper than /24 */
+static uint32_t bulk_ips[BULK_NB_CHECK] = {
+    CNE_IPV4(10, 0, 0, 1),   CNE_IPV4(10, 1, 2, 3),   CNE_IPV4(10, 2, 0, 1),
+    CNE_IPV4(11, 0, 0, 1),   CNE_IPV4(10, 1, 1, 129), CNE_IPV4(10, 1, 1, 130),
+};
+
+/* Lookup the check addresses as a registered reader and compare with the expected next hops */
+static int
+bulk_check(struct cne_fib *fib, struct cne_rcu_qsbr *v, const uint64_t exp[BULK_NB_CHECK])
+{
+    uint64_t nh[BULK_NB_CHECK];
+
+    cne_rcu_qsbr_thread_online(v, BULK_READER);
+    cne_fib_lookup_bulk(fib, bulk_ips, nh, BULK_NB_CHECK);
+    cne_rcu_qsbr_quiescent(v, BULK_READER);
+    /* The updates wait for the readers, this thread must not be online while it updates */
+    cne_rcu_qsbr_thread_offline(v, BULK_READER);
+
+    for (int i = 0; i < BULK_NB_CHECK; i++)
+        CNE_TEST_ASSERT(nh[i] == exp[i], "%08x next hop %lu, expected %lu\n", bulk_ips[i], nh[i],
+                        exp[i]);
+
+    return TEST_SUCCESS;
+}
+
+/* Check the next hop of a prefix in the RIB, nh == 0 expects the prefix to be missing */
+static int
+bulk_check_rib(struct cne_fib *fib, uint32_t ip, uint8_t depth, uint64_t nh)
+{
+    struct cne_rib_node *node = cne_rib_lookup_exact(cne_fib_get_rib(fib), ip, depth);
+    uint64_t rib_nh;
+
+    if (nh == 0) {
+        CNE_TEST_ASSERT(node == NULL, "Route %08x/%u is in the RIB\n", ip, depth);
+        return TEST_SUCCESS;
+    }
+    CNE_TEST_ASSERT(node != NULL, "Route %08x/%u is not in the RIB\n", ip, depth);
+    cne_rib_get_nh(node, &rib_nh);
+    CNE_TEST_ASSERT(rib_nh == nh, "Route %08x/%u next hop %lu, expected %lu\n", ip, depth,
+                    rib_nh, nh);
+
+    return TEST_SUCCESS;
+}
+
+static int
+check_update_bulk(struct cne_fib *fib, struct cne_rcu_qsbr *v)
+{
+    /* Add and delete of the same prefix in one batch are coalesced to the final state */
+    struct cne_fib_route coalesce[] = {
+        {CNE_IPV4(10, 0, 0, 0), 24, CNE_FIB_ADD, 1},
+        {CNE_IPV4(10, 1, 1, 128), 25, CNE_FIB_ADD, 2},
+        {CNE_IPV4(10, 0, 0, 0), 24, CNE_FIB_DEL, 0},
+        {CNE_IPV4(10, 1, 0, 0), 16, CNE_FIB_ADD, 3},
+        {CNE_IPV4(10, 1, 1, 128), 25, CNE_FIB_DEL, 0},
+        {CNE_IPV4(10, 1, 0, 0), 16, CNE_FIB_ADD, 4},
+        {CNE_IPV4(10, 1, 1, 128), 25, CNE_FIB_ADD, 5},
+    };
+    uint64_t exp_coalesce[BULK_NB_CHECK] = {BULK_DEF_NH, 4, BULK_DEF_NH, BULK_DEF_NH, 5, 5};
+
+    /* The delete of a missing route fails the batch after the other changes hit the RIB */
+    struct cne_fib_route missing[] = {
+        {CNE_IPV4(10, 2, 0, 0), 16, CNE_FIB_ADD, 6},
+        {CNE_IPV4(10, 1, 0, 0), 16, CNE_FIB_ADD, 7},
+        {CNE_IPV4(10, 1, 1, 128), 25, CNE_FIB_DEL, 0},
+        {CNE_IPV4(11, 0, 0, 0), 8, CNE_FIB_DEL, 0},
+    };
+
+    /* A batch on top of the routes added with cne_fib_add() */
+    struct cne_fib_route on_top[] = {
+        {CNE_IPV4(10, 1, 1, 128), 26, CNE_FIB_ADD, 8},
+        {CNE_IPV4(10, 1, 0, 0), 16, CNE_FIB_DEL, 0},
+        {CNE_IPV4(10, 0, 0, 0), 8, CNE_FIB_ADD, 9},
+    };
+    uint64_t exp_on_top[BULK_NB_CHECK] = {9, 9, 9, 12, 8, 8};
+
+    /* A next hop too large for a 1B FIB, checked after the RIB was changed */
+    struct cne_fib_route too_large[] = {
+        {CNE_IPV4(10, 2, 0, 0), 16, CNE_FIB_ADD, 10},
+        {CNE_IPV4(10, 0, 0, 0), 8, CNE_FIB_DEL, 0},
+        {CNE_IPV4(11, 0, 0, 0), 8, CNE_FIB_ADD, 0x1000},
+    };
+    int ret;
+
+    ret = cne_fib_update_bulk(fib, coalesce, cne_countof(coalesce));
+    CNE_TEST_ASSERT(ret == 0, "Failed to apply batch: %d\n", ret);
+    ret = bulk_check(fib, v, exp_coalesce);
+    CNE_TEST_ASSERT(ret == TEST_SUCCESS, "Lookup fails after coalesced batch\n");
+    CNE_TEST_ASSERT(bulk_check_rib(fib, CNE_IPV4(10, 0, 0, 0), 24, 0) == TEST_SUCCESS,
+                    "Coalesced delete not applied\n");
+
+    ret = cne_fib_update_bulk(fib, missing, cne_countof(missing));
+    CNE_TEST_ASSERT(ret == -ENOENT, "Delete of a missing route returned %d\n", ret);
+    ret = bulk_check(fib, v, exp_coalesce);
+    CNE_TEST_ASSERT(ret == TEST_SUCCESS, "FIB changed by a failed batch\n");
+    CNE_TEST_ASSERT(bulk_check_rib(fib, CNE_IPV4(10, 2, 0, 0), 16, 0) == TEST_SUCCESS &&
+                        bulk_check_rib(fib, CNE_IPV4(10, 1, 0, 0), 16, 4) == TEST_SUCCESS &&
+                        bulk_check_rib(fib, CNE_IPV4(10, 1, 1, 128), 25, 5) == TEST_SUCCESS,
+                    "RIB not restored after a failed batch\n");
+
+    ret = cne_fib_add(fib, CNE_IPV4(11, 0, 0, 0), 8, 12);
+    CNE_TEST_ASSERT(ret == 0, "Failed to add a route\n");
+    ret = cne_fib_update_bulk(fib, on_top, cne_countof(on_top));
+    CNE_TEST_ASSERT(ret == 0, "Failed to apply batch: %d\n", ret);
+    ret = bulk_check(fib, v, exp_on_top);
+    CNE_TEST_ASSERT(ret == TEST_SUCCESS, "Lookup fails after batch on added routes\n");
+
+    /* The single route updates keep working on the rebuilt tables */
+    ret = cne_fib_delete(fib, CNE_IPV4(10, 1, 1, 128), 26);
+    CNE_TEST_ASSERT(ret == 0, "Failed to delete a route\n");
+    exp_on_top[4] = exp_on_top[5] = 5;
+    ret = bulk_check(fib, v, exp_on_top);
+    CNE_TEST_ASSERT(ret == TEST_SUCCESS, "Lookup fails after delete on rebuilt tables\n");
+
+    ret = cne_fib_update_bulk(fib, too_large, cne_countof(too_large));
+    CNE_TEST_ASSERT(ret == -EINVAL, "Too large next hop returned %d\n", ret);
+    ret = bulk_check(fib, v, exp_on_top);
+    CNE_TEST_ASSERT(ret == TEST_SUCCESS, "FIB changed by a failed batch\n");
+    CNE_TEST_ASSERT(bulk_check_rib(fib, CNE_IPV4(10, 2, 0, 0), 16, 0) == TEST_SUCCESS &&
+                        bulk_check_rib(fib, CNE_IPV4(10, 0, 0, 0), 8, 9) == TEST_SUCCESS &&
+                        bulk_check_rib(fib, CNE_IPV4(11, 0, 0, 0), 8, 12) == TEST_SUCCESS,
+                    "RIB not restored after a failed batch\n");
+
+    return TEST_SUCCESS;
+}
+
+int32_t
+test_update_bulk(void)
+{
+    struct cne_fib_route route = {CNE_IPV4(10, 0, 0, 0), 8, CNE_FIB_ADD, 1};
+    struct cne_fib_rcu_config cfg = {0};
+    struct cne_fib_conf config    = {0};
+    struct cne_rcu_qsbr *v;
+    struct cne_fib *fib;
+    int ret;
+
+    v = cne_rcu_qsbr_create();
+    CNE_TEST_ASSERT(v != NULL, "Failed to create QSBR variable\n");
+    CNE_TEST_ASSERT(cne_rcu_qsbr_thread_register(v, BULK_READER) == 0,
+                    "Failed to register reader\n");
+
+    config.max_routes       = MAX_ROUTES;
+    config.default_nh       = BULK_DEF_NH;
+    config.type             = CNE_FIB_DIR24_8;
+    config.dir24_8.nh_sz    = CNE_FIB_DIR24_8_1B;
+    config.dir24_8.num_tbl8 = 127;
+
+    /* The old tables can not be freed safely without a RCU config */
+    fib = cne_fib_create(__func__, &config);
+    CNE_TEST_ASSERT(fib != NULL, "Failed to create FIB\n");
+    ret = cne_fib_update_bulk(fib, &route, 1);
+    CNE_TEST_ASSERT(ret == -ENOTSUP, "Batch without a RCU config returned %d\n", ret);
+    cne_fib_free(fib);
+
+    for (int mode = CNE_FIB_QSBR_MODE_DQ; mode <= CNE_FIB_QSBR_MODE_SYNC; mode++) {
+        fib = cne_fib_create(__func__, &config);
+        CNE_TEST_ASSERT(fib != NULL, "Failed to create FIB\n");
+
+        cfg.v    = v;
+        cfg.mode = mode;
+        ret      = cne_fib_rcu_qsbr_add(fib, &cfg);
+        CNE_TEST_ASSERT(ret == 0, "Failed to add RCU config\n");
+
+        ret = check_update_bulk(fib, v);
+        cne_fib_free(fib);
+        CNE_TEST_ASSERT(ret == TEST_SUCCESS, "Batch updates fail in RCU mode %d\n", mode);
+    }
+
+    cne_rcu_qsbr_thread_unregister(v, BULK_READER);
+    cne_rcu_qsbr_free(v);
+
+    return TEST_SUCCESS;
+}
+
 // clang-format off
 static struct unit_test_suite fib_fast_tests = {
     .suite_name      = "fib autotest",
@@ -352,6 +684,9 @@ static struct unit_test_suite fib_fast_tests = {
         TEST_CASE(test_add_del_invalid),
 		TEST_CASE(test_get_invalid),
         TEST_CASE(test_lookup),
+        TEST_CASE(test_lookup_avx2),
+        TEST_CASE(test_lookup_tbl24_end),
+        TEST_CASE(test_update_bulk),
 		TEST_CASES_END()
 	}
 };
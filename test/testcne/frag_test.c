@@ -0,0 +1,592 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright (c) 2023 Intel Corporation
+ */
+
+#include <stdio.h>             // for NULL, EOF
+#include <stdint.h>            // for uint8_t, uint16_t, uint32_t
+#include <stdlib.h>            // for malloc, free
+#include <string.h>            // for memset, memcmp
+#include <getopt.h>            // for getopt_long, option
+#include <sys/socket.h>        // for AF_INET
+#include <netinet/in.h>        // for IPPROTO_UDP
+#include <pktmbuf.h>           // for pktmbuf_t, pktmbuf_alloc_chain, pktmbuf_read
+#include <tst_info.h>          // for tst_end, tst_ok, TST_ASSERT_GOTO, tst_...
+#include <cne_common.h>        // for cne_countof
+#include <cne_timer.h>         // for cne_timer_subsystem_init
+#include <net/cne_ip.h>        // for __cne_raw_cksum, __cne_raw_cksum_reduce
+#include <net/cne_ether.h>     // for cne_ether_hdr, CNE_ETHER_TYPE_IPV4
+#include <net/cne_udp.h>       // for cne_udp_hdr
+#include <cne_graph.h>         // for cne_graph_create, cne_node_clone
+#include <cne_graph_worker.h>  // for cne_graph_walk, cne_node_enqueue
+#include <cnet_stk.h>          // for stk_t, stk_get, stk_set
+#include <cnet_ipv4.h>         // for ipv4_entry
+#include <cnet_ipv6.h>         // for ipv6_entry
+#include <cnet_node_names.h>   // for IP4_REASM_NODE_NAME, IP6_REASM_NODE_NAME
+#include <cnet_frag.h>         // for cnet_frag_build, cnet_frag_insert, cnet_frag_ip4
+
+#include "frag_test.h"
+#include "cne_mmap.h"        // for mmap_free, mmap_addr, mmap_alloc, MMAP...
+
+#define FRAG_NB_MBUFS  1024
+#define FRAG_L2_LEN    14   /**< Ethernet header */
+#define FRAG_L3_LEN    20   /**< IPv4 header without options */
+#define FRAG_HDR_LEN   (FRAG_L2_LEN + FRAG_L3_LEN)
+#define FRAG_PAYLOAD   4000 /**< Three fragments at a 1500 byte MTU */
+#define FRAG_SIZE      1480
+#define FRAG_NB_FRAGS  3
+#define FRAG_MTU       1500
+#define FRAG_ID        0x1234
+#define FRAG_SINK_DROP "frag_test_drop"
+#define FRAG_SINK_UDP  "frag_test_udp"
+#define FRAG_CLONE     "frag_test" /**< The reassembly clones with their edges to the sinks */
+
+static int verbose;
+
+/* Fragments handed to the graph by the source node and datagrams received by the sinks */
+static pktmbuf_t *frag_src[FRAG_NB_FRAGS], *frag_udp[FRAG_NB_FRAGS];
+static uint16_t frag_nb_src, frag_nb_udp, frag_nb_drop, frag_src_edge;
+
+/*
+ * Create a packet with the headers followed by a byte pattern payload, the packet is larger
+ * than an mbuf so it is a chain. The same bytes are written to ref for the checks.
+ */
+static pktmbuf_t *
+frag_chain_create(pktmbuf_info_t *pi, const uint8_t *ref, uint32_t len)
+{
+    uint32_t off = 0;
+    pktmbuf_t *m, *seg;
+
+    m = pktmbuf_alloc_chain(pi, len);
+    if (!m)
+        return NULL;
+
+    for (seg = m; seg; seg = seg->next) {
+        memcpy(pktmbuf_mtod(seg, void *), ref + off, pktmbuf_data_len(seg));
+        off += pktmbuf_data_len(seg);
+    }
+
+    return m;
+}
+
+static pktmbuf_t *
+frag_pkt_create(pktmbuf_info_t *pi, uint8_t *ref)
+{
+    memset(ref, 0xee, FRAG_HDR_LEN);
+    for (int i = 0; i < FRAG_PAYLOAD; i++)
+        ref[FRAG_HDR_LEN + i] = (uint8_t)(i * 7);
+
+    return frag_chain_create(pi, ref, FRAG_HDR_LEN + FRAG_PAYLOAD);
+}
+
+/*
+ * Create a chained UDP datagram as sent by ip4_output or ip6_output, the UDP header and
+ * payload are FRAG_PAYLOAD bytes and the UDP checksum covers the whole datagram. The same
+ * bytes are written to ref and len is set to the length of the packet.
+ */
+static pktmbuf_t *
+frag_dgram_create(pktmbuf_info_t *pi, uint8_t *ref, bool ipv6, uint32_t *len)
+{
+    uint16_t l3_len = ipv6 ? sizeof(struct cne_ipv6_hdr) : sizeof(struct cne_ipv4_hdr);
+    struct cne_ether_hdr *eth = (struct cne_ether_hdr *)ref;
+    struct cne_udp_hdr *udp   = (struct cne_udp_hdr *)(ref + FRAG_L2_LEN + l3_len);
+    void *l3                  = ref + FRAG_L2_LEN;
+    pktmbuf_t *m;
+
+    memset(ref, 0, FRAG_L2_LEN + l3_len + sizeof(*udp));
+    for (uint32_t i = sizeof(*udp); i < FRAG_PAYLOAD; i++)
+        ref[FRAG_L2_LEN + l3_len + i] = (uint8_t)(i * 7);
+
+    udp->src_port  = htobe16(5678);
+    udp->dst_port  = htobe16(1234);
+    udp->dgram_len = htobe16(FRAG_PAYLOAD);
+
+    if (ipv6) {
+        struct cne_ipv6_hdr *ip6 = l3;
+
+        eth->ether_type   = htobe16(CNE_ETHER_TYPE_IPV6);
+        ip6->vtc_flow     = htobe32(6 << 28);
+        ip6->payload_len  = htobe16(FRAG_PAYLOAD);
+        ip6->proto        = IPPROTO_UDP;
+        ip6->hop_limits   = 64;
+        ip6->src_addr[0]  = 0xfd;
+        ip6->src_addr[15] = 1;
+        ip6->dst_addr[0]  = 0xfd;
+        ip6->dst_addr[15] = 2;
+        udp->dgram_cksum  = cne_ipv6_udptcp_cksum(ip6, udp);
+    } else {
+        struct cne_ipv4_hdr *ip = l3;
+
+        eth->ether_type   = htobe16(CNE_ETHER_TYPE_IPV4);
+        ip->version_ihl   = 0x45;
+        ip->total_length  = htobe16(l3_len + FRAG_PAYLOAD);
+        ip->packet_id     = htobe16(FRAG_ID);
+        ip->time_to_live  = 64;
+        ip->next_proto_id = IPPROTO_UDP;
+        ip->src_addr      = htobe32(0xc0a80001);
+        ip->dst_addr      = htobe32(0xc0a80002);
+        ip->hdr_checksum  = cne_ipv4_cksum(ip);
+        udp->dgram_cksum  = cne_ipv4_udptcp_cksum(ip, udp);
+    }
+
+    *len = FRAG_L2_LEN + l3_len + FRAG_PAYLOAD;
+    m    = frag_chain_create(pi, ref, *len);
+    if (m)
+        m->l2_len = FRAG_L2_LEN;
+
+    return m;
+}
+
+/* Strip the L2 header and insert the fragments into the table in reverse order */
+static int
+frag_insert_all(struct frag_tbl *tbl, struct frag_key *key, pktmbuf_t **frags, int nb,
+                pktmbuf_t **out)
+{
+    for (int i = nb - 1; i >= 0; i--) {
+        pktmbuf_adj_offset(frags[i], FRAG_L2_LEN);
+        if (cnet_frag_insert(tbl, key, frags[i], FRAG_L3_LEN, 0, i * FRAG_SIZE, i < nb - 1, 0,
+                             out) < 0)
+            return -1;
+        if (*out && i > 0)
+            return -1;
+    }
+    return 0;
+}
+
+static int
+test_frag(pktmbuf_info_t *pi)
+{
+    pktmbuf_t *m = NULL, *out = NULL;
+    pktmbuf_t *frags[CNET_FRAG_MAX_FRAGS], *dups[CNET_FRAG_MAX_FRAGS] = {0};
+    struct frag_tbl *tbl = NULL;
+    struct frag_key key  = {0};
+    uint8_t *buf         = NULL;
+    uint8_t *ref         = NULL;
+    uint32_t sum1, sum2;
+    const void *p;
+    int nb;
+
+    buf = malloc(FRAG_HDR_LEN + FRAG_PAYLOAD);
+    ref = malloc(FRAG_HDR_LEN + FRAG_PAYLOAD);
+    TST_ASSERT_GOTO(buf != NULL && ref != NULL, "Failed to allocate buffer", err);
+
+    tbl = cnet_frag_tbl_create(16, 64, 1);
+    TST_ASSERT_GOTO(tbl != NULL, "Failed to create fragment table", err);
+
+    m = frag_pkt_create(pi, ref);
+    TST_ASSERT_GOTO(m != NULL, "Failed to create packet", err);
+    TST_ASSERT_GOTO(m->nb_segs > 1, "Packet of %u bytes is not chained", err,
+                    pktmbuf_pkt_len(m));
+
+    nb = cnet_frag_build(m, FRAG_HDR_LEN, 0, FRAG_SIZE, frags, cne_countof(frags));
+    TST_ASSERT_GOTO(nb == FRAG_NB_FRAGS, "Expected %d fragments got %d", err, FRAG_NB_FRAGS, nb);
+
+    /* Each fragment has a copy of the headers and the payload at offset i * FRAG_SIZE */
+    for (int i = 0; i < nb; i++) {
+        uint32_t flen = (i < nb - 1) ? FRAG_SIZE : FRAG_PAYLOAD - (i * FRAG_SIZE);
+
+        TST_ASSERT_GOTO(pktmbuf_pkt_len(frags[i]) == FRAG_HDR_LEN + flen,
+                        "Fragment %d length %u", err, i, pktmbuf_pkt_len(frags[i]));
+        p = pktmbuf_read(frags[i], 0, FRAG_HDR_LEN, buf);
+        TST_ASSERT_GOTO(p && !memcmp(p, ref, FRAG_HDR_LEN), "Fragment %d header mismatch", err,
+                        i);
+        p = pktmbuf_read(frags[i], FRAG_HDR_LEN, flen, buf);
+        TST_ASSERT_GOTO(p && !memcmp(p, ref + FRAG_HDR_LEN + i * FRAG_SIZE, flen),
+                        "Fragment %d payload mismatch at offset %u", err, i, i * FRAG_SIZE);
+        for (pktmbuf_t *seg = frags[i]->next; seg; seg = seg->next)
+            TST_ASSERT_GOTO(!pktmbuf_is_direct(seg), "Fragment %d payload was copied", err, i);
+    }
+    tst_ok("Built %d fragments of a %u segment packet without copying the payload", nb,
+           m->nb_segs);
+
+    nb = cnet_frag_build(m, FRAG_HDR_LEN, 0, FRAG_SIZE, dups, cne_countof(dups));
+    TST_ASSERT_GOTO(nb == FRAG_NB_FRAGS, "Expected %d duplicate fragments", err, FRAG_NB_FRAGS);
+
+    key.af    = AF_INET;
+    key.proto = IPPROTO_UDP;
+    key.id    = 1;
+
+    /* A duplicate of a held fragment is freed and the datagram still completes */
+    pktmbuf_adj_offset(dups[2], FRAG_L2_LEN);
+    TST_ASSERT_GOTO(cnet_frag_insert(tbl, &key, dups[2], FRAG_L3_LEN, 0, 2 * FRAG_SIZE, false, 0,
+                                     &out) == 0 && !out,
+                    "Failed to insert fragment", err);
+    dups[2] = NULL;
+    TST_ASSERT_GOTO(frag_insert_all(tbl, &key, frags, nb, &out) == 0 && out,
+                    "Failed to reassemble datagram", err);
+    TST_ASSERT_GOTO(tbl->stats.frags_dup == 1, "Duplicate fragment not detected", err);
+    TST_ASSERT_GOTO(tbl->nb_flows == 0 && tbl->nb_mbufs == 0, "Flow not released", err);
+
+    /* The datagram is the saved L3 header followed by the payload in order */
+    TST_ASSERT_GOTO(pktmbuf_pkt_len(out) == FRAG_L3_LEN + FRAG_PAYLOAD,
+                    "Reassembled length %u", err, pktmbuf_pkt_len(out));
+    p = pktmbuf_read(out, 0, pktmbuf_pkt_len(out), buf);
+    TST_ASSERT_GOTO(p && !memcmp(p, ref + FRAG_L2_LEN, pktmbuf_pkt_len(out)),
+                    "Reassembled datagram mismatch", err);
+
+    /* The checksum over the chain matches the contiguous checksum, including odd offsets */
+    for (uint32_t off = FRAG_L3_LEN; off < FRAG_L3_LEN + 8; off++) {
+        sum1 = cnet_frag_cksum_mbuf(out, off, pktmbuf_pkt_len(out) - off, 0);
+        sum2 = __cne_raw_cksum(ref + FRAG_L2_LEN + off, pktmbuf_pkt_len(out) - off, 0);
+        TST_ASSERT_GOTO(__cne_raw_cksum_reduce(sum1) == __cne_raw_cksum_reduce(sum2),
+                        "Checksum mismatch at offset %u", err, off);
+    }
+    tst_ok("Reassembled %u byte datagram from out of order fragments", pktmbuf_pkt_len(out));
+    pktmbuf_free(out);
+    out = NULL;
+
+    /* Overlapping fragments drop the whole datagram */
+    key.id = 2;
+    pktmbuf_adj_offset(dups[0], FRAG_L2_LEN);
+    TST_ASSERT_GOTO(cnet_frag_insert(tbl, &key, dups[0], FRAG_L3_LEN, 0, 0, true, 0, &out) == 0,
+                    "Failed to insert fragment", err);
+    dups[0] = NULL;
+    pktmbuf_adj_offset(dups[1], FRAG_L2_LEN);
+    TST_ASSERT_GOTO(cnet_frag_insert(tbl, &key, dups[1], FRAG_L3_LEN, 0, 8, true, 0, &out) < 0,
+                    "Overlapping fragment accepted", err);
+    dups[1] = NULL;
+    TST_ASSERT_GOTO(tbl->nb_flows == 0 && tbl->nb_mbufs == 0, "Invalid flow not released", err);
+    tst_ok("Overlapping fragments dropped");
+
+    /* An incomplete datagram is released once the TTL expires */
+    nb = cnet_frag_build(m, FRAG_HDR_LEN, 0, FRAG_SIZE, frags, cne_countof(frags));
+    TST_ASSERT_GOTO(nb == FRAG_NB_FRAGS, "Expected %d fragments", err, FRAG_NB_FRAGS);
+    key.id = 3;
+    pktmbuf_adj_offset(frags[0], FRAG_L2_LEN);
+    TST_ASSERT_GOTO(cnet_frag_insert(tbl, &key, frags[0], FRAG_L3_LEN, 0, 0, true, 0, &out) == 0,
+                    "Failed to insert fragment", err);
+    pktmbuf_free_bulk(&frags[1], nb - 1);
+
+    cnet_frag_tbl_expire(tbl, tbl->ttl);
+    TST_ASSERT_GOTO(tbl->nb_flows == 1, "Flow expired before the TTL", err);
+    cnet_frag_tbl_expire(tbl, tbl->ttl + 1);
+    TST_ASSERT_GOTO(tbl->nb_flows == 0 && tbl->nb_mbufs == 0 && tbl->stats.timeouts == 1,
+                    "Flow not expired", err);
+    tst_ok("Incomplete datagram expired");
+
+    if (verbose)
+        cnet_frag_stats_dump(tbl);
+
+    cnet_frag_tbl_destroy(tbl);
+    pktmbuf_free(m);
+    free(ref);
+    free(buf);
+    return 0;
+err:
+    for (int i = 0; i < FRAG_NB_FRAGS; i++)
+        pktmbuf_free(dups[i]);
+    pktmbuf_free(out);
+    cnet_frag_tbl_destroy(tbl);
+    pktmbuf_free(m);
+    free(ref);
+    free(buf);
+    return -1;
+}
+
+static uint16_t
+frag_source_process(struct cne_graph *graph, struct cne_node *node, void **objs,
+                    uint16_t nb_objs)
+{
+    CNE_SET_USED(objs);
+    CNE_SET_USED(nb_objs);
+
+    nb_objs = frag_nb_src;
+    if (nb_objs) {
+        cne_node_enqueue(graph, node, frag_src_edge, (void **)frag_src, nb_objs);
+        frag_nb_src = 0;
+    }
+    return nb_objs;
+}
+
+static uint16_t
+frag_drop_process(struct cne_graph *graph, struct cne_node *node, void **objs, uint16_t nb_objs)
+{
+    CNE_SET_USED(graph);
+    CNE_SET_USED(node);
+
+    pktmbuf_free_bulk((pktmbuf_t **)objs, nb_objs);
+    frag_nb_drop += nb_objs;
+    return nb_objs;
+}
+
+static uint16_t
+frag_udp_process(struct cne_graph *graph, struct cne_node *node, void **objs, uint16_t nb_objs)
+{
+    CNE_SET_USED(graph);
+    CNE_SET_USED(node);
+
+    for (uint16_t i = 0; i < nb_objs; i++) {
+        if (frag_nb_udp < FRAG_NB_FRAGS)
+            frag_udp[frag_nb_udp++] = objs[i];
+        else
+            pktmbuf_free(objs[i]);
+    }
+    return nb_objs;
+}
+
+static struct cne_node_register frag_source_node = {
+    .name       = "frag_test_source",
+    .process    = frag_source_process,
+    .flags      = CNE_NODE_SOURCE_F,
+    .nb_edges   = 2,
+    .next_nodes = {IP4_REASM_NODE_NAME "-" FRAG_CLONE, IP6_REASM_NODE_NAME "-" FRAG_CLONE},
+};
+CNE_NODE_REGISTER(frag_source_node);
+
+static struct cne_node_register frag_drop_node = {
+    .name    = FRAG_SINK_DROP,
+    .process = frag_drop_process,
+};
+CNE_NODE_REGISTER(frag_drop_node);
+
+static struct cne_node_register frag_udp_node = {
+    .name    = FRAG_SINK_UDP,
+    .process = frag_udp_process,
+};
+CNE_NODE_REGISTER(frag_udp_node);
+
+/* Check the IP header of fragment i, the data must start at the L2 header */
+static int
+frag_ip_check(pktmbuf_t *f, int i, bool more, uint16_t frag_size, bool ipv6)
+{
+    uint32_t ofs  = i * frag_size;
+    uint32_t flen = CNE_MIN(FRAG_PAYLOAD - ofs, (uint32_t)frag_size);
+
+    if (ipv6) {
+        struct cne_ipv6_hdr *ip6 = pktmbuf_mtod_offset(f, struct cne_ipv6_hdr *, FRAG_L2_LEN);
+        struct cne_ipv6_fragment_ext *fh = (struct cne_ipv6_fragment_ext *)(ip6 + 1);
+        uint16_t fd                      = be16toh(fh->frag_data);
+
+        TST_ASSERT_GOTO(ip6->proto == IPPROTO_FRAGMENT && fh->next_header == IPPROTO_UDP,
+                        "IPv6 fragment %d has no fragment header", err, i);
+        TST_ASSERT_GOTO(be16toh(ip6->payload_len) == sizeof(*fh) + flen,
+                        "IPv6 fragment %d payload length %u", err, i, be16toh(ip6->payload_len));
+        TST_ASSERT_GOTO((fd & CNE_IPV6_EHDR_FO_MASK) == ofs && !!CNE_IPV6_GET_MF(fd) == more &&
+                            be32toh(fh->id) == FRAG_ID,
+                        "IPv6 fragment %d has offset %u id %x", err, i, fd & CNE_IPV6_EHDR_FO_MASK,
+                        be32toh(fh->id));
+    } else {
+        struct cne_ipv4_hdr *ip = pktmbuf_mtod_offset(f, struct cne_ipv4_hdr *, FRAG_L2_LEN);
+        uint16_t off            = be16toh(ip->fragment_offset);
+
+        TST_ASSERT_GOTO(be16toh(ip->total_length) == sizeof(*ip) + flen,
+                        "IPv4 fragment %d total length %u", err, i, be16toh(ip->total_length));
+        TST_ASSERT_GOTO((off & CNE_IPV4_HDR_OFFSET_MASK) * CNE_IPV4_HDR_OFFSET_UNITS == ofs &&
+                            !!(off & CNE_IPV4_HDR_MF_FLAG) == more,
+                        "IPv4 fragment %d has fragment offset %04x", err, i, off);
+        TST_ASSERT_GOTO(__cne_raw_cksum_reduce(__cne_raw_cksum(ip, sizeof(*ip), 0)) == 0xffff,
+                        "IPv4 fragment %d header checksum", err, i);
+    }
+    TST_ASSERT_GOTO(pktmbuf_pkt_len(f) <= FRAG_L2_LEN + FRAG_MTU, "Fragment %d length %u", err, i,
+                    pktmbuf_pkt_len(f));
+
+    return 0;
+err:
+    return -1;
+}
+
+/*
+ * Fragment a datagram the way the ip4_frag and ip6_frag nodes do and pass the fragments
+ * in reverse order to the clone of the ip4_reasm or ip6_reasm node. The datagram is
+ * reassembled, then dropped when a byte of its payload is changed.
+ */
+static int
+test_frag_ip(pktmbuf_info_t *pi, struct cne_graph *graph, bool ipv6)
+{
+    const char *af = ipv6 ? "IPv6" : "IPv4";
+    uint16_t l3_len, frag_size;
+    pktmbuf_t *m = NULL, *frags[CNET_FRAG_MAX_FRAGS];
+    uint8_t *buf = NULL, *ref = NULL;
+    const void *p;
+    uint32_t len;
+    int nb = 0;
+
+    l3_len    = ipv6 ? sizeof(struct cne_ipv6_hdr) : sizeof(struct cne_ipv4_hdr);
+    frag_size = (FRAG_MTU - l3_len - (ipv6 ? sizeof(struct cne_ipv6_fragment_ext) : 0)) & ~7;
+
+    buf = malloc(FRAG_L2_LEN + l3_len + FRAG_PAYLOAD);
+    ref = malloc(FRAG_L2_LEN + l3_len + FRAG_PAYLOAD);
+    TST_ASSERT_GOTO(buf != NULL && ref != NULL, "Failed to allocate buffer", err);
+
+    for (int bad = 0; bad < 2; bad++) {
+        m = frag_dgram_create(pi, ref, ipv6, &len);
+        TST_ASSERT_GOTO(m != NULL, "Failed to create %s datagram", err, af);
+
+        if (ipv6)
+            nb = cnet_frag_ip6(m, FRAG_MTU, FRAG_ID, frags, cne_countof(frags));
+        else
+            nb = cnet_frag_ip4(m, FRAG_MTU, frags, cne_countof(frags));
+        TST_ASSERT_GOTO(nb == FRAG_NB_FRAGS, "Expected %d %s fragments got %d", err,
+                        FRAG_NB_FRAGS, af, nb);
+
+        for (int i = 0; i < nb; i++) {
+            if (frag_ip_check(frags[i], i, i < nb - 1, frag_size, ipv6) < 0)
+                goto err;
+            pktmbuf_adj_offset(frags[i], FRAG_L2_LEN);
+        }
+
+        /* The fragments keep the payload of the datagram */
+        pktmbuf_free(m);
+        m = NULL;
+
+        if (bad)
+            *pktmbuf_mtod(frags[nb - 1]->next, uint8_t *) ^= 0xff;
+
+        for (int i = nb - 1; i >= 0; i--)
+            frag_src[frag_nb_src++] = frags[i];
+        nb            = 0;
+        frag_src_edge = ipv6;
+        frag_nb_drop  = 0;
+        frag_nb_udp   = 0;
+
+        cne_graph_walk(graph);
+        TST_ASSERT_GOTO(frag_nb_src == 0 && frag_nb_udp == !bad && frag_nb_drop == bad,
+                        "%s: %u datagrams reassembled and %u dropped", err, af, frag_nb_udp,
+                        frag_nb_drop);
+        if (bad)
+            break;
+
+        m           = frag_udp[0];
+        frag_nb_udp = 0;
+
+        TST_ASSERT_GOTO(pktmbuf_pkt_len(m) == len - FRAG_L2_LEN, "%s reassembled length %u",
+                        err, af, pktmbuf_pkt_len(m));
+        p = pktmbuf_read(m, 0, len - FRAG_L2_LEN, buf);
+        TST_ASSERT_GOTO(p && !memcmp(p, ref + FRAG_L2_LEN, len - FRAG_L2_LEN),
+                        "%s reassembled datagram mismatch", err, af);
+        TST_ASSERT_GOTO((m->ol_flags & CNE_MBUF_F_RX_L4_CKSUM_MASK) ==
+                            CNE_MBUF_F_RX_L4_CKSUM_GOOD,
+                        "%s reassembled datagram checksum not marked good", err, af);
+        tst_ok("%s datagram fragmented at a %u byte MTU and reassembled by the %s node", af,
+               FRAG_MTU, ipv6 ? IP6_REASM_NODE_NAME : IP4_REASM_NODE_NAME);
+
+        pktmbuf_free(m);
+        m = NULL;
+    }
+    tst_ok("%s datagram with a bad checksum dropped after reassembly", af);
+
+    free(ref);
+    free(buf);
+    return 0;
+err:
+    while (nb > 0)
+        pktmbuf_free(frags[--nb]);
+    pktmbuf_free_bulk(frag_src, frag_nb_src);
+    pktmbuf_free_bulk(frag_udp, frag_nb_udp);
+    frag_nb_src = 0;
+    frag_nb_udp = 0;
+    pktmbuf_free(m);
+    free(ref);
+    free(buf);
+    return -1;
+}
+
+/*
+ * Run clones of the reassembly nodes with their drop and UDP edges moved to the sink
+ * nodes, the clones are kept in the node list when the test is run again.
+ */
+static int
+test_frag_nodes(pktmbuf_info_t *pi)
+{
+    static const char *patterns[] = {"frag_test_source", IP4_REASM_NODE_NAME "-" FRAG_CLONE,
+                                     IP6_REASM_NODE_NAME "-" FRAG_CLONE, FRAG_SINK_DROP,
+                                     FRAG_SINK_UDP, NULL};
+    static const char *reasm[]    = {IP4_REASM_NODE_NAME, IP6_REASM_NODE_NAME};
+    static const char *sinks[]    = {FRAG_SINK_DROP, FRAG_SINK_UDP};
+    stk_t *saved_stk              = stk_get();
+    struct ipv4_entry ipv4        = {0};
+    struct ipv6_entry ipv6        = {0};
+    stk_t stk                     = {.ipv4 = &ipv4, .ipv6 = &ipv6};
+    cne_graph_t id                = CNE_GRAPH_ID_INVALID;
+    struct frag_tbl *tbl;
+    struct cne_graph *graph;
+    int ret = -1;
+
+    /* The keys of the two address families never match, both nodes can share the table */
+    tbl = cnet_frag_tbl_create(16, 64, 1);
+    TST_ASSERT_GOTO(tbl != NULL, "Failed to create fragment table", leave);
+    ipv4.frag_tbl = tbl;
+    ipv6.frag_tbl = tbl;
+    stk_set(&stk);
+
+    for (int i = 0; i < (int)cne_countof(reasm); i++) {
+        char name[CNE_NODE_NAMESIZE];
+        cne_node_t node;
+
+        snprintf(name, sizeof(name), "%s-%s", reasm[i], FRAG_CLONE);
+        node = cne_node_from_name(name);
+        if (node == CNE_NODE_ID_INVALID)
+            node = cne_node_clone(cne_node_from_name(reasm[i]), FRAG_CLONE);
+        TST_ASSERT_GOTO(node != CNE_NODE_ID_INVALID, "Failed to clone the %s node", leave,
+                        reasm[i]);
+
+        /* The drop and UDP edges come first, the TCP edge is removed */
+        TST_ASSERT_GOTO(cne_node_edge_update(node, 0, sinks, cne_countof(sinks)) !=
+                                CNE_EDGE_ID_INVALID &&
+                            cne_node_edge_shrink(node, cne_countof(sinks)) != CNE_EDGE_ID_INVALID,
+                        "Failed to move the %s edges to the sinks", leave, reasm[i]);
+    }
+
+    id = cne_graph_create("frag_test", patterns);
+    TST_ASSERT_GOTO(id != CNE_GRAPH_ID_INVALID, "Failed to create the graph", leave);
+    graph = cne_graph_lookup("frag_test");
+    TST_ASSERT_GOTO(graph != NULL, "Failed to find the graph", leave);
+
+    if (test_frag_ip(pi, graph, false) < 0 || test_frag_ip(pi, graph, true) < 0)
+        goto leave;
+    TST_ASSERT_GOTO(tbl->nb_flows == 0 && tbl->nb_mbufs == 0, "Flows not released", leave);
+    TST_ASSERT_GOTO(ipv4.stats.ip_reassemble_failed == 1 && ipv6.stats.ip6_reassemble_failed == 1,
+                    "Reassembly failures not counted", leave);
+
+    ret = 0;
+leave:
+    if (id != CNE_GRAPH_ID_INVALID)
+        cne_graph_destroy(id);
+    stk_set(saved_stk);
+    cnet_frag_tbl_destroy(tbl);
+    return ret;
+}
+
+int
+frag_main(int argc, char **argv)
+{
+    static const struct option lgopts[] = {{NULL, 0, 0, 0}};
+    pktmbuf_info_t *pi = NULL;
+    mmap_t *mm         = NULL;
+    tst_info_t *tst;
+    int option_index, opt;
+
+    verbose = 0;
+    while ((opt = getopt_long(argc, argv, "v", lgopts, &option_index)) != EOF) {
+        switch (opt) {
+        case 'v':
+            verbose = 1;
+            break;
+        default:
+            break;
+        }
+    }
+
+    tst = tst_start("IP Fragmentation");
+
+    cne_timer_subsystem_init();
+
+    mm = mmap_alloc(FRAG_NB_MBUFS, DEFAULT_MBUF_SIZE, MMAP_HUGEPAGE_DEFAULT);
+    TST_ASSERT_GOTO(mm != NULL, "Failed to allocate memory", leave);
+
+    pi = pktmbuf_pool_create(mmap_addr(mm), FRAG_NB_MBUFS, DEFAULT_MBUF_SIZE, 0, NULL);
+    TST_ASSERT_GOTO(pi != NULL, "Failed to create pktmbuf pool", leave);
+
+    if (test_frag(pi) < 0 || test_frag_nodes(pi) < 0)
+        goto leave;
+
+    pktmbuf_destroy(pi);
+    mmap_free(mm);
+    tst_end(tst, TST_PASSED);
+
+    return 0;
+leave:
+    pktmbuf_destroy(pi);
+    mmap_free(mm);
+    tst_end(tst, TST_FAILED);
+    return -1;
+}
@@ -0,0 +1,24 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright (c) 2023 Intel Corporation
+ */
+
+#ifndef _FRAG_TEST_H_
+#define _FRAG_TEST_H_
+
+/**
+ * @file
+ * CNET IP fragmentation and reassembly Test
+ *
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+int frag_main(int argc, char **argv);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _FRAG_TEST_H_ */
@@ -16,6 +16,15 @@
 #include <stdint.h>                  // for uint8_t, uint16_t, uint32_t, uintptr_t
 #include <stdlib.h>                  // for free, malloc, calloc
 #include <string.h>                  // for memset, strcmp
+#include <netinet/in.h>              // for IPPROTO_TCP, IPPROTO_UDP
+#include <cne_cycles.h>              // for cne_rdtsc
+#include <cne_mmap.h>                // for mmap_alloc, mmap_addr, mmap_free
+#include <pktmbuf.h>                 // for pktmbuf_t, pktmbuf_pool_create, pktmbuf_mtod
+#include <pktmbuf_ptype.h>           // for cne_get_ptype, cne_get_ptype_bulk
+#include <net/cne_ether.h>           // for cne_ether_hdr, cne_vlan_hdr
+#include <net/cne_ip.h>              // for cne_ipv4_hdr, cne_ipv6_hdr
+#include <net/cne_tcp.h>             // for cne_tcp_hdr
+#include <net/cne_udp.h>             // for cne_udp_hdr
 
 #include "graph_test.h"        // for GRAPH_PRINT_FLAG, GRAPH_VERBOSE_FLAG
 
@@ -862,6 +871,204 @@ graph_init_reverse_tree(void)
                       NODES_PER_STAGE(edge_map), src_map, snk_map, edge_map, 0);
 }
 
+#define PTYPE_PERF_PKTS  (4 * CNE_GRAPH_BURST_SIZE) /**< Packets parsed in each iteration */
+#define PTYPE_PERF_ITERS 2000                       /**< Iterations of each parser */
+#define PTYPE_ODD_BURST  13                         /**< Burst size not a multiple of 8 */
+
+/* Packet mix of the ptype test, mostly TCP and UDP over IPv4 and IPv6 */
+static const struct {
+    uint16_t ether_type; /**< Ether type of the packet */
+    uint8_t proto;       /**< IP protocol of the packet */
+    uint8_t vlan;        /**< Add a VLAN tag */
+} ptype_perf_mix[] = {
+    {CNE_ETHER_TYPE_IPV4, IPPROTO_TCP, 0}, {CNE_ETHER_TYPE_IPV4, IPPROTO_TCP, 0},
+    {CNE_ETHER_TYPE_IPV4, IPPROTO_UDP, 0}, {CNE_ETHER_TYPE_IPV4, IPPROTO_TCP, 1},
+    {CNE_ETHER_TYPE_IPV6, IPPROTO_TCP, 0}, {CNE_ETHER_TYPE_IPV6, IPPROTO_UDP, 0},
+    {CNE_ETHER_TYPE_IPV4, IPPROTO_UDP, 0}, {CNE_ETHER_TYPE_ARP, 0, 0},
+};
+
+static mmap_t *ptype_mm;
+static pktmbuf_info_t *ptype_pi;
+static pktmbuf_t *ptype_pkts[PTYPE_PERF_PKTS];
+
+static void
+ptype_perf_build(pktmbuf_t *m, uint32_t n)
+{
+    uint8_t *p                = pktmbuf_mtod(m, uint8_t *);
+    struct cne_ether_hdr *eth = (struct cne_ether_hdr *)p;
+    uint16_t etype            = ptype_perf_mix[n % CNE_DIM(ptype_perf_mix)].ether_type;
+    uint8_t proto             = ptype_perf_mix[n % CNE_DIM(ptype_perf_mix)].proto;
+    uint16_t off              = sizeof(struct cne_ether_hdr);
+
+    memset(p, 0, 128);
+    eth->ether_type = htobe16(etype);
+    if (ptype_perf_mix[n % CNE_DIM(ptype_perf_mix)].vlan) {
+        struct cne_vlan_hdr *vh = (struct cne_vlan_hdr *)(p + off);
+
+        eth->ether_type = htobe16(CNE_ETHER_TYPE_VLAN);
+        vh->vlan_tci    = htobe16(n & 0xfff);
+        vh->eth_proto   = htobe16(etype);
+        off += sizeof(struct cne_vlan_hdr);
+    }
+
+    if (etype == CNE_ETHER_TYPE_IPV4) {
+        struct cne_ipv4_hdr *ip4 = (struct cne_ipv4_hdr *)(p + off);
+
+        ip4->version_ihl   = 0x45;
+        ip4->time_to_live  = 64;
+        ip4->next_proto_id = proto;
+        ip4->src_addr      = htobe32(0x0a000000 + n);
+        ip4->dst_addr      = htobe32(0x0a010000 + (n >> 3));
+        off += sizeof(struct cne_ipv4_hdr);
+    } else if (etype == CNE_ETHER_TYPE_IPV6) {
+        struct cne_ipv6_hdr *ip6 = (struct cne_ipv6_hdr *)(p + off);
+
+        ip6->vtc_flow     = htobe32(6 << 28);
+        ip6->proto        = proto;
+        ip6->hop_limits   = 64;
+        ip6->src_addr[15] = n;
+        ip6->dst_addr[14] = n >> 3;
+        off += sizeof(struct cne_ipv6_hdr);
+    } else
+        proto = 0;
+
+    if (proto == IPPROTO_TCP) {
+        struct cne_tcp_hdr *tcp = (struct cne_tcp_hdr *)(p + off);
+
+        tcp->src_port = htobe16(1024 + n);
+        tcp->dst_port = htobe16(80);
+        tcp->data_off = sizeof(struct cne_tcp_hdr) << 2;
+    } else if (proto == IPPROTO_UDP) {
+        struct cne_udp_hdr *udp = (struct cne_udp_hdr *)(p + off);
+
+        udp->src_port = htobe16(1024 + n);
+        udp->dst_port = htobe16(53);
+    }
+    pktmbuf_data_len(m) = 128;
+}
+
+/* Parse the packets one at a time, as the eth_rx node did before cne_get_ptype_bulk() */
+static void
+ptype_perf_scalar(pktmbuf_t **pkts, uint16_t nb_pkts)
+{
+    for (uint16_t i = 0; i < nb_pkts; i++) {
+        struct cne_net_hdr_lens hdr_lens = {0};
+        pktmbuf_t *m                     = pkts[i];
+
+        m->packet_type = cne_get_ptype(m, &hdr_lens, CNE_PTYPE_ALL_MASK);
+        m->tx_offload  = 0;
+        m->l2_len      = hdr_lens.l2_len;
+        m->l3_len      = hdr_lens.l3_len;
+        m->l4_len      = hdr_lens.l4_len;
+    }
+}
+
+static uint64_t
+ptype_perf_run(void (*parse)(pktmbuf_t **pkts, uint16_t nb_pkts))
+{
+    uint64_t start = cne_rdtsc();
+
+    for (int iter = 0; iter < PTYPE_PERF_ITERS; iter++)
+        for (int i = 0; i < PTYPE_PERF_PKTS; i += CNE_GRAPH_BURST_SIZE)
+            parse(&ptype_pkts[i], CNE_GRAPH_BURST_SIZE);
+
+    return cne_rdtsc() - start;
+}
+
+static int
+graph_init_ptype(void)
+{
+    ptype_mm = mmap_alloc(PTYPE_PERF_PKTS, DEFAULT_MBUF_SIZE, MMAP_HUGEPAGE_DEFAULT);
+    if (!ptype_mm) {
+        tst_error("Failed to allocate memory");
+        return -1;
+    }
+
+    ptype_pi =
+        pktmbuf_pool_create(mmap_addr(ptype_mm), PTYPE_PERF_PKTS, DEFAULT_MBUF_SIZE, 0, NULL);
+    if (!ptype_pi || pktmbuf_alloc_bulk(ptype_pi, ptype_pkts, PTYPE_PERF_PKTS) <= 0) {
+        tst_error("Failed to allocate pktmbufs");
+        return -1;
+    }
+
+    for (uint32_t i = 0; i < PTYPE_PERF_PKTS; i++)
+        ptype_perf_build(ptype_pkts[i], i);
+
+    return 0;
+}
+
+static void
+graph_fini_ptype(void)
+{
+    if (ptype_pi) {
+        pktmbuf_free_bulk(ptype_pkts, PTYPE_PERF_PKTS);
+        pktmbuf_destroy(ptype_pi);
+    }
+    mmap_free(ptype_mm);
+    ptype_pi = NULL;
+    ptype_mm = NULL;
+}
+
+/*
+ * The burst parser must give the same results as cne_get_ptype() and the same flow hash as
+ * the scalar parser, which parses bursts of less than 8 packets one at a time.
+ */
+static int
+ptype_check(uint16_t burst)
+{
+    static uint32_t ref_hash[PTYPE_PERF_PKTS];
+
+    for (int i = 0; i < PTYPE_PERF_PKTS; i++) {
+        ptype_pkts[i]->hash = 0;
+        cne_get_ptype_bulk(&ptype_pkts[i], 1);
+        ref_hash[i]         = ptype_pkts[i]->hash;
+        ptype_pkts[i]->hash = 0;
+    }
+
+    for (int i = 0; i < PTYPE_PERF_PKTS; i += burst)
+        cne_get_ptype_bulk(&ptype_pkts[i], CNE_MIN(burst, PTYPE_PERF_PKTS - i));
+
+    for (int i = 0; i < PTYPE_PERF_PKTS; i++) {
+        struct cne_net_hdr_lens hdr_lens = {0};
+        pktmbuf_t *m                     = ptype_pkts[i];
+        uint32_t ptype                   = cne_get_ptype(m, &hdr_lens, CNE_PTYPE_ALL_MASK);
+
+        if (m->packet_type != ptype || m->l2_len != hdr_lens.l2_len ||
+            m->l3_len != hdr_lens.l3_len || m->l4_len != hdr_lens.l4_len) {
+            tst_error("Packet %d parsed as %08x %u/%u/%u, expected %08x %u/%u/%u", i,
+                      m->packet_type, m->l2_len, m->l3_len, m->l4_len, ptype, hdr_lens.l2_len,
+                      hdr_lens.l3_len, hdr_lens.l4_len);
+            return -1;
+        }
+        if (m->hash != ref_hash[i]) {
+            tst_error("Packet %d flow hash %08x in a burst of %u, %08x parsed alone", i, m->hash,
+                      burst, ref_hash[i]);
+            return -1;
+        }
+    }
+
+    return 0;
+}
+
+static int
+graph_ptype_perf(void)
+{
+    uint64_t scalar, bulk, nb = (uint64_t)PTYPE_PERF_PKTS * PTYPE_PERF_ITERS;
+
+    /* Full bursts and bursts ending with packets the vector code does not parse */
+    if (ptype_check(CNE_GRAPH_BURST_SIZE) < 0 || ptype_check(PTYPE_ODD_BURST) < 0)
+        return -1;
+
+    scalar = ptype_perf_run(ptype_perf_scalar);
+    bulk   = ptype_perf_run(cne_get_ptype_bulk);
+
+    tst_ok("Packet type: %.1f cycles/packet one at a time, %.1f cycles/packet in bursts with "
+           "the flow hash",
+           (double)scalar / nb, (double)bulk / nb);
+
+    return 0;
+}
+
 /* Graph Topology
  * nodes per stage:	4
  * stages:		5
@@ -961,6 +1168,7 @@ static struct unit_test_suite graph_perf_testsuite = {
             TEST_CASE_ST(graph_init_tree, graph_fini, graph_tree_4s_4n_1src_4snk),
             TEST_CASE_ST(graph_init_reverse_tree, graph_fini, graph_reverse_tree_3s_4n_1src_1snk),
             TEST_CASE_ST(graph_init_parallel_tree, graph_fini, graph_parallel_tree_5s_4n_4src_4snk),
+            TEST_CASE_ST(graph_init_ptype, graph_fini_ptype, graph_ptype_perf),
             TEST_CASES_END(), /**< NULL terminate unit test array */
         },
 };
@@ -4,6 +4,7 @@
 
 #include <stdio.h>               // for NULL, fflush, snprintf, stdout, EOF
 #include <inttypes.h>            // for PRIu64
+#include <cne_common.h>          // for CNE_MIN
 #include <cne_cycles.h>          // for cne_rdtsc
 #include <cne_hash.h>            // for hash_sig_t, cne_hash_parameters, cne_hash_...
 #include <cne_jhash.h>           // for cne_jhash
@@ -31,8 +32,9 @@ struct cne_hash;
 #define NUM_KEYSIZES 10
 #define NUM_SHUFFLES 10
 #define BURST_SIZE   16
+#define ADD_BURST    64 /* Keys given to each cne_hash_add_bulk() call */
 
-enum operations { ADD = 0, LOOKUP, LOOKUP_MULTI, DELETE, NUM_OPERATIONS };
+enum operations { ADD = 0, ADD_BULK, LOOKUP, LOOKUP_MULTI, DELETE, NUM_OPERATIONS };
 
 static uint32_t hashtest_key_lens[] = {
     /* standard key sizes */
@@ -305,6 +307,42 @@ timed_adds(unsigned int with_hash, unsigned int with_data, unsigned int table_in
     return 0;
 }
 
+static int
+timed_adds_bulk(unsigned int with_data, unsigned int table_index, unsigned int ext)
+{
+    const void *keys_burst[ADD_BURST];
+    void *data_burst[ADD_BURST];
+    unsigned int i, k, n, keys_to_add;
+    uint64_t start_tsc, time_taken = 0;
+    int ret;
+
+    if (!ext)
+        keys_to_add = KEYS_TO_ADD * ADD_PERCENT;
+    else
+        keys_to_add = KEYS_TO_ADD;
+
+    for (i = 0; i < keys_to_add; i += n) {
+        n = CNE_MIN(keys_to_add - i, (unsigned int)ADD_BURST);
+        for (k = 0; k < n; k++) {
+            keys_burst[k] = keys[i + k];
+            data_burst[k] = (void *)((uintptr_t)signatures[i + k]);
+        }
+
+        start_tsc = cne_rdtsc();
+        ret       = cne_hash_add_bulk(htables[table_index], keys_burst,
+                                      with_data ? data_burst : NULL, n, &positions[i]);
+        time_taken += cne_rdtsc() - start_tsc;
+        if (ret != (int)n) {
+            tst_error("Added %d of the %u keys starting at key number %u", ret, n, i);
+            return -1;
+        }
+    }
+
+    cycles[table_index][ADD_BULK][0][with_data] = time_taken / keys_to_add;
+
+    return 0;
+}
+
 static int
 timed_lookups(unsigned int with_hash, unsigned int with_data, unsigned int table_index,
               unsigned int ext)
@@ -527,6 +565,13 @@ run_all_tbl_perf_tests(unsigned int with_pushes, unsigned int ext)
                 if (timed_adds(with_hash, with_data, i, ext) < 0)
                     return -1;
 
+                /* The bulk add computes the hash values itself, time it once */
+                if (!with_hash) {
+                    reset_table(i);
+                    if (timed_adds_bulk(with_data, i, ext) < 0)
+                        return -1;
+                }
+
                 for (j = 0; j < NUM_SHUFFLES; j++)
                     shuffle_input_keys(i, ext);
 
@@ -558,12 +603,16 @@ run_all_tbl_perf_tests(unsigned int with_pushes, unsigned int ext)
             else
                 cne_printf("  Without pre-computed hash values\n");
 
-            cne_printf("    %-18s%-18s%-18s%-18s%-18s\n", "Keysize", "Add", "Lookup", "Lookup_bulk",
-                       "Delete");
+            cne_printf("    %-18s%-18s%-18s%-18s%-18s%-18s\n", "Keysize", "Add", "Add_bulk",
+                       "Lookup", "Lookup_bulk", "Delete");
             for (i = 0; i < NUM_KEYSIZES; i++) {
                 cne_printf("    %-18d", hashtest_key_lens[i]);
-                for (j = 0; j < NUM_OPERATIONS; j++)
-                    cne_printf("%-18" PRIu64, cycles[i][j][with_hash][with_data]);
+                for (j = 0; j < NUM_OPERATIONS; j++) {
+                    if (j == ADD_BULK && with_hash)
+                        cne_printf("%-18s", "-");
+                    else
+                        cne_printf("%-18" PRIu64, cycles[i][j][with_hash][with_data]);
+                }
                 cne_printf("\n");
             }
         }
@@ -912,6 +912,223 @@ test_extendable_bucket(void)
     return 0;
 }
 
+/*
+ * Hash function returning the source address of a flow_key, so a test can pick the primary
+ * bucket (low bits) and the signature (high 16 bits) of every key.
+ */
+static uint32_t
+ip_src_hash(const void *key, __cne_unused uint32_t key_len, __cne_unused uint32_t init_val)
+{
+    return ((const struct flow_key *)key)->ip_src;
+}
+
+/* Fill in count keys with a hash of (sig << 16) | bkt, told apart by the source port */
+static void
+bulk_keys(struct flow_key *k, const void **kp, unsigned int count, uint32_t bkt, uint32_t sig,
+          uint16_t port)
+{
+    unsigned int i;
+
+    for (i = 0; i < count; i++) {
+        memset(&k[i], 0, sizeof(k[i]));
+        k[i].ip_src   = (sig << 16) | bkt;
+        k[i].port_src = port + i;
+        kp[i]         = &k[i];
+    }
+}
+
+/*
+ * Bulk add keys repeated in the batch and keys already in the table.
+ *	- add 6 keys holding 3 distinct ones: 6 OK, duplicates get the same position
+ *	- lookup the 3 keys: the data of the last duplicate in the batch
+ *	- add 2 keys already in the table and 1 new key: same positions, data updated
+ */
+static int
+test_add_bulk_update(void)
+{
+    struct cne_hash_parameters params = ut_params;
+    const void *k[6]  = {&keys[0], &keys[1], &keys[0], &keys[2], &keys[1], &keys[0]};
+    const void *k2[3] = {&keys[2], &keys[3], &keys[0]};
+    void *data[6]     = {(void *)1, (void *)2, (void *)3, (void *)4, (void *)5, (void *)6};
+    void *data2[3]    = {(void *)7, (void *)8, (void *)9};
+    int32_t pos[6], pos2[3];
+    struct cne_hash *handle;
+    void *d;
+    int ret;
+
+    params.name = "bulk_update";
+    handle      = cne_hash_create(&params);
+    RETURN_IF_ERROR(handle == NULL, "hash creation failed");
+
+    ret = cne_hash_add_bulk(handle, k, data, 6, pos);
+    RETURN_IF_ERROR(ret != 6, "bulk add returned %d", ret);
+    RETURN_IF_ERROR(pos[0] < 0 || pos[1] < 0 || pos[3] < 0, "failed to add keys");
+    RETURN_IF_ERROR(pos[2] != pos[0] || pos[5] != pos[0] || pos[4] != pos[1],
+                    "duplicate key got a new position");
+    RETURN_IF_ERROR(cne_hash_count(handle) != 3, "wrong key count %d", cne_hash_count(handle));
+
+    ret = cne_hash_lookup_data(handle, &keys[0], &d);
+    RETURN_IF_ERROR(ret != pos[0] || d != data[5], "key 0 found at %d with data %p", ret, d);
+    ret = cne_hash_lookup_data(handle, &keys[1], &d);
+    RETURN_IF_ERROR(ret != pos[1] || d != data[4], "key 1 found at %d with data %p", ret, d);
+    ret = cne_hash_lookup_data(handle, &keys[2], &d);
+    RETURN_IF_ERROR(ret != pos[3] || d != data[3], "key 2 found at %d with data %p", ret, d);
+
+    ret = cne_hash_add_bulk(handle, k2, data2, 3, pos2);
+    RETURN_IF_ERROR(ret != 3, "bulk add returned %d", ret);
+    RETURN_IF_ERROR(pos2[0] != pos[3] || pos2[2] != pos[0], "existing key got a new position");
+    RETURN_IF_ERROR(pos2[1] < 0, "failed to add key 3 (pos=%d)", pos2[1]);
+    RETURN_IF_ERROR(cne_hash_count(handle) != 4, "wrong key count %d", cne_hash_count(handle));
+
+    ret = cne_hash_lookup_data(handle, &keys[2], &d);
+    RETURN_IF_ERROR(ret != pos[3] || d != data2[0], "key 2 found at %d with data %p", ret, d);
+    ret = cne_hash_lookup_data(handle, &keys[0], &d);
+    RETURN_IF_ERROR(ret != pos[0] || d != data2[2], "key 0 found at %d with data %p", ret, d);
+
+    cne_hash_free(handle);
+    return 0;
+}
+
+/*
+ * Bulk add a key whose two buckets are filled by the keys before it in the same batch.
+ *	- 8 keys fill bucket 0 and 8 keys fill bucket 1, all of them can move to bucket 2
+ *	- the last key of the batch has buckets 0 and 1 and is added by displacing a key
+ *	- lookup the 17 keys: 17 hits
+ */
+static int
+test_add_bulk_displace(void)
+{
+    struct cne_hash_parameters params = ut_params;
+    struct flow_key k[17];
+    const void *kp[17];
+    int32_t pos[17];
+    struct cne_hash *handle;
+    unsigned int i;
+    int ret;
+
+    params.name      = "bulk_displace";
+    params.hash_func = ip_src_hash;
+    handle           = cne_hash_create(&params);
+    RETURN_IF_ERROR(handle == NULL, "hash creation failed");
+
+    bulk_keys(&k[0], &kp[0], 8, 0, 2, 0);  /* bucket 0, alternative bucket 2 */
+    bulk_keys(&k[8], &kp[8], 8, 1, 3, 8);  /* bucket 1, alternative bucket 2 */
+    bulk_keys(&k[16], &kp[16], 1, 0, 1, 16); /* bucket 0, alternative bucket 1 */
+
+    ret = cne_hash_add_bulk(handle, kp, NULL, 17, pos);
+    RETURN_IF_ERROR(ret != 17, "bulk add returned %d", ret);
+
+    for (i = 0; i < 17; i++) {
+        RETURN_IF_ERROR(pos[i] < 0, "failed to add key (pos[%u]=%d)", i, pos[i]);
+        ret = cne_hash_lookup(handle, kp[i]);
+        RETURN_IF_ERROR(ret != pos[i], "failed to find key (pos[%u]=%d)", i, ret);
+    }
+
+    cne_hash_free(handle);
+    return 0;
+}
+
+/*
+ * Bulk add 20 keys to the same bucket of a table with extendable buckets.
+ *	- add the 20 keys: 20 OK, 12 of them in extendable buckets
+ *	- add the 20 keys again with new data: same positions
+ *	- lookup the 20 keys: 20 hits with the new data
+ */
+static int
+test_add_bulk_ext(void)
+{
+    struct cne_hash_parameters params = ut_params;
+    struct flow_key k[20];
+    const void *kp[20];
+    void *data[20];
+    int32_t pos[20], pos2[20];
+    struct cne_hash *handle;
+    unsigned int i;
+    void *d;
+    int ret;
+
+    params.name       = "bulk_ext";
+    params.hash_func  = pseudo_hash;
+    params.extra_flag = CNE_HASH_EXTRA_FLAGS_EXT_TABLE;
+    handle            = cne_hash_create(&params);
+    RETURN_IF_ERROR(handle == NULL, "hash creation failed");
+
+    bulk_keys(k, kp, 20, 0, 0, 0);
+    for (i = 0; i < 20; i++)
+        data[i] = (void *)(uintptr_t)(i + 1);
+
+    ret = cne_hash_add_bulk(handle, kp, data, 20, pos);
+    RETURN_IF_ERROR(ret != 20, "bulk add returned %d", ret);
+
+    for (i = 0; i < 20; i++)
+        data[i] = (void *)(uintptr_t)(i + 100);
+
+    ret = cne_hash_add_bulk(handle, kp, data, 20, pos2);
+    RETURN_IF_ERROR(ret != 20, "bulk add returned %d", ret);
+    RETURN_IF_ERROR(cne_hash_count(handle) != 20, "wrong key count %d", cne_hash_count(handle));
+
+    for (i = 0; i < 20; i++) {
+        RETURN_IF_ERROR(pos[i] < 0, "failed to add key (pos[%u]=%d)", i, pos[i]);
+        RETURN_IF_ERROR(pos2[i] != pos[i], "failed to update key (pos[%u]=%d)", i, pos2[i]);
+        ret = cne_hash_lookup_data(handle, kp[i], &d);
+        RETURN_IF_ERROR(ret != pos[i] || d != data[i], "key %u found at %d with data %p", i, ret,
+                        d);
+    }
+
+    cne_hash_free(handle);
+    return 0;
+}
+
+/*
+ * Bulk add more keys than there are free key slots.
+ *	- 60 entries in 8 buckets of 8, so bucket entries are left when the key slots run out
+ *	- add 56 keys filling buckets 0 to 6: 56 OK
+ *	- add 8 keys to bucket 7: 4 OK, 4 -ENOSPC
+ */
+static int
+test_add_bulk_full(void)
+{
+    struct cne_hash_parameters params = ut_params;
+    struct flow_key k[64];
+    const void *kp[64];
+    int32_t pos[64];
+    struct cne_hash *handle;
+    unsigned int i;
+    int ret;
+
+    params.name      = "bulk_full";
+    params.entries   = 60;
+    params.hash_func = ip_src_hash;
+    handle           = cne_hash_create(&params);
+    RETURN_IF_ERROR(handle == NULL, "hash creation failed");
+
+    for (i = 0; i < 8; i++)
+        bulk_keys(&k[i * 8], &kp[i * 8], 8, i, 0, i * 8);
+
+    ret = cne_hash_add_bulk(handle, kp, NULL, 56, pos);
+    RETURN_IF_ERROR(ret != 56, "bulk add returned %d", ret);
+
+    ret = cne_hash_add_bulk(handle, &kp[56], NULL, 8, &pos[56]);
+    RETURN_IF_ERROR(ret != 4, "bulk add returned %d", ret);
+    RETURN_IF_ERROR(cne_hash_count(handle) != 60, "wrong key count %d", cne_hash_count(handle));
+
+    for (i = 0; i < 64; i++) {
+        if (i < 60) {
+            RETURN_IF_ERROR(pos[i] < 0, "failed to add key (pos[%u]=%d)", i, pos[i]);
+            ret = cne_hash_lookup(handle, kp[i]);
+            RETURN_IF_ERROR(ret != pos[i], "failed to find key (pos[%u]=%d)", i, ret);
+        } else {
+            RETURN_IF_ERROR(pos[i] != -ENOSPC, "added key past the free slots (pos[%u]=%d)", i,
+                            pos[i]);
+            ret = cne_hash_lookup(handle, kp[i]);
+            RETURN_IF_ERROR(ret != -ENOENT, "fail: found non-existent key (pos[%u]=%d)", i, ret);
+        }
+    }
+
+    cne_hash_free(handle);
+    return 0;
+}
+
 /******************************************************************************/
 static int
 fbk_hash_unit_test(void)
@@ -1681,6 +1898,14 @@ test_hash(void)
         return -1;
     if (test_extendable_bucket() < 0)
         return -1;
+    if (test_add_bulk_update() < 0)
+        return -1;
+    if (test_add_bulk_displace() < 0)
+        return -1;
+    if (test_add_bulk_ext() < 0)
+        return -1;
+    if (test_add_bulk_full() < 0)
+        return -1;
 
     if (fbk_hash_unit_test() < 0)
         return -1;
@@ -18,6 +18,8 @@
 #include <json-c/json_visit.h>         // for JSON_C_VISIT_RETURN_ERROR, json_c_visit
 #include <stdlib.h>                    // for calloc, free
 #include <sys/queue.h>                 // for STAILQ_INSERT_TAIL
+#include <cne_lport.h>                 // for lport_cfg
+#include <cne_mmap.h>                  // for mmap_alloc, mmap_free, mmap_addr
 
 #include "jcfg_test.h"
 #include "cne_common.h"        // for __cne_unused, CNE_SET_USED
@@ -173,6 +175,96 @@ err:
     return -1;
 }
 
+#define MQ_NB_QUEUES 4
+
+// clang-format off
+static const char *mq_json =
+    "{"
+    "  \"application\": { \"name\": \"jcfg_test\" },"
+    "  \"defaults\": { \"bufcnt\": 1, \"bufsz\": 2, \"rxdesc\": 1, \"txdesc\": 1 },"
+    "  \"umems\": {"
+    "    \"umem0\": { \"bufcnt\": 1, \"bufsz\": 2, \"mtype\": \"4KB\", \"regions\": [1] }"
+    "  },"
+    "  \"lports\": {"
+    "    \"eth0:4\": { \"pmd\": \"net_af_xdp\", \"qid\": 4, \"nb_queues\": 4,"
+    "                  \"umem\": \"umem0\", \"region\": 0 }"
+    "  },"
+    "  \"lcore-groups\": { \"initial\": [0], \"group0\": [0] },"
+    "  \"threads\": {"
+    "    \"main\": { \"group\": \"initial\" },"
+    "    \"fwd:0\": { \"group\": \"group0\", \"lports\": [\"eth0:4\"] },"
+    "    \"fwd:1\": { \"group\": \"group0\", \"lports\": [\"eth0:4\"] },"
+    "    \"fwd:2\": { \"group\": \"group0\", \"lports\": [\"eth0:4\"] },"
+    "    \"fwd:3\": { \"group\": \"group0\", \"lports\": [\"eth0:4\"] }"
+    "  }"
+    "}";
+// clang-format on
+
+/* A multi-queue lport passes nb_queues to lport_cfg and each thread polls its own queue */
+static int
+test_lport_queues(int flags)
+{
+    jcfg_info_t *jinfo    = NULL;
+    struct lport_cfg pcfg = {0};
+    uint16_t seen_qids    = 0;
+    jcfg_lport_t *lport;
+    jcfg_umem_t *umem;
+
+    flags = (flags & ~JCFG_PARSE_FILE) | JCFG_PARSE_STRING;
+
+    jinfo = jcfg_parser(flags, mq_json);
+    TST_ASSERT_GOTO(jinfo, "jcfg_parser() failed for the multi-queue lport\n", err);
+    TST_ASSERT_GOTO(jcfg_process(jinfo, flags, process_callback, NULL) == 0,
+                    "jcfg_process() failed for the multi-queue lport\n", err);
+
+    lport = jcfg_lookup_lport(jinfo, "eth0:4");
+    TST_ASSERT_GOTO(lport, "lport eth0:4 not found\n", err);
+    TST_ASSERT_GOTO(lport->nb_queues == MQ_NB_QUEUES, "lport nb_queues %u != %u\n", err,
+                    lport->nb_queues, MQ_NB_QUEUES);
+
+    /* The application allocates the UMEM and sets the region addresses */
+    umem     = lport->umem;
+    umem->mm = mmap_alloc(umem->bufcnt, umem->bufsz, MMAP_HUGEPAGE_4KB);
+    TST_ASSERT_GOTO(umem->mm, "mmap_alloc() failed\n", err);
+    umem->rinfo[0].addr = mmap_addr(umem->mm);
+
+    TST_ASSERT_GOTO(jcfg_lport_cfg(lport, &pcfg) == 0, "jcfg_lport_cfg() failed\n", err);
+    TST_ASSERT_GOTO(pcfg.qid == 4 && pcfg.nb_queues == MQ_NB_QUEUES,
+                    "lport_cfg qid %u nb_queues %u, expected 4 and %u\n", err, pcfg.qid,
+                    pcfg.nb_queues, MQ_NB_QUEUES);
+
+    for (int i = 0; i < MQ_NB_QUEUES; i++) {
+        char name[16];
+        jcfg_thd_t *thd;
+
+        snprintf(name, sizeof(name), "fwd:%d", i);
+        thd = jcfg_lookup_thread(jinfo, name);
+        TST_ASSERT_GOTO(thd && thd->lport_cnt == 1 && thd->lports[0] == lport,
+                        "thread %s does not poll lport eth0:4\n", err, name);
+        TST_ASSERT_GOTO(thd->lport_qids[0] < MQ_NB_QUEUES, "thread %s qid %u out of range\n", err,
+                        name, thd->lport_qids[0]);
+        TST_ASSERT_GOTO(!(seen_qids & (1 << thd->lport_qids[0])),
+                        "thread %s polls queue %u of another thread\n", err, name,
+                        thd->lport_qids[0]);
+        seen_qids |= (1 << thd->lport_qids[0]);
+    }
+
+    mmap_free(umem->mm);
+    umem->mm = NULL;
+    jcfg_destroy(jinfo);
+    return 0;
+err:
+    if (jinfo) {
+        lport = jcfg_lookup_lport(jinfo, "eth0:4");
+        if (lport && lport->umem) {
+            mmap_free(lport->umem->mm);
+            lport->umem->mm = NULL;
+        }
+        jcfg_destroy(jinfo);
+    }
+    return -1;
+}
+
 int
 jcfg_main(int argc, char **argv)
 {
@@ -208,6 +300,9 @@ jcfg_main(int argc, char **argv)
     if (test_json_files(JSON_TEST_DIR, flags))
         goto leave;
 
+    if (test_lport_queues(flags))
+        goto leave;
+
     tst_end(tst, TST_PASSED);
 
     return 0;
@@ -11,6 +11,7 @@
 #include <tst_info.h>          // for tst_end, tst_ok, TST_ASSERT_GOTO, tst_...
 #include <cne_common.h>        // for CNE_USED, cne_countof
 #include <stdint.h>            // for uint32_t
+#include <string.h>            // for strstr
 
 #include "mbuf_test.h"
 #include "mempool.h"         // for mempool_cfg
@@ -189,6 +190,27 @@ mbuf_main(int argc, char **argv)
     }
     cne_printf("\n");
     tst_end(tst, TST_PASSED);
+
+    tst = tst_start("PKTMBUF offload flags");
+    mm  = NULL;
+
+    /* Flags used by the AF_XDP metadata must have names and stay out of the free range */
+    ret = cne_get_rx_ol_flag_list(CNE_MBUF_F_RX_RSS_HASH | CNE_MBUF_F_RX_TIMESTAMP, err_msg,
+                                  sizeof(err_msg));
+    TST_ASSERT_GOTO(ret == 0 && strstr(err_msg, "RX_TIMESTAMP") && strstr(err_msg, "RX_RSS_HASH"),
+                    "RX flag list is wrong: %s", err, err_msg);
+    ret = cne_get_tx_ol_flag_list(CNE_MBUF_F_TX_TCP_CKSUM | CNE_MBUF_F_TX_LAUNCH_TIME, err_msg,
+                                  sizeof(err_msg));
+    TST_ASSERT_GOTO(ret == 0 && strstr(err_msg, "TX_LAUNCH_TIME") &&
+                        strstr(err_msg, "TX_TCP_CKSUM"),
+                    "TX flag list is wrong: %s", err, err_msg);
+    TST_ASSERT_GOTO(CNE_MBUF_F_RX_TIMESTAMP < CNE_MBUF_F_FIRST_FREE &&
+                        CNE_MBUF_F_TX_LAUNCH_TIME > CNE_MBUF_F_LAST_FREE,
+                    "Offload flags overlap the free flag range", err);
+    TST_ASSERT_GOTO(CNE_MBUF_F_TX_OFFLOAD_MASK & CNE_MBUF_F_TX_LAUNCH_TIME,
+                    "TX_LAUNCH_TIME missing from the TX offload mask", err);
+
+    tst_end(tst, TST_PASSED);
     return 0;
 
 err:
@@ -6,6 +6,7 @@
 
 #include <stdio.h>             // for NULL, EOF
 #include <stdlib.h>            // for rand
+#include <inttypes.h>          // for PRIu64
 #include <getopt.h>            // for getopt_long, option
 #include <cne_common.h>        // for cne_countof
 #include <mempool.h>           // for mempool_destroy, mempool_cfg, mempool_...
@@ -24,6 +25,104 @@ typedef struct {
 
 enum { OK = 0, ERR };
 
+#define CACHE_OBJCNT 1024
+#define CACHE_SZ     64
+#define CACHE_LOW_WM 16
+#define CACHE_HIGH   96
+#define CACHE_BURST  8
+#define CACHE_GETS   (CACHE_SZ / CACHE_BURST)
+
+static int
+mempool_cache_test(int verbose)
+{
+    struct mempool_cfg ci = {.objcnt = CACHE_OBJCNT, .objsz = 512, .cache_sz = 0};
+    struct mempool_cache *cache = NULL;
+    mempool_cache_stats_t cs;
+    mempool_t *mp = NULL;
+    mmap_t *mm;
+    void *objs[CACHE_SZ];
+    int i;
+
+    mm = mmap_alloc(ci.objcnt, ci.objsz, MMAP_HUGEPAGE_DEFAULT);
+    if (!mm) {
+        tst_error("Fail to mmap_alloc(%d)\n", ci.objcnt * ci.objsz);
+        return -1;
+    }
+    ci.addr = mmap_addr(mm);
+
+    mp = mempool_create(&ci);
+    if (!mp) {
+        tst_error("Failed to create mempool\n");
+        goto err;
+    }
+
+    if (mempool_cache_create(mp, CACHE_SZ, CACHE_SZ, CACHE_HIGH) ||
+        mempool_cache_create(mp, CACHE_SZ, CACHE_LOW_WM, CACHE_SZ)) {
+        tst_error("Mempool cache created with invalid watermarks\n");
+        goto err;
+    }
+
+    cache = mempool_cache_create(mp, CACHE_SZ, CACHE_LOW_WM, CACHE_HIGH);
+    if (!cache) {
+        tst_error("Failed to create mempool cache\n");
+        goto err;
+    }
+
+    /*
+     * The first get refills the cache, the following gets are served from the
+     * cache until the next get would drop it below the low watermark.
+     */
+    for (i = 0; i < CACHE_GETS; i++) {
+        if (mempool_generic_get(mp, &objs[i * CACHE_BURST], CACHE_BURST, cache)) {
+            tst_error("mempool_generic_get(%d) with cache failed\n", i);
+            goto err;
+        }
+    }
+    mempool_cache_stats_get(mp, &cs);
+    if (cs.hits != (CACHE_GETS - 2) || cs.misses != 2 || cs.refills != 2) {
+        tst_error("Cache get stats hits %" PRIu64 " misses %" PRIu64 " refills %" PRIu64 "\n",
+                  cs.hits, cs.misses, cs.refills);
+        goto err;
+    }
+    if (mempool_avail_count(mp) != (CACHE_OBJCNT - (2 * CACHE_SZ))) {
+        tst_error("Cache refill took %u objects\n", CACHE_OBJCNT - mempool_avail_count(mp));
+        goto err;
+    }
+    tst_ok("PASS --- TEST: Mempool cache refill test pass\n");
+
+    /* Puts fill the cache to the high watermark and then flush back to size */
+    for (i = 0; i < CACHE_GETS; i++)
+        mempool_generic_put(mp, &objs[i * CACHE_BURST], CACHE_BURST, cache);
+    mempool_cache_stats_get(mp, &cs);
+    if (cs.flushes != ((CACHE_GETS * CACHE_BURST) / (CACHE_HIGH - CACHE_SZ)) ||
+        mempool_avail_count(mp) != (CACHE_OBJCNT - CACHE_SZ)) {
+        tst_error("Cache flushes %" PRIu64 ", avail %u\n", cs.flushes, mempool_avail_count(mp));
+        goto err;
+    }
+    tst_ok("PASS --- TEST: Mempool cache flush test pass\n");
+
+    if (verbose)
+        mempool_dump(mp);
+
+    mempool_cache_destroy(mp, cache);
+    cache = NULL;
+    if (!mempool_full(mp)) {
+        tst_error("Mempool not full after cache destroy\n");
+        goto err;
+    }
+    tst_ok("PASS --- TEST: Mempool cache destroy test pass\n");
+
+    mempool_destroy(mp);
+    mmap_free(mm);
+    return 0;
+
+err:
+    mempool_cache_destroy(mp, cache);
+    mempool_destroy(mp);
+    mmap_free(mm);
+    return -1;
+}
+
 int
 mempool_main(int argc, char **argv)
 {
@@ -133,6 +232,10 @@ mempool_main(int argc, char **argv)
         mempool_destroy(mp);
         mmap_free(mm);
     }
+    mm = NULL;
+
+    if (mempool_cache_test(verbose))
+        goto err;
 
     tst_end(tst, TST_PASSED);
     return 0;
@@ -166,6 +166,42 @@ mmap_main(int argc, char **argv)
         }
     }
 
+    cne_printf("\n[blue]>>>[white]TEST: API Test for mmap_alloc_numa\n[]");
+    mmap_stats_t stats;
+    uint64_t remote;
+
+    mmap = mmap_alloc_numa(1024, 2048, MMAP_HUGEPAGE_4KB, 0);
+    if (!mmap) {
+        tst_error("mmap_alloc_numa() failed\n");
+        goto err;
+    }
+    if (mmap_numa_node(mmap, &remote) != 0) {
+        tst_error("mmap NUMA node is not 0\n");
+        goto err;
+    }
+    if (mmap_stats_get(&stats) || stats.sizes[MMAP_HUGEPAGE_4KB].remote_pages < remote) {
+        tst_error("mmap remote pages %lu not in the stats\n", remote);
+        goto err;
+    }
+    if (remote)
+        cne_printf("[yellow]%lu[] pages are not on NUMA node 0\n", remote);
+    if (mmap_free(mmap)) {
+        tst_error("mmap_free() failed\n");
+        goto err;
+    }
+    mmap = NULL;
+
+    mmap = mmap_alloc(1, 1, MMAP_HUGEPAGE_4KB);
+    if (!mmap || mmap_numa_node(mmap, NULL) != MMAP_NUMA_NODE_ANY) {
+        tst_error("mmap_alloc() memory has a NUMA node\n");
+        goto err;
+    }
+    if (mmap_free(mmap)) {
+        tst_error("mmap_free() failed\n");
+        goto err;
+    }
+    mmap = NULL;
+
     tst_end(tst, TST_PASSED);
 
     return 0;
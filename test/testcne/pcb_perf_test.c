@@ -0,0 +1,203 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright (c) 2023 Intel Corporation
+ */
+
+#include <stdio.h>            // for NULL
+#include <stdint.h>           // for uint32_t, uint64_t
+#include <stdlib.h>           // for rand, srand, aligned_alloc, free
+#include <string.h>           // for memset
+#include <getopt.h>           // for getopt_long, option
+#include <netinet/in.h>       // for htonl, htons
+
+#include <cne_cycles.h>        // for cne_rdtsc
+#include <cne_common.h>        // for CNE_CACHE_LINE_SIZE
+#include <cne_vec.h>           // for vec_add, vec_free
+#include <cnet_pcb.h>          // for pcb_entry, pcb_hd, cnet_pcb_lookup
+#include <tst_info.h>          // for tst_start, tst_end
+#include <cne_log.h>
+
+#include "pcb_test.h"
+
+#define TEST_PCB_ASSERT(cond)                            \
+    do {                                                 \
+        if (!(cond)) {                                   \
+            cne_printf("Error at line %d:\n", __LINE__); \
+            goto err;                                    \
+        }                                                \
+    } while (0)
+
+#define NUM_LISTENERS  16        /**< Wildcard listener PCBs on ports 80 to 95 */
+#define NUM_LOOKUPS    (1 << 20) /**< Number of lookups for the hash table */
+#define LINEAR_LOOKUPS (1 << 10) /**< Linear scans are slow, use fewer lookups */
+#define BULK_SIZE      4         /**< Same burst width as the tcp_input node */
+#define MISS_RATE      16        /**< One in MISS_RATE keys is a new connection */
+
+#define LOCAL_ADDR 0x0b000001 /**< 11.0.0.1 */
+
+static const uint32_t pcb_counts[] = {1000, 10000, 100000};
+
+static void
+pcb_key_set(struct pcb_key *key, uint32_t faddr, uint16_t fport, uint32_t laddr, uint16_t lport)
+{
+    memset(key, 0, sizeof(struct pcb_key));
+
+    in_caddr_update(&key->faddr, AF_INET, sizeof(struct in_addr), htons(fport));
+    key->faddr.cin_addr.s_addr = htonl(faddr);
+    in_caddr_update(&key->laddr, AF_INET, sizeof(struct in_addr), htons(lport));
+    key->laddr.cin_addr.s_addr = htonl(laddr);
+}
+
+/* Established connection i uses a unique foreign address and one of the listener ports */
+static void
+pcb_conn_key(struct pcb_key *key, uint32_t i)
+{
+    pcb_key_set(key, 0x0a000000 + i, 1024 + (i & 0x7fff), LOCAL_ADDR, 80 + (i % NUM_LISTENERS));
+}
+
+static int
+pcb_perf_run(uint32_t nb_pcbs)
+{
+    struct pcb_hd linear = {0}, hashed = {0};
+    struct pcb_entry *pcbs = NULL;
+    struct pcb_key *keys   = NULL;
+    uint32_t total         = nb_pcbs + NUM_LISTENERS;
+    uint64_t begin, linear_time, hash_time, bulk_time;
+    uint32_t i, found = 0;
+
+    pcbs = aligned_alloc(CNE_CACHE_LINE_SIZE, total * sizeof(struct pcb_entry));
+    keys = calloc(NUM_LOOKUPS, sizeof(struct pcb_key));
+    TEST_PCB_ASSERT(pcbs != NULL && keys != NULL);
+    memset(pcbs, 0, total * sizeof(struct pcb_entry));
+
+    TEST_PCB_ASSERT(cnet_pcb_hd_init(&hashed, "pcb_perf", total) == 0);
+
+    /* Listeners are added first, established connections are found after them in a scan */
+    for (i = 0; i < total; i++) {
+        struct pcb_entry *pcb = &pcbs[i];
+
+        if (i < NUM_LISTENERS)
+            pcb_key_set(&pcb->key, 0, 0, LOCAL_ADDR, 80 + i);
+        else
+            pcb_conn_key(&pcb->key, i - NUM_LISTENERS);
+        pcb->ip_proto = IPPROTO_TCP;
+
+        vec_add(linear.vec, pcb);
+        cnet_pcb_link(&hashed, pcb);
+    }
+    TEST_PCB_ASSERT(vec_len(hashed.wild) == NUM_LISTENERS);
+
+    /* Mostly established connections with a few SYNs for the listeners */
+    for (i = 0; i < NUM_LOOKUPS; i++) {
+        uint32_t n = (uint32_t)rand() % nb_pcbs;
+
+        if ((i % MISS_RATE) == 0)
+            pcb_conn_key(&keys[i], nb_pcbs + n);
+        else
+            pcb_conn_key(&keys[i], n);
+    }
+
+    /* The hash lookup must return the same PCB as the linear scan */
+    for (i = 0; i < LINEAR_LOOKUPS; i++) {
+        struct pcb_entry *p1 = cnet_pcb_lookup(&linear, &keys[i], BEST_MATCH);
+        struct pcb_entry *p2 = cnet_pcb_lookup(&hashed, &keys[i], BEST_MATCH);
+
+        TEST_PCB_ASSERT(p1 != NULL && p1 == p2);
+    }
+
+    begin = cne_rdtsc();
+    for (i = 0; i < LINEAR_LOOKUPS; i++)
+        found += cnet_pcb_lookup(&linear, &keys[i], BEST_MATCH) != NULL;
+    linear_time = cne_rdtsc() - begin;
+
+    begin = cne_rdtsc();
+    for (i = 0; i < NUM_LOOKUPS; i++)
+        found += cnet_pcb_lookup(&hashed, &keys[i], BEST_MATCH) != NULL;
+    hash_time = cne_rdtsc() - begin;
+
+    begin = cne_rdtsc();
+    for (i = 0; i < NUM_LOOKUPS; i += BULK_SIZE) {
+        struct pcb_key *kptrs[BULK_SIZE];
+        struct pcb_entry *res[BULK_SIZE];
+
+        for (int j = 0; j < BULK_SIZE; j++)
+            kptrs[j] = &keys[i + j];
+
+        cnet_pcb_lookup_bulk(&hashed, kptrs, BULK_SIZE, res);
+
+        /* Misses fall back to the listener lookup like tcp_input does */
+        for (int j = 0; j < BULK_SIZE; j++) {
+            if (res[j] == NULL)
+                res[j] = cnet_pcb_lookup(&hashed, kptrs[j], BEST_MATCH);
+            found += res[j] != NULL;
+        }
+    }
+    bulk_time = cne_rdtsc() - begin;
+
+    TEST_PCB_ASSERT(found == LINEAR_LOOKUPS + (2 * NUM_LOOKUPS));
+
+    cne_printf("  %6u PCBs: linear %10.1f, hash %6.1f, bulk x%d %6.1f cycles/lookup\n", nb_pcbs,
+               (double)linear_time / LINEAR_LOOKUPS, (double)hash_time / NUM_LOOKUPS, BULK_SIZE,
+               (double)bulk_time / NUM_LOOKUPS);
+
+    vec_free(linear.vec);
+    cnet_pcb_hd_free(&hashed);
+    free(keys);
+    free(pcbs);
+    return 0;
+
+err:
+    vec_free(linear.vec);
+    cnet_pcb_hd_free(&hashed);
+    free(keys);
+    free(pcbs);
+    return -1;
+}
+
+static int
+test_pcb_perf(void)
+{
+    srand(cne_rdtsc());
+
+    cne_printf("PCB lookup with %d listeners, 1 in %d lookups for a listener\n", NUM_LISTENERS,
+               MISS_RATE);
+
+    for (uint32_t i = 0; i < cne_countof(pcb_counts); i++) {
+        if (pcb_perf_run(pcb_counts[i]) < 0)
+            return -1;
+    }
+
+    return 0;
+}
+
+int
+pcb_perf_main(int argc, char **argv)
+{
+    tst_info_t *tst;
+    int opt;
+    char **argvopt;
+    int option_index;
+    static const struct option lgopts[] = {{NULL, 0, 0, 0}};
+
+    argvopt = argv;
+
+    while ((opt = getopt_long(argc, argvopt, "v", lgopts, &option_index)) != EOF) {
+        switch (opt) {
+        case 'v':
+            break;
+        default:
+            break;
+        }
+    }
+
+    tst = tst_start("PCB Perf");
+
+    if (test_pcb_perf() < 0)
+        goto leave;
+
+    tst_end(tst, TST_PASSED);
+
+    return 0;
+leave:
+    tst_end(tst, TST_FAILED);
+    return -1;
+}
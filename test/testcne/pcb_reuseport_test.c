@@ -0,0 +1,298 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright (c) 2023 Intel Corporation
+ */
+
+#include <stdio.h>             // for NULL, EOF
+#include <stdint.h>            // for uint32_t, uint16_t
+#include <stdlib.h>            // for calloc, free
+#include <string.h>            // for memset
+#include <getopt.h>            // for getopt_long, option
+#include <netinet/in.h>        // for htonl, htons, IPPROTO_TCP, IPPROTO_UDP
+
+#include <cne_common.h>        // for CNE_CACHE_LINE_SIZE
+#include <cne_vec.h>           // for vec_len
+#include <pktmbuf.h>           // for pktmbuf_t, CNE_MBUF_F_RX_RSS_HASH
+#include <cnet.h>              // for cnet, this_cnet
+#include <cnet_pcb.h>          // for pcb_entry, cnet_pcb_reuseport_join, cnet_pcb_lookup
+#include <tst_info.h>          // for tst_end, tst_ok, TST_ASSERT_GOTO, tst_start
+
+#include "pcb_reuseport_test.h"
+
+#define RP_NB_MEMBERS 4    /**< Listeners in the group */
+#define RP_NB_FLOWS   8192 /**< New flows spread over the group */
+#define RP_PORT       8080
+#define RP_LADDR      0x0b000001 /**< 11.0.0.1 */
+
+struct rp_state {
+    struct pcb_hd hd;
+    struct pcb_entry *pcbs;       /**< Group members and the PCBs bound after them */
+    uint8_t *owner;               /**< Member index selected for each flow */
+    uint32_t counts[RP_NB_MEMBERS];
+};
+
+static void
+rp_key_set(struct pcb_key *key, uint32_t faddr, uint16_t fport, uint16_t lport)
+{
+    memset(key, 0, sizeof(struct pcb_key));
+
+    in_caddr_update(&key->faddr, AF_INET, sizeof(struct in_addr), htons(fport));
+    key->faddr.cin_addr.s_addr = htonl(faddr);
+    in_caddr_update(&key->laddr, AF_INET, sizeof(struct in_addr), htons(lport));
+    key->laddr.cin_addr.s_addr = htonl(RP_LADDR);
+}
+
+/* Flow i of the test, a SYN from a different client address and port */
+static inline void
+rp_flow_key(struct pcb_key *key, uint32_t i)
+{
+    rp_key_set(key, 0x0a000000 + (i >> 4), 1024 + (i & 0xf) * 97, RP_PORT);
+}
+
+/* Find the listener of the flow like tcp_input and spread it over the group */
+static struct pcb_entry *
+rp_select(struct rp_state *rs, struct pcb_key *key, pktmbuf_t *m)
+{
+    struct pcb_entry *pcb = cnet_pcb_lookup(&rs->hd, key, BEST_MATCH);
+
+    return cnet_pcb_reuseport(pcb, m, key);
+}
+
+/* Select a member for every flow, returns the number of flows which moved */
+static int
+rp_spread(struct rp_state *rs, bool first)
+{
+    pktmbuf_t m = {0};
+    int moved   = 0;
+
+    memset(rs->counts, 0, sizeof(rs->counts));
+    for (uint32_t i = 0; i < RP_NB_FLOWS; i++) {
+        struct pcb_key key;
+        struct pcb_entry *pcb;
+        uint8_t idx;
+
+        rp_flow_key(&key, i);
+        pcb = rp_select(rs, &key, &m);
+        if (!pcb || pcb < rs->pcbs || pcb >= &rs->pcbs[RP_NB_MEMBERS])
+            return -1;
+        idx = pcb - rs->pcbs;
+        rs->counts[idx]++;
+
+        if (!first && rs->owner[i] != idx)
+            moved++;
+        rs->owner[i] = idx;
+    }
+    return moved;
+}
+
+static void
+rp_destroy(struct rp_state *rs)
+{
+    if (!rs)
+        return;
+
+    for (int i = 0; rs->pcbs && i < RP_NB_MEMBERS + 2; i++) {
+        cnet_pcb_reuseport_leave(&rs->pcbs[i]);
+        cnet_pcb_unlink(&rs->pcbs[i]);
+    }
+    cnet_pcb_hd_free(&rs->hd);
+    free(rs->pcbs);
+    free(rs->owner);
+    free(rs);
+}
+
+static struct rp_state *
+rp_create(void)
+{
+    struct rp_state *rs = calloc(1, sizeof(struct rp_state));
+
+    if (!rs)
+        return NULL;
+
+    rs->pcbs  = aligned_alloc(CNE_CACHE_LINE_SIZE, (RP_NB_MEMBERS + 2) * sizeof(struct pcb_entry));
+    rs->owner = calloc(RP_NB_FLOWS, sizeof(uint8_t));
+    if (!rs->pcbs || !rs->owner || cnet_pcb_hd_init(&rs->hd, "reuseport_test", 64) < 0) {
+        rp_destroy(rs);
+        return NULL;
+    }
+    memset(rs->pcbs, 0, (RP_NB_MEMBERS + 2) * sizeof(struct pcb_entry));
+
+    return rs;
+}
+
+/* Bind a listener PCB to the group address and port */
+static int
+rp_bind(struct rp_state *rs, int i, uint8_t proto, uint16_t port, bool reuse)
+{
+    struct pcb_entry *pcb = &rs->pcbs[i];
+
+    cnet_pcb_unlink(pcb);
+    rp_key_set(&pcb->key, 0, 0, port);
+    pcb->ip_proto = proto;
+
+    if (cnet_pcb_reuseport_join(pcb, &pcb->key.laddr, reuse) < 0)
+        return -1;
+    cnet_pcb_link(&rs->hd, pcb);
+
+    return 0;
+}
+
+/* The flows are spread evenly over the group and each flow always selects the same member */
+static int
+test_reuseport_spread(struct rp_state *rs)
+{
+    struct pcb_reuseport *grp;
+    pktmbuf_t m = {0};
+    struct pcb_key key;
+
+    for (int i = 0; i < RP_NB_MEMBERS; i++)
+        TST_ASSERT_GOTO(rp_bind(rs, i, IPPROTO_TCP, RP_PORT, true) == 0,
+                        "Failed to bind member %d", err, i);
+    grp = rs->pcbs[0].reuseport;
+    TST_ASSERT_GOTO(grp && grp->nb_pcbs == RP_NB_MEMBERS, "Members not in one group", err);
+    for (int i = 1; i < RP_NB_MEMBERS; i++)
+        TST_ASSERT_GOTO(rs->pcbs[i].reuseport == grp, "Member %d in another group", err, i);
+
+    TST_ASSERT_GOTO(rp_spread(rs, true) == 0, "Flow selected a PCB out of the group", err);
+    for (int i = 0; i < RP_NB_MEMBERS; i++) {
+        uint32_t want = RP_NB_FLOWS / RP_NB_MEMBERS;
+
+        TST_ASSERT_GOTO(rs->counts[i] > (want * 3) / 4 && rs->counts[i] < (want * 5) / 4,
+                        "Member %d got %u flows expected about %u", err, i, rs->counts[i],
+                        want);
+    }
+    TST_ASSERT_GOTO(rp_spread(rs, false) == 0, "Flows moved without a group change", err);
+    tst_ok("New flows spread evenly over %d members", RP_NB_MEMBERS);
+
+    /* The RSS hash of the driver selects the member when present */
+    m.ol_flags = CNE_MBUF_F_RX_RSS_HASH;
+    for (uint32_t h = 0, seen = 0; h < 64; h++) {
+        struct pcb_entry *pcb;
+
+        pktmbuf_hash(&m) = h * 0x9e3779b9;
+        rp_flow_key(&key, 0);
+        pcb = rp_select(rs, &key, &m);
+        rp_flow_key(&key, h + 1);
+        TST_ASSERT_GOTO(rp_select(rs, &key, &m) == pcb, "Same RSS hash selected another PCB",
+                        err);
+        seen |= 1 << (pcb - rs->pcbs);
+        if (h == 63)
+            TST_ASSERT_GOTO(seen == (1 << RP_NB_MEMBERS) - 1,
+                            "RSS hash did not select every member", err);
+    }
+    tst_ok("RSS hash selects the member");
+
+    return 0;
+err:
+    return -1;
+}
+
+/* A member leaving only moves its own flows, joining again only takes them back */
+static int
+test_reuseport_leave(struct rp_state *rs)
+{
+    struct pcb_reuseport *grp = rs->pcbs[0].reuseport;
+    uint32_t before[RP_NB_MEMBERS];
+    int gone = 2, moved;
+
+    rp_spread(rs, true);
+    memcpy(before, rs->counts, sizeof(before));
+
+    cnet_pcb_reuseport_leave(&rs->pcbs[gone]);
+    cnet_pcb_unlink(&rs->pcbs[gone]);
+    TST_ASSERT_GOTO(grp->nb_pcbs == RP_NB_MEMBERS - 1, "Group has %u members", err,
+                    grp->nb_pcbs);
+
+    for (uint32_t i = 0; i < RP_NB_FLOWS; i++) {
+        if (rs->owner[i] == gone)
+            rs->owner[i] = RP_NB_MEMBERS; /* Any other member is fine for these flows */
+    }
+    moved = rp_spread(rs, false);
+    TST_ASSERT_GOTO(moved == (int)before[gone], "%d flows moved, the member had %u", err, moved,
+                    before[gone]);
+    TST_ASSERT_GOTO(rs->counts[gone] == 0, "Flows still selected the member", err);
+    for (int i = 0; i < RP_NB_MEMBERS; i++)
+        TST_ASSERT_GOTO(i == gone || rs->counts[i] > before[i],
+                        "Member %d got none of the moved flows", err, i);
+    tst_ok("Member leaving only moves its own flows");
+
+    /* Joining again only takes back the flows the member had */
+    TST_ASSERT_GOTO(rp_bind(rs, gone, IPPROTO_TCP, RP_PORT, true) == 0, "Failed to rejoin",
+                    err);
+    moved = rp_spread(rs, false);
+    TST_ASSERT_GOTO(moved == (int)before[gone] && rs->counts[gone] == before[gone],
+                    "%d flows moved back, the member had %u", err, moved, before[gone]);
+    tst_ok("Member joining again only takes back its own flows");
+
+    return 0;
+err:
+    return -1;
+}
+
+/* A bind without SO_REUSEPORT to the address and port of a group is rejected */
+static int
+test_reuseport_exclusive(struct rp_state *rs)
+{
+    struct pcb_reuseport *grp = rs->pcbs[0].reuseport;
+    struct cnet *cnet         = this_cnet;
+    struct pcb_entry *other   = &rs->pcbs[RP_NB_MEMBERS];
+    struct pcb_entry *udp     = &rs->pcbs[RP_NB_MEMBERS + 1];
+    uint32_t nb_groups        = vec_len(cnet->reuseport);
+
+    TST_ASSERT_GOTO(rp_bind(rs, RP_NB_MEMBERS, IPPROTO_TCP, RP_PORT, false) < 0,
+                    "Bind without SO_REUSEPORT joined the group", err);
+    TST_ASSERT_GOTO(other->reuseport == NULL && grp->nb_pcbs == RP_NB_MEMBERS,
+                    "Rejected bind changed the group", err);
+
+    /* Another port or protocol is not in the group */
+    TST_ASSERT_GOTO(rp_bind(rs, RP_NB_MEMBERS, IPPROTO_TCP, RP_PORT + 1, false) == 0 &&
+                        other->reuseport == NULL,
+                    "Bind to another port failed", err);
+    TST_ASSERT_GOTO(rp_bind(rs, RP_NB_MEMBERS + 1, IPPROTO_UDP, RP_PORT, false) == 0 &&
+                        udp->reuseport == NULL,
+                    "UDP bind to the TCP group port failed", err);
+    TST_ASSERT_GOTO(vec_len(cnet->reuseport) == nb_groups, "Group created without reuse", err);
+    tst_ok("Bind without SO_REUSEPORT to a group port rejected");
+
+    /* The group is freed with its last member */
+    for (int i = 0; i < RP_NB_MEMBERS; i++)
+        cnet_pcb_reuseport_leave(&rs->pcbs[i]);
+    TST_ASSERT_GOTO(vec_len(cnet->reuseport) == nb_groups - 1, "Group not freed", err);
+    TST_ASSERT_GOTO(rp_bind(rs, RP_NB_MEMBERS, IPPROTO_TCP, RP_PORT, false) == 0,
+                    "Bind failed after the group was freed", err);
+    tst_ok("Group freed with its last member");
+
+    return 0;
+err:
+    return -1;
+}
+
+int
+pcb_reuseport_main(int argc, char **argv)
+{
+    static const struct option lgopts[] = {{NULL, 0, 0, 0}};
+    struct rp_state *rs                 = NULL;
+    tst_info_t *tst;
+    int option_index, opt;
+
+    optind = 0;
+    while ((opt = getopt_long(argc, argv, "", lgopts, &option_index)) != EOF)
+        ;
+
+    tst = tst_start("PCB SO_REUSEPORT");
+
+    TST_ASSERT_GOTO(this_cnet != NULL, "CNET is not initialized", err);
+    rs = rp_create();
+    TST_ASSERT_GOTO(rs != NULL, "Failed to create the PCB list", err);
+
+    if (test_reuseport_spread(rs) < 0 || test_reuseport_leave(rs) < 0 ||
+        test_reuseport_exclusive(rs) < 0)
+        goto err;
+
+    rp_destroy(rs);
+    tst_end(tst, TST_PASSED);
+    return 0;
+err:
+    rp_destroy(rs);
+    tst_end(tst, TST_FAILED);
+    return -1;
+}
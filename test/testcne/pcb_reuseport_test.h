@@ -0,0 +1,24 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright (c) 2023 Intel Corporation
+ */
+
+#ifndef _PCB_REUSEPORT_TEST_H_
+#define _PCB_REUSEPORT_TEST_H_
+
+/**
+ * @file
+ * CNET PCB SO_REUSEPORT Test
+ *
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+int pcb_reuseport_main(int argc, char **argv);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _PCB_REUSEPORT_TEST_H_ */
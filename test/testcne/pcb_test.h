@@ -0,0 +1,24 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright (c) 2023 Intel Corporation
+ */
+
+#ifndef _PCB_TEST_H_
+#define _PCB_TEST_H_
+
+/**
+ * @file
+ * CNE PCB lookup Test
+ *
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+int pcb_perf_main(int argc, char **argv);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _PCB_TEST_H_ */
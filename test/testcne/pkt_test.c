@@ -496,6 +496,132 @@ fail:
     return -1;
 }
 
+static int extbuf_freed;
+
+static void
+extbuf_free_cb(void *addr __cne_unused, void *opaque)
+{
+    *(int *)opaque = 1;
+}
+
+/*
+ * test chained (segmented) pktmbufs
+ */
+static int
+test_pktmbuf_chain(void)
+{
+    pktmbuf_t *m = NULL, *c = NULL, *seg, *x;
+    pktmbuf_ext_shinfo_t shinfo;
+    pktmbuf_cursor_t cur;
+    uint8_t ext[MBUF_TEST_DATA_LEN];
+    uint8_t buf[MBUF_TEST_DATA_LEN];
+    uint32_t len, i, off;
+    char *data;
+
+    tst_info("SUBTEST: pktmbuf_alloc_chain");
+    len = (3 * DEFAULT_MBUF_SIZE) + MBUF_TEST_DATA_LEN;
+    m   = pktmbuf_alloc_chain(pi, len);
+    TST_ASSERT_GOTO(m, "SUBTEST: pktmbuf_alloc_chain failed\n", fail);
+    TST_ASSERT_GOTO(pktmbuf_nb_segs(m) > 1 && pktmbuf_pkt_len(m) == len,
+                    "SUBTEST: pktmbuf_alloc_chain bad length\n", fail);
+
+    /* Fill the packet with a byte pattern of its offset */
+    for (off = 0, seg = m; seg; seg = seg->next) {
+        data = pktmbuf_mtod(seg, char *);
+        for (i = 0; i < pktmbuf_data_len(seg); i++)
+            data[i] = (char)(off++ & 0xff);
+    }
+    tst_ok("PASS --- SUBTEST: pktmbuf_alloc_chain");
+
+    tst_info("SUBTEST: pktmbuf_cursor across segments");
+    off = pktmbuf_data_len(m) - (MBUF_TEST_DATA_LEN / 2);
+    TST_ASSERT_GOTO(pktmbuf_cursor_init(&cur, m, off) == 0, "SUBTEST: cursor init failed\n", fail);
+    TST_ASSERT_GOTO(pktmbuf_cursor_read(&cur, buf, MBUF_TEST_DATA_LEN) == MBUF_TEST_DATA_LEN,
+                    "SUBTEST: cursor read failed\n", fail);
+    for (i = 0; i < MBUF_TEST_DATA_LEN; i++)
+        TST_ASSERT_GOTO(buf[i] == ((off + i) & 0xff), "SUBTEST: cursor data mismatch\n", fail);
+    TST_ASSERT_GOTO(pktmbuf_cursor_pos(&cur) == off + MBUF_TEST_DATA_LEN,
+                    "SUBTEST: cursor position mismatch\n", fail);
+    TST_ASSERT_GOTO(pktmbuf_cursor_skip(&cur, len) == len - off - MBUF_TEST_DATA_LEN,
+                    "SUBTEST: cursor skip failed\n", fail);
+    TST_ASSERT_GOTO(pktmbuf_cursor_init(&cur, m, len + 1) < 0,
+                    "SUBTEST: cursor init past the end\n", fail);
+    tst_ok("PASS --- SUBTEST: pktmbuf_cursor across segments");
+
+    tst_info("SUBTEST: pktmbuf_clone of a chain");
+    c = pktmbuf_clone(m, pi);
+    TST_ASSERT_GOTO(c, "SUBTEST: pktmbuf_clone failed\n", fail);
+    TST_ASSERT_GOTO(pktmbuf_nb_segs(c) == pktmbuf_nb_segs(m) && pktmbuf_pkt_len(c) == len,
+                    "SUBTEST: pktmbuf_clone bad length\n", fail);
+    for (seg = m, x = c; seg; seg = seg->next, x = x->next) {
+        TST_ASSERT_GOTO(!pktmbuf_is_direct(x) && pktmbuf_mtod(x, char *) == pktmbuf_mtod(seg, char *),
+                        "SUBTEST: clone does not share data\n", fail);
+        TST_ASSERT_GOTO(pktmbuf_refcnt_read(seg) == 2, "SUBTEST: clone refcnt\n", fail);
+    }
+    pktmbuf_free(c);
+    c = NULL;
+    for (seg = m; seg; seg = seg->next)
+        TST_ASSERT_GOTO(pktmbuf_refcnt_read(seg) == 1, "SUBTEST: clone free refcnt\n", fail);
+    tst_ok("PASS --- SUBTEST: pktmbuf_clone of a chain");
+
+    tst_info("SUBTEST: pktmbuf_append_chain and pktmbuf_prepend_chain");
+    i    = pktmbuf_nb_segs(m);
+    data = pktmbuf_append_chain(m, (uint16_t)(pktmbuf_tailroom(pktmbuf_lastseg(m)) + 1));
+    TST_ASSERT_GOTO(data && pktmbuf_nb_segs(m) == i + 1, "SUBTEST: append_chain failed\n", fail);
+
+    x    = m;
+    data = pktmbuf_prepend_chain(&m, (uint16_t)(pktmbuf_headroom(m) + 1));
+    TST_ASSERT_GOTO(data && m != x && m->next == x && pktmbuf_nb_segs(m) == i + 2,
+                    "SUBTEST: prepend_chain failed\n", fail);
+    pktmbuf_free(m);
+    m = NULL;
+    tst_ok("PASS --- SUBTEST: pktmbuf_append_chain and pktmbuf_prepend_chain");
+
+    tst_info("SUBTEST: pktmbuf_linearize");
+    m = pktmbuf_alloc(pi);
+    TST_ASSERT_GOTO(m, "SUBTEST: pktmbuf_alloc failed\n", fail);
+    x = pktmbuf_alloc(pi);
+    TST_ASSERT_GOTO(x, "SUBTEST: pktmbuf_alloc failed\n", fail);
+    memset(pktmbuf_append(m, MBUF_TEST_DATA_LEN), 0x11, MBUF_TEST_DATA_LEN);
+    memset(pktmbuf_append(x, MBUF_TEST_DATA_LEN2), 0x22, MBUF_TEST_DATA_LEN2);
+    TST_ASSERT_GOTO(pktmbuf_chain(m, x) == 0, "SUBTEST: pktmbuf_chain failed\n", fail);
+    TST_ASSERT_GOTO(!pktmbuf_is_contiguous(m), "SUBTEST: chain is contiguous\n", fail);
+    TST_ASSERT_GOTO(pktmbuf_linearize(m) == 0 && pktmbuf_is_contiguous(m) &&
+                        pktmbuf_data_len(m) == MBUF_TEST_DATA_LEN + MBUF_TEST_DATA_LEN2,
+                    "SUBTEST: pktmbuf_linearize failed\n", fail);
+    data = pktmbuf_mtod(m, char *);
+    TST_ASSERT_GOTO(data[MBUF_TEST_DATA_LEN - 1] == 0x11 && data[MBUF_TEST_DATA_LEN] == 0x22,
+                    "SUBTEST: pktmbuf_linearize data mismatch\n", fail);
+    pktmbuf_free(m);
+    m = NULL;
+    tst_ok("PASS --- SUBTEST: pktmbuf_linearize");
+
+    tst_info("SUBTEST: pktmbuf_attach_extbuf");
+    extbuf_freed = 0;
+    pktmbuf_ext_shinfo_init(&shinfo, extbuf_free_cb, &extbuf_freed);
+    m = pktmbuf_alloc(pi);
+    TST_ASSERT_GOTO(m, "SUBTEST: pktmbuf_alloc failed\n", fail);
+    TST_ASSERT_GOTO(pktmbuf_attach_extbuf(m, ext, sizeof(ext), &shinfo) == 0,
+                    "SUBTEST: pktmbuf_attach_extbuf failed\n", fail);
+    c = pktmbuf_clone(m, pi);
+    TST_ASSERT_GOTO(c && pktmbuf_mtod(c, uint8_t *) == ext, "SUBTEST: clone extbuf failed\n", fail);
+    pktmbuf_free(m);
+    m = NULL;
+    TST_ASSERT_GOTO(extbuf_freed == 0, "SUBTEST: extbuf freed too early\n", fail);
+    pktmbuf_free(c);
+    c = NULL;
+    TST_ASSERT_GOTO(extbuf_freed == 1, "SUBTEST: extbuf not freed\n", fail);
+    tst_ok("PASS --- SUBTEST: pktmbuf_attach_extbuf");
+
+    return 0;
+
+fail:
+    tst_error("FAILED --- SUBTEST: test_pktmbuf_chain");
+    pktmbuf_free(c);
+    pktmbuf_free(m);
+    return -1;
+}
+
 static int
 test_mbuf(void)
 {
@@ -526,6 +652,10 @@ test_mbuf(void)
                     "TEST: test_pktmbuf_with_non_ascii_data failed\n", leave);
     tst_ok("PASS --- TEST: test_pktmbuf_with_non_ascii_data");
 
+    tst_info("TEST: test_pktmbuf_chain");
+    TST_ASSERT_GOTO(!test_pktmbuf_chain(), "TEST: test_pktmbuf_chain failed\n", leave);
+    tst_ok("PASS --- TEST: test_pktmbuf_chain");
+
     tst_info("TEST: test_failing_pktmbuf_sanity_check");
     TST_ASSERT_GOTO(!test_failing_pktmbuf_sanity_check(),
                     "TEST: test_failing_pktmbuf_sanity_check failed\n", leave);
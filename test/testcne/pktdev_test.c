@@ -15,13 +15,25 @@
 #include <cne_log.h>             // for cne_panic
 #include <cne_lport.h>           // for lport_cfg, LPORT_DFLT_START_QUEUE_IDX
 #include <pmd_af_xdp.h>          // for PMD_NET_AF_XDP_NAME
+#include <pmd_af_packet.h>       // for PMD_NET_AF_PACKET_NAME
 #include <bsd/string.h>          // for strlcpy
 #include <inttypes.h>            // for PRIx8
 #include <net/ethernet.h>        // for ether_addr
 #include <string.h>              // for strcmp, memset
 #include <errno.h>               // for ENODEV, ENOTSUP
 #include <stdlib.h>              // for free, malloc
-#include <unistd.h>              // for sleep
+#include <unistd.h>              // for sleep, usleep
+#include <arpa/inet.h>           // for htons
+#include <sys/socket.h>          // for getsockopt, AF_PACKET, SO_DOMAIN
+#include <sys/ioctl.h>           // for ioctl
+#include <sys/uio.h>             // for writev, iovec
+#include <fcntl.h>               // for fcntl, F_SETFL, O_NONBLOCK
+#include <linux/if_packet.h>     // for sockaddr_ll, PACKET_VNET_HDR
+#include <linux/if_tun.h>        // for tun_pi, TUNGETIFF, IFF_MULTI_QUEUE, IFF_VNET_HDR
+#include <linux/virtio_net.h>    // for virtio_net_hdr, VIRTIO_NET_HDR_F_NEEDS_CSUM
+#include <net/cne_ip.h>          // for cne_ipv4_hdr, cne_ipv4_udptcp_cksum_verify
+#include <net/cne_tcp.h>         // for cne_tcp_hdr
+#include <pmd_tap.h>             // for PMD_NET_TAP_NAME
 
 #include "netdev_funcs.h"        // for netdev_promiscuous_enable
 #include "pktdev_test.h"
@@ -178,6 +190,13 @@ general_tests(const char *ifname, const char *pmd)
         tst_info("\n\nPort %u TX OFFLOAD %" PRIu32, lport, off.tx_checksum_offload);
         tst_info("Port %u RX OFFLOAD %" PRIu32, lport, off.rx_checksum_offload);
         tst_ok("PASS --- TEST:  Check lport enabled offloads");
+
+        /* The lport has no LPORT_XDP_METADATA, so the NIC checksum offload is not reachable */
+        tst_info("TEST: No TX checksum offload without TX metadata");
+        TST_ASSERT_EQUAL_AND_CLEANUP(off.tx_checksum_offload, 0,
+                                     "FAIL --- TEST: TX checksum offload without TX metadata\n",
+                                     clean_up, &clnup);
+        tst_ok("PASS --- TEST: No TX checksum offload without TX metadata");
     }
 
     tst_info("TEST: pktdev_promiscuous_enable");
@@ -224,6 +243,19 @@ general_tests(const char *ifname, const char *pmd)
     TST_ASSERT_GOTO(pktdev_info_get(CNE_MAX_ETHPORTS + 1, dev_info) == -ENODEV,
                     "ERROR - The error code isn't correct\n", leave);
     tst_ok("PASS --- TEST: Port number above max checking passed");
+
+    tst_info("TEST: API test for pktdev_queue_fd_get");
+    int rx_fd = -1, tx_fd = -1;
+    TST_ASSERT_GOTO(pktdev_queue_fd_get(lport, 0, &rx_fd, &tx_fd) == 0,
+                    "ERROR - Could not get the queue file descriptors\n", leave);
+    TST_ASSERT_GOTO(rx_fd == dev_info->rx_fd && tx_fd == dev_info->tx_fd,
+                    "ERROR - Queue fds %d/%d do not match the lport fds %d/%d\n", leave, rx_fd,
+                    tx_fd, dev_info->rx_fd, dev_info->tx_fd);
+    if (!strcmp(pmd, PMD_NET_AF_XDP_NAME))
+        TST_ASSERT_GOTO(rx_fd >= 0, "ERROR - No RX fd for the AF_XDP queue\n", leave);
+    TST_ASSERT_GOTO(pktdev_queue_fd_get(lport, dev_info->nb_rx_queues, &rx_fd, NULL) == -EINVAL,
+                    "ERROR - The error code isn't correct\n", leave);
+    tst_ok("PASS --- TEST: Get the queue file descriptors");
     free(dev_info);
 
     tst_info("TEST: API test for pktdev_socket_id");
@@ -323,6 +355,612 @@ leave:
     return -1;
 }
 
+#define MQ_TEST_QUEUES 4
+#define MQ_TEST_BURST  8
+
+static int
+multi_queue_tests(void)
+{
+    pktmbuf_t *pkts[MQ_TEST_BURST];
+    struct pktdev_info info;
+    lport_stats_t stats;
+    struct lport_cfg pc;
+    mmap_t *mmap;
+    int lport = -1;
+    uint16_t n;
+
+    if (pi) {
+        pktmbuf_destroy(pi);
+        pi = NULL;
+    }
+
+    mmap = mmap_alloc(DEFAULT_MBUF_COUNT, DEFAULT_MBUF_SIZE, MMAP_HUGEPAGE_4KB);
+    if (mmap == NULL)
+        CNE_ERR_RET("Failed to mmap memory\n");
+
+    tst_info("TEST: Multi-queue lport with %d queues", MQ_TEST_QUEUES);
+    if (reset_test_params(&pc, "null-mq0", mmap, PMD_NET_NULL_NAME) < 0)
+        return -1;
+
+    pc.nb_queues = LPORT_MAX_QUEUES + 1;
+    TST_ASSERT_GOTO(pktdev_port_setup(&pc) < 0, "Created lport with too many queues\n", leave);
+
+    pc.nb_queues = MQ_TEST_QUEUES;
+    lport        = pktdev_port_setup(&pc);
+    TST_ASSERT_GOTO(lport >= 0, "pktdev_port_setup() failed\n", leave);
+
+    TST_ASSERT_GOTO(pktdev_info_get(lport, &info) == 0, "pktdev_info_get() failed\n", leave);
+    TST_ASSERT_GOTO(info.nb_rx_queues == MQ_TEST_QUEUES && info.nb_tx_queues == MQ_TEST_QUEUES,
+                    "Wrong number of queues %u/%u\n", leave, info.nb_rx_queues,
+                    info.nb_tx_queues);
+
+    /* Receive and transmit (qid + 1) bursts on each queue */
+    for (uint16_t q = 0; q < MQ_TEST_QUEUES; q++) {
+        for (uint16_t b = 0; b <= q; b++) {
+            n = pktdev_rx_burst_q(lport, q, pkts, MQ_TEST_BURST);
+            TST_ASSERT_GOTO(n == MQ_TEST_BURST, "RX burst on queue %u returned %u\n", leave, q, n);
+            n = pktdev_tx_burst_q(lport, q, pkts, n);
+            TST_ASSERT_GOTO(n == MQ_TEST_BURST, "TX burst on queue %u returned %u\n", leave, q, n);
+        }
+    }
+    n = pktdev_rx_burst_q(lport, MQ_TEST_QUEUES, pkts, MQ_TEST_BURST);
+    TST_ASSERT_GOTO(n == 0, "RX burst on invalid queue returned %u\n", leave, n);
+    tst_ok("PASS --- TEST: Multi-queue RX/TX bursts");
+
+    for (uint16_t q = 0; q < MQ_TEST_QUEUES; q++) {
+        uint64_t expected = (uint64_t)(q + 1) * MQ_TEST_BURST;
+
+        TST_ASSERT_GOTO(pktdev_queue_stats_get(lport, q, &stats) == 0,
+                        "pktdev_queue_stats_get(%u) failed\n", leave, q);
+        TST_ASSERT_GOTO(stats.ipackets == expected && stats.opackets == expected,
+                        "Queue %u stats %lu/%lu are wrong\n", leave, q, stats.ipackets,
+                        stats.opackets);
+    }
+    TST_ASSERT_GOTO(pktdev_queue_stats_get(lport, MQ_TEST_QUEUES, &stats) == -EINVAL,
+                    "Stats returned for invalid queue\n", leave);
+
+    /* Port stats are the sum of 1 + 2 + ... + MQ_TEST_QUEUES bursts */
+    TST_ASSERT_GOTO(pktdev_stats_get(lport, &stats) == 0, "pktdev_stats_get() failed\n", leave);
+    n = (MQ_TEST_QUEUES * (MQ_TEST_QUEUES + 1) / 2) * MQ_TEST_BURST;
+    TST_ASSERT_GOTO(stats.ipackets == n && stats.opackets == n,
+                    "Port stats %lu/%lu, expected %u\n", leave, stats.ipackets, stats.opackets,
+                    n);
+    tst_ok("PASS --- TEST: Multi-queue per queue and aggregated stats");
+
+    pktdev_close(lport);
+    mmap_free(mmap);
+    return 0;
+leave:
+    if (lport >= 0)
+        pktdev_close(lport);
+    mmap_free(mmap);
+    return -1;
+}
+
+#define AFP_TEST_IFNAME  "lo"   /* Frames sent on loopback are received back on it */
+#define AFP_TEST_PKTS    32     /* Number of small frames sent */
+#define AFP_TEST_ETHTYPE 0x88B5 /* Local experimental ethertype to find the test frames */
+#define AFP_TEST_BUFSZ   1024   /* RX mbuf size, too small for AFP_TEST_LARGE */
+#define AFP_TEST_SMALL   64     /* Length of the frames fitting in an mbuf */
+#define AFP_TEST_LARGE   1500   /* Length of the frame too large for an mbuf */
+#define AFP_TEST_TRIES   1000   /* Max 1ms waits for the kernel to retire the RX block */
+#define AFP_TEST_DRAIN   20     /* 1ms waits for copies arriving after the last frame */
+
+/* Build a test frame of len bytes with a sequence number, chained when it does not fit an mbuf */
+static pktmbuf_t *
+afp_frame_create(pktmbuf_info_t *pinfo, uint32_t len, uint32_t seq)
+{
+    struct ether_header *eh;
+    pktmbuf_t *m;
+
+    m = pktmbuf_alloc_chain(pinfo, len);
+    if (!m)
+        return NULL;
+
+    eh = pktmbuf_mtod(m, struct ether_header *);
+    memset(eh->ether_dhost, 0xff, ETHER_ADDR_LEN);
+    memset(eh->ether_shost, 0x02, ETHER_ADDR_LEN);
+    eh->ether_type = htons(AFP_TEST_ETHTYPE);
+    *pktmbuf_mtod_offset(m, uint32_t *, sizeof(*eh)) = seq;
+
+    return m;
+}
+
+/*
+ * The af_packet PMD receives from TPACKET_V3 blocks, frames fitting in an mbuf are
+ * returned and a frame larger than the mbuf tailroom is dropped as an input error.
+ * Loopback hands each sent frame back once as an incoming frame, the outgoing copy of
+ * the frame must not be received, so every sequence number is seen exactly once.
+ */
+static int
+af_packet_rx_tests(void)
+{
+    pktmbuf_t *pkts[AFP_TEST_PKTS + 1];
+    char pmd_opts[]       = "blk_tmo=1";
+    pktmbuf_info_t *pinfo = NULL;
+    lport_stats_t stats   = {0};
+    uint16_t n = 0, nb_tx = 0, sent, rcvd = 0;
+    uint8_t seen[AFP_TEST_PKTS] = {0};
+    int drain                   = AFP_TEST_DRAIN;
+    socklen_t len               = sizeof(int);
+    int rx_fd = -1, domain = 0;
+    struct lport_cfg pc;
+    mmap_t *mmap;
+    int lport = -1;
+
+    mmap = mmap_alloc(DEFAULT_MBUF_COUNT, AFP_TEST_BUFSZ, MMAP_HUGEPAGE_4KB);
+    if (mmap == NULL)
+        CNE_ERR_RET("Failed to mmap memory\n");
+
+    tst_info("TEST: af_packet TPACKET_V3 RX on %s", AFP_TEST_IFNAME);
+    if (reset_test_params(&pc, AFP_TEST_IFNAME, NULL, PMD_NET_AF_PACKET_NAME) < 0)
+        goto leave;
+    pinfo = pktmbuf_pool_create(mmap_addr(mmap), DEFAULT_MBUF_COUNT, AFP_TEST_BUFSZ,
+                                MEMPOOL_CACHE_MAX_SIZE, NULL);
+    TST_ASSERT_GOTO(pinfo, "pktmbuf_pool_create() failed\n", leave);
+    pc.pi = pinfo;
+    pc.pmd_opts = pmd_opts;
+
+    lport = pktdev_port_setup(&pc);
+    TST_ASSERT_GOTO(lport >= 0, "pktdev_port_setup() failed\n", leave);
+
+    /* The RX fd is the TPACKET_V3 ring socket an idlemgr waits on */
+    TST_ASSERT_GOTO(pktdev_queue_fd_get(lport, 0, &rx_fd, NULL) == 0 && rx_fd >= 0,
+                    "pktdev_queue_fd_get() returned no RX fd\n", leave);
+    TST_ASSERT_GOTO(getsockopt(rx_fd, SOL_SOCKET, SO_DOMAIN, &domain, &len) == 0 &&
+                        domain == AF_PACKET,
+                    "RX fd %d is not an AF_PACKET socket\n", leave, rx_fd);
+    tst_ok("PASS --- TEST: af_packet queue file descriptor");
+
+    for (nb_tx = 0; nb_tx < AFP_TEST_PKTS; nb_tx++) {
+        pkts[nb_tx] = afp_frame_create(pinfo, AFP_TEST_SMALL, nb_tx);
+        TST_ASSERT_GOTO(pkts[nb_tx], "Failed to create frame %u\n", leave, nb_tx);
+    }
+    pkts[nb_tx] = afp_frame_create(pinfo, AFP_TEST_LARGE, nb_tx);
+    TST_ASSERT_GOTO(pkts[nb_tx], "Failed to create the large frame\n", leave);
+    nb_tx++;
+
+    sent = pktdev_tx_burst(lport, pkts, nb_tx);
+    if (sent < nb_tx)
+        pktmbuf_free_bulk(&pkts[sent], nb_tx - sent);
+    TST_ASSERT_GOTO(sent == nb_tx, "Sent %u of %u frames\n", leave, sent, nb_tx);
+    nb_tx = 0;
+
+    /* Loopback carries other traffic, only count our frames and keep polling for late copies */
+    for (int tries = 0; tries < AFP_TEST_TRIES && drain > 0; tries++) {
+        TST_ASSERT_GOTO(pktdev_stats_get(lport, &stats) == 0, "pktdev_stats_get() failed\n",
+                        leave);
+        if (rcvd >= AFP_TEST_PKTS && stats.ierrors > 0)
+            drain--;
+
+        n = pktdev_rx_burst(lport, pkts, CNE_DIM(pkts));
+        for (uint16_t i = 0; i < n; i++) {
+            struct ether_header *eh = pktmbuf_mtod(pkts[i], struct ether_header *);
+            uint32_t seq;
+
+            TST_ASSERT_GOTO(!(pkts[i]->ol_flags & CNE_MBUF_F_RX_RSS_HASH) || pkts[i]->hash,
+                            "RSS hash flag set without a hash\n", leave_rx);
+            if (eh->ether_type != htons(AFP_TEST_ETHTYPE))
+                continue;
+
+            TST_ASSERT_GOTO(pktmbuf_data_len(pkts[i]) == AFP_TEST_SMALL,
+                            "Received a %u byte test frame\n", leave_rx,
+                            pktmbuf_data_len(pkts[i]));
+            seq = *pktmbuf_mtod_offset(pkts[i], uint32_t *, sizeof(*eh));
+            TST_ASSERT_GOTO(seq < AFP_TEST_PKTS, "Received unknown frame %u\n", leave_rx, seq);
+            TST_ASSERT_GOTO(!seen[seq], "Received frame %u twice, outgoing copy not ignored\n",
+                            leave_rx, seq);
+            seen[seq] = 1;
+            rcvd++;
+        }
+        pktmbuf_free_bulk(pkts, n);
+        if (n == 0)
+            usleep(1000);
+    }
+    TST_ASSERT_GOTO(rcvd >= AFP_TEST_PKTS, "Received %u of %u frames\n", leave, rcvd,
+                    AFP_TEST_PKTS);
+    TST_ASSERT_GOTO(stats.ierrors > 0, "Large frame was not counted as an input error\n",
+                    leave);
+    tst_ok("PASS --- TEST: af_packet RX drops frames larger than an mbuf");
+    tst_ok("PASS --- TEST: af_packet RX ignores the frames sent by the lport");
+
+    pktdev_close(lport);
+    pktmbuf_destroy(pinfo);
+    mmap_free(mmap);
+    return 0;
+leave_rx:
+    pktmbuf_free_bulk(pkts, n);
+leave:
+    if (nb_tx)
+        pktmbuf_free_bulk(pkts, nb_tx);
+    if (lport >= 0)
+        pktdev_close(lport);
+    pktmbuf_destroy(pinfo);
+    mmap_free(mmap);
+    return -1;
+}
+
+#define TAP_TEST_IFNAME  "cnetap0" /* Created by the tap PMD for the test */
+#define TAP_TEST_QUEUES  4         /* Number of queues of the tap lport */
+#define TAP_TEST_PORT    5001      /* TCP source port of the test frames */
+#define TAP_TEST_MSS     1000      /* Segment size of the TSO frames */
+#define TAP_TEST_SEGS    3         /* Number of MSS sized segments of a TSO frame */
+#define TAP_TEST_SMALL   600       /* TCP payload length of the frames without TSO */
+#define TAP_TEST_SEGLEN  256       /* Data length of each segment of a chained TX frame */
+#define TAP_TEST_TRIES   1000      /* Max 1ms waits for a frame to go through the kernel */
+#define TAP_TEST_TSO_SEQ 0x10000   /* Sequence number of the TSO frame sent by the lport */
+#define TAP_TEST_HLEN \
+    (sizeof(struct ether_header) + sizeof(struct cne_ipv4_hdr) + sizeof(struct cne_tcp_hdr))
+#define TAP_TEST_MAXLEN (TAP_TEST_HLEN + TAP_TEST_SEGS * TAP_TEST_MSS)
+
+/*
+ * Build an Ethernet/IPv4/TCP frame with a payload of len bytes, returns the frame length.
+ * The TCP checksum holds the pseudo header checksum expected by a partial checksum request.
+ */
+static uint32_t
+tap_frame_build(uint8_t *buf, uint32_t len, uint32_t seq)
+{
+    struct ether_header *eh = (struct ether_header *)buf;
+    struct cne_ipv4_hdr *ip = (struct cne_ipv4_hdr *)(eh + 1);
+    struct cne_tcp_hdr *tcp = (struct cne_tcp_hdr *)(ip + 1);
+    uint8_t *payload        = (uint8_t *)(tcp + 1);
+
+    memset(eh->ether_dhost, 0xff, ETHER_ADDR_LEN);
+    memset(eh->ether_shost, 0x02, ETHER_ADDR_LEN);
+    eh->ether_type = htons(ETHERTYPE_IP);
+
+    memset(ip, 0, sizeof(*ip));
+    ip->version_ihl   = CNE_IPV4_VHL_DEF;
+    ip->total_length  = htons(sizeof(*ip) + sizeof(*tcp) + len);
+    ip->time_to_live  = 64;
+    ip->next_proto_id = IPPROTO_TCP;
+    ip->src_addr      = htonl(CNE_IPV4(198, 18, 0, 1));
+    ip->dst_addr      = htonl(CNE_IPV4(198, 18, 0, 2));
+    ip->hdr_checksum  = cne_ipv4_cksum(ip);
+
+    memset(tcp, 0, sizeof(*tcp));
+    tcp->src_port  = htons(TAP_TEST_PORT);
+    tcp->dst_port  = htons(TAP_TEST_PORT);
+    tcp->sent_seq  = htonl(seq);
+    tcp->data_off  = (sizeof(*tcp) / 4) << 4;
+    tcp->tcp_flags = TCP_ACK_FLAG;
+    tcp->rx_win    = htons(UINT16_MAX);
+
+    for (uint32_t i = 0; i < len; i++)
+        payload[i] = (uint8_t)(seq + i);
+
+    tcp->cksum = cne_ipv4_phdr_cksum(ip, 0);
+
+    return TAP_TEST_HLEN + len;
+}
+
+/* Return the TCP header of a test frame or NULL if the frame is not one of ours */
+static struct cne_tcp_hdr *
+tap_frame_tcp(const uint8_t *buf, uint32_t len)
+{
+    const struct ether_header *eh = (const struct ether_header *)buf;
+    const struct cne_ipv4_hdr *ip = (const struct cne_ipv4_hdr *)(eh + 1);
+    struct cne_tcp_hdr *tcp       = (struct cne_tcp_hdr *)(ip + 1);
+
+    if (len < TAP_TEST_HLEN || eh->ether_type != htons(ETHERTYPE_IP) ||
+        ip->next_proto_id != IPPROTO_TCP || tcp->src_port != htons(TAP_TEST_PORT))
+        return NULL;
+
+    return tcp;
+}
+
+/* Copy a frame into a chain of mbufs holding at most seg_len bytes each */
+static pktmbuf_t *
+tap_mbuf_create(pktmbuf_info_t *pinfo, const uint8_t *buf, uint32_t len, uint32_t seg_len)
+{
+    pktmbuf_t *m = NULL;
+
+    for (uint32_t off = 0, n; off < len; off += n) {
+        pktmbuf_t *seg = pktmbuf_alloc(pinfo);
+
+        n = CNE_MIN(seg_len, len - off);
+        if (!seg || !pktmbuf_append(seg, n)) {
+            pktmbuf_free(seg);
+            pktmbuf_free(m);
+            return NULL;
+        }
+        memcpy(pktmbuf_mtod(seg, void *), buf + off, n);
+
+        if (!m)
+            m = seg;
+        else if (pktmbuf_chain(m, seg) < 0) {
+            pktmbuf_free(seg);
+            pktmbuf_free(m);
+            return NULL;
+        }
+    }
+
+    return m;
+}
+
+/*
+ * Receive the test frame with the given sequence number seen by the packet socket on the
+ * tap interface, the socket also sees the frames the kernel sends to the lport.
+ */
+static ssize_t
+tap_capture(int sock, uint8_t *buf, size_t len, uint32_t seq)
+{
+    for (int tries = 0; tries < TAP_TEST_TRIES; tries++) {
+        ssize_t n = recv(sock, buf, len, MSG_DONTWAIT);
+        struct cne_tcp_hdr *tcp;
+
+        if (n < 0) {
+            usleep(1000);
+            continue;
+        }
+        if (n <= (ssize_t)sizeof(struct virtio_net_hdr))
+            continue;
+
+        tcp = tap_frame_tcp(buf + sizeof(struct virtio_net_hdr),
+                            n - sizeof(struct virtio_net_hdr));
+        if (tcp && ntohl(tcp->sent_seq) == seq)
+            return n;
+    }
+
+    return -1;
+}
+
+/*
+ * Open a multi-queue tap lport with virtio_net_hdr offloads and check the headers the PMD
+ * exchanges with the kernel. The tap has no receive offloads, so the kernel segments and
+ * checksums packets before they are received, and the checksum and TSO requests of sent
+ * packets are given to the kernel in the virtio_net_hdr of each chained packet.
+ */
+static int
+tap_tests(void)
+{
+    static uint8_t buf[sizeof(struct virtio_net_hdr) + TAP_TEST_MAXLEN];
+    struct virtio_net_hdr *vh = (struct virtio_net_hdr *)buf;
+    uint8_t *frame            = buf + sizeof(*vh);
+    pktmbuf_t *pkts[TAP_TEST_SEGS + 1];
+    int fds[TAP_TEST_QUEUES], sv[2] = {-1, -1};
+    pktmbuf_info_t *pinfo = NULL;
+    struct pktdev_info info;
+    struct sockaddr_ll sll;
+    struct lport_cfg pc;
+    struct ifreq ifr;
+    uint32_t len, seen = 0;
+    int one = 1, sock = -1;
+    int lport = -1;
+    mmap_t *mmap;
+    uint16_t n = 0;
+    ssize_t rlen;
+
+    mmap = mmap_alloc(DEFAULT_MBUF_COUNT, DEFAULT_MBUF_SIZE, MMAP_HUGEPAGE_4KB);
+    if (mmap == NULL)
+        CNE_ERR_RET("Failed to mmap memory\n");
+
+    tst_info("TEST: tap lport with %d queues on %s", TAP_TEST_QUEUES, TAP_TEST_IFNAME);
+    if (reset_test_params(&pc, TAP_TEST_IFNAME, NULL, PMD_NET_TAP_NAME) < 0)
+        goto leave;
+    pinfo = pktmbuf_pool_create(mmap_addr(mmap), DEFAULT_MBUF_COUNT, DEFAULT_MBUF_SIZE,
+                                MEMPOOL_CACHE_MAX_SIZE, NULL);
+    TST_ASSERT_GOTO(pinfo, "pktmbuf_pool_create() failed\n", leave);
+    pc.pi        = pinfo;
+    pc.nb_queues = TAP_TEST_QUEUES;
+
+    lport = pktdev_port_setup(&pc);
+    TST_ASSERT_GOTO(lport >= 0, "pktdev_port_setup() failed\n", leave);
+    TST_ASSERT_GOTO(pktdev_info_get(lport, &info) == 0, "pktdev_info_get() failed\n", leave);
+    TST_ASSERT_GOTO(info.nb_rx_queues == TAP_TEST_QUEUES && info.nb_tx_queues == TAP_TEST_QUEUES,
+                    "Wrong number of queues %u/%u\n", leave, info.nb_rx_queues,
+                    info.nb_tx_queues);
+
+    /* Each queue is its own fd attached to the same multi-queue interface */
+    for (uint16_t q = 0; q < TAP_TEST_QUEUES; q++) {
+        TST_ASSERT_GOTO(pktdev_queue_fd_get(lport, q, &fds[q], NULL) == 0 && fds[q] >= 0,
+                        "pktdev_queue_fd_get(%u) returned no fd\n", leave, q);
+        for (uint16_t i = 0; i < q; i++)
+            TST_ASSERT_GOTO(fds[i] != fds[q], "Queues %u and %u share fd %d\n", leave, i, q,
+                            fds[q]);
+
+        memset(&ifr, 0, sizeof(ifr));
+        TST_ASSERT_GOTO(ioctl(fds[q], TUNGETIFF, &ifr) == 0, "TUNGETIFF on queue %u failed\n",
+                        leave, q);
+        TST_ASSERT_GOTO(!strcmp(ifr.ifr_name, TAP_TEST_IFNAME),
+                        "Queue %u is attached to %s\n", leave, q, ifr.ifr_name);
+        TST_ASSERT_GOTO((ifr.ifr_flags & IFF_MULTI_QUEUE) && (ifr.ifr_flags & IFF_VNET_HDR),
+                        "Queue %u flags %04x, no IFF_MULTI_QUEUE or IFF_VNET_HDR\n", leave, q,
+                        ifr.ifr_flags);
+    }
+    tst_ok("PASS --- TEST: tap multi-queue open with IFF_MULTI_QUEUE and IFF_VNET_HDR");
+
+    /* A packet socket on the interface sends the frames received by the lport */
+    sock = socket(AF_PACKET, SOCK_RAW, htons(ETH_P_ALL));
+    TST_ASSERT_GOTO(sock >= 0, "Failed to open a packet socket\n", leave);
+    TST_ASSERT_GOTO(setsockopt(sock, SOL_PACKET, PACKET_VNET_HDR, &one, sizeof(one)) == 0,
+                    "Failed to set PACKET_VNET_HDR\n", leave);
+    memset(&sll, 0, sizeof(sll));
+    sll.sll_family   = AF_PACKET;
+    sll.sll_protocol = htons(ETH_P_ALL);
+    sll.sll_ifindex  = info.if_index;
+    TST_ASSERT_GOTO(bind(sock, (struct sockaddr *)&sll, sizeof(sll)) == 0,
+                    "Failed to bind the packet socket\n", leave);
+
+    /* A TSO frame with a partial checksum is segmented and checksummed by the kernel */
+    len = tap_frame_build(frame, TAP_TEST_SEGS * TAP_TEST_MSS, 0);
+    memset(vh, 0, sizeof(*vh));
+    vh->flags       = VIRTIO_NET_HDR_F_NEEDS_CSUM;
+    vh->gso_type    = VIRTIO_NET_HDR_GSO_TCPV4;
+    vh->gso_size    = TAP_TEST_MSS;
+    vh->hdr_len     = TAP_TEST_HLEN;
+    vh->csum_start  = TAP_TEST_HLEN - sizeof(struct cne_tcp_hdr);
+    vh->csum_offset = offsetof(struct cne_tcp_hdr, cksum);
+    TST_ASSERT_GOTO(send(sock, buf, sizeof(*vh) + len, 0) == (ssize_t)(sizeof(*vh) + len),
+                    "Failed to send the TSO frame to %s\n", leave, TAP_TEST_IFNAME);
+
+    /* The kernel spreads the flows over the queues, poll all of them */
+    for (int tries = 0; tries < TAP_TEST_TRIES && seen != (1 << TAP_TEST_SEGS) - 1; tries++) {
+        for (uint16_t q = 0; q < TAP_TEST_QUEUES; q++) {
+            n = pktdev_rx_burst_q(lport, q, pkts, CNE_DIM(pkts));
+            for (uint16_t i = 0; i < n; i++) {
+                pktmbuf_t *m            = pkts[i];
+                struct cne_ipv4_hdr *ip = pktmbuf_mtod_offset(m, struct cne_ipv4_hdr *,
+                                                              sizeof(struct ether_header));
+                struct cne_tcp_hdr *tcp = tap_frame_tcp(pktmbuf_mtod(m, uint8_t *),
+                                                        pktmbuf_data_len(m));
+                uint32_t seg;
+
+                if (!tcp)
+                    continue;
+
+                seg = ntohl(tcp->sent_seq) / TAP_TEST_MSS;
+                TST_ASSERT_GOTO(pktmbuf_data_len(m) == TAP_TEST_HLEN + TAP_TEST_MSS &&
+                                    seg < TAP_TEST_SEGS && !(seen & (1 << seg)),
+                                "Received a %u byte frame, seq %u\n", leave_rx,
+                                pktmbuf_data_len(m), ntohl(tcp->sent_seq));
+                TST_ASSERT_GOTO(cne_raw_cksum(ip, sizeof(*ip)) == 0xffff &&
+                                    cne_ipv4_udptcp_cksum_verify(ip, tcp) == 0,
+                                "Segment %u has a bad checksum\n", leave_rx, seg);
+                TST_ASSERT_GOTO(!(m->ol_flags & CNE_MBUF_F_RX_L4_CKSUM_MASK),
+                                "Segment %u RX flags %lx, expected no checksum status\n",
+                                leave_rx, seg, m->ol_flags);
+                seen |= 1 << seg;
+            }
+            pktmbuf_free_bulk(pkts, n);
+            n = 0;
+        }
+        if (seen != (1 << TAP_TEST_SEGS) - 1)
+            usleep(1000);
+    }
+    TST_ASSERT_GOTO(seen == (1 << TAP_TEST_SEGS) - 1, "Received segments %x of the TSO frame\n",
+                    leave, seen);
+    tst_ok("PASS --- TEST: tap RX of a TSO frame segmented and checksummed by the kernel");
+
+    /* A chained frame with a TCP checksum request is one partial checksum packet */
+    len     = tap_frame_build(frame, TAP_TEST_SMALL, TAP_TEST_SEGS * TAP_TEST_MSS);
+    pkts[0] = tap_mbuf_create(pinfo, frame, len, TAP_TEST_SEGLEN);
+    TST_ASSERT_GOTO(pkts[0] && pkts[0]->nb_segs > 1, "Failed to create a chained frame\n",
+                    leave);
+    pkts[0]->l2_len   = sizeof(struct ether_header);
+    pkts[0]->l3_len   = sizeof(struct cne_ipv4_hdr);
+    pkts[0]->l4_len   = sizeof(struct cne_tcp_hdr);
+    pkts[0]->ol_flags = CNE_MBUF_F_TX_IPV4 | CNE_MBUF_F_TX_TCP_CKSUM;
+    n                 = 1;
+    TST_ASSERT_GOTO(pktdev_tx_burst_q(lport, 1, pkts, n) == 1, "Failed to send the frame\n",
+                    leave);
+    n = 0;
+
+    rlen = tap_capture(sock, buf, sizeof(buf), TAP_TEST_SEGS * TAP_TEST_MSS);
+    TST_ASSERT_GOTO(rlen == (ssize_t)(sizeof(*vh) + len), "Captured %ld bytes, expected %lu\n",
+                    leave, rlen, sizeof(*vh) + len);
+    TST_ASSERT_GOTO((vh->flags & VIRTIO_NET_HDR_F_NEEDS_CSUM) &&
+                        vh->gso_type == VIRTIO_NET_HDR_GSO_NONE &&
+                        vh->csum_start == TAP_TEST_HLEN - sizeof(struct cne_tcp_hdr) &&
+                        vh->csum_offset == offsetof(struct cne_tcp_hdr, cksum),
+                    "Checksum request flags %x gso %u start %u offset %u\n", leave, vh->flags,
+                    vh->gso_type, vh->csum_start, vh->csum_offset);
+    tap_frame_build(buf + sizeof(buf) - len, TAP_TEST_SMALL, TAP_TEST_SEGS * TAP_TEST_MSS);
+    TST_ASSERT_GOTO(!memcmp(frame, buf + sizeof(buf) - len, len),
+                    "Chained frame was not sent as one packet\n", leave);
+    tst_ok("PASS --- TEST: tap TX of a chained frame with a TCP checksum request");
+
+    /* A chained TSO frame is given to the kernel as one GSO packet */
+    len     = tap_frame_build(frame, TAP_TEST_SEGS * TAP_TEST_MSS, TAP_TEST_TSO_SEQ);
+    pkts[0] = tap_mbuf_create(pinfo, frame, len, DEFAULT_MBUF_SIZE / 2);
+    TST_ASSERT_GOTO(pkts[0] && pkts[0]->nb_segs > 1, "Failed to create a chained TSO frame\n",
+                    leave);
+    pkts[0]->l2_len    = sizeof(struct ether_header);
+    pkts[0]->l3_len    = sizeof(struct cne_ipv4_hdr);
+    pkts[0]->l4_len    = sizeof(struct cne_tcp_hdr);
+    pkts[0]->tso_segsz = TAP_TEST_MSS;
+    pkts[0]->ol_flags  = CNE_MBUF_F_TX_IPV4 | CNE_MBUF_F_TX_TCP_CKSUM | CNE_MBUF_F_TX_TCP_SEG;
+    n                  = 1;
+    TST_ASSERT_GOTO(pktdev_tx_burst_q(lport, 2, pkts, n) == 1, "Failed to send the TSO frame\n",
+                    leave);
+    n = 0;
+
+    rlen = tap_capture(sock, buf, sizeof(buf), TAP_TEST_TSO_SEQ);
+    TST_ASSERT_GOTO(rlen == (ssize_t)(sizeof(*vh) + len), "Captured %ld bytes, expected %lu\n",
+                    leave, rlen, sizeof(*vh) + len);
+    TST_ASSERT_GOTO((vh->flags & VIRTIO_NET_HDR_F_NEEDS_CSUM) &&
+                        vh->gso_type == VIRTIO_NET_HDR_GSO_TCPV4 && vh->gso_size == TAP_TEST_MSS,
+                    "TSO request flags %x gso %u size %u\n", leave, vh->flags, vh->gso_type,
+                    vh->gso_size);
+    tst_ok("PASS --- TEST: tap TX of a chained TSO frame");
+
+    /*
+     * The kernel never hands over a partial or validated checksum without receive offloads,
+     * so the last queue is replaced with a socket to feed the PMD virtio_net_hdr flags.
+     */
+    TST_ASSERT_GOTO(socketpair(AF_UNIX, SOCK_SEQPACKET, 0, sv) == 0 &&
+                        fcntl(sv[0], F_SETFL, O_NONBLOCK) == 0 &&
+                        dup2(sv[0], fds[TAP_TEST_QUEUES - 1]) >= 0,
+                    "Failed to replace the queue fd\n", leave);
+    close(sv[0]);
+    sv[0] = -1;
+
+    static const uint16_t vflags[] = {0, VIRTIO_NET_HDR_F_NEEDS_CSUM,
+                                      VIRTIO_NET_HDR_F_DATA_VALID};
+    static const uint64_t rx_flags[] = {CNE_MBUF_F_RX_L4_CKSUM_UNKNOWN,
+                                        CNE_MBUF_F_RX_L4_CKSUM_NONE,
+                                        CNE_MBUF_F_RX_L4_CKSUM_GOOD};
+    struct tun_pi tpi = {.flags = 0, .proto = htons(ETHERTYPE_IP)};
+    struct iovec iov[3];
+
+    len = tap_frame_build(frame, TAP_TEST_SMALL, 0);
+    for (uint16_t i = 0; i < cne_countof(vflags); i++) {
+        memset(vh, 0, sizeof(*vh));
+        vh->flags = vflags[i];
+        if (vflags[i] & VIRTIO_NET_HDR_F_NEEDS_CSUM) {
+            vh->csum_start  = TAP_TEST_HLEN - sizeof(struct cne_tcp_hdr);
+            vh->csum_offset = offsetof(struct cne_tcp_hdr, cksum);
+        }
+        iov[0].iov_base = &tpi;
+        iov[0].iov_len  = sizeof(tpi);
+        iov[1].iov_base = vh;
+        iov[1].iov_len  = sizeof(*vh);
+        iov[2].iov_base = frame;
+        iov[2].iov_len  = len;
+        TST_ASSERT_GOTO(writev(sv[1], iov, 3) == (ssize_t)(sizeof(tpi) + sizeof(*vh) + len),
+                        "Failed to write frame %u\n", leave, i);
+    }
+
+    n = pktdev_rx_burst_q(lport, TAP_TEST_QUEUES - 1, pkts, CNE_DIM(pkts));
+    TST_ASSERT_GOTO(n == cne_countof(vflags), "Received %u of %u frames\n", leave_rx, n,
+                    (uint16_t)cne_countof(vflags));
+    for (uint16_t i = 0; i < n; i++) {
+        TST_ASSERT_GOTO(pktmbuf_data_len(pkts[i]) == len &&
+                            !memcmp(pktmbuf_mtod(pkts[i], void *), frame, len),
+                        "Frame %u data is wrong\n", leave_rx, i);
+        TST_ASSERT_GOTO((pkts[i]->ol_flags & CNE_MBUF_F_RX_L4_CKSUM_MASK) == rx_flags[i],
+                        "virtio_net_hdr flags %x gave RX flags %lx\n", leave_rx, vflags[i],
+                        pkts[i]->ol_flags);
+    }
+    pktmbuf_free_bulk(pkts, n);
+    n = 0;
+    tst_ok("PASS --- TEST: tap RX virtio_net_hdr checksum flags");
+
+    close(sv[1]);
+    close(sock);
+    pktdev_close(lport);
+    pktmbuf_destroy(pinfo);
+    mmap_free(mmap);
+    return 0;
+leave_rx:
+    pktmbuf_free_bulk(pkts, n);
+    n = 0;
+leave:
+    if (n)
+        pktmbuf_free_bulk(pkts, n);
+    if (sv[0] >= 0)
+        close(sv[0]);
+    if (sv[1] >= 0)
+        close(sv[1]);
+    if (sock >= 0)
+        close(sock);
+    if (lport >= 0)
+        pktdev_close(lport);
+    pktmbuf_destroy(pinfo);
+    mmap_free(mmap);
+    return -1;
+}
+
 int
 pktdev_main(int argc, char **argv)
 {
@@ -379,6 +1017,15 @@ pktdev_main(int argc, char **argv)
         if (general_tests(ifname, tests[i]) < 0)
             goto leave;
     }
+
+    if (multi_queue_tests() < 0)
+        goto leave;
+
+    if (af_packet_rx_tests() < 0)
+        goto leave;
+
+    if (tap_tests() < 0)
+        goto leave;
     tst_end(tst, TST_PASSED);
 
     return 0;
@@ -0,0 +1,265 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright (c) 2023 Intel Corporation
+ */
+
+// IWYU pragma: no_include <bits/getopt_core.h>
+
+#include <stdio.h>               // for NULL, EOF, snprintf
+#include <stdint.h>              // for uint32_t, uint64_t
+#include <getopt.h>              // for getopt_long, option
+#include <errno.h>               // for ENOSPC
+#include <cne_common.h>          // for cne_countof, CNE_SET_USED
+#include <cne_rcu_qsbr.h>        // for cne_rcu_qsbr_create, cne_rcu_qsbr_quiescent
+#include <cne_hash.h>            // for cne_hash_create, cne_hash_rcu_qsbr_add
+#include <cne_fib.h>             // for cne_fib_create, cne_fib_rcu_qsbr_add
+#include <net/cne_ip.h>          // for CNE_IPV4
+#include <tst_info.h>            // for tst_end, tst_start, TST_ASSERT_GOTO
+
+#include "rcu_test.h"
+
+#define RCU_TEST_READERS 2 /* Number of simulated reader threads */
+#define RCU_HASH_ENTRIES 64
+#define RCU_FIB_TBL8S    64
+
+static uint32_t freed_cnt;
+
+static void
+test_free_fn(void *p, void *e, unsigned int n)
+{
+    CNE_SET_USED(p);
+    CNE_SET_USED(e);
+
+    freed_cnt += n;
+}
+
+static void
+readers_quiescent(struct cne_rcu_qsbr *v)
+{
+    for (unsigned int i = 0; i < RCU_TEST_READERS; i++)
+        cne_rcu_qsbr_quiescent(v, i);
+}
+
+static int
+test_qsbr_check(struct cne_rcu_qsbr *v)
+{
+    uint64_t token;
+
+    token = cne_rcu_qsbr_start(v);
+    TST_ASSERT(cne_rcu_qsbr_check(v, token, false) == 0, "Check passed with no quiescent state");
+
+    cne_rcu_qsbr_quiescent(v, 0);
+    TST_ASSERT(cne_rcu_qsbr_check(v, token, false) == 0, "Check passed with one reader active");
+
+    cne_rcu_qsbr_quiescent(v, 1);
+    TST_ASSERT(cne_rcu_qsbr_check(v, token, false) == 1, "Check failed after all readers");
+
+    /* An offline reader does not hold back the grace period */
+    cne_rcu_qsbr_thread_offline(v, 1);
+    token = cne_rcu_qsbr_start(v);
+    cne_rcu_qsbr_quiescent(v, 0);
+    TST_ASSERT(cne_rcu_qsbr_check(v, token, false) == 1, "Check failed with reader offline");
+    cne_rcu_qsbr_thread_online(v, 1);
+
+    return 0;
+}
+
+static int
+test_qsbr_dq(struct cne_rcu_qsbr *v)
+{
+    struct cne_rcu_qsbr_dq_parameters params = {0};
+    struct cne_rcu_qsbr_dq *dq;
+    unsigned int freed, pending;
+    uint32_t e;
+
+    params.name                  = "rcu_test_dq";
+    params.size                  = 16;
+    params.esize                 = sizeof(uint32_t);
+    params.trigger_reclaim_limit = params.size;
+    params.max_reclaim_size      = params.size;
+    params.free_fn               = test_free_fn;
+    params.v                     = v;
+
+    dq = cne_rcu_qsbr_dq_create(&params);
+    TST_ASSERT(dq != NULL, "Failed to create defer queue");
+
+    freed_cnt = 0;
+    for (e = 0; e < params.size; e++)
+        TST_ASSERT_GOTO(cne_rcu_qsbr_dq_enqueue(dq, &e) == 0, "Enqueue %u failed", err, e);
+
+    /* Queue is full and the readers have not gone quiescent */
+    TST_ASSERT_GOTO(cne_rcu_qsbr_dq_enqueue(dq, &e) != 0, "Enqueue on full queue passed", err);
+
+    cne_rcu_qsbr_dq_reclaim(dq, ~0, &freed, &pending, NULL);
+    TST_ASSERT_GOTO(freed == 0 && pending == params.size, "Reclaimed %u before grace period",
+                    err, freed);
+
+    readers_quiescent(v);
+
+    cne_rcu_qsbr_dq_reclaim(dq, ~0, &freed, &pending, NULL);
+    TST_ASSERT_GOTO(freed == params.size && pending == 0 && freed_cnt == params.size,
+                    "Reclaimed %u of %u after grace period", err, freed, params.size);
+
+    TST_ASSERT(cne_rcu_qsbr_dq_delete(dq) == 0, "Failed to delete defer queue");
+
+    return 0;
+err:
+    readers_quiescent(v);
+    cne_rcu_qsbr_dq_delete(dq);
+    return -1;
+}
+
+static int
+test_hash_rcu(struct cne_rcu_qsbr *v)
+{
+    struct cne_hash_parameters params = {0};
+    struct cne_hash_rcu_config cfg    = {0};
+    struct cne_hash *h;
+    uint32_t key;
+    int ret;
+
+    params.name      = "rcu_test_hash";
+    params.entries   = RCU_HASH_ENTRIES;
+    params.key_len   = sizeof(uint32_t);
+    params.socket_id = -1;
+
+    h = cne_hash_create(&params);
+    TST_ASSERT(h != NULL, "Failed to create hash");
+
+    cfg.v                     = v;
+    cfg.mode                  = CNE_HASH_QSBR_MODE_DQ;
+    cfg.trigger_reclaim_limit = RCU_HASH_ENTRIES;
+    TST_ASSERT_GOTO(cne_hash_rcu_qsbr_add(h, &cfg) == 0, "Failed to add RCU to hash", err);
+    TST_ASSERT_GOTO(cne_hash_rcu_qsbr_add(h, &cfg) != 0, "Added RCU to hash twice", err);
+
+    for (key = 0; key < RCU_HASH_ENTRIES; key++) {
+        ret = cne_hash_add_key(h, &key);
+        if (ret == -ENOSPC)
+            break;
+        TST_ASSERT_GOTO(ret >= 0, "Failed to add key %u", err, key);
+    }
+    TST_ASSERT_GOTO(key > 0, "No keys added", err);
+
+    for (uint32_t k = 0; k < key; k++)
+        TST_ASSERT_GOTO(cne_hash_del_key(h, &k) >= 0, "Failed to delete key %u", err, k);
+
+    /* Key slots are still referenced by the readers, so the table stays full */
+    TST_ASSERT_GOTO(cne_hash_add_key(h, &key) == -ENOSPC, "Key slot reused before grace period",
+                    err);
+
+    readers_quiescent(v);
+
+    /* The add reclaims the deleted slots from the defer queue */
+    TST_ASSERT_GOTO(cne_hash_add_key(h, &key) >= 0, "Key slot not reclaimed", err);
+    TST_ASSERT_GOTO(cne_hash_lookup(h, &key) >= 0, "Failed to lookup key %u", err, key);
+
+    cne_hash_free(h);
+    return 0;
+err:
+    readers_quiescent(v);
+    cne_hash_free(h);
+    return -1;
+}
+
+static int
+test_fib_rcu(struct cne_rcu_qsbr *v)
+{
+    struct cne_fib_conf conf      = {0};
+    struct cne_fib_rcu_config cfg = {0};
+    struct cne_fib *fib;
+    uint32_t ip, i;
+
+    conf.type             = CNE_FIB_DIR24_8;
+    conf.default_nh       = 0;
+    conf.max_routes       = RCU_FIB_TBL8S * 2;
+    conf.dir24_8.nh_sz    = CNE_FIB_DIR24_8_4B;
+    conf.dir24_8.num_tbl8 = RCU_FIB_TBL8S;
+
+    fib = cne_fib_create("rcu_test_fib", &conf);
+    TST_ASSERT(fib != NULL, "Failed to create FIB");
+
+    cfg.v           = v;
+    cfg.mode        = CNE_FIB_QSBR_MODE_DQ;
+    cfg.reclaim_thd = RCU_FIB_TBL8S;
+    TST_ASSERT_GOTO(cne_fib_rcu_qsbr_add(fib, &cfg) == 0, "Failed to add RCU to FIB", err);
+
+    /* Each /32 in its own /24 uses a tbl8 group */
+    for (i = 0; i < RCU_FIB_TBL8S; i++) {
+        ip = CNE_IPV4(10, 0, i, 1);
+        TST_ASSERT_GOTO(cne_fib_add(fib, ip, 32, i + 1) == 0, "Failed to add route %u", err, i);
+    }
+    for (i = 0; i < RCU_FIB_TBL8S; i++) {
+        ip = CNE_IPV4(10, 0, i, 1);
+        TST_ASSERT_GOTO(cne_fib_delete(fib, ip, 32) == 0, "Failed to delete route %u", err, i);
+    }
+
+    /* All tbl8 groups are waiting on the readers */
+    ip = CNE_IPV4(10, 1, 0, 1);
+    TST_ASSERT_GOTO(cne_fib_add(fib, ip, 32, 1) != 0, "tbl8 reused before grace period", err);
+
+    readers_quiescent(v);
+
+    TST_ASSERT_GOTO(cne_fib_add(fib, ip, 32, 1) == 0, "tbl8 group not reclaimed", err);
+
+    cne_fib_free(fib);
+    return 0;
+err:
+    readers_quiescent(v);
+    cne_fib_free(fib);
+    return -1;
+}
+
+int
+rcu_main(int argc, char **argv)
+{
+    struct cne_rcu_qsbr *v = NULL;
+    tst_info_t *tst;
+    int verbose = 0, opt;
+    char **argvopt;
+    int option_index;
+    static const struct option lgopts[] = {{NULL, 0, 0, 0}};
+
+    argvopt = argv;
+
+    optind = 0;
+    while ((opt = getopt_long(argc, argvopt, "V", lgopts, &option_index)) != EOF) {
+        switch (opt) {
+        case 'V':
+            verbose = 1;
+            break;
+        default:
+            break;
+        }
+    }
+
+    tst = tst_start("RCU QSBR");
+
+    v = cne_rcu_qsbr_create();
+    TST_ASSERT_GOTO(v != NULL, "Failed to create QSBR variable", leave);
+
+    for (unsigned int i = 0; i < RCU_TEST_READERS; i++) {
+        TST_ASSERT_GOTO(cne_rcu_qsbr_thread_register(v, i) == 0, "Failed to register %u", leave,
+                        i);
+        cne_rcu_qsbr_thread_online(v, i);
+    }
+
+    if (test_qsbr_check(v) < 0)
+        goto leave;
+    if (test_qsbr_dq(v) < 0)
+        goto leave;
+    if (test_hash_rcu(v) < 0)
+        goto leave;
+    if (test_fib_rcu(v) < 0)
+        goto leave;
+
+    if (verbose)
+        cne_rcu_qsbr_dump(stdout, v);
+
+    cne_rcu_qsbr_free(v);
+    tst_end(tst, TST_PASSED);
+
+    return 0;
+leave:
+    cne_rcu_qsbr_free(v);
+    tst_end(tst, TST_FAILED);
+    return -1;
+}
@@ -0,0 +1,469 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright (c) 2023 Intel Corporation
+ */
+
+#include <stdio.h>              // for NULL, EOF
+#include <stdint.h>             // for uint32_t, uint64_t
+#include <stdlib.h>             // for calloc, free
+#include <string.h>             // for strcmp
+#include <getopt.h>             // for getopt_long, option
+#include <tst_info.h>           // for tst_end, tst_ok, TST_ASSERT_GOTO, tst_start
+#include <cne_cycles.h>         // for cne_get_timer_hz
+#include <cnet_tcp.h>           // for tcb_entry, TCBF_IN_RECOVERY
+#include <cnet_tcp_cc.h>        // for cnet_tcp_cc_find, cnet_tcp_cc_set, cnet_tcp_cc_ack
+
+#include "tcp_cc_test.h"
+
+#define CC_MSS     1000   /**< max_mss of the test connection */
+#define CC_WSCALE  7      /**< Send window scale, allows a large cwnd */
+#define CC_SND_WND 200000 /**< Send window of the test connection */
+
+/* Gains of bbr in 1/256 units, see cnet_tcp_bbr.c */
+#define BBR_GAIN_UNIT    256
+#define BBR_GAIN_STARTUP ((BBR_GAIN_UNIT * 2885) / 1000 + 1)
+#define BBR_GAIN_DRAIN   ((BBR_GAIN_UNIT * 1000) / 2885)
+#define BBR_GAIN_PROBE   (BBR_GAIN_UNIT * 5 / 4)
+#define BBR_GAIN_DOWN    (BBR_GAIN_UNIT * 3 / 4)
+
+static int cc_test_inits, cc_test_releases;
+
+static void
+cc_test_init(struct tcb_entry *tcb __cne_unused)
+{
+    cc_test_inits++;
+}
+
+static void
+cc_test_release(struct tcb_entry *tcb __cne_unused)
+{
+    cc_test_releases++;
+}
+
+static void
+cc_test_ack(struct tcb_entry *tcb __cne_unused, const struct tcp_cc_sample *rs __cne_unused)
+{
+}
+
+static uint32_t
+cc_test_loss(struct tcb_entry *tcb)
+{
+    return tcb->snd_cwnd;
+}
+
+static void
+cc_test_rto(struct tcb_entry *tcb __cne_unused)
+{
+}
+
+static const struct tcp_cc_ops cc_test_ops = {
+    .name    = "cc_test",
+    .init    = cc_test_init,
+    .release = cc_test_release,
+    .ack     = cc_test_ack,
+    .loss    = cc_test_loss,
+    .rto     = cc_test_rto,
+};
+
+static struct tcb_entry *
+cc_tcb_create(const char *name, uint32_t cwnd, uint32_t ssthresh)
+{
+    struct tcb_entry *tcb = calloc(1, sizeof(struct tcb_entry));
+
+    if (!tcb)
+        return NULL;
+
+    tcb->max_mss      = CC_MSS;
+    tcb->snd_scale    = CC_WSCALE;
+    tcb->snd_wnd      = CC_SND_WND;
+    tcb->snd_cwnd     = cwnd;
+    tcb->snd_ssthresh = ssthresh;
+    cnet_tcp_cc_set(tcb, cnet_tcp_cc_find(name));
+    if (!tcb->cc) {
+        free(tcb);
+        return NULL;
+    }
+    return tcb;
+}
+
+static void
+cc_tcb_destroy(struct tcb_entry *tcb)
+{
+    if (tcb) {
+        cnet_tcp_cc_release(tcb);
+        free(tcb);
+    }
+}
+
+/* Send len bytes and acknowledge them, inflight bytes stay outstanding after the ACK */
+static void
+cc_send_ack(struct tcb_entry *tcb, uint32_t len, uint32_t inflight, uint64_t now)
+{
+    tcb->snd_max += len;
+    tcb->snd_una = tcb->snd_max - inflight;
+    cnet_tcp_cc_ack(tcb, len, now);
+}
+
+static int
+test_cc_select(void)
+{
+    const char *names[] = {"reno", "cubic", "bbr"};
+    struct tcp_cc_ops bad = cc_test_ops;
+    struct tcb_entry *tcb = NULL;
+    int inits, releases;
+
+    for (int i = 0; i < (int)cne_countof(names); i++) {
+        const struct tcp_cc_ops *ops = cnet_tcp_cc_find(names[i]);
+
+        TST_ASSERT_GOTO(ops && !strcmp(ops->name, names[i]), "Module %s not found", err,
+                        names[i]);
+    }
+    TST_ASSERT_GOTO(!cnet_tcp_cc_find("vegas") && !cnet_tcp_cc_find(NULL),
+                    "Unknown module found", err);
+    TST_ASSERT_GOTO(cnet_tcp_cc_default_set("vegas") < 0, "Unknown default module accepted", err);
+
+    /* Register once, the module table lives for the whole process */
+    if (!cnet_tcp_cc_find(cc_test_ops.name))
+        TST_ASSERT_GOTO(cnet_tcp_cc_register(&cc_test_ops) == 0, "Register failed", err);
+    TST_ASSERT_GOTO(cnet_tcp_cc_find(cc_test_ops.name) == &cc_test_ops, "Module not registered",
+                    err);
+    TST_ASSERT_GOTO(cnet_tcp_cc_register(&cc_test_ops) < 0, "Duplicate name registered", err);
+    bad.ack = NULL;
+    TST_ASSERT_GOTO(cnet_tcp_cc_register(&bad) < 0, "Module without an ack hook registered",
+                    err);
+    tst_ok("Modules found by name and invalid registrations rejected");
+
+    inits    = cc_test_inits;
+    releases = cc_test_releases;
+    tcb      = cc_tcb_create("cc_test", 10 * CC_MSS, 20 * CC_MSS);
+    TST_ASSERT_GOTO(tcb && cc_test_inits == inits + 1, "Init hook not called", err);
+
+    /* Switching module releases the old state and starts the new one from scratch */
+    tcb->pacing_rate    = 1;
+    tcb->cc_priv[0]     = 1;
+    tcb->cc_rs.round_ts = 1;
+    cnet_tcp_cc_set(tcb, cnet_tcp_cc_find("bbr"));
+    TST_ASSERT_GOTO(cc_test_releases == releases + 1, "Release hook not called on a switch", err);
+    TST_ASSERT_GOTO(tcb->cc == cnet_tcp_cc_find("bbr"), "Module not switched", err);
+    TST_ASSERT_GOTO(tcb->pacing_rate == 0 && tcb->cc_rs.round_ts == 0,
+                    "Pacing or sampler state kept across a switch", err);
+    TST_ASSERT_GOTO(tcb->snd_cwnd == 10 * CC_MSS, "cwnd changed by a switch", err);
+
+    cnet_tcp_cc_set(tcb, NULL);
+    TST_ASSERT_GOTO(tcb->cc != NULL, "No default module selected", err);
+
+    cnet_tcp_cc_release(tcb);
+    TST_ASSERT_GOTO(tcb->cc == NULL, "Module still attached after release", err);
+    cnet_tcp_cc_ack(tcb, CC_MSS, 1);
+    cnet_tcp_cc_loss(tcb);
+    TST_ASSERT_GOTO(tcb->snd_cwnd == 10 * CC_MSS && tcb->snd_ssthresh == 20 * CC_MSS,
+                    "Hooks called without a module", err);
+    tst_ok("Switching modules releases and resets the connection state");
+
+    cc_tcb_destroy(tcb);
+    return 0;
+err:
+    cc_tcb_destroy(tcb);
+    return -1;
+}
+
+/* RFC 5681 slow start, congestion avoidance, fast recovery and timeout */
+static int
+test_cc_reno(void)
+{
+    struct tcb_entry *tcb;
+    uint32_t cwnd;
+
+    tcb = cc_tcb_create("reno", 4 * CC_MSS, 8 * CC_MSS);
+    TST_ASSERT_GOTO(tcb, "Failed to create the reno connection", err);
+
+    /* One MSS per ACK up to and including ssthresh */
+    for (int i = 0; i < 5; i++) {
+        cc_send_ack(tcb, CC_MSS, 0, 1);
+        TST_ASSERT_GOTO(tcb->snd_cwnd == (uint32_t)(5 + i) * CC_MSS, "Slow start cwnd %u", err,
+                        tcb->snd_cwnd);
+    }
+
+    /* Then MSS * MSS / cwnd per ACK */
+    cwnd = tcb->snd_cwnd;
+    cc_send_ack(tcb, CC_MSS, 0, 1);
+    TST_ASSERT_GOTO(tcb->snd_cwnd == cwnd + CC_MSS * CC_MSS / cwnd,
+                    "Congestion avoidance cwnd %u", err, tcb->snd_cwnd);
+    tst_ok("Reno slow start and congestion avoidance");
+
+    /* A loss with 9 segments in flight halves the flight, the window holds in recovery */
+    tcb->snd_max = tcb->snd_una + 9 * CC_MSS;
+    cnet_tcp_cc_loss(tcb);
+    TST_ASSERT_GOTO(tcb->snd_ssthresh == 9 * CC_MSS / 2, "ssthresh %u after a loss", err,
+                    tcb->snd_ssthresh);
+    tcb->snd_cwnd = tcb->snd_ssthresh;
+    tcb->tflags |= TCBF_IN_RECOVERY;
+    cc_send_ack(tcb, CC_MSS, 8 * CC_MSS, 1);
+    TST_ASSERT_GOTO(tcb->snd_cwnd == 9 * CC_MSS / 2, "cwnd %u grew during recovery", err,
+                    tcb->snd_cwnd);
+    tcb->tflags &= ~TCBF_IN_RECOVERY;
+
+    /* A single segment in flight still keeps two segments */
+    tcb->snd_max = tcb->snd_una + CC_MSS;
+    cnet_tcp_cc_loss(tcb);
+    TST_ASSERT_GOTO(tcb->snd_ssthresh == 2 * CC_MSS, "ssthresh %u below 2 * MSS", err,
+                    tcb->snd_ssthresh);
+    tst_ok("Reno loss halves the flight and holds cwnd during recovery");
+
+    tcb->snd_cwnd = 9 * CC_MSS;
+    cnet_tcp_cc_rto(tcb);
+    TST_ASSERT_GOTO(tcb->snd_cwnd == CC_MSS && tcb->snd_ssthresh == 4 * CC_MSS,
+                    "cwnd %u ssthresh %u after a timeout", err, tcb->snd_cwnd,
+                    tcb->snd_ssthresh);
+
+    tcb->snd_cwnd = 9 * CC_MSS;
+    cnet_tcp_cc_restart(tcb);
+    TST_ASSERT_GOTO(tcb->snd_cwnd == 4 * CC_MSS, "Restart window %u", err, tcb->snd_cwnd);
+    tst_ok("Reno timeout and restart windows");
+
+    cc_tcb_destroy(tcb);
+    return 0;
+err:
+    cc_tcb_destroy(tcb);
+    return -1;
+}
+
+/* Acknowledge one MSS at a time nb times, all at the same time now */
+static void
+cc_ack_many(struct tcb_entry *tcb, int nb, uint64_t now)
+{
+    for (int i = 0; i < nb; i++)
+        cc_send_ack(tcb, CC_MSS, 0, now);
+}
+
+/* RFC 8312 slow start, multiplicative decrease, concave and convex growth */
+static int
+test_cc_cubic(void)
+{
+    uint64_t hz    = cne_get_timer_hz();
+    uint64_t rtt   = hz / 100;
+    uint32_t w_max = 100 * CC_MSS;
+    struct tcb_entry *tcb;
+    uint64_t now, k;
+    uint32_t cwnd;
+
+    tcb = cc_tcb_create("cubic", 4 * CC_MSS, w_max);
+    TST_ASSERT_GOTO(tcb, "Failed to create the cubic connection", err);
+
+    /* Slow start adds at most one MSS per ACK, a stretch ACK counts as one */
+    now = hz;
+    tcb->snd_max += 3 * CC_MSS;
+    cnet_tcp_cc_sent(tcb, tcb->snd_max, false, now);
+    now += rtt;
+    tcb->snd_una = tcb->snd_max;
+    cnet_tcp_cc_ack(tcb, 3 * CC_MSS, now);
+    TST_ASSERT_GOTO(tcb->snd_cwnd == 5 * CC_MSS, "Slow start cwnd %u", err, tcb->snd_cwnd);
+    cc_ack_many(tcb, 95, now);
+    TST_ASSERT_GOTO(tcb->snd_cwnd == w_max, "Slow start cwnd %u", err, tcb->snd_cwnd);
+    tst_ok("Cubic slow start");
+
+    /* First loss, beta is 0.7 and the plateau is the window at the loss */
+    cnet_tcp_cc_loss(tcb);
+    TST_ASSERT_GOTO(tcb->snd_ssthresh == w_max * 7 / 10, "ssthresh %u after a loss", err,
+                    tcb->snd_ssthresh);
+    tcb->snd_cwnd = tcb->snd_ssthresh;
+    tcb->tflags |= TCBF_IN_RECOVERY;
+    cc_ack_many(tcb, 10, now);
+    TST_ASSERT_GOTO(tcb->snd_cwnd == w_max * 7 / 10, "cwnd %u grew during recovery", err,
+                    tcb->snd_cwnd);
+    tcb->tflags &= ~TCBF_IN_RECOVERY;
+
+    /* The ACK at ssthresh is still slow start, the next one starts the epoch */
+    cc_send_ack(tcb, CC_MSS, 0, now);
+    cwnd = tcb->snd_cwnd;
+    cc_send_ack(tcb, CC_MSS, 0, now);
+    TST_ASSERT_GOTO(tcb->snd_cwnd > cwnd && tcb->snd_cwnd < w_max, "Epoch start cwnd %u", err,
+                    tcb->snd_cwnd);
+
+    /* K = cubic_root((W_max - cwnd) / C) with C = 0.4, 29 segments give 4.169 seconds */
+    k = (hz * 4169) / 1000;
+
+    /* Concave region, the window grows towards the plateau but stays below it */
+    cc_ack_many(tcb, 1000, now + k / 2);
+    TST_ASSERT_GOTO(tcb->snd_cwnd > 90 * CC_MSS && tcb->snd_cwnd < w_max,
+                    "Concave region cwnd %u", err, tcb->snd_cwnd);
+    cc_ack_many(tcb, 1000, now + k);
+    TST_ASSERT_GOTO(tcb->snd_cwnd >= 99 * CC_MSS && tcb->snd_cwnd <= w_max + CC_MSS,
+                    "cwnd %u not at the plateau after K", err, tcb->snd_cwnd);
+
+    /* Convex region, the window probes above the plateau */
+    cc_ack_many(tcb, 1000, now + 2 * k);
+    TST_ASSERT_GOTO(tcb->snd_cwnd > 120 * CC_MSS, "Convex region cwnd %u", err, tcb->snd_cwnd);
+    tst_ok("Cubic concave and convex growth around W_max");
+
+    /* A loss below the last plateau lowers W_max to (1 + beta) / 2 * cwnd */
+    tcb->snd_cwnd = 90 * CC_MSS;
+    cnet_tcp_cc_loss(tcb);
+    tcb->snd_cwnd = tcb->snd_ssthresh;
+    TST_ASSERT_GOTO(tcb->snd_cwnd == 63 * CC_MSS, "ssthresh %u after a loss", err,
+                    tcb->snd_ssthresh);
+    now += 3 * k;
+    cc_ack_many(tcb, 2, now);
+    k = (hz * 3150) / 1000; /* 12.5 segments to the new 76.5 segment plateau */
+    cc_ack_many(tcb, 1000, now + k);
+    TST_ASSERT_GOTO(tcb->snd_cwnd > 70 * CC_MSS && tcb->snd_cwnd < 80 * CC_MSS,
+                    "Fast convergence plateau cwnd %u", err, tcb->snd_cwnd);
+    tst_ok("Cubic fast convergence");
+
+    cwnd = tcb->snd_cwnd;
+    cnet_tcp_cc_rto(tcb);
+    TST_ASSERT_GOTO(tcb->snd_cwnd == CC_MSS && tcb->snd_ssthresh == cwnd * 7 / 10,
+                    "cwnd %u ssthresh %u after a timeout", err, tcb->snd_cwnd,
+                    tcb->snd_ssthresh);
+    tst_ok("Cubic timeout");
+
+    cc_tcb_destroy(tcb);
+    return 0;
+err:
+    cc_tcb_destroy(tcb);
+    return -1;
+}
+
+/* Feed bbr one round trip sample and return the pacing gain in BBR_GAIN_UNIT */
+static uint64_t
+bbr_round(struct tcb_entry *tcb, uint64_t bw, uint64_t rtt, uint32_t inflight, bool recovery,
+          uint64_t now)
+{
+    struct tcp_cc_sample rs = {
+        .now         = now,
+        .rtt         = rtt,
+        .bw          = bw,
+        .acked       = CC_MSS,
+        .inflight    = inflight,
+        .round_start = true,
+        .in_recovery = recovery,
+    };
+
+    tcb->cc->ack(tcb, &rs);
+    tcb->pacing_rate = tcb->cc->pacing_rate(tcb);
+
+    return (tcb->pacing_rate * BBR_GAIN_UNIT + bw / 2) / bw;
+}
+
+/* BBRv1 STARTUP, DRAIN, PROBE_BW and PROBE_RTT transitions */
+static int
+test_cc_bbr(void)
+{
+    uint64_t hz  = cne_get_timer_hz();
+    uint64_t rtt = hz / 100;
+    uint64_t bw  = 1000000;
+    uint64_t now = hz;
+    struct tcb_entry *tcb;
+    uint64_t gain;
+    uint32_t cwnd;
+    bool drain_seen;
+
+    tcb = cc_tcb_create("bbr", 10 * CC_MSS, 20 * CC_MSS);
+    TST_ASSERT_GOTO(tcb, "Failed to create the bbr connection", err);
+    TST_ASSERT_GOTO(tcb->cc->pacing_rate(tcb) == 0, "Pacing before the first sample", err);
+
+    /* STARTUP while the bandwidth doubles every round */
+    for (int i = 0; i < 4; i++, bw *= 2) {
+        now += rtt;
+        gain = bbr_round(tcb, bw, rtt, 0, false, now);
+        TST_ASSERT_GOTO(gain == BBR_GAIN_STARTUP, "Round %d gain %lu not STARTUP", err, i, gain);
+    }
+    bw /= 2;
+    tst_ok("BBR stays in STARTUP while the bandwidth grows");
+
+    /* Three rounds without growth fill the pipe, DRAIN while the queue is above the BDP */
+    for (int i = 0; i < 3; i++) {
+        now += rtt;
+        gain = bbr_round(tcb, bw, rtt, 100 * CC_MSS, false, now);
+    }
+    TST_ASSERT_GOTO(gain == BBR_GAIN_DRAIN, "Gain %lu not DRAIN", err, gain);
+    now += rtt;
+    gain = bbr_round(tcb, bw, rtt, 100 * CC_MSS, false, now);
+    TST_ASSERT_GOTO(gain == BBR_GAIN_DRAIN, "Gain %lu left DRAIN with a queue", err, gain);
+    tst_ok("BBR leaves STARTUP for DRAIN after three rounds without growth");
+
+    /* PROBE_BW once inflight is at the BDP, never starting with the drain phase */
+    now += rtt;
+    gain = bbr_round(tcb, bw, rtt, 0, false, now);
+    TST_ASSERT_GOTO(gain == BBR_GAIN_PROBE || gain == BBR_GAIN_UNIT, "Gain %lu not PROBE_BW",
+                    err, gain);
+
+    /* The gain cycles once per min_rtt through 5/4, 3/4 and six rounds of 1 */
+    drain_seen = false;
+    for (int i = 0; i < 8; i++) {
+        now += rtt + 1;
+        gain = bbr_round(tcb, bw, rtt, 0, false, now);
+        TST_ASSERT_GOTO(gain == BBR_GAIN_PROBE || gain == BBR_GAIN_DOWN || gain == BBR_GAIN_UNIT,
+                        "Gain %lu not in the PROBE_BW cycle", err, gain);
+        drain_seen |= gain == BBR_GAIN_DOWN;
+    }
+    TST_ASSERT_GOTO(drain_seen, "PROBE_BW cycle without a 3/4 phase", err);
+    tst_ok("BBR cycles the PROBE_BW gains");
+
+    /* min_rtt not seen for 10 seconds, PROBE_RTT holds cwnd at 4 segments */
+    cwnd = tcb->snd_cwnd;
+    TST_ASSERT_GOTO(cwnd > 4 * CC_MSS, "cwnd %u too small for PROBE_RTT", err, cwnd);
+    now += 11 * hz;
+    gain = bbr_round(tcb, bw, 2 * rtt, 0, false, now);
+    TST_ASSERT_GOTO(gain == BBR_GAIN_UNIT && tcb->snd_cwnd == 4 * CC_MSS,
+                    "PROBE_RTT gain %lu cwnd %u", err, gain, tcb->snd_cwnd);
+    now += hz / 10;
+    bbr_round(tcb, bw, 2 * rtt, 0, false, now);
+    TST_ASSERT_GOTO(tcb->snd_cwnd == 4 * CC_MSS, "PROBE_RTT ended before 200ms", err);
+
+    /* After 200ms and one round return to PROBE_BW with the window before PROBE_RTT */
+    now += hz / 5;
+    gain = bbr_round(tcb, bw, 2 * rtt, 0, false, now);
+    TST_ASSERT_GOTO(gain == BBR_GAIN_PROBE || gain == BBR_GAIN_UNIT, "Gain %lu not PROBE_BW",
+                    err, gain);
+    TST_ASSERT_GOTO(tcb->snd_cwnd >= cwnd, "cwnd %u not restored to %u", err, tcb->snd_cwnd,
+                    cwnd);
+    tst_ok("BBR enters and leaves PROBE_RTT");
+
+    /* Packet conservation in recovery, the window comes back when it ends */
+    cwnd = tcb->snd_cwnd;
+    now += rtt;
+    bbr_round(tcb, bw, 2 * rtt, 5 * CC_MSS, true, now);
+    TST_ASSERT_GOTO(tcb->snd_cwnd <= 7 * CC_MSS, "cwnd %u not inflight + acked in recovery",
+                    err, tcb->snd_cwnd);
+    TST_ASSERT_GOTO(tcb->cc->loss(tcb) == tcb->snd_cwnd, "Loss changed ssthresh", err);
+    now += rtt;
+    bbr_round(tcb, bw, 2 * rtt, 0, false, now);
+    TST_ASSERT_GOTO(tcb->snd_cwnd >= cwnd, "cwnd %u not restored to %u after recovery", err,
+                    tcb->snd_cwnd, cwnd);
+
+    cwnd = tcb->snd_cwnd;
+    cnet_tcp_cc_rto(tcb);
+    TST_ASSERT_GOTO(tcb->snd_cwnd == CC_MSS && tcb->snd_ssthresh == cwnd,
+                    "cwnd %u ssthresh %u after a timeout", err, tcb->snd_cwnd,
+                    tcb->snd_ssthresh);
+    tst_ok("BBR loss recovery and timeout");
+
+    cc_tcb_destroy(tcb);
+    return 0;
+err:
+    cc_tcb_destroy(tcb);
+    return -1;
+}
+
+int
+tcp_cc_main(int argc, char **argv)
+{
+    static const struct option lgopts[] = {{NULL, 0, 0, 0}};
+    tst_info_t *tst;
+    int option_index, opt;
+
+    optind = 0;
+    while ((opt = getopt_long(argc, argv, "", lgopts, &option_index)) != EOF)
+        ;
+
+    tst = tst_start("TCP congestion control");
+
+    if (test_cc_select() < 0 || test_cc_reno() < 0 || test_cc_cubic() < 0 ||
+        test_cc_bbr() < 0) {
+        tst_end(tst, TST_FAILED);
+        return -1;
+    }
+
+    tst_end(tst, TST_PASSED);
+    return 0;
+}
@@ -0,0 +1,590 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright (c) 2023 Intel Corporation
+ */
+
+#include <stdio.h>                 // for NULL, EOF
+#include <stdint.h>                // for uint8_t, uint16_t, uint32_t
+#include <string.h>                // for memset
+#include <getopt.h>                // for getopt_long, option
+#include <netinet/in.h>            // for IPPROTO_TCP, IPPROTO_UDP
+#include <pktmbuf.h>               // for pktmbuf_t, pktmbuf_alloc, pktmbuf_append
+#include <tst_info.h>              // for tst_end, tst_ok, TST_ASSERT_GOTO, tst_start
+#include <cne_common.h>            // for cne_countof, CNE_SET_USED
+#include <net/cne_ip.h>            // for cne_ipv4_udptcp_cksum, cne_ipv4_cksum
+#include <net/cne_tcp.h>           // for cne_tcp_hdr
+#include <cne_graph.h>             // for cne_graph_create, cne_node_clone
+#include <cne_graph_worker.h>      // for cne_graph_walk, cne_node_enqueue
+#include <cnet_stk.h>              // for stk_t, stk_get, stk_set, TCP_GRO_ENABLED
+#include <cnet_tcp.h>              // for TCP_ACK, TCP_PSH, TCP_FIN, tcp_stats
+#include <cnet_tcp_gro.h>          // for cnet_tcp_gro, TCP_GRO_MAX_SEGS
+#include <cnet_node_names.h>       // for TCP_GRO_NODE_NAME
+
+#include "tcp_gro_test.h"
+#include "cne_mmap.h"        // for mmap_free, mmap_addr, mmap_alloc, MMAP...
+
+#define GRO_NB_MBUFS 256
+#define GRO_BUF_SIZE 4096 /**< Large enough to reach the 64K limit with fewer segments */
+#define GRO_L4_LEN   32   /**< TCP header with the timestamp option */
+#define GRO_MSS      1000 /**< Payload of a full segment */
+#define GRO_BURST    64
+#define GRO_SEQ      0xfffffc00 /**< First sequence number, wraps in the burst */
+#define GRO_ACK      0x12345678
+#define GRO_WIN      0x2000
+#define GRO_TSVAL    0x01020304
+#define GRO_SINK     "tcp_gro_test_sink"
+#define GRO_CLONE    "gro_test" /**< The tcp_gro clone with its edge to GRO_SINK */
+
+/* Packets handed to the graph by the source node and received by the sink node */
+static pktmbuf_t *gro_src[GRO_BURST], *gro_sink[GRO_BURST];
+static uint16_t gro_nb_src, gro_nb_sink;
+
+/* Payload byte at sequence number seq */
+static inline uint8_t
+gro_byte(uint32_t seq)
+{
+    return (uint8_t)(seq * 7 + 3);
+}
+
+static inline struct cne_tcp_hdr *
+gro_tcp(pktmbuf_t *m)
+{
+    return pktmbuf_mtod_offset(m, struct cne_tcp_hdr *, m->l3_len);
+}
+
+/* Recompute the TCP checksum after a header of the segment was changed */
+static void
+gro_cksum(pktmbuf_t *m)
+{
+    struct cne_tcp_hdr *tcp = gro_tcp(m);
+    void *l3                = pktmbuf_mtod(m, void *);
+
+    tcp->cksum = 0;
+    if (m->l3_len == sizeof(struct cne_ipv6_hdr))
+        tcp->cksum = cne_ipv6_udptcp_cksum(l3, tcp);
+    else
+        tcp->cksum = cne_ipv4_udptcp_cksum(l3, tcp);
+}
+
+/* Build a segment as received by tcp_gro, the data offset is at the IP header */
+static pktmbuf_t *
+gro_pkt_create(pktmbuf_info_t *pi, bool ipv6, uint16_t sport, uint32_t seq, uint16_t plen,
+               uint8_t flags)
+{
+    uint16_t l3_len = ipv6 ? sizeof(struct cne_ipv6_hdr) : sizeof(struct cne_ipv4_hdr);
+    uint16_t hlen   = l3_len + GRO_L4_LEN;
+    struct cne_tcp_hdr *tcp;
+    uint8_t *p, *opt;
+    pktmbuf_t *m;
+
+    if ((m = pktmbuf_alloc(pi)) == NULL)
+        return NULL;
+
+    p = (uint8_t *)pktmbuf_append(m, hlen + plen);
+    if (!p) {
+        pktmbuf_free(m);
+        return NULL;
+    }
+    memset(p, 0, hlen);
+    if (ipv6) {
+        struct cne_ipv6_hdr *ip6 = (struct cne_ipv6_hdr *)p;
+
+        ip6->vtc_flow    = htobe32(6 << 28);
+        ip6->payload_len = htobe16(GRO_L4_LEN + plen);
+        ip6->proto       = IPPROTO_TCP;
+        ip6->hop_limits  = 64;
+        for (int i = 0; i < 16; i++) {
+            ip6->src_addr[i] = (uint8_t)(0x20 + i);
+            ip6->dst_addr[i] = (uint8_t)(0x80 + i);
+        }
+    } else {
+        struct cne_ipv4_hdr *ip4 = (struct cne_ipv4_hdr *)p;
+
+        ip4->version_ihl   = 0x45;
+        ip4->total_length  = htobe16(hlen + plen);
+        ip4->time_to_live  = 64;
+        ip4->next_proto_id = IPPROTO_TCP;
+        ip4->src_addr      = htobe32(CNE_IPV4(192, 168, 1, 2));
+        ip4->dst_addr      = htobe32(CNE_IPV4(192, 168, 1, 1));
+        ip4->hdr_checksum  = cne_ipv4_cksum(ip4);
+    }
+
+    tcp            = (struct cne_tcp_hdr *)(p + l3_len);
+    tcp->src_port  = htobe16(sport);
+    tcp->dst_port  = htobe16(80);
+    tcp->sent_seq  = htobe32(seq);
+    tcp->recv_ack  = htobe32(GRO_ACK);
+    tcp->data_off  = (GRO_L4_LEN / 4) << 4;
+    tcp->tcp_flags = flags;
+    tcp->rx_win    = htobe16(GRO_WIN);
+
+    /* NOP, NOP, timestamp */
+    opt    = (uint8_t *)&tcp[1];
+    opt[0] = 1;
+    opt[1] = 1;
+    opt[2] = 8;
+    opt[3] = 10;
+    *(uint32_t *)&opt[4] = htobe32(GRO_TSVAL);
+
+    for (int i = 0; i < plen; i++)
+        p[hlen + i] = gro_byte(seq + i);
+
+    m->l3_len = l3_len;
+    m->l4_len = GRO_L4_LEN;
+    gro_cksum(m);
+
+    return m;
+}
+
+static void
+gro_free(pktmbuf_t **pkts, int nb)
+{
+    for (int i = 0; i < nb; i++)
+        pktmbuf_free(pkts[i]);
+}
+
+/* Build nb full segments of flow sport in order from GRO_SEQ */
+static int
+gro_build(pktmbuf_info_t *pi, pktmbuf_t **pkts, int nb, bool ipv6, uint16_t sport,
+          uint16_t plen)
+{
+    for (int i = 0; i < nb; i++) {
+        pkts[i] = gro_pkt_create(pi, ipv6, sport, GRO_SEQ + i * plen, plen, TCP_ACK);
+        if (!pkts[i]) {
+            gro_free(pkts, i);
+            return -1;
+        }
+    }
+    return 0;
+}
+
+/*
+ * Check m is the merge of nb segments holding plen bytes from sequence number seq, with
+ * valid IP lengths, checksums and the payload in order along the chain.
+ */
+static int
+gro_check(pktmbuf_t *m, uint16_t nb, uint32_t seq, uint32_t plen, uint8_t flags)
+{
+    uint16_t hlen           = m->l3_len + GRO_L4_LEN;
+    struct cne_tcp_hdr *tcp = gro_tcp(m);
+    uint32_t off            = 0;
+
+    TST_ASSERT_GOTO(m->nb_segs == nb, "Merged %u segments expected %u", err, m->nb_segs, nb);
+    TST_ASSERT_GOTO(pktmbuf_pkt_len(m) == hlen + plen, "Packet length %u expected %u", err,
+                    pktmbuf_pkt_len(m), hlen + plen);
+    TST_ASSERT_GOTO(be32toh(tcp->sent_seq) == seq, "Sequence number %x expected %x", err,
+                    be32toh(tcp->sent_seq), seq);
+    TST_ASSERT_GOTO(tcp->tcp_flags == flags, "Flags %02x expected %02x", err, tcp->tcp_flags,
+                    flags);
+    TST_ASSERT_GOTO((m->ol_flags & CNE_MBUF_F_RX_L4_CKSUM_MASK) == CNE_MBUF_F_RX_L4_CKSUM_GOOD,
+                    "Checksum not marked good", err);
+
+    if (m->l3_len == sizeof(struct cne_ipv6_hdr)) {
+        struct cne_ipv6_hdr *ip6 = pktmbuf_mtod(m, struct cne_ipv6_hdr *);
+
+        TST_ASSERT_GOTO(be16toh(ip6->payload_len) == GRO_L4_LEN + plen,
+                        "payload_len %u expected %u", err, be16toh(ip6->payload_len),
+                        GRO_L4_LEN + plen);
+    } else {
+        struct cne_ipv4_hdr *ip4 = pktmbuf_mtod(m, struct cne_ipv4_hdr *);
+        uint16_t cksum           = ip4->hdr_checksum;
+
+        TST_ASSERT_GOTO(be16toh(ip4->total_length) == hlen + plen,
+                        "total_length %u expected %u", err, be16toh(ip4->total_length),
+                        hlen + plen);
+        ip4->hdr_checksum = 0;
+        TST_ASSERT_GOTO(cne_ipv4_cksum(ip4) == cksum, "IPv4 header checksum not updated", err);
+        ip4->hdr_checksum = cksum;
+    }
+
+    for (pktmbuf_t *s = m; s; s = s->next) {
+        uint8_t *p   = pktmbuf_mtod(s, uint8_t *);
+        uint16_t len = pktmbuf_data_len(s);
+
+        if (s == m) {
+            p += hlen;
+            len -= hlen;
+        }
+        for (uint16_t j = 0; j < len; j++, off++)
+            TST_ASSERT_GOTO(p[j] == gro_byte(seq + off), "Payload byte %u out of order", err,
+                            off);
+    }
+    return 0;
+err:
+    return -1;
+}
+
+/* In-order segments of a flow are merged into the first one, a short segment ends it */
+static int
+test_gro_merge(pktmbuf_info_t *pi, struct tcp_stats *stats, bool ipv6)
+{
+    pktmbuf_t *pkts[GRO_BURST];
+    uint64_t merged = stats->S_gro_merged;
+    int nb          = 6;
+
+    if (gro_build(pi, pkts, nb, ipv6, 1234, GRO_MSS) < 0)
+        return -1;
+
+    /* The fifth segment is short and ends the merge, the sixth one is left alone */
+    pktmbuf_free(pkts[4]);
+    pkts[4] = gro_pkt_create(pi, ipv6, 1234, GRO_SEQ + 4 * GRO_MSS, 400, TCP_ACK);
+    TST_ASSERT_GOTO(pkts[4] != NULL, "Failed to create a segment", err);
+    pktmbuf_free(pkts[5]);
+    pkts[5] = gro_pkt_create(pi, ipv6, 1234, GRO_SEQ + 4 * GRO_MSS + 400, GRO_MSS, TCP_ACK);
+    TST_ASSERT_GOTO(pkts[5] != NULL, "Failed to create a segment", err);
+
+    nb = cnet_tcp_gro(pkts, nb);
+    TST_ASSERT_GOTO(nb == 2, "%d packets left after the merge", err, nb);
+    if (gro_check(pkts[0], 5, GRO_SEQ, 4 * GRO_MSS + 400, TCP_ACK) < 0 ||
+        gro_check(pkts[1], 1, GRO_SEQ + 4 * GRO_MSS + 400, GRO_MSS, TCP_ACK) < 0)
+        goto err;
+    TST_ASSERT_GOTO(stats->S_gro_merged == merged + 4, "Merged segments not counted", err);
+
+    gro_free(pkts, nb);
+    tst_ok("IPv%d in-order segments merged up to a short segment", ipv6 ? 6 : 4);
+    return 0;
+err:
+    gro_free(pkts, nb);
+    return -1;
+}
+
+/* A PSH, another flag, a gap or a different header ends the merge of the flow */
+static int
+test_gro_flush(pktmbuf_info_t *pi)
+{
+    static const char *what[] = {"PSH", "FIN", "gap", "ACK", "window", "timestamp", "checksum"};
+    pktmbuf_t *pkts[GRO_BURST];
+    int nb = 0;
+
+    for (int k = 0; k < (int)cne_countof(what); k++) {
+        struct cne_tcp_hdr *tcp;
+
+        nb = 4;
+        if (gro_build(pi, pkts, nb, false, 1234, GRO_MSS) < 0)
+            return -1;
+        tcp = gro_tcp(pkts[2]);
+
+        switch (k) {
+        case 0:
+            /* PSH is kept on the merged packet and the next segment starts a new one */
+            gro_tcp(pkts[1])->tcp_flags |= TCP_PSH;
+            gro_cksum(pkts[1]);
+            nb = cnet_tcp_gro(pkts, nb);
+            TST_ASSERT_GOTO(nb == 2, "%s: %d packets left", err, what[k], nb);
+            if (gro_check(pkts[0], 2, GRO_SEQ, 2 * GRO_MSS, TCP_ACK | TCP_PSH) < 0 ||
+                gro_check(pkts[1], 2, GRO_SEQ + 2 * GRO_MSS, 2 * GRO_MSS, TCP_ACK) < 0)
+                goto err;
+            break;
+        case 1:
+            /* The FIN segment is left alone for tcp_input, the next one starts a merge */
+            tcp->tcp_flags |= TCP_FIN;
+            gro_cksum(pkts[2]);
+            nb = cnet_tcp_gro(pkts, nb);
+            TST_ASSERT_GOTO(nb == 3, "%s: %d packets left", err, what[k], nb);
+            if (gro_check(pkts[0], 2, GRO_SEQ, 2 * GRO_MSS, TCP_ACK) < 0 ||
+                gro_check(pkts[2], 1, GRO_SEQ + 3 * GRO_MSS, GRO_MSS, TCP_ACK) < 0)
+                goto err;
+            TST_ASSERT_GOTO(pkts[1]->nb_segs == 1 && gro_tcp(pkts[1])->tcp_flags & TCP_FIN,
+                            "%s: segment merged", err, what[k]);
+            break;
+        case 6:
+            /* A bad checksum is left for tcp_input to drop, without the good flag */
+            tcp->cksum ^= 0x5555;
+            nb = cnet_tcp_gro(pkts, nb);
+            TST_ASSERT_GOTO(nb == 3, "%s: %d packets left", err, what[k], nb);
+            if (gro_check(pkts[0], 2, GRO_SEQ, 2 * GRO_MSS, TCP_ACK) < 0)
+                goto err;
+            TST_ASSERT_GOTO(pkts[1]->nb_segs == 1 && (pkts[1]->ol_flags &
+                                                      CNE_MBUF_F_RX_L4_CKSUM_MASK) == 0,
+                            "%s: segment merged or marked good", err, what[k]);
+            TST_ASSERT_GOTO(pkts[2]->nb_segs == 1, "%s: merged after the bad segment", err,
+                            what[k]);
+            break;
+        default:
+            /* The flow is merged again from the segment that differs, up to the last one */
+            if (k == 2) {
+                gro_free(&pkts[2], 2);
+                for (int i = 2; i < 4; i++) {
+                    pkts[i] = gro_pkt_create(pi, false, 1234, GRO_SEQ + (i + 1) * GRO_MSS,
+                                             GRO_MSS, TCP_ACK);
+                    if (!pkts[i]) {
+                        nb = i;
+                        goto err;
+                    }
+                }
+            }
+            for (int i = 2; k != 2 && i < 4; i++) {
+                tcp = gro_tcp(pkts[i]);
+                if (k == 3)
+                    tcp->recv_ack = htobe32(GRO_ACK + 1);
+                else if (k == 4)
+                    tcp->rx_win = htobe16(GRO_WIN + 1);
+                else
+                    *(uint32_t *)((uint8_t *)&tcp[1] + 4) = htobe32(GRO_TSVAL + 1);
+                gro_cksum(pkts[i]);
+            }
+
+            nb = cnet_tcp_gro(pkts, nb);
+            TST_ASSERT_GOTO(nb == 2, "%s: %d packets left", err, what[k], nb);
+            if (gro_check(pkts[0], 2, GRO_SEQ, 2 * GRO_MSS, TCP_ACK) < 0 ||
+                gro_check(pkts[1], 2, GRO_SEQ + ((k == 2) ? 3 : 2) * GRO_MSS, 2 * GRO_MSS,
+                          TCP_ACK) < 0)
+                goto err;
+            break;
+        }
+        gro_free(pkts, nb);
+        nb = 0;
+    }
+    tst_ok("PSH, flags, gaps, header changes and bad checksums end the merge");
+
+    return 0;
+err:
+    gro_free(pkts, nb);
+    return -1;
+}
+
+/* Flows are merged side by side and a packet which is not TCP ends all of them */
+static int
+test_gro_flows(pktmbuf_info_t *pi)
+{
+    pktmbuf_t *a[4], *b[4], *pkts[GRO_BURST];
+    struct cne_ipv4_hdr *ip4;
+    int nb = 0;
+
+    if (gro_build(pi, a, 4, false, 1000, GRO_MSS) < 0)
+        return -1;
+    if (gro_build(pi, b, 4, false, 2000, GRO_MSS) < 0) {
+        gro_free(a, 4);
+        return -1;
+    }
+
+    /* A0 B0 A1 B1 X A2 B2 A3 B3 */
+    for (int i = 0; i < 2; i++) {
+        pkts[nb++] = a[i];
+        pkts[nb++] = b[i];
+    }
+    pkts[nb] = gro_pkt_create(pi, false, 3000, GRO_SEQ, GRO_MSS, TCP_ACK);
+    if (!pkts[nb]) {
+        gro_free(pkts, nb);
+        gro_free(&a[2], 2);
+        gro_free(&b[2], 2);
+        return -1;
+    }
+    ip4                = pktmbuf_mtod(pkts[nb], struct cne_ipv4_hdr *);
+    ip4->next_proto_id = IPPROTO_UDP;
+    nb++;
+    for (int i = 2; i < 4; i++) {
+        pkts[nb++] = a[i];
+        pkts[nb++] = b[i];
+    }
+
+    nb = cnet_tcp_gro(pkts, nb);
+    TST_ASSERT_GOTO(nb == 5, "%d packets left", err, nb);
+    TST_ASSERT_GOTO(pkts[0] == a[0] && pkts[1] == b[0] && pkts[3] == a[2] && pkts[4] == b[2],
+                    "Packets out of order", err);
+    TST_ASSERT_GOTO(pkts[2]->nb_segs == 1 && gro_tcp(pkts[2])->src_port == htobe16(3000),
+                    "Packet which is not TCP changed", err);
+    if (gro_check(pkts[0], 2, GRO_SEQ, 2 * GRO_MSS, TCP_ACK) < 0 ||
+        gro_check(pkts[1], 2, GRO_SEQ, 2 * GRO_MSS, TCP_ACK) < 0 ||
+        gro_check(pkts[3], 2, GRO_SEQ + 2 * GRO_MSS, 2 * GRO_MSS, TCP_ACK) < 0 ||
+        gro_check(pkts[4], 2, GRO_SEQ + 2 * GRO_MSS, 2 * GRO_MSS, TCP_ACK) < 0)
+        goto err;
+
+    gro_free(pkts, nb);
+    tst_ok("Interleaved flows merged and a packet which is not TCP ends all merges");
+    return 0;
+err:
+    gro_free(pkts, nb);
+    return -1;
+}
+
+/* A merge never holds more than TCP_GRO_MAX_SEGS segments or 64K of IP length */
+static int
+test_gro_limits(pktmbuf_info_t *pi)
+{
+    pktmbuf_t *pkts[GRO_BURST];
+    uint16_t plen = 100, nb_max;
+    int nb        = TCP_GRO_MAX_SEGS + 8;
+
+    if (gro_build(pi, pkts, nb, false, 1234, plen) < 0)
+        return -1;
+    nb = cnet_tcp_gro(pkts, nb);
+    TST_ASSERT_GOTO(nb == 2, "%d packets left with the segment limit", err, nb);
+    if (gro_check(pkts[0], TCP_GRO_MAX_SEGS, GRO_SEQ, TCP_GRO_MAX_SEGS * plen, TCP_ACK) < 0 ||
+        gro_check(pkts[1], 8, GRO_SEQ + TCP_GRO_MAX_SEGS * plen, 8 * plen, TCP_ACK) < 0)
+        goto err;
+    gro_free(pkts, nb);
+    tst_ok("Merge ends at %d segments", TCP_GRO_MAX_SEGS);
+
+    /* The largest number of segments which fit in the IPv4 total_length */
+    plen   = 3000;
+    nb_max = (UINT16_MAX - sizeof(struct cne_ipv4_hdr) - GRO_L4_LEN) / plen;
+    nb     = nb_max + 3;
+    if (gro_build(pi, pkts, nb, false, 1234, plen) < 0)
+        return -1;
+    nb = cnet_tcp_gro(pkts, nb);
+    TST_ASSERT_GOTO(nb == 2, "%d packets left with the length limit", err, nb);
+    if (gro_check(pkts[0], nb_max, GRO_SEQ, nb_max * plen, TCP_ACK) < 0 ||
+        gro_check(pkts[1], 3, GRO_SEQ + nb_max * plen, 3 * plen, TCP_ACK) < 0)
+        goto err;
+    gro_free(pkts, nb);
+    tst_ok("Merge ends before the IP length goes past %u", UINT16_MAX);
+
+    return 0;
+err:
+    gro_free(pkts, nb);
+    return -1;
+}
+
+static uint16_t
+gro_source_process(struct cne_graph *graph, struct cne_node *node, void **objs,
+                   uint16_t nb_objs)
+{
+    CNE_SET_USED(objs);
+    CNE_SET_USED(nb_objs);
+
+    nb_objs = gro_nb_src;
+    if (nb_objs) {
+        cne_node_enqueue(graph, node, 0, (void **)gro_src, nb_objs);
+        gro_nb_src = 0;
+    }
+    return nb_objs;
+}
+
+static uint16_t
+gro_sink_process(struct cne_graph *graph, struct cne_node *node, void **objs, uint16_t nb_objs)
+{
+    CNE_SET_USED(graph);
+    CNE_SET_USED(node);
+
+    for (uint16_t i = 0; i < nb_objs && gro_nb_sink < GRO_BURST; i++)
+        gro_sink[gro_nb_sink++] = objs[i];
+    return nb_objs;
+}
+
+static struct cne_node_register gro_source_node = {
+    .name       = "tcp_gro_test_source",
+    .process    = gro_source_process,
+    .flags      = CNE_NODE_SOURCE_F,
+    .nb_edges   = 1,
+    .next_nodes = {TCP_GRO_NODE_NAME "-" GRO_CLONE},
+};
+CNE_NODE_REGISTER(gro_source_node);
+
+static struct cne_node_register gro_sink_node = {
+    .name    = GRO_SINK,
+    .process = gro_sink_process,
+};
+CNE_NODE_REGISTER(gro_sink_node);
+
+/* The tcp_gro node merges the burst only when GRO is enabled on the stack instance */
+static int
+test_gro_node(pktmbuf_info_t *pi, stk_t *stk)
+{
+    static const char *patterns[] = {"tcp_gro_test_source", TCP_GRO_NODE_NAME "-" GRO_CLONE,
+                                     GRO_SINK, NULL};
+    static const char *sink[]     = {GRO_SINK};
+    cne_graph_t id                = CNE_GRAPH_ID_INVALID;
+    struct cne_graph *graph;
+    cne_node_t node;
+
+    /*
+     * Run a clone of tcp_gro with its edge moved from tcp_input to the sink node, the clone
+     * is kept in the node list when the test is run again.
+     */
+    node = cne_node_from_name(TCP_GRO_NODE_NAME "-" GRO_CLONE);
+    if (node == CNE_NODE_ID_INVALID)
+        node = cne_node_clone(cne_node_from_name(TCP_GRO_NODE_NAME), GRO_CLONE);
+    TST_ASSERT_GOTO(node != CNE_NODE_ID_INVALID, "Failed to clone the tcp_gro node", err);
+    TST_ASSERT_GOTO(cne_node_edge_update(node, 0, sink, 1) != CNE_EDGE_ID_INVALID,
+                    "Failed to move the tcp_gro edge to the sink", err);
+
+    id = cne_graph_create("tcp_gro_test", patterns);
+    TST_ASSERT_GOTO(id != CNE_GRAPH_ID_INVALID, "Failed to create the graph", err);
+    graph = cne_graph_lookup("tcp_gro_test");
+    TST_ASSERT_GOTO(graph != NULL, "Failed to find the graph", err);
+
+    for (int enable = 0; enable < 2; enable++) {
+        int want = enable ? 1 : 4;
+
+        if (enable)
+            stk->gflags |= TCP_GRO_ENABLED;
+        else
+            stk->gflags &= ~TCP_GRO_ENABLED;
+
+        if (gro_build(pi, gro_src, 4, false, 1234, GRO_MSS) < 0)
+            goto err;
+        gro_nb_src  = 4;
+        gro_nb_sink = 0;
+
+        cne_graph_walk(graph);
+        TST_ASSERT_GOTO(gro_nb_src == 0 && gro_nb_sink == want,
+                        "GRO %s: %u packets reached the sink expected %d", err,
+                        enable ? "enabled" : "disabled", gro_nb_sink, want);
+        TST_ASSERT_GOTO(gro_sink[0]->nb_segs == (enable ? 4 : 1),
+                        "GRO %s: %u segments in the first packet", err,
+                        enable ? "enabled" : "disabled", gro_sink[0]->nb_segs);
+        gro_free(gro_sink, gro_nb_sink);
+        gro_nb_sink = 0;
+    }
+    stk->gflags &= ~TCP_GRO_ENABLED;
+    tst_ok("tcp_gro node merges only with GRO enabled");
+
+    cne_graph_destroy(id);
+    return 0;
+err:
+    gro_free(gro_src, gro_nb_src);
+    gro_free(gro_sink, gro_nb_sink);
+    gro_nb_src  = 0;
+    gro_nb_sink = 0;
+    stk->gflags &= ~TCP_GRO_ENABLED;
+    if (id != CNE_GRAPH_ID_INVALID)
+        cne_graph_destroy(id);
+    return -1;
+}
+
+int
+tcp_gro_main(int argc, char **argv)
+{
+    static const struct option lgopts[] = {{NULL, 0, 0, 0}};
+    stk_t *saved_stk        = stk_get();
+    struct tcp_stats stats  = {0};
+    stk_t stk               = {.tcp_stats = &stats};
+    pktmbuf_info_t *pi      = NULL;
+    mmap_t *mm              = NULL;
+    tst_info_t *tst;
+    int option_index, opt;
+
+    optind = 0;
+    while ((opt = getopt_long(argc, argv, "", lgopts, &option_index)) != EOF)
+        ;
+
+    tst = tst_start("TCP GRO");
+
+    mm = mmap_alloc(GRO_NB_MBUFS, GRO_BUF_SIZE, MMAP_HUGEPAGE_DEFAULT);
+    TST_ASSERT_GOTO(mm != NULL, "Failed to allocate memory", leave);
+
+    pi = pktmbuf_pool_create(mmap_addr(mm), GRO_NB_MBUFS, GRO_BUF_SIZE, 0, NULL);
+    TST_ASSERT_GOTO(pi != NULL, "Failed to create pktmbuf pool", leave);
+
+    stk_set(&stk);
+
+    for (int ipv6 = 0; ipv6 <= CNET_ENABLE_IP6; ipv6++)
+        if (test_gro_merge(pi, &stats, ipv6) < 0)
+            goto leave;
+
+    if (test_gro_flush(pi) < 0 || test_gro_flows(pi) < 0 || test_gro_limits(pi) < 0 ||
+        test_gro_node(pi, &stk) < 0)
+        goto leave;
+
+    stk_set(saved_stk);
+    pktmbuf_destroy(pi);
+    mmap_free(mm);
+    tst_end(tst, TST_PASSED);
+    return 0;
+leave:
+    stk_set(saved_stk);
+    pktmbuf_destroy(pi);
+    mmap_free(mm);
+    tst_end(tst, TST_FAILED);
+    return -1;
+}
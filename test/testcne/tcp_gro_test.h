@@ -0,0 +1,24 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright (c) 2023 Intel Corporation
+ */
+
+#ifndef _TCP_GRO_TEST_H_
+#define _TCP_GRO_TEST_H_
+
+/**
+ * @file
+ * CNET TCP generic receive offload Test
+ *
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+int tcp_gro_main(int argc, char **argv);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _TCP_GRO_TEST_H_ */
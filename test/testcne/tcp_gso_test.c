@@ -0,0 +1,303 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright (c) 2023 Intel Corporation
+ */
+
+#include <stdio.h>              // for NULL, EOF
+#include <stdint.h>             // for uint8_t, uint16_t, uint32_t
+#include <string.h>             // for memset
+#include <getopt.h>             // for getopt_long, option
+#include <netinet/in.h>         // for IPPROTO_TCP
+#include <pktmbuf.h>            // for pktmbuf_t, pktmbuf_alloc, pktmbuf_append
+#include <tst_info.h>           // for tst_end, tst_ok, TST_ASSERT_GOTO, tst_start
+#include <net/cne_ip.h>         // for cne_ipv4_udptcp_cksum_verify, cne_ipv4_cksum
+#include <net/cne_tcp.h>        // for cne_tcp_hdr
+#include <cnet_stk.h>           // for stk_t, stk_get, stk_set
+#include <cnet_tcp.h>           // for TCP_FIN, TCP_PSH, TCP_ACK, tcp_stats
+#include <cnet_tcp_gso.h>       // for cnet_tcp_gso_segment
+
+#include "tcp_gso_test.h"
+#include "cne_mmap.h"        // for mmap_free, mmap_addr, mmap_alloc, MMAP...
+
+#define GSO_NB_MBUFS 256
+#define GSO_L2_LEN   14   /**< Ethernet header */
+#define GSO_L4_LEN   20   /**< TCP header without options */
+#define GSO_SEGSZ    1000 /**< Payload of each frame */
+#define GSO_LAST_LEN 400  /**< Payload of the last, shorter, frame */
+#define GSO_NB_SEGS  4
+#define GSO_SEQ      0x7ffffe00 /**< First sequence number */
+#define GSO_IP_ID    0xfffe     /**< IPv4 packet_id of the first frame, wraps */
+
+/* Payload byte at offset off of the super-segment */
+static inline uint8_t
+gso_byte(uint32_t off)
+{
+    return (uint8_t)(off * 13 + 5);
+}
+
+/*
+ * Build a super-segment of GSO_NB_SEGS frames, the headers and the payload of the first
+ * frame in the first mbuf and the payload of each other frame in a chained mbuf.
+ */
+static pktmbuf_t *
+gso_pkt_create(pktmbuf_info_t *pi, bool ipv6, uint8_t flags)
+{
+    uint16_t l3_len = ipv6 ? sizeof(struct cne_ipv6_hdr) : sizeof(struct cne_ipv4_hdr);
+    uint16_t hlen   = GSO_L2_LEN + l3_len + GSO_L4_LEN;
+    struct cne_tcp_hdr *tcp;
+    uint32_t off = 0;
+    pktmbuf_t *m;
+    char *p;
+
+    if ((m = pktmbuf_alloc(pi)) == NULL)
+        return NULL;
+
+    p = pktmbuf_append(m, hlen);
+    memset(p, 0, hlen);
+    if (ipv6) {
+        struct cne_ipv6_hdr *ip6 = (struct cne_ipv6_hdr *)(p + GSO_L2_LEN);
+
+        ip6->vtc_flow   = htobe32(6 << 28);
+        ip6->proto      = IPPROTO_TCP;
+        ip6->hop_limits = 64;
+        for (int i = 0; i < 16; i++) {
+            ip6->src_addr[i] = (uint8_t)(0x20 + i);
+            ip6->dst_addr[i] = (uint8_t)(0x80 + i);
+        }
+    } else {
+        struct cne_ipv4_hdr *ip4 = (struct cne_ipv4_hdr *)(p + GSO_L2_LEN);
+
+        ip4->version_ihl   = 0x45;
+        ip4->time_to_live  = 64;
+        ip4->next_proto_id = IPPROTO_TCP;
+        ip4->packet_id     = htobe16(GSO_IP_ID);
+        ip4->src_addr      = htobe32(CNE_IPV4(192, 168, 1, 1));
+        ip4->dst_addr      = htobe32(CNE_IPV4(192, 168, 1, 2));
+    }
+    tcp            = (struct cne_tcp_hdr *)(p + GSO_L2_LEN + l3_len);
+    tcp->src_port  = htobe16(5678);
+    tcp->dst_port  = htobe16(80);
+    tcp->sent_seq  = htobe32(GSO_SEQ);
+    tcp->recv_ack  = htobe32(0x12345678);
+    tcp->data_off  = (GSO_L4_LEN / 4) << 4;
+    tcp->tcp_flags = flags;
+    tcp->rx_win    = htobe16(0xffff);
+
+    for (int i = 0; i < GSO_NB_SEGS; i++) {
+        uint16_t len = (i == GSO_NB_SEGS - 1) ? GSO_LAST_LEN : GSO_SEGSZ;
+        pktmbuf_t *s = m;
+
+        if (i) {
+            if ((s = pktmbuf_alloc(pi)) == NULL || pktmbuf_chain(m, s) < 0) {
+                pktmbuf_free(s);
+                pktmbuf_free(m);
+                return NULL;
+            }
+        }
+        p = pktmbuf_append(s, len);
+        for (int j = 0; j < len; j++)
+            p[j] = (char)gso_byte(off++);
+    }
+
+    m->l2_len    = GSO_L2_LEN;
+    m->l3_len    = l3_len;
+    m->l4_len    = GSO_L4_LEN;
+    m->tso_segsz = GSO_SEGSZ;
+    m->ol_flags |= CNE_MBUF_F_TX_TCP_SEG;
+
+    return m;
+}
+
+static void
+gso_free(pktmbuf_t **segs, int nb)
+{
+    for (int i = 0; i < nb; i++)
+        pktmbuf_free(segs[i]);
+}
+
+/* Check each frame is a complete TCP/IP packet with the next part of the payload */
+static int
+gso_check(pktmbuf_t **segs, int nb, bool ipv6, bool offload, uint8_t flags)
+{
+    uint16_t l3_len = ipv6 ? sizeof(struct cne_ipv6_hdr) : sizeof(struct cne_ipv4_hdr);
+    uint16_t hlen   = GSO_L2_LEN + l3_len + GSO_L4_LEN;
+    uint32_t off    = 0;
+
+    for (int i = 0; i < nb; i++) {
+        pktmbuf_t *f            = segs[i];
+        uint16_t plen           = (i == nb - 1) ? GSO_LAST_LEN : GSO_SEGSZ;
+        uint8_t *h              = pktmbuf_mtod(f, uint8_t *);
+        void *l3                = h + GSO_L2_LEN;
+        struct cne_tcp_hdr *tcp = (struct cne_tcp_hdr *)(h + GSO_L2_LEN + l3_len);
+        uint8_t want            = (i == nb - 1) ? flags : flags & ~(TCP_FIN | TCP_PSH);
+
+        TST_ASSERT_GOTO(f->next == NULL && f->nb_segs == 1, "Frame %d still chained", err, i);
+        TST_ASSERT_GOTO(pktmbuf_data_len(f) == hlen + plen, "Frame %d length %u", err, i,
+                        pktmbuf_data_len(f));
+        TST_ASSERT_GOTO(f->l2_len == GSO_L2_LEN && f->l3_len == l3_len &&
+                            f->l4_len == GSO_L4_LEN && f->tso_segsz == 0,
+                        "Frame %d offload lengths not set", err, i);
+        TST_ASSERT_GOTO(be32toh(tcp->sent_seq) == GSO_SEQ + off, "Frame %d seq %x", err, i,
+                        be32toh(tcp->sent_seq));
+        TST_ASSERT_GOTO(tcp->tcp_flags == want, "Frame %d flags %02x expected %02x", err, i,
+                        tcp->tcp_flags, want);
+        TST_ASSERT_GOTO(be16toh(tcp->src_port) == 5678 && be32toh(tcp->recv_ack) == 0x12345678,
+                        "Frame %d header not copied", err, i);
+
+        for (int j = 0; j < plen; j++, off++)
+            TST_ASSERT_GOTO(h[hlen + j] == gso_byte(off), "Frame %d payload byte %d", err, i,
+                            j);
+
+        if (ipv6) {
+            struct cne_ipv6_hdr *ip6 = l3;
+
+            TST_ASSERT_GOTO(be16toh(ip6->payload_len) == GSO_L4_LEN + plen,
+                            "Frame %d payload_len %u", err, i, be16toh(ip6->payload_len));
+            if (offload)
+                TST_ASSERT_GOTO(tcp->cksum == cne_ipv6_phdr_cksum(ip6, f->ol_flags),
+                                "Frame %d pseudo header checksum", err, i);
+            else
+                TST_ASSERT_GOTO(cne_ipv6_udptcp_cksum_verify(ip6, tcp) == 0,
+                                "Frame %d TCP checksum", err, i);
+        } else {
+            struct cne_ipv4_hdr *ip4 = l3;
+            uint16_t cksum           = ip4->hdr_checksum;
+
+            TST_ASSERT_GOTO(be16toh(ip4->total_length) == l3_len + GSO_L4_LEN + plen,
+                            "Frame %d total_length %u", err, i, be16toh(ip4->total_length));
+            TST_ASSERT_GOTO(be16toh(ip4->packet_id) == (uint16_t)(GSO_IP_ID + i),
+                            "Frame %d packet_id %u", err, i, be16toh(ip4->packet_id));
+            ip4->hdr_checksum = 0;
+            TST_ASSERT_GOTO(cne_ipv4_cksum(ip4) == cksum, "Frame %d IPv4 checksum", err, i);
+            ip4->hdr_checksum = cksum;
+            if (offload)
+                TST_ASSERT_GOTO(tcp->cksum == cne_ipv4_phdr_cksum(ip4, f->ol_flags),
+                                "Frame %d pseudo header checksum", err, i);
+            else
+                TST_ASSERT_GOTO(cne_ipv4_udptcp_cksum_verify(ip4, tcp) == 0,
+                                "Frame %d TCP checksum", err, i);
+        }
+
+        if (offload)
+            TST_ASSERT_GOTO(f->ol_flags & CNE_MBUF_F_TX_TCP_CKSUM,
+                            "Frame %d checksum offload not requested", err, i);
+        TST_ASSERT_GOTO(!(f->ol_flags & CNE_MBUF_F_TX_TCP_SEG), "Frame %d still a GSO packet",
+                        err, i);
+    }
+    return 0;
+err:
+    return -1;
+}
+
+static int
+test_gso(pktmbuf_info_t *pi, struct tcp_stats *stats, bool ipv6, bool offload)
+{
+    uint8_t flags = TCP_ACK | TCP_PSH | TCP_FIN;
+    pktmbuf_t *segs[TCP_GSO_MAX_SEGS];
+    uint64_t frames = stats->S_gso_frames;
+    pktmbuf_t *m;
+    int nb = 0;
+
+    m = gso_pkt_create(pi, ipv6, flags);
+    TST_ASSERT_GOTO(m != NULL, "Failed to create the super-segment", err);
+
+    nb = cnet_tcp_gso_segment(m, offload, segs, cne_countof(segs));
+    TST_ASSERT_GOTO(nb == GSO_NB_SEGS, "Segmented into %d frames", err, nb);
+    TST_ASSERT_GOTO(segs[0] == m, "First frame is not the super-segment", err);
+    TST_ASSERT_GOTO(stats->S_gso_frames == frames + GSO_NB_SEGS, "GSO frames not counted", err);
+
+    if (gso_check(segs, nb, ipv6, offload, flags) < 0)
+        goto err;
+
+    gso_free(segs, nb);
+    return 0;
+err:
+    if (nb > 0)
+        gso_free(segs, nb);
+    else
+        pktmbuf_free(m);
+    return -1;
+}
+
+/* Invalid super-segments are rejected and left untouched */
+static int
+test_gso_invalid(pktmbuf_info_t *pi)
+{
+    pktmbuf_t *segs[TCP_GSO_MAX_SEGS];
+    pktmbuf_t *m, *last;
+
+    m = gso_pkt_create(pi, false, TCP_ACK);
+    TST_ASSERT_GOTO(m != NULL, "Failed to create the super-segment", err);
+
+    TST_ASSERT_GOTO(cnet_tcp_gso_segment(m, false, segs, GSO_NB_SEGS - 1) < 0,
+                    "Too many frames accepted", err);
+    TST_ASSERT_GOTO(m->nb_segs == GSO_NB_SEGS && (m->ol_flags & CNE_MBUF_F_TX_TCP_SEG),
+                    "Super-segment changed on error", err);
+
+    /* A payload mbuf without headroom for the headers */
+    last = pktmbuf_lastseg(m);
+    pktmbuf_prepend(last, pktmbuf_headroom(last) - 10);
+    TST_ASSERT_GOTO(cnet_tcp_gso_segment(m, false, segs, cne_countof(segs)) < 0,
+                    "Payload without headroom accepted", err);
+
+    m->tso_segsz = GSO_SEGSZ / 2;
+    TST_ASSERT_GOTO(cnet_tcp_gso_segment(m, false, segs, cne_countof(segs)) < 0,
+                    "Frame larger than tso_segsz accepted", err);
+
+    pktmbuf_free(m);
+    tst_ok("Invalid super-segments rejected");
+    return 0;
+err:
+    pktmbuf_free(m);
+    return -1;
+}
+
+int
+tcp_gso_main(int argc, char **argv)
+{
+    static const struct option lgopts[] = {{NULL, 0, 0, 0}};
+    stk_t *saved_stk        = stk_get();
+    struct tcp_stats stats  = {0};
+    stk_t stk               = {.tcp_stats = &stats};
+    pktmbuf_info_t *pi      = NULL;
+    mmap_t *mm              = NULL;
+    tst_info_t *tst;
+    int option_index, opt;
+
+    optind = 0;
+    while ((opt = getopt_long(argc, argv, "", lgopts, &option_index)) != EOF)
+        ;
+
+    tst = tst_start("TCP GSO");
+
+    mm = mmap_alloc(GSO_NB_MBUFS, DEFAULT_MBUF_SIZE, MMAP_HUGEPAGE_DEFAULT);
+    TST_ASSERT_GOTO(mm != NULL, "Failed to allocate memory", leave);
+
+    pi = pktmbuf_pool_create(mmap_addr(mm), GSO_NB_MBUFS, DEFAULT_MBUF_SIZE, 0, NULL);
+    TST_ASSERT_GOTO(pi != NULL, "Failed to create pktmbuf pool", leave);
+
+    stk_set(&stk);
+
+    for (int i = 0; i < 4; i++) {
+        bool ipv6 = i & 1, offload = i & 2;
+
+        if (test_gso(pi, &stats, ipv6, offload) < 0)
+            goto leave;
+        tst_ok("IPv%d super-segment %s checksum offload", ipv6 ? 6 : 4,
+               offload ? "with" : "without");
+    }
+
+    if (test_gso_invalid(pi) < 0)
+        goto leave;
+
+    stk_set(saved_stk);
+    pktmbuf_destroy(pi);
+    mmap_free(mm);
+    tst_end(tst, TST_PASSED);
+    return 0;
+leave:
+    stk_set(saved_stk);
+    pktmbuf_destroy(pi);
+    mmap_free(mm);
+    tst_end(tst, TST_FAILED);
+    return -1;
+}
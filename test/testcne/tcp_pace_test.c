@@ -0,0 +1,203 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright (c) 2023 Intel Corporation
+ */
+
+#include <stdio.h>              // for NULL, EOF
+#include <stdint.h>             // for uint32_t, uint64_t
+#include <stdlib.h>             // for calloc, free
+#include <getopt.h>             // for getopt_long, option
+#include <tst_info.h>           // for tst_end, tst_ok, TST_ASSERT_GOTO, tst_start
+#include <cne_cycles.h>         // for cne_get_timer_hz, cne_rdtsc
+#include <cne_timer.h>          // for cne_timer_subsystem_init, cne_timer_pending
+#include <cne_vec.h>            // for vec_add, vec_free
+#include <cnet_stk.h>           // for stk_t, stk_get, stk_set
+#include <cnet_pcb.h>           // for pcb_entry
+#include <cnet_tcp.h>           // for tcb_entry, tcp_pace_budget, tcp_pace_defer
+
+#include "tcp_pace_test.h"
+
+#define PACE_MSS  1000     /**< max_mss of the test connections */
+#define PACE_RATE 10000000 /**< Pacing rate in bytes per second */
+#define PACE_NB   3        /**< Number of test connections */
+
+/* The stack instance used by the pacer, only the fields it touches are set */
+struct pace_stk {
+    stk_t stk;
+    struct tcp_entry tcp;
+    struct tcp_stats stats;
+    struct pcb_entry pcbs[PACE_NB];
+    struct tcb_entry tcbs[PACE_NB];
+};
+
+static struct pace_stk *
+pace_stk_create(void)
+{
+    struct pace_stk *ps = calloc(1, sizeof(struct pace_stk));
+
+    if (!ps)
+        return NULL;
+
+    ps->stk.tcp       = &ps->tcp;
+    ps->stk.tcp_stats = &ps->stats;
+    cne_timer_init(&ps->stk.tcp_pace_timer);
+
+    for (int i = 0; i < PACE_NB; i++) {
+        ps->tcbs[i].max_mss     = PACE_MSS;
+        ps->tcbs[i].pacing_rate = PACE_RATE;
+        ps->pcbs[i].tcb         = &ps->tcbs[i];
+        vec_add(ps->tcp.tcp_hd.vec, &ps->pcbs[i]);
+    }
+
+    return ps;
+}
+
+static void
+pace_stk_destroy(struct pace_stk *ps)
+{
+    if (ps) {
+        cne_timer_stop(&ps->stk.tcp_pace_timer);
+        vec_free(ps->tcp.tcp_hd.vec);
+        free(ps);
+    }
+}
+
+/* The bucket starts full, refills at the pacing rate and never holds more than the burst */
+static int
+test_pace_budget(struct pace_stk *ps)
+{
+    struct tcb_entry *tcb = &ps->tcbs[0];
+    uint64_t hz           = cne_get_timer_hz();
+    uint32_t burst        = (uint32_t)(((uint64_t)PACE_RATE * TCP_PACE_BURST_US) / 1000000);
+    uint64_t now          = cne_rdtsc();
+    uint32_t tokens;
+
+    TST_ASSERT_GOTO(tcp_pace_budget(tcb, now) == burst, "First budget %u expected %u", err,
+                    tcb->pace_tokens, burst);
+
+    /* Send most of the bucket, 100us at 10MB/s refills 1000 bytes */
+    tcb->pace_tokens -= 8 * PACE_MSS;
+    now += hz / 10000;
+    tokens = tcp_pace_budget(tcb, now);
+    TST_ASSERT_GOTO(tokens >= 3 * PACE_MSS - 1 && tokens <= 3 * PACE_MSS,
+                    "Budget %u after 100us", err, tokens);
+    TST_ASSERT_GOTO(tcb->pace_ts == now, "Refill time not recorded", err);
+
+    /* The same time again adds nothing, a long wait only fills the bucket */
+    TST_ASSERT_GOTO(tcp_pace_budget(tcb, now) == tokens, "Budget grew without time", err);
+    now += hz / 100;
+    TST_ASSERT_GOTO(tcp_pace_budget(tcb, now) == burst, "Budget %u above the burst", err,
+                    tcb->pace_tokens);
+    tcb->pace_tokens = 0;
+    now += hz;
+    TST_ASSERT_GOTO(tcp_pace_budget(tcb, now) == burst, "Budget %u after an idle second", err,
+                    tcb->pace_tokens);
+    tst_ok("Token bucket refills at the pacing rate up to the burst size");
+
+    /* SO_MAX_PACING_RATE caps the rate, the bucket still holds two segments */
+    tcb->pace_max    = PACE_RATE / 10;
+    tcb->pace_tokens = 0;
+    now += hz / 10000;
+    tokens = tcp_pace_budget(tcb, now);
+    TST_ASSERT_GOTO(tokens >= PACE_MSS / 10 - 1 && tokens <= PACE_MSS / 10,
+                    "Budget %u with the max pacing rate", err, tokens);
+    now += hz / 100;
+    TST_ASSERT_GOTO(tcp_pace_budget(tcb, now) == 2 * PACE_MSS, "Min burst %u", err,
+                    tcb->pace_tokens);
+    tcb->pace_max = 0;
+    tst_ok("Max pacing rate caps the refill and the burst is at least two segments");
+
+    return 0;
+err:
+    return -1;
+}
+
+/* A deferred send waits for the missing tokens, the stack timer runs at the earliest one */
+static int
+test_pace_defer(struct pace_stk *ps)
+{
+    struct cne_timer *tim = &ps->stk.tcp_pace_timer;
+    uint64_t hz           = cne_get_timer_hz();
+    uint64_t now          = cne_rdtsc();
+    uint64_t wait, expire, paced;
+
+    /* 5000 bytes missing at 10MB/s is 500us */
+    paced = ps->stats.S_paced;
+    ps->tcbs[0].pace_tokens = 3 * PACE_MSS;
+    tcp_pace_defer(&ps->tcbs[0], 8 * PACE_MSS, now);
+    wait = ps->tcbs[0].pace_next - now;
+    TST_ASSERT_GOTO(wait >= (hz / 2000) && wait <= (hz / 2000) + 2, "Wait %lu expected %lu", err,
+                    wait, hz / 2000);
+    TST_ASSERT_GOTO(ps->stats.S_paced == paced + 1, "Paced send not counted", err);
+    TST_ASSERT_GOTO(cne_timer_pending(tim), "Pacer timer not armed", err);
+    expire = tim->expire;
+
+    /* A later deadline keeps the timer, an earlier one moves it forward */
+    ps->tcbs[1].pace_tokens = 0;
+    tcp_pace_defer(&ps->tcbs[1], 20 * PACE_MSS, now);
+    TST_ASSERT_GOTO(tim->expire == expire, "Timer moved to a later deadline", err);
+    ps->tcbs[2].pace_tokens = 7 * PACE_MSS;
+    tcp_pace_defer(&ps->tcbs[2], 8 * PACE_MSS, now);
+    TST_ASSERT_GOTO(ps->tcbs[2].pace_next < ps->tcbs[0].pace_next && tim->expire < expire,
+                    "Timer not moved to the earlier deadline", err);
+    tst_ok("Deferred sends wait for the missing tokens on one pacer timer");
+
+    /*
+     * The timer clears the due connections and re-arms for the one left, the test TCBs
+     * have no PCB so cnet_tcp_output() returns without sending.
+     */
+    cne_timer_stop(tim);
+    ps->tcbs[0].pace_next = 1;
+    ps->tcbs[1].pace_next = cne_rdtsc() + hz;
+    ps->tcbs[2].pace_next = 1;
+    tcp_pace_timo(tim, &ps->stk);
+    TST_ASSERT_GOTO(ps->tcbs[0].pace_next == 0 && ps->tcbs[2].pace_next == 0,
+                    "Due connections not sent", err);
+    TST_ASSERT_GOTO(ps->tcbs[1].pace_next != 0, "Connection sent before its deadline", err);
+    TST_ASSERT_GOTO(cne_timer_pending(tim), "Pacer timer not re-armed", err);
+
+    cne_timer_stop(tim);
+    ps->tcbs[1].pace_next = 1;
+    tcp_pace_timo(tim, &ps->stk);
+    TST_ASSERT_GOTO(ps->tcbs[1].pace_next == 0 && !cne_timer_pending(tim),
+                    "Pacer timer re-armed without a deferred send", err);
+    tst_ok("Pacer timer sends the due connections and re-arms for the rest");
+
+    return 0;
+err:
+    return -1;
+}
+
+int
+tcp_pace_main(int argc, char **argv)
+{
+    static const struct option lgopts[] = {{NULL, 0, 0, 0}};
+    stk_t *saved_stk    = stk_get();
+    struct pace_stk *ps = NULL;
+    tst_info_t *tst;
+    int option_index, opt;
+
+    optind = 0;
+    while ((opt = getopt_long(argc, argv, "", lgopts, &option_index)) != EOF)
+        ;
+
+    tst = tst_start("TCP pacing");
+
+    cne_timer_subsystem_init();
+
+    ps = pace_stk_create();
+    TST_ASSERT_GOTO(ps != NULL, "Failed to create the stack instance", err);
+    stk_set(&ps->stk);
+
+    if (test_pace_budget(ps) < 0 || test_pace_defer(ps) < 0)
+        goto err;
+
+    stk_set(saved_stk);
+    pace_stk_destroy(ps);
+    tst_end(tst, TST_PASSED);
+    return 0;
+err:
+    stk_set(saved_stk);
+    pace_stk_destroy(ps);
+    tst_end(tst, TST_FAILED);
+    return -1;
+}
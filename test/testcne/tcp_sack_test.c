@@ -0,0 +1,280 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright (c) 2023 Intel Corporation
+ */
+
+#include <stdio.h>              // for NULL, EOF
+#include <stdint.h>             // for uint32_t, uint64_t, uint16_t
+#include <getopt.h>             // for getopt_long, option
+#include <tst_info.h>           // for tst_end, tst_ok, TST_ASSERT_GOTO, tst_start
+#include <cne_common.h>         // for cne_countof
+#include <cnet_tcp_sack.h>      // for cnet_tcp_sack_create, cnet_tcp_sack_update
+
+#include "tcp_sack_test.h"
+
+#define SACK_SEQ      1000 /**< First sequence number sent */
+#define SACK_SEG_LEN  100  /**< Length of every segment */
+#define SACK_XMIT_TS  1000 /**< Transmit time of the first segment in cycles */
+#define SACK_XMIT_GAP 10   /**< Cycles between two transmissions */
+
+#define SEG_SEQ(i) (SACK_SEQ + (i) * SACK_SEG_LEN)
+
+/* Send nb segments starting at segment index first, one every SACK_XMIT_GAP cycles */
+static void
+sack_send(struct tcp_sack *sk, int first, int nb)
+{
+    for (int i = first; i < first + nb; i++)
+        cnet_tcp_sack_sent(sk, SEG_SEQ(i), SACK_SEG_LEN, SACK_XMIT_TS + i * SACK_XMIT_GAP);
+}
+
+/* Return the scoreboard flags of the segment starting at seq or -1 when not tracked */
+static int
+sack_flags(struct tcp_sack *sk, uint32_t seq)
+{
+    for (uint16_t i = 0; i < sk->cnt; i++) {
+        struct tcp_sb_entry *e = &sk->ents[(sk->head + i) % TCP_SACK_SB_ENTRIES];
+
+        if (e->start == seq)
+            return (int)e->flags;
+    }
+    return -1;
+}
+
+/*
+ * SACK blocks arriving in any order, overlapping earlier blocks or only covering part of
+ * a segment mark each fully covered segment once, and the cumulative ACK removes them.
+ */
+static int
+test_sack_merge(void)
+{
+    struct tcp_sack_blk b1[] = {{SEG_SEQ(5), SEG_SEQ(7)}};
+    struct tcp_sack_blk b2[] = {{SEG_SEQ(2), SEG_SEQ(3)}, {SEG_SEQ(5), SEG_SEQ(7)}};
+    struct tcp_sack_blk b3[] = {{SEG_SEQ(2), SEG_SEQ(7)}, {SEG_SEQ(8) + 50, SEG_SEQ(9)}};
+    struct tcp_sack *sk;
+    uint64_t now = SACK_XMIT_TS + 1000;
+    uint64_t srtt;
+    int ev;
+
+    sk = cnet_tcp_sack_create();
+    TST_ASSERT_GOTO(sk != NULL, "Failed to create scoreboard", err);
+
+    sack_send(sk, 0, 10);
+    TST_ASSERT_GOTO(sk->cnt == 10 && cnet_tcp_sack_pipe(sk) == 10 * SACK_SEG_LEN,
+                    "Expected 10 segments in flight, got %u", err, sk->cnt);
+
+    ev = cnet_tcp_sack_update(sk, SACK_SEQ, b1, cne_countof(b1), false, now);
+    TST_ASSERT_GOTO(!(ev & TCP_SACK_EV_DSACK), "Block taken as a D-SACK", err);
+    TST_ASSERT_GOTO(sack_flags(sk, SEG_SEQ(5)) == TCP_SB_SACKED &&
+                        sack_flags(sk, SEG_SEQ(6)) == TCP_SB_SACKED,
+                    "Segments 5-6 not SACKed", err);
+    TST_ASSERT_GOTO(cnet_tcp_sack_pipe(sk) == 8 * SACK_SEG_LEN, "Pipe %u after first block",
+                    err, cnet_tcp_sack_pipe(sk));
+
+    /* An older block arrives after a newer one, the repeated block changes nothing */
+    srtt = sk->srtt;
+    cnet_tcp_sack_update(sk, SACK_SEQ, b2, cne_countof(b2), false, now);
+    TST_ASSERT_GOTO(sack_flags(sk, SEG_SEQ(2)) == TCP_SB_SACKED, "Segment 2 not SACKed", err);
+    TST_ASSERT_GOTO(cnet_tcp_sack_pipe(sk) == 7 * SACK_SEG_LEN, "Pipe %u after second block",
+                    err, cnet_tcp_sack_pipe(sk));
+
+    /* The merged block adds segments 3-4, a block covering half a segment marks nothing */
+    cnet_tcp_sack_update(sk, SACK_SEQ, b3, cne_countof(b3), false, now);
+    for (int i = 2; i < 7; i++)
+        TST_ASSERT_GOTO(sack_flags(sk, SEG_SEQ(i)) & TCP_SB_SACKED, "Segment %d not SACKed",
+                        err, i);
+    TST_ASSERT_GOTO(!(sack_flags(sk, SEG_SEQ(8)) & TCP_SB_SACKED), "Partial segment SACKed",
+                    err);
+    TST_ASSERT_GOTO(cnet_tcp_sack_pipe(sk) == 5 * SACK_SEG_LEN, "Pipe %u after merged block",
+                    err, cnet_tcp_sack_pipe(sk));
+    TST_ASSERT_GOTO(sk->srtt != srtt, "RTT not sampled from the new segments", err);
+    tst_ok("SACK blocks received out of order mark each segment once");
+
+    /* The cumulative ACK inside segment 7 removes the SACKed segments and trims segment 7 */
+    cnet_tcp_sack_update(sk, SEG_SEQ(7) + 40, NULL, 0, false, now);
+    TST_ASSERT_GOTO(sk->cnt == 3 && sk->ents[sk->head].start == SEG_SEQ(7) + 40,
+                    "Scoreboard has %u entries starting at %u", err, sk->cnt,
+                    sk->ents[sk->head].start);
+    TST_ASSERT_GOTO(cnet_tcp_sack_pipe(sk) == 3 * SACK_SEG_LEN - 40, "Pipe %u after ACK", err,
+                    cnet_tcp_sack_pipe(sk));
+    tst_ok("Cumulative ACK removes the acknowledged and SACKed segments");
+
+    cnet_tcp_sack_destroy(sk);
+    return 0;
+err:
+    cnet_tcp_sack_destroy(sk);
+    return -1;
+}
+
+/*
+ * A first block below the ACK or inside the second block is a D-SACK, RFC 2883. It grows
+ * the RACK reordering window and shows a tail loss probe did not repair a loss.
+ */
+static int
+test_sack_dsack(void)
+{
+    struct tcp_sack_blk below[]  = {{SEG_SEQ(0), SEG_SEQ(1)}};
+    struct tcp_sack_blk inside[] = {{SEG_SEQ(4), SEG_SEQ(5)}, {SEG_SEQ(4), SEG_SEQ(6)}};
+    struct tcp_sack_blk probe[]  = {{SEG_SEQ(7), SEG_SEQ(8)}};
+    uint64_t now                 = SACK_XMIT_TS + 1000;
+    struct tcp_sack *sk;
+    int ev;
+
+    sk = cnet_tcp_sack_create();
+    TST_ASSERT_GOTO(sk != NULL, "Failed to create scoreboard", err);
+    sack_send(sk, 0, 6);
+
+    ev = cnet_tcp_sack_update(sk, SEG_SEQ(3), below, cne_countof(below), false, now);
+    TST_ASSERT_GOTO(ev & TCP_SACK_EV_DSACK, "D-SACK below the ACK not detected", err);
+    TST_ASSERT_GOTO(sk->reo_wnd_mult == 2, "Reordering window multiplier %u", err,
+                    sk->reo_wnd_mult);
+
+    ev = cnet_tcp_sack_update(sk, SEG_SEQ(3), inside, cne_countof(inside), false, now);
+    TST_ASSERT_GOTO(ev & TCP_SACK_EV_DSACK, "D-SACK inside the second block not detected", err);
+    TST_ASSERT_GOTO(sk->reo_wnd_mult == 3, "Reordering window multiplier %u", err,
+                    sk->reo_wnd_mult);
+    TST_ASSERT_GOTO(sack_flags(sk, SEG_SEQ(4)) == TCP_SB_SACKED &&
+                        sack_flags(sk, SEG_SEQ(5)) == TCP_SB_SACKED,
+                    "Second block not processed after the D-SACK", err);
+    tst_ok("D-SACK blocks detected and the reordering window grows");
+
+    for (int i = 0; i < TCP_RACK_REO_MULT; i++)
+        cnet_tcp_sack_update(sk, SEG_SEQ(3), below, cne_countof(below), false, now);
+    TST_ASSERT_GOTO(sk->reo_wnd_mult == TCP_RACK_REO_MULT, "Multiplier %u above the max", err,
+                    sk->reo_wnd_mult);
+
+    /* A retransmitted probe acknowledged without a D-SACK repaired a loss */
+    sack_send(sk, 6, 1);
+    cnet_tcp_sack_tlp_sent(sk, SEG_SEQ(7), true);
+    ev = cnet_tcp_sack_update(sk, SEG_SEQ(7), NULL, 0, false, now);
+    TST_ASSERT_GOTO(ev & TCP_SACK_EV_TLP_LOSS, "Probe without D-SACK did not report a loss", err);
+
+    /* With a D-SACK for the probe the original was delivered, there was no loss */
+    sack_send(sk, 7, 1);
+    cnet_tcp_sack_tlp_sent(sk, SEG_SEQ(8), true);
+    ev = cnet_tcp_sack_update(sk, SEG_SEQ(8), probe, cne_countof(probe), false, now);
+    TST_ASSERT_GOTO((ev & TCP_SACK_EV_DSACK) && !(ev & TCP_SACK_EV_TLP_LOSS),
+                    "D-SACKed probe reported a loss", err);
+    TST_ASSERT_GOTO(!sk->tlp_inflight, "Probe still in flight", err);
+    tst_ok("D-SACK tells a spurious tail loss probe from a repaired loss");
+
+    cnet_tcp_sack_dsack_set(sk, SEG_SEQ(2), SEG_SEQ(3));
+    TST_ASSERT_GOTO(sk->dsack_pending && sk->dsack.start == SEG_SEQ(2) &&
+                        sk->dsack.end == SEG_SEQ(3),
+                    "D-SACK to send not recorded", err);
+
+    cnet_tcp_sack_destroy(sk);
+    return 0;
+err:
+    cnet_tcp_sack_destroy(sk);
+    return -1;
+}
+
+/*
+ * RACK marks a segment lost once a segment sent after it was delivered and more than
+ * RTT + reordering window cycles passed since it was sent, the others wait on the timer.
+ */
+static int
+test_rack_loss(void)
+{
+    struct tcp_sack_blk blk[] = {{SEG_SEQ(3), SEG_SEQ(5)}};
+    struct tcp_sack_blk all[] = {{SEG_SEQ(1), SEG_SEQ(5)}};
+    uint64_t now, reo_wnd, deadline;
+    struct tcp_sack *sk;
+    uint32_t seq, len;
+    int ev;
+
+    sk = cnet_tcp_sack_create();
+    TST_ASSERT_GOTO(sk != NULL, "Failed to create scoreboard", err);
+    sack_send(sk, 0, 5);
+
+    /* Segments 3 and 4 are delivered one RTT of 1000 cycles after segment 4 was sent */
+    now = SACK_XMIT_TS + 4 * SACK_XMIT_GAP + 1000;
+    ev  = cnet_tcp_sack_update(sk, SACK_SEQ, blk, cne_countof(blk), false, now);
+    TST_ASSERT_GOTO(sk->rack_rtt == 1000 && sk->min_rtt == 1000, "RACK RTT %lu min %lu", err,
+                    sk->rack_rtt, sk->min_rtt);
+
+    /* No reordering seen and fewer than 3 SACKed segments, the window is min_rtt / 4 */
+    reo_wnd = sk->min_rtt / 4;
+    TST_ASSERT_GOTO(!(ev & TCP_SACK_EV_LOSS), "Segments lost inside the reordering window", err);
+    deadline = SACK_XMIT_TS + 2 * SACK_XMIT_GAP + sk->rack_rtt + reo_wnd;
+    TST_ASSERT_GOTO(sk->rack_deadline == deadline, "Reordering timer %lu expected %lu", err,
+                    sk->rack_deadline, deadline);
+
+    /* Only segment 0 is past its window when the next ACK arrives */
+    now = SACK_XMIT_TS + sk->rack_rtt + reo_wnd;
+    ev  = cnet_tcp_sack_update(sk, SACK_SEQ, NULL, 0, false, now);
+    TST_ASSERT_GOTO(ev & TCP_SACK_EV_LOSS, "Segment 0 not marked lost", err);
+    TST_ASSERT_GOTO(sack_flags(sk, SEG_SEQ(0)) == TCP_SB_LOST &&
+                        sack_flags(sk, SEG_SEQ(1)) == 0 && sack_flags(sk, SEG_SEQ(2)) == 0,
+                    "Wrong segments marked lost", err);
+    TST_ASSERT_GOTO(cnet_tcp_sack_next_lost(sk, &seq, &len) && seq == SEG_SEQ(0) &&
+                        len == SACK_SEG_LEN,
+                    "Next lost segment %u/%u", err, seq, len);
+    TST_ASSERT_GOTO(cnet_tcp_sack_pipe(sk) == 2 * SACK_SEG_LEN, "Pipe %u with a lost segment",
+                    err, cnet_tcp_sack_pipe(sk));
+    tst_ok("RACK marks only the segments outside the reordering window lost");
+
+    /* The timer fires before the deadline without effect, then marks the rest lost */
+    TST_ASSERT_GOTO(cnet_tcp_sack_timo(sk, false, sk->rack_deadline - 1) == 0,
+                    "Reordering timer fired early", err);
+    ev = cnet_tcp_sack_timo(sk, false, deadline);
+    TST_ASSERT_GOTO(ev & TCP_SACK_EV_LOSS, "Reordering timer did not mark a loss", err);
+    TST_ASSERT_GOTO(sack_flags(sk, SEG_SEQ(1)) == TCP_SB_LOST &&
+                        sack_flags(sk, SEG_SEQ(2)) == TCP_SB_LOST,
+                    "Segments 1-2 not lost after the reordering timer", err);
+    TST_ASSERT_GOTO(cnet_tcp_sack_pipe(sk) == 0, "Pipe %u with all segments lost", err,
+                    cnet_tcp_sack_pipe(sk));
+    tst_ok("Reordering timer marks the remaining segments lost");
+
+    /* A retransmission clears the lost mark and the segment is back in the pipe */
+    cnet_tcp_sack_sent(sk, SEG_SEQ(0), SACK_SEG_LEN, deadline);
+    TST_ASSERT_GOTO(sack_flags(sk, SEG_SEQ(0)) == TCP_SB_RETRANS, "Retransmission not recorded",
+                    err);
+    TST_ASSERT_GOTO(cnet_tcp_sack_next_lost(sk, &seq, &len) && seq == SEG_SEQ(1),
+                    "Next lost segment %u", err, seq);
+    TST_ASSERT_GOTO(cnet_tcp_sack_pipe(sk) == SACK_SEG_LEN, "Pipe %u after retransmission", err,
+                    cnet_tcp_sack_pipe(sk));
+    cnet_tcp_sack_destroy(sk);
+
+    /* With 3 SACKed segments the window is zero, losses are marked after one RTT */
+    sk = cnet_tcp_sack_create();
+    TST_ASSERT_GOTO(sk != NULL, "Failed to create scoreboard", err);
+    sack_send(sk, 0, 5);
+    now = SACK_XMIT_TS + 4 * SACK_XMIT_GAP + 1000;
+    ev  = cnet_tcp_sack_update(sk, SACK_SEQ, all, cne_countof(all), false, now);
+    TST_ASSERT_GOTO((ev & TCP_SACK_EV_LOSS) && sack_flags(sk, SEG_SEQ(0)) == TCP_SB_LOST,
+                    "Segment 0 not lost with a zero reordering window", err);
+    TST_ASSERT_GOTO(sk->rack_deadline == 0, "Reordering timer armed", err);
+    tst_ok("Three SACKed segments close the reordering window");
+
+    cnet_tcp_sack_rto(sk);
+    TST_ASSERT_GOTO(sack_flags(sk, SEG_SEQ(0)) == 0 && sack_flags(sk, SEG_SEQ(1)) == 0,
+                    "Scoreboard marks kept after an RTO", err);
+
+    cnet_tcp_sack_destroy(sk);
+    return 0;
+err:
+    cnet_tcp_sack_destroy(sk);
+    return -1;
+}
+
+int
+tcp_sack_main(int argc, char **argv)
+{
+    static const struct option lgopts[] = {{NULL, 0, 0, 0}};
+    tst_info_t *tst;
+    int option_index, opt;
+
+    optind = 0;
+    while ((opt = getopt_long(argc, argv, "", lgopts, &option_index)) != EOF)
+        ;
+
+    tst = tst_start("TCP SACK and RACK");
+
+    if (test_sack_merge() < 0 || test_sack_dsack() < 0 || test_rack_loss() < 0) {
+        tst_end(tst, TST_FAILED);
+        return -1;
+    }
+
+    tst_end(tst, TST_PASSED);
+    return 0;
+}
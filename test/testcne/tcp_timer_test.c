@@ -0,0 +1,291 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright (c) 2023 Intel Corporation
+ */
+
+#include <stdio.h>              // for NULL, EOF
+#include <stdint.h>             // for uint32_t, uint64_t
+#include <stdlib.h>             // for calloc, free, rand, srand
+#include <string.h>             // for memset
+#include <getopt.h>             // for getopt_long, option
+#include <tst_info.h>           // for tst_end, tst_ok, TST_ASSERT_GOTO, tst_start
+#include <cne_common.h>         // for cne_countof
+#include <cnet_tcp_timer.h>     // for cnet_tcp_timer_arm, cnet_tcp_timer_advance
+
+#include "tcp_timer_test.h"
+
+#define TT_NB_RANDOM 4096 /**< Timers with a random expiry */
+#define TT_START     (TCP_TIMER_SPAN - 1000) /**< First tick, the level 3 digit wraps */
+
+/* Expire offsets at the edges of each level */
+static const uint64_t tt_edges[] = {
+    1,
+    2,
+    TCP_TIMER_SLOTS - 1,
+    TCP_TIMER_SLOTS,
+    TCP_TIMER_SLOTS + 1,
+    (1ULL << (2 * TCP_TIMER_BITS)) - 1,
+    1ULL << (2 * TCP_TIMER_BITS),
+    (1ULL << (2 * TCP_TIMER_BITS)) + 1,
+    (1ULL << (3 * TCP_TIMER_BITS)) - 1,
+    1ULL << (3 * TCP_TIMER_BITS),
+    (1ULL << (3 * TCP_TIMER_BITS)) + 1,
+    TCP_TIMER_SPAN - 2,
+    TCP_TIMER_SPAN - 1,
+};
+
+struct tt_state {
+    struct tcp_timer_wheel tw;
+    struct tcp_timer_entry *tims; /**< Timers, idx is the index in this array */
+    uint64_t *want;               /**< Tick each timer must fire at, zero when it must not */
+    uint32_t *fired;              /**< Number of times each timer fired */
+    uint32_t nb;                  /**< Number of timers */
+    uint32_t errors;              /**< Timers fired at the wrong tick */
+    uint64_t period;              /**< Re-arm timer 0 with this period when not zero */
+    int32_t cancel;               /**< Timer cancelled by the callback of timer 0, or -1 */
+};
+
+static void
+tt_cb(struct tcp_timer_entry *tim, void *arg)
+{
+    struct tt_state *ts = arg;
+
+    ts->fired[tim->idx]++;
+    if (ts->tw.now != ts->want[tim->idx] || cnet_tcp_timer_pending(tim))
+        ts->errors++;
+
+    if (tim->idx == 0) {
+        if (ts->cancel >= 0) {
+            cnet_tcp_timer_cancel(&ts->tims[ts->cancel]);
+            ts->want[ts->cancel] = 0;
+        }
+        if (ts->period) {
+            cnet_tcp_timer_arm(&ts->tw, tim, ts->period);
+            ts->want[0] = ts->tw.now + ts->period;
+        }
+    }
+}
+
+static void
+tt_destroy(struct tt_state *ts)
+{
+    if (ts) {
+        free(ts->tims);
+        free(ts->want);
+        free(ts->fired);
+        free(ts);
+    }
+}
+
+static struct tt_state *
+tt_create(uint32_t nb, uint64_t now)
+{
+    struct tt_state *ts = calloc(1, sizeof(struct tt_state));
+
+    if (!ts)
+        return NULL;
+
+    ts->nb     = nb;
+    ts->cancel = -1;
+    ts->tims   = calloc(nb, sizeof(struct tcp_timer_entry));
+    ts->want   = calloc(nb, sizeof(uint64_t));
+    ts->fired  = calloc(nb, sizeof(uint32_t));
+    if (!ts->tims || !ts->want || !ts->fired) {
+        tt_destroy(ts);
+        return NULL;
+    }
+
+    cnet_tcp_timer_init(&ts->tw, now, tt_cb, ts);
+    for (uint32_t i = 0; i < nb; i++)
+        ts->tims[i].idx = i;
+
+    return ts;
+}
+
+static void
+tt_arm(struct tt_state *ts, uint32_t i, uint64_t ticks)
+{
+    cnet_tcp_timer_arm(&ts->tw, &ts->tims[i], ticks);
+    ts->want[i] = ts->tw.now + ticks;
+}
+
+/* Every timer with a deadline fired exactly once at that tick, the others never fired */
+static int
+tt_check(struct tt_state *ts)
+{
+    TST_ASSERT_GOTO(ts->errors == 0, "%u timers fired at the wrong tick", err, ts->errors);
+
+    for (uint32_t i = 0; i < ts->nb; i++) {
+        uint32_t want = ts->want[i] && ts->want[i] <= ts->tw.now;
+
+        TST_ASSERT_GOTO(ts->fired[i] == want, "Timer %u fired %u times expected %u", err, i,
+                        ts->fired[i], want);
+        TST_ASSERT_GOTO(cnet_tcp_timer_pending(&ts->tims[i]) == (ts->want[i] > ts->tw.now),
+                        "Timer %u pending state is wrong", err, i);
+    }
+    return 0;
+err:
+    return -1;
+}
+
+/* Timers at the edges of each level and at random ticks fire once at their expiry */
+static int
+test_timer_expire(void)
+{
+    uint32_t nb_edges   = cne_countof(tt_edges);
+    struct tt_state *ts = tt_create(nb_edges * 2 + TT_NB_RANDOM, TT_START);
+    uint32_t n          = 0;
+
+    TST_ASSERT_GOTO(ts, "Failed to create the timer wheel", err);
+
+    /* Arm the edge timers from the start and again from a tick that is not level aligned */
+    for (uint32_t i = 0; i < nb_edges; i++)
+        tt_arm(ts, n++, tt_edges[i]);
+    cnet_tcp_timer_advance(&ts->tw, TT_START + 37);
+    for (uint32_t i = 0; i < nb_edges; i++)
+        tt_arm(ts, n++, tt_edges[i]);
+
+    srand(0x5eed);
+    while (n < ts->nb)
+        tt_arm(ts, n++, 1 + ((((uint64_t)rand() << 16) ^ rand()) % (TCP_TIMER_SPAN - 1)));
+
+    /* Advance in uneven steps, every level wraps several times on the way */
+    while (ts->tw.now < TT_START + 37 + TCP_TIMER_SPAN) {
+        cnet_tcp_timer_advance(&ts->tw, ts->tw.now + 1 + (uint64_t)(rand() % 5000));
+        TST_ASSERT_GOTO(ts->errors == 0, "Timer fired at the wrong tick before %lu", err,
+                        ts->tw.now);
+    }
+    if (tt_check(ts) < 0)
+        goto err;
+    tst_ok("Timers on every level fire once at their expiry");
+
+    /* A zero delay fires on the next tick and delays past the span are clamped */
+    cnet_tcp_timer_arm(&ts->tw, &ts->tims[0], 0);
+    TST_ASSERT_GOTO(ts->tims[0].expire == ts->tw.now + 1, "Zero delay expires at %lu", err,
+                    ts->tims[0].expire);
+    ts->want[0] = ts->tw.now + 1;
+    cnet_tcp_timer_arm(&ts->tw, &ts->tims[1], TCP_TIMER_SPAN * 3);
+    TST_ASSERT_GOTO(ts->tims[1].expire == ts->tw.now + TCP_TIMER_SPAN - 1,
+                    "Delay not clamped to the span", err);
+    ts->want[1] = ts->tw.now + TCP_TIMER_SPAN - 1;
+    memset(ts->fired, 0, ts->nb * sizeof(uint32_t));
+    cnet_tcp_timer_advance(&ts->tw, ts->tw.now + TCP_TIMER_SPAN);
+    TST_ASSERT_GOTO(ts->errors == 0 && ts->fired[0] == 1 && ts->fired[1] == 1,
+                    "Zero or clamped delay did not fire once", err);
+    tst_ok("Zero delays and delays past the span");
+
+    tt_destroy(ts);
+    return 0;
+err:
+    tt_destroy(ts);
+    return -1;
+}
+
+/* Cancelled timers never fire, re-armed timers only fire at their new expiry */
+static int
+test_timer_cancel_rearm(void)
+{
+    uint32_t nb_edges   = cne_countof(tt_edges);
+    struct tt_state *ts = tt_create(nb_edges * 4, TT_START);
+    uint64_t half       = TCP_TIMER_SPAN / 2;
+
+    TST_ASSERT_GOTO(ts, "Failed to create the timer wheel", err);
+
+    for (uint32_t i = 0; i < ts->nb; i++)
+        tt_arm(ts, i, tt_edges[i % nb_edges]);
+
+    /* Cancel a quarter before any cascade and cancel one of them twice */
+    for (uint32_t i = 0; i < nb_edges; i++) {
+        cnet_tcp_timer_cancel(&ts->tims[i]);
+        ts->want[i] = 0;
+    }
+    cnet_tcp_timer_cancel(&ts->tims[0]);
+
+    /* Re-arm a quarter earlier or later while they are still pending */
+    for (uint32_t i = nb_edges; i < 2 * nb_edges; i++)
+        tt_arm(ts, i, tt_edges[(i * 7) % nb_edges]);
+
+    /* Half way, cancel and re-arm timers which were moved down to lower levels */
+    cnet_tcp_timer_advance(&ts->tw, TT_START + half);
+    for (uint32_t i = 2 * nb_edges; i < ts->nb; i++) {
+        if (!cnet_tcp_timer_pending(&ts->tims[i]))
+            continue;
+        if (i & 1) {
+            cnet_tcp_timer_cancel(&ts->tims[i]);
+            ts->want[i] = 0;
+        } else
+            tt_arm(ts, i, ts->want[i] - ts->tw.now + TCP_TIMER_SLOTS + 3);
+    }
+    if (tt_check(ts) < 0)
+        goto err;
+
+    cnet_tcp_timer_advance(&ts->tw, TT_START + half + TCP_TIMER_SPAN);
+    if (tt_check(ts) < 0)
+        goto err;
+    tst_ok("Cancelled timers never fire and re-armed timers fire at the new expiry");
+
+    tt_destroy(ts);
+    return 0;
+err:
+    tt_destroy(ts);
+    return -1;
+}
+
+/* The callback re-arms its own timer and cancels a timer due in the same tick */
+static int
+test_timer_callback(void)
+{
+    struct tt_state *ts = tt_create(3, TT_START);
+    uint32_t nb;
+
+    TST_ASSERT_GOTO(ts, "Failed to create the timer wheel", err);
+
+    ts->period = TCP_TIMER_SLOTS + 1;
+    ts->cancel = 1;
+    tt_arm(ts, 0, 10);
+    tt_arm(ts, 1, 10);
+    tt_arm(ts, 2, 10 + ts->period);
+
+    cnet_tcp_timer_advance(&ts->tw, TT_START + 10);
+    TST_ASSERT_GOTO(ts->fired[0] == 1 && ts->fired[1] == 0,
+                    "Timer due in the same tick not cancelled by the callback", err);
+    ts->cancel = -1;
+
+    /* Timer 0 fires once per period, each time at its new expiry */
+    nb = 1;
+    for (int i = 0; i < 100; i++) {
+        cnet_tcp_timer_advance(&ts->tw, ts->want[0]);
+        TST_ASSERT_GOTO(ts->fired[0] == ++nb, "Periodic timer fired %u times expected %u", err,
+                        ts->fired[0], nb);
+    }
+    TST_ASSERT_GOTO(ts->errors == 0 && ts->fired[2] == 1 && ts->fired[1] == 0,
+                    "Timers fired at the wrong tick", err);
+    tst_ok("Callback re-arms its timer and cancels a timer due in the same tick");
+
+    tt_destroy(ts);
+    return 0;
+err:
+    tt_destroy(ts);
+    return -1;
+}
+
+int
+tcp_timer_main(int argc, char **argv)
+{
+    static const struct option lgopts[] = {{NULL, 0, 0, 0}};
+    tst_info_t *tst;
+    int option_index, opt;
+
+    optind = 0;
+    while ((opt = getopt_long(argc, argv, "", lgopts, &option_index)) != EOF)
+        ;
+
+    tst = tst_start("TCP timer wheel");
+
+    if (test_timer_expire() < 0 || test_timer_cancel_rearm() < 0 || test_timer_callback() < 0) {
+        tst_end(tst, TST_FAILED);
+        return -1;
+    }
+
+    tst_end(tst, TST_PASSED);
+    return 0;
+}
@@ -14,13 +14,29 @@
 #include <pmd_af_xdp.h>        // for PMD_NET_AF_XDP_NAME
 #include <net/if.h>            // for IF_NAMESIZE
 #include <string.h>            // for memset, strcmp
-#include <unistd.h>            // for sleep
+#include <unistd.h>            // for sleep, usleep
+#include <pthread.h>           // for pthread_create, pthread_join
+#include <sched.h>             // for sched_yield
+#include <cne_cycles.h>        // for cne_rdtsc
+#include <stddef.h>            // for offsetof
+#include <net/cne_ether.h>     // for cne_ether_hdr
+#include <net/cne_ip.h>        // for cne_ipv4_hdr
+#include <net/cne_tcp.h>       // for cne_tcp_hdr
+#include <net/cne_udp.h>       // for cne_udp_hdr
+#include <endian.h>            // for htobe16
 
 #include "xskdev_test.h"
 #include "cne_log.h"          // for cne_panic
 #include "cne_lport.h"        // for lport_cfg, lport_stats_t, LPORT_DFLT_S...
 #include "cne_mmap.h"         // for mmap_addr, mmap_free, mmap_alloc, mmap...
 #include "pktmbuf.h"          // for pktmbuf_destroy, pktmbuf_pool_create
+#include "xskdev_priv.h"      // for xskdev_rx_meta_fill, xskdev_tx_meta_fill
+
+#define TX_STAGE_PKTS  128   /* Packets sent from a thread not owning the TX ring */
+#define TX_FLUSH_TRIES 1000  /* Max xskdev_tx_flush() calls or 1ms waits to send staged packets */
+#define TX_PERF_BURST  32    /* Packets per xskdev_tx_burst() call in the perf test */
+#define TX_PERF_ITERS  20000 /* Number of xskdev_tx_burst() calls in the perf test */
+#define TX_SG_SEG_LEN  64    /* Data length of each segment of a chained packet */
 
 static void
 reset_test_params(struct lport_cfg *cfg, const char *ifname, mmap_t *mmap)
@@ -47,6 +63,459 @@ reset_test_params(struct lport_cfg *cfg, const char *ifname, mmap_t *mmap)
     cfg->addr = addr;
 }
 
+static void
+fill_tx_mbufs(pktmbuf_t **mbufs, int nb_mbufs)
+{
+    for (int j = 0; j < nb_mbufs; j++) {
+        pktmbuf_t *xb = mbufs[j];
+        uint64_t *p   = pktmbuf_mtod(xb, uint64_t *);
+
+        p[0]                 = 0xfd3c78299efefd3c;
+        p[1]                 = 0x00450008b82c9efe;
+        p[2]                 = 0;
+        pktmbuf_data_len(xb) = 60;
+    }
+}
+
+struct tx_stage_arg {
+    xskdev_info_t *xi;  /* Socket in TX owner mode */
+    pktmbuf_t **mbufs;  /* Packets to send from the non-owner thread */
+    uint16_t nb_mbufs;  /* Number of packets in mbufs */
+    uint16_t nb_staged; /* Number of packets accepted by xskdev_tx_burst() */
+};
+
+static void *
+tx_stage_thread(void *arg)
+{
+    struct tx_stage_arg *a = arg;
+
+    a->nb_staged = xskdev_tx_burst(a->xi, (void **)a->mbufs, a->nb_mbufs);
+
+    return NULL;
+}
+
+/* Packets sent from a thread not owning the TX ring are staged and sent by the owner */
+static int
+tx_owner_test(const char *ifname, mmap_t *mmap)
+{
+    struct tx_stage_arg arg = {0};
+    lport_stats_t stats     = {0};
+    pktmbuf_t *mbufs[TX_STAGE_PKTS];
+    xskdev_info_t *xi = NULL;
+    struct lport_cfg pc;
+    pthread_t tid;
+    int n, ret = -1;
+
+    reset_test_params(&pc, ifname, mmap);
+    pc.flags = LPORT_TX_OWNER;
+    pc.pi    = pktmbuf_pool_create(mmap_addr(mmap), DEFAULT_MBUF_COUNT, DEFAULT_MBUF_SIZE,
+                                   MEMPOOL_CACHE_MAX_SIZE, NULL);
+    TST_ASSERT_GOTO(pc.pi, "FAILED --- TEST: pktmbuf_pool_create\n", leave);
+
+    xi = xskdev_socket_create(&pc);
+    TST_ASSERT_GOTO(xi, "FAILED --- TEST: TX owner Socket Create\n", leave);
+    TST_ASSERT_GOTO(xskdev_tx_owner_set(xi) == 0, "FAILED --- TEST: xskdev_tx_owner_set\n",
+                    leave);
+
+    n = pktmbuf_alloc_bulk(pc.pi, mbufs, TX_STAGE_PKTS);
+    TST_ASSERT_GOTO(n == TX_STAGE_PKTS, "FAILED --- TEST: pktmbuf_alloc_bulk\n", leave);
+    fill_tx_mbufs(mbufs, n);
+
+    arg.xi       = xi;
+    arg.mbufs    = mbufs;
+    arg.nb_mbufs = n;
+    TST_ASSERT_GOTO(pthread_create(&tid, NULL, tx_stage_thread, &arg) == 0,
+                    "FAILED --- TEST: pthread_create\n", leave);
+    pthread_join(tid, NULL);
+
+    if (arg.nb_staged < n)
+        pktmbuf_free_bulk(&mbufs[arg.nb_staged], n - arg.nb_staged);
+    TST_ASSERT_GOTO(arg.nb_staged == n, "FAILED --- TEST: staged %u of %d packets\n", leave,
+                    arg.nb_staged, n);
+
+    for (int tries = 0; stats.tx_staged < arg.nb_staged && tries < TX_FLUSH_TRIES; tries++) {
+        xskdev_tx_flush(xi);
+        TST_ASSERT_GOTO(xskdev_stats_get(xi, &stats) == 0, "FAILED --- TEST: xskdev_stats_get\n",
+                        leave);
+    }
+    TST_ASSERT_GOTO(stats.tx_staged == arg.nb_staged,
+                    "FAILED --- TEST: owner sent %lu of %u staged packets\n", leave,
+                    stats.tx_staged, arg.nb_staged);
+
+    ret = 0;
+leave:
+    xskdev_socket_destroy(xi);
+    pktmbuf_destroy(pc.pi);
+    return ret;
+}
+
+struct tx_poll_arg {
+    xskdev_info_t *xi;  /* Socket in TX owner mode */
+    volatile int ready; /* 1 once the polling thread owns the TX ring, -1 if it failed to */
+    volatile int quit;  /* Set by the test to stop the polling thread */
+};
+
+/* TX owner thread with nothing to send, it only polls for received packets */
+static void *
+tx_poll_thread(void *arg)
+{
+    struct tx_poll_arg *a = arg;
+    pktmbuf_t *rx_mbufs[TX_PERF_BURST];
+    uint16_t n;
+
+    if (xskdev_tx_owner_set(a->xi) < 0) {
+        a->ready = -1;
+        return NULL;
+    }
+    a->ready = 1;
+
+    while (!a->quit) {
+        n = xskdev_rx_burst(a->xi, (void **)rx_mbufs, TX_PERF_BURST);
+        if (n)
+            pktmbuf_free_bulk(rx_mbufs, n);
+    }
+
+    return NULL;
+}
+
+/*
+ * The TX owner only receives, the packets staged by a second thread must still be
+ * sent without anyone calling xskdev_tx_flush().
+ */
+static int
+tx_owner_rx_test(const char *ifname, mmap_t *mmap)
+{
+    struct tx_stage_arg arg = {0};
+    struct tx_poll_arg poll = {0};
+    lport_stats_t stats     = {0};
+    pktmbuf_t *mbufs[TX_STAGE_PKTS];
+    pthread_t poll_tid, stage_tid;
+    xskdev_info_t *xi = NULL;
+    bool polling      = false;
+    struct lport_cfg pc;
+    int n, ret = -1;
+
+    reset_test_params(&pc, ifname, mmap);
+    pc.flags = LPORT_TX_OWNER;
+    pc.pi    = pktmbuf_pool_create(mmap_addr(mmap), DEFAULT_MBUF_COUNT, DEFAULT_MBUF_SIZE,
+                                   MEMPOOL_CACHE_MAX_SIZE, NULL);
+    TST_ASSERT_GOTO(pc.pi, "FAILED --- TEST: pktmbuf_pool_create\n", leave);
+
+    xi = xskdev_socket_create(&pc);
+    TST_ASSERT_GOTO(xi, "FAILED --- TEST: TX owner Socket Create\n", leave);
+
+    poll.xi = xi;
+    TST_ASSERT_GOTO(pthread_create(&poll_tid, NULL, tx_poll_thread, &poll) == 0,
+                    "FAILED --- TEST: pthread_create\n", leave);
+    polling = true;
+    while (!poll.ready)
+        sched_yield();
+    TST_ASSERT_GOTO(poll.ready > 0, "FAILED --- TEST: polling thread did not claim the TX ring\n",
+                    leave);
+
+    n = pktmbuf_alloc_bulk(pc.pi, mbufs, TX_STAGE_PKTS);
+    TST_ASSERT_GOTO(n == TX_STAGE_PKTS, "FAILED --- TEST: pktmbuf_alloc_bulk\n", leave);
+    fill_tx_mbufs(mbufs, n);
+
+    arg.xi       = xi;
+    arg.mbufs    = mbufs;
+    arg.nb_mbufs = n;
+    TST_ASSERT_GOTO(pthread_create(&stage_tid, NULL, tx_stage_thread, &arg) == 0,
+                    "FAILED --- TEST: pthread_create\n", leave);
+    pthread_join(stage_tid, NULL);
+
+    if (arg.nb_staged < n)
+        pktmbuf_free_bulk(&mbufs[arg.nb_staged], n - arg.nb_staged);
+    TST_ASSERT_GOTO(arg.nb_staged == n, "FAILED --- TEST: staged %u of %d packets\n", leave,
+                    arg.nb_staged, n);
+
+    for (int tries = 0; stats.tx_staged < arg.nb_staged && tries < TX_FLUSH_TRIES; tries++) {
+        usleep(1000);
+        TST_ASSERT_GOTO(xskdev_stats_get(xi, &stats) == 0, "FAILED --- TEST: xskdev_stats_get\n",
+                        leave);
+    }
+
+    poll.quit = 1;
+    pthread_join(poll_tid, NULL);
+    polling = false;
+
+    TST_ASSERT_GOTO(xskdev_stats_get(xi, &stats) == 0, "FAILED --- TEST: xskdev_stats_get\n",
+                    leave);
+    TST_ASSERT_GOTO(stats.tx_staged == arg.nb_staged,
+                    "FAILED --- TEST: %lu of %u staged packets stranded\n", leave,
+                    arg.nb_staged - stats.tx_staged, arg.nb_staged);
+
+    ret = 0;
+leave:
+    if (polling) {
+        poll.quit = 1;
+        pthread_join(poll_tid, NULL);
+    }
+    xskdev_socket_destroy(xi);
+    pktmbuf_destroy(pc.pi);
+    return ret;
+}
+
+/* Build a packet of nb_segs chained segments, each holding TX_SG_SEG_LEN bytes */
+static pktmbuf_t *
+sg_pkt_create(pktmbuf_info_t *pi, uint16_t nb_segs)
+{
+    pktmbuf_t *segs[XSKDEV_MAX_SEGS + 1];
+
+    if (nb_segs > CNE_DIM(segs) || pktmbuf_alloc_bulk(pi, segs, nb_segs) != nb_segs)
+        return NULL;
+
+    fill_tx_mbufs(segs, 1);
+    for (uint16_t i = 0; i < nb_segs; i++) {
+        pktmbuf_data_len(segs[i]) = TX_SG_SEG_LEN;
+        if (i && pktmbuf_chain(segs[0], segs[i]) < 0) {
+            pktmbuf_free_bulk(&segs[i], nb_segs - i);
+            pktmbuf_free(segs[0]);
+            return NULL;
+        }
+    }
+
+    return segs[0];
+}
+
+/*
+ * Chained packets are sent with one descriptor per segment. A packet with more than
+ * XSKDEV_MAX_SEGS segments is dropped and must not stop the packets behind it.
+ */
+static int
+tx_sg_test(const char *ifname, mmap_t *mmap)
+{
+    uint16_t nb_segs[] = {3, XSKDEV_MAX_SEGS + 1, XSKDEV_MAX_SEGS, 2};
+    pktmbuf_t *pkts[CNE_DIM(nb_segs)];
+    lport_stats_t stats = {0};
+    xskdev_info_t *xi   = NULL;
+    uint64_t bytes      = 0;
+    uint16_t i, n = 0, sent;
+    struct lport_cfg pc;
+    int ret = -1;
+
+    reset_test_params(&pc, ifname, mmap);
+    pc.flags = LPORT_MULTI_BUFFER;
+    pc.pi    = pktmbuf_pool_create(mmap_addr(mmap), DEFAULT_MBUF_COUNT, DEFAULT_MBUF_SIZE,
+                                   MEMPOOL_CACHE_MAX_SIZE, NULL);
+    TST_ASSERT_GOTO(pc.pi, "FAILED --- TEST: pktmbuf_pool_create\n", leave);
+
+    xi = xskdev_socket_create(&pc);
+    if (!xi) {
+        tst_skip("SKIP --- TEST: %s does not support AF_XDP multi-buffer\n", ifname);
+        ret = 0;
+        goto leave;
+    }
+
+    for (n = 0; n < CNE_DIM(nb_segs); n++) {
+        pkts[n] = sg_pkt_create(pc.pi, nb_segs[n]);
+        TST_ASSERT_GOTO(pkts[n], "FAILED --- TEST: chain of %u segments\n", leave, nb_segs[n]);
+    }
+
+    sent = xskdev_tx_burst(xi, (void **)pkts, n);
+    if (sent < n)
+        pktmbuf_free_bulk(&pkts[sent], n - sent);
+    n = 0;
+    TST_ASSERT_GOTO(sent == CNE_DIM(nb_segs), "FAILED --- TEST: burst stopped after %u packets\n",
+                    leave, sent);
+
+    TST_ASSERT_GOTO(xskdev_stats_get(xi, &stats) == 0, "FAILED --- TEST: xskdev_stats_get\n",
+                    leave);
+    TST_ASSERT_GOTO(stats.tx_seg_limit == 1 && stats.opackets == CNE_DIM(nb_segs) - 1,
+                    "FAILED --- TEST: %lu dropped, %lu sent\n", leave, stats.tx_seg_limit,
+                    stats.opackets);
+    for (i = 0; i < CNE_DIM(nb_segs); i++) {
+        if (nb_segs[i] <= XSKDEV_MAX_SEGS)
+            bytes += (uint64_t)nb_segs[i] * TX_SG_SEG_LEN;
+    }
+    TST_ASSERT_GOTO(stats.obytes == bytes, "FAILED --- TEST: %lu bytes sent, expected %lu\n",
+                    leave, stats.obytes, bytes);
+
+    ret = 0;
+leave:
+    if (n)
+        pktmbuf_free_bulk(pkts, n);
+    xskdev_socket_destroy(xi);
+    pktmbuf_destroy(pc.pi);
+    return ret;
+}
+
+/*
+ * The TX checksum offload flags of a mbuf become an AF_XDP TX metadata checksum request in
+ * front of the packet. Without TX metadata support in the build no metadata is written.
+ */
+static int
+tx_meta_test(mmap_t *mmap)
+{
+    pktmbuf_info_t *pi;
+    pktmbuf_t *m = NULL;
+    uint32_t options;
+    int ret = -1;
+
+    pi = pktmbuf_pool_create(mmap_addr(mmap), DEFAULT_MBUF_COUNT, DEFAULT_MBUF_SIZE,
+                             MEMPOOL_CACHE_MAX_SIZE, NULL);
+    TST_ASSERT_GOTO(pi, "FAILED --- TEST: pktmbuf_pool_create\n", leave);
+    m = pktmbuf_alloc(pi);
+    TST_ASSERT_GOTO(m, "FAILED --- TEST: pktmbuf_alloc\n", leave);
+    fill_tx_mbufs(&m, 1);
+
+    options = xskdev_tx_meta_fill(m);
+    TST_ASSERT_GOTO(options == 0, "FAILED --- TEST: metadata without offload flags\n", leave);
+
+    m->l2_len   = sizeof(struct cne_ether_hdr);
+    m->l3_len   = sizeof(struct cne_ipv4_hdr);
+    m->ol_flags = CNE_MBUF_F_TX_IPV4 | CNE_MBUF_F_TX_IP_CKSUM | CNE_MBUF_F_TX_TCP_CKSUM;
+    options     = xskdev_tx_meta_fill(m);
+#ifdef CAN_USE_XSK_TX_METADATA
+    struct xsk_tx_metadata *meta;
+
+    meta = pktmbuf_mtod_offset(m, struct xsk_tx_metadata *, -(int)sizeof(*meta));
+    TST_ASSERT_GOTO(options == XDP_TX_METADATA && (meta->flags & XDP_TXMD_FLAGS_CHECKSUM),
+                    "FAILED --- TEST: no TCP checksum request\n", leave);
+    TST_ASSERT_GOTO(meta->request.csum_start == m->l2_len + m->l3_len &&
+                        meta->request.csum_offset == offsetof(struct cne_tcp_hdr, cksum),
+                    "FAILED --- TEST: TCP checksum request start %u offset %u\n", leave,
+                    meta->request.csum_start, meta->request.csum_offset);
+
+    m->ol_flags = CNE_MBUF_F_TX_IPV4 | CNE_MBUF_F_TX_IP_CKSUM | CNE_MBUF_F_TX_UDP_CKSUM;
+    options     = xskdev_tx_meta_fill(m);
+    TST_ASSERT_GOTO(options == XDP_TX_METADATA && (meta->flags & XDP_TXMD_FLAGS_CHECKSUM),
+                    "FAILED --- TEST: no UDP checksum request\n", leave);
+    TST_ASSERT_GOTO(meta->request.csum_start == m->l2_len + m->l3_len &&
+                        meta->request.csum_offset == offsetof(struct cne_udp_hdr, dgram_cksum),
+                    "FAILED --- TEST: UDP checksum request start %u offset %u\n", leave,
+                    meta->request.csum_start, meta->request.csum_offset);
+
+    /* The metadata goes in the headroom, a packet without room for it is sent without */
+    TST_ASSERT_GOTO(pktmbuf_prepend(m, pktmbuf_headroom(m)),
+                    "FAILED --- TEST: pktmbuf_prepend\n", leave);
+    options = xskdev_tx_meta_fill(m);
+    TST_ASSERT_GOTO(options == 0, "FAILED --- TEST: metadata without headroom\n", leave);
+#else
+    TST_ASSERT_GOTO(options == 0, "FAILED --- TEST: metadata without TX metadata support\n",
+                    leave);
+    tst_info("AF_XDP TX metadata is not supported by kernel or libxdp");
+#endif
+
+    ret = 0;
+leave:
+    pktmbuf_free(m);
+    pktmbuf_destroy(pi);
+    return ret;
+}
+
+#define RX_META_HASH      0x12345678
+#define RX_META_TIMESTAMP 0x1122334455667788ULL
+#define RX_META_VLAN_TCI  0x2064
+
+/*
+ * The XDP RX metadata written in front of a frame by an XDP-hints program is copied into the
+ * mbuf. Only the fields flagged as valid are used and the metadata is used only once.
+ */
+static int
+rx_meta_test(mmap_t *mmap)
+{
+    struct xskdev_rx_meta *meta;
+    pktmbuf_info_t *pi;
+    pktmbuf_t *m = NULL;
+    int ret = -1;
+
+    pi = pktmbuf_pool_create(mmap_addr(mmap), DEFAULT_MBUF_COUNT, DEFAULT_MBUF_SIZE,
+                             MEMPOOL_CACHE_MAX_SIZE, NULL);
+    TST_ASSERT_GOTO(pi, "FAILED --- TEST: pktmbuf_pool_create\n", leave);
+    m = pktmbuf_alloc(pi);
+    TST_ASSERT_GOTO(m, "FAILED --- TEST: pktmbuf_alloc\n", leave);
+    fill_tx_mbufs(&m, 1);
+
+    meta = pktmbuf_mtod_offset(m, struct xskdev_rx_meta *, -(int)sizeof(*meta));
+    memset(meta, 0, sizeof(*meta));
+    meta->rx_hash      = RX_META_HASH;
+    meta->rx_timestamp = RX_META_TIMESTAMP;
+    meta->vlan_proto   = htobe16(CNE_ETHER_TYPE_VLAN);
+    meta->vlan_tci     = RX_META_VLAN_TCI;
+    meta->flags        = XSKDEV_RX_META_HASH;
+    meta->magic        = XSKDEV_RX_META_MAGIC;
+
+    /* Only the hash is valid */
+    m->ol_flags = 0;
+    xskdev_rx_meta_fill(m);
+    TST_ASSERT_GOTO(m->hash == RX_META_HASH && m->ol_flags == CNE_MBUF_F_RX_RSS_HASH,
+                    "FAILED --- TEST: RX hash %08x flags %lx\n", leave, m->hash, m->ol_flags);
+    TST_ASSERT_GOTO(meta->magic == 0, "FAILED --- TEST: RX metadata magic not cleared\n", leave);
+
+    /* The frame is reused, the stale metadata in front of it is ignored */
+    m->hash     = 0;
+    m->ol_flags = 0;
+    xskdev_rx_meta_fill(m);
+    TST_ASSERT_GOTO(m->hash == 0 && m->ol_flags == 0, "FAILED --- TEST: stale RX metadata used\n",
+                    leave);
+
+    meta->flags = XSKDEV_RX_META_HASH | XSKDEV_RX_META_TIMESTAMP | XSKDEV_RX_META_VLAN;
+    meta->magic = XSKDEV_RX_META_MAGIC;
+    xskdev_rx_meta_fill(m);
+    TST_ASSERT_GOTO(m->hash == RX_META_HASH && m->timestamp == RX_META_TIMESTAMP &&
+                        m->vlan_tci == RX_META_VLAN_TCI,
+                    "FAILED --- TEST: RX hash %08x timestamp %lx VLAN TCI %04x\n", leave, m->hash,
+                    m->timestamp, m->vlan_tci);
+    TST_ASSERT_GOTO(m->ol_flags == (CNE_MBUF_F_RX_RSS_HASH | CNE_MBUF_F_RX_TIMESTAMP |
+                                    CNE_MBUF_F_RX_VLAN | CNE_MBUF_F_RX_VLAN_STRIPPED),
+                    "FAILED --- TEST: RX metadata flags %lx\n", leave, m->ol_flags);
+
+    ret = 0;
+leave:
+    pktmbuf_free(m);
+    pktmbuf_destroy(pi);
+    return ret;
+}
+
+/* Return the average cycles of a xskdev_tx_burst() call for the given lport flags */
+static int
+tx_perf_test(const char *ifname, mmap_t *mmap, uint16_t flags, double *cycles)
+{
+    pktmbuf_t *mbufs[TX_PERF_BURST];
+    xskdev_info_t *xi = NULL;
+    uint64_t total = 0, start;
+    struct lport_cfg pc;
+    int n, bursts = 0;
+    uint16_t sent;
+
+    reset_test_params(&pc, ifname, mmap);
+    pc.flags = flags;
+    pc.pi    = pktmbuf_pool_create(mmap_addr(mmap), DEFAULT_MBUF_COUNT, DEFAULT_MBUF_SIZE,
+                                   MEMPOOL_CACHE_MAX_SIZE, NULL);
+    if (!pc.pi)
+        return -1;
+
+    xi = xskdev_socket_create(&pc);
+    if (!xi) {
+        pktmbuf_destroy(pc.pi);
+        return -1;
+    }
+
+    for (int i = 0; i < TX_PERF_ITERS; i++) {
+        n = pktmbuf_alloc_bulk(pc.pi, mbufs, TX_PERF_BURST);
+        if (n <= 0) {
+            /* All buffers are in flight, an empty burst reaps the completion queue */
+            xskdev_tx_burst(xi, (void **)mbufs, 0);
+            continue;
+        }
+        fill_tx_mbufs(mbufs, n);
+
+        start = cne_rdtsc();
+        sent  = xskdev_tx_burst(xi, (void **)mbufs, n);
+        total += cne_rdtsc() - start;
+        bursts++;
+
+        if (sent < n)
+            pktmbuf_free_bulk(&mbufs[sent], n - sent);
+    }
+    *cycles = (bursts) ? (double)total / bursts : 0.0;
+
+    xskdev_socket_destroy(xi);
+    pktmbuf_destroy(pc.pi);
+    return 0;
+}
+
 int
 xskdev_main(int argc, char **argv)
 {
@@ -121,15 +590,7 @@ xskdev_main(int argc, char **argv)
     pktmbuf_t *tx_mbufs[256];
     int n_pkts = pktmbuf_alloc_bulk(pc.pi, tx_mbufs, 256);
     if (n_pkts > 0) {
-        for (int j = 0; j < n_pkts; j++) {
-            pktmbuf_t *xb = tx_mbufs[j];
-            uint64_t *p   = pktmbuf_mtod(xb, uint64_t *);
-
-            p[0]                 = 0xfd3c78299efefd3c;
-            p[1]                 = 0x00450008b82c9efe;
-            p[2]                 = 0;
-            pktmbuf_data_len(xb) = 60;
-        }
+        fill_tx_mbufs(tx_mbufs, n_pkts);
         uint16_t n = xskdev_tx_burst(xi, (void **)tx_mbufs, n_pkts);
 
         if (n != n_pkts)
@@ -166,6 +627,41 @@ xskdev_main(int argc, char **argv)
     xskdev_socket_destroy(xi);
     pktmbuf_destroy(pc.pi);
 
+    /*************************************************************************/
+    /*                       TX Owner Mode Tests                             */
+    /*************************************************************************/
+    cne_printf("\n[blue]>>>[white]TEST: TX owner mode[]\n");
+    TST_ASSERT_GOTO(tx_owner_test(ifname, mmap) == 0, "FAILED --- TEST: TX owner mode\n", err);
+    tst_ok("PASS --- TEST: TX owner mode\n");
+
+    cne_printf("\n[blue]>>>[white]TEST: TX owner flushes staged packets on RX[]\n");
+    TST_ASSERT_GOTO(tx_owner_rx_test(ifname, mmap) == 0,
+                    "FAILED --- TEST: TX owner flushes staged packets on RX\n", err);
+    tst_ok("PASS --- TEST: TX owner flushes staged packets on RX\n");
+
+    cne_printf("\n[blue]>>>[white]TEST: Multi-buffer TX[]\n");
+    TST_ASSERT_GOTO(tx_sg_test(ifname, mmap) == 0, "FAILED --- TEST: Multi-buffer TX\n", err);
+    tst_ok("PASS --- TEST: Multi-buffer TX\n");
+
+    cne_printf("\n[blue]>>>[white]TEST: RX metadata[]\n");
+    TST_ASSERT_GOTO(rx_meta_test(mmap) == 0, "FAILED --- TEST: RX metadata\n", err);
+    tst_ok("PASS --- TEST: RX metadata\n");
+
+    cne_printf("\n[blue]>>>[white]TEST: TX metadata checksum request[]\n");
+    TST_ASSERT_GOTO(tx_meta_test(mmap) == 0, "FAILED --- TEST: TX metadata\n", err);
+    tst_ok("PASS --- TEST: TX metadata checksum request\n");
+
+    double lock_cycles, owner_cycles;
+
+    cne_printf("\n[blue]>>>[white]TEST: TX burst performance, TX lock vs TX owner[]\n");
+    TST_ASSERT_GOTO(tx_perf_test(ifname, mmap, 0, &lock_cycles) == 0,
+                    "FAILED --- TEST: TX lock performance\n", err);
+    TST_ASSERT_GOTO(tx_perf_test(ifname, mmap, LPORT_TX_OWNER, &owner_cycles) == 0,
+                    "FAILED --- TEST: TX owner performance\n", err);
+    cne_printf("  %d bursts of %d packets: TX lock %.1f, TX owner %.1f cycles/burst\n",
+               TX_PERF_ITERS, TX_PERF_BURST, lock_cycles, owner_cycles);
+    tst_ok("PASS --- TEST: TX burst performance\n");
+
     /*************************************************************************/
     /*                       Invalid Parameter Tests                         */
     /*************************************************************************/